@@ -31,16 +31,22 @@ remove_all_files("xml/")
 run_command("doxygen Doxyfile")
 run_command(cmd % ("classboost_1_1geometry_1_1index_1_1rtree", "rtree"))
 run_command(cmd % ("group__rtree__functions", "rtree_functions"))
+run_command(cmd % ("classboost_1_1geometry_1_1index_1_1flat__rtree", "flat_rtree"))
+run_command(cmd % ("classboost_1_1geometry_1_1index_1_1mapped__rtree", "mapped_rtree"))
 
 run_command(cmd % ("structboost_1_1geometry_1_1index_1_1linear", "rtree_linear"))
 run_command(cmd % ("structboost_1_1geometry_1_1index_1_1quadratic", "rtree_quadratic"))
 run_command(cmd % ("structboost_1_1geometry_1_1index_1_1rstar", "rtree_rstar"))
+run_command(cmd % ("structboost_1_1geometry_1_1index_1_1kmeans", "rtree_kmeans"))
 run_command(cmd % ("classboost_1_1geometry_1_1index_1_1dynamic__linear", "rtree_dynamic_linear"))
 run_command(cmd % ("classboost_1_1geometry_1_1index_1_1dynamic__quadratic", "rtree_dynamic_quadratic"))
 run_command(cmd % ("classboost_1_1geometry_1_1index_1_1dynamic__rstar", "rtree_dynamic_rstar"))
+run_command(cmd % ("classboost_1_1geometry_1_1index_1_1dynamic__kmeans", "rtree_dynamic_kmeans"))
 
 run_command(cmd % ("structboost_1_1geometry_1_1index_1_1indexable", "indexable"))
 run_command(cmd % ("structboost_1_1geometry_1_1index_1_1equal__to", "equal_to"))
+run_command(cmd % ("structboost_1_1geometry_1_1index_1_1hilbert__packing", "hilbert_packing"))
+run_command(cmd % ("structboost_1_1geometry_1_1index_1_1morton__packing", "morton_packing"))
 
 run_command(cmd % ("group__predicates", "predicates"))
 #run_command(cmd % ("group__nearest__relations", "nearest_relations"))
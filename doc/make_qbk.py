@@ -127,7 +127,8 @@ strategies = ["distance::pythagoras", "distance::pythagoras_box_box"
     , "buffer::side_straight"
     , "centroid::bashein_detmer", "centroid::average"
     , "convex_hull::graham_andrew"
-    , "simplify::douglas_peucker"
+    , "simplify::douglas_peucker", "simplify::visvalingam_whyatt"
+    , "simplify::topology_preserving"
     , "side::side_by_triangle", "side::side_by_cross_track", "side::spherical_side_formula"
     , "transform::inverse_transformer", "transform::map_transformer"
     , "transform::rotate_transformer", "transform::scale_transformer"
@@ -0,0 +1,91 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Benchmark of the geodesic distance matrix of GPS points, calculated by
+// calling the strategy for each pair of points, by distance_matrix and
+// by distance_matrix in parallel
+
+#include <iostream>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/algorithms/distance_matrix.hpp>
+#include <boost/geometry/strategies/geographic/distance_andoyer.hpp>
+#include <boost/geometry/strategies/geographic/distance_thomas.hpp>
+#include <boost/geometry/strategies/geographic/distance_vincenty.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+namespace bg = boost::geometry;
+
+typedef bg::model::point<double, 2, bg::cs::geographic<bg::degree> > point_type;
+typedef bg::srs::spheroid<double> spheroid_type;
+typedef boost::chrono::duration<float> duration_type;
+
+template <typename Strategy>
+void benchmark(std::vector<point_type> const& points, Strategy const& strategy,
+               char const* name)
+{
+    std::size_t const count = points.size();
+    std::vector<double> matrix(count * count);
+
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < count; i++)
+        {
+            for (std::size_t j = 0; j < count; j++)
+            {
+                matrix[i * count + j] = strategy.apply(points[i], points[j]);
+            }
+        }
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - " << name << ", per pair" << std::endl;
+    }
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        bg::distance_matrix(points, points, matrix.begin(), strategy);
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - " << name << ", distance_matrix" << std::endl;
+    }
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        bg::distance_matrix(points, points, matrix.begin(), strategy, bg::parallel());
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - " << name << ", distance_matrix parallel" << std::endl;
+    }
+}
+
+int main()
+{
+    std::size_t const count = 4000;
+
+    // Points scattered over a country-sized area
+    boost::minstd_rand rng;
+    boost::uniform_real<> lon(3.0, 7.0);
+    boost::uniform_real<> lat(50.5, 53.5);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_real<> > rnd_lon(rng, lon);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_real<> > rnd_lat(rng, lat);
+
+    std::vector<point_type> points;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        points.push_back(point_type(rnd_lon(), rnd_lat()));
+    }
+
+    std::cout << "Matrix of " << count << " x " << count << " points" << std::endl;
+
+    benchmark(points, bg::strategy::distance::andoyer<spheroid_type>(), "andoyer");
+    benchmark(points, bg::strategy::distance::thomas<spheroid_type>(), "thomas");
+    benchmark(points, bg::strategy::distance::vincenty<spheroid_type>(), "vincenty");
+
+    return 0;
+}
@@ -0,0 +1,270 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Benchmark of the geocentric chord distance: the time of one distance
+// compared to the geodesic and spherical strategies, and the k nearest
+// points and the points within a distance, found by calculating the
+// geodesic distance to all points or by filtering them with the chord
+// (in an rtree of geocentric points) and refining the candidates
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/strategies/geographic/distance_geocentric_chord.hpp>
+#include <boost/geometry/strategies/geographic/distance_vincenty.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+typedef bg::model::point<double, 2, bg::cs::geographic<bg::degree> > point_type;
+typedef bg::model::point<double, 2, bg::cs::spherical_equatorial<bg::degree> > sph_point_type;
+typedef bg::model::point<double, 3, bg::cs::cartesian> geocentric_type;
+typedef bg::model::box<geocentric_type> box_type;
+typedef std::pair<geocentric_type, std::size_t> value_type;
+typedef bg::srs::spheroid<double> spheroid_type;
+typedef boost::chrono::duration<float> duration_type;
+
+typedef bg::strategy::distance::vincenty<spheroid_type> exact_type;
+typedef bg::strategy::distance::geocentric_chord<spheroid_type> chord_type;
+
+template <typename Point, typename Strategy>
+void benchmark_pairs(std::vector<Point> const& points, Strategy const& strategy,
+                     char const* name)
+{
+    boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+    double sum = 0;
+    for (std::size_t i = 1; i < points.size(); i++)
+    {
+        sum += strategy.apply(points[i - 1], points[i]);
+    }
+    duration_type time = boost::chrono::steady_clock::now() - start;
+    std::cout << time << " - " << name << " (" << sum << ")" << std::endl;
+}
+
+// Exact k nearest points: the geodesic distance of the k-th nearest point
+// by the chord bounds the chord of all k nearest points
+std::vector<std::pair<double, std::size_t> >
+nearest_refined(bgi::rtree<value_type, bgi::rstar<16> > const& rtree,
+                std::vector<point_type> const& points,
+                point_type const& query, std::size_t k,
+                chord_type const& chord, exact_type const& exact)
+{
+    geocentric_type query_g;
+    chord.to_geocentric(query, query_g);
+
+    std::vector<value_type> candidates;
+    rtree.query(bgi::nearest(query_g, k), std::back_inserter(candidates));
+    double limit = 0;
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        limit = (std::max)(limit, exact.apply(query, points[candidates[i].second]));
+    }
+
+    box_type const box(
+        geocentric_type(bg::get<0>(query_g) - limit, bg::get<1>(query_g) - limit, bg::get<2>(query_g) - limit),
+        geocentric_type(bg::get<0>(query_g) + limit, bg::get<1>(query_g) + limit, bg::get<2>(query_g) + limit));
+    candidates.clear();
+    rtree.query(bgi::intersects(box), std::back_inserter(candidates));
+
+    std::vector<std::pair<double, std::size_t> > result;
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        if (bg::comparable_distance(query_g, candidates[i].first) <= limit * limit)
+        {
+            std::size_t const id = candidates[i].second;
+            result.push_back(std::make_pair(exact.apply(query, points[id]), id));
+        }
+    }
+    std::partial_sort(result.begin(), result.begin() + k, result.end());
+    result.resize(k);
+    return result;
+}
+
+std::vector<std::pair<double, std::size_t> >
+nearest_exact(std::vector<point_type> const& points,
+              point_type const& query, std::size_t k, exact_type const& exact)
+{
+    std::vector<std::pair<double, std::size_t> > result;
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        result.push_back(std::make_pair(exact.apply(query, points[i]), i));
+    }
+    std::partial_sort(result.begin(), result.begin() + k, result.end());
+    result.resize(k);
+    return result;
+}
+
+// Number of points within the distance, accepted by the largest possible
+// geodesic distance of their chord or refined
+std::size_t within_refined(bgi::rtree<value_type, bgi::rstar<16> > const& rtree,
+                           std::vector<point_type> const& points,
+                           point_type const& query, double distance,
+                           chord_type const& chord, exact_type const& exact,
+                           std::size_t& refined)
+{
+    geocentric_type query_g;
+    chord.to_geocentric(query, query_g);
+
+    box_type const box(
+        geocentric_type(bg::get<0>(query_g) - distance, bg::get<1>(query_g) - distance, bg::get<2>(query_g) - distance),
+        geocentric_type(bg::get<0>(query_g) + distance, bg::get<1>(query_g) + distance, bg::get<2>(query_g) + distance));
+    std::vector<value_type> candidates;
+    rtree.query(bgi::intersects(box), std::back_inserter(candidates));
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+        double const cd = bg::comparable_distance(query_g, candidates[i].first);
+        if (cd > distance * distance)
+        {
+            continue;
+        }
+        if (chord.max_distance(cd) <= distance)
+        {
+            count++;
+        }
+        else
+        {
+            refined++;
+            if (exact.apply(query, points[candidates[i].second]) <= distance)
+            {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+std::size_t within_exact(std::vector<point_type> const& points,
+                         point_type const& query, double distance,
+                         exact_type const& exact)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        if (exact.apply(query, points[i]) <= distance)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+int main()
+{
+    std::size_t const count = 200000;
+    std::size_t const query_count = 20;
+    std::size_t const k = 10;
+    double const distance = 25000.0;
+
+    // Points over Western Europe
+    boost::minstd_rand generator(12345);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_real<> >
+        lon(generator, boost::uniform_real<>(-5.0, 15.0)),
+        lat(generator, boost::uniform_real<>(42.0, 56.0));
+
+    std::vector<point_type> points;
+    std::vector<sph_point_type> sph_points;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        points.push_back(point_type(lon(), lat()));
+        sph_points.push_back(sph_point_type(bg::get<0>(points.back()),
+                                            bg::get<1>(points.back())));
+    }
+
+    exact_type const exact;
+    chord_type const chord;
+
+    std::cout << "Distances of " << count << " pairs" << std::endl;
+    benchmark_pairs(points, exact, "vincenty");
+    benchmark_pairs(points, bg::strategy::distance::andoyer<spheroid_type>(), "andoyer");
+    benchmark_pairs(sph_points, bg::strategy::distance::haversine<double>(6371008.8), "haversine");
+    benchmark_pairs(points, chord, "geocentric_chord");
+    benchmark_pairs(points, bg::strategy::distance::comparable::geocentric_chord<spheroid_type>(),
+                    "comparable geocentric_chord");
+
+    std::vector<value_type> values;
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < count; i++)
+        {
+            geocentric_type g;
+            chord.to_geocentric(points[i], g);
+            values.push_back(value_type(g, i));
+        }
+        bgi::rtree<value_type, bgi::rstar<16> > const rtree(values);
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - rtree of geocentric points" << std::endl;
+    }
+    bgi::rtree<value_type, bgi::rstar<16> > const rtree(values);
+
+    std::cout << query_count << " queries, " << k << " nearest and within "
+              << distance << " m" << std::endl;
+
+    std::vector<std::pair<double, std::size_t> > expected, detected;
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        for (std::size_t q = 0; q < query_count; q++)
+        {
+            std::vector<std::pair<double, std::size_t> > const result
+                = nearest_exact(points, points[q], k, exact);
+            expected.insert(expected.end(), result.begin(), result.end());
+        }
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - nearest, geodesic distance of all points" << std::endl;
+    }
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        for (std::size_t q = 0; q < query_count; q++)
+        {
+            std::vector<std::pair<double, std::size_t> > const result
+                = nearest_refined(rtree, points, points[q], k, chord, exact);
+            detected.insert(detected.end(), result.begin(), result.end());
+        }
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - nearest, chord in rtree and refined"
+                  << (detected == expected ? "" : " (DIFFERENT)") << std::endl;
+    }
+
+    std::size_t expected_within = 0, detected_within = 0, refined = 0;
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        for (std::size_t q = 0; q < query_count; q++)
+        {
+            expected_within += within_exact(points, points[q], distance, exact);
+        }
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - within, geodesic distance of all points ("
+                  << expected_within << ")" << std::endl;
+    }
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        for (std::size_t q = 0; q < query_count; q++)
+        {
+            detected_within += within_refined(rtree, points, points[q], distance,
+                                              chord, exact, refined);
+        }
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - within, chord in rtree and refined ("
+                  << detected_within << ", " << refined << " refined)"
+                  << (detected_within == expected_within ? "" : " (DIFFERENT)")
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Benchmark of reading WKT from a string and from a character buffer
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/io/wkt/read_buffer.hpp>
+
+namespace bg = boost::geometry;
+
+typedef bg::model::d2::point_xy<double> point_type;
+typedef bg::model::polygon<point_type> polygon_type;
+typedef boost::chrono::duration<float> duration_type;
+
+int main()
+{
+    std::size_t const count = 10000;
+    std::size_t const points_per_ring = 100;
+
+    // Generate polygons with coordinates written with full precision,
+    // one WKT per line as in a dump
+    boost::minstd_rand rng;
+    boost::uniform_real<> coordinate(-1000.0, 1000.0);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_real<> > rnd(rng, coordinate);
+
+    std::ostringstream out;
+    out << std::setprecision(17);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const cx = rnd();
+        double const cy = rnd();
+        polygon_type polygon;
+        for (std::size_t j = 0; j < points_per_ring; j++)
+        {
+            double const angle = -2.0 * bg::math::pi<double>() * j / points_per_ring;
+            bg::append(polygon.outer(), point_type(cx + std::cos(angle),
+                                                   cy + std::sin(angle)));
+        }
+        bg::correct(polygon);
+        out << bg::wkt(polygon) << std::endl;
+    }
+    std::string const dump = out.str();
+
+    // Split in lines
+    std::vector<std::pair<std::size_t, std::size_t> > lines;
+    for (std::size_t begin = 0; begin < dump.size(); )
+    {
+        std::size_t end = dump.find('\n', begin);
+        lines.push_back(std::make_pair(begin, end));
+        begin = end + 1;
+    }
+
+    std::cout << "WKT of " << dump.size() / (1024 * 1024) << " MB, "
+              << lines.size() << " polygons" << std::endl;
+
+    {
+        boost::chrono::thread_clock::time_point start = boost::chrono::thread_clock::now();
+        double area = 0;
+        polygon_type polygon;
+        for (std::size_t i = 0; i < lines.size(); i++)
+        {
+            bg::read_wkt(dump.substr(lines[i].first, lines[i].second - lines[i].first),
+                         polygon);
+            area += bg::area(polygon);
+        }
+        duration_type time = boost::chrono::thread_clock::now() - start;
+        std::cout << time << " - read_wkt(string), area: " << area << std::endl;
+    }
+
+    {
+        boost::chrono::thread_clock::time_point start = boost::chrono::thread_clock::now();
+        double area = 0;
+        polygon_type polygon;
+        char const* data = dump.data();
+        for (std::size_t i = 0; i < lines.size(); i++)
+        {
+            bg::read_wkt(data + lines[i].first, data + lines[i].second, polygon);
+            area += bg::area(polygon);
+        }
+        duration_type time = boost::chrono::thread_clock::now() - start;
+        std::cout << time << " - read_wkt(buffer), area: " << area << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Benchmark of the simplify strategies on a large synthetic coastline
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <boost/chrono.hpp>
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+namespace bg = boost::geometry;
+
+typedef bg::model::d2::point_xy<double> point_type;
+typedef bg::model::polygon<point_type> polygon_type;
+typedef boost::chrono::duration<float> duration_type;
+
+template <typename Strategy>
+void run(std::string const& name, polygon_type const& coastline,
+         double max_value, Strategy const& strategy)
+{
+    boost::chrono::thread_clock::time_point start = boost::chrono::thread_clock::now();
+    polygon_type simplified;
+    bg::simplify(coastline, simplified, max_value, strategy);
+    duration_type time = boost::chrono::thread_clock::now() - start;
+
+    std::cout << time << " - " << name << " " << max_value
+              << ", points: " << bg::num_points(simplified)
+              << ", valid: " << std::boolalpha << bg::is_valid(simplified)
+              << std::endl;
+}
+
+int main()
+{
+    std::size_t const count = 1000000;
+
+    // A coastline: a circle with a noisy radius, and a few islands
+    // in lakes close to the coast
+    boost::minstd_rand rng;
+    boost::uniform_real<> noise(-1.0, 1.0);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_real<> > rnd(rng, noise);
+
+    polygon_type coastline;
+    double radius = 1000.0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double const angle = -2.0 * bg::math::pi<double>() * i / count;
+        radius += rnd() * 0.05 + (1000.0 - radius) * 0.001;
+        bg::append(coastline.outer(), point_type(radius * std::cos(angle),
+                                                 radius * std::sin(angle)));
+    }
+    for (std::size_t i = 0; i < 100; i++)
+    {
+        double const angle = 2.0 * bg::math::pi<double>() * i / 100;
+        double const x = 990.0 * std::cos(angle);
+        double const y = 990.0 * std::sin(angle);
+        coastline.inners().resize(coastline.inners().size() + 1);
+        bg::append(coastline.inners().back(), point_type(x - 1, y - 1));
+        bg::append(coastline.inners().back(), point_type(x + 1, y - 1));
+        bg::append(coastline.inners().back(), point_type(x + 1, y + 1));
+        bg::append(coastline.inners().back(), point_type(x - 1, y + 1));
+    }
+    bg::correct(coastline);
+
+    std::cout << "Coastline of " << bg::num_points(coastline) << " points"
+              << ", valid: " << std::boolalpha << bg::is_valid(coastline)
+              << std::endl;
+
+    // The douglas_peucker strategy uses a distance, the other
+    // strategies an area
+    for (double distance = 0.1; distance <= 10.0; distance *= 10.0)
+    {
+        run("douglas_peucker", coastline, distance,
+            bg::strategy::simplify::douglas_peucker
+                <
+                    point_type, bg::strategy::distance::projected_point<>
+                >());
+    }
+    for (double area = 0.1; area <= 100.0; area *= 10.0)
+    {
+        run("visvalingam_whyatt", coastline, area,
+            bg::strategy::simplify::visvalingam_whyatt<point_type>());
+    }
+    for (double area = 0.1; area <= 100.0; area *= 10.0)
+    {
+        run("topology_preserving", coastline, area,
+            bg::strategy::simplify::topology_preserving<point_type>());
+    }
+
+    return 0;
+}
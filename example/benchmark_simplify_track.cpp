@@ -0,0 +1,82 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Benchmark of the Douglas-Peucker simplification of a long GPS track,
+// sequentially and in parallel
+
+#include <iostream>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+namespace bg = boost::geometry;
+
+typedef bg::model::d2::point_xy<double> point_type;
+typedef bg::model::linestring<point_type> linestring_type;
+typedef boost::chrono::duration<float> duration_type;
+typedef bg::strategy::simplify::douglas_peucker
+    <
+        point_type, bg::strategy::distance::projected_point<>
+    > strategy_type;
+
+int main()
+{
+    std::size_t const count = 10000000;
+
+    // A random walk with a slowly changing heading
+    boost::minstd_rand rng;
+    boost::uniform_real<> noise(-1.0, 1.0);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_real<> > rnd(rng, noise);
+
+    linestring_type track;
+    track.reserve(count);
+    double x = 0, y = 0, heading = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        heading += rnd() * 0.1;
+        x += std::cos(heading) + rnd() * 0.2;
+        y += std::sin(heading) + rnd() * 0.2;
+        track.push_back(point_type(x, y));
+    }
+
+    std::cout << "Track of " << track.size() << " points" << std::endl;
+
+    for (double distance = 0.1; distance <= 100.0; distance *= 10.0)
+    {
+        std::size_t size = 0;
+        {
+            boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+            linestring_type simplified;
+            strategy_type::apply(track, std::back_inserter(simplified), distance);
+            duration_type time = boost::chrono::steady_clock::now() - start;
+            size = simplified.size();
+            std::cout << time << " - sequential, distance: " << distance
+                      << ", points: " << size << std::endl;
+        }
+        {
+            boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+            linestring_type simplified;
+            strategy_type::apply(track, std::back_inserter(simplified), distance,
+                                 bg::parallel());
+            duration_type time = boost::chrono::steady_clock::now() - start;
+            std::cout << time << " - parallel, distance: " << distance
+                      << ", points: " << simplified.size()
+                      << (simplified.size() == size ? "" : " (different)")
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Shapefile Example - reading the polygons of a memory-mapped shapefile
+// intersecting a box, with their attributes
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/extensions/gis/io/shapefile/shapefile.hpp>
+
+namespace bg = boost::geometry;
+namespace bip = boost::interprocess;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+typedef bg::model::box<point_type> box_type;
+typedef bg::model::polygon<point_type> polygon_type;
+typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+
+int main(int argc, char** argv)
+{
+    if (argc != 2 && argc != 6)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <name without extension> [min_x min_y max_x max_y]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::string const name = argv[1];
+
+    try
+    {
+        // The files are mapped, only the pages of the records read are
+        // loaded from the disk
+        bip::file_mapping shp_file((name + ".shp").c_str(), bip::read_only);
+        bip::mapped_region shp(shp_file, bip::read_only);
+        bip::file_mapping shx_file((name + ".shx").c_str(), bip::read_only);
+        bip::mapped_region shx(shx_file, bip::read_only);
+        bip::file_mapping dbf_file((name + ".dbf").c_str(), bip::read_only);
+        bip::mapped_region dbf(dbf_file, bip::read_only);
+
+        bg::shp_reader const shapes(shp.get_address(), shp.get_size(),
+                                    shx.get_address(), shx.get_size());
+        bg::dbf_reader const attributes(dbf.get_address(), dbf.get_size());
+
+        box_type box;
+        if (argc == 6)
+        {
+            box = box_type(point_type(std::atof(argv[2]), std::atof(argv[3])),
+                           point_type(std::atof(argv[4]), std::atof(argv[5])));
+        }
+        else
+        {
+            shapes.bounds(box);
+        }
+
+        // Only the records whose boxes intersect the box are decoded
+        std::vector<std::size_t> found;
+        shapes.query(box, std::back_inserter(found));
+
+        std::cout << shapes.size() << " records, " << found.size()
+                  << " intersecting " << bg::wkt(box) << std::endl;
+
+        multi_polygon_type multi_polygon;
+        for (std::size_t i = 0; i < found.size(); i++)
+        {
+            if (shapes.read(found[i], multi_polygon))
+            {
+                std::cout << found[i];
+                for (std::size_t f = 0; f < attributes.field_count(); f++)
+                {
+                    std::cout << " " << attributes.field_name(f) << "="
+                              << attributes.value(found[i], f);
+                }
+                std::cout << " area: " << bg::area(multi_polygon) << std::endl;
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Benchmark of reading WKB in both byte orders, compared to reading WKT
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/io/wkt/read_buffer.hpp>
+#include <boost/geometry/extensions/gis/io/wkb/read_wkb.hpp>
+#include <boost/geometry/extensions/gis/io/wkb/write_wkb.hpp>
+
+namespace bg = boost::geometry;
+
+typedef bg::model::d2::point_xy<double> point_type;
+typedef bg::model::polygon<point_type> polygon_type;
+typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+typedef boost::chrono::duration<float> duration_type;
+typedef std::vector<boost::uint8_t> byte_vector;
+
+// Converts WKB of a polygon with one ring, written in little endian, to big
+// endian: the byte order, then 32-bit type and counts, then the doubles
+void to_xdr(byte_vector::iterator it, byte_vector::iterator end)
+{
+    *it++ = 0;
+    for (int i = 0; i < 3; i++, it += 4)
+    {
+        std::reverse(it, it + 4);
+    }
+    for (; it != end; it += 8)
+    {
+        std::reverse(it, it + 8);
+    }
+}
+
+template <typename Geometry>
+void benchmark(std::vector<byte_vector> const& records, std::string const& name)
+{
+    boost::chrono::thread_clock::time_point start = boost::chrono::thread_clock::now();
+    double area = 0;
+    Geometry geometry;
+    for (std::size_t i = 0; i < records.size(); i++)
+    {
+        bg::read_wkb(records[i].begin(), records[i].end(), geometry);
+        area += bg::area(geometry);
+    }
+    duration_type time = boost::chrono::thread_clock::now() - start;
+    std::cout << time << " - " << name << ", area: " << area << std::endl;
+}
+
+int main()
+{
+    std::size_t const count = 10000;
+    std::size_t const points_per_ring = 100;
+
+    boost::minstd_rand rng;
+    boost::uniform_real<> coordinate(-1000.0, 1000.0);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_real<> > rnd(rng, coordinate);
+
+    std::ostringstream out;
+    out << std::setprecision(17);
+    std::vector<std::pair<std::size_t, std::size_t> > lines;
+    std::vector<byte_vector> ndr, xdr;
+    byte_vector multi;
+    {
+        multi_polygon_type multi_polygon;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            double const cx = rnd();
+            double const cy = rnd();
+            polygon_type polygon;
+            for (std::size_t j = 0; j < points_per_ring; j++)
+            {
+                double const angle = -2.0 * bg::math::pi<double>() * j / points_per_ring;
+                bg::append(polygon.outer(), point_type(cx + std::cos(angle),
+                                                       cy + std::sin(angle)));
+            }
+            bg::correct(polygon);
+
+            std::size_t const begin = out.tellp();
+            out << bg::wkt(polygon);
+            lines.push_back(std::make_pair(begin, std::size_t(out.tellp())));
+            out << std::endl;
+
+            ndr.push_back(byte_vector());
+            bg::write_wkb(polygon, std::back_inserter(ndr.back()));
+            xdr.push_back(ndr.back());
+            to_xdr(xdr.back().begin(), xdr.back().end());
+
+            multi_polygon.push_back(polygon);
+        }
+        bg::write_wkb(multi_polygon, std::back_inserter(multi));
+    }
+    std::string const dump = out.str();
+
+    std::cout << "WKT of " << dump.size() / (1024 * 1024) << " MB, WKB of "
+              << multi.size() / (1024 * 1024) << " MB, "
+              << count << " polygons" << std::endl;
+
+    {
+        boost::chrono::thread_clock::time_point start = boost::chrono::thread_clock::now();
+        double area = 0;
+        polygon_type polygon;
+        char const* data = dump.data();
+        for (std::size_t i = 0; i < lines.size(); i++)
+        {
+            bg::read_wkt(data + lines[i].first, data + lines[i].second, polygon);
+            area += bg::area(polygon);
+        }
+        duration_type time = boost::chrono::thread_clock::now() - start;
+        std::cout << time << " - read_wkt(buffer), area: " << area << std::endl;
+    }
+
+    benchmark<polygon_type>(ndr, "read_wkb (little endian)");
+    benchmark<polygon_type>(xdr, "read_wkb (big endian)");
+
+    {
+        std::vector<byte_vector> records(1, multi);
+        benchmark<multi_polygon_type>(records, "read_wkb (multi polygon)");
+    }
+
+    return 0;
+}
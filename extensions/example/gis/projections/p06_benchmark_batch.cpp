@@ -0,0 +1,114 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Projection benchmark: projects an array of coordinates with tmerc, merc
+// and lcc, point by point through the virtual interface, with the batch
+// methods of the projection created by the factory (one virtual call),
+// with the batch methods of the static projection and in parallel
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+#include <boost/geometry/extensions/gis/latlong/point_ll.hpp>
+#include <boost/geometry/extensions/gis/projections/factory.hpp>
+#include <boost/geometry/extensions/gis/projections/parameters.hpp>
+#include <boost/geometry/extensions/gis/projections/proj/lcc.hpp>
+#include <boost/geometry/extensions/gis/projections/proj/merc.hpp>
+#include <boost/geometry/extensions/gis/projections/proj/tmerc.hpp>
+
+namespace bg = boost::geometry;
+
+typedef bg::model::ll::point<bg::degree> lonlat_type;
+typedef bg::model::d2::point_xy<double> xy_type;
+typedef boost::chrono::duration<float> duration_type;
+
+template <typename StaticProjection>
+void benchmark(std::string const& definition,
+               std::vector<double> const& lon, std::vector<double> const& lat)
+{
+    std::size_t const count = lon.size();
+    std::vector<double> x(count), y(count);
+
+    bg::projections::parameters par = bg::projections::detail::pj_init_plus(definition);
+    bg::projections::factory<lonlat_type, xy_type, bg::projections::parameters> pf;
+    boost::shared_ptr<bg::projections::projection<lonlat_type, xy_type> >
+        prj(pf.create_new(par));
+    StaticProjection const static_prj(par);
+
+    std::cout << prj->name() << std::endl;
+
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < count; i++)
+        {
+            lonlat_type ll(bg::longitude<>(lon[i]), bg::latitude<>(lat[i]));
+            xy_type xy;
+            prj->forward(ll, xy);
+            x[i] = xy.x();
+            y[i] = xy.y();
+        }
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - per point" << std::endl;
+    }
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        prj->forward(&lon[0], &lat[0], &x[0], &y[0], count);
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - batch" << std::endl;
+    }
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        static_prj.forward(&lon[0], &lat[0], &x[0], &y[0], count);
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - batch, static projection" << std::endl;
+    }
+    {
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        prj->forward(&lon[0], &lat[0], &x[0], &y[0], count, bg::parallel());
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - batch, parallel" << std::endl;
+    }
+    {
+        std::vector<double> ilon(count), ilat(count);
+        boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        prj->inverse(&x[0], &y[0], &ilon[0], &ilat[0], count);
+        duration_type time = boost::chrono::steady_clock::now() - start;
+        std::cout << time << " - batch, inverse" << std::endl;
+    }
+}
+
+int main()
+{
+    std::size_t const count = 4000000;
+
+    // A grid over Western Europe
+    std::vector<double> lon(count), lat(count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        lon[i] = -5.0 + (i % 2000) * 0.01;
+        lat[i] = 40.0 + (i / 2000) * 0.01;
+    }
+
+    std::cout << "Projecting " << count << " points" << std::endl;
+
+    benchmark<bg::projections::tmerc_ellipsoid<lonlat_type, xy_type> >
+        ("+proj=tmerc +ellps=WGS84 +lon_0=5 +units=m", lon, lat);
+    benchmark<bg::projections::merc_ellipsoid<lonlat_type, xy_type> >
+        ("+proj=merc +ellps=WGS84 +units=m", lon, lat);
+    benchmark<bg::projections::lcc_ellipsoid<lonlat_type, xy_type> >
+        ("+proj=lcc +ellps=WGS84 +lat_1=40 +lat_2=55 +lon_0=5 +units=m", lon, lat);
+
+    return 0;
+}
@@ -0,0 +1,532 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/length.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/io/wkt/wkt.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+#include <boost/geometry/extensions/gis/io/shapefile/shapefile.hpp>
+
+namespace bg = boost::geometry;
+
+namespace { // anonymous
+
+typedef std::vector<boost::uint8_t> byte_vector;
+typedef std::vector<std::pair<double, double> > coordinates;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+typedef bg::model::point<double, 3, bg::cs::cartesian> point3d_type;
+typedef bg::model::box<point_type> box_type;
+typedef bg::model::linestring<point_type> linestring_type;
+typedef bg::model::multi_point<point_type> multi_point_type;
+typedef bg::model::multi_linestring<linestring_type> multi_linestring_type;
+typedef bg::model::polygon<point_type> polygon_type;
+typedef bg::model::polygon<point_type, false, false> polygon_ccw_open_type;
+typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+
+template <typename G>
+std::string to_wkt(G const& geometry)
+{
+    std::ostringstream out;
+    out << bg::wkt(geometry);
+    return out.str();
+}
+
+void put_big(byte_vector& bytes, boost::uint32_t value)
+{
+    for (int i = 3; i >= 0; i--)
+    {
+        bytes.push_back(static_cast<boost::uint8_t>(value >> (8 * i)));
+    }
+}
+
+void put_little(byte_vector& bytes, boost::uint32_t value)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        bytes.push_back(static_cast<boost::uint8_t>(value >> (8 * i)));
+    }
+}
+
+void put_double(byte_vector& bytes, double value)
+{
+    boost::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(double));
+    put_little(bytes, static_cast<boost::uint32_t>(bits));
+    put_little(bytes, static_cast<boost::uint32_t>(bits >> 32));
+}
+
+// Writes the .shp and .shx files of the records added
+class shapefile_writer
+{
+public :
+    void add_null()
+    {
+        byte_vector content;
+        put_little(content, 0);
+        add(content);
+    }
+
+    void add_point(double x, double y)
+    {
+        byte_vector content;
+        put_little(content, 1);
+        put_double(content, x);
+        put_double(content, y);
+        add(content);
+    }
+
+    void add_point_z(double x, double y, double z)
+    {
+        byte_vector content;
+        put_little(content, 11);
+        put_double(content, x);
+        put_double(content, y);
+        put_double(content, z);
+        put_double(content, 0);
+        add(content);
+    }
+
+    // Polylines (3), polygons (5) and multipoints (8), Z (+10) is the
+    // index of the point
+    void add_parts(boost::uint32_t type, std::vector<coordinates> const& parts)
+    {
+        coordinates all;
+        for (std::size_t i = 0; i < parts.size(); i++)
+        {
+            all.insert(all.end(), parts[i].begin(), parts[i].end());
+        }
+
+        byte_vector content;
+        put_little(content, type);
+        double min_x = all.front().first, min_y = all.front().second;
+        double max_x = min_x, max_y = min_y;
+        for (std::size_t i = 0; i < all.size(); i++)
+        {
+            min_x = (std::min)(min_x, all[i].first);
+            min_y = (std::min)(min_y, all[i].second);
+            max_x = (std::max)(max_x, all[i].first);
+            max_y = (std::max)(max_y, all[i].second);
+        }
+        put_double(content, min_x);
+        put_double(content, min_y);
+        put_double(content, max_x);
+        put_double(content, max_y);
+
+        if (type % 10 != 8)
+        {
+            put_little(content, static_cast<boost::uint32_t>(parts.size()));
+        }
+        put_little(content, static_cast<boost::uint32_t>(all.size()));
+        if (type % 10 != 8)
+        {
+            boost::uint32_t start = 0;
+            for (std::size_t i = 0; i < parts.size(); i++)
+            {
+                put_little(content, start);
+                start += static_cast<boost::uint32_t>(parts[i].size());
+            }
+        }
+        for (std::size_t i = 0; i < all.size(); i++)
+        {
+            put_double(content, all[i].first);
+            put_double(content, all[i].second);
+        }
+        if (type > 10)
+        {
+            put_double(content, 0);
+            put_double(content, double(all.size() - 1));
+            for (std::size_t i = 0; i < all.size(); i++)
+            {
+                put_double(content, double(i));
+            }
+        }
+        add(content);
+    }
+
+    byte_vector shp() const
+    {
+        byte_vector bytes;
+        header(bytes, m_records.size());
+        bytes.insert(bytes.end(), m_records.begin(), m_records.end());
+        return bytes;
+    }
+
+    byte_vector shx() const
+    {
+        byte_vector bytes;
+        header(bytes, 8 * m_offsets.size());
+        for (std::size_t i = 0; i < m_offsets.size(); i++)
+        {
+            put_big(bytes, static_cast<boost::uint32_t>(m_offsets[i] / 2));
+            put_big(bytes, static_cast<boost::uint32_t>(m_lengths[i] / 2));
+        }
+        return bytes;
+    }
+
+private :
+    void add(byte_vector const& content)
+    {
+        m_offsets.push_back(100 + m_records.size());
+        m_lengths.push_back(content.size());
+        put_big(m_records, static_cast<boost::uint32_t>(m_offsets.size()));
+        put_big(m_records, static_cast<boost::uint32_t>(content.size() / 2));
+        m_records.insert(m_records.end(), content.begin(), content.end());
+    }
+
+    static void header(byte_vector& bytes, std::size_t size)
+    {
+        put_big(bytes, 9994);
+        for (int i = 0; i < 5; i++)
+        {
+            put_big(bytes, 0);
+        }
+        put_big(bytes, static_cast<boost::uint32_t>((100 + size) / 2));
+        put_little(bytes, 1000);
+        put_little(bytes, 5);
+        double const box[8] = { -10, -10, 10, 10, 0, 0, 0, 0 };
+        for (int i = 0; i < 8; i++)
+        {
+            put_double(bytes, box[i]);
+        }
+    }
+
+    byte_vector m_records;
+    std::vector<std::size_t> m_offsets;
+    std::vector<std::size_t> m_lengths;
+};
+
+coordinates make_coordinates(double const* values, std::size_t count)
+{
+    coordinates result;
+    for (std::size_t i = 0; i + 1 < count; i += 2)
+    {
+        result.push_back(std::make_pair(values[i], values[i + 1]));
+    }
+    return result;
+}
+
+#define COORDINATES(values) make_coordinates(values, sizeof(values) / sizeof(double))
+
+// Outer rings are clockwise, holes counterclockwise
+double const outer1[] = { 0, 0, 0, 4, 4, 4, 4, 0, 0, 0 };
+double const hole1[] = { 1, 1, 2, 1, 2, 2, 1, 2, 1, 1 };
+double const outer2[] = { 5, 5, 5, 6, 6, 6, 6, 5, 5, 5 };
+double const line1[] = { 0, 0, 3, 4 };
+double const line2[] = { 10, 10, 10, 11, 11, 11 };
+
+shapefile_writer create_shapefile()
+{
+    shapefile_writer writer;
+
+    std::vector<coordinates> parts;
+
+    // 0: polygon with a hole
+    parts.push_back(COORDINATES(outer1));
+    parts.push_back(COORDINATES(hole1));
+    writer.add_parts(5, parts);
+
+    // 1: multipolygon
+    parts.push_back(COORDINATES(outer2));
+    writer.add_parts(5, parts);
+
+    // 2: null
+    writer.add_null();
+
+    // 3: polyline
+    parts.clear();
+    parts.push_back(COORDINATES(line1));
+    writer.add_parts(3, parts);
+
+    // 4: polyline with two parts, with Z
+    parts.push_back(COORDINATES(line2));
+    writer.add_parts(13, parts);
+
+    // 5: point, 6: point with Z
+    writer.add_point(7, 8);
+    writer.add_point_z(7, 8, 9);
+
+    // 7: multipoint
+    parts.clear();
+    parts.push_back(COORDINATES(line2));
+    writer.add_parts(8, parts);
+
+    return writer;
+}
+
+void test_reader(bg::shp_reader const& reader)
+{
+    BOOST_CHECK_EQUAL(reader.size(), 8u);
+    BOOST_CHECK_EQUAL(reader.shape_type(), 5u);
+
+    box_type bounds;
+    reader.bounds(bounds);
+    BOOST_CHECK_EQUAL(to_wkt(bounds), "POLYGON((-10 -10,-10 10,10 10,10 -10,-10 -10))");
+
+    // Polygons
+    {
+        polygon_type polygon;
+        BOOST_CHECK(reader.read(0, polygon));
+        BOOST_CHECK_EQUAL(to_wkt(polygon),
+            "POLYGON((0 0,0 4,4 4,4 0,0 0),(1 1,2 1,2 2,1 2,1 1))");
+
+        polygon_ccw_open_type polygon_ccw;
+        BOOST_CHECK(reader.read(0, polygon_ccw));
+        BOOST_CHECK_EQUAL(polygon_ccw.outer().size(), 4u);
+        BOOST_CHECK_EQUAL(to_wkt(polygon_ccw),
+            "POLYGON((4 0,4 4,0 4,0 0,4 0),(1 2,2 2,2 1,1 1,1 2))");
+
+        // Two outer rings
+        BOOST_CHECK(! reader.read(1, polygon));
+
+        multi_polygon_type multi_polygon;
+        BOOST_CHECK(reader.read(0, multi_polygon));
+        BOOST_CHECK_EQUAL(multi_polygon.size(), 1u);
+        BOOST_CHECK(reader.read(1, multi_polygon));
+        BOOST_CHECK_EQUAL(to_wkt(multi_polygon),
+            "MULTIPOLYGON(((0 0,0 4,4 4,4 0,0 0),(1 1,2 1,2 2,1 2,1 1)),"
+            "((5 5,5 6,6 6,6 5,5 5)))");
+
+        BOOST_CHECK(! reader.read(3, multi_polygon));
+    }
+
+    // Null
+    {
+        BOOST_CHECK(reader.record(2).is_null());
+        multi_point_type multi_point;
+        BOOST_CHECK(! reader.read(2, multi_point));
+        box_type box;
+        BOOST_CHECK(! reader.record(2).envelope(box));
+    }
+
+    // Polylines
+    {
+        linestring_type linestring;
+        BOOST_CHECK(reader.read(3, linestring));
+        BOOST_CHECK_EQUAL(to_wkt(linestring), "LINESTRING(0 0,3 4)");
+        BOOST_CHECK(! reader.read(4, linestring));
+
+        multi_linestring_type multi_linestring;
+        BOOST_CHECK(reader.read(4, multi_linestring));
+        BOOST_CHECK_EQUAL(to_wkt(multi_linestring),
+            "MULTILINESTRING((0 0,3 4),(10 10,10 11,11 11))");
+
+        // Z values are the indexes of the points
+        bg::model::multi_linestring<bg::model::linestring<point3d_type> > multi3d;
+        BOOST_CHECK(reader.read(4, multi3d));
+        BOOST_CHECK_EQUAL(to_wkt(multi3d),
+            "MULTILINESTRING((0 0 0,3 4 1),(10 10 2,10 11 3,11 11 4))");
+    }
+
+    // Points
+    {
+        point_type point;
+        BOOST_CHECK(reader.read(5, point));
+        BOOST_CHECK_EQUAL(to_wkt(point), "POINT(7 8)");
+        point3d_type point3d;
+        BOOST_CHECK(reader.read(5, point3d));
+        BOOST_CHECK_EQUAL(to_wkt(point3d), "POINT(7 8 0)");
+        BOOST_CHECK(reader.read(6, point3d));
+        BOOST_CHECK_EQUAL(to_wkt(point3d), "POINT(7 8 9)");
+        BOOST_CHECK(! reader.read(7, point));
+
+        multi_point_type multi_point;
+        BOOST_CHECK(reader.read(5, multi_point));
+        BOOST_CHECK_EQUAL(to_wkt(multi_point), "MULTIPOINT((7 8))");
+        BOOST_CHECK(reader.read(7, multi_point));
+        BOOST_CHECK_EQUAL(to_wkt(multi_point), "MULTIPOINT((10 10),(10 11),(11 11))");
+    }
+
+    // Points accessed without copying
+    {
+        bg::shp_record const record = reader.record(4);
+        BOOST_CHECK_EQUAL(record.shape_type(), 13u);
+        BOOST_CHECK_EQUAL(record.num_parts(), 2u);
+        BOOST_CHECK_EQUAL(record.num_points(), 5u);
+
+        bg::shp_points<point_type> const part = record.part<point_type>(1);
+        BOOST_CHECK_EQUAL(part.size(), 3u);
+        BOOST_CHECK_EQUAL(to_wkt(*(part.begin() + 2)), "POINT(11 11)");
+        BOOST_CHECK_CLOSE(bg::length(part), 2.0, 0.0001);
+        BOOST_CHECK_CLOSE(bg::length(record.part<point_type>(0)), 5.0, 0.0001);
+
+        box_type box;
+        bg::envelope(record.points<point_type>(), box);
+        BOOST_CHECK_EQUAL(to_wkt(box), "POLYGON((0 0,0 11,11 11,11 0,0 0))");
+        BOOST_CHECK(record.envelope(box));
+        BOOST_CHECK_EQUAL(to_wkt(box), "POLYGON((0 0,0 11,11 11,11 0,0 0))");
+    }
+
+    // Bounding box prefilter
+    {
+        std::vector<std::size_t> found;
+        reader.query(box_type(point_type(4.5, 4.5), point_type(10, 10)),
+                     std::back_inserter(found));
+        std::size_t const expected[] = { 1, 4, 5, 6, 7 };
+        BOOST_CHECK(found == std::vector<std::size_t>(expected, expected + 5));
+
+        found.clear();
+        reader.query(box_type(point_type(20, 20), point_type(30, 30)),
+                     std::back_inserter(found));
+        BOOST_CHECK(found.empty());
+    }
+}
+
+void test_shp()
+{
+    shapefile_writer const writer = create_shapefile();
+    byte_vector const shp = writer.shp();
+    byte_vector const shx = writer.shx();
+
+    // With and without the index
+    test_reader(bg::shp_reader(&shp[0], shp.size(), &shx[0], shx.size()));
+    test_reader(bg::shp_reader(&shp[0], shp.size()));
+
+    // Invalid header
+    {
+        byte_vector wrong = shp;
+        wrong[0] = 1;
+        BOOST_CHECK_THROW(bg::shp_reader(&wrong[0], wrong.size()),
+                          bg::read_shapefile_exception);
+        BOOST_CHECK_THROW(bg::shp_reader(&shp[0], 50),
+                          bg::read_shapefile_exception);
+    }
+
+    // Truncated file, the last record exceeds it
+    {
+        BOOST_CHECK_THROW(bg::shp_reader(&shp[0], shp.size() - 1),
+                          bg::read_shapefile_exception);
+
+        bg::shp_reader const reader(&shp[0], shp.size() - 1,
+                                    &shx[0], shx.size());
+        point_type point;
+        BOOST_CHECK(reader.read(5, point));
+        try
+        {
+            multi_point_type multi_point;
+            reader.read(7, multi_point);
+            BOOST_CHECK_MESSAGE(false, "exception expected");
+        }
+        catch (bg::read_shapefile_exception const& e)
+        {
+            BOOST_CHECK_EQUAL(e.offset(), shp.size() - 8 - 88);
+        }
+    }
+
+    // Corrupt .shx, offsets past the end of the .shp file
+    {
+        byte_vector wrong = shx;
+        // The offset of the first record, in 16-bit words
+        wrong[100] = 0x7F;
+        wrong[101] = 0xFF;
+        wrong[102] = 0xFF;
+        wrong[103] = 0xFF;
+        // The offset of the second record, 4 bytes before the end
+        boost::uint32_t const words = boost::uint32_t(shp.size() / 2 - 2);
+        wrong[108] = boost::uint8_t(words >> 24);
+        wrong[109] = boost::uint8_t(words >> 16);
+        wrong[110] = boost::uint8_t(words >> 8);
+        wrong[111] = boost::uint8_t(words);
+
+        bg::shp_reader const reader(&shp[0], shp.size(), &wrong[0], wrong.size());
+        BOOST_CHECK_THROW(reader.record(0), bg::read_shapefile_exception);
+        BOOST_CHECK_THROW(reader.record(1), bg::read_shapefile_exception);
+        BOOST_CHECK(reader.record(2).is_null());
+    }
+
+    // Number of points exceeding the record
+    {
+        byte_vector wrong = shp;
+        // The number of parts of the first record
+        wrong[100 + 8 + 36 + 3] = 0x7F;
+        bg::shp_reader const reader(&wrong[0], wrong.size());
+        BOOST_CHECK_THROW(reader.record(0), bg::read_shapefile_exception);
+        BOOST_CHECK(reader.record(1).num_parts() == 3);
+    }
+}
+
+void put_text(byte_vector& bytes, std::string const& text, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; i++)
+    {
+        bytes.push_back(static_cast<boost::uint8_t>(i < text.size() ? text[i] : 0));
+    }
+}
+
+void test_dbf()
+{
+    // Two fields: NAME C(8), VALUE N(5)
+    byte_vector dbf;
+    dbf.push_back(3);
+    dbf.push_back(116); dbf.push_back(1); dbf.push_back(1);
+    put_little(dbf, 3);
+    dbf.push_back(97); dbf.push_back(0); // header size 32 + 2 * 32 + 1
+    dbf.push_back(14); dbf.push_back(0); // record size 1 + 8 + 5
+    put_text(dbf, "", 20);
+
+    put_text(dbf, "NAME", 11);
+    dbf.push_back('C');
+    put_text(dbf, "", 4);
+    dbf.push_back(8);
+    put_text(dbf, "", 15);
+
+    put_text(dbf, "VALUE", 11);
+    dbf.push_back('N');
+    put_text(dbf, "", 4);
+    dbf.push_back(5);
+    put_text(dbf, "", 15);
+
+    dbf.push_back(0x0D);
+
+    std::string const records = " first      12"
+                                "*second     -3"
+                                " third         ";
+    dbf.insert(dbf.end(), records.begin(), records.begin() + 42);
+    dbf.push_back(0x1A);
+
+    bg::dbf_reader const reader(&dbf[0], dbf.size());
+    BOOST_CHECK_EQUAL(reader.size(), 3u);
+    BOOST_CHECK_EQUAL(reader.field_count(), 2u);
+    BOOST_CHECK_EQUAL(reader.field_name(0), "NAME");
+    BOOST_CHECK_EQUAL(reader.field_type(1), 'N');
+    BOOST_CHECK_EQUAL(reader.field_index("VALUE"), 1u);
+    BOOST_CHECK_EQUAL(reader.field_index("OTHER"), 2u);
+
+    BOOST_CHECK(! reader.is_deleted(0));
+    BOOST_CHECK(reader.is_deleted(1));
+    BOOST_CHECK_EQUAL(reader.value(0, 0), "first");
+    BOOST_CHECK_EQUAL(reader.value(0, 1), "12");
+    BOOST_CHECK_EQUAL(reader.value(1, 1), "-3");
+    BOOST_CHECK_EQUAL(reader.value(2, 1), "");
+
+    // More records than the file contains
+    BOOST_CHECK_THROW(bg::dbf_reader(&dbf[0], dbf.size() - 2),
+                      bg::read_shapefile_exception);
+}
+
+} // namespace anonymous
+
+int test_main(int, char* [])
+{
+    test_shp();
+    test_dbf();
+
+    return 0;
+}
@@ -0,0 +1,236 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/io/wkt/read.hpp>
+#include <boost/geometry/io/wkt/write.hpp>
+#include <boost/geometry/extensions/gis/io/wkb/read_records.hpp>
+#include <boost/geometry/extensions/gis/io/wkb/utility.hpp>
+
+namespace bg = boost::geometry;
+
+namespace { // anonymous
+
+typedef std::vector<boost::uint8_t> byte_vector;
+typedef bg::model::d2::point_xy<double> point_type;
+typedef bg::model::linestring<point_type> linestring_type;
+typedef bg::model::polygon<point_type> polygon_type;
+
+// The same polygon in little and big endian byte order
+std::string const hex_polygon_ndr
+    = "0103000000010000000500000000000000000000000000000000000000000000000000"
+      "0000000000000000F03F000000000000F03F000000000000F03F000000000000F03F00"
+      "0000000000000000000000000000000000000000000000";
+std::string const hex_polygon_xdr
+    = "0000000003000000010000000500000000000000000000000000000000000000000000"
+      "00003FF00000000000003FF00000000000003FF00000000000003FF000000000000000"
+      "0000000000000000000000000000000000000000000000";
+std::string const wkt_polygon = "POLYGON((0 0,0 1,1 1,1 0,0 0))";
+
+template <typename G>
+std::string to_wkt(G const& geometry)
+{
+    std::ostringstream out;
+    out << bg::wkt(geometry);
+    return out.str();
+}
+
+// Collects the records by offset, the calls may be concurrent
+struct collect_visitor
+{
+    template <typename G>
+    void operator()(G const& geometry, std::size_t offset)
+    {
+        std::string const wkt = to_wkt(geometry);
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        records[offset] = wkt;
+    }
+
+    std::map<std::size_t, std::string> records;
+};
+
+void append_record(std::string const& hex, byte_vector& bytes)
+{
+    byte_vector wkb;
+    BOOST_CHECK(bg::hex2wkb(hex, std::back_inserter(wkb)));
+    boost::uint32_t const length = static_cast<boost::uint32_t>(wkb.size());
+    for (int i = 0; i < 4; i++)
+    {
+        bytes.push_back(static_cast<boost::uint8_t>(length >> (8 * i)));
+    }
+    bytes.insert(bytes.end(), wkb.begin(), wkb.end());
+}
+
+void test_hex_records()
+{
+    std::string data;
+    std::map<std::size_t, std::string> expected;
+    for (int i = 0; i < 300; i++)
+    {
+        if (i % 11 == 0)
+        {
+            data += "  \r\n";
+        }
+        expected[data.size()] = wkt_polygon;
+        data += i % 2 == 0 ? hex_polygon_ndr : hex_polygon_xdr;
+        data += i % 3 == 0 ? "\r\n" : "\n";
+    }
+
+    char const* first = data.data();
+    char const* last = first + data.size();
+
+    {
+        bg::hex_wkb_record_reader reader(first, last);
+        polygon_type polygon;
+        std::size_t count = 0;
+        while (reader.next(polygon))
+        {
+            BOOST_CHECK_EQUAL(to_wkt(polygon), wkt_polygon);
+            BOOST_CHECK(expected.count(reader.record_offset()) == 1);
+            count++;
+        }
+        BOOST_CHECK(reader.at_end());
+        BOOST_CHECK_EQUAL(count, expected.size());
+        BOOST_CHECK_EQUAL(reader.count(), expected.size());
+    }
+
+    for (std::size_t threads = 1; threads <= 4; threads++)
+    {
+        collect_visitor visitor;
+        BOOST_CHECK(bg::for_each_hex_wkb_record<polygon_type>(first, last,
+                        visitor, bg::parallel(threads)));
+        BOOST_CHECK(visitor.records == expected);
+    }
+
+    // Invalid hex digit in the third record
+    std::string wrong = hex_polygon_ndr + "\n" + hex_polygon_ndr + "\n"
+        + hex_polygon_ndr + "\n";
+    std::size_t const wrong_offset = 2 * (hex_polygon_ndr.size() + 1);
+    wrong[wrong_offset + 10] = 'G';
+    {
+        bg::hex_wkb_record_reader reader(wrong.data(),
+                                         wrong.data() + wrong.size());
+        polygon_type polygon;
+        BOOST_CHECK(reader.next(polygon));
+        BOOST_CHECK(reader.next(polygon));
+        BOOST_CHECK(! reader.next(polygon));
+        BOOST_CHECK(! reader.at_end());
+        BOOST_CHECK_EQUAL(reader.record_offset(), wrong_offset);
+    }
+    {
+        collect_visitor visitor;
+        BOOST_CHECK(! bg::for_each_hex_wkb_record<polygon_type>(wrong.data(),
+                        wrong.data() + wrong.size(), visitor));
+        BOOST_CHECK_EQUAL(visitor.records.size(), 2u);
+    }
+}
+
+void test_length_prefixed_records()
+{
+    byte_vector data;
+    std::map<std::size_t, std::string> expected;
+    for (int i = 0; i < 300; i++)
+    {
+        std::size_t const offset = data.size();
+        if (i % 3 == 0)
+        {
+            // LINESTRING(1 2,3 4)
+            append_record("010200000002000000000000000000F03F00000000000000400000000000000840"
+                          "0000000000001040", data);
+            expected[offset] = "LINESTRING(1 2,3 4)";
+        }
+        else
+        {
+            append_record(i % 2 == 0 ? hex_polygon_ndr : hex_polygon_xdr, data);
+            expected[offset] = wkt_polygon;
+        }
+    }
+
+    boost::uint8_t const* first = &data[0];
+    boost::uint8_t const* last = first + data.size();
+
+    {
+        // Records of different types are read as linestrings, the polygons
+        // fail
+        bg::wkb_record_reader reader(first, last);
+        linestring_type linestring;
+        BOOST_CHECK(reader.next(linestring));
+        BOOST_CHECK_EQUAL(to_wkt(linestring), "LINESTRING(1 2,3 4)");
+        BOOST_CHECK(! reader.next(linestring));
+        BOOST_CHECK(! reader.at_end());
+        BOOST_CHECK_EQUAL(reader.record_offset(), (++expected.begin())->first);
+    }
+
+    // Only polygons
+    byte_vector polygons;
+    std::map<std::size_t, std::string> expected_polygons;
+    for (int i = 0; i < 300; i++)
+    {
+        expected_polygons[polygons.size()] = wkt_polygon;
+        append_record(i % 2 == 0 ? hex_polygon_ndr : hex_polygon_xdr, polygons);
+    }
+    first = &polygons[0];
+    last = first + polygons.size();
+
+    {
+        collect_visitor visitor;
+        BOOST_CHECK(bg::for_each_wkb_record<polygon_type>(first, last, visitor));
+        BOOST_CHECK(visitor.records == expected_polygons);
+    }
+
+    for (std::size_t threads = 1; threads <= 4; threads++)
+    {
+        collect_visitor visitor;
+        BOOST_CHECK(bg::for_each_wkb_record<polygon_type>(first, last,
+                        visitor, bg::parallel(threads)));
+        BOOST_CHECK(visitor.records == expected_polygons);
+    }
+
+    // A length which exceeds the buffer
+    {
+        byte_vector truncated(polygons.begin(), polygons.end() - 1);
+        collect_visitor visitor;
+        BOOST_CHECK(! bg::for_each_wkb_record<polygon_type>(&truncated[0],
+                        &truncated[0] + truncated.size(), visitor,
+                        bg::parallel(2)));
+        BOOST_CHECK_EQUAL(visitor.records.size(), 299u);
+    }
+}
+
+} // namespace anonymous
+
+int test_main(int, char* [])
+{
+    {
+        byte_vector wkb;
+        BOOST_CHECK(bg::hex2wkb("00ff7Fa0", std::back_inserter(wkb)));
+        BOOST_CHECK(wkb.size() == 4 && wkb[1] == 0xff && wkb[2] == 0x7f
+                    && wkb[3] == 0xa0);
+        BOOST_CHECK(! bg::hex2wkb("0", std::back_inserter(wkb)));
+        BOOST_CHECK(! bg::hex2wkb("0x", std::back_inserter(wkb)));
+    }
+
+    test_hex_records();
+    test_length_prefixed_records();
+
+    return 0;
+}
@@ -99,35 +99,35 @@ int test_main(int, char* [])
         test_geometry_equals_old<point3d_type, true>(
             "01E90300005839B4C876BEF33F83C0CAA145B616404F401361C3332240", "POINT(1.234 5.678 9.1011)");
 
-        //     // XYZ - POINT(1.234 5.678 99) - Z coordinate ignored
-        //     test_geometry_equals<point_type, true>(
-        //         "01010000805839B4C876BEF33F83C0CAA145B616400000000000C05840", "POINT(1.234 5.678)");
-        // 
-        //     // SRID=32632;POINT(1.234 5.678) - PostGIS EWKT
-        //     test_geometry_equals<point_type, false>(
-        //         "0101000020787F00005839B4C876BEF33F83C0CAA145B61640", "POINT (1.234 5.678)");
-        // 
-        //     // SRID=4326;POINT(1.234 5.678 99) - PostGIS EWKT
-        //     test_geometry_equals<point_type, false>(
-        //         "01010000A0E61000005839B4C876BEF33F83C0CAA145B616400000000000C05840", "POINT(1.234 5.678)");
-        // 
-        //     // POINTM(1.234 5.678 99) - XYM with M compound ignored
-        //     test_geometry_equals<point_type, true>(
-        //         "01010000405839B4C876BEF33F83C0CAA145B616400000000000C05840", "POINT (1.234 5.678)");
-        // 
-        //     // SRID=32632;POINTM(1.234 5.678 99)
-        //     test_geometry_equals<point_type, false>(
-        //         "0101000060787F00005839B4C876BEF33F83C0CAA145B616400000000000C05840", "POINT (1.234 5.678)");
-        // 
-        //     // POINT(1.234 5.678 15 79) - XYZM - Z and M compounds ignored
-        //     test_geometry_equals<point_type, true>(
-        //         "01010000C05839B4C876BEF33F83C0CAA145B616400000000000002E400000000000C05340",
-        //         "POINT (1.234 5.678)");
-        // 
-        //     // SRID=4326;POINT(1.234 5.678 15 79) - XYZM + SRID
-        //     test_geometry_equals<point_type, false>(
-        //         "01010000E0E61000005839B4C876BEF33F83C0CAA145B616400000000000002E400000000000C05340",
-        //         "POINT (1.234 5.678)");
+        // XYZ - POINT(1.234 5.678 99) - Z coordinate ignored
+        test_geometry_equals_old<point_type, true>(
+            "01010000805839B4C876BEF33F83C0CAA145B616400000000000C05840", "POINT(1.234 5.678)");
+
+        // SRID=32632;POINT(1.234 5.678) - PostGIS EWKT
+        test_geometry_equals_old<point_type, true>(
+            "0101000020787F00005839B4C876BEF33F83C0CAA145B61640", "POINT (1.234 5.678)");
+
+        // SRID=4326;POINT(1.234 5.678 99) - PostGIS EWKT
+        test_geometry_equals_old<point_type, true>(
+            "01010000A0E61000005839B4C876BEF33F83C0CAA145B616400000000000C05840", "POINT(1.234 5.678)");
+
+        // POINTM(1.234 5.678 99) - XYM with M compound ignored
+        test_geometry_equals_old<point_type, true>(
+            "01010000405839B4C876BEF33F83C0CAA145B616400000000000C05840", "POINT (1.234 5.678)");
+
+        // SRID=32632;POINTM(1.234 5.678 99)
+        test_geometry_equals_old<point_type, true>(
+            "0101000060787F00005839B4C876BEF33F83C0CAA145B616400000000000C05840", "POINT (1.234 5.678)");
+
+        // POINT(1.234 5.678 15 79) - XYZM - Z and M compounds ignored
+        test_geometry_equals_old<point_type, true>(
+            "01010000C05839B4C876BEF33F83C0CAA145B616400000000000002E400000000000C05340",
+            "POINT (1.234 5.678)");
+
+        // SRID=4326;POINT(1.234 5.678 15 79) - XYZM + SRID
+        test_geometry_equals_old<point_type, true>(
+            "01010000E0E61000005839B4C876BEF33F83C0CAA145B616400000000000002E400000000000C05340",
+            "POINT (1.234 5.678)");
 
     }
 
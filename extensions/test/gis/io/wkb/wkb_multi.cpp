@@ -0,0 +1,330 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/variant/variant.hpp>
+
+#include <boost/geometry/algorithms/equals.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/io/wkt/wkt.hpp>
+#include <boost/geometry/extensions/gis/io/wkb/read_wkb.hpp>
+#include <boost/geometry/extensions/gis/io/wkb/write_wkb.hpp>
+#include <boost/geometry/extensions/gis/io/wkb/utility.hpp>
+
+namespace bg = boost::geometry;
+
+namespace { // anonymous
+
+typedef std::vector<boost::uint8_t> byte_vector;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+typedef bg::model::point<double, 3, bg::cs::cartesian> point3d_type;
+typedef bg::model::point<double, 4, bg::cs::cartesian> point4d_type;
+typedef bg::model::linestring<point_type> linestring_type;
+typedef bg::model::polygon<point_type> polygon_type;
+typedef bg::model::multi_point<point_type> multi_point_type;
+typedef bg::model::multi_linestring<linestring_type> multi_linestring_type;
+typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+typedef bg::model::multi_point<point3d_type> multi_point3d_type;
+
+typedef boost::variant
+    <
+        point_type, linestring_type, polygon_type,
+        multi_point_type, multi_linestring_type, multi_polygon_type
+    > variant_type;
+
+struct collection_type : std::vector<variant_type> {};
+
+} // namespace anonymous
+
+namespace boost { namespace geometry { namespace traits
+{
+
+template <>
+struct tag<collection_type>
+{
+    typedef geometry_collection_tag type;
+};
+
+}}} // namespace boost::geometry::traits
+
+namespace { // anonymous
+
+template <typename G>
+std::string to_wkt(G const& geometry)
+{
+    std::ostringstream out;
+    out << bg::wkt(geometry);
+    return out.str();
+}
+
+struct to_wkt_visitor : boost::static_visitor<std::string>
+{
+    template <typename G>
+    std::string operator()(G const& geometry) const
+    {
+        return to_wkt(geometry);
+    }
+};
+
+std::string to_hex(byte_vector const& wkb)
+{
+    std::string hex;
+    BOOST_CHECK(bg::wkb2hex(wkb.begin(), wkb.end(), hex));
+    return hex;
+}
+
+// Reads the hexadecimal WKB and compares the geometry with the WKT
+template <typename Geometry>
+void test_read(std::string const& wkbhex, std::string const& wkt)
+{
+    byte_vector wkb;
+    BOOST_CHECK(bg::hex2wkb(wkbhex, std::back_inserter(wkb)));
+
+    Geometry geometry;
+    BOOST_CHECK_MESSAGE(bg::read_wkb(wkb.begin(), wkb.end(), geometry),
+        "read_wkb failed for " << wkbhex);
+    BOOST_CHECK_EQUAL(to_wkt(geometry), wkt);
+}
+
+// Writes the geometry, compares the WKB and reads it back
+template <typename Geometry>
+void test_round_trip(std::string const& wkt, std::string const& wkbhex)
+{
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+
+    byte_vector wkb;
+    BOOST_CHECK(bg::write_wkb(geometry, std::back_inserter(wkb)));
+    BOOST_CHECK_EQUAL(to_hex(wkb), wkbhex);
+
+    Geometry read;
+    BOOST_CHECK(bg::read_wkb(wkb.begin(), wkb.end(), read));
+    BOOST_CHECK_EQUAL(to_wkt(read), to_wkt(geometry));
+}
+
+template <typename Geometry>
+void test_wrong(std::string const& wkbhex)
+{
+    byte_vector wkb;
+    BOOST_CHECK(bg::hex2wkb(wkbhex, std::back_inserter(wkb)));
+
+    Geometry geometry;
+    BOOST_CHECK_MESSAGE(! bg::read_wkb(wkb.begin(), wkb.end(), geometry),
+        "read_wkb should fail for " << wkbhex);
+}
+
+void test_multi()
+{
+    // MULTIPOINT((1 2),(3 4))
+    test_round_trip<multi_point_type>("MULTIPOINT((1 2),(3 4))",
+        "0104000000020000000101000000000000000000F03F0000000000000040"
+        "010100000000000000000008400000000000001040");
+
+    // MULTILINESTRING((0 0,1 1),(2 2,3 3,4 4))
+    test_round_trip<multi_linestring_type>(
+        "MULTILINESTRING((0 0,1 1),(2 2,3 3,4 4))",
+        "010500000002000000010200000002000000000000000000000000000000000000"
+        "00000000000000F03F000000000000F03F010200000003000000000000000000"
+        "00400000000000000040000000000000084000000000000008400000000000001040"
+        "0000000000001040");
+
+    // MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)))
+    test_round_trip<multi_polygon_type>(
+        "MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)))",
+        "0106000000010000000103000000010000000500000000000000000000000000"
+        "0000000000000000000000000000000000000000F03F000000000000F03F0000"
+        "00000000F03F000000000000F03F000000000000000000000000000000000000"
+        "000000000000");
+
+    // Empty multi
+    test_round_trip<multi_point_type>("MULTIPOINT()",
+        "010400000000000000");
+
+    // MULTIPOINT((1 2),(3 4)) in big endian, elements in mixed byte order
+    test_read<multi_point_type>(
+        "0000000004000000020000000001"
+        "3FF00000000000004000000000000000"
+        "010100000000000000000008400000000000001040",
+        "MULTIPOINT((1 2),(3 4))");
+
+    // MULTIPOINT Z((1 2 3),(4 5 6)), ISO and EWKB
+    test_read<multi_point3d_type>(
+        "01EC03000002000000"
+        "01E9030000000000000000F03F00000000000000400000000000000840"
+        "01E9030000000000000000104000000000000014400000000000001840",
+        "MULTIPOINT((1 2 3),(4 5 6))");
+    test_read<multi_point3d_type>(
+        "010400008002000000"
+        "0101000080000000000000F03F00000000000000400000000000000840"
+        "0101000080000000000000104000000000000014400000000000001840",
+        "MULTIPOINT((1 2 3),(4 5 6))");
+
+    // Z skipped for 2D points
+    test_read<multi_point_type>(
+        "01EC03000002000000"
+        "01E9030000000000000000F03F00000000000000400000000000000840"
+        "01E9030000000000000000104000000000000014400000000000001840",
+        "MULTIPOINT((1 2),(4 5))");
+
+    // Wrong element type
+    test_wrong<multi_point_type>(
+        "010400000001000000010200000000000000");
+    // Truncated
+    test_wrong<multi_point_type>(
+        "0104000000020000000101000000000000000000F03F0000000000000040");
+    // Number of elements exceeding the input
+    test_wrong<multi_point_type>("0104000000FFFFFF7F");
+}
+
+void test_point4d()
+{
+    // POINT ZM(1 2 3 4)
+    std::string const zm
+        = "01B90B0000000000000000F03F000000000000004000000000000008400000000000001040";
+    test_round_trip<point4d_type>("POINT(1 2 3 4)", zm);
+
+    // POINT M(1 2 4), the Z value is not present and set to zero
+    test_read<point4d_type>(
+        "01D1070000000000000000F03F00000000000000400000000000001040",
+        "POINT(1 2 0 4)");
+
+    // POINT(1 2), the missing values are zero
+    test_read<point4d_type>(
+        "0101000000000000000000F03F0000000000000040",
+        "POINT(1 2 0 0)");
+}
+
+void test_ewkb()
+{
+    point3d_type const point(1, 2, 3);
+
+    // SRID=4326;POINT(1 2 3)
+    byte_vector wkb;
+    BOOST_CHECK(bg::write_ewkb(point, std::back_inserter(wkb), 4326));
+    BOOST_CHECK_EQUAL(to_hex(wkb),
+        "01010000A0E6100000000000000000F03F00000000000000400000000000000840");
+
+    point3d_type read;
+    boost::uint32_t srid = 0;
+    BOOST_CHECK(bg::read_wkb(wkb.begin(), wkb.end(), read, srid));
+    BOOST_CHECK_EQUAL(srid, 4326u);
+    BOOST_CHECK(bg::equals(read, point));
+
+    // Without SRID
+    wkb.clear();
+    BOOST_CHECK(bg::write_ewkb(point, std::back_inserter(wkb)));
+    BOOST_CHECK_EQUAL(to_hex(wkb),
+        "0101000080000000000000F03F00000000000000400000000000000840");
+    BOOST_CHECK(bg::read_wkb(wkb.begin(), wkb.end(), read, srid));
+    BOOST_CHECK_EQUAL(srid, 0u);
+
+    // The SRID is written only in the header of the outer geometry
+    multi_point_type multi_point;
+    bg::read_wkt("MULTIPOINT((1 2))", multi_point);
+    wkb.clear();
+    BOOST_CHECK(bg::write_ewkb(multi_point, std::back_inserter(wkb), 4326));
+    BOOST_CHECK_EQUAL(to_hex(wkb),
+        "0104000020E6100000010000000101000000000000000000F03F0000000000000040");
+    multi_point_type read_multi;
+    BOOST_CHECK(bg::read_wkb(wkb.begin(), wkb.end(), read_multi, srid));
+    BOOST_CHECK_EQUAL(srid, 4326u);
+    BOOST_CHECK_EQUAL(to_wkt(read_multi), "MULTIPOINT((1 2))");
+}
+
+void test_variant()
+{
+    std::string const wkts[] =
+    {
+        "POINT(1 2)",
+        "LINESTRING(1 2,3 4)",
+        "POLYGON((0 0,0 1,1 1,1 0,0 0))",
+        "MULTIPOINT((1 2),(3 4))",
+        "MULTILINESTRING((1 2,3 4))",
+        "MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)))"
+    };
+
+    collection_type collection;
+    for (std::size_t i = 0; i < sizeof(wkts) / sizeof(wkts[0]); i++)
+    {
+        variant_type variant;
+        switch (i)
+        {
+            case 0 : { point_type g; bg::read_wkt(wkts[i], g); variant = g; } break;
+            case 1 : { linestring_type g; bg::read_wkt(wkts[i], g); variant = g; } break;
+            case 2 : { polygon_type g; bg::read_wkt(wkts[i], g); variant = g; } break;
+            case 3 : { multi_point_type g; bg::read_wkt(wkts[i], g); variant = g; } break;
+            case 4 : { multi_linestring_type g; bg::read_wkt(wkts[i], g); variant = g; } break;
+            case 5 : { multi_polygon_type g; bg::read_wkt(wkts[i], g); variant = g; } break;
+        }
+
+        byte_vector wkb;
+        BOOST_CHECK(bg::write_wkb(variant, std::back_inserter(wkb)));
+
+        variant_type read;
+        BOOST_CHECK(bg::read_wkb(wkb.begin(), wkb.end(), read));
+        BOOST_CHECK_EQUAL(read.which(), static_cast<int>(i));
+        BOOST_CHECK_EQUAL(boost::apply_visitor(to_wkt_visitor(), read), wkts[i]);
+
+        collection.push_back(variant);
+    }
+
+    // GEOMETRYCOLLECTION of all types
+    byte_vector wkb;
+    BOOST_CHECK(bg::write_wkb(collection, std::back_inserter(wkb)));
+    BOOST_CHECK_EQUAL(to_hex(wkb).substr(0, 18), "010700000006000000");
+
+    collection_type read;
+    BOOST_CHECK(bg::read_wkb(wkb.begin(), wkb.end(), read));
+    BOOST_CHECK_EQUAL(read.size(), collection.size());
+    for (std::size_t i = 0; i < read.size() && i < collection.size(); i++)
+    {
+        BOOST_CHECK_EQUAL(read[i].which(), collection[i].which());
+        BOOST_CHECK_EQUAL(boost::apply_visitor(to_wkt_visitor(), read[i]),
+                          wkts[i]);
+    }
+
+    // POINT(1 2) and GEOMETRYCOLLECTION(POINT(1 2)) in big endian
+    test_read<variant_type>("00000000013FF00000000000004000000000000000",
+                            "POINT(1 2)");
+    {
+        byte_vector wkb;
+        BOOST_CHECK(bg::hex2wkb(
+            "00000000070000000100000000013FF00000000000004000000000000000",
+            std::back_inserter(wkb)));
+        BOOST_CHECK(bg::read_wkb(wkb.begin(), wkb.end(), read));
+        BOOST_CHECK_EQUAL(read.size(), 1u);
+        BOOST_CHECK_EQUAL(boost::apply_visitor(to_wkt_visitor(), read.front()),
+                          "POINT(1 2)");
+    }
+
+    // A geometry collection can't be read into a variant of these types
+    test_wrong<variant_type>("010700000000000000");
+}
+
+} // namespace anonymous
+
+int test_main(int, char* [])
+{
+    test_multi();
+    test_point4d();
+    test_ewkb();
+    test_variant();
+
+    return 0;
+}
@@ -0,0 +1,267 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/geometry/extensions/gis/projections/factory.hpp>
+#include <boost/geometry/extensions/gis/projections/parameters.hpp>
+#include <boost/geometry/extensions/gis/projections/projection.hpp>
+
+#include <boost/geometry/extensions/gis/projections/proj/lcc.hpp>
+#include <boost/geometry/extensions/gis/projections/proj/merc.hpp>
+#include <boost/geometry/extensions/gis/projections/proj/tmerc.hpp>
+
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/extensions/gis/latlong/point_ll.hpp>
+
+
+typedef bg::model::ll::point<bg::degree, double> lonlat_type;
+typedef bg::model::d2::point_xy<double> xy_type;
+
+
+// Projects the points one by one, invalid points are set to HUGE_VAL
+template <typename Projection>
+std::size_t forward_each(Projection const& prj,
+                         std::vector<double> const& lon,
+                         std::vector<double> const& lat,
+                         std::vector<double>& x, std::vector<double>& y)
+{
+    std::size_t projected = 0;
+    x.resize(lon.size());
+    y.resize(lon.size());
+    for (std::size_t i = 0; i < lon.size(); i++)
+    {
+        lonlat_type ll;
+        ll.lon(lon[i]);
+        ll.lat(lat[i]);
+        xy_type xy;
+        if (prj.forward(ll, xy))
+        {
+            x[i] = xy.x();
+            y[i] = xy.y();
+            projected++;
+        }
+        else
+        {
+            x[i] = HUGE_VAL;
+            y[i] = HUGE_VAL;
+        }
+    }
+    return projected;
+}
+
+// Projects the points back one by one
+template <typename Projection>
+std::size_t inverse_each(Projection const& prj,
+                         std::vector<double> const& x,
+                         std::vector<double> const& y,
+                         std::vector<double>& lon, std::vector<double>& lat)
+{
+    std::size_t projected = 0;
+    lon.resize(x.size());
+    lat.resize(x.size());
+    for (std::size_t i = 0; i < x.size(); i++)
+    {
+        xy_type const xy(x[i], y[i]);
+        lonlat_type ll;
+        if (prj.inverse(xy, ll))
+        {
+            lon[i] = ll.lon();
+            lat[i] = ll.lat();
+            projected++;
+        }
+        else
+        {
+            lon[i] = HUGE_VAL;
+            lat[i] = HUGE_VAL;
+        }
+    }
+    return projected;
+}
+
+// Invalid input may result in nan
+inline bool same(double a, double b)
+{
+    return a == b || (a != a && b != b);
+}
+
+template <typename Projection>
+void test_batch(Projection const& prj, std::string const& caseid)
+{
+    std::vector<double> lon, lat;
+    for (int i = 0; i < 10000; i++)
+    {
+        lon.push_back(-5.0 + (i % 100) * 0.2);
+        lat.push_back(35.0 + (i / 100) * 0.25);
+    }
+    // Points which can't be projected, in the middle and at the end
+    lon[17] = 4.0; lat[17] = 95.0;
+    lon[5000] = 4.0; lat[5000] = -91.0;
+    lon.push_back(700.0); lat.push_back(52.0);
+
+    std::size_t const count = lon.size();
+
+    std::vector<double> ex, ey;
+    std::size_t const expected = forward_each(prj, lon, lat, ex, ey);
+    BOOST_CHECK_EQUAL(expected, count - 3);
+    BOOST_CHECK_EQUAL(ex[17], HUGE_VAL);
+    BOOST_CHECK_EQUAL(ey[count - 1], HUGE_VAL);
+
+    // Separate arrays
+    std::vector<double> x(count), y(count);
+    BOOST_CHECK_EQUAL(prj.forward(&lon[0], &lat[0], &x[0], &y[0], count), expected);
+    BOOST_CHECK_MESSAGE(x == ex && y == ey, caseid << " separate");
+
+    // Interleaved arrays, projected in place
+    std::vector<double> lonlat(2 * count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        lonlat[2 * i] = lon[i];
+        lonlat[2 * i + 1] = lat[i];
+    }
+    std::vector<double> xy = lonlat;
+    BOOST_CHECK_EQUAL(prj.forward(&xy[0], &xy[0], count), expected);
+    bool equal = true;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        equal = equal && xy[2 * i] == ex[i] && xy[2 * i + 1] == ey[i];
+    }
+    BOOST_CHECK_MESSAGE(equal, caseid << " interleaved");
+
+    // Strided arrays, e.g. with a third coordinate
+    std::vector<double> xyz(3 * count, 7.0);
+    BOOST_CHECK_EQUAL(prj.forward(&lon[0], &lat[0], 1,
+                                  &xyz[0], &xyz[1], 3, count), expected);
+    equal = true;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        equal = equal && xyz[3 * i] == ex[i] && xyz[3 * i + 1] == ey[i]
+                      && xyz[3 * i + 2] == 7.0;
+    }
+    BOOST_CHECK_MESSAGE(equal, caseid << " strided");
+
+    // Parallel
+    std::vector<double> px(count), py(count);
+    BOOST_CHECK_EQUAL(prj.forward(&lon[0], &lat[0], &px[0], &py[0], count,
+                                  bg::parallel(2)), expected);
+    BOOST_CHECK_MESSAGE(px == ex && py == ey, caseid << " parallel");
+
+    std::vector<double> pxy(2 * count);
+    BOOST_CHECK_EQUAL(prj.forward(&lonlat[0], &pxy[0], count,
+                                  bg::parallel(2)), expected);
+    BOOST_CHECK_MESSAGE(pxy == xy, caseid << " parallel interleaved");
+
+    // Empty batch
+    BOOST_CHECK_EQUAL(prj.forward(&lon[0], &lat[0], &x[0], &y[0], 0), 0u);
+
+    // Inverse, the results of invalid points depend on the projection
+    std::vector<double> elon, elat;
+    std::size_t const expected_inverse = inverse_each(prj, ex, ey, elon, elat);
+
+    std::vector<double> ilon(count), ilat(count);
+    BOOST_CHECK_EQUAL(prj.inverse(&ex[0], &ey[0], &ilon[0], &ilat[0], count),
+                      expected_inverse);
+
+    std::size_t errors = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        bool const ok = same(ilon[i], elon[i]) && same(ilat[i], elat[i])
+            && (ex[i] == HUGE_VAL
+                || (std::fabs(ilon[i] - lon[i]) < 1e-6
+                    && std::fabs(ilat[i] - lat[i]) < 1e-6));
+        if (! ok && errors++ < 10)
+        {
+            BOOST_CHECK_MESSAGE(false, caseid << " inverse " << i
+                << " " << ilon[i] << " " << ilat[i]
+                << " " << elon[i] << " " << elat[i]);
+        }
+    }
+
+    std::vector<double> pll(2 * count);
+    BOOST_CHECK_EQUAL(prj.inverse(&xy[0], &pll[0], count, bg::parallel(2)),
+                      expected_inverse);
+    BOOST_CHECK(pll[2 * 21] == ilon[21] && pll[2 * 21 + 1] == ilat[21]);
+}
+
+// Projection implementing only the virtual methods of one point,
+// the batch methods use them
+class per_point_projection
+    : public bg::projections::projection<lonlat_type, xy_type>
+{
+    typedef bg::projections::projection<lonlat_type, xy_type> base_type;
+
+public :
+    explicit per_point_projection(base_type const& prj)
+        : m_prj(prj)
+    {}
+
+    using base_type::forward;
+    using base_type::inverse;
+
+    virtual bool forward(lonlat_type const& lp, xy_type& xy) const
+    {
+        return m_prj.forward(lp, xy);
+    }
+    virtual bool inverse(xy_type const& xy, lonlat_type& lp) const
+    {
+        return m_prj.inverse(xy, lp);
+    }
+    virtual void fwd(LL_T& lp_lon, LL_T& lp_lat, XY_T& xy_x, XY_T& xy_y) const
+    {
+        m_prj.fwd(lp_lon, lp_lat, xy_x, xy_y);
+    }
+    virtual void inv(XY_T& xy_x, XY_T& xy_y, LL_T& lp_lon, LL_T& lp_lat) const
+    {
+        m_prj.inv(xy_x, xy_y, lp_lon, lp_lat);
+    }
+    virtual std::string name() const { return m_prj.name(); }
+    virtual bg::projections::parameters const& params() const { return m_prj.params(); }
+    virtual bg::projections::parameters& mutable_params() { return m_params; }
+
+private :
+    base_type const& m_prj;
+    bg::projections::parameters m_params;
+};
+
+template <typename StaticProjection>
+void test_projection(std::string const& definition, std::string const& caseid)
+{
+    bg::projections::parameters par = bg::projections::detail::pj_init_plus(definition);
+
+    StaticProjection const static_prj(par);
+    test_batch(static_prj, caseid + "_static");
+
+    bg::projections::factory<lonlat_type, xy_type, bg::projections::parameters> pf;
+    boost::shared_ptr<bg::projections::projection<lonlat_type, xy_type> >
+        prj(pf.create_new(par));
+    test_batch(*prj, caseid + "_dynamic");
+
+    per_point_projection const per_point(*prj);
+    test_batch(per_point, caseid + "_per_point");
+}
+
+int test_main(int, char* [])
+{
+    test_projection<bg::projections::tmerc_ellipsoid<lonlat_type, xy_type> >
+        ("+proj=tmerc +ellps=WGS84 +lon_0=5 +units=m", "tmerc");
+    test_projection<bg::projections::merc_ellipsoid<lonlat_type, xy_type> >
+        ("+proj=merc +ellps=WGS84 +units=m", "merc");
+    test_projection<bg::projections::lcc_ellipsoid<lonlat_type, xy_type> >
+        ("+proj=lcc +ellps=WGS84 +lat_1=33 +lat_2=45 +lon_0=4 +units=m", "lcc");
+
+    return 0;
+}
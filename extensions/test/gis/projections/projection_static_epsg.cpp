@@ -0,0 +1,194 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <cstddef>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+#include <boost/geometry/extensions/gis/projections/epsg.hpp>
+#include <boost/geometry/extensions/gis/projections/factory.hpp>
+#include <boost/geometry/extensions/gis/projections/parameters.hpp>
+#include <boost/geometry/extensions/gis/projections/static_epsg.hpp>
+
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/extensions/gis/latlong/point_ll.hpp>
+
+
+typedef bg::model::ll::point<bg::degree, double> lonlat_type;
+typedef bg::model::d2::point_xy<double> xy_type;
+
+
+inline void check_close(double detected, double expected, std::string const& what,
+                        int code)
+{
+    BOOST_CHECK_MESSAGE(bg::math::abs(detected - expected)
+                            <= 1e-12 * (std::max)(1.0, bg::math::abs(expected)),
+                        code << " " << what << " detected: " << detected
+                             << " expected: " << expected);
+}
+
+// The parameters and the projected points are the same as the ones of the
+// projection created by the factory from the definition of epsg.hpp
+template <int Code>
+void test_code(double lon_min, double lat_min, double lon_max, double lat_max)
+{
+    typedef bg::projections::static_epsg_traits<Code, lonlat_type, xy_type> traits;
+
+    bg::projections::static_parameters const spar = traits::par();
+    bg::projections::parameters const par = bg::projections::detail::pj_init_plus(
+                    bg::projections::detail::code_to_string(Code));
+
+    check_close(spar.a, par.a, "a", Code);
+    check_close(spar.es, par.es, "es", Code);
+    check_close(spar.e, par.e, "e", Code);
+    check_close(spar.one_es, par.one_es, "one_es", Code);
+    check_close(spar.lam0, par.lam0, "lam0", Code);
+    check_close(spar.phi0, par.phi0, "phi0", Code);
+    check_close(spar.k0, par.k0, "k0", Code);
+    check_close(spar.x0, par.x0, "x0", Code);
+    check_close(spar.y0, par.y0, "y0", Code);
+    check_close(spar.to_meter, par.to_meter, "to_meter", Code);
+    BOOST_CHECK_EQUAL(spar.datum_type, par.datum_type);
+    for (int i = 0; i < 7; i++)
+    {
+        check_close(spar.datum_params[i], par.datum_params[i], "datum_params", Code);
+    }
+
+    typename traits::type const static_prj(spar);
+
+    bg::projections::factory<lonlat_type, xy_type, bg::projections::parameters> pf;
+    boost::shared_ptr<bg::projections::projection<lonlat_type, xy_type> >
+        prj(pf.create_new(par));
+
+    for (int i = 0; i <= 10; i++)
+    {
+        for (int j = 0; j <= 10; j++)
+        {
+            lonlat_type const ll(bg::longitude<>(lon_min + (lon_max - lon_min) * i / 10.0),
+                                 bg::latitude<>(lat_min + (lat_max - lat_min) * j / 10.0));
+            xy_type xy1, xy2;
+            BOOST_CHECK(static_prj.forward(ll, xy1));
+            BOOST_CHECK(prj->forward(ll, xy2));
+            BOOST_CHECK_CLOSE(xy1.x(), xy2.x(), 1e-9);
+            BOOST_CHECK_CLOSE(xy1.y(), xy2.y(), 1e-9);
+
+            lonlat_type ll1, ll2;
+            BOOST_CHECK(static_prj.inverse(xy1, ll1));
+            BOOST_CHECK(prj->inverse(xy2, ll2));
+            BOOST_CHECK_CLOSE(ll1.lon(), ll2.lon(), 1e-9);
+            BOOST_CHECK_CLOSE(ll1.lat(), ll2.lat(), 1e-9);
+        }
+    }
+
+    // Without datum shift, the projector projects like the projection
+    bg::projections::epsg_projector<Code, lonlat_type, xy_type> const projector;
+    lonlat_type const center(bg::longitude<>((lon_min + lon_max) / 2),
+                             bg::latitude<>((lat_min + lat_max) / 2));
+    xy_type xy1, xy2;
+    projector.forward(center, xy1);
+    projector.get_projection().forward(center, xy2);
+    BOOST_CHECK_EQUAL(bg::projections::detail::pj_datum_shifted(spar),
+                      bg::math::abs(xy1.x() - xy2.x()) > 1.0);
+}
+
+template <int Code>
+void test_projector(double lon, double lat, double x, double y, double tolerance,
+                    double shift)
+{
+    typedef bg::projections::epsg_projector<Code, lonlat_type, xy_type> projector_type;
+    projector_type const projector;
+
+    lonlat_type ll;
+    ll.lon(lon);
+    ll.lat(lat);
+    xy_type xy;
+    BOOST_CHECK(projector.forward(ll, xy));
+    BOOST_CHECK_MESSAGE(bg::math::abs(xy.x() - x) < tolerance
+                        && bg::math::abs(xy.y() - y) < tolerance,
+                        Code << " detected: " << xy.x() << " " << xy.y());
+
+    // The distance to the points projected without datum shift
+    xy_type unshifted;
+    projector.get_projection().forward(ll, unshifted);
+    double const dx = unshifted.x() - xy.x();
+    double const dy = unshifted.y() - xy.y();
+    BOOST_CHECK_CLOSE(sqrt(dx * dx + dy * dy) + 1.0, shift + 1.0, 10.0);
+
+    // Back to WGS84, the inverse of the Helmert transformation is approximate
+    lonlat_type back;
+    BOOST_CHECK(projector.inverse(xy, back));
+    BOOST_CHECK_SMALL(back.lon() - lon, 1e-7);
+    BOOST_CHECK_SMALL(back.lat() - lat, 1e-7);
+
+    // Projectors are values
+    projector_type copy;
+    copy = projector;
+    xy_type xy_copy;
+    copy.forward(ll, xy_copy);
+    BOOST_CHECK_EQUAL(xy_copy.x(), xy.x());
+    BOOST_CHECK_EQUAL(xy_copy.y(), xy.y());
+
+    // Invalid latitude
+    ll.lat(91.0);
+    BOOST_CHECK(! projector.forward(ll, xy));
+}
+
+void test_geocentric()
+{
+    namespace bpd = bg::projections::detail;
+
+    double const a = 6378137.0;
+    double const es = 0.0066943799901413165;
+    double const b = a * sqrt(1 - es);
+    double const d2r = bg::math::d2r<double>();
+
+    double x, y, z;
+    bpd::pj_geodetic_to_geocentric(a, es, 0, 0, 0, x, y, z);
+    BOOST_CHECK_CLOSE(x, a, 1e-12);
+    BOOST_CHECK_SMALL(y, 1e-6);
+    BOOST_CHECK_SMALL(z, 1e-6);
+
+    bpd::pj_geodetic_to_geocentric(a, es, 90 * d2r, 90 * d2r, 100, x, y, z);
+    BOOST_CHECK_CLOSE(z, b + 100, 1e-12);
+
+    bpd::pj_geodetic_to_geocentric(a, es, 4.9 * d2r, 52.4 * d2r, 250, x, y, z);
+    double lon, lat, h;
+    bpd::pj_geocentric_to_geodetic(a, es, x, y, z, lon, lat, h);
+    BOOST_CHECK_CLOSE(lon, 4.9 * d2r, 1e-10);
+    BOOST_CHECK_CLOSE(lat, 52.4 * d2r, 1e-10);
+    BOOST_CHECK_CLOSE(h, 250, 1e-6);
+}
+
+int test_main(int, char* [])
+{
+    test_code<2154>(-4, 42, 8, 51);
+    test_code<2805>(-73, 41, -70, 43);
+    test_code<3395>(-170, -80, 170, 80);
+    test_code<27700>(-7, 50, 2, 58);
+    test_code<28992>(3.3, 50.7, 7.2, 53.5);
+    test_code<31467>(7.5, 47, 10.5, 55);
+    test_code<32631>(0, 0, 6, 84);
+    test_code<32733>(12, -80, 18, 0);
+    test_code<25832>(6, 38, 12, 84);
+
+    test_geocentric();
+
+    // OSGB36 (7 parameters), Ordnance Survey Caister Water Tower
+    test_projector<27700>(1.7160740, 52.6580078, 651409.903, 313177.270, 5.0, 135.0);
+    // Potsdam (3 parameters), Frankfurt am Main, the expected coordinates are
+    // calculated with the Helmert transformation to Bessel and the Krueger
+    // series of the transverse Mercator (accurate to mm)
+    test_projector<31467>(8.6821, 50.1109, 3477332.487, 5552793.645, 1.0, 149.0);
+
+    return 0;
+}
@@ -32,6 +32,7 @@
 #include <boost/geometry/geometries/concepts/check.hpp>
 #include <boost/geometry/geometries/box.hpp>
 #include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 #include <boost/geometry/algorithms/detail/buffer/buffer_inserter.hpp>
 
@@ -287,6 +288,86 @@ inline void buffer(GeometryIn const& geometry_in,
 }
 
 
+/*!
+\brief \brief_calc{buffer}, using parallel tasks
+\ingroup buffer
+\details \details_calc{buffer, \det_buffer}.
+    The pieces of the members of multi-geometries are created, and the
+    intersections of the pieces are calculated and located, by parallel
+    tasks. The result is the same as the result of the sequential version.
+\tparam GeometryIn \tparam_geometry
+\tparam MultiPolygon \tparam_geometry{MultiPolygon}
+\tparam DistanceStrategy A strategy defining distance (or radius)
+\tparam SideStrategy A strategy defining creation along sides
+\tparam JoinStrategy A strategy defining creation around convex corners
+\tparam EndStrategy A strategy defining creation at linestring ends
+\tparam PointStrategy A strategy defining creation around points
+\param geometry_in \param_geometry
+\param geometry_out output multi polygon (or std:: collection of polygons),
+    will contain a buffered version of the input geometry
+\param distance_strategy The distance strategy to be used
+\param side_strategy The side strategy to be used
+\param join_strategy The join strategy to be used
+\param end_strategy The end strategy to be used
+\param point_strategy The point strategy to be used
+\param parallel_policy the parallel execution policy
+
+\qbk{distinguish,with strategies and parallel}
+ */
+template
+<
+    typename GeometryIn,
+    typename MultiPolygon,
+    typename DistanceStrategy,
+    typename SideStrategy,
+    typename JoinStrategy,
+    typename EndStrategy,
+    typename PointStrategy
+>
+inline void buffer(GeometryIn const& geometry_in,
+                MultiPolygon& geometry_out,
+                DistanceStrategy const& distance_strategy,
+                SideStrategy const& side_strategy,
+                JoinStrategy const& join_strategy,
+                EndStrategy const& end_strategy,
+                PointStrategy const& point_strategy,
+                geometry::parallel const& parallel_policy)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+    concept::check<GeometryIn const>();
+    concept::check<polygon_type>();
+
+    typedef typename point_type<GeometryIn>::type point_type;
+    typedef typename rescale_policy_type<point_type>::type rescale_policy_type;
+
+    geometry_out.clear();
+
+    if (geometry::is_empty(geometry_in))
+    {
+        // Then output geometry is kept empty as well
+        return;
+    }
+
+    model::box<point_type> box;
+    geometry::envelope(geometry_in, box);
+    geometry::buffer(box, box, distance_strategy.max_distance(join_strategy, end_strategy));
+
+    rescale_policy_type rescale_policy
+            = boost::geometry::get_rescale_policy<rescale_policy_type>(box);
+
+    detail::buffer::visit_pieces_default_policy visitor;
+    detail::buffer::buffer_inserter<polygon_type>(geometry_in, std::back_inserter(geometry_out),
+                distance_strategy,
+                side_strategy,
+                join_strategy,
+                end_strategy,
+                point_strategy,
+                rescale_policy,
+                visitor,
+                detail::buffer::buffer_parallel_policy(parallel_policy));
+}
+
+
 }} // namespace boost::geometry
 
 #endif // BOOST_GEOMETRY_ALGORITHMS_BUFFER_HPP
@@ -9,8 +9,10 @@
 #ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_BUFFER_BUFFER_INSERTER_HPP
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_BUFFER_BUFFER_INSERTER_HPP
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
+#include <vector>
 
 
 #include <boost/core/ignore_unused.hpp>
@@ -24,6 +26,7 @@
 
 #include <boost/geometry/util/condition.hpp>
 #include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 #include <boost/geometry/strategies/buffer.hpp>
 #include <boost/geometry/strategies/side.hpp>
@@ -338,6 +341,69 @@ template
 >
 struct buffer_multi
 {
+private :
+    // Creates the pieces of a block of consecutive geometries
+    template
+    <
+        typename Collection,
+        typename DistanceStrategy,
+        typename SideStrategy,
+        typename JoinStrategy,
+        typename EndStrategy,
+        typename PointStrategy,
+        typename RobustPolicy
+    >
+    struct block_task
+    {
+        block_task(Multi const& multi,
+                std::vector<Collection>& collections,
+                DistanceStrategy const& distance_strategy,
+                SideStrategy const& side_strategy,
+                JoinStrategy const& join_strategy,
+                EndStrategy const& end_strategy,
+                PointStrategy const& point_strategy,
+                RobustPolicy const& robust_policy)
+            : m_multi(multi)
+            , m_collections(collections)
+            , m_distance_strategy(distance_strategy)
+            , m_side_strategy(side_strategy)
+            , m_join_strategy(join_strategy)
+            , m_end_strategy(end_strategy)
+            , m_point_strategy(point_strategy)
+            , m_robust_policy(robust_policy)
+        {}
+
+        inline void operator()(std::size_t block) const
+        {
+            typedef typename boost::range_iterator<Multi const>::type iterator;
+
+            std::size_t const count = boost::size(m_multi);
+            std::size_t const blocks = m_collections.size();
+            std::size_t const first = block * count / blocks;
+            std::size_t const last = (block + 1) * count / blocks;
+
+            iterator it = boost::begin(m_multi);
+            std::advance(it, first);
+            for (std::size_t i = first; i < last; ++i, ++it)
+            {
+                Policy::apply(*it, m_collections[block],
+                    m_distance_strategy, m_side_strategy,
+                    m_join_strategy, m_end_strategy, m_point_strategy,
+                    m_robust_policy);
+            }
+        }
+
+        Multi const& m_multi;
+        std::vector<Collection>& m_collections;
+        DistanceStrategy const& m_distance_strategy;
+        SideStrategy const& m_side_strategy;
+        JoinStrategy const& m_join_strategy;
+        EndStrategy const& m_end_strategy;
+        PointStrategy const& m_point_strategy;
+        RobustPolicy const& m_robust_policy;
+    };
+
+public :
     template
     <
         typename Collection,
@@ -368,6 +434,131 @@ struct buffer_multi
                 robust_policy);
         }
     }
+
+    // Parallel version, the pieces of blocks of consecutive geometries are
+    // created by parallel tasks in separate collections. They're appended
+    // to the collection in the order of the geometries, so the pieces are
+    // the same as the ones created by the sequential version.
+    template
+    <
+        typename Collection,
+        typename DistanceStrategy,
+        typename SideStrategy,
+        typename JoinStrategy,
+        typename EndStrategy,
+        typename PointStrategy,
+        typename RobustPolicy
+    >
+    static inline void apply(Multi const& multi,
+            Collection& collection,
+            DistanceStrategy const& distance_strategy,
+            SideStrategy const& side_strategy,
+            JoinStrategy const& join_strategy,
+            EndStrategy const& end_strategy,
+            PointStrategy const& point_strategy,
+            RobustPolicy const& robust_policy,
+            geometry::parallel const& parallel_policy)
+    {
+        std::size_t const count = boost::size(multi);
+        std::size_t const threads
+            = geometry::detail::parallel::threads_count(parallel_policy);
+
+        if (threads <= 1 || count <= 1)
+        {
+            apply(multi, collection,
+                distance_strategy, side_strategy,
+                join_strategy, end_strategy, point_strategy,
+                robust_policy);
+            return;
+        }
+
+        // More blocks than threads, the geometries can differ in size
+        std::size_t const blocks = (std::min)(count, threads * 4);
+        std::vector<Collection> collections(blocks, Collection(robust_policy));
+
+        block_task
+            <
+                Collection,
+                DistanceStrategy, SideStrategy, JoinStrategy,
+                EndStrategy, PointStrategy, RobustPolicy
+            > task(multi, collections,
+                   distance_strategy, side_strategy,
+                   join_strategy, end_strategy, point_strategy,
+                   robust_policy);
+
+        geometry::detail::parallel::for_each_index(blocks, task, threads);
+
+        for (std::size_t i = 0; i < blocks; ++i)
+        {
+            collection.append(collections[i]);
+        }
+    }
+};
+
+// Creates the pieces of the input geometry with parallel tasks if it is
+// a multi-geometry, Dispatch is the buffer_inserter of the geometry
+template <bool IsMulti>
+struct add_pieces
+{
+    template
+    <
+        typename Dispatch,
+        typename Geometry,
+        typename Collection,
+        typename DistanceStrategy,
+        typename SideStrategy,
+        typename JoinStrategy,
+        typename EndStrategy,
+        typename PointStrategy,
+        typename RobustPolicy
+    >
+    static inline void apply(Geometry const& geometry,
+            Collection& collection,
+            DistanceStrategy const& distance_strategy,
+            SideStrategy const& side_strategy,
+            JoinStrategy const& join_strategy,
+            EndStrategy const& end_strategy,
+            PointStrategy const& point_strategy,
+            RobustPolicy const& robust_policy,
+            geometry::parallel const& )
+    {
+        Dispatch::apply(geometry, collection,
+            distance_strategy, side_strategy, join_strategy,
+            end_strategy, point_strategy,
+            robust_policy);
+    }
+};
+
+template <>
+struct add_pieces<true>
+{
+    template
+    <
+        typename Dispatch,
+        typename Geometry,
+        typename Collection,
+        typename DistanceStrategy,
+        typename SideStrategy,
+        typename JoinStrategy,
+        typename EndStrategy,
+        typename PointStrategy,
+        typename RobustPolicy
+    >
+    static inline void apply(Geometry const& geometry,
+            Collection& collection,
+            DistanceStrategy const& distance_strategy,
+            SideStrategy const& side_strategy,
+            JoinStrategy const& join_strategy,
+            EndStrategy const& end_strategy,
+            PointStrategy const& point_strategy,
+            RobustPolicy const& robust_policy,
+            geometry::parallel const& parallel_policy)
+    {
+        Dispatch::apply(geometry, collection,
+            distance_strategy, side_strategy, join_strategy,
+            end_strategy, point_strategy,
+            robust_policy, parallel_policy);
+    }
 };
 
 struct visit_pieces_default_policy
@@ -844,6 +1035,94 @@ struct buffer_inserter<multi_tag, Multi, PolygonOutput>
 namespace detail { namespace buffer
 {
 
+// The pieces are created and the turns are calculated by one thread
+struct buffer_sequential_policy
+{
+    template
+    <
+        typename Dispatch,
+        typename Geometry,
+        typename Collection,
+        typename DistanceStrategy,
+        typename SideStrategy,
+        typename JoinStrategy,
+        typename EndStrategy,
+        typename PointStrategy,
+        typename RobustPolicy
+    >
+    inline void add_pieces(Geometry const& geometry,
+            Collection& collection,
+            DistanceStrategy const& distance_strategy,
+            SideStrategy const& side_strategy,
+            JoinStrategy const& join_strategy,
+            EndStrategy const& end_strategy,
+            PointStrategy const& point_strategy,
+            RobustPolicy const& robust_policy) const
+    {
+        Dispatch::apply(geometry, collection,
+            distance_strategy, side_strategy, join_strategy,
+            end_strategy, point_strategy,
+            robust_policy);
+    }
+
+    template <typename Collection>
+    inline void get_turns(Collection& collection) const
+    {
+        collection.get_turns();
+    }
+};
+
+// The pieces of multi-geometries are created and the turns are calculated
+// and located in the pieces by parallel tasks
+struct buffer_parallel_policy
+{
+    explicit buffer_parallel_policy(geometry::parallel const& parallel_policy)
+        : m_parallel_policy(parallel_policy)
+    {}
+
+    template
+    <
+        typename Dispatch,
+        typename Geometry,
+        typename Collection,
+        typename DistanceStrategy,
+        typename SideStrategy,
+        typename JoinStrategy,
+        typename EndStrategy,
+        typename PointStrategy,
+        typename RobustPolicy
+    >
+    inline void add_pieces(Geometry const& geometry,
+            Collection& collection,
+            DistanceStrategy const& distance_strategy,
+            SideStrategy const& side_strategy,
+            JoinStrategy const& join_strategy,
+            EndStrategy const& end_strategy,
+            PointStrategy const& point_strategy,
+            RobustPolicy const& robust_policy) const
+    {
+        static const bool is_multi = boost::is_same
+            <
+                typename tag_cast<typename tag<Geometry>::type, multi_tag>::type,
+                multi_tag
+            >::value;
+
+        detail::buffer::add_pieces<is_multi>::template apply<Dispatch>(
+            geometry, collection,
+            distance_strategy, side_strategy, join_strategy,
+            end_strategy, point_strategy,
+            robust_policy, m_parallel_policy);
+    }
+
+    template <typename Collection>
+    inline void get_turns(Collection& collection) const
+    {
+        collection.get_turns(m_parallel_policy);
+    }
+
+    geometry::parallel m_parallel_policy;
+};
+
 template
 <
     typename GeometryOutput,
@@ -855,7 +1134,8 @@ template
     typename EndStrategy,
     typename PointStrategy,
     typename RobustPolicy,
-    typename VisitPiecesPolicy
+    typename VisitPiecesPolicy,
+    typename ExecutionPolicy
 >
 inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator out,
         DistanceStrategy const& distance_strategy,
@@ -864,7 +1144,8 @@ inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator
         EndStrategy const& end_strategy,
         PointStrategy const& point_strategy,
         RobustPolicy const& robust_policy,
-        VisitPiecesPolicy& visit_pieces_policy
+        VisitPiecesPolicy& visit_pieces_policy,
+        ExecutionPolicy const& execution_policy
     )
 {
     boost::ignore_unused(visit_pieces_policy);
@@ -888,7 +1169,7 @@ inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator
             linear_tag
         >::type::value;
 
-    dispatch::buffer_inserter
+    typedef dispatch::buffer_inserter
         <
             typename tag_cast
                 <
@@ -897,12 +1178,15 @@ inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator
                 >::type,
             GeometryInput,
             GeometryOutput
-        >::apply(geometry_input, collection,
+        > dispatch_type;
+
+    execution_policy.template add_pieces<dispatch_type>(geometry_input,
+            collection,
             distance_strategy, side_strategy, join_strategy,
             end_strategy, point_strategy,
             robust_policy);
 
-    collection.get_turns();
+    execution_policy.get_turns(collection);
     collection.classify_turns(linear);
     if (BOOST_GEOMETRY_CONDITION(areal))
     {
@@ -947,6 +1231,36 @@ inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator
     visit_pieces_policy.apply(const_collection, 1);
 }
 
+template
+<
+    typename GeometryOutput,
+    typename GeometryInput,
+    typename OutputIterator,
+    typename DistanceStrategy,
+    typename SideStrategy,
+    typename JoinStrategy,
+    typename EndStrategy,
+    typename PointStrategy,
+    typename RobustPolicy,
+    typename VisitPiecesPolicy
+>
+inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator out,
+        DistanceStrategy const& distance_strategy,
+        SideStrategy const& side_strategy,
+        JoinStrategy const& join_strategy,
+        EndStrategy const& end_strategy,
+        PointStrategy const& point_strategy,
+        RobustPolicy const& robust_policy,
+        VisitPiecesPolicy& visit_pieces_policy
+    )
+{
+    buffer_inserter<GeometryOutput>(geometry_input, out,
+        distance_strategy, side_strategy, join_strategy,
+        end_strategy, point_strategy,
+        robust_policy, visit_pieces_policy,
+        buffer_sequential_policy());
+}
+
 template
 <
     typename GeometryOutput,
@@ -49,6 +49,7 @@
 #include <boost/geometry/algorithms/detail/sections/sectionalize.hpp>
 #include <boost/geometry/algorithms/detail/sections/section_box_policies.hpp>
 
+#include <boost/geometry/util/parallel.hpp>
 #include <boost/geometry/util/range.hpp>
 
 
@@ -732,7 +733,7 @@ struct buffered_piece_collection
         }
     }
 
-    inline void get_turns()
+    inline void enlarge_sections()
     {
         for(typename boost::range_iterator<sections_type>::type it
                 = boost::begin(monotonic_sections);
@@ -741,6 +742,22 @@ struct buffered_piece_collection
         {
             enlarge_box(it->bounding_box, 1);
         }
+    }
+
+    inline void prepare_pieces()
+    {
+        insert_rescaled_piece_turns();
+
+        reverse_negative_robust_rings();
+
+        determine_properties();
+
+        prepare_buffered_point_pieces();
+    }
+
+    inline void get_turns()
+    {
+        enlarge_sections();
 
         {
             // Calculate the turns
@@ -760,13 +777,7 @@ struct buffered_piece_collection
                 >::apply(monotonic_sections, visitor);
         }
 
-        insert_rescaled_piece_turns();
-
-        reverse_negative_robust_rings();
-
-        determine_properties();
-
-        prepare_buffered_point_pieces();
+        prepare_pieces();
 
         {
             // Check if it is inside any of the pieces
@@ -785,6 +796,97 @@ struct buffered_piece_collection
         }
     }
 
+    // Parallel version, the turns are calculated and located in the pieces
+    // by parallel tasks. The turns are the same, in the same order, as the
+    // ones of the sequential version. Only the counts of the turns which are
+    // within a piece, and are discarded, can differ.
+    inline void get_turns(geometry::parallel const& parallel_policy)
+    {
+        enlarge_sections();
+
+        {
+            parallel_piece_turn_visitor
+                <
+                    piece_vector_type,
+                    buffered_ring_collection<buffered_ring<Ring> >,
+                    turn_vector_type,
+                    RobustPolicy
+                > visitor(m_pieces, offsetted_rings, m_robust_policy);
+
+            geometry::partition
+                <
+                    robust_box_type,
+                    detail::section::get_section_box,
+                    detail::section::overlaps_section_box
+                >::apply(monotonic_sections, visitor, parallel_policy);
+
+            m_turns.swap(visitor.m_turns);
+        }
+
+        prepare_pieces();
+
+        {
+            parallel_turn_in_piece_visitor
+                <
+                    turn_vector_type, piece_vector_type
+                > visitor(m_turns, m_pieces);
+
+            geometry::partition
+                <
+                    robust_box_type,
+                    turn_get_box, turn_ovelaps_box,
+                    piece_get_box, piece_ovelaps_box
+                >::apply(m_turns, m_pieces, visitor, parallel_policy);
+
+            visitor.add_counts(m_turns);
+        }
+    }
+
+    // Appends the pieces, offsetted rings and originals of another
+    // collection, created for the next geometries of the input (e.g. the
+    // next polygons of a multi-polygon). The indices of the pieces and
+    // rings are shifted, so the result is the same as if the pieces were
+    // added to this collection.
+    inline void append(this_type const& other)
+    {
+        BOOST_GEOMETRY_ASSERT(m_turns.empty() && other.m_turns.empty());
+
+        signed_size_type const piece_offset
+            = static_cast<signed_size_type>(boost::size(m_pieces));
+        signed_size_type const ring_offset
+            = static_cast<signed_size_type>(boost::size(offsetted_rings));
+
+        for (typename boost::range_iterator<piece_vector_type const>::type
+                it = boost::begin(other.m_pieces);
+            it != boost::end(other.m_pieces);
+            ++it)
+        {
+            m_pieces.push_back(*it);
+            piece& pc = m_pieces.back();
+            pc.index += piece_offset;
+            pc.left_index += piece_offset;
+            pc.right_index += piece_offset;
+            pc.first_seg_id.multi_index += ring_offset;
+        }
+
+        for (typename boost::range_iterator<sections_type const>::type
+                it = boost::begin(other.monotonic_sections);
+            it != boost::end(other.monotonic_sections);
+            ++it)
+        {
+            monotonic_sections.push_back(*it);
+            monotonic_sections.back().ring_id.source_index += piece_offset;
+            monotonic_sections.back().ring_id.multi_index += ring_offset;
+        }
+
+        offsetted_rings.insert(offsetted_rings.end(),
+                boost::begin(other.offsetted_rings),
+                boost::end(other.offsetted_rings));
+        robust_originals.insert(robust_originals.end(),
+                boost::begin(other.robust_originals),
+                boost::end(other.robust_originals));
+    }
+
     inline void start_new_ring()
     {
         signed_size_type const n = static_cast<signed_size_type>(offsetted_rings.size());
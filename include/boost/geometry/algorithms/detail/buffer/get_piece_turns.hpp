@@ -9,6 +9,9 @@
 #ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_BUFFER_GET_PIECE_TURNS_HPP
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_BUFFER_GET_PIECE_TURNS_HPP
 
+#include <algorithm>
+#include <iterator>
+
 #include <boost/range.hpp>
 
 #include <boost/geometry/algorithms/equals.hpp>
@@ -16,6 +19,7 @@
 #include <boost/geometry/algorithms/detail/disjoint/box_box.hpp>
 #include <boost/geometry/algorithms/detail/overlay/segment_identifier.hpp>
 #include <boost/geometry/algorithms/detail/overlay/get_turn_info.hpp>
+#include <boost/geometry/algorithms/detail/partition.hpp>
 #include <boost/geometry/algorithms/detail/sections/section_functions.hpp>
 #include <boost/geometry/algorithms/detail/buffer/buffer_policies.hpp>
 
@@ -285,6 +289,56 @@ public:
 };
 
 
+// Visitor used by the parallel partition, the visitor of each task
+// collects the turns in its own container. They're joined in the order
+// in which the sequential piece_turn_visitor would add them.
+template
+<
+    typename Pieces,
+    typename Rings,
+    typename Turns,
+    typename RobustPolicy
+>
+struct parallel_piece_turn_visitor
+{
+    Pieces const& m_pieces;
+    Rings const& m_rings;
+    Turns m_turns;
+    RobustPolicy const& m_robust_policy;
+
+    parallel_piece_turn_visitor(Pieces const& pieces,
+            Rings const& ring_collection,
+            RobustPolicy const& robust_policy)
+        : m_pieces(pieces)
+        , m_rings(ring_collection)
+        , m_robust_policy(robust_policy)
+    {}
+
+    parallel_piece_turn_visitor(parallel_piece_turn_visitor const& other,
+            detail::partition::split)
+        : m_pieces(other.m_pieces)
+        , m_rings(other.m_rings)
+        , m_robust_policy(other.m_robust_policy)
+    {}
+
+    template <typename Section>
+    inline void apply(Section const& section1, Section const& section2,
+                    bool first = true)
+    {
+        piece_turn_visitor
+            <
+                Pieces, Rings, Turns, RobustPolicy
+            > visitor(m_pieces, m_rings, m_turns, m_robust_policy);
+        visitor.apply(section1, section2, first);
+    }
+
+    inline void join(parallel_piece_turn_visitor const& other)
+    {
+        std::copy(boost::begin(other.m_turns), boost::end(other.m_turns),
+                  std::back_inserter(m_turns));
+    }
+};
+
 }} // namespace detail::buffer
 #endif // DOXYGEN_NO_DETAIL
 
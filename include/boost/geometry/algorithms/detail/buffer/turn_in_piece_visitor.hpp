@@ -10,6 +10,9 @@
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_BUFFER_TURN_IN_PIECE_VISITOR
 
 
+#include <utility>
+#include <vector>
+
 #include <boost/core/ignore_unused.hpp>
 
 #include <boost/range.hpp>
@@ -25,6 +28,7 @@
 #include <boost/geometry/algorithms/detail/disjoint/box_box.hpp>
 #include <boost/geometry/algorithms/detail/overlay/segment_identifier.hpp>
 #include <boost/geometry/algorithms/detail/overlay/get_turn_info.hpp>
+#include <boost/geometry/algorithms/detail/partition.hpp>
 #include <boost/geometry/policies/compare.hpp>
 #include <boost/geometry/strategies/buffer.hpp>
 #include <boost/geometry/algorithms/detail/buffer/buffer_policies.hpp>
@@ -681,37 +685,30 @@ public:
         , m_pieces(pieces)
     {}
 
+    // Returns the location of the turn with respect to the piece,
+    // analyse_disjoint if it doesn't change any of the counts of the turn
     template <typename Turn, typename Piece>
-    inline void apply(Turn const& turn, Piece const& piece, bool first = true)
+    inline analyse_result analyse(Turn const& turn, Piece const& piece) const
     {
-        boost::ignore_unused_variable_warning(first);
-
-        if (turn.count_within > 0)
-        {
-            // Already inside - no need to check again
-            return;
-        }
-
         if (piece.type == strategy::buffer::buffered_flat_end
             || piece.type == strategy::buffer::buffered_concave)
         {
             // Turns cannot be located within flat-end or concave pieces
-            return;
+            return analyse_disjoint;
         }
 
         if (! geometry::covered_by(turn.robust_point, piece.robust_envelope))
         {
             // Easy check: if the turn is not in the envelope, we can safely return
-            return;
+            return analyse_disjoint;
         }
 
         if (skip(turn.operations[0], piece) || skip(turn.operations[1], piece))
         {
-            return;
+            return analyse_disjoint;
         }
 
         // TODO: mutable_piece to make some on-demand preparations in analyse
-        Turn& mutable_turn = m_turns[turn.turn_index];
 
         if (piece.type == geometry::strategy::buffer::buffered_point)
         {
@@ -728,12 +725,11 @@ public:
 
             if (cd < piece.robust_min_comparable_radius)
             {
-                mutable_turn.count_within++;
-                return;
+                return analyse_within;
             }
             if (cd > piece.robust_max_comparable_radius)
             {
-                return;
+                return analyse_disjoint;
             }
         }
 
@@ -745,21 +741,13 @@ public:
         switch(analyse_code)
         {
             case analyse_disjoint :
-                return;
             case analyse_on_offsetted :
-                mutable_turn.count_on_offsetted++; // value is not used anymore
-                return;
             case analyse_on_original_boundary :
-                mutable_turn.count_on_original_boundary++;
-                return;
             case analyse_within :
-                mutable_turn.count_within++;
-                return;
 #if ! defined(BOOST_GEOMETRY_BUFFER_USE_SIDE_OF_INTERSECTION)
             case analyse_near_offsetted :
-                mutable_turn.count_within_near_offsetted++;
-                return;
 #endif
+                return analyse_code;
             default :
                 break;
         }
@@ -782,9 +770,109 @@ public:
         int geometry_code = detail::within::point_in_geometry(turn.robust_point, piece.robust_ring);
 #endif
 
-        if (geometry_code == 1)
+        return geometry_code == 1 ? analyse_within : analyse_disjoint;
+    }
+
+    // Updates the counts of the turn with the result of analyse()
+    template <typename Turn>
+    static inline void add_count(Turn& turn, analyse_result code)
+    {
+        switch(code)
+        {
+            case analyse_on_offsetted :
+                turn.count_on_offsetted++; // value is not used anymore
+                return;
+            case analyse_on_original_boundary :
+                turn.count_on_original_boundary++;
+                return;
+            case analyse_within :
+                turn.count_within++;
+                return;
+#if ! defined(BOOST_GEOMETRY_BUFFER_USE_SIDE_OF_INTERSECTION)
+            case analyse_near_offsetted :
+                turn.count_within_near_offsetted++;
+                return;
+#endif
+            default :
+                return;
+        }
+    }
+
+    template <typename Turn, typename Piece>
+    inline void apply(Turn const& turn, Piece const& piece, bool first = true)
+    {
+        boost::ignore_unused_variable_warning(first);
+
+        if (turn.count_within > 0)
+        {
+            // Already inside - no need to check again
+            return;
+        }
+
+        analyse_result const code = analyse(turn, piece);
+        if (code != analyse_disjoint)
+        {
+            add_count(m_turns[turn.turn_index], code);
+        }
+    }
+};
+
+
+// Visitor used by the parallel partition. The turns can't be changed by
+// the tasks, so each task collects the counts to add in its own container
+// and they're added to the turns afterwards by add_counts().
+// Because the turns are not updated during the partition, turns which
+// are already within a piece are not skipped. Their other counts (e.g.
+// count_within_near_offsetted) can then become non-zero where the
+// sequential ones stay zero, depending on the order of the pieces. But
+// count_within of these turns is non-zero in both versions, so they're
+// located inside the buffer and discarded and the other counts are not
+// used. The other turns are counted in the same way.
+template <typename Turns, typename Pieces>
+class parallel_turn_in_piece_visitor
+{
+    typedef turn_in_piece_visitor<Turns, Pieces> visitor_type;
+    typedef std::pair<std::size_t, analyse_result> count_type;
+
+    visitor_type m_visitor;
+    std::vector<count_type> m_counts;
+
+public:
+
+    inline parallel_turn_in_piece_visitor(Turns& turns, Pieces const& pieces)
+        : m_visitor(turns, pieces)
+    {}
+
+    inline parallel_turn_in_piece_visitor(
+            parallel_turn_in_piece_visitor const& other,
+            detail::partition::split)
+        : m_visitor(other.m_visitor)
+    {}
+
+    template <typename Turn, typename Piece>
+    inline void apply(Turn const& turn, Piece const& piece, bool first = true)
+    {
+        boost::ignore_unused_variable_warning(first);
+
+        analyse_result const code = m_visitor.analyse(turn, piece);
+        if (code != analyse_disjoint)
+        {
+            m_counts.push_back(count_type(turn.turn_index, code));
+        }
+    }
+
+    inline void join(parallel_turn_in_piece_visitor const& other)
+    {
+        m_counts.insert(m_counts.end(),
+                other.m_counts.begin(), other.m_counts.end());
+    }
+
+    inline void add_counts(Turns& turns) const
+    {
+        for (typename std::vector<count_type>::const_iterator it
+                = m_counts.begin(); it != m_counts.end(); ++it)
         {
-            mutable_turn.count_within++;
+            visitor_type::add_count(turns[it->first], it->second);
         }
     }
 };
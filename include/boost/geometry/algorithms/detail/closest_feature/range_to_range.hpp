@@ -10,15 +10,31 @@
 #ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_CLOSEST_FEATURE_RANGE_TO_RANGE_HPP
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_CLOSEST_FEATURE_RANGE_TO_RANGE_HPP
 
+#include <algorithm>
 #include <cstddef>
 
 #include <iterator>
 #include <utility>
+#include <vector>
 
+#include <boost/core/ignore_unused.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/assert.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/cs.hpp>
 #include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/tags.hpp>
+#include <boost/geometry/geometries/box.hpp>
 #include <boost/geometry/strategies/distance.hpp>
+#include <boost/geometry/strategies/tags.hpp>
+#include <boost/geometry/algorithms/detail/distance/segment_to_box.hpp>
 #include <boost/geometry/algorithms/dispatch/distance.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/expand.hpp>
 #include <boost/geometry/index/rtree.hpp>
 
 
@@ -36,6 +52,317 @@ namespace detail { namespace closest_feature
 class range_to_range_rtree
 {
 private:
+    // Long query ranges are divided in blocks of consecutive objects,
+    // which are close to each other in linear and areal geometries
+    static const std::size_t block_size = 16;
+
+    template <typename Iterator, typename Distance>
+    struct query_block
+    {
+        typedef typename point_type
+            <
+                typename std::iterator_traits<Iterator>::value_type
+            >::type point_type;
+        typedef model::box<point_type> box_type;
+
+        Iterator first;
+        std::size_t count;
+        box_type box;
+
+        // the distance to the nearest object of the r-tree, it is a lower
+        // bound of the distances of the objects in the block
+        Distance lower_bound;
+
+        inline bool operator<(query_block const& other) const
+        {
+            return lower_bound < other.lower_bound;
+        }
+    };
+
+    // The blocks are only used in cartesian coordinate systems, in which
+    // the boxes and the distances to the boxes are well defined
+    template <typename RTreeValueType, typename QueryRangeIterator>
+    struct use_blocks
+        : boost::mpl::bool_
+            <
+                boost::is_same
+                    <
+                        typename cs_tag<RTreeValueType>::type,
+                        cartesian_tag
+                    >::value
+                && boost::is_same
+                    <
+                        typename cs_tag
+                            <
+                                typename std::iterator_traits
+                                    <
+                                        QueryRangeIterator
+                                    >::value_type
+                            >::type,
+                        cartesian_tag
+                    >::value
+            >
+    {};
+
+    // The point of the box closest to the point
+    template <std::size_t Dimension, std::size_t DimensionCount>
+    struct closest_point_of_box
+    {
+        template <typename Point, typename Box>
+        static inline void apply(Point const& point, Box const& box,
+                                 Point& result)
+        {
+            typedef typename coordinate_type<Point>::type coordinate_type;
+
+            coordinate_type const c = geometry::get<Dimension>(point);
+            coordinate_type const min_c = geometry::get<min_corner, Dimension>(box);
+            coordinate_type const max_c = geometry::get<max_corner, Dimension>(box);
+            geometry::set<Dimension>(result,
+                c < min_c ? min_c : (max_c < c ? max_c : c));
+
+            closest_point_of_box
+                <
+                    Dimension + 1, DimensionCount
+                >::apply(point, box, result);
+        }
+    };
+
+    template <std::size_t DimensionCount>
+    struct closest_point_of_box<DimensionCount, DimensionCount>
+    {
+        template <typename Point, typename Box>
+        static inline void apply(Point const&, Box const&, Point&)
+        {}
+    };
+
+    // The distance of the object of the r-tree to the box of a block,
+    // calculated with the strategy used for the objects so it can be
+    // compared with their distances
+    template
+    <
+        typename RTreeValueType,
+        typename Box,
+        typename Strategy,
+        typename Tag = typename tag<RTreeValueType>::type,
+        typename StrategyTag = typename strategy::distance::services::tag
+            <
+                Strategy
+            >::type
+    >
+    struct block_distance
+    {
+        template <typename Distance>
+        static inline void apply(RTreeValueType const& value, Box const& box,
+                                 Strategy const& strategy, Distance& result)
+        {
+            result = dispatch::distance
+                <
+                    RTreeValueType, Box, Strategy
+                >::apply(value, box, strategy);
+        }
+    };
+
+    template <typename Point, typename Box, typename Strategy>
+    struct block_distance
+        <
+            Point, Box, Strategy,
+            point_tag, strategy_tag_distance_point_point
+        >
+    {
+        template <typename Distance>
+        static inline void apply(Point const& point, Box const& box,
+                                 Strategy const& strategy, Distance& result)
+        {
+            Point closest = point;
+            closest_point_of_box
+                <
+                    0, dimension<Point>::value
+                >::apply(point, box, closest);
+            result = strategy.apply(point, closest);
+        }
+    };
+
+    // a point-segment strategy gives the distance to the degenerated segment
+    template <typename Point, typename Box, typename Strategy>
+    struct block_distance
+        <
+            Point, Box, Strategy,
+            point_tag, strategy_tag_distance_point_segment
+        >
+    {
+        template <typename Distance>
+        static inline void apply(Point const& point, Box const& box,
+                                 Strategy const& strategy, Distance& result)
+        {
+            Point closest = point;
+            closest_point_of_box
+                <
+                    0, dimension<Point>::value
+                >::apply(point, box, closest);
+            result = strategy.apply(point, closest, closest);
+        }
+    };
+
+    // Finds the nearest object of the r-tree of the query object, returns
+    // true if the minimum is updated
+    template
+    <
+        typename RTree,
+        typename QueryRangeIterator,
+        typename Strategy,
+        typename Distance
+    >
+    static inline bool nearest(RTree const& rt,
+                               QueryRangeIterator qit,
+                               Strategy const& strategy,
+                               typename RTree::value_type& rtree_min,
+                               QueryRangeIterator& qit_min,
+                               Distance& dist_min,
+                               bool& first)
+    {
+        typedef typename RTree::value_type rtree_value_type;
+
+        rtree_value_type t_v;
+        std::size_t n = rt.query(index::nearest(*qit, 1), &t_v);
+
+        BOOST_GEOMETRY_ASSERT( n > 0 );
+        // n above is unused outside BOOST_GEOMETRY_ASSERT,
+        // hence the call to boost::ignore_unused below
+        //
+        // however, t_v (initialized by the call to rt.query(...))
+        // is used below, which is why we cannot put the call to
+        // rt.query(...) inside BOOST_GEOMETRY_ASSERT
+        boost::ignore_unused(n);
+
+        Distance dist = dispatch::distance
+            <
+                rtree_value_type,
+                typename std::iterator_traits
+                    <
+                        QueryRangeIterator
+                    >::value_type,
+                Strategy
+            >::apply(t_v, *qit, strategy);
+
+        if (first || dist < dist_min)
+        {
+            first = false;
+            dist_min = dist;
+            rtree_min = t_v;
+            qit_min = qit;
+            return true;
+        }
+        return false;
+    }
+
+    template
+    <
+        typename RTree,
+        typename QueryRangeIterator,
+        typename Strategy,
+        typename Distance
+    >
+    static inline void apply(RTree const& rt,
+                             QueryRangeIterator queries_first,
+                             QueryRangeIterator queries_last,
+                             Strategy const& strategy,
+                             typename RTree::value_type& rtree_min,
+                             QueryRangeIterator& qit_min,
+                             Distance& dist_min,
+                             boost::mpl::false_)
+    {
+        bool first = true;
+        for (QueryRangeIterator qit = queries_first;
+             qit != queries_last; ++qit)
+        {
+            if (nearest(rt, qit, strategy, rtree_min, qit_min, dist_min, first)
+                && math::equals(dist_min, Distance(0)))
+            {
+                return;
+            }
+        }
+    }
+
+    // The blocks are considered in the order of their lower bounds, the
+    // search stops if the lower bound of the next block is not less than
+    // the distance found so far. The lower bounds are calculated with the
+    // strategy so they're compared with the distances directly.
+    template
+    <
+        typename RTree,
+        typename QueryRangeIterator,
+        typename Strategy,
+        typename Distance
+    >
+    static inline void apply(RTree const& rt,
+                             QueryRangeIterator queries_first,
+                             QueryRangeIterator queries_last,
+                             Strategy const& strategy,
+                             typename RTree::value_type& rtree_min,
+                             QueryRangeIterator& qit_min,
+                             Distance& dist_min,
+                             boost::mpl::true_)
+    {
+        typedef typename RTree::value_type rtree_value_type;
+        typedef query_block<QueryRangeIterator, Distance> block_type;
+        typedef block_distance
+            <
+                rtree_value_type, typename block_type::box_type, Strategy
+            > block_distance_type;
+
+        std::vector<block_type> blocks;
+        for (QueryRangeIterator qit = queries_first; qit != queries_last; )
+        {
+            block_type block;
+            block.first = qit;
+            block.count = 0;
+            geometry::envelope(*qit, block.box);
+            for ( ; qit != queries_last && block.count < block_size;
+                  ++qit, ++block.count)
+            {
+                geometry::expand(block.box, *qit);
+            }
+            blocks.push_back(block);
+        }
+
+        if (blocks.size() == 1)
+        {
+            apply(rt, queries_first, queries_last, strategy,
+                  rtree_min, qit_min, dist_min, boost::mpl::false_());
+            return;
+        }
+
+        rtree_value_type t_v;
+        for (typename std::vector<block_type>::iterator it = blocks.begin();
+             it != blocks.end(); ++it)
+        {
+            rt.query(index::nearest(it->box, 1), &t_v);
+            block_distance_type::apply(t_v, it->box, strategy,
+                                       it->lower_bound);
+        }
+        std::sort(blocks.begin(), blocks.end());
+
+        bool first = true;
+        for (typename std::vector<block_type>::const_iterator
+                it = blocks.begin(); it != blocks.end(); ++it)
+        {
+            if (! first && ! (it->lower_bound < dist_min))
+            {
+                return;
+            }
+
+            QueryRangeIterator qit = it->first;
+            for (std::size_t i = 0; i < it->count; ++i, ++qit)
+            {
+                if (nearest(rt, qit, strategy, rtree_min, qit_min, dist_min, first)
+                    && math::equals(dist_min, Distance(0)))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
     template
     <
         typename RTreeRangeIterator,
@@ -58,50 +385,14 @@ private:
         BOOST_GEOMETRY_ASSERT( rtree_first != rtree_last );
         BOOST_GEOMETRY_ASSERT( queries_first != queries_last );
 
-        Distance const zero = Distance(0);
-        dist_min = zero;
+        dist_min = Distance(0);
 
         // create -- packing algorithm
         rtree_type rt(rtree_first, rtree_last);
 
-        RTreeValueType t_v;
-        bool first = true;
-
-        for (QueryRangeIterator qit = queries_first;
-             qit != queries_last; ++qit, first = false)
-        {
-            std::size_t n = rt.query(index::nearest(*qit, 1), &t_v);
-
-            BOOST_GEOMETRY_ASSERT( n > 0 );
-            // n above is unused outside BOOST_GEOMETRY_ASSERT,
-            // hence the call to boost::ignore_unused below
-            //
-            // however, t_v (initialized by the call to rt.query(...))
-            // is used below, which is why we cannot put the call to
-            // rt.query(...) inside BOOST_GEOMETRY_ASSERT
-            boost::ignore_unused(n);
-
-            Distance dist = dispatch::distance
-                <
-                    RTreeValueType,
-                    typename std::iterator_traits
-                        <
-                            QueryRangeIterator
-                        >::value_type,
-                    Strategy
-                >::apply(t_v, *qit, strategy);
-
-            if (first || dist < dist_min)
-            {
-                dist_min = dist;
-                rtree_min = t_v;
-                qit_min = qit;
-                if ( math::equals(dist_min, zero) )
-                {
-                    return;
-                }
-            }
-        }
+        apply(rt, queries_first, queries_last, strategy,
+              rtree_min, qit_min, dist_min,
+              use_blocks<RTreeValueType, QueryRangeIterator>());
     }
 
 public:
@@ -148,6 +439,41 @@ public:
     }
 
 
+    // uses an existing r-tree, which may be reused for several query ranges
+    template
+    <
+        typename RTree,
+        typename QueryRangeIterator,
+        typename Strategy,
+        typename Distance
+    >
+    static inline std::pair
+        <
+            typename RTree::value_type, QueryRangeIterator
+        > apply(RTree const& rt,
+                QueryRangeIterator queries_first,
+                QueryRangeIterator queries_last,
+                Strategy const& strategy,
+                Distance& dist_min)
+    {
+        typedef typename RTree::value_type rtree_value_type;
+
+        BOOST_GEOMETRY_ASSERT( ! rt.empty() );
+        BOOST_GEOMETRY_ASSERT( queries_first != queries_last );
+
+        dist_min = Distance(0);
+
+        rtree_value_type rtree_min;
+        QueryRangeIterator qit_min;
+
+        apply(rt, queries_first, queries_last, strategy,
+              rtree_min, qit_min, dist_min,
+              use_blocks<rtree_value_type, QueryRangeIterator>());
+
+        return std::make_pair(rtree_min, qit_min);
+    }
+
+
     template
     <
         typename RTreeRangeIterator,
@@ -0,0 +1,436 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_DISTANCE_MATRIX_GEOGRAPHIC_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_DETAIL_DISTANCE_MATRIX_GEOGRAPHIC_HPP
+
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <boost/range.hpp>
+
+#include <boost/geometry/core/radian_access.hpp>
+#include <boost/geometry/core/radius.hpp>
+
+#include <boost/geometry/algorithms/detail/flattening.hpp>
+#include <boost/geometry/algorithms/detail/vincenty_inverse.hpp>
+#include <boost/geometry/algorithms/detail/distance_matrix/kernel.hpp>
+
+#include <boost/geometry/strategies/geographic/distance_andoyer.hpp>
+#include <boost/geometry/strategies/geographic/distance_thomas.hpp>
+#include <boost/geometry/strategies/geographic/distance_vincenty.hpp>
+
+#include <boost/geometry/util/math.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace distance_matrix
+{
+
+
+// The sines and cosines of the halves of the coordinates of the points,
+// stored in separate arrays. The sines and cosines of the half sums and
+// half differences of the coordinates of two points are calculated from
+// them without calling trigonometric functions.
+template <typename CT>
+class half_angles
+{
+public :
+    inline void reserve(std::size_t count)
+    {
+        m_sin_lon.reserve(count);
+        m_cos_lon.reserve(count);
+        m_sin_lat.reserve(count);
+        m_cos_lat.reserve(count);
+    }
+
+    inline void push_back(CT const& lon, CT const& lat)
+    {
+        m_sin_lon.push_back(sin(lon / CT(2)));
+        m_cos_lon.push_back(cos(lon / CT(2)));
+        m_sin_lat.push_back(sin(lat / CT(2)));
+        m_cos_lat.push_back(cos(lat / CT(2)));
+    }
+
+    inline std::size_t size() const
+    {
+        return m_sin_lon.size();
+    }
+
+    inline CT const* sin_lon() const { return data(m_sin_lon); }
+    inline CT const* cos_lon() const { return data(m_cos_lon); }
+    inline CT const* sin_lat() const { return data(m_sin_lat); }
+    inline CT const* cos_lat() const { return data(m_cos_lat); }
+
+private :
+    static inline CT const* data(std::vector<CT> const& v)
+    {
+        return v.empty() ? NULL : &v[0];
+    }
+
+    std::vector<CT> m_sin_lon;
+    std::vector<CT> m_cos_lon;
+    std::vector<CT> m_sin_lat;
+    std::vector<CT> m_cos_lat;
+};
+
+
+// Andoyer: the longitudes and latitudes are used directly, the inner loop
+// calls only sqrt and atan and has no branches, so it may be vectorized
+template
+<
+    typename Point, typename Range,
+    typename Spheroid, typename CalculationType
+>
+class kernel
+    <
+        Point, Range,
+        strategy::distance::andoyer<Spheroid, CalculationType>
+    >
+{
+    typedef strategy::distance::andoyer<Spheroid, CalculationType> strategy_type;
+    typedef typename boost::range_value<Range>::type range_point_type;
+
+public :
+    typedef typename strategy_type::template calculation_type
+        <
+            Point, range_point_type
+        >::type result_type;
+
+    inline kernel(Range const& range, strategy_type const& strategy)
+        : m_radius_a(get_radius<0>(strategy.model()))
+        , m_flattening(geometry::detail::flattening<result_type>(strategy.model()))
+    {
+        m_points.reserve(boost::size(range));
+        for (typename boost::range_iterator<Range const>::type
+                it = boost::begin(range);
+             it != boost::end(range);
+             ++it)
+        {
+            m_points.push_back(result_type(get_as_radian<0>(*it)),
+                               result_type(get_as_radian<1>(*it)));
+        }
+    }
+
+    inline std::size_t size() const
+    {
+        return m_points.size();
+    }
+
+    inline void apply(Point const& point, result_type* out) const
+    {
+        typedef result_type CT;
+
+        CT const c0 = 0;
+        CT const c1 = 1;
+        CT const c2 = 2;
+        CT const c3 = 3;
+        CT const eps = std::numeric_limits<CT>::epsilon();
+
+        CT const lon1 = get_as_radian<0>(point);
+        CT const lat1 = get_as_radian<1>(point);
+        CT const sin_lon1 = sin(lon1 / c2);
+        CT const cos_lon1 = cos(lon1 / c2);
+        CT const sin_lat1 = sin(lat1 / c2);
+        CT const cos_lat1 = cos(lat1 / c2);
+
+        CT const* const sin_lon2 = m_points.sin_lon();
+        CT const* const cos_lon2 = m_points.cos_lon();
+        CT const* const sin_lat2 = m_points.sin_lat();
+        CT const* const cos_lat2 = m_points.cos_lat();
+
+        CT const radius_a = m_radius_a;
+        CT const flattening = m_flattening;
+        std::size_t const count = m_points.size();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // G = (lat1 - lat2) / 2, F = (lat1 + lat2) / 2,
+            // lambda = (lon1 - lon2) / 2
+            CT const sinG = sin_lat1 * cos_lat2[i] - cos_lat1 * sin_lat2[i];
+            CT const cosG = cos_lat1 * cos_lat2[i] + sin_lat1 * sin_lat2[i];
+            CT const sinF = sin_lat1 * cos_lat2[i] + cos_lat1 * sin_lat2[i];
+            CT const cosF = cos_lat1 * cos_lat2[i] - sin_lat1 * sin_lat2[i];
+            CT const sinL = sin_lon1 * cos_lon2[i] - cos_lon1 * sin_lon2[i];
+            CT const cosL = cos_lon1 * cos_lon2[i] + sin_lon1 * sin_lon2[i];
+
+            CT const sinG2 = sinG * sinG;
+            CT const cosG2 = cosG * cosG;
+            CT const sinF2 = sinF * sinF;
+            CT const cosF2 = cosF * cosF;
+            CT const sinL2 = sinL * sinL;
+            CT const cosL2 = cosL * cosL;
+
+            CT const S = sinG2 * cosL2 + cosF2 * sinL2;
+            CT const C = cosG2 * cosL2 + sinF2 * sinL2;
+
+            CT const omega = atan(math::sqrt(S / C));
+            CT const r3 = c3 * math::sqrt(S * C) / omega;
+            CT const D = c2 * omega * radius_a;
+            CT const H1 = (r3 - c1) / (c2 * C);
+            CT const H2 = (r3 + c1) / (c2 * S);
+
+            CT const distance
+                = D * (c1 + flattening * (H1 * sinF2 * cosG2 - H2 * cosF2 * sinG2));
+
+            // The same points, or S or C equal to 0 (the values calculated
+            // for them are not finite and are not used)
+            out[i] = math::abs(S) <= eps || math::abs(C) <= eps ? c0 : distance;
+        }
+    }
+
+private :
+    result_type m_radius_a;
+    result_type m_flattening;
+    half_angles<result_type> m_points;
+};
+
+
+// Thomas: the reduced latitudes are calculated once for each point, the
+// inner loop calls only sqrt and asin and has no branches
+template
+<
+    typename Point, typename Range,
+    typename Spheroid, typename CalculationType
+>
+class kernel
+    <
+        Point, Range,
+        strategy::distance::thomas<Spheroid, CalculationType>
+    >
+{
+    typedef strategy::distance::thomas<Spheroid, CalculationType> strategy_type;
+    typedef typename boost::range_value<Range>::type range_point_type;
+
+public :
+    typedef typename strategy_type::template calculation_type
+        <
+            Point, range_point_type
+        >::type result_type;
+
+    inline kernel(Range const& range, strategy_type const& strategy)
+        : m_radius_a(get_radius<0>(strategy.model()))
+        , m_flattening(geometry::detail::flattening<result_type>(strategy.model()))
+    {
+        m_points.reserve(boost::size(range));
+        for (typename boost::range_iterator<Range const>::type
+                it = boost::begin(range);
+             it != boost::end(range);
+             ++it)
+        {
+            m_points.push_back(result_type(get_as_radian<0>(*it)),
+                               reduced_latitude(get_as_radian<1>(*it)));
+        }
+    }
+
+    inline std::size_t size() const
+    {
+        return m_points.size();
+    }
+
+    inline void apply(Point const& point, result_type* out) const
+    {
+        typedef result_type CT;
+
+        CT const c0 = 0;
+        CT const c1 = 1;
+        CT const c2 = 2;
+        CT const c4 = 4;
+        CT const eps = std::numeric_limits<CT>::epsilon();
+
+        CT const lon1 = get_as_radian<0>(point);
+        CT const theta1 = reduced_latitude(get_as_radian<1>(point));
+        CT const sin_lon1 = sin(lon1 / c2);
+        CT const cos_lon1 = cos(lon1 / c2);
+        CT const sin_theta1 = sin(theta1 / c2);
+        CT const cos_theta1 = cos(theta1 / c2);
+
+        CT const* const sin_lon2 = m_points.sin_lon();
+        CT const* const cos_lon2 = m_points.cos_lon();
+        CT const* const sin_theta2 = m_points.sin_lat();
+        CT const* const cos_theta2 = m_points.cos_lat();
+
+        CT const radius_a = m_radius_a;
+        CT const f = m_flattening;
+        std::size_t const count = m_points.size();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // theta_m = (theta1 + theta2) / 2, d_theta_m = (theta2 - theta1) / 2,
+            // d_lambda_m = (lon2 - lon1) / 2
+            CT const sin_theta_m = sin_theta1 * cos_theta2[i] + cos_theta1 * sin_theta2[i];
+            CT const cos_theta_m = cos_theta1 * cos_theta2[i] - sin_theta1 * sin_theta2[i];
+            CT const sin_d_theta_m = sin_theta2[i] * cos_theta1 - cos_theta2[i] * sin_theta1;
+            CT const cos_d_theta_m = cos_theta1 * cos_theta2[i] + sin_theta1 * sin_theta2[i];
+            CT const sin_d_lambda_m = sin_lon2[i] * cos_lon1 - cos_lon2[i] * sin_lon1;
+
+            CT const sin2_theta_m = sin_theta_m * sin_theta_m;
+            CT const cos2_theta_m = cos_theta_m * cos_theta_m;
+            CT const sin2_d_theta_m = sin_d_theta_m * sin_d_theta_m;
+            CT const cos2_d_theta_m = cos_d_theta_m * cos_d_theta_m;
+            CT const sin2_d_lambda_m = sin_d_lambda_m * sin_d_lambda_m;
+
+            CT const H = cos2_theta_m - sin2_d_theta_m;
+            CT const L = sin2_d_theta_m + H * sin2_d_lambda_m;
+            CT const one_minus_L = c1 - L;
+
+            // cos_d = 1 - 2L, d = acos(cos_d) and sin_d = sin(d), calculated
+            // without the loss of precision of acos near 1
+            CT const d = c2 * asin(math::sqrt(L));
+            CT const sin_d = c2 * math::sqrt(L * one_minus_L);
+
+            CT const U = c2 * sin2_theta_m * cos2_d_theta_m / one_minus_L;
+            CT const V = c2 * sin2_d_theta_m * cos2_theta_m / L;
+            CT const X = U + V;
+            CT const Y = U - V;
+            CT const T = d / sin_d;
+
+            CT const delta1d = f * (T * X - Y) / c4;
+            CT const distance = radius_a * sin_d * (T - delta1d);
+
+            out[i] = math::abs(sin_d) <= eps
+                  || math::abs(L) <= eps
+                  || math::abs(one_minus_L) <= eps
+                   ? c0 : distance;
+        }
+    }
+
+private :
+    template <typename T>
+    inline result_type reduced_latitude(T const& lat) const
+    {
+        typedef result_type CT;
+        CT const pi_half = math::pi<CT>() / CT(2);
+        return math::equals(lat, pi_half) ? CT(lat) :
+               math::equals(lat, -pi_half) ? CT(lat) :
+               atan((CT(1) - m_flattening) * tan(CT(lat)));
+    }
+
+    result_type m_radius_a;
+    result_type m_flattening;
+    half_angles<result_type> m_points;
+};
+
+
+// Vincenty: the sines and cosines of the reduced latitudes are calculated
+// once for each point, the iteration is performed for each pair
+template
+<
+    typename Point, typename Range,
+    typename Spheroid, typename CalculationType
+>
+class kernel
+    <
+        Point, Range,
+        strategy::distance::vincenty<Spheroid, CalculationType>
+    >
+{
+    typedef strategy::distance::vincenty<Spheroid, CalculationType> strategy_type;
+    typedef typename boost::range_value<Range>::type range_point_type;
+
+public :
+    typedef typename strategy_type::template calculation_type
+        <
+            Point, range_point_type
+        >::type result_type;
+
+private :
+    typedef geometry::detail::vincenty_inverse
+        <
+            result_type, true, false
+        > inverse_type;
+
+    struct reduced_point
+    {
+        result_type lon, lat, sin_U, cos_U;
+    };
+
+public :
+    inline kernel(Range const& range, strategy_type const& strategy)
+        : m_radius_a(get_radius<0>(strategy.model()))
+        , m_radius_b(get_radius<2>(strategy.model()))
+        , m_flattening(geometry::detail::flattening<result_type>(strategy.model()))
+    {
+        m_points.reserve(boost::size(range));
+        for (typename boost::range_iterator<Range const>::type
+                it = boost::begin(range);
+             it != boost::end(range);
+             ++it)
+        {
+            m_points.push_back(reduce(*it));
+        }
+    }
+
+    inline std::size_t size() const
+    {
+        return m_points.size();
+    }
+
+    inline void apply(Point const& point, result_type* out) const
+    {
+        reduced_point const p1 = reduce(point);
+
+        for (typename std::vector<reduced_point>::const_iterator
+                it = m_points.begin();
+             it != m_points.end();
+             ++it, ++out)
+        {
+            if (math::equals(p1.lat, it->lat) && math::equals(p1.lon, it->lon))
+            {
+                *out = result_type(0);
+                continue;
+            }
+
+            *out = inverse_type::apply_reduced(it->lon - p1.lon,
+                                               p1.sin_U, p1.cos_U,
+                                               it->sin_U, it->cos_U,
+                                               m_radius_a, m_radius_b,
+                                               m_flattening).distance;
+        }
+    }
+
+private :
+    template <typename P>
+    inline reduced_point reduce(P const& p) const
+    {
+        typedef result_type CT;
+        CT const c1 = 1;
+
+        reduced_point result;
+        result.lon = get_as_radian<0>(p);
+        result.lat = get_as_radian<1>(p);
+
+        // U: reduced latitude, defined by tan U = (1-f) tan phi
+        CT const tan_U = (c1 - m_flattening) * tan(result.lat);
+        CT const temp_den_U = math::sqrt(c1 + math::sqr(tan_U));
+        result.cos_U = c1 / temp_den_U;
+        result.sin_U = tan_U / temp_den_U;
+        return result;
+    }
+
+    result_type m_radius_a;
+    result_type m_radius_b;
+    result_type m_flattening;
+    std::vector<reduced_point> m_points;
+};
+
+
+}} // namespace detail::distance_matrix
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_DISTANCE_MATRIX_GEOGRAPHIC_HPP
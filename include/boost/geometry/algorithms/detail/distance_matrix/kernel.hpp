@@ -0,0 +1,78 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_DISTANCE_MATRIX_KERNEL_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_DETAIL_DISTANCE_MATRIX_KERNEL_HPP
+
+
+#include <boost/range.hpp>
+
+#include <boost/geometry/strategies/distance.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace distance_matrix
+{
+
+
+// Calculates the distances between a point and all points of a range.
+// The kernel is created once for the range and may be used by many threads
+// at the same time. The specializations for the strategies of which the
+// calculation may be split calculate the values depending only on the
+// points of the range in the constructor.
+template <typename Point, typename Range, typename Strategy>
+class kernel
+{
+    typedef typename boost::range_value<Range>::type range_point_type;
+
+public :
+    typedef typename strategy::distance::services::return_type
+        <
+            Strategy, Point, range_point_type
+        >::type result_type;
+
+    inline kernel(Range const& range, Strategy const& strategy)
+        : m_range(range)
+        , m_strategy(strategy)
+    {}
+
+    inline std::size_t size() const
+    {
+        return boost::size(m_range);
+    }
+
+    // Writes size() distances to out
+    inline void apply(Point const& point, result_type* out) const
+    {
+        for (typename boost::range_iterator<Range const>::type
+                it = boost::begin(m_range);
+             it != boost::end(m_range);
+             ++it, ++out)
+        {
+            *out = m_strategy.apply(point, *it);
+        }
+    }
+
+private :
+    Range const& m_range;
+    Strategy const& m_strategy;
+};
+
+
+}} // namespace detail::distance_matrix
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_DISTANCE_MATRIX_KERNEL_HPP
@@ -21,6 +21,7 @@
 
 #include <boost/geometry/algorithms/detail/overlay/intersection_insert.hpp>
 #include <boost/geometry/policies/robustness/get_rescale_policy.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 
 namespace boost { namespace geometry
@@ -301,6 +302,68 @@ inline bool intersection(Geometry1 const& geometry1,
 }
 
 
+/*!
+\brief \brief_calc2{intersection}, using parallel tasks
+\ingroup intersection
+\details \details_calc2{intersection, spatial set theoretic intersection}.
+    The turns are calculated per pair of sections and enriched per ring by
+    parallel tasks, and the parents of the output rings are assigned by
+    parallel tasks. The traversal assembling the output rings is sequential.
+    The result is the same as the result of the sequential version.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam GeometryOut Collection of geometries (e.g. std::vector, std::deque, boost::geometry::multi*) of which
+    the value_type fulfills a \p_l_or_c concept, or it is the output geometry (e.g. for a box)
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param geometry_out The output geometry, either a multi_point, multi_polygon,
+    multi_linestring, or a box (for intersection of two boxes)
+\param parallel_policy the parallel execution policy
+
+\qbk{distinguish,parallel}
+*/
+template
+<
+    typename Geometry1,
+    typename Geometry2,
+    typename GeometryOut
+>
+inline bool intersection(Geometry1 const& geometry1,
+            Geometry2 const& geometry2,
+            GeometryOut& geometry_out,
+            geometry::parallel const& parallel_policy)
+{
+    concept::check<Geometry1 const>();
+    concept::check<Geometry2 const>();
+
+    typedef typename geometry::rescale_overlay_policy_type
+    <
+        Geometry1,
+        Geometry2
+    >::type rescale_policy_type;
+
+    rescale_policy_type robust_policy
+        = geometry::get_rescale_policy<rescale_policy_type>(geometry1,
+                                                            geometry2);
+
+    typedef strategy_intersection
+    <
+        typename cs_tag<Geometry1>::type,
+        Geometry1,
+        Geometry2,
+        typename geometry::point_type<Geometry1>::type,
+        rescale_policy_type
+    > strategy;
+
+    return dispatch::intersection
+    <
+        Geometry1,
+        Geometry2
+    >::apply(geometry1, geometry2, robust_policy, geometry_out,
+             detail::overlay::parallel_strategy<strategy>(parallel_policy));
+}
+
+
 }} // namespace boost::geometry
 
 
@@ -9,6 +9,8 @@
 #ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_ASSIGN_PARENTS_HPP
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_ASSIGN_PARENTS_HPP
 
+#include <vector>
+
 #include <boost/range.hpp>
 
 #include <boost/geometry/algorithms/area.hpp>
@@ -20,6 +22,8 @@
 
 #include <boost/geometry/geometries/box.hpp>
 
+#include <boost/geometry/util/parallel.hpp>
+
 namespace boost { namespace geometry
 {
 
@@ -155,19 +159,179 @@ struct assign_visitor
 };
 
 
+// Visitor used by the parallel partition, the parents found by the visitor
+// of each task are stored as candidates and assigned afterwards in the order
+// in which assign_visitor would assign them.
+template <typename Geometry1, typename Geometry2, typename Collection, typename RingMap>
+struct parallel_assign_visitor
+{
+    typedef typename RingMap::mapped_type ring_info_type;
+    typedef typename ring_info_type::area_type area_type;
+
+    struct candidate
+    {
+        candidate(ring_identifier const& i, ring_identifier const& p, area_type a)
+            : id(i), parent(p), parent_area(a)
+        {}
+
+        ring_identifier id;
+        ring_identifier parent;
+        area_type parent_area;
+    };
+
+    Geometry1 const& m_geometry1;
+    Geometry2 const& m_geometry2;
+    Collection const& m_collection;
+    RingMap const& m_ring_map;
+    bool m_check_for_orientation;
+    std::vector<candidate> m_candidates;
+
+    inline parallel_assign_visitor(Geometry1 const& g1, Geometry2 const& g2, Collection const& c,
+                RingMap const& map, bool check)
+        : m_geometry1(g1)
+        , m_geometry2(g2)
+        , m_collection(c)
+        , m_ring_map(map)
+        , m_check_for_orientation(check)
+    {}
+
+    inline parallel_assign_visitor(parallel_assign_visitor const& other,
+                detail::partition::split)
+        : m_geometry1(other.m_geometry1)
+        , m_geometry2(other.m_geometry2)
+        , m_collection(other.m_collection)
+        , m_ring_map(other.m_ring_map)
+        , m_check_for_orientation(other.m_check_for_orientation)
+    {}
+
+    template <typename Item>
+    inline void apply(Item const& outer, Item const& inner, bool first = true)
+    {
+        if (first && outer.abs_area < inner.abs_area)
+        {
+            // Apply with reversed arguments
+            apply(inner, outer, false);
+            return;
+        }
+
+        if (m_check_for_orientation
+         || (math::larger(outer.real_area, 0)
+          && math::smaller(inner.real_area, 0)))
+        {
+            // The map isn't modified during the partition so it can be read
+            // by the tasks, but only with find()
+            ring_info_type const& inner_in_map = m_ring_map.find(inner.id)->second;
+
+            if (geometry::within(inner_in_map.point, outer.envelope)
+               && within_selected_input(inner_in_map, outer.id, m_geometry1, m_geometry2, m_collection)
+               )
+            {
+                m_candidates.push_back(candidate(inner.id, outer.id, outer.abs_area));
+            }
+        }
+    }
+
+    inline void join(parallel_assign_visitor const& other)
+    {
+        m_candidates.insert(m_candidates.end(),
+                other.m_candidates.begin(), other.m_candidates.end());
+    }
+
+    inline void assign(RingMap& ring_map) const
+    {
+        for (typename std::vector<candidate>::const_iterator it = m_candidates.begin();
+            it != m_candidates.end(); ++it)
+        {
+            ring_info_type& inner_in_map = ring_map[it->id];
+
+            // Assign a parent if there was no earlier parent, or the newly
+            // found parent is smaller than the previous one
+            if (inner_in_map.parent.source_index == -1
+                || it->parent_area < inner_in_map.parent_area)
+            {
+                inner_in_map.parent = it->parent;
+                inner_in_map.parent_area = it->parent_area;
+            }
+        }
+    }
+};
+
+
+// Finds the parents of the rings with the partition
+struct assign_parents_sequential
+{
+    template
+    <
+        typename Box, typename Vector,
+        typename Geometry1, typename Geometry2,
+        typename RingCollection, typename RingMap
+    >
+    inline void apply(Vector const& vector,
+            Geometry1 const& geometry1, Geometry2 const& geometry2,
+            RingCollection const& collection, RingMap& ring_map,
+            bool check_for_orientation) const
+    {
+        assign_visitor
+            <
+                Geometry1, Geometry2,
+                RingCollection, RingMap
+            > visitor(geometry1, geometry2, collection, ring_map, check_for_orientation);
+
+        geometry::partition
+            <
+                Box, ring_info_helper_get_box, ring_info_helper_ovelaps_box
+            >::apply(vector, visitor);
+    }
+};
+
+struct assign_parents_parallel
+{
+    explicit assign_parents_parallel(geometry::parallel const& policy)
+        : m_policy(policy)
+    {}
+
+    template
+    <
+        typename Box, typename Vector,
+        typename Geometry1, typename Geometry2,
+        typename RingCollection, typename RingMap
+    >
+    inline void apply(Vector const& vector,
+            Geometry1 const& geometry1, Geometry2 const& geometry2,
+            RingCollection const& collection, RingMap& ring_map,
+            bool check_for_orientation) const
+    {
+        parallel_assign_visitor
+            <
+                Geometry1, Geometry2,
+                RingCollection, RingMap
+            > visitor(geometry1, geometry2, collection, ring_map, check_for_orientation);
+
+        geometry::partition
+            <
+                Box, ring_info_helper_get_box, ring_info_helper_ovelaps_box
+            >::apply(vector, visitor, m_policy);
+
+        visitor.assign(ring_map);
+    }
+
+    geometry::parallel m_policy;
+};
 
 
 template
 <
     typename Geometry1, typename Geometry2,
     typename RingCollection,
-    typename RingMap
+    typename RingMap,
+    typename AssignPolicy
 >
 inline void assign_parents(Geometry1 const& geometry1,
             Geometry2 const& geometry2,
             RingCollection const& collection,
             RingMap& ring_map,
-            bool check_for_orientation = false)
+            bool check_for_orientation,
+            AssignPolicy const& assign_policy)
 {
     typedef typename geometry::tag<Geometry1>::type tag1;
     typedef typename geometry::tag<Geometry2>::type tag2;
@@ -250,16 +414,8 @@ inline void assign_parents(Geometry1 const& geometry1,
             }
         }
 
-        assign_visitor
-            <
-                Geometry1, Geometry2,
-                RingCollection, RingMap
-            > visitor(geometry1, geometry2, collection, ring_map, check_for_orientation);
-
-        geometry::partition
-            <
-                box_type, ring_info_helper_get_box, ring_info_helper_ovelaps_box
-            >::apply(vector, visitor);
+        assign_policy.template apply<box_type>(vector, geometry1, geometry2,
+                collection, ring_map, check_for_orientation);
     }
 
     if (check_for_orientation)
@@ -304,6 +460,40 @@ inline void assign_parents(Geometry1 const& geometry1,
     }
 }
 
+template
+<
+    typename Geometry1, typename Geometry2,
+    typename RingCollection,
+    typename RingMap
+>
+inline void assign_parents(Geometry1 const& geometry1,
+            Geometry2 const& geometry2,
+            RingCollection const& collection,
+            RingMap& ring_map,
+            bool check_for_orientation = false)
+{
+    assign_parents(geometry1, geometry2, collection, ring_map,
+            check_for_orientation, assign_parents_sequential());
+}
+
+// Parallel version, the containment of the rings is checked by parallel tasks
+template
+<
+    typename Geometry1, typename Geometry2,
+    typename RingCollection,
+    typename RingMap
+>
+inline void assign_parents(Geometry1 const& geometry1,
+            Geometry2 const& geometry2,
+            RingCollection const& collection,
+            RingMap& ring_map,
+            bool check_for_orientation,
+            geometry::parallel const& parallel_policy)
+{
+    assign_parents(geometry1, geometry2, collection, ring_map,
+            check_for_orientation, assign_parents_parallel(parallel_policy));
+}
+
 
 // Version for one geometry (called by buffer)
 template
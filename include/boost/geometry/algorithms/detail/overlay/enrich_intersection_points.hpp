@@ -31,6 +31,7 @@
 #include <boost/geometry/algorithms/detail/overlay/overlay_type.hpp>
 #include <boost/geometry/policies/robustness/robust_type.hpp>
 #include <boost/geometry/strategies/side.hpp>
+#include <boost/geometry/util/parallel.hpp>
 #ifdef BOOST_GEOMETRY_DEBUG_ENRICH
 #  include <boost/geometry/algorithms/detail/overlay/check_enrich.hpp>
 #endif
@@ -221,10 +222,8 @@ inline void update_discarded(Turns& turn_points, Operations& operations)
 
 
 // Sorts IP-s of this ring on segment-identifier, and if on same segment,
-//  on distance.
-// Then assigns for each IP which is the next IP on this segment,
-// plus the vertex-index to travel to, plus the next IP
-// (might be on another segment)
+//  on distance. Returns true if there are clusters of IP-s on the same
+//  location. The sorting doesn't depend on the other rings.
 template
 <
     typename IndexType,
@@ -235,15 +234,12 @@ template
     typename RobustPolicy,
     typename Strategy
 >
-inline void enrich_sort(Container& operations,
-            TurnPoints& turn_points,
-            operation_type for_operation,
+inline bool sort_operations(Container& operations,
+            TurnPoints const& turn_points,
             Geometry1 const& geometry1, Geometry2 const& geometry2,
             RobustPolicy const& robust_policy,
             Strategy const& strategy)
 {
-    typedef typename IndexType::type operations_type;
-
     bool clustered = false;
     std::sort(boost::begin(operations),
                 boost::end(operations),
@@ -256,6 +252,30 @@ inline void enrich_sort(Container& operations,
                         Reverse1, Reverse2,
                         Strategy
                     >(turn_points, geometry1, geometry2, robust_policy, strategy, &clustered));
+    return clustered;
+}
+
+// Handles the clusters of the sorted IP-s of this ring and updates
+//  the discarded IP-s. This may discard the turns of the other rings.
+template
+<
+    typename IndexType,
+    bool Reverse1, bool Reverse2,
+    typename Container,
+    typename TurnPoints,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy,
+    typename Strategy
+>
+inline void enrich_clusters(Container& operations,
+            TurnPoints& turn_points,
+            operation_type for_operation,
+            Geometry1 const& geometry1, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Strategy const& strategy,
+            bool clustered)
+{
+    typedef typename IndexType::type operations_type;
 
     // DONT'T discard xx / (for union) ix / ii / (for intersection) ux / uu here
     // It would give way to "lonely" ui turn points, traveling all
@@ -302,6 +322,37 @@ inline void enrich_sort(Container& operations,
     update_discarded(turn_points, operations);
 }
 
+// Sorts IP-s of this ring on segment-identifier, and if on same segment,
+//  on distance.
+// Then assigns for each IP which is the next IP on this segment,
+// plus the vertex-index to travel to, plus the next IP
+// (might be on another segment)
+template
+<
+    typename IndexType,
+    bool Reverse1, bool Reverse2,
+    typename Container,
+    typename TurnPoints,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy,
+    typename Strategy
+>
+inline void enrich_sort(Container& operations,
+            TurnPoints& turn_points,
+            operation_type for_operation,
+            Geometry1 const& geometry1, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Strategy const& strategy)
+{
+    bool const clustered = sort_operations<IndexType, Reverse1, Reverse2>(
+                operations, turn_points,
+                geometry1, geometry2, robust_policy, strategy);
+
+    enrich_clusters<IndexType, Reverse1, Reverse2>(operations, turn_points,
+                for_operation, geometry1, geometry2, robust_policy, strategy,
+                clustered);
+}
+
 
 template
 <
@@ -445,6 +496,139 @@ inline void create_map(TurnPoints const& turn_points, MappedVector& mapped_vecto
 }
 
 
+// Discards uu turns, handles colocations and creates a map of vectors
+// of indexed operation-types to be able to sort intersection points PER RING
+template
+<
+    overlay_type OverlayType,
+    typename IndexedType,
+    typename TurnPoints,
+    typename MappedVector
+>
+inline void create_ring_map(TurnPoints& turn_points, MappedVector& mapped_vector)
+{
+    // Iterate through turns and discard uu
+    // and check if there are possible colocations
+    bool check_colocations = false;
+    for (typename boost::range_iterator<TurnPoints>::type
+            it = boost::begin(turn_points);
+         it != boost::end(turn_points);
+         ++it)
+    {
+        if (it->both(detail::overlay::operation_union))
+        {
+            // Discard  (necessary for a.o. #76). With uu, at all points there
+            // is the risk that rings are being traversed twice or more.
+            // Without uu, all rings having only uu will be untouched
+            // and gathered by assemble
+            it->discarded = true;
+            check_colocations = true;
+        }
+        else if (it->combination(detail::overlay::operation_union,
+                                 detail::overlay::operation_blocked))
+        {
+            check_colocations = true;
+        }
+        else if (OverlayType == overlay_difference
+                 && it->both(detail::overlay::operation_intersection))
+        {
+            // For difference operation (u/u -> i/i)
+            check_colocations = true;
+        }
+        else if (it->both(detail::overlay::operation_none))
+        {
+            it->discarded = true;
+        }
+    }
+
+    if (check_colocations)
+    {
+        detail::overlay::handle_colocations<OverlayType>(turn_points);
+    }
+
+    create_map<IndexedType>(turn_points, mapped_vector);
+}
+
+
+// Tasks of the parallel enrichment, each one processes the operations
+// of one ring. Only the operations of this ring are modified.
+template
+<
+    typename IndexType,
+    bool Reverse1, bool Reverse2,
+    typename MapIterators,
+    typename TurnPoints,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy,
+    typename Strategy
+>
+struct sort_operations_task
+{
+    sort_operations_task(MapIterators const& rings,
+            std::vector<char>& clustered,
+            TurnPoints const& turn_points,
+            Geometry1 const& geometry1, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Strategy const& strategy)
+        : m_rings(rings), m_clustered(clustered)
+        , m_turn_points(turn_points)
+        , m_geometry1(geometry1), m_geometry2(geometry2)
+        , m_robust_policy(robust_policy), m_strategy(strategy)
+    {}
+
+    inline void operator()(std::size_t i)
+    {
+        m_clustered[i] = sort_operations<IndexType, Reverse1, Reverse2>(
+                    m_rings[i]->second, m_turn_points,
+                    m_geometry1, m_geometry2, m_robust_policy, m_strategy);
+    }
+
+    MapIterators const& m_rings;
+    std::vector<char>& m_clustered;
+    TurnPoints const& m_turn_points;
+    Geometry1 const& m_geometry1;
+    Geometry2 const& m_geometry2;
+    RobustPolicy const& m_robust_policy;
+    Strategy const& m_strategy;
+};
+
+template
+<
+    typename IndexType,
+    typename MapIterators,
+    typename TurnPoints,
+    typename Geometry1, typename Geometry2,
+    typename Strategy
+>
+struct enrich_assign_task
+{
+    enrich_assign_task(MapIterators const& rings,
+            TurnPoints& turn_points,
+            operation_type for_operation,
+            Geometry1 const& geometry1, Geometry2 const& geometry2,
+            Strategy const& strategy)
+        : m_rings(rings)
+        , m_turn_points(turn_points)
+        , m_for_operation(for_operation)
+        , m_geometry1(geometry1), m_geometry2(geometry2)
+        , m_strategy(strategy)
+    {}
+
+    inline void operator()(std::size_t i)
+    {
+        enrich_assign<IndexType>(m_rings[i]->second, m_turn_points,
+                    m_for_operation, m_geometry1, m_geometry2, m_strategy);
+    }
+
+    MapIterators const& m_rings;
+    TurnPoints& m_turn_points;
+    operation_type m_for_operation;
+    Geometry1 const& m_geometry1;
+    Geometry2 const& m_geometry2;
+    Strategy const& m_strategy;
+};
+
+
 }} // namespace detail::overlay
 #endif //DOXYGEN_NO_DETAIL
 
@@ -493,50 +677,10 @@ inline void enrich_intersection_points(TurnPoints& turn_points,
             std::vector<indexed_turn_operation>
         > mapped_vector_type;
 
-    // Iterate through turns and discard uu
-    // and check if there are possible colocations
-    bool check_colocations = false;
-    for (typename boost::range_iterator<TurnPoints>::type
-            it = boost::begin(turn_points);
-         it != boost::end(turn_points);
-         ++it)
-    {
-        if (it->both(detail::overlay::operation_union))
-        {
-            // Discard  (necessary for a.o. #76). With uu, at all points there
-            // is the risk that rings are being traversed twice or more.
-            // Without uu, all rings having only uu will be untouched
-            // and gathered by assemble
-            it->discarded = true;
-            check_colocations = true;
-        }
-        else if (it->combination(detail::overlay::operation_union,
-                                 detail::overlay::operation_blocked))
-        {
-            check_colocations = true;
-        }
-        else if (OverlayType == overlay_difference
-                 && it->both(detail::overlay::operation_intersection))
-        {
-            // For difference operation (u/u -> i/i)
-            check_colocations = true;
-        }
-        else if (it->both(detail::overlay::operation_none))
-        {
-            it->discarded = true;
-        }
-    }
-
-    if (check_colocations)
-    {
-        detail::overlay::handle_colocations<OverlayType>(turn_points);
-    }
-
-    // Create a map of vectors of indexed operation-types to be able
-    // to sort intersection points PER RING
     mapped_vector_type mapped_vector;
 
-    detail::overlay::create_map<indexed_turn_operation>(turn_points, mapped_vector);
+    detail::overlay::create_ring_map<OverlayType, indexed_turn_operation>(
+                turn_points, mapped_vector);
 
 
     // No const-iterator; contents of mapped copy is temporary,
@@ -585,6 +729,112 @@ inline void enrich_intersection_points(TurnPoints& turn_points,
 
 }
 
+/*!
+\brief All intersection points are enriched with successor information,
+    the rings are processed in parallel
+\ingroup overlay
+\details The intersection points of the rings are sorted and the successor
+    information is assigned by parallel tasks. The clusters of
+    intersection points and the discarded ones, which may affect the other
+    rings, are handled sequentially. The result is the same as the result
+    of the sequential version.
+\tparam TurnPoints type of intersection container
+            (e.g. vector of "intersection/turn point"'s)
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Strategy side strategy type
+\param turn_points container containing intersectionpoints
+\param for_operation operation_type (union or intersection)
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param robust_policy policy to handle robustness issues
+\param strategy strategy
+\param parallel_policy the parallel execution policy
+ */
+template
+<
+    bool Reverse1, bool Reverse2,
+    overlay_type OverlayType,
+    typename TurnPoints,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy,
+    typename Strategy
+>
+inline void enrich_intersection_points(TurnPoints& turn_points,
+    detail::overlay::operation_type for_operation,
+    Geometry1 const& geometry1, Geometry2 const& geometry2,
+    RobustPolicy const& robust_policy,
+    Strategy const& strategy,
+    geometry::parallel const& parallel_policy)
+{
+    typedef typename boost::range_value<TurnPoints>::type turn_point_type;
+    typedef typename turn_point_type::turn_operation_type turn_operation_type;
+    typedef detail::overlay::indexed_turn_operation
+        <
+            turn_operation_type
+        > indexed_turn_operation;
+
+    typedef std::map
+        <
+            ring_identifier,
+            std::vector<indexed_turn_operation>
+        > mapped_vector_type;
+    typedef std::vector
+        <
+            typename mapped_vector_type::iterator
+        > ring_iterators_type;
+
+    std::size_t const threads
+        = geometry::detail::parallel::threads_count(parallel_policy);
+
+    mapped_vector_type mapped_vector;
+
+    detail::overlay::create_ring_map<OverlayType, indexed_turn_operation>(
+                turn_points, mapped_vector);
+
+    ring_iterators_type rings;
+    rings.reserve(mapped_vector.size());
+    for (typename mapped_vector_type::iterator mit
+        = mapped_vector.begin();
+        mit != mapped_vector.end();
+        ++mit)
+    {
+        rings.push_back(mit);
+    }
+
+    std::vector<char> clustered(rings.size(), 0);
+    detail::overlay::sort_operations_task
+        <
+            indexed_turn_operation, Reverse1, Reverse2,
+            ring_iterators_type, TurnPoints,
+            Geometry1, Geometry2, RobustPolicy, Strategy
+        > sort_task(rings, clustered, turn_points,
+                    geometry1, geometry2, robust_policy, strategy);
+    geometry::detail::parallel::for_each_index(rings.size(), sort_task, threads);
+
+    for (std::size_t i = 0; i < rings.size(); i++)
+    {
+        detail::overlay::enrich_clusters<indexed_turn_operation, Reverse1, Reverse2>(
+                    rings[i]->second, turn_points, for_operation,
+                    geometry1, geometry2, robust_policy, strategy,
+                    clustered[i] != 0);
+    }
+
+    for (std::size_t i = 0; i < rings.size(); i++)
+    {
+        detail::overlay::enrich_discard<indexed_turn_operation>(rings[i]->second, turn_points);
+    }
+
+    detail::overlay::enrich_assign_task
+        <
+            indexed_turn_operation,
+            ring_iterators_type, TurnPoints,
+            Geometry1, Geometry2, Strategy
+        > assign_task(rings, turn_points, for_operation,
+                      geometry1, geometry2, strategy);
+    geometry::detail::parallel::for_each_index(rings.size(), assign_task, threads);
+}
+
 }} // namespace boost::geometry
 
 #endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_ENRICH_HPP
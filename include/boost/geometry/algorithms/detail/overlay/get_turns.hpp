@@ -16,7 +16,9 @@
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_GET_TURNS_HPP
 
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <map>
 
 #include <boost/array.hpp>
@@ -24,6 +26,7 @@
 #include <boost/mpl/if.hpp>
 #include <boost/mpl/vector_c.hpp>
 #include <boost/range.hpp>
+#include <boost/type_traits/is_base_of.hpp>
 
 #include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/coordinate_dimension.hpp>
@@ -36,6 +39,7 @@
 #include <boost/geometry/geometries/concepts/check.hpp>
 
 #include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/parallel.hpp>
 #include <boost/geometry/views/closeable_view.hpp>
 #include <boost/geometry/views/reversible_view.hpp>
 #include <boost/geometry/views/detail/range_type.hpp>
@@ -431,6 +435,69 @@ struct section_visitor
 
 };
 
+// Section visitor used by the parallel partition, the visitor of each task
+// collects the turns in its own container. They're joined in the order
+// in which the sequential section_visitor would add them.
+template
+<
+    typename Geometry1, typename Geometry2,
+    bool Reverse1, bool Reverse2,
+    typename Turns,
+    typename TurnPolicy,
+    typename RobustPolicy,
+    typename InterruptPolicy
+>
+struct parallel_section_visitor
+{
+    int m_source_id1;
+    Geometry1 const& m_geometry1;
+    int m_source_id2;
+    Geometry2 const& m_geometry2;
+    RobustPolicy const& m_rescale_policy;
+    Turns m_turns;
+    InterruptPolicy m_interrupt_policy;
+
+    parallel_section_visitor(int id1, Geometry1 const& g1,
+            int id2, Geometry2 const& g2,
+            RobustPolicy const& robust_policy,
+            InterruptPolicy const& ip)
+        : m_source_id1(id1), m_geometry1(g1)
+        , m_source_id2(id2), m_geometry2(g2)
+        , m_rescale_policy(robust_policy)
+        , m_interrupt_policy(ip)
+    {}
+
+    parallel_section_visitor(parallel_section_visitor const& other,
+            detail::partition::split)
+        : m_source_id1(other.m_source_id1), m_geometry1(other.m_geometry1)
+        , m_source_id2(other.m_source_id2), m_geometry2(other.m_geometry2)
+        , m_rescale_policy(other.m_rescale_policy)
+        , m_interrupt_policy(other.m_interrupt_policy)
+    {}
+
+    template <typename Section>
+    inline bool apply(Section const& sec1, Section const& sec2)
+    {
+        section_visitor
+            <
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                Turns, TurnPolicy, RobustPolicy, InterruptPolicy
+            > visitor(m_source_id1, m_geometry1, m_source_id2, m_geometry2,
+                      m_rescale_policy, m_turns, m_interrupt_policy);
+        return visitor.apply(sec1, sec2);
+    }
+
+    inline void join(parallel_section_visitor const& other)
+    {
+        std::copy(boost::begin(other.m_turns), boost::end(other.m_turns),
+                  std::back_inserter(m_turns));
+    }
+};
+
+// The dimensions in which get_turns_generic sectionalizes the geometries
+typedef boost::mpl::vector_c<std::size_t, 0, 1> sections_dimensions;
+
 template
 <
     typename Geometry1, typename Geometry2,
@@ -439,17 +506,10 @@ template
 >
 class get_turns_generic
 {
-
 public:
-    template <typename RobustPolicy, typename Turns, typename InterruptPolicy>
-    static inline void apply(
-            int source_id1, Geometry1 const& geometry1,
-            int source_id2, Geometry2 const& geometry2,
-            RobustPolicy const& robust_policy,
-            Turns& turns,
-            InterruptPolicy& interrupt_policy)
+    template <typename RobustPolicy, typename Turns>
+    struct sections_traits
     {
-        // First create monotonic sections...
         typedef typename boost::range_value<Turns>::type ip_type;
         typedef typename ip_type::point_type point_type;
 
@@ -460,17 +520,66 @@ public:
                     point_type, RobustPolicy
                 >::type
             > box_type;
-        typedef geometry::sections<box_type, 2> sections_type;
+        typedef geometry::sections<box_type, 2> type;
 
-        sections_type sec1, sec2;
-        typedef boost::mpl::vector_c<std::size_t, 0, 1> dimensions;
+        typedef geometry::partition
+            <
+                box_type,
+                detail::section::get_section_box,
+                detail::section::overlaps_section_box
+            > partition_type;
+    };
 
-        geometry::sectionalize<Reverse1, dimensions>(geometry1, robust_policy,
-                sec1, 0);
-        geometry::sectionalize<Reverse2, dimensions>(geometry2, robust_policy,
-                sec2, 1);
+private:
+    template <typename RobustPolicy, typename Sections>
+    static inline void sectionalize(Geometry1 const& geometry1,
+            Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Sections& sec1, Sections& sec2)
+    {
+        geometry::sectionalize<Reverse1, sections_dimensions>(geometry1,
+                robust_policy, sec1, 0);
+        geometry::sectionalize<Reverse2, sections_dimensions>(geometry2,
+                robust_policy, sec2, 1);
+    }
 
-        // ... and then partition them, intersecting overlapping sections in visitor method
+public:
+    template <typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy)
+    {
+        typedef sections_traits<RobustPolicy, Turns> sections_info;
+
+        // First create monotonic sections...
+        typename sections_info::type sec1, sec2;
+        sectionalize(geometry1, geometry2, robust_policy, sec1, sec2);
+
+        apply(source_id1, geometry1, source_id2, geometry2,
+              robust_policy, turns, interrupt_policy, sec1, sec2);
+    }
+
+    // Version taking the sections of both geometries, created before
+    // (e.g. cached) with the same robust policy
+    template
+    <
+        typename RobustPolicy, typename Turns, typename InterruptPolicy,
+        typename Sections
+    >
+    static inline void apply(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            Sections const& sec1, Sections const& sec2)
+    {
+        typedef sections_traits<RobustPolicy, Turns> sections_info;
+
+        // Partition the sections, intersecting overlapping sections in visitor method
         section_visitor
             <
                 Geometry1, Geometry2,
@@ -478,12 +587,37 @@ public:
                 Turns, TurnPolicy, RobustPolicy, InterruptPolicy
             > visitor(source_id1, geometry1, source_id2, geometry2, robust_policy, turns, interrupt_policy);
 
-        geometry::partition
+        sections_info::partition_type::apply(sec1, sec2, visitor);
+    }
+
+    // Parallel version, the pairs of sections are intersected by parallel
+    // tasks. The turns are added in the same order as by the sequential
+    // version. The interrupt policy has to be disabled.
+    template <typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            geometry::parallel const& parallel_policy)
+    {
+        typedef sections_traits<RobustPolicy, Turns> sections_info;
+
+        typename sections_info::type sec1, sec2;
+        sectionalize(geometry1, geometry2, robust_policy, sec1, sec2);
+
+        parallel_section_visitor
             <
-                box_type,
-                detail::section::get_section_box,
-                detail::section::overlaps_section_box
-            >::apply(sec1, sec2, visitor);
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                Turns, TurnPolicy, RobustPolicy, InterruptPolicy
+            > visitor(source_id1, geometry1, source_id2, geometry2, robust_policy, interrupt_policy);
+
+        // The turns found so far are kept in front of the new ones
+        visitor.m_turns.swap(turns);
+        sections_info::partition_type::apply(sec1, sec2, visitor, parallel_policy);
+        visitor.m_turns.swap(turns);
     }
 };
 
@@ -942,6 +1076,132 @@ struct get_turns_reversed
 #endif // DOXYGEN_NO_DISPATCH
 
 
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace get_turns
+{
+
+// Calls the parallel version of get_turns_generic if it's used by the
+// dispatch for the geometries, otherwise the sequential dispatch
+template
+<
+    typename GeometryTag1, typename GeometryTag2,
+    typename Geometry1, typename Geometry2,
+    bool Reverse1, bool Reverse2,
+    typename TurnPolicy,
+    bool IsGeneric = boost::is_base_of
+        <
+            get_turns_generic<Geometry1, Geometry2, Reverse1, Reverse2, TurnPolicy>,
+            dispatch::get_turns
+                <
+                    GeometryTag1, GeometryTag2,
+                    Geometry1, Geometry2,
+                    Reverse1, Reverse2,
+                    TurnPolicy
+                >
+        >::value
+>
+struct get_turns_parallel
+{
+    template <typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            geometry::parallel const& )
+    {
+        dispatch::get_turns
+            <
+                GeometryTag1, GeometryTag2,
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy
+            >::apply(source_id1, geometry1, source_id2, geometry2,
+                     robust_policy, turns, interrupt_policy);
+    }
+};
+
+template
+<
+    typename GeometryTag1, typename GeometryTag2,
+    typename Geometry1, typename Geometry2,
+    bool Reverse1, bool Reverse2,
+    typename TurnPolicy
+>
+struct get_turns_parallel
+    <
+        GeometryTag1, GeometryTag2,
+        Geometry1, Geometry2,
+        Reverse1, Reverse2,
+        TurnPolicy,
+        true
+    >
+{
+    template <typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            geometry::parallel const& parallel_policy)
+    {
+        typedef get_turns_generic
+            <
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy
+            > generic_type;
+
+        // Interrupting tasks isn't supported
+        if (InterruptPolicy::enabled)
+        {
+            generic_type::apply(source_id1, geometry1, source_id2, geometry2,
+                                robust_policy, turns, interrupt_policy);
+        }
+        else
+        {
+            generic_type::apply(source_id1, geometry1, source_id2, geometry2,
+                                robust_policy, turns, interrupt_policy,
+                                parallel_policy);
+        }
+    }
+};
+
+template
+<
+    typename GeometryTag1, typename GeometryTag2,
+    typename Geometry1, typename Geometry2,
+    bool Reverse1, bool Reverse2,
+    typename TurnPolicy
+>
+struct get_turns_parallel_reversed
+{
+    template <typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(
+            int source_id1, Geometry1 const& g1,
+            int source_id2, Geometry2 const& g2,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            geometry::parallel const& parallel_policy)
+    {
+        get_turns_parallel
+            <
+                GeometryTag2, GeometryTag1,
+                Geometry2, Geometry1,
+                Reverse2, Reverse1,
+                TurnPolicy
+            >::apply(source_id2, g2, source_id1, g1, robust_policy,
+                    turns, interrupt_policy, parallel_policy);
+    }
+};
+
+}} // namespace detail::get_turns
+#endif // DOXYGEN_NO_DETAIL
+
+
 
 /*!
 \brief \brief_calc2{turn points}
@@ -1003,6 +1263,73 @@ inline void get_turns(Geometry1 const& geometry1,
             turns, interrupt_policy);
 }
 
+/*!
+\brief \brief_calc2{turn points} in parallel
+\ingroup overlay
+\details The pairs of sections of the geometries are intersected by parallel
+    tasks. The turns are the same and in the same order as the turns
+    calculated by the sequential version. Geometries for which get_turns
+    doesn't use sections and interrupted calculations are processed
+    sequentially.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Turns type of turn-container (e.g. vector of "intersection/turn point"'s)
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param robust_policy policy to handle robustness issues
+\param turns container which will contain turn points
+\param interrupt_policy policy determining if process is stopped
+    when intersection is found
+\param parallel_policy the parallel execution policy
+ */
+template
+<
+    bool Reverse1, bool Reverse2,
+    typename AssignPolicy,
+    typename Geometry1,
+    typename Geometry2,
+    typename RobustPolicy,
+    typename Turns,
+    typename InterruptPolicy
+>
+inline void get_turns(Geometry1 const& geometry1,
+            Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            geometry::parallel const& parallel_policy)
+{
+    concept::check_concepts_and_equal_dimensions<Geometry1 const, Geometry2 const>();
+
+    typedef detail::overlay::get_turn_info<AssignPolicy> TurnPolicy;
+
+    boost::mpl::if_c
+        <
+            reverse_dispatch<Geometry1, Geometry2>::type::value,
+            detail::get_turns::get_turns_parallel_reversed
+            <
+                typename tag<Geometry1>::type,
+                typename tag<Geometry2>::type,
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy
+            >,
+            detail::get_turns::get_turns_parallel
+            <
+                typename tag<Geometry1>::type,
+                typename tag<Geometry2>::type,
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy
+            >
+        >::type::apply(
+            0, geometry1,
+            1, geometry2,
+            robust_policy,
+            turns, interrupt_policy,
+            parallel_policy);
+}
+
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
@@ -44,6 +44,8 @@
 
 #include <boost/geometry/policies/robustness/segment_ratio_type.hpp>
 
+#include <boost/geometry/util/parallel.hpp>
+
 
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
 #  include <boost/geometry/io/dsv/write.hpp>
@@ -155,6 +157,130 @@ inline OutputIterator return_if_one_input_is_empty(Geometry1 const& geometry1,
 }
 
 
+/*!
+\brief Overlay strategy, wrapping another one, which makes overlay
+    calculate the turns, enrich them and assign the parents of the output
+    rings with parallel tasks. The traversal is sequential.
+*/
+template <typename Strategy>
+struct parallel_strategy : Strategy
+{
+    explicit parallel_strategy(geometry::parallel const& policy)
+        : parallel_policy(policy)
+    {}
+
+    geometry::parallel parallel_policy;
+};
+
+
+template
+<
+    bool Reverse1, bool Reverse2,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy, typename Turns,
+    typename Strategy
+>
+inline void overlay_get_turns(Geometry1 const& geometry1, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy, Turns& turns,
+            Strategy const& )
+{
+    detail::get_turns::no_interrupt_policy policy;
+    geometry::get_turns
+        <
+            Reverse1, Reverse2,
+            detail::overlay::assign_null_policy
+        >(geometry1, geometry2, robust_policy, turns, policy);
+}
+
+template
+<
+    bool Reverse1, bool Reverse2,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy, typename Turns,
+    typename Strategy
+>
+inline void overlay_get_turns(Geometry1 const& geometry1, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy, Turns& turns,
+            parallel_strategy<Strategy> const& strategy)
+{
+    detail::get_turns::no_interrupt_policy policy;
+    geometry::get_turns
+        <
+            Reverse1, Reverse2,
+            detail::overlay::assign_null_policy
+        >(geometry1, geometry2, robust_policy, turns, policy,
+          strategy.parallel_policy);
+}
+
+
+template
+<
+    bool Reverse1, bool Reverse2, overlay_type OverlayType,
+    typename Turns,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy,
+    typename Strategy
+>
+inline void overlay_enrich(Turns& turns, operation_type for_operation,
+            Geometry1 const& geometry1, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Strategy const& )
+{
+    typename Strategy::side_strategy_type side_strategy;
+    geometry::enrich_intersection_points<Reverse1, Reverse2, OverlayType>(turns,
+            for_operation, geometry1, geometry2, robust_policy, side_strategy);
+}
+
+template
+<
+    bool Reverse1, bool Reverse2, overlay_type OverlayType,
+    typename Turns,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy,
+    typename Strategy
+>
+inline void overlay_enrich(Turns& turns, operation_type for_operation,
+            Geometry1 const& geometry1, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            parallel_strategy<Strategy> const& strategy)
+{
+    typename Strategy::side_strategy_type side_strategy;
+    geometry::enrich_intersection_points<Reverse1, Reverse2, OverlayType>(turns,
+            for_operation, geometry1, geometry2, robust_policy, side_strategy,
+            strategy.parallel_policy);
+}
+
+
+template
+<
+    typename Geometry1, typename Geometry2,
+    typename RingCollection, typename RingMap,
+    typename Strategy
+>
+inline void overlay_assign_parents(Geometry1 const& geometry1,
+            Geometry2 const& geometry2,
+            RingCollection const& collection, RingMap& ring_map,
+            Strategy const& )
+{
+    assign_parents(geometry1, geometry2, collection, ring_map);
+}
+
+template
+<
+    typename Geometry1, typename Geometry2,
+    typename RingCollection, typename RingMap,
+    typename Strategy
+>
+inline void overlay_assign_parents(Geometry1 const& geometry1,
+            Geometry2 const& geometry2,
+            RingCollection const& collection, RingMap& ring_map,
+            parallel_strategy<Strategy> const& strategy)
+{
+    assign_parents(geometry1, geometry2, collection, ring_map, false,
+            strategy.parallel_policy);
+}
+
+
 template
 <
     typename Geometry1, typename Geometry2,
@@ -169,7 +295,7 @@ struct overlay
                 Geometry1 const& geometry1, Geometry2 const& geometry2,
                 RobustPolicy const& robust_policy,
                 OutputIterator out,
-                Strategy const& )
+                Strategy const& strategy)
     {
         bool const is_empty1 = geometry::is_empty(geometry1);
         bool const is_empty2 = geometry::is_empty(geometry2);
@@ -205,24 +331,19 @@ struct overlay
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
 std::cout << "get turns" << std::endl;
 #endif
-        detail::get_turns::no_interrupt_policy policy;
-        geometry::get_turns
-            <
-                Reverse1, Reverse2,
-                detail::overlay::assign_null_policy
-            >(geometry1, geometry2, robust_policy, turn_points, policy);
+        overlay_get_turns<Reverse1, Reverse2>(geometry1, geometry2,
+                robust_policy, turn_points, strategy);
 
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
 std::cout << "enrich" << std::endl;
 #endif
-        typename Strategy::side_strategy_type side_strategy;
-        geometry::enrich_intersection_points<Reverse1, Reverse2, OverlayType>(turn_points,
+        overlay_enrich<Reverse1, Reverse2, OverlayType>(turn_points,
                 OverlayType == overlay_union
                     ? geometry::detail::overlay::operation_union
                     : geometry::detail::overlay::operation_intersection,
                     geometry1, geometry2,
                     robust_policy,
-                    side_strategy);
+                    strategy);
 
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
 std::cout << "traverse" << std::endl;
@@ -268,7 +389,8 @@ std::cout << "traverse" << std::endl;
             }
         }
 
-        assign_parents(geometry1, geometry2, rings, selected_ring_properties);
+        overlay_assign_parents(geometry1, geometry2, rings,
+                selected_ring_properties, strategy);
 
         return add_rings<GeometryOut>(selected_ring_properties, geometry1, geometry2, rings, out);
     }
@@ -20,6 +20,7 @@
 #include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/coordinate_type.hpp>
 #include <boost/geometry/algorithms/assign.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 
 namespace boost { namespace geometry
@@ -194,6 +195,106 @@ inline bool recurse_ok(IteratorVector1 const& input1,
         && recurse_ok(input2, input3, min_elements, level);
 }
 
+// Tag passed to the constructor of a visitor creating the visitor of
+// a parallel task, see parallel_tasks
+struct split {};
+
+// Minimal number of items of each half of a box for which the halves are
+// processed as parallel tasks. For smaller ones the overhead isn't worth it.
+std::size_t const parallel_min_items = 64;
+
+// The halves of the boxes are processed by Tasks:
+// - sequential_tasks visits the pairs and the boxes of both halves with
+//   the visitors of the caller,
+// - parallel_tasks processes the halves as parallel tasks.
+struct sequential_tasks
+{
+    template
+    <
+        typename Half1, typename Half2,
+        typename Policy, typename BoxPolicy
+    >
+    inline void apply(Half1 const& lower, Half2 const& upper,
+            Policy& policy, BoxPolicy& box_policy) const
+    {
+        lower(policy, box_policy, *this);
+        upper(policy, box_policy, *this);
+    }
+};
+
+// Each task gets its own visitor and box visitor, created with
+// Policy(policy, split()) and BoxPolicy(box_policy, split()), so the
+// visitors don't have to be thread-safe. After both tasks are finished
+// their visitors are joined with the visitors of the caller in the
+// sequential order, e.g. policy.join(lower_policy), policy.join(upper_policy).
+// The threads are divided between the halves.
+class parallel_tasks
+{
+    template <typename Half, typename Policy, typename BoxPolicy>
+    struct task
+    {
+        task(Half const& half, Policy& policy, BoxPolicy& box_policy,
+                std::size_t threads)
+            : m_half(half), m_policy(policy), m_box_policy(box_policy)
+            , m_threads(threads)
+        {}
+
+        inline void operator()()
+        {
+            m_half(m_policy, m_box_policy, parallel_tasks(m_threads));
+        }
+
+        Half const& m_half;
+        Policy& m_policy;
+        BoxPolicy& m_box_policy;
+        std::size_t m_threads;
+    };
+
+public :
+    explicit parallel_tasks(std::size_t threads)
+        : m_threads(threads)
+    {}
+
+    template
+    <
+        typename Half1, typename Half2,
+        typename Policy, typename BoxPolicy
+    >
+    inline void apply(Half1 const& lower, Half2 const& upper,
+            Policy& policy, BoxPolicy& box_policy) const
+    {
+        if (m_threads <= 1
+            || lower.size() < parallel_min_items
+            || upper.size() < parallel_min_items)
+        {
+            lower(policy, box_policy, *this);
+            upper(policy, box_policy, *this);
+            return;
+        }
+
+        std::size_t const lower_threads = m_threads / 2;
+
+        Policy lower_policy(policy, split());
+        Policy upper_policy(policy, split());
+        BoxPolicy lower_box_policy(box_policy, split());
+        BoxPolicy upper_box_policy(box_policy, split());
+        task<Half1, Policy, BoxPolicy> lower_task(lower,
+                lower_policy, lower_box_policy, lower_threads);
+        task<Half2, Policy, BoxPolicy> upper_task(upper,
+                upper_policy, upper_box_policy, m_threads - lower_threads);
+
+        geometry::detail::parallel::fork_join(lower_task, upper_task, true);
+
+        policy.join(lower_policy);
+        policy.join(upper_policy);
+        box_policy.join(lower_box_policy);
+        box_policy.join(upper_box_policy);
+    }
+
+private :
+    std::size_t m_threads;
+};
+
 template
 <
     int Dimension,
@@ -226,11 +327,12 @@ class partition_one_range
         return box;
     }
 
-    template <typename Policy, typename IteratorVector>
+    template <typename Policy, typename IteratorVector, typename Tasks>
     static inline void next_level(Box const& box,
             IteratorVector const& input,
             std::size_t level, std::size_t min_elements,
-            Policy& policy, VisitBoxPolicy& box_policy)
+            Policy& policy, VisitBoxPolicy& box_policy,
+            Tasks const& tasks)
     {
         if (recurse_ok(input, min_elements, level))
         {
@@ -241,7 +343,8 @@ class partition_one_range
                 OverlapsPolicy,
                 ExpandPolicy,
                 VisitBoxPolicy
-            >::apply(box, input, level + 1, min_elements, policy, box_policy);
+            >::apply(box, input, level + 1, min_elements, policy, box_policy,
+                     tasks);
         }
         else
         {
@@ -249,14 +352,44 @@ class partition_one_range
         }
     }
 
+    // Lower or upper half of the box with its elements
+    template <typename IteratorVector>
+    struct half
+    {
+        half(Box const& box, IteratorVector const& input,
+                std::size_t level, std::size_t min_elements)
+            : m_box(box), m_input(input)
+            , m_level(level), m_min_elements(min_elements)
+        {}
+
+        inline std::size_t size() const
+        {
+            return boost::size(m_input);
+        }
+
+        template <typename Policy, typename Tasks>
+        inline void operator()(Policy& policy, VisitBoxPolicy& box_policy,
+                Tasks const& tasks) const
+        {
+            next_level(m_box, m_input, m_level, m_min_elements,
+                policy, box_policy, tasks);
+        }
+
+        Box const& m_box;
+        IteratorVector const& m_input;
+        std::size_t m_level;
+        std::size_t m_min_elements;
+    };
+
     // Function to switch to two forward ranges if there are
     // geometries exceeding the separation line
-    template <typename Policy, typename IteratorVector>
+    template <typename Policy, typename IteratorVector, typename Tasks>
     static inline void next_level2(Box const& box,
             IteratorVector const& input1,
             IteratorVector const& input2,
             std::size_t level, std::size_t min_elements,
-            Policy& policy, VisitBoxPolicy& box_policy)
+            Policy& policy, VisitBoxPolicy& box_policy,
+            Tasks const& tasks)
     {
         if (recurse_ok(input1, input2, min_elements, level))
         {
@@ -268,7 +401,7 @@ class partition_one_range
                 ExpandPolicy, ExpandPolicy,
                 VisitBoxPolicy
             >::apply(box, input1, input2, level + 1, min_elements,
-                policy, box_policy);
+                policy, box_policy, tasks);
         }
         else
         {
@@ -277,12 +410,13 @@ class partition_one_range
     }
 
 public :
-    template <typename Policy, typename IteratorVector>
+    template <typename Policy, typename IteratorVector, typename Tasks>
     static inline void apply(Box const& box,
             IteratorVector const& input,
             std::size_t level,
             std::size_t min_elements,
-            Policy& policy, VisitBoxPolicy& box_policy)
+            Policy& policy, VisitBoxPolicy& box_policy,
+            Tasks const& tasks)
     {
         box_policy.apply(box, level);
 
@@ -301,19 +435,21 @@ public :
             // Recursively do exceeding elements only, in next dimension they
             // will probably be less exceeding within the new box
             next_level(exceeding_box, exceeding, level, min_elements,
-                policy, box_policy);
+                policy, box_policy, tasks);
 
             // Switch to two forward ranges, combine exceeding with
             // lower resp upper, but not lower/lower, upper/upper
             next_level2(exceeding_box, exceeding, lower, level, min_elements,
-                policy, box_policy);
+                policy, box_policy, tasks);
             next_level2(exceeding_box, exceeding, upper, level, min_elements,
-                policy, box_policy);
+                policy, box_policy, tasks);
         }
 
         // Recursively call operation both parts
-        next_level(lower_box, lower, level, min_elements, policy, box_policy);
-        next_level(upper_box, upper, level, min_elements, policy, box_policy);
+        tasks.apply(
+            half<IteratorVector>(lower_box, lower, level, min_elements),
+            half<IteratorVector>(upper_box, upper, level, min_elements),
+            policy, box_policy);
     }
 };
 
@@ -333,13 +469,15 @@ class partition_two_ranges
     <
         typename Policy,
         typename IteratorVector1,
-        typename IteratorVector2
+        typename IteratorVector2,
+        typename Tasks
     >
     static inline void next_level(Box const& box,
             IteratorVector1 const& input1,
             IteratorVector2 const& input2,
             std::size_t level, std::size_t min_elements,
-            Policy& policy, VisitBoxPolicy& box_policy)
+            Policy& policy, VisitBoxPolicy& box_policy,
+            Tasks const& tasks)
     {
         partition_two_ranges
         <
@@ -351,9 +489,47 @@ class partition_two_ranges
             ExpandPolicy2,
             VisitBoxPolicy
         >::apply(box, input1, input2, level + 1, min_elements,
-                 policy, box_policy);
+                 policy, box_policy, tasks);
     }
 
+    // Lower or upper half of the box with the elements of both ranges
+    template <typename IteratorVector1, typename IteratorVector2>
+    struct half
+    {
+        half(Box const& box,
+                IteratorVector1 const& input1, IteratorVector2 const& input2,
+                std::size_t level, std::size_t min_elements)
+            : m_box(box), m_input1(input1), m_input2(input2)
+            , m_level(level), m_min_elements(min_elements)
+        {}
+
+        inline std::size_t size() const
+        {
+            return boost::size(m_input1) + boost::size(m_input2);
+        }
+
+        template <typename Policy, typename Tasks>
+        inline void operator()(Policy& policy, VisitBoxPolicy& box_policy,
+                Tasks const& tasks) const
+        {
+            if (recurse_ok(m_input1, m_input2, m_min_elements, m_level))
+            {
+                next_level(m_box, m_input1, m_input2, m_level,
+                           m_min_elements, policy, box_policy, tasks);
+            }
+            else
+            {
+                handle_two(m_input1, m_input2, policy);
+            }
+        }
+
+        Box const& m_box;
+        IteratorVector1 const& m_input1;
+        IteratorVector2 const& m_input2;
+        std::size_t m_level;
+        std::size_t m_min_elements;
+    };
+
     template <typename ExpandPolicy, typename IteratorVector>
     static inline Box get_new_box(IteratorVector const& input)
     {
@@ -377,14 +553,16 @@ public :
     <
         typename Policy,
         typename IteratorVector1,
-        typename IteratorVector2
+        typename IteratorVector2,
+        typename Tasks
     >
     static inline void apply(Box const& box,
             IteratorVector1 const& input1,
             IteratorVector2 const& input2,
             std::size_t level,
             std::size_t min_elements,
-            Policy& policy, VisitBoxPolicy& box_policy)
+            Policy& policy, VisitBoxPolicy& box_policy,
+            Tasks const& tasks)
     {
         box_policy.apply(box, level);
 
@@ -406,7 +584,7 @@ public :
             {
                 Box exceeding_box = get_new_box(exceeding1, exceeding2);
                 next_level(exceeding_box, exceeding1, exceeding2, level,
-                           min_elements, policy, box_policy);
+                           min_elements, policy, box_policy, tasks);
             }
             else
             {
@@ -421,9 +599,9 @@ public :
             {
                 Box exceeding_box = get_new_box<ExpandPolicy1>(exceeding1);
                 next_level(exceeding_box, exceeding1, lower2, level,
-                           min_elements, policy, box_policy);
+                           min_elements, policy, box_policy, tasks);
                 next_level(exceeding_box, exceeding1, upper2, level,
-                           min_elements, policy, box_policy);
+                           min_elements, policy, box_policy, tasks);
             }
             else
             {
@@ -439,9 +617,9 @@ public :
             {
                 Box exceeding_box = get_new_box<ExpandPolicy2>(exceeding2);
                 next_level(exceeding_box, lower1, exceeding2, level,
-                    min_elements, policy, box_policy);
+                    min_elements, policy, box_policy, tasks);
                 next_level(exceeding_box, upper1, exceeding2, level,
-                    min_elements, policy, box_policy);
+                    min_elements, policy, box_policy, tasks);
             }
             else
             {
@@ -450,32 +628,29 @@ public :
             }
         }
 
-        if (recurse_ok(lower1, lower2, min_elements, level))
-        {
-            next_level(lower_box, lower1, lower2, level,
-                       min_elements, policy, box_policy);
-        }
-        else
-        {
-            handle_two(lower1, lower2, policy);
-        }
-        if (recurse_ok(upper1, upper2, min_elements, level))
-        {
-            next_level(upper_box, upper1, upper2, level,
-                       min_elements, policy, box_policy);
-        }
-        else
-        {
-            handle_two(upper1, upper2, policy);
-        }
+        tasks.apply(
+            half<IteratorVector1, IteratorVector2>(lower_box, lower1, lower2,
+                level, min_elements),
+            half<IteratorVector1, IteratorVector2>(upper_box, upper1, upper2,
+                level, min_elements),
+            policy, box_policy);
     }
 };
 
 struct visit_no_policy
 {
+    visit_no_policy()
+    {}
+
+    visit_no_policy(visit_no_policy const&, split)
+    {}
+
     template <typename Box>
     static inline void apply(Box const&, std::size_t )
     {}
+
+    static inline void join(visit_no_policy const& )
+    {}
 };
 
 struct include_all_policy
@@ -526,13 +701,12 @@ class partition
         }
     }
 
-public :
-    template <typename ForwardRange, typename VisitPolicy>
-    static inline void apply(ForwardRange const& forward_range,
+    template <typename ForwardRange, typename VisitPolicy, typename Tasks>
+    static inline void apply_tasks(ForwardRange const& forward_range,
             VisitPolicy& visitor,
-            std::size_t min_elements = 16,
-            VisitBoxPolicy box_visitor = detail::partition::visit_no_policy()
-            )
+            std::size_t min_elements,
+            VisitBoxPolicy& box_visitor,
+            Tasks const& tasks)
     {
         typedef typename boost::range_iterator
             <
@@ -554,7 +728,7 @@ public :
                     ExpandPolicy1,
                     VisitBoxPolicy
                 >::apply(total, iterator_vector, 0, min_elements,
-                         visitor, box_visitor);
+                         visitor, box_visitor, tasks);
         }
         else
         {
@@ -575,15 +749,15 @@ public :
     <
         typename ForwardRange1,
         typename ForwardRange2,
-        typename VisitPolicy
+        typename VisitPolicy,
+        typename Tasks
     >
-    static inline void apply(ForwardRange1 const& forward_range1,
+    static inline void apply_tasks(ForwardRange1 const& forward_range1,
                 ForwardRange2 const& forward_range2,
                 VisitPolicy& visitor,
-                std::size_t min_elements = 16,
-                VisitBoxPolicy box_visitor
-                    = detail::partition::visit_no_policy()
-                )
+                std::size_t min_elements,
+                VisitBoxPolicy& box_visitor,
+                Tasks const& tasks)
     {
         typedef typename boost::range_iterator
             <
@@ -612,7 +786,7 @@ public :
                     0, Box, OverlapsPolicy1, OverlapsPolicy2,
                     ExpandPolicy1, ExpandPolicy2, VisitBoxPolicy
                 >::apply(total, iterator_vector1, iterator_vector2,
-                         0, min_elements, visitor, box_visitor);
+                         0, min_elements, visitor, box_visitor, tasks);
         }
         else
         {
@@ -629,6 +803,141 @@ public :
             }
         }
     }
+
+    // Called by one thread of the team processing the parallel tasks
+    template <typename ForwardRange, typename VisitPolicy>
+    struct one_range_team_task
+    {
+        one_range_team_task(ForwardRange const& forward_range,
+                VisitPolicy& visitor, std::size_t min_elements,
+                VisitBoxPolicy& box_visitor, std::size_t threads)
+            : m_forward_range(forward_range), m_visitor(visitor)
+            , m_min_elements(min_elements), m_box_visitor(box_visitor)
+            , m_threads(threads)
+        {}
+
+        inline void operator()()
+        {
+            apply_tasks(m_forward_range, m_visitor, m_min_elements,
+                m_box_visitor, detail::partition::parallel_tasks(m_threads));
+        }
+
+        ForwardRange const& m_forward_range;
+        VisitPolicy& m_visitor;
+        std::size_t m_min_elements;
+        VisitBoxPolicy& m_box_visitor;
+        std::size_t m_threads;
+    };
+
+    template
+    <
+        typename ForwardRange1,
+        typename ForwardRange2,
+        typename VisitPolicy
+    >
+    struct two_ranges_team_task
+    {
+        two_ranges_team_task(ForwardRange1 const& forward_range1,
+                ForwardRange2 const& forward_range2,
+                VisitPolicy& visitor, std::size_t min_elements,
+                VisitBoxPolicy& box_visitor, std::size_t threads)
+            : m_forward_range1(forward_range1)
+            , m_forward_range2(forward_range2)
+            , m_visitor(visitor)
+            , m_min_elements(min_elements), m_box_visitor(box_visitor)
+            , m_threads(threads)
+        {}
+
+        inline void operator()()
+        {
+            apply_tasks(m_forward_range1, m_forward_range2, m_visitor,
+                m_min_elements, m_box_visitor,
+                detail::partition::parallel_tasks(m_threads));
+        }
+
+        ForwardRange1 const& m_forward_range1;
+        ForwardRange2 const& m_forward_range2;
+        VisitPolicy& m_visitor;
+        std::size_t m_min_elements;
+        VisitBoxPolicy& m_box_visitor;
+        std::size_t m_threads;
+    };
+
+public :
+    template <typename ForwardRange, typename VisitPolicy>
+    static inline void apply(ForwardRange const& forward_range,
+            VisitPolicy& visitor,
+            std::size_t min_elements = 16,
+            VisitBoxPolicy box_visitor = detail::partition::visit_no_policy()
+            )
+    {
+        apply_tasks(forward_range, visitor, min_elements, box_visitor,
+                    detail::partition::sequential_tasks());
+    }
+
+    template
+    <
+        typename ForwardRange1,
+        typename ForwardRange2,
+        typename VisitPolicy
+    >
+    static inline void apply(ForwardRange1 const& forward_range1,
+                ForwardRange2 const& forward_range2,
+                VisitPolicy& visitor,
+                std::size_t min_elements = 16,
+                VisitBoxPolicy box_visitor
+                    = detail::partition::visit_no_policy()
+                )
+    {
+        apply_tasks(forward_range1, forward_range2, visitor, min_elements,
+                    box_visitor, detail::partition::sequential_tasks());
+    }
+
+    // Parallel versions, the lower and upper halves of the boxes are
+    // processed as parallel tasks. The visitor has to be constructible
+    // with VisitPolicy(visitor, detail::partition::split()), creating
+    // the visitor of a task, and it has to define visitor.join(other)
+    // merging the results of the other visitor, see parallel_tasks.
+    // The same is required of the box visitor.
+    template <typename ForwardRange, typename VisitPolicy>
+    static inline void apply(ForwardRange const& forward_range,
+            VisitPolicy& visitor,
+            geometry::parallel parallel_policy,
+            std::size_t min_elements = 16,
+            VisitBoxPolicy box_visitor = detail::partition::visit_no_policy()
+            )
+    {
+        std::size_t const threads
+            = geometry::detail::parallel::threads_count(parallel_policy);
+
+        one_range_team_task<ForwardRange, VisitPolicy>
+            task(forward_range, visitor, min_elements, box_visitor, threads);
+        geometry::detail::parallel::run_team(task, threads);
+    }
+
+    template
+    <
+        typename ForwardRange1,
+        typename ForwardRange2,
+        typename VisitPolicy
+    >
+    static inline void apply(ForwardRange1 const& forward_range1,
+                ForwardRange2 const& forward_range2,
+                VisitPolicy& visitor,
+                geometry::parallel parallel_policy,
+                std::size_t min_elements = 16,
+                VisitBoxPolicy box_visitor
+                    = detail::partition::visit_no_policy()
+                )
+    {
+        std::size_t const threads
+            = geometry::detail::parallel::threads_count(parallel_policy);
+
+        two_ranges_team_task<ForwardRange1, ForwardRange2, VisitPolicy>
+            task(forward_range1, forward_range2, visitor, min_elements,
+                 box_visitor, threads);
+        geometry::detail::parallel::run_team(task, threads);
+    }
 };
 
 
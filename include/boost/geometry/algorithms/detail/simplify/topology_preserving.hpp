@@ -0,0 +1,697 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_SIMPLIFY_TOPOLOGY_PRESERVING_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_DETAIL_SIMPLIFY_TOPOLOGY_PRESERVING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <boost/range.hpp>
+
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/interior_type.hpp>
+#include <boost/geometry/core/mutable_range.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+
+#include <boost/geometry/algorithms/detail/equals/point_point.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/expand.hpp>
+
+// The rtree depends on distance, which includes it itself
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/geometry/policies/compare.hpp>
+#include <boost/geometry/strategies/agnostic/simplify_visvalingam_whyatt.hpp>
+#include <boost/geometry/strategies/cartesian/side_by_triangle.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace simplify
+{
+
+
+// Simplifies rings together, with the Visvalingam-Whyatt algorithm.
+// The rings are divided into arcs at the nodes, the points which have
+// other than two neighbours in all the rings. The same arc found in
+// several rings (in either direction) is stored and simplified once.
+template <typename Point>
+class topology_preserving_simplifier
+{
+    typedef geometry::less<Point> less_type;
+    typedef strategy::simplify::detail::visvalingam_whyatt_vertices
+        <
+            Point
+        > vertices_type;
+
+public :
+
+    typedef typename vertices_type::area_type area_type;
+
+    // Adds a ring, returns its index
+    template <typename Ring>
+    inline std::size_t add_ring(Ring const& ring_in)
+    {
+        ring_data data;
+        data.closed = geometry::closure<Ring>::value != geometry::open;
+
+        // The points without the closing point and duplicates
+        for (typename boost::range_iterator<Ring const>::type
+                it = boost::begin(ring_in); it != boost::end(ring_in); ++it)
+        {
+            if (data.points.empty()
+                || ! detail::equals::equals_point_point(data.points.back(), *it))
+            {
+                data.points.push_back(*it);
+            }
+        }
+        while (data.points.size() > 1
+            && detail::equals::equals_point_point(data.points.front(),
+                                                  data.points.back()))
+        {
+            data.points.pop_back();
+        }
+
+        m_rings.push_back(data);
+        return m_rings.size() - 1;
+    }
+
+    inline void apply(area_type const& max_area)
+    {
+        count_neighbours();
+
+        for (std::size_t r = 0; r < m_rings.size(); ++r)
+        {
+            if (m_rings[r].points.size() >= 3)
+            {
+                split_ring(r);
+            }
+        }
+
+        simplify(max_area);
+    }
+
+    // Assigns the simplified ring to the output ring
+    template <typename RingOut>
+    inline void get_ring(std::size_t r, RingOut& ring_out) const
+    {
+        std::vector<Point> const points = ring_points(r);
+
+        traits::clear<RingOut>::apply(ring_out);
+        for (typename std::vector<Point>::const_iterator
+                it = points.begin(); it != points.end(); ++it)
+        {
+            traits::push_back<RingOut>::apply(ring_out, *it);
+        }
+        if (m_rings[r].closed && ! points.empty())
+        {
+            traits::push_back<RingOut>::apply(ring_out, points.front());
+        }
+    }
+
+private :
+
+    struct ring_data
+    {
+        ring_data()
+            : closed(true), count(0)
+        {}
+
+        std::vector<Point> points;
+        bool closed;
+
+        // The arcs of the ring, and whether they're reversed
+        std::vector<std::pair<std::size_t, bool> > arcs;
+
+        // The number of remaining vertices
+        std::size_t count;
+    };
+
+    struct neighbours
+    {
+        neighbours()
+            : count(0)
+        {}
+
+        inline void add(Point const& p)
+        {
+            if (count == 0)
+            {
+                first = p;
+                count = 1;
+            }
+            else if (count == 1)
+            {
+                if (! detail::equals::equals_point_point(first, p))
+                {
+                    second = p;
+                    count = 2;
+                }
+            }
+            else if (count == 2)
+            {
+                if (! detail::equals::equals_point_point(first, p)
+                    && ! detail::equals::equals_point_point(second, p))
+                {
+                    count = 3;
+                }
+            }
+        }
+
+        Point first;
+        Point second;
+        int count;
+    };
+
+    typedef std::map<Point, neighbours, less_type> neighbours_map;
+    typedef std::pair<Point, Point> arc_key;
+
+    struct arc_key_less
+    {
+        inline bool operator()(arc_key const& left, arc_key const& right) const
+        {
+            less_type less;
+            return less(left.first, right.first)
+                || (! less(right.first, left.first)
+                    && less(left.second, right.second));
+        }
+    };
+
+    inline void count_neighbours()
+    {
+        for (std::size_t r = 0; r < m_rings.size(); ++r)
+        {
+            std::vector<Point> const& points = m_rings[r].points;
+            std::size_t const n = points.size();
+            if (n < 3)
+            {
+                continue;
+            }
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                neighbours& nb = m_neighbours[points[i]];
+                nb.add(points[(i + n - 1) % n]);
+                nb.add(points[(i + 1) % n]);
+            }
+        }
+    }
+
+    inline bool is_node(Point const& p) const
+    {
+        typename neighbours_map::const_iterator it = m_neighbours.find(p);
+        return it == m_neighbours.end() || it->second.count != 2;
+    }
+
+    inline void split_ring(std::size_t r)
+    {
+        ring_data& ring = m_rings[r];
+        std::vector<Point> const& points = ring.points;
+        std::size_t const n = points.size();
+
+        // Start at a node. A ring without nodes (e.g. an island in a hole
+        // shared by the hole) starts at its smallest point, so it is
+        // divided in the same way in all rings containing it.
+        less_type less;
+        std::size_t start = n;
+        std::size_t smallest = 0;
+        for (std::size_t i = 0; i < n && start == n; ++i)
+        {
+            if (is_node(points[i]))
+            {
+                start = i;
+            }
+            if (less(points[i], points[smallest]))
+            {
+                smallest = i;
+            }
+        }
+        if (start == n)
+        {
+            start = smallest;
+        }
+
+        std::size_t i = start;
+        do
+        {
+            std::vector<Point> arc;
+            arc.push_back(points[i]);
+            do
+            {
+                i = (i + 1) % n;
+                arc.push_back(points[i]);
+            }
+            while (i != start && ! is_node(points[i]));
+
+            add_arc(r, arc);
+        }
+        while (i != start);
+    }
+
+    inline void add_arc(std::size_t r, std::vector<Point>& arc)
+    {
+        std::size_t const k = arc.size() - 1;
+        arc_key const forward(arc[0], arc[1]);
+        arc_key const backward(arc[k], arc[k - 1]);
+
+        bool const reversed = arc_key_less()(backward, forward);
+        if (reversed)
+        {
+            std::reverse(arc.begin(), arc.end());
+        }
+
+        arc_key const key = reversed ? backward : forward;
+        typename std::map<arc_key, std::size_t, arc_key_less>::const_iterator
+            it = m_arc_ids.find(key);
+
+        std::size_t id = 0;
+        if (it == m_arc_ids.end())
+        {
+            id = m_arcs.size();
+            m_arc_ids.insert(std::make_pair(key, id));
+            m_arcs.push_back(arc);
+            m_arc_rings.push_back(std::vector<std::size_t>());
+        }
+        else
+        {
+            id = it->second;
+        }
+
+        m_arc_rings[id].push_back(r);
+        m_rings[r].arcs.push_back(std::make_pair(id, reversed));
+        m_rings[r].count += arc.size() - 1;
+    }
+
+    typedef std::pair<Point, std::size_t> indexed_point;
+    typedef index::rtree<indexed_point, index::rstar<16> > rtree_type;
+
+    // The envelope of the segment from a vertex to its next vertex
+    typedef model::box<Point> box_type;
+    typedef std::pair<box_type, std::size_t> indexed_segment;
+    typedef index::rtree<indexed_segment, index::rstar<16> > segment_rtree_type;
+
+    static inline indexed_segment make_segment(Point const& p, Point const& q,
+                                               std::size_t i)
+    {
+        box_type box;
+        geometry::envelope(p, box);
+        geometry::expand(box, q);
+        return indexed_segment(box, i);
+    }
+
+    // Checks whether a vertex can be removed
+    struct remove_policy
+    {
+        remove_policy(topology_preserving_simplifier& simplifier,
+                      vertices_type const& vertices,
+                      rtree_type const& tree,
+                      segment_rtree_type& segments)
+            : m_simplifier(simplifier)
+            , m_vertices(vertices)
+            , m_tree(tree)
+            , m_segments(segments)
+        {}
+
+        inline bool operator()(std::size_t i, std::size_t prev, std::size_t next)
+        {
+            std::vector<std::size_t> const& rings
+                = m_simplifier.m_arc_rings[m_simplifier.m_vertex_arcs[i]];
+
+            for (std::size_t r = 0; r < rings.size(); ++r)
+            {
+                if (m_simplifier.m_rings[rings[r]].count <= 3)
+                {
+                    return false;
+                }
+            }
+
+            Point const& a = m_vertices.point(prev);
+            Point const& b = m_vertices.point(i);
+            Point const& c = m_vertices.point(next);
+
+            box_type box;
+            geometry::envelope(a, box);
+            geometry::expand(box, b);
+            geometry::expand(box, c);
+
+            m_found.clear();
+            m_tree.query(index::intersects(box), std::back_inserter(m_found));
+
+            for (typename std::vector<indexed_point>::const_iterator
+                    it = m_found.begin(); it != m_found.end(); ++it)
+            {
+                std::size_t const j = it->second;
+                if (j == i || j == prev || j == next || m_vertices.removed(j)
+                    || detail::equals::equals_point_point(it->first, a)
+                    || detail::equals::equals_point_point(it->first, b)
+                    || detail::equals::equals_point_point(it->first, c))
+                {
+                    continue;
+                }
+
+                if (in_triangle(a, b, c, it->first))
+                {
+                    // Removing the vertex would move the boundary
+                    // over this vertex
+                    return false;
+                }
+            }
+
+            // The new segment may not cross, touch or overlap another
+            // segment, e.g. another arc between the same nodes which is
+            // collapsed onto the same segment
+            indexed_segment const added = make_segment(a, c, prev);
+
+            m_found_segments.clear();
+            m_segments.query(index::intersects(added.first),
+                             std::back_inserter(m_found_segments));
+
+            for (typename std::vector<indexed_segment>::const_iterator
+                    it = m_found_segments.begin();
+                    it != m_found_segments.end(); ++it)
+            {
+                std::size_t const j = it->second;
+                if (j == prev || j == i)
+                {
+                    // The segments replaced by the new segment
+                    continue;
+                }
+
+                if (intersects(a, c, m_vertices.point(j),
+                               m_vertices.point(m_vertices.next(j))))
+                {
+                    return false;
+                }
+            }
+
+            m_segments.remove(make_segment(a, b, prev));
+            m_segments.remove(make_segment(b, c, i));
+            m_segments.insert(added);
+
+            for (std::size_t r = 0; r < rings.size(); ++r)
+            {
+                m_simplifier.m_rings[rings[r]].count--;
+            }
+            return true;
+        }
+
+        static inline bool in_triangle(Point const& a, Point const& b,
+                                       Point const& c, Point const& p)
+        {
+            typedef strategy::side::side_by_triangle<> side;
+            int const s1 = side::apply(a, b, p);
+            int const s2 = side::apply(b, c, p);
+            int const s3 = side::apply(c, a, p);
+            return (s1 >= 0 && s2 >= 0 && s3 >= 0)
+                || (s1 <= 0 && s2 <= 0 && s3 <= 0);
+        }
+
+        // Returns true if the segments a-c and p-q have other points
+        // in common than a shared endpoint
+        static inline bool intersects(Point const& a, Point const& c,
+                                      Point const& p, Point const& q)
+        {
+            typedef strategy::side::side_by_triangle<> side;
+            int const side_p = side::apply(a, c, p);
+            int const side_q = side::apply(a, c, q);
+
+            if (side_p == 0 && side_q == 0)
+            {
+                // Collinear, the points are ordered along the line
+                less_type less;
+                Point const& min1 = less(a, c) ? a : c;
+                Point const& max1 = less(a, c) ? c : a;
+                Point const& min2 = less(p, q) ? p : q;
+                Point const& max2 = less(p, q) ? q : p;
+                return less(min1, max2) && less(min2, max1);
+            }
+
+            if (side_p * side_q > 0
+                || side::apply(p, q, a) * side::apply(p, q, c) > 0)
+            {
+                return false;
+            }
+
+            // The segments meet in one point, which is allowed
+            // if it is an endpoint of both of them
+            return ! (detail::equals::equals_point_point(p, a)
+                   || detail::equals::equals_point_point(p, c)
+                   || detail::equals::equals_point_point(q, a)
+                   || detail::equals::equals_point_point(q, c));
+        }
+
+        topology_preserving_simplifier& m_simplifier;
+        vertices_type const& m_vertices;
+        rtree_type const& m_tree;
+        segment_rtree_type& m_segments;
+        std::vector<indexed_point> m_found;
+        std::vector<indexed_segment> m_found_segments;
+    };
+
+    inline void simplify(area_type const& max_area)
+    {
+        std::vector<indexed_point> values;
+        std::vector<indexed_segment> segment_values;
+        for (std::size_t a = 0; a < m_arcs.size(); ++a)
+        {
+            std::vector<Point> const& arc = m_arcs[a];
+            std::size_t const first
+                = m_vertices.add_chain(arc.begin(), arc.end());
+            m_arc_first.push_back(first);
+            for (std::size_t i = 0; i < arc.size(); ++i)
+            {
+                m_vertex_arcs.push_back(a);
+                values.push_back(indexed_point(arc[i], first + i));
+                if (i + 1 < arc.size())
+                {
+                    segment_values.push_back(
+                        make_segment(arc[i], arc[i + 1], first + i));
+                }
+            }
+        }
+
+        rtree_type const tree(values.begin(), values.end());
+        segment_rtree_type segments(segment_values.begin(),
+                                    segment_values.end());
+
+        remove_policy policy(*this, m_vertices, tree, segments);
+        m_vertices.apply(max_area, policy);
+    }
+
+    // The remaining points of the ring, starting at the first point of the
+    // input ring if it is kept, without the closing point
+    inline std::vector<Point> ring_points(std::size_t r) const
+    {
+        ring_data const& ring = m_rings[r];
+        if (ring.arcs.empty())
+        {
+            return ring.points;
+        }
+
+        std::vector<Point> result;
+        for (std::size_t a = 0; a < ring.arcs.size(); ++a)
+        {
+            std::size_t const id = ring.arcs[a].first;
+            std::size_t const first = m_arc_first[id];
+            std::size_t const last = first + m_arcs[id].size() - 1;
+
+            std::vector<Point> arc;
+            for (std::size_t i = first; i != vertices_type::none;
+                 i = m_vertices.next(i))
+            {
+                arc.push_back(m_vertices.point(i));
+                if (i == last)
+                {
+                    break;
+                }
+            }
+            if (ring.arcs[a].second)
+            {
+                std::reverse(arc.begin(), arc.end());
+            }
+
+            // The last point is the first point of the next arc
+            result.insert(result.end(), arc.begin(), arc.end() - 1);
+        }
+
+        typename std::vector<Point>::iterator it = result.begin();
+        for (; it != result.end(); ++it)
+        {
+            if (detail::equals::equals_point_point(*it, ring.points.front()))
+            {
+                break;
+            }
+        }
+        if (it != result.end())
+        {
+            std::rotate(result.begin(), it, result.end());
+        }
+        return result;
+    }
+
+    std::vector<ring_data> m_rings;
+
+    neighbours_map m_neighbours;
+
+    std::vector<std::vector<Point> > m_arcs;
+    std::vector<std::vector<std::size_t> > m_arc_rings;
+    std::map<arc_key, std::size_t, arc_key_less> m_arc_ids;
+
+    vertices_type m_vertices;
+    std::vector<std::size_t> m_arc_first;
+    std::vector<std::size_t> m_vertex_arcs;
+};
+
+
+template
+<
+    typename Geometry,
+    typename Tag = typename tag<Geometry>::type
+>
+struct topology_preserving_rings
+{};
+
+template <typename Ring>
+struct topology_preserving_rings<Ring, ring_tag>
+{
+    template <typename Simplifier>
+    static inline void add(Simplifier& simplifier, Ring const& ring, Ring& )
+    {
+        simplifier.add_ring(ring);
+    }
+
+    template <typename Simplifier>
+    static inline void get(Simplifier const& simplifier, std::size_t& index,
+                           Ring& ring)
+    {
+        simplifier.get_ring(index++, ring);
+    }
+};
+
+template <typename Polygon>
+struct topology_preserving_rings<Polygon, polygon_tag>
+{
+    template <typename Simplifier>
+    static inline void add(Simplifier& simplifier, Polygon const& polygon,
+                           Polygon& out)
+    {
+        typedef typename interior_type<Polygon>::type rings_type;
+
+        simplifier.add_ring(exterior_ring(polygon));
+
+        rings_type const& rings = interior_rings(polygon);
+        for (typename boost::range_iterator<rings_type const>::type
+                it = boost::begin(rings); it != boost::end(rings); ++it)
+        {
+            simplifier.add_ring(*it);
+        }
+
+        traits::resize<rings_type>::apply(interior_rings(out),
+                                          boost::size(rings));
+    }
+
+    template <typename Simplifier>
+    static inline void get(Simplifier const& simplifier, std::size_t& index,
+                           Polygon& polygon)
+    {
+        typedef typename interior_type<Polygon>::type rings_type;
+
+        simplifier.get_ring(index++, exterior_ring(polygon));
+
+        rings_type& rings = interior_rings(polygon);
+        for (typename boost::range_iterator<rings_type>::type
+                it = boost::begin(rings); it != boost::end(rings); ++it)
+        {
+            simplifier.get_ring(index++, *it);
+        }
+    }
+};
+
+template <typename MultiPolygon>
+struct topology_preserving_rings<MultiPolygon, multi_polygon_tag>
+{
+    typedef topology_preserving_rings
+        <
+            typename boost::range_value<MultiPolygon>::type
+        > policy;
+
+    template <typename Simplifier>
+    static inline void add(Simplifier& simplifier, MultiPolygon const& multi,
+                           MultiPolygon& out)
+    {
+        traits::resize<MultiPolygon>::apply(out, boost::size(multi));
+
+        typename boost::range_iterator<MultiPolygon>::type
+            it_out = boost::begin(out);
+        for (typename boost::range_iterator<MultiPolygon const>::type
+                it = boost::begin(multi); it != boost::end(multi);
+                ++it, ++it_out)
+        {
+            policy::add(simplifier, *it, *it_out);
+        }
+    }
+
+    template <typename Simplifier>
+    static inline void get(Simplifier const& simplifier, std::size_t& index,
+                           MultiPolygon& multi)
+    {
+        for (typename boost::range_iterator<MultiPolygon>::type
+                it = boost::begin(multi); it != boost::end(multi); ++it)
+        {
+            policy::get(simplifier, index, *it);
+        }
+    }
+};
+
+
+// Simplifies all the rings of a ring, polygon or multi-polygon together
+struct simplify_topology_preserving
+{
+    template <typename Geometry, typename Distance, typename Strategy>
+    static inline void apply(Geometry const& geometry, Geometry& out,
+                             Distance const& max_area, Strategy const& )
+    {
+        typedef topology_preserving_rings<Geometry> rings;
+        typedef topology_preserving_simplifier
+            <
+                typename point_type<Geometry>::type
+            > simplifier_type;
+
+        simplifier_type simplifier;
+        rings::add(simplifier, geometry, out);
+        if (! (max_area < 0))
+        {
+            simplifier.apply(max_area);
+        }
+
+        std::size_t index = 0;
+        rings::get(simplifier, index, out);
+    }
+};
+
+
+}} // namespace detail::simplify
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_SIMPLIFY_TOPOLOGY_PRESERVING_HPP
@@ -68,21 +68,6 @@ public:
         }
 
         CT const c1 = 1;
-        CT const c2 = 2;
-        CT const c3 = 3;
-        CT const c4 = 4;
-        CT const c16 = 16;
-        CT const c_e_12 = CT(1e-12);
-
-        CT const pi = geometry::math::pi<CT>();
-        CT const two_pi = c2 * pi;
-
-        // lambda: difference in longitude on an auxiliary sphere
-        CT L = lon2 - lon1;
-        CT lambda = L;
-
-        if (L < -pi) L += two_pi;
-        if (L > pi) L -= two_pi;
 
         CT const radius_a = CT(get_radius<0>(spheroid));
         CT const radius_b = CT(get_radius<2>(spheroid));
@@ -111,6 +96,42 @@ public:
         //sin_U1 = tan_U1 * cos_U1; // sin(U1);
         //sin_U2 = tan_U2 * cos_U2; // sin(U2);
 
+        return apply_reduced(CT(lon2 - lon1),
+                             sin_U1, cos_U1, sin_U2, cos_U2,
+                             radius_a, radius_b, flattening);
+    }
+
+    // The part of the calculation depending on both points. The sines and
+    // cosines of the reduced latitudes and the parameters of the spheroid
+    // are passed, so they may be calculated once for many pairs of points.
+    static inline result_type apply_reduced(CT const& d_lon,
+                                            CT const& sin_U1,
+                                            CT const& cos_U1,
+                                            CT const& sin_U2,
+                                            CT const& cos_U2,
+                                            CT const& radius_a,
+                                            CT const& radius_b,
+                                            CT const& flattening)
+    {
+        result_type result;
+
+        CT const c1 = 1;
+        CT const c2 = 2;
+        CT const c3 = 3;
+        CT const c4 = 4;
+        CT const c16 = 16;
+        CT const c_e_12 = CT(1e-12);
+
+        CT const pi = geometry::math::pi<CT>();
+        CT const two_pi = c2 * pi;
+
+        // lambda: difference in longitude on an auxiliary sphere
+        CT L = d_lon;
+        CT lambda = L;
+
+        if (L < -pi) L += two_pi;
+        if (L > pi) L -= two_pi;
+
         CT previous_lambda;
         CT sin_lambda;
         CT cos_lambda;
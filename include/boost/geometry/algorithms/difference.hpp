@@ -13,6 +13,7 @@
 
 #include <boost/geometry/algorithms/detail/overlay/intersection_insert.hpp>
 #include <boost/geometry/policies/robustness/get_rescale_policy.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 namespace boost { namespace geometry
 {
@@ -163,6 +164,65 @@ inline void difference(Geometry1 const& geometry1,
 }
 
 
+/*!
+\brief_calc2{difference}, using parallel tasks
+\ingroup difference
+\details \details_calc2{difference, spatial set theoretic difference}.
+    The turns are calculated per pair of sections and enriched per ring by
+    parallel tasks, and the parents of the output rings are assigned by
+    parallel tasks. The traversal assembling the output rings is sequential.
+    The result is the same as the result of the sequential version.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Collection \tparam_output_collection
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param output_collection the output collection
+\param parallel_policy the parallel execution policy
+
+\qbk{distinguish,parallel}
+*/
+template
+<
+    typename Geometry1,
+    typename Geometry2,
+    typename Collection
+>
+inline void difference(Geometry1 const& geometry1,
+            Geometry2 const& geometry2, Collection& output_collection,
+            geometry::parallel const& parallel_policy)
+{
+    concept::check<Geometry1 const>();
+    concept::check<Geometry2 const>();
+
+    typedef typename boost::range_value<Collection>::type geometry_out;
+    concept::check<geometry_out>();
+
+    typedef typename geometry::rescale_overlay_policy_type
+        <
+            Geometry1,
+            Geometry2
+        >::type rescale_policy_type;
+
+    rescale_policy_type robust_policy
+            = geometry::get_rescale_policy<rescale_policy_type>(geometry1, geometry2);
+
+    typedef strategy_intersection
+        <
+            typename cs_tag<geometry_out>::type,
+            Geometry1,
+            Geometry2,
+            typename geometry::point_type<geometry_out>::type,
+            rescale_policy_type
+        > strategy;
+
+    detail::difference::difference_insert<geometry_out>(
+            geometry1, geometry2, robust_policy,
+            std::back_inserter(output_collection),
+            detail::overlay::parallel_strategy<strategy>(parallel_policy));
+}
+
+
 }} // namespace boost::geometry
 
 
@@ -0,0 +1,367 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_DISTANCE_MATRIX_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_DISTANCE_MATRIX_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/range.hpp>
+
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/algorithms/detail/distance/default_strategies.hpp>
+#include <boost/geometry/algorithms/detail/distance_matrix/kernel.hpp>
+#include <boost/geometry/algorithms/detail/distance_matrix/geographic.hpp>
+
+#include <boost/geometry/util/parallel.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace distance_matrix
+{
+
+
+template <typename Range1, typename Range2, typename Strategy>
+struct kernel_type
+{
+    typedef kernel
+        <
+            typename boost::range_value<Range1>::type,
+            Range2,
+            Strategy
+        > type;
+};
+
+
+template <typename Point, typename Range>
+struct default_strategy
+{
+    typedef typename detail::distance::default_strategy
+        <
+            Point, typename boost::range_value<Range>::type
+        >::type type;
+};
+
+
+template <typename Point, typename Range, typename OutputIterator, typename Strategy>
+inline OutputIterator distances(Point const& point, Range const& range,
+                                OutputIterator out, Strategy const& strategy)
+{
+    typedef kernel<Point, Range, Strategy> kernel_type;
+    typedef typename kernel_type::result_type result_type;
+
+    kernel_type const kernel(range, strategy);
+    if (kernel.size() == 0)
+    {
+        return out;
+    }
+
+    std::vector<result_type> row(kernel.size());
+    kernel.apply(point, &row[0]);
+    return std::copy(row.begin(), row.end(), out);
+}
+
+
+// Calculates the rows of the matrix, each one is calculated into a buffer
+// and copied to its place in the output
+template <typename Kernel, typename Iterator, typename OutputIterator>
+class rows
+{
+    typedef typename Kernel::result_type result_type;
+
+public :
+    inline rows(Kernel const& kernel, Iterator first, OutputIterator out)
+        : m_kernel(kernel)
+        , m_first(first)
+        , m_out(out)
+    {}
+
+    inline void operator()(std::size_t index) const
+    {
+        std::size_t const count = m_kernel.size();
+        std::vector<result_type> row(count);
+        m_kernel.apply(*(m_first + index), &row[0]);
+        std::copy(row.begin(), row.end(), m_out + index * count);
+    }
+
+private :
+    Kernel const& m_kernel;
+    Iterator m_first;
+    OutputIterator m_out;
+};
+
+
+template
+<
+    typename Range1, typename Range2,
+    typename OutputIterator, typename Strategy
+>
+inline OutputIterator distance_matrix(Range1 const& range1,
+                                      Range2 const& range2,
+                                      OutputIterator out,
+                                      Strategy const& strategy)
+{
+    typedef typename kernel_type<Range1, Range2, Strategy>::type kernel_type;
+    typedef typename kernel_type::result_type result_type;
+
+    kernel_type const kernel(range2, strategy);
+    if (kernel.size() == 0)
+    {
+        return out;
+    }
+
+    std::vector<result_type> row(kernel.size());
+    for (typename boost::range_iterator<Range1 const>::type
+            it = boost::begin(range1);
+         it != boost::end(range1);
+         ++it)
+    {
+        kernel.apply(*it, &row[0]);
+        out = std::copy(row.begin(), row.end(), out);
+    }
+    return out;
+}
+
+template
+<
+    typename Range1, typename Range2,
+    typename RandomAccessIterator, typename Strategy
+>
+inline RandomAccessIterator distance_matrix(Range1 const& range1,
+                                            Range2 const& range2,
+                                            RandomAccessIterator out,
+                                            Strategy const& strategy,
+                                            std::size_t threads)
+{
+    typedef typename kernel_type<Range1, Range2, Strategy>::type kernel_type;
+    typedef typename boost::range_iterator<Range1 const>::type iterator_type;
+
+    kernel_type const kernel(range2, strategy);
+    std::size_t const count1 = boost::size(range1);
+    std::size_t const count2 = kernel.size();
+    if (count1 == 0 || count2 == 0)
+    {
+        return out;
+    }
+
+    rows<kernel_type, iterator_type, RandomAccessIterator>
+        f(kernel, boost::begin(range1), out);
+    detail::parallel::for_each_index(count1, f, threads);
+
+    return out + count1 * count2;
+}
+
+
+}} // namespace detail::distance_matrix
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Calculates the distances between a point and all points of a range
+\ingroup distance
+\details The values of the strategy depending only on one point, e.g.
+    the reduced latitudes of the geographic strategies, are calculated
+    once for each point.
+\tparam Point \tparam_point
+\tparam Range Range of points, e.g. a multi_point or a std::vector of points
+\tparam OutputIterator Output iterator of the distances
+\tparam Strategy \tparam_strategy{Distance}
+\param point \param_point
+\param range The range of points
+\param out The output iterator, the distances are written in the order of
+    the points of the range
+\param strategy The point-point distance strategy
+\return The output iterator after the last distance
+
+\qbk{distinguish,with strategy}
+*/
+template <typename Point, typename Range, typename OutputIterator, typename Strategy>
+inline OutputIterator distances(Point const& point, Range const& range,
+                                OutputIterator out, Strategy const& strategy)
+{
+    concept::check<Point const>();
+    concept::check<typename boost::range_value<Range>::type const>();
+
+    return detail::distance_matrix::distances(point, range, out, strategy);
+}
+
+/*!
+\brief Calculates the distances between a point and all points of a range
+\ingroup distance
+\details The default strategy is used, corresponding to the coordinate
+    system of the points.
+\tparam Point \tparam_point
+\tparam Range Range of points, e.g. a multi_point or a std::vector of points
+\tparam OutputIterator Output iterator of the distances
+\param point \param_point
+\param range The range of points
+\param out The output iterator, the distances are written in the order of
+    the points of the range
+\return The output iterator after the last distance
+*/
+template <typename Point, typename Range, typename OutputIterator>
+inline OutputIterator distances(Point const& point, Range const& range,
+                                OutputIterator out)
+{
+    typedef typename detail::distance_matrix::default_strategy
+        <
+            Point, Range
+        >::type strategy_type;
+
+    return geometry::distances(point, range, out, strategy_type());
+}
+
+
+/*!
+\brief Calculates the distances between all points of the first range and
+    all points of the second range
+\ingroup distance
+\details The distances are written row by row, the row of a point of the
+    first range contains its distances to all points of the second range.
+    The values of the strategy depending only on one point, e.g. the
+    reduced latitudes of the geographic strategies, are calculated once
+    for each point.
+\tparam Range1 Range of points
+\tparam Range2 Range of points
+\tparam OutputIterator Output iterator of the distances
+\tparam Strategy \tparam_strategy{Distance}
+\param range1 The first range of points, the rows of the matrix
+\param range2 The second range of points, the columns of the matrix
+\param out The output iterator of size(range1) * size(range2) distances
+\param strategy The point-point distance strategy
+\return The output iterator after the last distance
+
+\qbk{distinguish,with strategy}
+*/
+template
+<
+    typename Range1, typename Range2,
+    typename OutputIterator, typename Strategy
+>
+inline OutputIterator distance_matrix(Range1 const& range1,
+                                      Range2 const& range2,
+                                      OutputIterator out,
+                                      Strategy const& strategy)
+{
+    concept::check<typename boost::range_value<Range1>::type const>();
+    concept::check<typename boost::range_value<Range2>::type const>();
+
+    return detail::distance_matrix::distance_matrix(range1, range2, out, strategy);
+}
+
+/*!
+\brief Calculates the distances between all points of the first range and
+    all points of the second range
+\ingroup distance
+\details The default strategy is used, corresponding to the coordinate
+    system of the points.
+\tparam Range1 Range of points
+\tparam Range2 Range of points
+\tparam OutputIterator Output iterator of the distances
+\param range1 The first range of points, the rows of the matrix
+\param range2 The second range of points, the columns of the matrix
+\param out The output iterator of size(range1) * size(range2) distances
+\return The output iterator after the last distance
+*/
+template <typename Range1, typename Range2, typename OutputIterator>
+inline OutputIterator distance_matrix(Range1 const& range1,
+                                      Range2 const& range2,
+                                      OutputIterator out)
+{
+    typedef typename detail::distance_matrix::default_strategy
+        <
+            typename boost::range_value<Range1>::type, Range2
+        >::type strategy_type;
+
+    return geometry::distance_matrix(range1, range2, out, strategy_type());
+}
+
+/*!
+\brief Calculates the distances between all points of the first range and
+    all points of the second range in parallel
+\ingroup distance
+\details The rows of the matrix are calculated in parallel, the result is
+    the same as the result of the sequential version.
+\tparam Range1 Random access range of points
+\tparam Range2 Range of points
+\tparam RandomAccessIterator Random access output iterator of the distances
+\tparam Strategy \tparam_strategy{Distance}
+\param range1 The first range of points, the rows of the matrix
+\param range2 The second range of points, the columns of the matrix
+\param out The output iterator of size(range1) * size(range2) distances
+\param strategy The point-point distance strategy
+\param policy The parallel execution policy
+\return The output iterator after the last distance
+
+\qbk{distinguish,with strategy and parallel policy}
+*/
+template
+<
+    typename Range1, typename Range2,
+    typename RandomAccessIterator, typename Strategy
+>
+inline RandomAccessIterator distance_matrix(Range1 const& range1,
+                                            Range2 const& range2,
+                                            RandomAccessIterator out,
+                                            Strategy const& strategy,
+                                            parallel const& policy)
+{
+    concept::check<typename boost::range_value<Range1>::type const>();
+    concept::check<typename boost::range_value<Range2>::type const>();
+
+    return detail::distance_matrix::distance_matrix(range1, range2, out, strategy,
+                detail::parallel::threads_count(policy));
+}
+
+/*!
+\brief Calculates the distances between all points of the first range and
+    all points of the second range in parallel
+\ingroup distance
+\details The default strategy is used, corresponding to the coordinate
+    system of the points. The rows of the matrix are calculated in
+    parallel, the result is the same as the result of the sequential
+    version.
+\tparam Range1 Random access range of points
+\tparam Range2 Range of points
+\tparam RandomAccessIterator Random access output iterator of the distances
+\param range1 The first range of points, the rows of the matrix
+\param range2 The second range of points, the columns of the matrix
+\param out The output iterator of size(range1) * size(range2) distances
+\param policy The parallel execution policy
+\return The output iterator after the last distance
+
+\qbk{distinguish,with parallel policy}
+*/
+template <typename Range1, typename Range2, typename RandomAccessIterator>
+inline RandomAccessIterator distance_matrix(Range1 const& range1,
+                                            Range2 const& range2,
+                                            RandomAccessIterator out,
+                                            parallel const& policy)
+{
+    typedef typename detail::distance_matrix::default_strategy
+        <
+            typename boost::range_value<Range1>::type, Range2
+        >::type strategy_type;
+
+    return geometry::distance_matrix(range1, range2, out, strategy_type(),
+                                     policy);
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_DISTANCE_MATRIX_HPP
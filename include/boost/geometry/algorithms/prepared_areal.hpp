@@ -0,0 +1,552 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_PREPARED_AREAL_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_PREPARED_AREAL_HPP
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <boost/mpl/if.hpp>
+#include <boost/range.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/cs.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/ring_type.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/algorithms/detail/interior_iterator.hpp>
+#include <boost/geometry/algorithms/not_implemented.hpp>
+
+#include <boost/geometry/strategies/agnostic/point_in_poly_winding.hpp>
+
+#include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/select_most_precise.hpp>
+
+#include <boost/geometry/views/detail/normalized_view.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace prepared_areal
+{
+
+// The tolerance of the comparison of the coordinates of the points and
+// the vertices in the winding strategy (math::equals), enlarged. It uses the
+// epsilon of the coordinate type, because the strategy compares the
+// coordinates in this type, not in the calculation type of the bands.
+// Integral coordinates may be compared with floating point coordinates of
+// the points, so the greatest epsilon of these types (of float) is used.
+template <typename CoordinateType>
+struct tolerance
+{
+    typedef typename boost::mpl::if_c
+        <
+            boost::is_floating_point<CoordinateType>::value,
+            CoordinateType,
+            float
+        >::type epsilon_type;
+
+    template <typename T>
+    static inline T apply(T const& value)
+    {
+        return static_cast<T>(std::numeric_limits<epsilon_type>::epsilon())
+             * math::detail::greatest(math::abs(value), T(1))
+             * T(4);
+    }
+};
+
+
+// A ring, normalized to clockwise and closed, with its edges distributed
+// into horizontal bands. Only the edges overlapping the band containing
+// the point are passed to the winding strategy. The other edges don't
+// affect its result because they don't cross the level of the point.
+template <typename Point, typename CalculationType>
+class indexed_ring
+{
+    typedef tolerance<typename coordinate_type<Point>::type> tolerance_type;
+
+public:
+    typedef CalculationType calculation_type;
+
+    template <typename Ring>
+    explicit indexed_ring(Ring const& ring)
+        : m_band_height(0)
+    {
+        if (boost::size(ring) < core_detail::closure::minimum_ring_size
+                                    <
+                                        geometry::closure<Ring>::value
+                                    >::value)
+        {
+            // Degenerate rings don't contain any point
+            return;
+        }
+
+        detail::normalized_view<Ring const> view(ring);
+        m_points.assign(boost::begin(view), boost::end(view));
+
+        if (m_points.size() < 2)
+        {
+            m_points.clear();
+            return;
+        }
+
+        m_min_x = m_max_x = get<0>(m_points.front());
+        m_min_y = m_max_y = get<1>(m_points.front());
+        for (std::size_t i = 1; i < m_points.size(); i++)
+        {
+            calculation_type const x = get<0>(m_points[i]);
+            calculation_type const y = get<1>(m_points[i]);
+            if (x < m_min_x) m_min_x = x;
+            if (x > m_max_x) m_max_x = x;
+            if (y < m_min_y) m_min_y = y;
+            if (y > m_max_y) m_max_y = y;
+        }
+
+        m_min_x -= tolerance_type::apply(m_min_x);
+        m_max_x += tolerance_type::apply(m_max_x);
+        m_min_y -= tolerance_type::apply(m_min_y);
+        m_max_y += tolerance_type::apply(m_max_y);
+
+        create_bands();
+    }
+
+    inline bool empty() const
+    {
+        return m_points.empty();
+    }
+
+    template <typename PointOfQuery>
+    inline bool covers_envelope(PointOfQuery const& point, bool check_x) const
+    {
+        if (m_points.empty())
+        {
+            return false;
+        }
+
+        calculation_type const y = get<1>(point);
+        if (y < m_min_y || y > m_max_y)
+        {
+            return false;
+        }
+        if (check_x)
+        {
+            calculation_type const x = get<0>(point);
+            return x >= m_min_x && x <= m_max_x;
+        }
+        return true;
+    }
+
+    // Returns 1 if the point is inside, 0 if it is on the ring,
+    // -1 if it is outside, like point_in_geometry
+    template <typename PointOfQuery, typename Strategy>
+    inline int apply(PointOfQuery const& point, Strategy const& strategy) const
+    {
+        typename Strategy::state_type state;
+
+        calculation_type const y = get<1>(point);
+        if (! m_points.empty() && y >= m_min_y && y <= m_max_y)
+        {
+            std::size_t const band = band_index(y);
+            for (std::size_t i = m_band_offsets[band];
+                 i < m_band_offsets[band + 1]; i++)
+            {
+                std::size_t const e = m_edges[i];
+                if (! strategy.apply(point, m_points[e], m_points[e + 1], state))
+                {
+                    break;
+                }
+            }
+        }
+
+        return strategy.result(state);
+    }
+
+private:
+    inline std::size_t band_index(calculation_type const& y) const
+    {
+        if (m_band_height <= 0 || y <= m_min_y)
+        {
+            return 0;
+        }
+        std::size_t const max_index = m_band_offsets.size() - 2;
+        calculation_type const index = std::floor((y - m_min_y) / m_band_height);
+        return index >= static_cast<calculation_type>(max_index)
+            ? max_index
+            : static_cast<std::size_t>(index);
+    }
+
+    // Returns the number of the edges stored in all bands
+    inline std::size_t count_edges(std::size_t bands_count)
+    {
+        set_bands_count(bands_count);
+
+        std::size_t result = 0;
+        for (std::size_t e = 0; e + 1 < m_points.size(); e++)
+        {
+            std::size_t first, last;
+            edge_bands(e, first, last);
+            result += last - first + 1;
+        }
+        return result;
+    }
+
+    inline void set_bands_count(std::size_t bands_count)
+    {
+        m_band_offsets.assign(bands_count + 1, 0);
+        m_band_height = (m_max_y - m_min_y) / static_cast<calculation_type>(bands_count);
+    }
+
+    inline void edge_bands(std::size_t e, std::size_t& first, std::size_t& last) const
+    {
+        calculation_type y1 = get<1>(m_points[e]);
+        calculation_type y2 = get<1>(m_points[e + 1]);
+        if (y1 > y2)
+        {
+            std::swap(y1, y2);
+        }
+        first = band_index(y1 - tolerance_type::apply(y1));
+        last = band_index(y2 + tolerance_type::apply(y2));
+    }
+
+    inline void create_bands()
+    {
+        std::size_t const edges_count = m_points.size() - 1;
+
+        // One band per edge, less if edges would be stored in many bands
+        std::size_t bands_count = edges_count;
+        std::size_t stored_count = count_edges(bands_count);
+        while (bands_count > 1 && stored_count > 8 * edges_count)
+        {
+            bands_count /= 2;
+            stored_count = count_edges(bands_count);
+        }
+
+        // Store the edges of the bands contiguously, in the order of the ring
+        for (std::size_t e = 0; e < edges_count; e++)
+        {
+            std::size_t first, last;
+            edge_bands(e, first, last);
+            for (std::size_t b = first; b <= last; b++)
+            {
+                m_band_offsets[b + 1]++;
+            }
+        }
+        for (std::size_t b = 0; b < bands_count; b++)
+        {
+            m_band_offsets[b + 1] += m_band_offsets[b];
+        }
+
+        m_edges.resize(stored_count);
+        std::vector<std::size_t> positions(m_band_offsets.begin(), m_band_offsets.end() - 1);
+        for (std::size_t e = 0; e < edges_count; e++)
+        {
+            std::size_t first, last;
+            edge_bands(e, first, last);
+            for (std::size_t b = first; b <= last; b++)
+            {
+                m_edges[positions[b]++] = e;
+            }
+        }
+    }
+
+    std::vector<Point> m_points;
+    calculation_type m_min_x, m_min_y, m_max_x, m_max_y;
+    calculation_type m_band_height;
+    std::vector<std::size_t> m_band_offsets;
+    std::vector<std::size_t> m_edges;
+};
+
+
+template <typename Point, typename CalculationType>
+class indexed_polygon
+{
+    typedef indexed_ring<Point, CalculationType> ring_type;
+
+public:
+    template <typename Polygon>
+    explicit indexed_polygon(Polygon const& polygon)
+        : m_exterior(exterior_ring(polygon))
+    {
+        typename interior_return_type<Polygon const>::type
+            rings = interior_rings(polygon);
+        for (typename detail::interior_iterator<Polygon const>::type
+             it = boost::begin(rings);
+             it != boost::end(rings);
+             ++it)
+        {
+            m_interiors.push_back(ring_type(*it));
+        }
+    }
+
+    template <typename Ring>
+    indexed_polygon(Ring const& ring, ring_tag)
+        : m_exterior(ring)
+    {}
+
+    // Like point_in_geometry for polygons, the point has to be inside
+    // the exterior ring and outside the interior rings
+    template <typename PointOfQuery, typename Strategy>
+    inline int apply(PointOfQuery const& point, Strategy const& strategy,
+                     bool check_x) const
+    {
+        if (! m_exterior.covers_envelope(point, check_x))
+        {
+            return -1;
+        }
+
+        int const code = m_exterior.apply(point, strategy);
+
+        if (code == 1)
+        {
+            for (typename std::vector<ring_type>::const_iterator
+                 it = m_interiors.begin(); it != m_interiors.end(); ++it)
+            {
+                if (! it->covers_envelope(point, check_x))
+                {
+                    continue;
+                }
+
+                int const interior_code = it->apply(point, strategy);
+
+                if (interior_code != -1)
+                {
+                    // If 0, return 0 (touch)
+                    // If 1 (inside hole) return -1 (outside polygon)
+                    return -interior_code;
+                }
+            }
+        }
+        return code;
+    }
+
+private:
+    ring_type m_exterior;
+    std::vector<ring_type> m_interiors;
+};
+
+
+template <typename Geometry, typename Tag = typename tag<Geometry>::type>
+struct fill_polygons
+    : not_implemented<Tag>
+{};
+
+template <typename Ring>
+struct fill_polygons<Ring, ring_tag>
+{
+    template <typename Polygons>
+    static inline void apply(Ring const& ring, Polygons& polygons)
+    {
+        typedef typename boost::range_value<Polygons>::type indexed_type;
+        polygons.push_back(indexed_type(ring, ring_tag()));
+    }
+};
+
+template <typename Polygon>
+struct fill_polygons<Polygon, polygon_tag>
+{
+    template <typename Polygons>
+    static inline void apply(Polygon const& polygon, Polygons& polygons)
+    {
+        typedef typename boost::range_value<Polygons>::type indexed_type;
+        polygons.push_back(indexed_type(polygon));
+    }
+};
+
+template <typename MultiPolygon>
+struct fill_polygons<MultiPolygon, multi_polygon_tag>
+{
+    template <typename Polygons>
+    static inline void apply(MultiPolygon const& multi_polygon, Polygons& polygons)
+    {
+        typedef typename boost::range_value<Polygons>::type indexed_type;
+        polygons.reserve(boost::size(multi_polygon));
+        for (typename boost::range_iterator<MultiPolygon const>::type
+             it = boost::begin(multi_polygon);
+             it != boost::end(multi_polygon);
+             ++it)
+        {
+            polygons.push_back(indexed_type(*it));
+        }
+    }
+};
+
+
+}} // namespace detail::prepared_areal
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Areal geometry (ring, polygon or multi-polygon) prepared for
+    repeated point-in-polygon tests
+\ingroup within
+\details The points of the rings are copied and their edges are distributed
+    into horizontal bands, so a point is compared only with the edges
+    overlapping its band instead of all edges. It is passed instead of the
+    areal geometry to within, covered_by, intersects and disjoint with a point.
+    The results are the same as the results of these algorithms called for
+    the areal geometry with the default (winding) strategy.
+\tparam Geometry \tparam_geometry, ring, polygon or multi-polygon
+\note Create it once for a geometry which is tested against many points.
+*/
+template <typename Geometry>
+class prepared_areal
+{
+public:
+    typedef typename geometry::point_type<Geometry>::type point_type;
+    typedef typename select_most_precise
+        <
+            typename coordinate_type<point_type>::type,
+            double
+        >::type calculation_type;
+
+    /*!
+    \brief The constructor, copies the rings of the geometry and creates
+        their bands of edges
+    \param geometry \param_geometry
+    */
+    explicit prepared_areal(Geometry const& geometry)
+    {
+        concept::check<Geometry const>();
+
+        detail::prepared_areal::fill_polygons<Geometry>::apply(geometry, m_polygons);
+    }
+
+    /*!
+    \brief Returns 1 if the point is in the interior, 0 if it is on the boundary
+        and -1 if it is in the exterior of the geometry
+    */
+    template <typename Point>
+    inline int relate_point(Point const& point) const
+    {
+        concept::check<Point const>();
+
+        typedef strategy::within::winding<Point, point_type> strategy_type;
+        strategy_type strategy;
+
+        // The longitudes of the points don't have to be between the
+        // longitudes of the vertices in spherical coordinate systems
+        bool const check_x = boost::is_same
+            <
+                typename cs_tag<point_type>::type,
+                cartesian_tag
+            >::value;
+
+        for (typename polygons_type::const_iterator it = m_polygons.begin();
+             it != m_polygons.end(); ++it)
+        {
+            int const code = it->apply(point, strategy, check_x);
+
+            // inside or on the boundary
+            if (code >= 0)
+            {
+                return code;
+            }
+        }
+        return -1;
+    }
+
+private:
+    typedef detail::prepared_areal::indexed_polygon
+        <
+            point_type, calculation_type
+        > indexed_polygon_type;
+    typedef std::vector<indexed_polygon_type> polygons_type;
+
+    polygons_type m_polygons;
+};
+
+
+/*!
+\brief \brief_check12{is completely inside}, for a prepared areal geometry
+\ingroup within
+\tparam Point \tparam_point
+\tparam Geometry \tparam_geometry
+\param point \param_point
+\param prepared The prepared areal geometry
+\return true if the point is in the interior of the geometry
+
+\qbk{distinguish,prepared}
+*/
+template <typename Point, typename Geometry>
+inline bool within(Point const& point, prepared_areal<Geometry> const& prepared)
+{
+    return prepared.relate_point(point) == 1;
+}
+
+/*!
+\brief \brief_check12{is inside or on border}, for a prepared areal geometry
+\ingroup covered_by
+\tparam Point \tparam_point
+\tparam Geometry \tparam_geometry
+\param point \param_point
+\param prepared The prepared areal geometry
+\return true if the point is in the interior or on the boundary of the geometry
+
+\qbk{distinguish,prepared}
+*/
+template <typename Point, typename Geometry>
+inline bool covered_by(Point const& point, prepared_areal<Geometry> const& prepared)
+{
+    return prepared.relate_point(point) >= 0;
+}
+
+/*!
+\brief \brief_check2{have at least one intersection}, for a prepared areal geometry
+\ingroup intersects
+\tparam Point \tparam_point
+\tparam Geometry \tparam_geometry
+\param point \param_point
+\param prepared The prepared areal geometry
+\return \return_check2{intersect each other}
+
+\qbk{distinguish,prepared}
+*/
+template <typename Point, typename Geometry>
+inline bool intersects(Point const& point, prepared_areal<Geometry> const& prepared)
+{
+    return prepared.relate_point(point) >= 0;
+}
+
+/*!
+\brief \brief_check2{are disjoint}, for a prepared areal geometry
+\ingroup disjoint
+\tparam Point \tparam_point
+\tparam Geometry \tparam_geometry
+\param point \param_point
+\param prepared The prepared areal geometry
+\return \return_check2{are disjoint}
+
+\qbk{distinguish,prepared}
+*/
+template <typename Point, typename Geometry>
+inline bool disjoint(Point const& point, prepared_areal<Geometry> const& prepared)
+{
+    return prepared.relate_point(point) < 0;
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_PREPARED_AREAL_HPP
@@ -0,0 +1,433 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_PREPARED_DISTANCE_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_PREPARED_DISTANCE_HPP
+
+
+#include <iterator>
+#include <utility>
+
+#include <boost/mpl/assert.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/range.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tag_cast.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/strategies/default_strategy.hpp>
+#include <boost/geometry/strategies/distance.hpp>
+#include <boost/geometry/strategies/distance_result.hpp>
+#include <boost/geometry/strategies/default_distance_result.hpp>
+#include <boost/geometry/strategies/default_comparable_distance_result.hpp>
+#include <boost/geometry/strategies/comparable_distance_result.hpp>
+
+#include <boost/geometry/algorithms/comparable_distance.hpp>
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/algorithms/prepared_sections.hpp>
+#include <boost/geometry/algorithms/detail/closest_feature/range_to_range.hpp>
+#include <boost/geometry/algorithms/detail/distance/default_strategies.hpp>
+#include <boost/geometry/algorithms/detail/distance/is_comparable.hpp>
+#include <boost/geometry/algorithms/detail/distance/iterator_selector.hpp>
+#include <boost/geometry/algorithms/detail/throw_on_empty_input.hpp>
+#include <boost/geometry/algorithms/dispatch/distance.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+/*!
+\brief Linear or areal geometry with an rtree of its segments, to be used
+    in many calls of distance and comparable_distance
+\ingroup distance
+\details The rtree of the segments (and the sections, used to check if an
+    areal geometry intersects the other geometry) is created once and is
+    reused by all the calculations. The distance to a geometry of which the
+    parts are close to each other (e.g. the segments of a linestring) is
+    calculated in blocks, the blocks which can't be closer than the
+    distance found so far are not considered.
+\tparam Geometry \tparam_geometry, linear or areal
+\note The prepared geometry keeps a reference to the geometry, which may
+    not be changed or destroyed while the prepared geometry is used.
+
+\qbk{[heading See also]}
+\qbk{* [link geometry.reference.algorithms.distance distance]}
+*/
+template <typename Geometry>
+class prepared_distance
+{
+    BOOST_MPL_ASSERT_MSG
+        (
+            (boost::mpl::or_
+                <
+                    boost::is_base_of<linear_tag, typename tag<Geometry>::type>,
+                    boost::is_base_of<areal_tag, typename tag<Geometry>::type>
+                >::value),
+            NOT_IMPLEMENTED_FOR_THIS_GEOMETRY_TYPE,
+            (types<Geometry>)
+        );
+
+    typedef detail::distance::iterator_selector<Geometry const> selector_type;
+
+public :
+
+    typedef Geometry geometry_type;
+
+#ifndef DOXYGEN_NO_DETAIL
+    typedef typename std::iterator_traits
+        <
+            typename selector_type::iterator_type
+        >::value_type segment_type;
+
+    // The same rtree as the one created by distance
+    typedef index::rtree<segment_type, index::linear<8> > rtree_type;
+#endif
+
+    explicit prepared_distance(Geometry const& geometry)
+        : m_geometry(geometry)
+        , m_rtree(selector_type::begin(geometry), selector_type::end(geometry))
+        , m_sections(geometry)
+    {
+        concept::check<Geometry const>();
+    }
+
+    inline Geometry const& geometry() const
+    {
+        return m_geometry;
+    }
+
+#ifndef DOXYGEN_NO_DETAIL
+    inline rtree_type const& rtree() const
+    {
+        return m_rtree;
+    }
+
+    inline prepared_sections<Geometry> const& sections() const
+    {
+        return m_sections;
+    }
+#endif
+
+private :
+    Geometry const& m_geometry;
+    rtree_type m_rtree;
+    prepared_sections<Geometry> m_sections;
+};
+
+
+namespace resolve_variant
+{
+
+// The prepared geometry is not a geometry, the result types are not defined,
+// so the overloads of distance and comparable_distance taking any geometry
+// are not considered
+template <typename Geometry1, typename Geometry2, typename Strategy>
+struct distance_result
+    <
+        geometry::prepared_distance<Geometry1>, Geometry2, Strategy
+    >
+{};
+
+template <typename Geometry1, typename Geometry2, typename Strategy>
+struct comparable_distance_result
+    <
+        geometry::prepared_distance<Geometry1>, Geometry2, Strategy
+    >
+{};
+
+} // namespace resolve_variant
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace prepared_distance
+{
+
+
+// The objects of the other geometry of which the distances to the segments
+// of the prepared geometry are calculated: the point, the points of a
+// multi-point or the segments of a linear or areal geometry
+template <typename Geometry, typename Tag = typename tag<Geometry>::type>
+struct query_range
+{
+    typedef detail::distance::iterator_selector<Geometry const> selector_type;
+    typedef typename selector_type::iterator_type iterator_type;
+
+    static inline iterator_type begin(Geometry const& geometry)
+    {
+        return selector_type::begin(geometry);
+    }
+
+    static inline iterator_type end(Geometry const& geometry)
+    {
+        return selector_type::end(geometry);
+    }
+};
+
+template <typename Point>
+struct query_range<Point, point_tag>
+{
+    typedef Point const* iterator_type;
+
+    static inline iterator_type begin(Point const& point)
+    {
+        return &point;
+    }
+
+    static inline iterator_type end(Point const& point)
+    {
+        return &point + 1;
+    }
+};
+
+
+// Checks if the other geometry intersects the areal prepared geometry, or
+// if the other areal geometry intersects the prepared geometry
+template <typename Geometry, typename Tag = typename tag<Geometry>::type>
+struct intersects
+{
+    template <typename Prepared>
+    static inline bool apply(Prepared const& prepared, Geometry const& geometry)
+    {
+        return geometry::intersects(prepared.sections(), geometry);
+    }
+};
+
+template <typename MultiPoint>
+struct intersects<MultiPoint, multi_point_tag>
+{
+    template <typename Prepared>
+    static inline bool apply(Prepared const& prepared,
+                             MultiPoint const& multi_point)
+    {
+        for (typename boost::range_iterator<MultiPoint const>::type
+                it = boost::begin(multi_point);
+             it != boost::end(multi_point);
+             ++it)
+        {
+            if (geometry::intersects(prepared.sections(), *it))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+
+template <typename Geometry1, typename Geometry2, typename Strategy>
+struct distance
+{
+    typedef typename strategy::distance::services::return_type
+        <
+            Strategy,
+            typename point_type<Geometry1>::type,
+            typename point_type<Geometry2>::type
+        >::type return_type;
+
+    typedef typename geometry::prepared_distance
+        <
+            Geometry1
+        >::segment_type segment_type;
+
+    typedef query_range<Geometry2> query_range_type;
+    typedef typename query_range_type::iterator_type query_iterator;
+
+    static const bool is_areal = boost::is_same
+        <
+            typename tag_cast<typename tag<Geometry1>::type, areal_tag>::type,
+            areal_tag
+        >::value
+        || boost::is_same
+        <
+            typename tag_cast<typename tag<Geometry2>::type, areal_tag>::type,
+            areal_tag
+        >::value;
+
+    static inline return_type apply(
+            geometry::prepared_distance<Geometry1> const& prepared,
+            Geometry2 const& geometry2,
+            Strategy const& strategy)
+    {
+        namespace sds = strategy::distance::services;
+
+        Geometry1 const& geometry1 = prepared.geometry();
+
+        query_iterator const first = query_range_type::begin(geometry2);
+        query_iterator const last = query_range_type::end(geometry2);
+
+        if (prepared.rtree().empty() || first == last)
+        {
+            // A geometry with one point, or a degenerated one
+            return dispatch::distance
+                <
+                    Geometry1, Geometry2, Strategy
+                >::apply(geometry1, geometry2, strategy);
+        }
+
+        if (is_areal && intersects<Geometry2>::apply(prepared, geometry2))
+        {
+            return return_type(0);
+        }
+
+        typename sds::return_type
+            <
+                typename sds::comparable_type<Strategy>::type,
+                typename point_type<Geometry1>::type,
+                typename point_type<Geometry2>::type
+            >::type cd_min;
+
+        std::pair<segment_type, query_iterator> closest_features
+            = detail::closest_feature::range_to_range_rtree::apply(
+                    prepared.rtree(), first, last,
+                    sds::get_comparable<Strategy>::apply(strategy),
+                    cd_min);
+
+        return
+            detail::distance::is_comparable<Strategy>::value
+            ?
+            cd_min
+            :
+            dispatch::distance
+                <
+                    segment_type,
+                    typename std::iterator_traits<query_iterator>::value_type,
+                    Strategy
+                >::apply(closest_features.first,
+                         *closest_features.second,
+                         strategy);
+    }
+};
+
+
+}} // namespace detail::prepared_distance
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief \brief_calc2{distance}, using the rtree of the segments of the
+    first geometry
+\ingroup distance
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Strategy \tparam_strategy{Distance}
+\param prepared The first geometry, with an rtree of its segments
+\param geometry2 \param_geometry
+\param strategy \param_strategy{distance}
+\return \return_calc{distance}
+
+\qbk{distinguish,prepared distance with strategy}
+*/
+template <typename Geometry1, typename Geometry2, typename Strategy>
+inline typename distance_result<Geometry1, Geometry2, Strategy>::type
+distance(prepared_distance<Geometry1> const& prepared,
+         Geometry2 const& geometry2,
+         Strategy const& strategy)
+{
+    concept::check<Geometry1 const>();
+    concept::check<Geometry2 const>();
+
+    detail::throw_on_empty_input(prepared.geometry());
+    detail::throw_on_empty_input(geometry2);
+
+    return detail::prepared_distance::distance
+        <
+            Geometry1, Geometry2, Strategy
+        >::apply(prepared, geometry2, strategy);
+}
+
+/*!
+\brief \brief_calc2{distance}, using the rtree of the segments of the
+    first geometry
+\ingroup distance
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\param prepared The first geometry, with an rtree of its segments
+\param geometry2 \param_geometry
+\return \return_calc{distance}
+
+\qbk{distinguish,prepared distance}
+*/
+template <typename Geometry1, typename Geometry2>
+inline typename default_distance_result<Geometry1, Geometry2>::type
+distance(prepared_distance<Geometry1> const& prepared,
+         Geometry2 const& geometry2)
+{
+    typedef typename detail::distance::default_strategy
+        <
+            Geometry1, Geometry2
+        >::type strategy_type;
+
+    return geometry::distance(prepared, geometry2, strategy_type());
+}
+
+/*!
+\brief \brief_calc2{comparable distance measurement}, using the rtree of
+    the segments of the first geometry
+\ingroup distance
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Strategy \tparam_strategy{Distance}
+\param prepared The first geometry, with an rtree of its segments
+\param geometry2 \param_geometry
+\param strategy \param_strategy{distance}
+\return \return_calc{comparable distance}
+
+\qbk{distinguish,prepared distance with strategy}
+*/
+template <typename Geometry1, typename Geometry2, typename Strategy>
+inline typename comparable_distance_result<Geometry1, Geometry2, Strategy>::type
+comparable_distance(prepared_distance<Geometry1> const& prepared,
+                    Geometry2 const& geometry2,
+                    Strategy const& strategy)
+{
+    return geometry::distance(prepared, geometry2,
+        strategy::distance::services::get_comparable
+            <
+                Strategy
+            >::apply(strategy));
+}
+
+/*!
+\brief \brief_calc2{comparable distance measurement}, using the rtree of
+    the segments of the first geometry
+\ingroup distance
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\param prepared The first geometry, with an rtree of its segments
+\param geometry2 \param_geometry
+\return \return_calc{comparable distance}
+
+\qbk{distinguish,prepared distance}
+*/
+template <typename Geometry1, typename Geometry2>
+inline typename default_comparable_distance_result<Geometry1, Geometry2>::type
+comparable_distance(prepared_distance<Geometry1> const& prepared,
+                    Geometry2 const& geometry2)
+{
+    typedef typename detail::distance::default_strategy
+        <
+            Geometry1, Geometry2
+        >::type strategy_type;
+
+    return geometry::comparable_distance(prepared, geometry2, strategy_type());
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_PREPARED_DISTANCE_HPP
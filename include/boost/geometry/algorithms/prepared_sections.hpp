@@ -0,0 +1,769 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_PREPARED_SECTIONS_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_PREPARED_SECTIONS_HPP
+
+
+#include <cstddef>
+#include <deque>
+
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/point_order.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/reverse_dispatch.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/algorithms/detail/disjoint/areal_areal.hpp>
+#include <boost/geometry/algorithms/detail/disjoint/linear_areal.hpp>
+#include <boost/geometry/algorithms/detail/disjoint/linear_linear.hpp>
+#include <boost/geometry/algorithms/detail/intersection/interface.hpp>
+#include <boost/geometry/algorithms/detail/overlay/do_reverse.hpp>
+#include <boost/geometry/algorithms/detail/overlay/get_turns.hpp>
+#include <boost/geometry/algorithms/detail/overlay/overlay.hpp>
+#include <boost/geometry/algorithms/detail/overlay/turn_info.hpp>
+#include <boost/geometry/algorithms/detail/sections/sectionalize.hpp>
+#include <boost/geometry/algorithms/disjoint.hpp>
+
+#include <boost/geometry/policies/disjoint_interrupt_policy.hpp>
+#include <boost/geometry/policies/robustness/get_rescale_policy.hpp>
+#include <boost/geometry/policies/robustness/no_rescale_policy.hpp>
+#include <boost/geometry/policies/robustness/rescale_policy.hpp>
+#include <boost/geometry/policies/robustness/robust_point_type.hpp>
+#include <boost/geometry/policies/robustness/segment_ratio_type.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace prepared_sections
+{
+
+template
+<
+    typename Point,
+    std::size_t Dimension = 0,
+    std::size_t DimensionCount = geometry::dimension<Point>::value
+>
+struct points_equal_exactly
+{
+    static inline bool apply(Point const& p1, Point const& p2)
+    {
+        return geometry::get<Dimension>(p1) == geometry::get<Dimension>(p2)
+            && points_equal_exactly
+                <
+                    Point, Dimension + 1, DimensionCount
+                >::apply(p1, p2);
+    }
+};
+
+template <typename Point, std::size_t DimensionCount>
+struct points_equal_exactly<Point, DimensionCount, DimensionCount>
+{
+    static inline bool apply(Point const& , Point const& )
+    {
+        return true;
+    }
+};
+
+// The sections can only be reused if the geometries are rescaled in
+// exactly the same way
+inline bool same_robust_policy(no_rescale_policy const& ,
+                               no_rescale_policy const& )
+{
+    return true;
+}
+
+template <typename FpPoint, typename IntPoint, typename CalculationType>
+inline bool same_robust_policy(
+        robust_policy<FpPoint, IntPoint, CalculationType> const& policy1,
+        robust_policy<FpPoint, IntPoint, CalculationType> const& policy2)
+{
+    return policy1.m_multiplier == policy2.m_multiplier
+        && points_equal_exactly<FpPoint>::apply(policy1.m_fp_min,
+                                                policy2.m_fp_min)
+        && points_equal_exactly<IntPoint>::apply(policy1.m_int_min,
+                                                 policy2.m_int_min);
+}
+
+
+// The sections of a geometry, created as get_turns_generic creates them
+template <typename Geometry, typename RobustPolicy>
+struct cached_sections
+{
+    static const bool reverse = overlay::do_reverse
+        <
+            geometry::point_order<Geometry>::value
+        >::value;
+
+    typedef model::box
+        <
+            typename geometry::robust_point_type
+                <
+                    typename geometry::point_type<Geometry>::type,
+                    RobustPolicy
+                >::type
+        > box_type;
+    typedef geometry::sections<box_type, 2> sections_type;
+
+    cached_sections(Geometry const& geometry,
+                    RobustPolicy const& robust_policy)
+        : m_robust_policy(robust_policy)
+    {
+        geometry::sectionalize
+            <
+                reverse, detail::get_turns::sections_dimensions
+            >(geometry, robust_policy, m_sections, 0);
+    }
+
+    template <typename Sections, typename OtherRobustPolicy>
+    inline Sections const* get(OtherRobustPolicy const& robust_policy) const
+    {
+        return get<Sections>(robust_policy,
+            boost::mpl::bool_
+                <
+                    boost::is_same<Sections, sections_type>::value
+                    && boost::is_same<OtherRobustPolicy, RobustPolicy>::value
+                >());
+    }
+
+private :
+    template <typename Sections, typename OtherRobustPolicy>
+    inline Sections const* get(OtherRobustPolicy const& ,
+                               boost::mpl::false_) const
+    {
+        return 0;
+    }
+
+    template <typename Sections>
+    inline Sections const* get(RobustPolicy const& robust_policy,
+                               boost::mpl::true_) const
+    {
+        return same_robust_policy(m_robust_policy, robust_policy)
+            ? &m_sections : 0;
+    }
+
+    RobustPolicy m_robust_policy;
+    sections_type m_sections;
+};
+
+// The sections with the rescale policy used by the overlay of the geometry
+// with itself, if it is rescaled
+template
+<
+    typename Geometry,
+    typename RobustPolicy = typename geometry::rescale_overlay_policy_type
+        <
+            Geometry, Geometry
+        >::type
+>
+struct rescaled_sections : cached_sections<Geometry, RobustPolicy>
+{
+    explicit rescaled_sections(Geometry const& geometry)
+        : cached_sections<Geometry, RobustPolicy>(geometry,
+            geometry::get_rescale_policy<RobustPolicy>(geometry))
+    {}
+};
+
+template <typename Geometry>
+struct rescaled_sections<Geometry, no_rescale_policy>
+{
+    explicit rescaled_sections(Geometry const& )
+    {}
+
+    template <typename Sections, typename RobustPolicy>
+    inline Sections const* get(RobustPolicy const& ) const
+    {
+        return 0;
+    }
+};
+
+
+// Calculates the turns as get_turns_generic does, but only sectionalizes
+// the geometries of which the sections are not cached
+template
+<
+    typename GeometryTag1, typename GeometryTag2,
+    typename Geometry1, typename Geometry2,
+    bool Reverse1, bool Reverse2,
+    typename TurnPolicy,
+    bool IsGeneric = boost::is_base_of
+        <
+            detail::get_turns::get_turns_generic
+                <
+                    Geometry1, Geometry2, Reverse1, Reverse2, TurnPolicy
+                >,
+            dispatch::get_turns
+                <
+                    GeometryTag1, GeometryTag2,
+                    Geometry1, Geometry2,
+                    Reverse1, Reverse2,
+                    TurnPolicy
+                >
+        >::value
+>
+struct get_turns
+{
+    template
+    <
+        typename RobustPolicy, typename Turns, typename InterruptPolicy,
+        typename Prepared
+    >
+    static inline void apply(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            Prepared const& )
+    {
+        dispatch::get_turns
+            <
+                GeometryTag1, GeometryTag2,
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy
+            >::apply(source_id1, geometry1, source_id2, geometry2,
+                     robust_policy, turns, interrupt_policy);
+    }
+};
+
+template
+<
+    typename GeometryTag1, typename GeometryTag2,
+    typename Geometry1, typename Geometry2,
+    bool Reverse1, bool Reverse2,
+    typename TurnPolicy
+>
+struct get_turns
+    <
+        GeometryTag1, GeometryTag2,
+        Geometry1, Geometry2,
+        Reverse1, Reverse2,
+        TurnPolicy,
+        true
+    >
+{
+    template
+    <
+        typename RobustPolicy, typename Turns, typename InterruptPolicy,
+        typename Prepared
+    >
+    static inline void apply(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            Prepared const& prepared)
+    {
+        typedef detail::get_turns::get_turns_generic
+            <
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy
+            > generic_type;
+        typedef typename generic_type::template sections_traits
+            <
+                RobustPolicy, Turns
+            >::type sections_type;
+
+        sections_type const* sec1 = prepared.template cached_sections
+            <
+                sections_type, Reverse1
+            >(geometry1, robust_policy);
+        sections_type const* sec2 = prepared.template cached_sections
+            <
+                sections_type, Reverse2
+            >(geometry2, robust_policy);
+
+        if (sec1 == 0 && sec2 == 0)
+        {
+            generic_type::apply(source_id1, geometry1, source_id2, geometry2,
+                                robust_policy, turns, interrupt_policy);
+            return;
+        }
+
+        sections_type own1, own2;
+        if (sec1 == 0)
+        {
+            geometry::sectionalize
+                <
+                    Reverse1, detail::get_turns::sections_dimensions
+                >(geometry1, robust_policy, own1, 0);
+            sec1 = &own1;
+        }
+        if (sec2 == 0)
+        {
+            geometry::sectionalize
+                <
+                    Reverse2, detail::get_turns::sections_dimensions
+                >(geometry2, robust_policy, own2, 1);
+            sec2 = &own2;
+        }
+
+        generic_type::apply(source_id1, geometry1, source_id2, geometry2,
+                            robust_policy, turns, interrupt_policy,
+                            *sec1, *sec2);
+    }
+};
+
+template
+<
+    typename GeometryTag1, typename GeometryTag2,
+    typename Geometry1, typename Geometry2,
+    bool Reverse1, bool Reverse2,
+    typename TurnPolicy
+>
+struct get_turns_reversed
+{
+    template
+    <
+        typename RobustPolicy, typename Turns, typename InterruptPolicy,
+        typename Prepared
+    >
+    static inline void apply(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            Prepared const& prepared)
+    {
+        get_turns
+            <
+                GeometryTag2, GeometryTag1,
+                Geometry2, Geometry1,
+                Reverse2, Reverse1,
+                TurnPolicy
+            >::apply(source_id2, geometry2, source_id1, geometry1,
+                     robust_policy, turns, interrupt_policy, prepared);
+    }
+};
+
+
+// As detail::disjoint::disjoint_linear, using the cached sections
+template <typename Geometry1, typename Geometry2, typename Prepared>
+inline bool disjoint_linear(Geometry1 const& geometry1,
+                            Geometry2 const& geometry2,
+                            Prepared const& prepared)
+{
+    typedef typename geometry::point_type<Geometry1>::type point_type;
+    typedef detail::no_rescale_policy rescale_policy_type;
+    typedef typename geometry::segment_ratio_type
+        <
+            point_type, rescale_policy_type
+        >::type segment_ratio_type;
+    typedef overlay::turn_info
+        <
+            point_type,
+            segment_ratio_type,
+            typename detail::get_turns::turn_operation_type
+                    <
+                        Geometry1, Geometry2, segment_ratio_type
+                    >::type
+        > turn_info_type;
+
+    std::deque<turn_info_type> turns;
+
+    detail::disjoint::disjoint_interrupt_policy interrupt_policy;
+    get_turns
+        <
+            typename geometry::tag<Geometry1>::type,
+            typename geometry::tag<Geometry2>::type,
+            Geometry1,
+            Geometry2,
+            overlay::do_reverse<geometry::point_order<Geometry1>::value>::value,
+            overlay::do_reverse<geometry::point_order<Geometry2>::value>::value,
+            detail::get_turns::get_turn_info_type
+                <
+                    Geometry1, Geometry2,
+                    detail::disjoint::assign_disjoint_policy
+                >
+        >::apply(0, geometry1, 1, geometry2,
+                 rescale_policy_type(), turns, interrupt_policy, prepared);
+
+    return ! interrupt_policy.has_intersections;
+}
+
+
+// The geometries for which disjoint uses get_turns (other geometries are
+// handled by the normal disjoint)
+template <typename Geometry, typename Tag = typename tag<Geometry>::type>
+struct category
+{
+    typedef void type;
+};
+
+template <typename Geometry>
+struct category<Geometry, linestring_tag> { typedef linear_tag type; };
+
+template <typename Geometry>
+struct category<Geometry, multi_linestring_tag> { typedef linear_tag type; };
+
+template <typename Geometry>
+struct category<Geometry, ring_tag> { typedef areal_tag type; };
+
+template <typename Geometry>
+struct category<Geometry, polygon_tag> { typedef areal_tag type; };
+
+template <typename Geometry>
+struct category<Geometry, multi_polygon_tag> { typedef areal_tag type; };
+
+
+template
+<
+    typename Geometry1, typename Geometry2,
+    typename Category1 = typename category<Geometry1>::type,
+    typename Category2 = typename category<Geometry2>::type
+>
+struct disjoint
+{
+    template <typename Prepared>
+    static inline bool apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             Prepared const& )
+    {
+        return geometry::disjoint(geometry1, geometry2);
+    }
+};
+
+template <typename Geometry1, typename Geometry2>
+struct disjoint<Geometry1, Geometry2, linear_tag, linear_tag>
+{
+    template <typename Prepared>
+    static inline bool apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             Prepared const& prepared)
+    {
+        return disjoint_linear(geometry1, geometry2, prepared);
+    }
+};
+
+template <typename Geometry1, typename Geometry2>
+struct disjoint<Geometry1, Geometry2, linear_tag, areal_tag>
+{
+    template <typename Prepared>
+    static inline bool apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             Prepared const& prepared)
+    {
+        return disjoint_linear(geometry1, geometry2, prepared)
+            && detail::disjoint::disjoint_no_intersections_policy
+                <
+                    Geometry1, Geometry2
+                >::apply(geometry1, geometry2);
+    }
+};
+
+template <typename Geometry1, typename Geometry2>
+struct disjoint<Geometry1, Geometry2, areal_tag, linear_tag>
+{
+    template <typename Prepared>
+    static inline bool apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             Prepared const& prepared)
+    {
+        return disjoint<Geometry2, Geometry1>::apply(geometry2, geometry1,
+                                                     prepared);
+    }
+};
+
+template <typename Geometry1, typename Geometry2>
+struct disjoint<Geometry1, Geometry2, areal_tag, areal_tag>
+{
+    template <typename Prepared>
+    static inline bool apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             Prepared const& prepared)
+    {
+        if (! disjoint_linear(geometry1, geometry2, prepared))
+        {
+            return false;
+        }
+
+        // If there is no intersection of segments, they might be located
+        // inside each other
+        return ! detail::disjoint::rings_containing(geometry1, geometry2)
+            && ! detail::disjoint::rings_containing(geometry2, geometry1);
+    }
+};
+
+
+}} // namespace detail::prepared_sections
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Geometry with cached sections, to be used in many calls of intersection,
+    intersects or disjoint with other geometries
+\ingroup sectionalize
+\details The sections of the geometry, which are created by these algorithms
+    for each call, are created once. In the calls only the sections of the
+    other geometry are created. The sections for intersection can be reused
+    if the other geometry lies within the envelope of the prepared geometry
+    (otherwise the rescaling differs). The results are the same as the results
+    of the algorithms called for the geometry itself.
+\tparam Geometry \tparam_geometry
+\note The geometry is referred to, and should not be changed or destroyed as
+    long as the prepared geometry is used
+*/
+template <typename Geometry>
+class prepared_sections
+{
+    typedef detail::prepared_sections::cached_sections
+        <
+            Geometry, detail::no_rescale_policy
+        > sections_type;
+
+public :
+    typedef Geometry geometry_type;
+
+    explicit prepared_sections(Geometry const& geometry)
+        : m_geometry(geometry)
+        , m_sections(geometry, detail::no_rescale_policy())
+        , m_rescaled_sections(geometry)
+    {
+        concept::check<Geometry const>();
+    }
+
+    inline Geometry const& geometry() const
+    {
+        return m_geometry;
+    }
+
+#ifndef DOXYGEN_NO_DETAIL
+    // Returns the cached sections if the geometry is the prepared geometry
+    // and they were created as the sections requested, otherwise 0
+    template <typename Sections, bool Reverse, typename OtherGeometry, typename RobustPolicy>
+    inline Sections const* cached_sections(OtherGeometry const& geometry,
+                RobustPolicy const& robust_policy) const
+    {
+        return cached_sections<Sections>(geometry, robust_policy,
+            boost::mpl::bool_
+                <
+                    boost::is_same<OtherGeometry, Geometry>::value
+                    && Reverse == sections_type::reverse
+                >());
+    }
+#endif
+
+private :
+    template <typename Sections, typename OtherGeometry, typename RobustPolicy>
+    inline Sections const* cached_sections(OtherGeometry const& ,
+                RobustPolicy const& , boost::mpl::false_) const
+    {
+        return 0;
+    }
+
+    template <typename Sections, typename RobustPolicy>
+    inline Sections const* cached_sections(Geometry const& geometry,
+                RobustPolicy const& robust_policy, boost::mpl::true_) const
+    {
+        if (&geometry != &m_geometry)
+        {
+            return 0;
+        }
+
+        Sections const* result
+            = m_sections.template get<Sections>(robust_policy);
+        return result != 0 ? result
+            : m_rescaled_sections.template get<Sections>(robust_policy);
+    }
+
+    Geometry const& m_geometry;
+    sections_type m_sections;
+    detail::prepared_sections::rescaled_sections<Geometry> m_rescaled_sections;
+};
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace overlay
+{
+
+// Overlay strategy, wrapping another one, which makes overlay reuse the
+// cached sections of a prepared geometry to calculate the turns
+template <typename Strategy, typename Prepared>
+struct prepared_strategy : Strategy
+{
+    explicit prepared_strategy(Prepared const& prepared)
+        : prepared(prepared)
+    {}
+
+    Prepared const& prepared;
+};
+
+template
+<
+    bool Reverse1, bool Reverse2,
+    typename Geometry1, typename Geometry2,
+    typename RobustPolicy, typename Turns,
+    typename Strategy, typename Prepared
+>
+inline void overlay_get_turns(Geometry1 const& geometry1, Geometry2 const& geometry2,
+            RobustPolicy const& robust_policy, Turns& turns,
+            prepared_strategy<Strategy, Prepared> const& strategy)
+{
+    typedef detail::overlay::get_turn_info
+        <
+            detail::overlay::assign_null_policy
+        > turn_policy;
+
+    detail::get_turns::no_interrupt_policy policy;
+    boost::mpl::if_c
+        <
+            geometry::reverse_dispatch<Geometry1, Geometry2>::type::value,
+            detail::prepared_sections::get_turns_reversed
+            <
+                typename tag<Geometry1>::type,
+                typename tag<Geometry2>::type,
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                turn_policy
+            >,
+            detail::prepared_sections::get_turns
+            <
+                typename tag<Geometry1>::type,
+                typename tag<Geometry2>::type,
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                turn_policy
+            >
+        >::type::apply(
+            0, geometry1,
+            1, geometry2,
+            robust_policy,
+            turns, policy,
+            strategy.prepared);
+}
+
+}} // namespace detail::overlay
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief \brief_check2{are disjoint}, using the cached sections of the first geometry
+\ingroup disjoint
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\param prepared The first geometry, with cached sections
+\param geometry2 \param_geometry
+\return \return_check2{are disjoint}
+
+\qbk{distinguish,prepared sections}
+*/
+template <typename Geometry1, typename Geometry2>
+inline bool disjoint(prepared_sections<Geometry1> const& prepared,
+                     Geometry2 const& geometry2)
+{
+    concept::check_concepts_and_equal_dimensions
+        <
+            Geometry1 const,
+            Geometry2 const
+        >();
+
+    return detail::prepared_sections::disjoint
+        <
+            Geometry1, Geometry2
+        >::apply(prepared.geometry(), geometry2, prepared);
+}
+
+/*!
+\brief \brief_check2{have at least one intersection}, using the cached sections
+    of the first geometry
+\ingroup intersects
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\param prepared The first geometry, with cached sections
+\param geometry2 \param_geometry
+\return \return_check2{intersect each other}
+
+\qbk{distinguish,prepared sections}
+*/
+template <typename Geometry1, typename Geometry2>
+inline bool intersects(prepared_sections<Geometry1> const& prepared,
+                       Geometry2 const& geometry2)
+{
+    return ! geometry::disjoint(prepared, geometry2);
+}
+
+/*!
+\brief \brief_calc2{intersection}, using the cached sections of the first geometry
+\ingroup intersection
+\details \details_calc2{intersection, spatial set theoretic intersection}.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam GeometryOut Collection of geometries (e.g. std::vector, std::deque, boost::geometry::multi*) of which
+    the value_type fulfills a \p_l_or_c concept, or it is the output geometry (e.g. for a box)
+\param prepared The first geometry, with cached sections
+\param geometry2 \param_geometry
+\param geometry_out The output geometry, either a multi_point, multi_polygon,
+    multi_linestring, or a box (for intersection of two boxes)
+
+\qbk{distinguish,prepared sections}
+*/
+template
+<
+    typename Geometry1,
+    typename Geometry2,
+    typename GeometryOut
+>
+inline bool intersection(prepared_sections<Geometry1> const& prepared,
+            Geometry2 const& geometry2,
+            GeometryOut& geometry_out)
+{
+    concept::check<Geometry1 const>();
+    concept::check<Geometry2 const>();
+
+    Geometry1 const& geometry1 = prepared.geometry();
+
+    typedef typename geometry::rescale_overlay_policy_type
+    <
+        Geometry1,
+        Geometry2
+    >::type rescale_policy_type;
+
+    rescale_policy_type robust_policy
+        = geometry::get_rescale_policy<rescale_policy_type>(geometry1,
+                                                            geometry2);
+
+    typedef strategy_intersection
+    <
+        typename cs_tag<Geometry1>::type,
+        Geometry1,
+        Geometry2,
+        typename geometry::point_type<Geometry1>::type,
+        rescale_policy_type
+    > strategy;
+
+    return dispatch::intersection
+    <
+        Geometry1,
+        Geometry2
+    >::apply(geometry1, geometry2, robust_policy, geometry_out,
+             detail::overlay::prepared_strategy
+                <
+                    strategy, prepared_sections<Geometry1>
+                >(prepared));
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_PREPARED_SECTIONS_HPP
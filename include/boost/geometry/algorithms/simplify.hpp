@@ -32,6 +32,8 @@
 
 #include <boost/geometry/geometries/concepts/check.hpp>
 #include <boost/geometry/strategies/agnostic/simplify_douglas_peucker.hpp>
+#include <boost/geometry/strategies/agnostic/simplify_topology_preserving.hpp>
+#include <boost/geometry/strategies/agnostic/simplify_visvalingam_whyatt.hpp>
 #include <boost/geometry/strategies/concepts/simplify_concept.hpp>
 #include <boost/geometry/strategies/default_strategy.hpp>
 #include <boost/geometry/strategies/distance.hpp>
@@ -41,6 +43,7 @@
 #include <boost/geometry/algorithms/not_implemented.hpp>
 
 #include <boost/geometry/algorithms/detail/distance/default_strategies.hpp>
+#include <boost/geometry/algorithms/detail/simplify/topology_preserving.hpp>
 
 namespace boost { namespace geometry
 {
@@ -296,6 +299,33 @@ struct simplify<MultiPolygon, multi_polygon_tag>
 {};
 
 
+// The topology preserving simplification of the rings of areal geometries,
+// other geometries are simplified as with visvalingam_whyatt
+template
+<
+    typename Geometry,
+    typename Tag = typename tag<Geometry>::type
+>
+struct simplify_topology_preserving
+    : simplify<Geometry>
+{};
+
+template <typename Ring>
+struct simplify_topology_preserving<Ring, ring_tag>
+    : detail::simplify::simplify_topology_preserving
+{};
+
+template <typename Polygon>
+struct simplify_topology_preserving<Polygon, polygon_tag>
+    : detail::simplify::simplify_topology_preserving
+{};
+
+template <typename MultiPolygon>
+struct simplify_topology_preserving<MultiPolygon, multi_polygon_tag>
+    : detail::simplify::simplify_topology_preserving
+{};
+
+
 } // namespace dispatch
 #endif // DOXYGEN_NO_DISPATCH
 
@@ -314,6 +344,27 @@ struct simplify
         dispatch::simplify<Geometry>::apply(geometry, out, max_distance, strategy);
     }
 
+    template
+    <
+        typename Geometry,
+        typename Distance,
+        typename Point,
+        typename PointDistanceStrategy
+    >
+    static inline void apply(Geometry const& geometry,
+                             Geometry& out,
+                             Distance const& max_area,
+                             strategy::simplify::topology_preserving
+                                <
+                                    Point, PointDistanceStrategy
+                                > const& strategy)
+    {
+        dispatch::simplify_topology_preserving
+            <
+                Geometry
+            >::apply(geometry, out, max_area, strategy);
+    }
+
     template <typename Geometry, typename Distance>
     static inline void apply(Geometry const& geometry,
                              Geometry& out,
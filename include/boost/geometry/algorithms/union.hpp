@@ -27,6 +27,7 @@
 
 #include <boost/geometry/algorithms/detail/overlay/linear_linear.hpp>
 #include <boost/geometry/algorithms/detail/overlay/pointlike_pointlike.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 
 namespace boost { namespace geometry
@@ -240,7 +241,7 @@ inline OutputIterator union_insert(Geometry1 const& geometry1,
 
 
 /*!
-\brief Combines two geometries which each other
+\brief Combines two geometries with each other
 \ingroup union
 \details \details_calc2{union, spatial set theoretic union}.
 \tparam Geometry1 \tparam_geometry
@@ -275,6 +276,69 @@ inline void union_(Geometry1 const& geometry1,
 }
 
 
+/*!
+\brief Combines two geometries with each other, using parallel tasks
+\ingroup union
+\details \details_calc2{union, spatial set theoretic union}.
+    The turns are calculated per pair of sections and enriched per ring by
+    parallel tasks, and the parents of the output rings are assigned by
+    parallel tasks. The traversal assembling the output rings is sequential.
+    The result is the same as the result of the sequential version.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Collection output collection, either a multi-geometry,
+    or a std::vector<Geometry> / std::deque<Geometry> etc
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param output_collection the output collection
+\param parallel_policy the parallel execution policy
+
+\qbk{distinguish,parallel}
+*/
+template
+<
+    typename Geometry1,
+    typename Geometry2,
+    typename Collection
+>
+inline void union_(Geometry1 const& geometry1,
+            Geometry2 const& geometry2,
+            Collection& output_collection,
+            geometry::parallel const& parallel_policy)
+{
+    concept::check<Geometry1 const>();
+    concept::check<Geometry2 const>();
+
+    typedef typename boost::range_value<Collection>::type geometry_out;
+    concept::check<geometry_out>();
+
+    typedef typename geometry::rescale_overlay_policy_type
+        <
+            Geometry1,
+            Geometry2
+        >::type rescale_policy_type;
+
+    typedef strategy_intersection
+        <
+            typename cs_tag<geometry_out>::type,
+            Geometry1,
+            Geometry2,
+            typename geometry::point_type<geometry_out>::type,
+            rescale_policy_type
+        > strategy;
+
+    rescale_policy_type robust_policy
+            = geometry::get_rescale_policy<rescale_policy_type>(geometry1, geometry2);
+
+    dispatch::union_insert
+        <
+            Geometry1, Geometry2, geometry_out
+        >::apply(geometry1, geometry2, robust_policy,
+                 std::back_inserter(output_collection),
+                 detail::overlay::parallel_strategy<strategy>(parallel_policy));
+}
+
+
 }} // namespace boost::geometry
 
 
@@ -0,0 +1,205 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_SHAPEFILE_DBF_READER_HPP
+#define BOOST_GEOMETRY_IO_SHAPEFILE_DBF_READER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry/core/assert.hpp>
+
+#include <boost/geometry/extensions/gis/io/shapefile/detail/parser.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+/*!
+\brief Reads the attributes of an ESRI shapefile (the dBASE .dbf file)
+    stored in memory
+\ingroup shapefile
+\details The records of the .dbf file correspond to the records of the .shp
+    file with the same index. The file is passed as a buffer, e.g. the
+    address of a memory-mapped file, which should stay valid while the
+    reader is used. The values are returned as text, as stored in the file
+    without the padding.
+*/
+class dbf_reader
+{
+public :
+    /*!
+    \brief Constructs the reader, reading the header and the field
+        descriptors
+    \param data pointer to the contents of the .dbf file
+    \param size size of the .dbf file in bytes
+    \throws read_shapefile_exception if the header is invalid or the records
+        exceed the file
+    */
+    dbf_reader(void const* data, std::size_t size)
+        : m_data(static_cast<boost::uint8_t const*>(data))
+        , m_count(0)
+        , m_header_size(0)
+        , m_record_size(0)
+    {
+        using namespace detail::shapefile;
+
+        if (m_data == 0 || size < 32)
+        {
+            throw read_shapefile_exception("Invalid dbf header", 0);
+        }
+
+        m_count = load_little_uint32(m_data + 4);
+        m_header_size = load_little_uint16(m_data + 8);
+        m_record_size = load_little_uint16(m_data + 10);
+
+        if (m_header_size > size || m_record_size == 0
+            || (size - m_header_size) / m_record_size < m_count)
+        {
+            throw read_shapefile_exception("Records exceed the dbf file", 0);
+        }
+
+        // Field descriptors of 32 bytes, terminated by 0x0D. The first byte
+        // of a record is the deletion flag.
+        std::size_t offset = 1;
+        for (std::size_t pos = 32;
+             pos + 32 <= m_header_size && m_data[pos] != 0x0D;
+             pos += 32)
+        {
+            field f;
+            boost::uint8_t const* const name = m_data + pos;
+            std::size_t length = 0;
+            while (length < 11 && name[length] != 0)
+            {
+                length++;
+            }
+            f.name.assign(reinterpret_cast<char const*>(name), length);
+            f.type = static_cast<char>(m_data[pos + 11]);
+            f.offset = offset;
+            f.length = m_data[pos + 16];
+            offset += f.length;
+
+            if (offset > m_record_size)
+            {
+                throw read_shapefile_exception(
+                    "Field exceeds the dbf record", pos);
+            }
+            m_fields.push_back(f);
+        }
+    }
+
+    /*!
+    \brief Returns the number of records
+    */
+    inline std::size_t size() const
+    {
+        return m_count;
+    }
+
+    /*!
+    \brief Returns the number of fields
+    */
+    inline std::size_t field_count() const
+    {
+        return m_fields.size();
+    }
+
+    /*!
+    \brief Returns the name of the field
+    */
+    inline std::string const& field_name(std::size_t field) const
+    {
+        BOOST_GEOMETRY_ASSERT(field < m_fields.size());
+        return m_fields[field].name;
+    }
+
+    /*!
+    \brief Returns the dBASE type of the field, e.g. 'C' for text, 'N' for
+        numbers
+    */
+    inline char field_type(std::size_t field) const
+    {
+        BOOST_GEOMETRY_ASSERT(field < m_fields.size());
+        return m_fields[field].type;
+    }
+
+    /*!
+    \brief Returns the index of the field with the name, or field_count()
+        if there is no such field
+    */
+    inline std::size_t field_index(std::string const& name) const
+    {
+        std::size_t i = 0;
+        while (i < m_fields.size() && m_fields[i].name != name)
+        {
+            i++;
+        }
+        return i;
+    }
+
+    /*!
+    \brief Returns true if the record is marked as deleted
+    */
+    inline bool is_deleted(std::size_t record) const
+    {
+        return *record_data(record) == '*';
+    }
+
+    /*!
+    \brief Returns the value of the field of the record, without the spaces
+        padding it
+    */
+    inline std::string value(std::size_t record, std::size_t field) const
+    {
+        BOOST_GEOMETRY_ASSERT(field < m_fields.size());
+
+        char const* first = reinterpret_cast<char const*>(
+            record_data(record) + m_fields[field].offset);
+        char const* last = first + m_fields[field].length;
+        while (first != last && *first == ' ')
+        {
+            ++first;
+        }
+        while (first != last && (*(last - 1) == ' ' || *(last - 1) == 0))
+        {
+            --last;
+        }
+        return std::string(first, last);
+    }
+
+private :
+    struct field
+    {
+        std::string name;
+        char type;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    inline boost::uint8_t const* record_data(std::size_t record) const
+    {
+        BOOST_GEOMETRY_ASSERT(record < m_count);
+        return m_data + m_header_size + m_record_size * record;
+    }
+
+    boost::uint8_t const* m_data;
+    std::size_t m_count;
+    std::size_t m_header_size;
+    std::size_t m_record_size;
+    std::vector<field> m_fields;
+};
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_SHAPEFILE_DBF_READER_HPP
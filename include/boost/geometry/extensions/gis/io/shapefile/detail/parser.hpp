@@ -0,0 +1,302 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_SHAPEFILE_DETAIL_PARSER_HPP
+#define BOOST_GEOMETRY_IO_SHAPEFILE_DETAIL_PARSER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <boost/geometry/core/exception.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+/*!
+\brief Exception thrown if a shapefile (.shp, .shx or .dbf) is invalid
+\ingroup shapefile
+*/
+class read_shapefile_exception : public geometry::exception
+{
+public :
+    read_shapefile_exception(std::string const& msg, std::size_t offset)
+        : m_offset(offset)
+    {
+        m_message = msg + " at offset "
+            + boost::lexical_cast<std::string>(offset);
+    }
+
+    virtual ~read_shapefile_exception() throw() {}
+
+    virtual const char* what() const throw()
+    {
+        return m_message.c_str();
+    }
+
+    /*!
+    \brief Returns the byte offset in the file where the error was found
+    */
+    inline std::size_t offset() const
+    {
+        return m_offset;
+    }
+
+private :
+    std::string m_message;
+    std::size_t m_offset;
+};
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace shapefile
+{
+
+// Shape types of the ESRI Shapefile Technical Description
+struct shape_type
+{
+    enum enum_t
+    {
+        null_shape = 0,
+        point = 1,
+        polyline = 3,
+        polygon = 5,
+        multipoint = 8,
+        point_z = 11,
+        polyline_z = 13,
+        polygon_z = 15,
+        multipoint_z = 18,
+        point_m = 21,
+        polyline_m = 23,
+        polygon_m = 25,
+        multipoint_m = 28,
+        multipatch = 31
+    };
+};
+
+static const std::size_t file_header_size = 100;
+static const std::size_t record_header_size = 8;
+static const boost::uint32_t file_code = 9994;
+
+// Integers are stored in big endian in the headers and in little endian in
+// the contents, doubles in little endian. The values are assembled from the
+// bytes so neither the alignment nor the byte order of the platform matters.
+inline boost::uint32_t load_big_uint32(boost::uint8_t const* p)
+{
+    return (boost::uint32_t(p[0]) << 24) | (boost::uint32_t(p[1]) << 16)
+         | (boost::uint32_t(p[2]) << 8) | boost::uint32_t(p[3]);
+}
+
+inline boost::uint32_t load_little_uint32(boost::uint8_t const* p)
+{
+    return (boost::uint32_t(p[3]) << 24) | (boost::uint32_t(p[2]) << 16)
+         | (boost::uint32_t(p[1]) << 8) | boost::uint32_t(p[0]);
+}
+
+inline boost::uint16_t load_little_uint16(boost::uint8_t const* p)
+{
+    return static_cast<boost::uint16_t>((p[1] << 8) | p[0]);
+}
+
+inline double load_little_double(boost::uint8_t const* p)
+{
+    boost::uint64_t const bits
+        = (boost::uint64_t(load_little_uint32(p + 4)) << 32)
+        | boost::uint64_t(load_little_uint32(p));
+    double value;
+    std::memcpy(&value, &bits, sizeof(double));
+    return value;
+}
+
+inline bool is_known_shape_type(boost::uint32_t type)
+{
+    switch (type)
+    {
+        case shape_type::null_shape :
+        case shape_type::point : case shape_type::point_z : case shape_type::point_m :
+        case shape_type::polyline : case shape_type::polyline_z : case shape_type::polyline_m :
+        case shape_type::polygon : case shape_type::polygon_z : case shape_type::polygon_m :
+        case shape_type::multipoint : case shape_type::multipoint_z : case shape_type::multipoint_m :
+            return true;
+    }
+    return false;
+}
+
+// Returns point, polyline, polygon or multipoint for the Z and M variants
+inline shape_type::enum_t base_shape_type(boost::uint32_t type)
+{
+    return type == shape_type::null_shape
+        ? shape_type::null_shape
+        : static_cast<shape_type::enum_t>(type % 10);
+}
+
+inline bool has_z(boost::uint32_t type)
+{
+    return type >= 10 && type < 20;
+}
+
+inline bool has_m(boost::uint32_t type)
+{
+    return type >= 10 && type < 30;
+}
+
+// The contents of one record, pointing into the file. The parts and the
+// points are only set for polylines, polygons and multipoints, the points
+// of a point record are its coordinates. Z and M are zero if not present,
+// M is optional in the files even for the types having it.
+struct record_contents
+{
+    record_contents()
+        : type(shape_type::null_shape)
+        , box(0), parts(0), points(0), z(0), m(0)
+        , num_parts(0), num_points(0)
+    {}
+
+    boost::uint32_t type;
+    boost::uint8_t const* box;
+    boost::uint8_t const* parts;
+    boost::uint8_t const* points;
+    boost::uint8_t const* z;
+    boost::uint8_t const* m;
+    std::size_t num_parts;
+    std::size_t num_points;
+};
+
+// Sets the pointer to the array of count doubles following a range of
+// two doubles, if it fits in the content, and advances the position
+inline void measure_array(boost::uint8_t const* content, std::size_t length,
+                          std::size_t& pos, std::size_t count,
+                          boost::uint8_t const*& array)
+{
+    std::size_t const size = 16 + 8 * count;
+    if (length - pos >= size)
+    {
+        array = content + pos + 16;
+        pos += size;
+    }
+}
+
+// Parses the contents of a record, returns false if they are invalid
+inline bool parse_record(boost::uint8_t const* content, std::size_t length,
+                         record_contents& record)
+{
+    record = record_contents();
+    if (length < 4)
+    {
+        return false;
+    }
+
+    record.type = load_little_uint32(content);
+    if (! is_known_shape_type(record.type))
+    {
+        return false;
+    }
+
+    std::size_t pos = 4;
+    switch (base_shape_type(record.type))
+    {
+        case shape_type::null_shape :
+            return true;
+
+        case shape_type::point :
+            if (length < 20)
+            {
+                return false;
+            }
+            record.points = content + 4;
+            record.num_points = 1;
+            pos = 20;
+            if (has_z(record.type) && length >= pos + 8)
+            {
+                record.z = content + pos;
+                pos += 8;
+            }
+            if (has_m(record.type) && length >= pos + 8)
+            {
+                record.m = content + pos;
+            }
+            return true;
+
+        case shape_type::multipoint :
+            if (length < 40)
+            {
+                return false;
+            }
+            record.box = content + 4;
+            record.num_points = load_little_uint32(content + 36);
+            pos = 40;
+            break;
+
+        default : // polyline, polygon
+            if (length < 44)
+            {
+                return false;
+            }
+            record.box = content + 4;
+            record.num_parts = load_little_uint32(content + 36);
+            record.num_points = load_little_uint32(content + 40);
+            pos = 44;
+            if ((length - pos) / 4 < record.num_parts)
+            {
+                return false;
+            }
+            record.parts = content + pos;
+            pos += 4 * record.num_parts;
+            break;
+    }
+
+    if ((length - pos) / 16 < record.num_points)
+    {
+        return false;
+    }
+    record.points = content + pos;
+    pos += 16 * record.num_points;
+
+    if (has_z(record.type))
+    {
+        measure_array(content, length, pos, record.num_points, record.z);
+        if (record.z == 0)
+        {
+            return false;
+        }
+    }
+    if (has_m(record.type))
+    {
+        measure_array(content, length, pos, record.num_points, record.m);
+    }
+
+    // The parts should start at increasing indexes of the points
+    std::size_t previous = 0;
+    for (std::size_t i = 0; i < record.num_parts; i++)
+    {
+        std::size_t const start = load_little_uint32(record.parts + 4 * i);
+        if (start < previous || start > record.num_points
+            || (i == 0 && start != 0))
+        {
+            return false;
+        }
+        previous = start;
+    }
+
+    return true;
+}
+
+
+}} // namespace detail::shapefile
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_SHAPEFILE_DETAIL_PARSER_HPP
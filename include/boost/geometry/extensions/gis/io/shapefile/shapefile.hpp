@@ -0,0 +1,15 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_SHAPEFILE_SHAPEFILE_HPP
+#define BOOST_GEOMETRY_IO_SHAPEFILE_SHAPEFILE_HPP
+
+#include <boost/geometry/extensions/gis/io/shapefile/dbf_reader.hpp>
+#include <boost/geometry/extensions/gis/io/shapefile/shp_reader.hpp>
+
+#endif // BOOST_GEOMETRY_IO_SHAPEFILE_SHAPEFILE_HPP
@@ -0,0 +1,861 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_SHAPEFILE_SHP_READER_HPP
+#define BOOST_GEOMETRY_IO_SHAPEFILE_SHP_READER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/range.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/assert.hpp>
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/point_order.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/ring_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+#include <boost/geometry/util/range.hpp>
+
+#include <boost/geometry/extensions/gis/io/shapefile/detail/parser.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace shapefile
+{
+
+template <std::size_t Index, typename Point>
+inline void set_coordinate(Point& point, boost::uint8_t const* p)
+{
+    typedef typename coordinate_type<Point>::type coordinate_type;
+    geometry::set<Index>(point,
+        static_cast<coordinate_type>(p == 0 ? 0.0 : load_little_double(p)));
+}
+
+// Assigns x and y, and z and m to the third and fourth dimension if the
+// point has them
+template
+<
+    typename Point,
+    std::size_t Dimension = geometry::dimension<Point>::value
+>
+struct point_assigner
+{
+    static inline void apply(Point& point, boost::uint8_t const* xy,
+                             boost::uint8_t const* z, boost::uint8_t const* m)
+    {
+        set_coordinate<0>(point, xy);
+        set_coordinate<1>(point, xy + 8);
+        set_coordinate<2>(point, z);
+        set_coordinate<3>(point, m);
+    }
+};
+
+template <typename Point>
+struct point_assigner<Point, 3>
+{
+    static inline void apply(Point& point, boost::uint8_t const* xy,
+                             boost::uint8_t const* z, boost::uint8_t const* )
+    {
+        set_coordinate<0>(point, xy);
+        set_coordinate<1>(point, xy + 8);
+        set_coordinate<2>(point, z);
+    }
+};
+
+template <typename Point>
+struct point_assigner<Point, 2>
+{
+    static inline void apply(Point& point, boost::uint8_t const* xy,
+                             boost::uint8_t const* , boost::uint8_t const* )
+    {
+        set_coordinate<0>(point, xy);
+        set_coordinate<1>(point, xy + 8);
+    }
+};
+
+}} // namespace detail::shapefile
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Random access iterator decoding the points of a shapefile record
+    stored in memory
+\ingroup shapefile
+\details The iterator points into the file and dereferences to a point by
+    value, decoded from the coordinates of the record.
+*/
+template <typename Point>
+class shp_point_iterator
+    : public boost::iterator_facade
+        <
+            shp_point_iterator<Point>,
+            Point const,
+            boost::random_access_traversal_tag,
+            Point
+        >
+{
+public :
+    shp_point_iterator()
+        : m_xy(0), m_z(0), m_m(0), m_index(0)
+    {}
+
+    shp_point_iterator(boost::uint8_t const* xy, boost::uint8_t const* z,
+                       boost::uint8_t const* m, std::ptrdiff_t index)
+        : m_xy(xy), m_z(z), m_m(m), m_index(index)
+    {}
+
+private :
+    friend class boost::iterator_core_access;
+
+    inline Point dereference() const
+    {
+        Point point;
+        detail::shapefile::point_assigner<Point>::apply(point,
+            m_xy + 16 * m_index,
+            m_z == 0 ? 0 : m_z + 8 * m_index,
+            m_m == 0 ? 0 : m_m + 8 * m_index);
+        return point;
+    }
+
+    inline bool equal(shp_point_iterator const& other) const
+    {
+        return m_index == other.m_index;
+    }
+
+    inline void increment() { ++m_index; }
+    inline void decrement() { --m_index; }
+    inline void advance(std::ptrdiff_t n) { m_index += n; }
+
+    inline std::ptrdiff_t distance_to(shp_point_iterator const& other) const
+    {
+        return other.m_index - m_index;
+    }
+
+    boost::uint8_t const* m_xy;
+    boost::uint8_t const* m_z;
+    boost::uint8_t const* m_m;
+    std::ptrdiff_t m_index;
+};
+
+
+/*!
+\brief Range of points of a shapefile record (or of one of its parts),
+    decoded on the fly from the file stored in memory
+\ingroup shapefile
+\details The range doesn't copy the coordinates, it is valid as long as the
+    file is. It is registered as a linestring so it can be passed to
+    algorithms not modifying their input, e.g. length or envelope.
+*/
+template <typename Point>
+class shp_points
+{
+public :
+    typedef Point value_type;
+    typedef shp_point_iterator<Point> iterator;
+    typedef shp_point_iterator<Point> const_iterator;
+    typedef std::size_t size_type;
+
+    shp_points()
+        : m_xy(0), m_z(0), m_m(0), m_first(0), m_last(0)
+    {}
+
+    shp_points(boost::uint8_t const* xy, boost::uint8_t const* z,
+               boost::uint8_t const* m, std::size_t first, std::size_t last)
+        : m_xy(xy), m_z(z), m_m(m), m_first(first), m_last(last)
+    {}
+
+    inline const_iterator begin() const
+    {
+        return const_iterator(m_xy, m_z, m_m, m_first);
+    }
+
+    inline const_iterator end() const
+    {
+        return const_iterator(m_xy, m_z, m_m, m_last);
+    }
+
+    inline size_type size() const
+    {
+        return m_last - m_first;
+    }
+
+    inline bool empty() const
+    {
+        return m_first == m_last;
+    }
+
+private :
+    boost::uint8_t const* m_xy;
+    boost::uint8_t const* m_z;
+    boost::uint8_t const* m_m;
+    std::size_t m_first;
+    std::size_t m_last;
+};
+
+
+#ifndef DOXYGEN_NO_TRAITS_SPECIALIZATIONS
+namespace traits
+{
+
+template <typename Point>
+struct tag<shp_points<Point> >
+{
+    typedef linestring_tag type;
+};
+
+} // namespace traits
+#endif // DOXYGEN_NO_TRAITS_SPECIALIZATIONS
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace shapefile
+{
+
+template <typename Point>
+inline shp_points<Point> part_points(record_contents const& record,
+                                     std::size_t part)
+{
+    std::size_t const first = record.parts == 0 ? 0
+        : load_little_uint32(record.parts + 4 * part);
+    std::size_t const last = record.parts == 0 || part + 1 >= record.num_parts
+        ? record.num_points
+        : load_little_uint32(record.parts + 4 * (part + 1));
+    return shp_points<Point>(record.points, record.z, record.m, first, last);
+}
+
+// Twice the signed area of the ring, negative if it is clockwise (shapefile
+// outer rings are clockwise, holes counterclockwise)
+inline double ring_area(record_contents const& record, std::size_t part)
+{
+    std::size_t const first = load_little_uint32(record.parts + 4 * part);
+    std::size_t const last = part + 1 >= record.num_parts
+        ? record.num_points
+        : load_little_uint32(record.parts + 4 * (part + 1));
+
+    double sum = 0;
+    for (std::size_t i = first; i + 1 < last; i++)
+    {
+        boost::uint8_t const* p = record.points + 16 * i;
+        sum += load_little_double(p) * load_little_double(p + 24)
+             - load_little_double(p + 16) * load_little_double(p + 8);
+    }
+    return sum;
+}
+
+// Appends the points, the closing point is skipped for open geometries
+template <typename Range, closure_selector Closure = geometry::closure<Range>::value>
+struct points_appender
+{
+    template <typename Point>
+    static inline void apply(shp_points<Point> const& points, Range& range)
+    {
+        for (typename shp_points<Point>::const_iterator it = points.begin();
+             it != points.end(); ++it)
+        {
+            range::push_back(range, *it);
+        }
+    }
+};
+
+template <typename Range>
+struct points_appender<Range, open>
+{
+    template <typename Point>
+    static inline void apply(shp_points<Point> const& points, Range& range)
+    {
+        typename shp_points<Point>::const_iterator last = points.end();
+        if (points.size() > 1)
+        {
+            --last;
+        }
+        for (typename shp_points<Point>::const_iterator it = points.begin();
+             it != last; ++it)
+        {
+            range::push_back(range, *it);
+        }
+    }
+};
+
+template <typename Ring>
+inline void append_ring(record_contents const& record, std::size_t part,
+                        Ring& ring)
+{
+    typedef typename geometry::point_type<Ring>::type point_type;
+    points_appender<Ring>::apply(part_points<point_type>(record, part), ring);
+    if (geometry::point_order<Ring>::value == counterclockwise)
+    {
+        std::reverse(boost::begin(ring), boost::end(ring));
+    }
+}
+
+// Assigns the rings from the part first to the part before the next outer
+// ring, returns the part after the last one
+template <typename Polygon>
+inline std::size_t append_polygon(record_contents const& record,
+                                  std::size_t first, Polygon& polygon)
+{
+    typedef typename ring_type<Polygon>::type ring_type;
+
+    append_ring(record, first, geometry::exterior_ring(polygon));
+
+    std::size_t part = first + 1;
+    for (; part < record.num_parts && ring_area(record, part) > 0; part++)
+    {
+        ring_type ring;
+        append_ring(record, part, ring);
+        range::push_back(geometry::interior_rings(polygon), ring);
+    }
+    return part;
+}
+
+}} // namespace detail::shapefile
+#endif // DOXYGEN_NO_DETAIL
+
+
+#ifndef DOXYGEN_NO_DISPATCH
+namespace dispatch
+{
+
+template <typename Tag, typename Geometry>
+struct read_shape {};
+
+template <typename Point>
+struct read_shape<point_tag, Point>
+{
+    static inline bool apply(detail::shapefile::record_contents const& record,
+                             Point& point)
+    {
+        using namespace detail::shapefile;
+        if (base_shape_type(record.type) != shape_type::point)
+        {
+            return false;
+        }
+        point_assigner<Point>::apply(point, record.points, record.z, record.m);
+        return true;
+    }
+};
+
+template <typename MultiPoint>
+struct read_shape<multi_point_tag, MultiPoint>
+{
+    static inline bool apply(detail::shapefile::record_contents const& record,
+                             MultiPoint& multi_point)
+    {
+        using namespace detail::shapefile;
+        typedef typename geometry::point_type<MultiPoint>::type point_type;
+
+        shape_type::enum_t const type = base_shape_type(record.type);
+        if (type != shape_type::point && type != shape_type::multipoint)
+        {
+            return false;
+        }
+
+        range::clear(multi_point);
+        shp_points<point_type> const points(record.points, record.z,
+                                            record.m, 0, record.num_points);
+        for (typename shp_points<point_type>::const_iterator it = points.begin();
+             it != points.end(); ++it)
+        {
+            range::push_back(multi_point, *it);
+        }
+        return true;
+    }
+};
+
+template <typename Linestring>
+struct read_shape<linestring_tag, Linestring>
+{
+    static inline bool apply(detail::shapefile::record_contents const& record,
+                             Linestring& linestring)
+    {
+        using namespace detail::shapefile;
+        typedef typename geometry::point_type<Linestring>::type point_type;
+
+        if (base_shape_type(record.type) != shape_type::polyline
+            || record.num_parts != 1)
+        {
+            return false;
+        }
+
+        range::clear(linestring);
+        points_appender<Linestring, closed>::apply(
+            part_points<point_type>(record, 0), linestring);
+        return true;
+    }
+};
+
+template <typename MultiLinestring>
+struct read_shape<multi_linestring_tag, MultiLinestring>
+{
+    static inline bool apply(detail::shapefile::record_contents const& record,
+                             MultiLinestring& multi_linestring)
+    {
+        using namespace detail::shapefile;
+        typedef typename boost::range_value<MultiLinestring>::type linestring_type;
+        typedef typename geometry::point_type<MultiLinestring>::type point_type;
+
+        if (base_shape_type(record.type) != shape_type::polyline)
+        {
+            return false;
+        }
+
+        range::clear(multi_linestring);
+        range::resize(multi_linestring, record.num_parts);
+        for (std::size_t i = 0; i < record.num_parts; i++)
+        {
+            points_appender<linestring_type, closed>::apply(
+                part_points<point_type>(record, i),
+                range::at(multi_linestring, i));
+        }
+        return true;
+    }
+};
+
+template <typename Ring>
+struct read_shape<ring_tag, Ring>
+{
+    static inline bool apply(detail::shapefile::record_contents const& record,
+                             Ring& ring)
+    {
+        using namespace detail::shapefile;
+        if (base_shape_type(record.type) != shape_type::polygon
+            || record.num_parts != 1)
+        {
+            return false;
+        }
+
+        range::clear(ring);
+        append_ring(record, 0, ring);
+        return true;
+    }
+};
+
+template <typename Polygon>
+struct read_shape<polygon_tag, Polygon>
+{
+    static inline bool apply(detail::shapefile::record_contents const& record,
+                             Polygon& polygon)
+    {
+        using namespace detail::shapefile;
+        if (base_shape_type(record.type) != shape_type::polygon
+            || record.num_parts == 0)
+        {
+            return false;
+        }
+
+        range::clear(geometry::exterior_ring(polygon));
+        range::clear(geometry::interior_rings(polygon));
+
+        // A record with several outer rings can't be read into a polygon
+        return append_polygon(record, 0, polygon) == record.num_parts;
+    }
+};
+
+template <typename MultiPolygon>
+struct read_shape<multi_polygon_tag, MultiPolygon>
+{
+    static inline bool apply(detail::shapefile::record_contents const& record,
+                             MultiPolygon& multi_polygon)
+    {
+        using namespace detail::shapefile;
+        typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+
+        if (base_shape_type(record.type) != shape_type::polygon)
+        {
+            return false;
+        }
+
+        // The holes follow their outer ring, as written by the common
+        // implementations
+        range::clear(multi_polygon);
+        for (std::size_t part = 0; part < record.num_parts; )
+        {
+            range::push_back(multi_polygon, polygon_type());
+            part = append_polygon(record, part, range::back(multi_polygon));
+        }
+        return true;
+    }
+};
+
+} // namespace dispatch
+#endif // DOXYGEN_NO_DISPATCH
+
+
+/*!
+\brief One record of a shapefile stored in memory
+\ingroup shapefile
+\details The record points into the file, it is valid as long as the file
+    is. The points are accessed without copying them, or the shape is
+    converted into a geometry by read().
+*/
+class shp_record
+{
+public :
+    explicit shp_record(detail::shapefile::record_contents const& contents)
+        : m_contents(contents)
+    {}
+
+    /*!
+    \brief Returns the shape type of the record, as in the specification
+        (e.g. 5 for polygons, 15 for polygons with Z)
+    */
+    inline boost::uint32_t shape_type() const
+    {
+        return m_contents.type;
+    }
+
+    /*!
+    \brief Returns true if the record has a null shape
+    */
+    inline bool is_null() const
+    {
+        return m_contents.type == detail::shapefile::shape_type::null_shape;
+    }
+
+    /*!
+    \brief Returns the number of parts (polylines) or rings (polygons),
+        0 for other shape types
+    */
+    inline std::size_t num_parts() const
+    {
+        return m_contents.num_parts;
+    }
+
+    /*!
+    \brief Returns the number of points
+    */
+    inline std::size_t num_points() const
+    {
+        return m_contents.num_points;
+    }
+
+    /*!
+    \brief Returns all points of the record
+    */
+    template <typename Point>
+    inline shp_points<Point> points() const
+    {
+        return shp_points<Point>(m_contents.points, m_contents.z,
+                                 m_contents.m, 0, m_contents.num_points);
+    }
+
+    /*!
+    \brief Returns the points of one part (polylines) or ring (polygons)
+    */
+    template <typename Point>
+    inline shp_points<Point> part(std::size_t index) const
+    {
+        BOOST_GEOMETRY_ASSERT(index < m_contents.num_parts);
+        return detail::shapefile::part_points<Point>(m_contents, index);
+    }
+
+    /*!
+    \brief Assigns the bounding box stored in the record (or the point)
+    \return false if the shape is null
+    */
+    template <typename Box>
+    inline bool envelope(Box& box) const
+    {
+        typedef typename coordinate_type<Box>::type coordinate_type;
+        using detail::shapefile::load_little_double;
+
+        if (is_null())
+        {
+            return false;
+        }
+
+        boost::uint8_t const* const min = m_contents.box != 0
+            ? m_contents.box : m_contents.points;
+        boost::uint8_t const* const max = m_contents.box != 0
+            ? m_contents.box + 16 : m_contents.points;
+        geometry::set<min_corner, 0>(box,
+            static_cast<coordinate_type>(load_little_double(min)));
+        geometry::set<min_corner, 1>(box,
+            static_cast<coordinate_type>(load_little_double(min + 8)));
+        geometry::set<max_corner, 0>(box,
+            static_cast<coordinate_type>(load_little_double(max)));
+        geometry::set<max_corner, 1>(box,
+            static_cast<coordinate_type>(load_little_double(max + 8)));
+        return true;
+    }
+
+    /*!
+    \brief Converts the shape into a geometry
+    \details Points are read into points and multi points, multi points
+        into multi points, polylines into multi linestrings (or linestrings
+        if they have one part) and polygons into multi polygons (or polygons
+        and rings if they have one outer ring). Rings are reversed and
+        opened for geometries which are counterclockwise or open. Z and M
+        are assigned to the third and fourth dimension if the point type has
+        them.
+    \return false if the shape is null or can't be read into the geometry
+    */
+    template <typename Geometry>
+    inline bool read(Geometry& geometry) const
+    {
+        return ! is_null()
+            && dispatch::read_shape
+                <
+                    typename tag<Geometry>::type,
+                    Geometry
+                >::apply(m_contents, geometry);
+    }
+
+private :
+    detail::shapefile::record_contents m_contents;
+};
+
+
+/*!
+\brief Reads the shapes of an ESRI shapefile stored in memory
+\ingroup shapefile
+\details The .shp file (and optionally its .shx index) are passed as
+    buffers, e.g. the addresses of memory-mapped files, so the records are
+    read directly from the mapped pages without copying them. With the .shx
+    file the records are accessed randomly without reading the .shp file
+    first, otherwise their offsets are collected when the reader is
+    created. The buffers should stay valid while the reader and its records
+    are used.
+*/
+class shp_reader
+{
+public :
+    /*!
+    \brief Constructs the reader, checking the headers
+    \param shp pointer to the contents of the .shp file
+    \param shp_size size of the .shp file in bytes
+    \param shx pointer to the contents of the .shx file, or 0
+    \param shx_size size of the .shx file in bytes
+    \throws read_shapefile_exception if a header is invalid, or without .shx
+        if a record exceeds the file
+    */
+    shp_reader(void const* shp, std::size_t shp_size,
+               void const* shx = 0, std::size_t shx_size = 0)
+        : m_shp(static_cast<boost::uint8_t const*>(shp))
+        , m_shp_size(shp_size)
+        , m_shx(static_cast<boost::uint8_t const*>(shx))
+        , m_count(0)
+    {
+        using namespace detail::shapefile;
+
+        check_header(m_shp, m_shp_size);
+
+        if (m_shx != 0)
+        {
+            check_header(m_shx, shx_size);
+            m_count = (shx_size - file_header_size) / record_header_size;
+        }
+        else
+        {
+            std::size_t offset = file_header_size;
+            while (m_shp_size - offset >= record_header_size)
+            {
+                std::size_t const length
+                    = 2 * std::size_t(load_big_uint32(m_shp + offset + 4));
+                if (m_shp_size - offset - record_header_size < length)
+                {
+                    throw read_shapefile_exception(
+                        "Record exceeds the file", offset);
+                }
+                m_offsets.push_back(offset);
+                offset += record_header_size + length;
+            }
+            m_count = m_offsets.size();
+        }
+    }
+
+    /*!
+    \brief Returns the number of records
+    */
+    inline std::size_t size() const
+    {
+        return m_count;
+    }
+
+    /*!
+    \brief Returns the shape type of the file
+    */
+    inline boost::uint32_t shape_type() const
+    {
+        return detail::shapefile::load_little_uint32(m_shp + 32);
+    }
+
+    /*!
+    \brief Assigns the bounding box of all shapes, stored in the header
+    */
+    template <typename Box>
+    inline void bounds(Box& box) const
+    {
+        detail::shapefile::record_contents contents;
+        contents.type = detail::shapefile::shape_type::polygon;
+        contents.box = m_shp + 36;
+        shp_record(contents).envelope(box);
+    }
+
+    /*!
+    \brief Returns the record at the index
+    \throws read_shapefile_exception if the record is invalid
+    */
+    inline shp_record record(std::size_t index) const
+    {
+        using namespace detail::shapefile;
+
+        std::size_t length = 0;
+        boost::uint8_t const* const content = record_content(index, length);
+        record_contents contents;
+        if (! parse_record(content, length, contents))
+        {
+            throw read_shapefile_exception("Invalid record",
+                static_cast<std::size_t>(content - m_shp) - record_header_size);
+        }
+        return shp_record(contents);
+    }
+
+    /*!
+    \brief Reads the shape of the record at the index into a geometry
+    \return false if the shape is null or can't be read into the geometry
+    \throws read_shapefile_exception if the record is invalid
+    */
+    template <typename Geometry>
+    inline bool read(std::size_t index, Geometry& geometry) const
+    {
+        return record(index).read(geometry);
+    }
+
+    /*!
+    \brief Finds the records whose bounding boxes intersect the box
+    \details Only the bounding boxes stored in the records are read, so this
+        can be used to select the shapes to decode.
+    \param box the box
+    \param out output iterator receiving the indexes of the records
+    \return the output iterator
+    \throws read_shapefile_exception if a record is invalid
+    */
+    template <typename Box, typename OutputIterator>
+    inline OutputIterator query(Box const& box, OutputIterator out) const
+    {
+        using namespace detail::shapefile;
+
+        double const min_x = geometry::get<min_corner, 0>(box);
+        double const min_y = geometry::get<min_corner, 1>(box);
+        double const max_x = geometry::get<max_corner, 0>(box);
+        double const max_y = geometry::get<max_corner, 1>(box);
+
+        for (std::size_t i = 0; i < m_count; i++)
+        {
+            boost::uint8_t const* const content = record_content(i);
+            boost::uint32_t const type = load_little_uint32(content);
+            if (type == shape_type::null_shape)
+            {
+                continue;
+            }
+
+            // Points are their own boxes, other shapes start with the box
+            boost::uint8_t const* const min = content + 4;
+            boost::uint8_t const* const max
+                = base_shape_type(type) == shape_type::point ? min : min + 16;
+            if (load_little_double(min) <= max_x
+                && load_little_double(min + 8) <= max_y
+                && load_little_double(max) >= min_x
+                && load_little_double(max + 8) >= min_y)
+            {
+                *out++ = i;
+            }
+        }
+        return out;
+    }
+
+private :
+    static inline void check_header(boost::uint8_t const* data,
+                                    std::size_t size)
+    {
+        using namespace detail::shapefile;
+        if (data == 0 || size < file_header_size
+            || load_big_uint32(data) != file_code
+            || load_little_uint32(data + 28) != 1000)
+        {
+            throw read_shapefile_exception("Invalid shapefile header", 0);
+        }
+    }
+
+    static inline std::size_t min_content_length(boost::uint32_t type)
+    {
+        using namespace detail::shapefile;
+        switch (base_shape_type(type))
+        {
+            case shape_type::null_shape : return 4;
+            case shape_type::point : return 20;
+            default : return 36;
+        }
+    }
+
+    // Returns the contents of the record, which has at least the space of
+    // the box (or of the point)
+    inline boost::uint8_t const* record_content(std::size_t index,
+                                                std::size_t& length) const
+    {
+        using namespace detail::shapefile;
+
+        BOOST_GEOMETRY_ASSERT(index < m_count);
+
+        std::size_t const offset = m_shx != 0
+            ? 2 * std::size_t(load_big_uint32(m_shx + file_header_size
+                                              + record_header_size * index))
+            : m_offsets[index];
+        // The offset is read from the .shx file, it is checked before it is
+        // subtracted from the size
+        if (offset < file_header_size
+            || offset > m_shp_size
+            || m_shp_size - offset < record_header_size)
+        {
+            throw read_shapefile_exception("Invalid record offset", offset);
+        }
+
+        length = 2 * std::size_t(load_big_uint32(m_shp + offset + 4));
+        boost::uint8_t const* const content = m_shp + offset + record_header_size;
+        if (m_shp_size - offset - record_header_size < length
+            || length < 4
+            || length < min_content_length(load_little_uint32(content)))
+        {
+            throw read_shapefile_exception("Invalid record", offset);
+        }
+        return content;
+    }
+
+    inline boost::uint8_t const* record_content(std::size_t index) const
+    {
+        std::size_t length = 0;
+        return record_content(index, length);
+    }
+
+    boost::uint8_t const* m_shp;
+    std::size_t m_shp_size;
+    boost::uint8_t const* m_shx;
+    std::size_t m_count;
+    std::vector<std::size_t> m_offsets;
+};
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_SHAPEFILE_SHP_READER_HPP
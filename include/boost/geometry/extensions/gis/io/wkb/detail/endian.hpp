@@ -255,6 +255,51 @@ struct endian_value<double, 8> : public endian_value_base<double>
     }
 };
 
+
+// Bulk load of 64-bit floating point values from contiguous bytes: one copy
+// and, if the byte order differs from the native one, one swap per value,
+// which compilers translate to a single instruction.
+
+inline boost::uint64_t byte_swap(boost::uint64_t value)
+{
+    boost::uint64_t const byte = 0xFF;
+    return (value >> 56)
+        | ((value >> 40) & (byte << 8))
+        | ((value >> 24) & (byte << 16))
+        | ((value >>  8) & (byte << 24))
+        | ((value <<  8) & (byte << 32))
+        | ((value << 24) & (byte << 40))
+        | ((value << 40) & (byte << 48))
+        | (value << 56);
+}
+
+template <typename E>
+inline void swap_values(double* , std::size_t , E, E)
+{
+}
+
+template <typename E1, typename E2>
+inline void swap_values(double* values, std::size_t count, E1, E2)
+{
+    for (std::size_t i = 0; i < count; i++)
+    {
+        boost::uint64_t raw;
+        std::memcpy(&raw, values + i, sizeof(boost::uint64_t));
+        raw = byte_swap(raw);
+        std::memcpy(values + i, &raw, sizeof(double));
+    }
+}
+
+template <typename E>
+inline void load_values(boost::uint8_t const* bytes, std::size_t count,
+                        double* values)
+{
+    BOOST_STATIC_ASSERT((sizeof(double) == sizeof(boost::uint64_t)));
+
+    std::memcpy(values, bytes, count * sizeof(double));
+    swap_values(values, count, native_endian_tag(), E());
+}
+
 }} // namespace detail::endian
 }} // namespace boost::geometry
 
@@ -9,8 +9,15 @@
 #ifndef BOOST_GEOMETRY_IO_WKB_DETAIL_OGC_HPP
 #define BOOST_GEOMETRY_IO_WKB_DETAIL_OGC_HPP
 
+#include <cstddef>
+
 #include <boost/cstdint.hpp>
 
+#include <boost/geometry/algorithms/not_implemented.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
 namespace boost { namespace geometry
 {
 
@@ -66,15 +73,13 @@ struct geometry_type_ogc
 {
     enum enum_t
     {
-        point      = 1,
-        linestring = 2,
-        polygon    = 3
-
-        // TODO: Not implemented
-        //multipoint = 4,
-        //multilinestring = 5,
-        //multipolygon = 6,
-        //collection = 7
+        point           = 1,
+        linestring      = 2,
+        polygon         = 3,
+        multipoint      = 4,
+        multilinestring = 5,
+        multipolygon    = 6,
+        collection      = 7
     };
 };
 
@@ -85,13 +90,10 @@ struct geometry_type_ewkt
         point      = 1,
         linestring = 2,
         polygon    = 3,
-
-        // TODO: Not implemented
-        //multipoint = 4,
-        //multilinestring = 5,
-        //multipolygon = 6,
-        //collection = 7
-
+        multipoint = 4,
+        multilinestring = 5,
+        multipolygon = 6,
+        collection = 7,
 
         pointz      = 1001,
         linestringz = 1002,
@@ -99,6 +101,24 @@ struct geometry_type_ewkt
     };
 };
 
+// Flags of the geometry type in PostGIS Extended WKB (EWKB), an SRID
+// follows the type if its flag is set
+struct ewkb_flags
+{
+    static const boost::uint32_t z = 0x80000000;
+    static const boost::uint32_t m = 0x40000000;
+    static const boost::uint32_t srid = 0x20000000;
+    static const boost::uint32_t all = 0xF0000000;
+};
+
+// Offsets of the geometry types with Z, M and ZM coordinates in ISO WKB
+struct iso_dimension_offset
+{
+    static const boost::uint32_t z = 1000;
+    static const boost::uint32_t m = 2000;
+    static const boost::uint32_t zm = 3000;
+};
+
 struct ogc_policy
 {
 };
@@ -140,7 +160,25 @@ struct geometry_type_impl<Geometry, OgcType, 3>
 
     static boost::uint32_t get()
     {
-        return 1000 + OgcType;
+        return iso_dimension_offset::z + OgcType;
+    }
+};
+
+template
+<
+    typename Geometry,
+    geometry_type_ogc::enum_t OgcType
+>
+struct geometry_type_impl<Geometry, OgcType, 4>
+{
+    static bool check(boost::uint32_t value)
+    {
+        return value == get();
+    }
+
+    static boost::uint32_t get()
+    {
+        return iso_dimension_offset::zm + OgcType;
     }
 };
 
@@ -169,6 +207,70 @@ struct geometry_type<Geometry, CheckPolicy, polygon_tag>
     : geometry_type_impl<Geometry, geometry_type_ogc::polygon>
 {};
 
+template <typename Geometry, typename CheckPolicy>
+struct geometry_type<Geometry, CheckPolicy, multi_point_tag>
+    : geometry_type_impl<Geometry, geometry_type_ogc::multipoint>
+{};
+
+template <typename Geometry, typename CheckPolicy>
+struct geometry_type<Geometry, CheckPolicy, multi_linestring_tag>
+    : geometry_type_impl<Geometry, geometry_type_ogc::multilinestring>
+{};
+
+template <typename Geometry, typename CheckPolicy>
+struct geometry_type<Geometry, CheckPolicy, multi_polygon_tag>
+    : geometry_type_impl<Geometry, geometry_type_ogc::multipolygon>
+{};
+
+// OGC type of the geometries with the tag, 0 if WKB can't represent them
+template <typename Tag>
+struct ogc_type
+{
+    static const boost::uint32_t value = 0;
+};
+
+template <>
+struct ogc_type<point_tag>
+{
+    static const boost::uint32_t value = geometry_type_ogc::point;
+};
+
+template <>
+struct ogc_type<linestring_tag>
+{
+    static const boost::uint32_t value = geometry_type_ogc::linestring;
+};
+
+template <>
+struct ogc_type<polygon_tag>
+{
+    static const boost::uint32_t value = geometry_type_ogc::polygon;
+};
+
+template <>
+struct ogc_type<multi_point_tag>
+{
+    static const boost::uint32_t value = geometry_type_ogc::multipoint;
+};
+
+template <>
+struct ogc_type<multi_linestring_tag>
+{
+    static const boost::uint32_t value = geometry_type_ogc::multilinestring;
+};
+
+template <>
+struct ogc_type<multi_polygon_tag>
+{
+    static const boost::uint32_t value = geometry_type_ogc::multipolygon;
+};
+
+template <>
+struct ogc_type<geometry_collection_tag>
+{
+    static const boost::uint32_t value = geometry_type_ogc::collection;
+};
+
 }} // namespace detail::wkb
 #endif // DOXYGEN_NO_IMPL
 
@@ -14,10 +14,14 @@
 #include <cstddef>
 #include <iterator>
 #include <limits>
+#include <string>
+#include <vector>
 
 #include <boost/concept_check.hpp>
 #include <boost/cstdint.hpp>
+#include <boost/range.hpp>
 #include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_pointer.hpp>
 #include <boost/type_traits/is_same.hpp>
 #include <boost/static_assert.hpp>
 
@@ -27,6 +31,10 @@
 #include <boost/geometry/core/coordinate_type.hpp>
 #include <boost/geometry/core/exterior_ring.hpp>
 #include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/mutable_range.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/ring_type.hpp>
+#include <boost/geometry/core/tag.hpp>
 #include <boost/geometry/extensions/gis/io/wkb/detail/endian.hpp>
 #include <boost/geometry/extensions/gis/io/wkb/detail/ogc.hpp>
 
@@ -57,30 +65,37 @@ struct value_parser
         diff_type const required_size = sizeof(T);
         if (it != end && std::distance(it, end) >= required_size)
         {
-            typedef endian::endian_value<T> parsed_value_type;
-            parsed_value_type parsed_value;
-
-            // Decide on direcion of endianness translation, detault to native
-            if (byte_order_type::xdr == order)
-            {
-                parsed_value.template load<endian::big_endian_tag>(it);
-            }
-            else if (byte_order_type::ndr == order)
-            {
-                parsed_value.template load<endian::little_endian_tag>(it);
-            }
-            else
-            {
-                parsed_value.template load<endian::native_endian_tag>(it);
-            }
-
-            value = parsed_value;
-            std::advance(it, required_size);
+            load(it, value, order);
             return true;
         }
 
         return false;
     }
+
+    // Loads the value, the caller checked that its bytes are available
+    template <typename Iterator>
+    static inline void load(Iterator& it, T& value, byte_order_type::enum_t order)
+    {
+        typedef endian::endian_value<T> parsed_value_type;
+        parsed_value_type parsed_value;
+
+        // Decide on direcion of endianness translation, detault to native
+        if (byte_order_type::xdr == order)
+        {
+            parsed_value.template load<endian::big_endian_tag>(it);
+        }
+        else if (byte_order_type::ndr == order)
+        {
+            parsed_value.template load<endian::little_endian_tag>(it);
+        }
+        else
+        {
+            parsed_value.template load<endian::native_endian_tag>(it);
+        }
+
+        value = parsed_value;
+        std::advance(it, sizeof(T));
+    }
 };
 
 struct byte_order_parser
@@ -94,70 +109,223 @@ struct byte_order_parser
             if (byte_order_type::unknown > value)
             {
                 order = byte_order_type::enum_t(value);
+                return true;
             }
-            return true;
         }
         return false;
     }
 };
 
+// Type, coordinate layout and SRID of a geometry, decoded from the ISO WKB
+// type (1000, 2000 or 3000 added for Z, M or ZM) or the PostGIS EWKB type
+// (flags in the high bits, optionally followed by an SRID)
+struct geometry_header
+{
+    geometry_header()
+        : type(0)
+        , has_z(false)
+        , has_m(false)
+        , has_srid(false)
+        , srid(0)
+    {}
+
+    inline std::size_t coordinate_count() const
+    {
+        return 2 + (has_z ? 1 : 0) + (has_m ? 1 : 0);
+    }
+
+    boost::uint32_t type;
+    bool has_z;
+    bool has_m;
+    bool has_srid;
+    boost::uint32_t srid;
+};
+
+struct header_parser
+{
+    template <typename Iterator>
+    static bool parse(Iterator& it, Iterator end,
+                byte_order_type::enum_t order, geometry_header& header)
+    {
+        boost::uint32_t value;
+        if (!value_parser<boost::uint32_t>::parse(it, end, value, order))
+        {
+            return false;
+        }
+
+        header.has_z = (value & ewkb_flags::z) != 0;
+        header.has_m = (value & ewkb_flags::m) != 0;
+        header.has_srid = (value & ewkb_flags::srid) != 0;
+        value &= ~ewkb_flags::all;
+
+        boost::uint32_t const offset = value - value % 1000;
+        header.type = value % 1000;
+        if (offset == iso_dimension_offset::z || offset == iso_dimension_offset::zm)
+        {
+            header.has_z = true;
+        }
+        if (offset == iso_dimension_offset::m || offset == iso_dimension_offset::zm)
+        {
+            header.has_m = true;
+        }
+
+        if (offset > iso_dimension_offset::zm
+            || header.type < geometry_type_ogc::point
+            || header.type > geometry_type_ogc::collection)
+        {
+            return false;
+        }
+
+        header.srid = 0;
+        return ! header.has_srid
+            || value_parser<boost::uint32_t>::parse(it, end, header.srid, order);
+    }
+};
+
 template <typename Geometry>
 struct geometry_type_parser
 {
     template <typename Iterator>
-    static bool parse(Iterator& it, Iterator end, 
+    static bool parse(Iterator& it, Iterator end,
+                byte_order_type::enum_t order, geometry_header& header)
+    {
+        return header_parser::parse(it, end, order, header)
+            && header.type == ogc_type<typename tag<Geometry>::type>::value;
+    }
+};
+
+// Byte sequences which are contiguous in memory, their coordinates can be
+// loaded in bulk
+template <typename Iterator>
+struct is_contiguous
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+
+    static const bool value = boost::is_pointer<Iterator>::value
+        || boost::is_same<Iterator, typename std::vector<value_type>::iterator>::value
+        || boost::is_same<Iterator, typename std::vector<value_type>::const_iterator>::value
+        || boost::is_same<Iterator, std::string::iterator>::value
+        || boost::is_same<Iterator, std::string::const_iterator>::value;
+};
+
+// Loads count coordinates, the caller checked that the bytes are available
+template <bool Contiguous>
+struct coordinates_loader
+{
+    template <typename Iterator>
+    static inline void apply(Iterator& it, std::size_t count, double* values,
                 byte_order_type::enum_t order)
     {
-        boost::uint32_t value;
-        if (value_parser<boost::uint32_t>::parse(it, end, value, order))
+        for (std::size_t i = 0; i < count; i++)
         {
-            return geometry_type<Geometry>::check(value);
+            value_parser<double>::load(it, values[i], order);
         }
-        return false;
     }
 };
 
-template <typename P,
-          std::size_t I = 0,
-          std::size_t N = dimension<P>::value>
-struct parsing_assigner
+template <>
+struct coordinates_loader<true>
 {
     template <typename Iterator>
-    static void run(Iterator& it, Iterator end, P& point, 
+    static inline void apply(Iterator& it, std::size_t count, double* values,
                 byte_order_type::enum_t order)
     {
-        typedef typename coordinate_type<P>::type coordinate_type;
+        if (count == 0)
+        {
+            return;
+        }
 
-        // coordinate type in WKB is always double
-        double value(0);
-        if (value_parser<double>::parse(it, end, value, order))
+        boost::uint8_t const* bytes
+            = reinterpret_cast<boost::uint8_t const*>(&*it);
+        if (byte_order_type::xdr == order)
         {
-            // actual coordinate type of point may be different
-            set<I>(point, static_cast<coordinate_type>(value));
+            endian::load_values<endian::big_endian_tag>(bytes, count, values);
+        }
+        else if (byte_order_type::ndr == order)
+        {
+            endian::load_values<endian::little_endian_tag>(bytes, count, values);
         }
         else
         {
-            // TODO: mloskot - Report premature termination at coordinate level
-            //throw failed to read coordinate value
-
-            // default initialized value as fallback
-            set<I>(point, coordinate_type());
+            endian::load_values<endian::native_endian_tag>(bytes, count, values);
         }
-        parsing_assigner<P, I+1, N>::run(it, end, point, order);
+        std::advance(it, count * sizeof(double));
+    }
+};
+
+template <typename Iterator>
+inline bool has_coordinates(Iterator it, Iterator end, std::size_t count)
+{
+    typedef typename std::iterator_traits<Iterator>::difference_type diff_type;
+    diff_type const available = std::distance(it, end) / diff_type(sizeof(double));
+    return available >= 0 && count <= static_cast<std::size_t>(available);
+}
+
+// Coordinate I of the point, the stored ones are x, y, z and m
+template <std::size_t I, bool Stored = (I < 4)>
+struct coordinate_value
+{
+    static inline double apply(double const* coordinates)
+    {
+        return coordinates[I];
+    }
+};
+
+template <std::size_t I>
+struct coordinate_value<I, false>
+{
+    static inline double apply(double const* )
+    {
+        return 0;
+    }
+};
+
+template <typename P,
+          std::size_t I = 0,
+          std::size_t N = dimension<P>::value>
+struct parsing_assigner
+{
+    static inline void run(double const* coordinates, P& point)
+    {
+        typedef typename coordinate_type<P>::type coordinate_type;
+
+        // coordinate type in WKB is always double, the actual coordinate
+        // type of point may be different
+        set<I>(point, static_cast<coordinate_type>(
+                          coordinate_value<I>::apply(coordinates)));
+        parsing_assigner<P, I+1, N>::run(coordinates, point);
     }
 };
 
 template <typename P, std::size_t N>
 struct parsing_assigner<P, N, N>
 {
-    template <typename Iterator>
-    static void run(Iterator& /*it*/, Iterator /*end*/, P& /*point*/,
-                byte_order_type::enum_t /*order*/)
+    static inline void run(double const* /*coordinates*/, P& /*point*/)
     {
         // terminate
     }
 };
 
+// Assigns the values of one point in the layout of the header, Z goes to
+// the third and M to the fourth dimension if the point has them, missing
+// values are zero
+template <typename P>
+inline void assign_values(double const* values, geometry_header const& header,
+                          P& point)
+{
+    double coordinates[4] = { values[0], values[1], 0, 0 };
+    std::size_t i = 2;
+    if (header.has_z)
+    {
+        coordinates[2] = values[i++];
+    }
+    if (header.has_m)
+    {
+        coordinates[3] = values[i];
+    }
+    parsing_assigner<P>::run(coordinates, point);
+}
+
 template <typename P>
 struct point_parser
 {
@@ -165,15 +333,22 @@ struct point_parser
     static bool parse(Iterator& it, Iterator end, P& point, 
                 byte_order_type::enum_t order)
     {
-        if (geometry_type_parser<P>::parse(it, end, order))
+        geometry_header header;
+        if (!geometry_type_parser<P>::parse(it, end, order, header))
         {
-            if (it != end)
-            {
-                parsing_assigner<P>::run(it, end, point, order);
-            }
-            return true;
+            return false;
         }
-        return false;
+
+        std::size_t const count = header.coordinate_count();
+        if (!has_coordinates(it, end, count))
+        {
+            return false;
+        }
+
+        double values[4];
+        coordinates_loader<is_contiguous<Iterator>::value>::apply(it, count, values, order);
+        assign_values(values, header, point);
+        return true;
     }
 };
 
@@ -182,7 +357,7 @@ struct point_container_parser
 {
     template <typename Iterator>
     static bool parse(Iterator& it, Iterator end, C& container, 
-                byte_order_type::enum_t order)
+                byte_order_type::enum_t order, geometry_header const& header)
     {
         typedef typename point_type<C>::type point_type;
 
@@ -192,34 +367,29 @@ struct point_container_parser
             return false;
         }
 
-        typedef typename std::iterator_traits<Iterator>::difference_type size_type;
-        BOOST_GEOMETRY_ASSERT(num_points <= boost::uint32_t( (std::numeric_limits<size_type>::max)() ) );
-
-        size_type const container_size = static_cast<size_type>(num_points);
-        size_type const point_size = dimension<point_type>::value * sizeof(double);
-
-        if (std::distance(it, end) >= (container_size * point_size))
+        std::size_t const coordinates = header.coordinate_count();
+        if (num_points > 0
+            && !has_coordinates(it, end, std::size_t(num_points) * coordinates))
         {
-            point_type point_buffer;
+            return false;
+        }
 
-            // Read coordinates into point and append point to line (ring)
-            size_type points_parsed = 0;
-            while (points_parsed < container_size && it != end)
-            {
-                parsing_assigner<point_type>::run(it, end, point_buffer, order);
-                boost::geometry::append(container, point_buffer);
-                ++points_parsed;
-            }
+        // Coordinates are loaded in blocks, then assigned to the points
+        std::size_t const block_size = 64;
+        double values[block_size * 4];
+        point_type point_buffer;
 
-            if (container_size != points_parsed)
+        for (std::size_t i = 0; i < num_points; i += block_size)
+        {
+            std::size_t const count = (std::min)(block_size, num_points - i);
+            coordinates_loader<is_contiguous<Iterator>::value>
+                ::apply(it, count * coordinates, values, order);
+            for (std::size_t j = 0; j < count; j++)
             {
-                return false;
+                assign_values(values + j * coordinates, header, point_buffer);
+                traits::push_back<C>::apply(container, point_buffer);
             }
         }
-        else
-        {
-            return false;
-        }
 
         return true;
     }
@@ -232,13 +402,13 @@ struct linestring_parser
     static bool parse(Iterator& it, Iterator end, L& linestring, 
                 byte_order_type::enum_t order)
     {
-        if (!geometry_type_parser<L>::parse(it, end, order))
+        geometry_header header;
+        if (!geometry_type_parser<L>::parse(it, end, order, header))
         {
             return false;
         }
 
-        BOOST_GEOMETRY_ASSERT(it != end);
-        return point_container_parser<L>::parse(it, end, linestring, order);
+        return point_container_parser<L>::parse(it, end, linestring, order, header);
     }
 };
 
@@ -249,7 +419,8 @@ struct polygon_parser
     static bool parse(Iterator& it, Iterator end, Polygon& polygon, 
                 byte_order_type::enum_t order)
     {
-        if (!geometry_type_parser<Polygon>::parse(it, end, order))
+        geometry_header header;
+        if (!geometry_type_parser<Polygon>::parse(it, end, order, header))
         {
             return false;
         }
@@ -268,7 +439,7 @@ struct polygon_parser
             if (0 == rings_parsed)
             {
                 ring_type& ring0 = exterior_ring(polygon);
-                if (!point_container_parser<ring_type>::parse(it, end, ring0, order))
+                if (!point_container_parser<ring_type>::parse(it, end, ring0, order, header))
                 {
                     return false;
                 }
@@ -277,7 +448,7 @@ struct polygon_parser
             {
                 interior_rings(polygon).resize(rings_parsed);
                 ring_type& ringN = interior_rings(polygon).back();
-                if (!point_container_parser<ring_type>::parse(it, end, ringN, order))
+                if (!point_container_parser<ring_type>::parse(it, end, ringN, order, header))
                 {
                     return false;
                 }
@@ -294,6 +465,80 @@ struct polygon_parser
     }
 };
 
+// Multi geometries, each geometry has its own byte order and header
+template <typename MultiGeometry, typename Parser>
+struct multi_parser
+{
+    template <typename Iterator>
+    static bool parse(Iterator& it, Iterator end, MultiGeometry& multi,
+                byte_order_type::enum_t order)
+    {
+        geometry_header header;
+        if (!geometry_type_parser<MultiGeometry>::parse(it, end, order, header))
+        {
+            return false;
+        }
+
+        boost::uint32_t num_geometries(0);
+        if (!value_parser<boost::uint32_t>::parse(it, end, num_geometries, order))
+        {
+            return false;
+        }
+
+        // Each geometry takes at least its byte order and type, don't
+        // allocate corrupt sizes
+        typedef typename std::iterator_traits<Iterator>::difference_type diff_type;
+        if (std::distance(it, end) / diff_type(5) < diff_type(num_geometries))
+        {
+            return false;
+        }
+
+        traits::resize<MultiGeometry>::apply(multi, num_geometries);
+
+        for (typename boost::range_iterator<MultiGeometry>::type
+                geometry_iter = boost::begin(multi);
+             geometry_iter != boost::end(multi);
+             ++geometry_iter)
+        {
+            byte_order_type::enum_t geometry_order;
+            if (!byte_order_parser::parse(it, end, geometry_order)
+                || !Parser::parse(it, end, *geometry_iter, geometry_order))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+template <typename MultiPoint>
+struct multi_point_parser
+    : multi_parser
+        <
+            MultiPoint,
+            point_parser<typename boost::range_value<MultiPoint>::type>
+        >
+{};
+
+template <typename MultiLinestring>
+struct multi_linestring_parser
+    : multi_parser
+        <
+            MultiLinestring,
+            linestring_parser<typename boost::range_value<MultiLinestring>::type>
+        >
+{};
+
+template <typename MultiPolygon>
+struct multi_polygon_parser
+    : multi_parser
+        <
+            MultiPolygon,
+            polygon_parser<typename boost::range_value<MultiPolygon>::type>
+        >
+{};
+
 }} // namespace detail::wkb
 #endif // DOXYGEN_NO_IMPL
 
@@ -27,6 +27,11 @@
 #include <boost/geometry/core/coordinate_type.hpp>
 #include <boost/geometry/core/exterior_ring.hpp>
 #include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/ring_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+#include <boost/geometry/algorithms/num_interior_rings.hpp>
 #include <boost/geometry/extensions/gis/io/wkb/detail/endian.hpp>
 #include <boost/geometry/extensions/gis/io/wkb/detail/ogc.hpp>
 
@@ -101,21 +106,76 @@ namespace detail { namespace wkb
         }
     };
 
-    template <typename Point>
-    struct point_writer
+    // Header options: ISO WKB or PostGIS EWKB, with an SRID which is only
+    // written for the outermost geometry
+    struct writer_options
+    {
+        writer_options()
+            : ewkb(false)
+            , has_srid(false)
+            , srid(0)
+        {}
+
+        inline writer_options nested() const
+        {
+            writer_options result = *this;
+            result.has_srid = false;
+            return result;
+        }
+
+        bool ewkb;
+        bool has_srid;
+        boost::uint32_t srid;
+    };
+
+    struct header_writer
     {
         template <typename OutputIterator>
-        static bool write(Point const& point,
+        static void write(boost::uint32_t type,
+                          std::size_t dimension,
                           OutputIterator& iter,
-                          byte_order_type::enum_t byte_order)
+                          byte_order_type::enum_t byte_order,
+                          writer_options const& options)
         {
             // write endian type
             value_writer<uint8_t>::write(byte_order, iter, byte_order);
 
-            // write geometry type
-            uint32_t type = geometry_type<Point>::get();
+            // write geometry type, with Z for the third and M for the
+            // fourth dimension
+            if (options.ewkb)
+            {
+                type |= dimension >= 3 ? ewkb_flags::z : 0;
+                type |= dimension >= 4 ? ewkb_flags::m : 0;
+                type |= options.has_srid ? ewkb_flags::srid : 0;
+            }
+            else
+            {
+                type += dimension == 3 ? iso_dimension_offset::z
+                    : dimension >= 4 ? iso_dimension_offset::zm
+                    : 0;
+            }
             value_writer<uint32_t>::write(type, iter, byte_order);
 
+            if (options.ewkb && options.has_srid)
+            {
+                value_writer<uint32_t>::write(options.srid, iter, byte_order);
+            }
+        }
+    };
+
+    template <typename Point>
+    struct point_writer
+    {
+        template <typename OutputIterator>
+        static bool write(Point const& point,
+                          OutputIterator& iter,
+                          byte_order_type::enum_t byte_order,
+                          writer_options const& options = writer_options())
+        {
+            header_writer::write(ogc_type<point_tag>::value,
+                                 dimension<Point>::value,
+                                 iter, byte_order, options);
+
             // write point's x, y, z
             writer_assigner<Point>::run(point, iter, byte_order);
 
@@ -123,34 +183,44 @@ namespace detail { namespace wkb
         }
     };
 
-    template <typename Linestring>
-    struct linestring_writer
+    template <typename Range>
+    struct point_range_writer
     {
         template <typename OutputIterator>
-        static bool write(Linestring const& linestring,
+        static void write(Range const& range,
                           OutputIterator& iter,
                           byte_order_type::enum_t byte_order)
         {
-            // write endian type
-            value_writer<uint8_t>::write(byte_order, iter, byte_order);
-
-            // write geometry type
-            uint32_t type = geometry_type<Linestring>::get();
-            value_writer<uint32_t>::write(type, iter, byte_order);
-
             // write num points
-            uint32_t num_points = boost::size(linestring);
+            uint32_t num_points = boost::size(range);
             value_writer<uint32_t>::write(num_points, iter, byte_order);
 
-            for(typename boost::range_iterator<Linestring const>::type
-                    point_iter = boost::begin(linestring);
-                point_iter != boost::end(linestring);
+            for(typename boost::range_iterator<Range const>::type
+                    point_iter = boost::begin(range);
+                point_iter != boost::end(range);
                 ++point_iter)
             {
                 // write point's x, y, z
-                writer_assigner<typename point_type<Linestring>::type>
+                writer_assigner<typename point_type<Range>::type>
                     ::run(*point_iter, iter, byte_order);
             }
+        }
+    };
+
+    template <typename Linestring>
+    struct linestring_writer
+    {
+        template <typename OutputIterator>
+        static bool write(Linestring const& linestring,
+                          OutputIterator& iter,
+                          byte_order_type::enum_t byte_order,
+                          writer_options const& options = writer_options())
+        {
+            header_writer::write(ogc_type<linestring_tag>::value,
+                                 dimension<Linestring>::value,
+                                 iter, byte_order, options);
+
+            point_range_writer<Linestring>::write(linestring, iter, byte_order);
 
             return true;
         }
@@ -162,14 +232,12 @@ namespace detail { namespace wkb
         template <typename OutputIterator>
         static bool write(Polygon const& polygon,
                           OutputIterator& iter,
-                          byte_order_type::enum_t byte_order)
+                          byte_order_type::enum_t byte_order,
+                          writer_options const& options = writer_options())
         {
-            // write endian type
-            value_writer<uint8_t>::write(byte_order, iter, byte_order);
-
-            // write geometry type
-            uint32_t type = geometry_type<Polygon>::get();
-            value_writer<uint32_t>::write(type, iter, byte_order);
+            header_writer::write(ogc_type<polygon_tag>::value,
+                                 dimension<Polygon>::value,
+                                 iter, byte_order, options);
 
             // write num rings
             uint32_t num_rings = 1 + geometry::num_interior_rings(polygon);
@@ -179,22 +247,8 @@ namespace detail { namespace wkb
             typedef typename geometry::ring_type<Polygon const>::type
                 ring_type;
 
-            typename geometry::ring_return_type<Polygon const>::type
-                exterior_ring = geometry::exterior_ring(polygon);
-
-            value_writer<uint32_t>::write(geometry::num_points(exterior_ring),
-                                          iter,
-                                          byte_order);
-
-            for(typename boost::range_iterator<ring_type const>::type
-                    point_iter = boost::begin(exterior_ring);
-                point_iter != boost::end(exterior_ring);
-                ++point_iter)
-            {
-                // write point's x, y, z
-                writer_assigner<typename point_type<Polygon>::type>
-                    ::run(*point_iter, iter, byte_order);
-            }
+            point_range_writer<ring_type>::write(geometry::exterior_ring(polygon),
+                                                 iter, byte_order);
 
             // write interor rings
             typedef typename geometry::interior_type<Polygon const>::type
@@ -208,25 +262,70 @@ namespace detail { namespace wkb
                 ring_iter != boost::end(interior_rings);
                 ++ring_iter)
             {
-                value_writer<uint32_t>::write(geometry::num_points(*ring_iter),
-                                              iter,
-                                              byte_order);
-
-                for(typename boost::range_iterator<ring_type const>::type
-                        point_iter = boost::begin(*ring_iter);
-                    point_iter != boost::end(*ring_iter); 
-                    ++point_iter)
-                {
-                    // write point's x, y, z
-                    writer_assigner<typename point_type<Polygon>::type>
-                        ::run(*point_iter, iter, byte_order);
-                }
+                point_range_writer<ring_type>::write(*ring_iter, iter, byte_order);
             }
 
             return true;
         }
     };
 
+    // Multi geometries, each geometry is written with its own header
+    template <typename MultiGeometry, typename Writer>
+    struct multi_writer
+    {
+        template <typename OutputIterator>
+        static bool write(MultiGeometry const& multi,
+                          OutputIterator& iter,
+                          byte_order_type::enum_t byte_order,
+                          writer_options const& options = writer_options())
+        {
+            header_writer::write(ogc_type<typename tag<MultiGeometry>::type>::value,
+                                 dimension<MultiGeometry>::value,
+                                 iter, byte_order, options);
+
+            // write num geometries
+            uint32_t num_geometries = boost::size(multi);
+            value_writer<uint32_t>::write(num_geometries, iter, byte_order);
+
+            for(typename boost::range_iterator<MultiGeometry const>::type
+                    geometry_iter = boost::begin(multi);
+                geometry_iter != boost::end(multi);
+                ++geometry_iter)
+            {
+                Writer::write(*geometry_iter, iter, byte_order, options.nested());
+            }
+
+            return true;
+        }
+    };
+
+    template <typename MultiPoint>
+    struct multi_point_writer
+        : multi_writer
+            <
+                MultiPoint,
+                point_writer<typename boost::range_value<MultiPoint>::type>
+            >
+    {};
+
+    template <typename MultiLinestring>
+    struct multi_linestring_writer
+        : multi_writer
+            <
+                MultiLinestring,
+                linestring_writer<typename boost::range_value<MultiLinestring>::type>
+            >
+    {};
+
+    template <typename MultiPolygon>
+    struct multi_polygon_writer
+        : multi_writer
+            <
+                MultiPolygon,
+                polygon_writer<typename boost::range_value<MultiPolygon>::type>
+            >
+    {};
+
 }} // namespace detail::wkb
 #endif // DOXYGEN_NO_IMPL
 
@@ -0,0 +1,437 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKB_READ_RECORDS_HPP
+#define BOOST_GEOMETRY_IO_WKB_READ_RECORDS_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry/io/wkt/read_records.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+#include <boost/geometry/extensions/gis/io/wkb/detail/ogc.hpp>
+#include <boost/geometry/extensions/gis/io/wkb/detail/parser.hpp>
+#include <boost/geometry/extensions/gis/io/wkb/read_wkb.hpp>
+#include <boost/geometry/extensions/gis/io/wkb/utility.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkb
+{
+
+// Reads the length prefix of the record at it, returns false if the record
+// doesn't fit in the buffer
+inline bool record_length(boost::uint8_t const* it, boost::uint8_t const* last,
+                          std::size_t& length)
+{
+    boost::uint32_t value = 0;
+    if (! value_parser<boost::uint32_t>::parse(it, last, value,
+                                               byte_order_type::ndr))
+    {
+        return false;
+    }
+    length = static_cast<std::size_t>(value);
+    return length <= static_cast<std::size_t>(last - it);
+}
+
+// Divides the buffer of length-prefixed records into (at most) count chunks
+// of about the same size. If a length is invalid the rest of the buffer is
+// the last chunk, whose reader will fail.
+inline void record_chunks(boost::uint8_t const* first,
+                          boost::uint8_t const* last, std::size_t count,
+                          std::vector<boost::uint8_t const*>& boundaries)
+{
+    std::size_t const chunk_size
+        = static_cast<std::size_t>(last - first) / (count > 0 ? count : 1);
+
+    boundaries.clear();
+    boundaries.push_back(first);
+
+    boost::uint8_t const* it = first;
+    std::size_t length = 0;
+    while (it != last && record_length(it, last, length))
+    {
+        it += sizeof(boost::uint32_t) + length;
+        if (it != last
+            && static_cast<std::size_t>(it - boundaries.back()) >= chunk_size)
+        {
+            boundaries.push_back(it);
+        }
+    }
+    if (boundaries.back() != last)
+    {
+        boundaries.push_back(last);
+    }
+}
+
+inline bool is_hex_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+}} // namespace detail::wkb
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Reads length-prefixed \ref WKB records from a byte buffer, one by one
+\ingroup wkb
+\details Each record consists of its length in bytes, as a 32-bit unsigned
+    integer in little endian byte order, followed by the WKB of one
+    geometry. The buffer (for example a memory-mapped file) is not copied
+    and should stay valid while the reader is used. The geometry can be
+    reused for all records. Reading stops at an invalid record, which can be
+    detected with at_end().
+*/
+class wkb_record_reader
+{
+public :
+    /*!
+    \brief Constructs the reader
+    \param first pointer to the first byte of the buffer
+    \param last pointer past the last byte of the buffer
+    \param base_offset offset of the buffer if it is a part of a larger
+        input, added to all reported offsets
+    */
+    wkb_record_reader(boost::uint8_t const* first, boost::uint8_t const* last,
+                      std::size_t base_offset = 0)
+        : m_first(first)
+        , m_it(first)
+        , m_last(last)
+        , m_base_offset(base_offset)
+        , m_record_offset(0)
+        , m_count(0)
+    {}
+
+    /*!
+    \brief Reads the next record into the geometry
+    \return false if there are no records left or if the record is invalid
+    */
+    template <typename Geometry>
+    inline bool next(Geometry& geometry)
+    {
+        std::size_t length = 0;
+        if (m_it == m_last || ! detail::wkb::record_length(m_it, m_last, length))
+        {
+            m_record_offset = offset(m_it);
+            return false;
+        }
+
+        boost::uint8_t const* const first = m_it + sizeof(boost::uint32_t);
+        m_record_offset = offset(m_it);
+
+        if (! read_wkb(first, first + length, geometry))
+        {
+            return false;
+        }
+
+        m_it = first + length;
+        m_count++;
+        return true;
+    }
+
+    /*!
+    \brief Returns the byte offset of the record read last, or of the
+        invalid record
+    */
+    inline std::size_t record_offset() const
+    {
+        return m_record_offset;
+    }
+
+    /*!
+    \brief Returns the number of records read
+    */
+    inline std::size_t count() const
+    {
+        return m_count;
+    }
+
+    /*!
+    \brief Returns true if all records were read
+    */
+    inline bool at_end() const
+    {
+        return m_it == m_last;
+    }
+
+private :
+    inline std::size_t offset(boost::uint8_t const* it) const
+    {
+        return m_base_offset + static_cast<std::size_t>(it - m_first);
+    }
+
+    boost::uint8_t const* m_first;
+    boost::uint8_t const* m_it;
+    boost::uint8_t const* m_last;
+    std::size_t m_base_offset;
+    std::size_t m_record_offset;
+    std::size_t m_count;
+};
+
+
+/*!
+\brief Reads newline-delimited hexadecimal \ref WKB records from a
+    character buffer, one by one
+\ingroup wkb
+\details Each line contains the WKB of one geometry as hexadecimal digits,
+    as written by wkb2hex or by database dumps. Lines containing only
+    whitespace are skipped. The digits are decoded into a byte buffer which
+    is reused for all records, as the geometry can be. Reading stops at an
+    invalid record, which can be detected with at_end().
+*/
+class hex_wkb_record_reader
+{
+public :
+    /*!
+    \brief Constructs the reader
+    \param first pointer to the first character of the buffer
+    \param last pointer past the last character of the buffer
+    \param base_offset offset of the buffer if it is a part of a larger
+        input, added to all reported offsets
+    */
+    hex_wkb_record_reader(char const* first, char const* last,
+                          std::size_t base_offset = 0)
+        : m_first(first)
+        , m_it(first)
+        , m_last(last)
+        , m_base_offset(base_offset)
+        , m_record_offset(0)
+        , m_count(0)
+    {}
+
+    /*!
+    \brief Reads the next record into the geometry
+    \return false if there are no records left or if the record is invalid
+    */
+    template <typename Geometry>
+    inline bool next(Geometry& geometry)
+    {
+        while (m_it != m_last)
+        {
+            char const* first = m_it;
+            char const* last = detail::wkt::line_end(m_it, m_last);
+            char const* const line_end = last;
+
+            while (first != last && detail::wkb::is_hex_space(*first))
+            {
+                ++first;
+            }
+            while (first != last && detail::wkb::is_hex_space(*(last - 1)))
+            {
+                --last;
+            }
+
+            if (first == last)
+            {
+                m_it = line_end != m_last ? line_end + 1 : line_end;
+                continue;
+            }
+
+            m_record_offset = offset(first);
+            m_bytes.clear();
+            if (! detail::wkb::hex_to_bytes(first, last,
+                                            std::back_inserter(m_bytes)))
+            {
+                return false;
+            }
+
+            if (! read_wkb(m_bytes.begin(), m_bytes.end(), geometry))
+            {
+                return false;
+            }
+
+            m_it = line_end != m_last ? line_end + 1 : line_end;
+            m_count++;
+            return true;
+        }
+        return false;
+    }
+
+    /*!
+    \brief Returns the byte offset of the record read last, or of the
+        invalid record
+    */
+    inline std::size_t record_offset() const
+    {
+        return m_record_offset;
+    }
+
+    /*!
+    \brief Returns the number of records read
+    */
+    inline std::size_t count() const
+    {
+        return m_count;
+    }
+
+    /*!
+    \brief Returns true if all records were read
+    */
+    inline bool at_end() const
+    {
+        return m_it == m_last;
+    }
+
+private :
+    inline std::size_t offset(char const* it) const
+    {
+        return m_base_offset + static_cast<std::size_t>(it - m_first);
+    }
+
+    char const* m_first;
+    char const* m_it;
+    char const* m_last;
+    std::size_t m_base_offset;
+    std::size_t m_record_offset;
+    std::size_t m_count;
+    std::vector<boost::uint8_t> m_bytes;
+};
+
+
+/*!
+\brief Calls a visitor for each length-prefixed \ref WKB record of a byte
+    buffer
+\ingroup wkb
+\details The visitor is called as visitor(geometry, offset), with the parsed
+    geometry and the byte offset of its record, in the order of the records.
+\tparam Geometry \tparam_geometry
+\param first pointer to the first byte of the buffer
+\param last pointer past the last byte of the buffer
+\param visitor function object called for each record
+\return false if an invalid record was found
+
+\qbk{distinguish,sequential}
+*/
+template <typename Geometry, typename Visitor>
+inline bool for_each_wkb_record(boost::uint8_t const* first,
+                                boost::uint8_t const* last,
+                                Visitor& visitor)
+{
+    wkb_record_reader reader(first, last);
+    Geometry geometry;
+    while (reader.next(geometry))
+    {
+        visitor(static_cast<Geometry const&>(geometry),
+                reader.record_offset());
+    }
+    return reader.at_end();
+}
+
+/*!
+\brief Calls a visitor for each length-prefixed \ref WKB record of a byte
+    buffer, parsing independent chunks in parallel
+\ingroup wkb
+\details The record boundaries are found by following the length prefixes,
+    then chunks of records are parsed by parallel tasks, each one reusing
+    its own geometry. The visitor is called as visitor(geometry, offset)
+    concurrently and in any order.
+\tparam Geometry \tparam_geometry
+\param first pointer to the first byte of the buffer
+\param last pointer past the last byte of the buffer
+\param visitor function object called for each record, it should be safe
+    to call concurrently
+\param parallel_policy the parallel execution policy
+\return false if an invalid record was found, the valid records of the
+    other chunks are visited anyway
+
+\qbk{distinguish,parallel}
+*/
+template <typename Geometry, typename Visitor>
+inline bool for_each_wkb_record(boost::uint8_t const* first,
+                                boost::uint8_t const* last,
+                                Visitor& visitor,
+                                geometry::parallel const& parallel_policy)
+{
+    std::size_t const threads
+        = detail::parallel::threads_count(parallel_policy);
+
+    std::vector<boost::uint8_t const*> boundaries;
+    detail::wkb::record_chunks(first, last, threads * 4, boundaries);
+
+    return detail::wkt::for_each_record
+        <
+            Geometry, wkb_record_reader
+        >(boundaries, visitor, parallel_policy);
+}
+
+/*!
+\brief Calls a visitor for each newline-delimited hexadecimal \ref WKB
+    record of a character buffer
+\ingroup wkb
+\details The visitor is called as visitor(geometry, offset), with the parsed
+    geometry and the byte offset of its record, in the order of the records.
+\tparam Geometry \tparam_geometry
+\param first pointer to the first character of the buffer
+\param last pointer past the last character of the buffer
+\param visitor function object called for each record
+\return false if an invalid record was found
+
+\qbk{distinguish,sequential}
+*/
+template <typename Geometry, typename Visitor>
+inline bool for_each_hex_wkb_record(char const* first, char const* last,
+                                    Visitor& visitor)
+{
+    hex_wkb_record_reader reader(first, last);
+    Geometry geometry;
+    while (reader.next(geometry))
+    {
+        visitor(static_cast<Geometry const&>(geometry),
+                reader.record_offset());
+    }
+    return reader.at_end();
+}
+
+/*!
+\brief Calls a visitor for each newline-delimited hexadecimal \ref WKB
+    record of a character buffer, parsing independent chunks in parallel
+\ingroup wkb
+\details The buffer is divided into chunks at line boundaries, the chunks
+    are parsed by parallel tasks, each one reusing its own geometry. The
+    visitor is called as visitor(geometry, offset) concurrently and in any
+    order.
+\tparam Geometry \tparam_geometry
+\param first pointer to the first character of the buffer
+\param last pointer past the last character of the buffer
+\param visitor function object called for each record, it should be safe
+    to call concurrently
+\param parallel_policy the parallel execution policy
+\return false if an invalid record was found, the valid records of the
+    other chunks are visited anyway
+
+\qbk{distinguish,parallel}
+*/
+template <typename Geometry, typename Visitor>
+inline bool for_each_hex_wkb_record(char const* first, char const* last,
+                                    Visitor& visitor,
+                                    geometry::parallel const& parallel_policy)
+{
+    std::size_t const threads
+        = detail::parallel::threads_count(parallel_policy);
+
+    std::vector<char const*> boundaries;
+    detail::wkt::line_chunks(first, last, threads * 4, boundaries);
+
+    return detail::wkt::for_each_record
+        <
+            Geometry, hex_wkb_record_reader
+        >(boundaries, visitor, parallel_policy);
+}
+
+
+}} // namespace boost::geometry
+
+#endif // BOOST_GEOMETRY_IO_WKB_READ_RECORDS_HPP
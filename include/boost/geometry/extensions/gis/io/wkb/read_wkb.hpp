@@ -11,9 +11,19 @@
 
 #include <iterator>
 
+#include <boost/cstdint.hpp>
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/next.hpp>
+#include <boost/range.hpp>
 #include <boost/type_traits/is_convertible.hpp>
 #include <boost/static_assert.hpp>
+#include <boost/variant/get.hpp>
+#include <boost/variant/variant_fwd.hpp>
 
+#include <boost/geometry/algorithms/clear.hpp>
+#include <boost/geometry/core/mutable_range.hpp>
+#include <boost/geometry/core/tag.hpp>
 #include <boost/geometry/core/tags.hpp>
 #include <boost/geometry/extensions/gis/io/wkb/detail/parser.hpp>
 
@@ -62,10 +72,240 @@ struct read_wkb<polygon_tag, G>
     }
 };
 
+template <typename G>
+struct read_wkb<multi_point_tag, G>
+{
+    template <typename Iterator>
+    static inline bool parse(Iterator& it, Iterator end, G& geometry,
+        detail::wkb::byte_order_type::enum_t order)
+    {
+        geometry::clear(geometry);
+        return detail::wkb::multi_point_parser<G>::parse(it, end, geometry, order);
+    }
+};
+
+template <typename G>
+struct read_wkb<multi_linestring_tag, G>
+{
+    template <typename Iterator>
+    static inline bool parse(Iterator& it, Iterator end, G& geometry,
+        detail::wkb::byte_order_type::enum_t order)
+    {
+        geometry::clear(geometry);
+        return detail::wkb::multi_linestring_parser<G>::parse(it, end, geometry, order);
+    }
+};
+
+template <typename G>
+struct read_wkb<multi_polygon_tag, G>
+{
+    template <typename Iterator>
+    static inline bool parse(Iterator& it, Iterator end, G& geometry,
+        detail::wkb::byte_order_type::enum_t order)
+    {
+        geometry::clear(geometry);
+        return detail::wkb::multi_polygon_parser<G>::parse(it, end, geometry, order);
+    }
+};
+
 } // namespace dispatch
 #endif // DOXYGEN_NO_DISPATCH
 
 
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkb
+{
+
+// Parses the geometry into the variant if its type has the OGC type of the
+// WKB, types which can't be represented in WKB are never instantiated
+template
+<
+    typename Geometry,
+    bool Representable
+        = ogc_type<typename tag<Geometry>::type>::value != 0
+>
+struct variant_alternative_parser
+{
+    template <typename Iterator, typename Variant>
+    static inline bool parse(Iterator& it, Iterator end, Variant& variant,
+        byte_order_type::enum_t order, boost::uint32_t type, bool& parsed)
+    {
+        if (type != ogc_type<typename tag<Geometry>::type>::value)
+        {
+            return false;
+        }
+
+        parsed = true;
+        variant = Geometry();
+        return dispatch::read_wkb
+            <
+                typename tag<Geometry>::type,
+                Geometry
+            >::parse(it, end, boost::get<Geometry>(variant), order);
+    }
+};
+
+template <typename Geometry>
+struct variant_alternative_parser<Geometry, false>
+{
+    template <typename Iterator, typename Variant>
+    static inline bool parse(Iterator& , Iterator , Variant& ,
+        byte_order_type::enum_t , boost::uint32_t , bool& )
+    {
+        return false;
+    }
+};
+
+// Selects the first alternative of the variant with the type of the WKB
+template <typename First, typename Last>
+struct variant_parser
+{
+    template <typename Iterator, typename Variant>
+    static inline bool parse(Iterator& it, Iterator end, Variant& variant,
+        byte_order_type::enum_t order, boost::uint32_t type)
+    {
+        bool parsed = false;
+        bool const result = variant_alternative_parser
+            <
+                typename boost::mpl::deref<First>::type
+            >::parse(it, end, variant, order, type, parsed);
+
+        return parsed
+            ? result
+            : variant_parser
+                <
+                    typename boost::mpl::next<First>::type,
+                    Last
+                >::parse(it, end, variant, order, type);
+    }
+};
+
+template <typename Last>
+struct variant_parser<Last, Last>
+{
+    template <typename Iterator, typename Variant>
+    static inline bool parse(Iterator& , Iterator , Variant& ,
+        byte_order_type::enum_t , boost::uint32_t )
+    {
+        return false;
+    }
+};
+
+}} // namespace detail::wkb
+#endif // DOXYGEN_NO_DETAIL
+
+
+#ifndef DOXYGEN_NO_DISPATCH
+namespace dispatch
+{
+
+template <typename Geometry>
+struct devarianted_read_wkb
+{
+    template <typename Iterator>
+    static inline bool parse(Iterator& it, Iterator end, Geometry& geometry,
+        detail::wkb::byte_order_type::enum_t order)
+    {
+        return read_wkb
+            <
+                typename tag<Geometry>::type,
+                Geometry
+            >::parse(it, end, geometry, order);
+    }
+};
+
+template <BOOST_VARIANT_ENUM_PARAMS(typename T)>
+struct devarianted_read_wkb<variant<BOOST_VARIANT_ENUM_PARAMS(T)> >
+{
+    typedef variant<BOOST_VARIANT_ENUM_PARAMS(T)> variant_type;
+
+    template <typename Iterator>
+    static inline bool parse(Iterator& it, Iterator end, variant_type& geometry,
+        detail::wkb::byte_order_type::enum_t order)
+    {
+        // The type is peeked, the parser of the alternative reads it again
+        Iterator type_it = it;
+        detail::wkb::geometry_header header;
+        if (!detail::wkb::header_parser::parse(type_it, end, order, header))
+        {
+            return false;
+        }
+
+        typedef typename variant_type::types types;
+        return detail::wkb::variant_parser
+            <
+                typename boost::mpl::begin<types>::type,
+                typename boost::mpl::end<types>::type
+            >::parse(it, end, geometry, order, header.type);
+    }
+};
+
+// Geometry collections, their elements are variants (or one geometry type)
+template <typename Collection>
+struct read_wkb<geometry_collection_tag, Collection>
+{
+    template <typename Iterator>
+    static inline bool parse(Iterator& it, Iterator end, Collection& collection,
+        detail::wkb::byte_order_type::enum_t order)
+    {
+        typedef typename boost::range_value<Collection>::type element_type;
+
+        traits::clear<Collection>::apply(collection);
+
+        detail::wkb::geometry_header header;
+        if (!detail::wkb::geometry_type_parser<Collection>::parse(it, end, order, header))
+        {
+            return false;
+        }
+
+        boost::uint32_t num_geometries(0);
+        if (!detail::wkb::value_parser<boost::uint32_t>::parse(it, end, num_geometries, order))
+        {
+            return false;
+        }
+
+        typedef typename std::iterator_traits<Iterator>::difference_type diff_type;
+        if (std::distance(it, end) / diff_type(5) < diff_type(num_geometries))
+        {
+            return false;
+        }
+
+        traits::resize<Collection>::apply(collection, num_geometries);
+
+        for (typename boost::range_iterator<Collection>::type
+                element_iter = boost::begin(collection);
+             element_iter != boost::end(collection);
+             ++element_iter)
+        {
+            detail::wkb::byte_order_type::enum_t element_order;
+            if (!detail::wkb::byte_order_parser::parse(it, end, element_order)
+                || !devarianted_read_wkb<element_type>::parse(it, end,
+                        *element_iter, element_order))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+} // namespace dispatch
+#endif // DOXYGEN_NO_DISPATCH
+
+
+/*!
+\brief Parses OGC Well-Known Binary (\ref WKB) into a geometry
+\ingroup wkb
+\details Points, linestrings, polygons, their multi versions and geometry
+    collections are read, in either byte order. Z and M values (ISO or
+    PostGIS EWKB) are assigned to the third and fourth dimension of the
+    points if they have them, otherwise they are skipped. An EWKB SRID is
+    skipped. If the geometry is a variant, the first alternative with the
+    type of the WKB is read. A geometry collection is a range of variants,
+    registered with the geometry_collection_tag.
+\return false if the WKB is invalid or doesn't match the geometry type
+*/
 template <typename Iterator, typename G>
 inline bool read_wkb(Iterator begin, Iterator end, G& geometry)
 {
@@ -80,16 +320,37 @@ inline bool read_wkb(Iterator begin, Iterator end, G& geometry)
     detail::wkb::byte_order_type::enum_t byte_order;
     if (detail::wkb::byte_order_parser::parse(begin, end, byte_order))
     {
-        return dispatch::read_wkb
-            <
-            typename tag<G>::type,
-            G
-            >::parse(begin, end, geometry, byte_order);
+        return dispatch::devarianted_read_wkb<G>::parse(begin, end, geometry, byte_order);
     }
 
     return false;
 }
 
+/*!
+\brief Parses OGC Well-Known Binary (\ref WKB) or PostGIS Extended WKB into a
+    geometry, and returns its SRID
+\ingroup wkb
+\details As read_wkb(begin, end, geometry), the SRID of the EWKB header is
+    assigned to srid, or 0 if the WKB has no SRID.
+*/
+template <typename Iterator, typename G>
+inline bool read_wkb(Iterator begin, Iterator end, G& geometry,
+                     boost::uint32_t& srid)
+{
+    srid = 0;
+
+    Iterator it = begin;
+    detail::wkb::byte_order_type::enum_t byte_order;
+    detail::wkb::geometry_header header;
+    if (detail::wkb::byte_order_parser::parse(it, end, byte_order)
+        && detail::wkb::header_parser::parse(it, end, byte_order, header))
+    {
+        srid = header.srid;
+    }
+
+    return read_wkb(begin, end, geometry);
+}
+
 template <typename ByteType, typename G>
 inline bool read_wkb(ByteType const* bytes, std::size_t length, G& geometry)
 {
@@ -23,40 +23,70 @@
 namespace boost { namespace geometry
 {
 
-// TODO: Waiting for errors handling design, eventually return bool
-// may be replaced to throw exception.
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkb
+{
 
-template <typename OutputIterator>
-bool hex2wkb(std::string const& hex, OutputIterator bytes)
+// Returns the value of a hexadecimal digit, or -1 for other characters
+inline int hex_digit_value(char c)
 {
-    // Bytes can be only written to output iterator.
-    BOOST_STATIC_ASSERT((boost::is_convertible<
-        typename std::iterator_traits<OutputIterator>::iterator_category,
-        const std::output_iterator_tag&>::value));
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
 
-    std::string::size_type const byte_size = 2;
-    if (0 != hex.size() % byte_size)
+template <typename OutputIterator>
+inline bool hex_to_bytes(char const* first, char const* last,
+                         OutputIterator bytes)
+{
+    if (0 != (last - first) % 2)
     {
         return false;
     }
 
-    std::string::size_type const size = hex.size() / byte_size;
-    for (std::string::size_type i = 0; i < size; ++i)
+    for (; first != last; first += 2)
     {
-        // TODO: This is confirmed performance killer - to be replaced with static char-to-byte map --mloskot
-        std::istringstream iss(hex.substr(i * byte_size, byte_size));
-        unsigned int byte(0);
-        if (!(iss >> std::hex >> byte))
+        int const high = hex_digit_value(first[0]);
+        int const low = hex_digit_value(first[1]);
+        if (high < 0 || low < 0)
         {
             return false;
         }
-        *bytes = static_cast<boost::uint8_t>(byte);
+        *bytes = static_cast<boost::uint8_t>((high << 4) | low);
         ++bytes;
     }
 
     return true;
 }
 
+}} // namespace detail::wkb
+#endif // DOXYGEN_NO_DETAIL
+
+// TODO: Waiting for errors handling design, eventually return bool
+// may be replaced to throw exception.
+
+template <typename OutputIterator>
+bool hex2wkb(std::string const& hex, OutputIterator bytes)
+{
+    // Bytes can be only written to output iterator.
+    BOOST_STATIC_ASSERT((boost::is_convertible<
+        typename std::iterator_traits<OutputIterator>::iterator_category,
+        const std::output_iterator_tag&>::value));
+
+    char const* const first = hex.data();
+    return detail::wkb::hex_to_bytes(first, first + hex.size(), bytes);
+}
+
 template <typename Iterator>
 bool wkb2hex(Iterator begin, Iterator end, std::string& hex)
 {
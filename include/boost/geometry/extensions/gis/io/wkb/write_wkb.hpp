@@ -14,6 +14,13 @@
 #include <boost/type_traits/is_convertible.hpp>
 #include <boost/static_assert.hpp>
 
+#include <boost/cstdint.hpp>
+#include <boost/range.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <boost/variant/variant_fwd.hpp>
+
+#include <boost/geometry/core/tag.hpp>
 #include <boost/geometry/core/tags.hpp>
 #include <boost/geometry/extensions/gis/io/wkb/detail/writer.hpp>
 
@@ -33,10 +40,11 @@ template <typename G>
 struct write_wkb<point_tag, G>
 {
     template <typename OutputIterator>
-    static inline bool write(const G& geometry, OutputIterator iter,
-                       detail::wkb::byte_order_type::enum_t byte_order)
+    static inline bool write(const G& geometry, OutputIterator& iter,
+                       detail::wkb::byte_order_type::enum_t byte_order,
+                       detail::wkb::writer_options const& options)
     {
-        return detail::wkb::point_writer<G>::write(geometry, iter, byte_order);
+        return detail::wkb::point_writer<G>::write(geometry, iter, byte_order, options);
     }
 };
 
@@ -44,10 +52,11 @@ template <typename G>
 struct write_wkb<linestring_tag, G>
 {
     template <typename OutputIterator>
-    static inline bool write(const G& geometry, OutputIterator iter,
-                       detail::wkb::byte_order_type::enum_t byte_order)
+    static inline bool write(const G& geometry, OutputIterator& iter,
+                       detail::wkb::byte_order_type::enum_t byte_order,
+                       detail::wkb::writer_options const& options)
     {
-        return detail::wkb::linestring_writer<G>::write(geometry, iter, byte_order);
+        return detail::wkb::linestring_writer<G>::write(geometry, iter, byte_order, options);
     }
 };
 
@@ -55,18 +64,149 @@ template <typename G>
 struct write_wkb<polygon_tag, G>
 {
     template <typename OutputIterator>
-    static inline bool write(const G& geometry, OutputIterator iter,
-                       detail::wkb::byte_order_type::enum_t byte_order)
+    static inline bool write(const G& geometry, OutputIterator& iter,
+                       detail::wkb::byte_order_type::enum_t byte_order,
+                       detail::wkb::writer_options const& options)
+    {
+        return detail::wkb::polygon_writer<G>::write(geometry, iter, byte_order, options);
+    }
+};
+
+template <typename G>
+struct write_wkb<multi_point_tag, G>
+{
+    template <typename OutputIterator>
+    static inline bool write(const G& geometry, OutputIterator& iter,
+                       detail::wkb::byte_order_type::enum_t byte_order,
+                       detail::wkb::writer_options const& options)
+    {
+        return detail::wkb::multi_point_writer<G>::write(geometry, iter, byte_order, options);
+    }
+};
+
+template <typename G>
+struct write_wkb<multi_linestring_tag, G>
+{
+    template <typename OutputIterator>
+    static inline bool write(const G& geometry, OutputIterator& iter,
+                       detail::wkb::byte_order_type::enum_t byte_order,
+                       detail::wkb::writer_options const& options)
+    {
+        return detail::wkb::multi_linestring_writer<G>::write(geometry, iter, byte_order, options);
+    }
+};
+
+template <typename G>
+struct write_wkb<multi_polygon_tag, G>
+{
+    template <typename OutputIterator>
+    static inline bool write(const G& geometry, OutputIterator& iter,
+                       detail::wkb::byte_order_type::enum_t byte_order,
+                       detail::wkb::writer_options const& options)
+    {
+        return detail::wkb::multi_polygon_writer<G>::write(geometry, iter, byte_order, options);
+    }
+};
+
+template <typename Geometry>
+struct devarianted_write_wkb
+{
+    template <typename OutputIterator>
+    static inline bool write(Geometry const& geometry, OutputIterator& iter,
+                       detail::wkb::byte_order_type::enum_t byte_order,
+                       detail::wkb::writer_options const& options)
+    {
+        return write_wkb
+            <
+                typename tag<Geometry>::type,
+                Geometry
+            >::write(geometry, iter, byte_order, options);
+    }
+};
+
+template <BOOST_VARIANT_ENUM_PARAMS(typename T)>
+struct devarianted_write_wkb<variant<BOOST_VARIANT_ENUM_PARAMS(T)> >
+{
+    template <typename OutputIterator>
+    struct visitor: static_visitor<bool>
     {
-        return detail::wkb::polygon_writer<G>::write(geometry, iter, byte_order);
+        OutputIterator& m_iter;
+        detail::wkb::byte_order_type::enum_t m_byte_order;
+        detail::wkb::writer_options const& m_options;
+
+        visitor(OutputIterator& iter,
+                detail::wkb::byte_order_type::enum_t byte_order,
+                detail::wkb::writer_options const& options)
+            : m_iter(iter)
+            , m_byte_order(byte_order)
+            , m_options(options)
+        {}
+
+        template <typename Geometry>
+        inline bool operator()(Geometry const& geometry) const
+        {
+            return devarianted_write_wkb<Geometry>::write(geometry, m_iter,
+                        m_byte_order, m_options);
+        }
+    };
+
+    template <typename OutputIterator>
+    static inline bool write(variant<BOOST_VARIANT_ENUM_PARAMS(T)> const& geometry,
+                       OutputIterator& iter,
+                       detail::wkb::byte_order_type::enum_t byte_order,
+                       detail::wkb::writer_options const& options)
+    {
+        return boost::apply_visitor(
+            visitor<OutputIterator>(iter, byte_order, options), geometry);
+    }
+};
+
+// Geometry collections, the elements are written with their own headers,
+// the collection has no dimension of its own and is written as 2D
+template <typename Collection>
+struct write_wkb<geometry_collection_tag, Collection>
+{
+    template <typename OutputIterator>
+    static inline bool write(Collection const& collection, OutputIterator& iter,
+                       detail::wkb::byte_order_type::enum_t byte_order,
+                       detail::wkb::writer_options const& options)
+    {
+        typedef typename boost::range_value<Collection>::type element_type;
+
+        detail::wkb::header_writer::write(
+            detail::wkb::ogc_type<geometry_collection_tag>::value, 2,
+            iter, byte_order, options);
+
+        boost::uint32_t num_geometries = boost::size(collection);
+        detail::wkb::value_writer<boost::uint32_t>::write(num_geometries,
+            iter, byte_order);
+
+        for (typename boost::range_iterator<Collection const>::type
+                element_iter = boost::begin(collection);
+             element_iter != boost::end(collection);
+             ++element_iter)
+        {
+            if (!devarianted_write_wkb<element_type>::write(*element_iter,
+                    iter, byte_order, options.nested()))
+            {
+                return false;
+            }
+        }
+
+        return true;
     }
 };
 
 } // namespace dispatch
 #endif // DOXYGEN_NO_DISPATCH
 
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkb
+{
+
 template <typename G, typename OutputIterator>
-inline bool write_wkb(const G& geometry, OutputIterator iter)
+inline bool write_wkb(G const& geometry, OutputIterator iter,
+                      writer_options const& options)
 {
     // The WKB is written to an OutputIterator.
     BOOST_STATIC_ASSERT((
@@ -83,17 +223,54 @@ inline bool write_wkb(const G& geometry, OutputIterator iter)
         detail::wkb::byte_order_type::enum_t byte_order =  detail::wkb::byte_order_type::ndr;
 #endif
 
-    if
-        (!dispatch::write_wkb
-        <
-        typename tag<G>::type,
-        G
-        >::write(geometry, iter, byte_order))
-    {
-        return false;
-    }
+    return dispatch::devarianted_write_wkb<G>::write(geometry, iter,
+                byte_order, options);
+}
 
-    return true;
+}} // namespace detail::wkb
+#endif // DOXYGEN_NO_DETAIL
+
+/*!
+\brief Writes a geometry as OGC Well-Known Binary (\ref WKB)
+\ingroup wkb
+\details Points, linestrings, polygons, their multi versions, geometry
+    collections (ranges of variants) and variants are written in the native
+    byte order. Points with three dimensions are written with Z, points with
+    four dimensions with Z and M (ISO type codes).
+*/
+template <typename G, typename OutputIterator>
+inline bool write_wkb(const G& geometry, OutputIterator iter)
+{
+    return detail::wkb::write_wkb(geometry, iter, detail::wkb::writer_options());
+}
+
+/*!
+\brief Writes a geometry as PostGIS Extended WKB, without SRID
+\ingroup wkb
+\details As write_wkb(), with Z and M flagged in the high bits of the types.
+*/
+template <typename G, typename OutputIterator>
+inline bool write_ewkb(const G& geometry, OutputIterator iter)
+{
+    detail::wkb::writer_options options;
+    options.ewkb = true;
+    return detail::wkb::write_wkb(geometry, iter, options);
+}
+
+/*!
+\brief Writes a geometry as PostGIS Extended WKB, with the SRID in the
+    header of the geometry
+\ingroup wkb
+*/
+template <typename G, typename OutputIterator>
+inline bool write_ewkb(const G& geometry, OutputIterator iter,
+                       boost::uint32_t srid)
+{
+    detail::wkb::writer_options options;
+    options.ewkb = true;
+    options.has_srid = true;
+    options.srid = srid;
+    return detail::wkb::write_wkb(geometry, iter, options);
 }
 
 // 	template <typename G, typename OutputIterator>
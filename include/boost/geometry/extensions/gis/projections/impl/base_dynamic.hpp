@@ -9,6 +9,8 @@
 #ifndef BOOST_GEOMETRY_PROJECTIONS_IMPL_BASE_DYNAMIC_HPP
 #define BOOST_GEOMETRY_PROJECTIONS_IMPL_BASE_DYNAMIC_HPP
 
+#include <cmath>
+#include <cstddef>
 #include <string>
 
 
@@ -32,6 +34,9 @@ protected:
 
 public:
 
+    using projection<LL, XY>::forward;
+    using projection<LL, XY>::inverse;
+
     base_v_f(P const& params) : m_proj(params) {}
 
     virtual P const& params() const { return m_proj.params(); }
@@ -43,6 +48,14 @@ public:
         return m_proj.forward(ll, xy);
     }
 
+    // One virtual call for all points, the loop of the projection is inlined
+    virtual std::size_t forward(LL_T const* lon, LL_T const* lat, std::size_t ll_stride,
+                                XY_T* x, XY_T* y, std::size_t xy_stride,
+                                std::size_t count) const
+    {
+        return m_proj.forward(lon, lat, ll_stride, x, y, xy_stride, count);
+    }
+
     virtual void fwd(LL_T& lp_lon, LL_T& lp_lat, XY_T& xy_x, XY_T& xy_y) const
     {
         m_proj.fwd(lp_lon, lp_lat, xy_x, xy_y);
@@ -58,6 +71,18 @@ public:
         // exception?
     }
 
+    virtual std::size_t inverse(XY_T const* , XY_T const* , std::size_t ,
+                                LL_T* lon, LL_T* lat, std::size_t ll_stride,
+                                std::size_t count) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            lon[i * ll_stride] = HUGE_VAL;
+            lat[i * ll_stride] = HUGE_VAL;
+        }
+        return 0;
+    }
+
     virtual std::string name() const
     {
         return m_proj.name();
@@ -79,6 +104,8 @@ private:
 
 public :
 
+    using base_v_f<C, LL, XY, P>::inverse;
+
     base_v_fi(P const& params) : base_v_f<C, LL, XY, P>(params) {}
 
     virtual bool inverse(XY const& xy, LL& ll) const
@@ -90,6 +117,13 @@ public :
     {
         this->m_proj.inv(xy_x, xy_y, lp_lon, lp_lat);
     }
+
+    virtual std::size_t inverse(XY_T const* x, XY_T const* y, std::size_t xy_stride,
+                                LL_T* lon, LL_T* lat, std::size_t ll_stride,
+                                std::size_t count) const
+    {
+        return this->m_proj.inverse(x, y, xy_stride, lon, lat, ll_stride, count);
+    }
 };
 
 } // namespace detail
@@ -15,10 +15,12 @@
 #endif // defined(_MSC_VER)
 
 
+#include <cstddef>
 #include <string>
 
 #include <boost/geometry/extensions/gis/projections/impl/pj_fwd.hpp>
 #include <boost/geometry/extensions/gis/projections/impl/pj_inv.hpp>
+#include <boost/geometry/extensions/gis/projections/impl/pj_parallel.hpp>
 
 namespace boost { namespace geometry { namespace projections
 {
@@ -32,13 +34,23 @@ namespace detail
 template <typename Prj, typename LL, typename XY, typename P>
 struct base_t_f
 {
+protected:
+
+    // Some projections do not work with float -> wrong results
+    // TODO: make traits which select <double> from int/float/double and else selects T
+
+    //typedef typename geometry::coordinate_type<LL>::type LL_T;
+    //typedef typename geometry::coordinate_type<XY>::type XY_T;
+    typedef double LL_T;
+    typedef double XY_T;
+
 public:
 
     typedef LL geographic_point_type; ///< latlong point type
     typedef XY cartesian_point_type;  ///< xy point type
 
-    inline base_t_f(Prj const& prj, P const& params)
-        : m_par(params), m_prj(prj)
+    inline base_t_f(Prj const& , P const& params)
+        : m_par(params)
     {}
 
     inline P const& params() const { return m_par; }
@@ -49,7 +61,7 @@ public:
     {
         try
         {
-            pj_fwd(m_prj, m_par, lp, xy);
+            pj_fwd(prj(), m_par, lp, xy);
             return true;
         }
         catch(...)
@@ -58,6 +70,47 @@ public:
         }
     }
 
+    /// Forward projection of count points, the coordinates are read and
+    /// written with the given strides. Points which can't be projected are
+    /// set to HUGE_VAL. Returns the number of projected points
+    inline std::size_t forward(LL_T const* lon, LL_T const* lat, std::size_t ll_stride,
+                               XY_T* x, XY_T* y, std::size_t xy_stride,
+                               std::size_t count) const
+    {
+        return pj_fwd_n<LL, XY>(prj(), m_par, lon, lat, ll_stride,
+                                x, y, xy_stride, count);
+    }
+
+    /// Forward projection of count points stored in separate arrays
+    inline std::size_t forward(LL_T const* lon, LL_T const* lat,
+                               XY_T* x, XY_T* y, std::size_t count) const
+    {
+        return forward(lon, lat, 1, x, y, 1, count);
+    }
+
+    /// Forward projection of count points stored in interleaved arrays
+    inline std::size_t forward(LL_T const* lonlat, XY_T* xy, std::size_t count) const
+    {
+        return forward(lonlat, lonlat + 1, 2, xy, xy + 1, 2, count);
+    }
+
+    /// Forward projection of count points stored in separate arrays, in parallel
+    inline std::size_t forward(LL_T const* lon, LL_T const* lat,
+                               XY_T* x, XY_T* y, std::size_t count,
+                               geometry::parallel const& policy) const
+    {
+        return pj_parallel_n<true>(*this, lon, lat, 1, x, y, 1, count,
+                    geometry::detail::parallel::threads_count(policy));
+    }
+
+    /// Forward projection of count points stored in interleaved arrays, in parallel
+    inline std::size_t forward(LL_T const* lonlat, XY_T* xy, std::size_t count,
+                               geometry::parallel const& policy) const
+    {
+        return pj_parallel_n<true>(*this, lonlat, lonlat + 1, 2, xy, xy + 1, 2,
+                    count, geometry::detail::parallel::threads_count(policy));
+    }
+
     inline std::string name() const
     {
         return this->m_par.name;
@@ -65,22 +118,24 @@ public:
 
 protected:
 
-    // Some projections do not work with float -> wrong results
-    // TODO: make traits which select <double> from int/float/double and else selects T
-
-    //typedef typename geometry::coordinate_type<LL>::type LL_T;
-    //typedef typename geometry::coordinate_type<XY>::type XY_T;
-    typedef double LL_T;
-    typedef double XY_T;
+    // The derived projection, not stored as a reference such that
+    // projections can be copied
+    inline Prj const& prj() const
+    {
+        return static_cast<Prj const&>(*this);
+    }
 
     P m_par;
-    const Prj& m_prj;
 };
 
 // Base-template-forward/inverse
 template <typename Prj, typename LL, typename XY, typename P>
 struct base_t_fi : public base_t_f<Prj, LL, XY, P>
 {
+private :
+    typedef typename base_t_f<Prj, LL, XY, P>::LL_T LL_T;
+    typedef typename base_t_f<Prj, LL, XY, P>::XY_T XY_T;
+
 public :
     inline base_t_fi(Prj const& prj, P const& params)
         : base_t_f<Prj, LL, XY, P>(prj, params)
@@ -90,7 +145,7 @@ public :
     {
         try
         {
-            pj_inv(this->m_prj, this->m_par, xy, lp);
+            pj_inv(this->prj(), this->m_par, xy, lp);
             return true;
         }
         catch(...)
@@ -98,6 +153,45 @@ public :
             return false;
         }
     }
+
+    /// Inverse projection of count points, see forward
+    inline std::size_t inverse(XY_T const* x, XY_T const* y, std::size_t xy_stride,
+                               LL_T* lon, LL_T* lat, std::size_t ll_stride,
+                               std::size_t count) const
+    {
+        return pj_inv_n<LL, XY>(this->prj(), this->m_par, x, y, xy_stride,
+                                lon, lat, ll_stride, count);
+    }
+
+    /// Inverse projection of count points stored in separate arrays
+    inline std::size_t inverse(XY_T const* x, XY_T const* y,
+                               LL_T* lon, LL_T* lat, std::size_t count) const
+    {
+        return inverse(x, y, 1, lon, lat, 1, count);
+    }
+
+    /// Inverse projection of count points stored in interleaved arrays
+    inline std::size_t inverse(XY_T const* xy, LL_T* lonlat, std::size_t count) const
+    {
+        return inverse(xy, xy + 1, 2, lonlat, lonlat + 1, 2, count);
+    }
+
+    /// Inverse projection of count points stored in separate arrays, in parallel
+    inline std::size_t inverse(XY_T const* x, XY_T const* y,
+                               LL_T* lon, LL_T* lat, std::size_t count,
+                               geometry::parallel const& policy) const
+    {
+        return pj_parallel_n<false>(*this, x, y, 1, lon, lat, 1, count,
+                    geometry::detail::parallel::threads_count(policy));
+    }
+
+    /// Inverse projection of count points stored in interleaved arrays, in parallel
+    inline std::size_t inverse(XY_T const* xy, LL_T* lonlat, std::size_t count,
+                               geometry::parallel const& policy) const
+    {
+        return pj_parallel_n<false>(*this, xy, xy + 1, 2, lonlat, lonlat + 1, 2,
+                    count, geometry::detail::parallel::threads_count(policy));
+    }
 };
 
 } // namespace detail
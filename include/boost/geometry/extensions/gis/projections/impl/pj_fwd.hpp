@@ -35,6 +35,10 @@
 #ifndef BOOST_GEOMETRY_PROJECTIONS_IMPL_PJ_FWD_HPP
 #define BOOST_GEOMETRY_PROJECTIONS_IMPL_PJ_FWD_HPP
 
+#include <cmath>
+#include <cstddef>
+
+#include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/radian_access.hpp>
 #include <boost/geometry/util/math.hpp>
 
@@ -93,6 +97,44 @@ inline void pj_fwd(Prj const& prj, P const& par, LL const& ll, XY& xy)
     geometry::set<1>(xy, par.fr_meter * (par.a * y + par.y0));
 }
 
+/* forward projection of count points, the coordinates are read and written
+   with the given strides (1 for separate arrays, 2 for interleaved ones).
+   Points which can't be projected are set to HUGE_VAL. Returns the number
+   of projected points */
+template <typename LL, typename XY, typename Prj, typename P>
+inline std::size_t pj_fwd_n(Prj const& prj, P const& par,
+            double const* lon, double const* lat, std::size_t ll_stride,
+            double* x, double* y, std::size_t xy_stride, std::size_t count)
+{
+    std::size_t projected = 0;
+    std::size_t i = 0;
+    while (i < count)
+    {
+        // The try block is entered again only after a failing point
+        try
+        {
+            for ( ; i < count; ++i)
+            {
+                LL ll;
+                geometry::set<0>(ll, lon[i * ll_stride]);
+                geometry::set<1>(ll, lat[i * ll_stride]);
+                XY xy;
+                pj_fwd(prj, par, ll, xy);
+                x[i * xy_stride] = geometry::get<0>(xy);
+                y[i * xy_stride] = geometry::get<1>(xy);
+                ++projected;
+            }
+        }
+        catch (...)
+        {
+            x[i * xy_stride] = HUGE_VAL;
+            y[i * xy_stride] = HUGE_VAL;
+            ++i;
+        }
+    }
+    return projected;
+}
+
 } // namespace detail
 }}} // namespace boost::geometry::projections
 
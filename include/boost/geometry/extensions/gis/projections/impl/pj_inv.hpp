@@ -37,7 +37,12 @@
 
 
 
+#include <cmath>
+#include <cstddef>
+
 #include <boost/geometry/extensions/gis/projections/impl/adjlon.hpp>
+#include <boost/geometry/extensions/gis/projections/impl/projects.hpp>
+#include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/radian_access.hpp>
 #include <boost/geometry/util/math.hpp>
 
@@ -74,6 +79,40 @@ inline void pj_inv(PRJ const& prj, PAR const& par, XY const& xy, LL& ll)
     geometry::set_from_radian<1>(ll, lat);
 }
 
+/* inverse projection of count points, see pj_fwd_n */
+template <typename LL, typename XY, typename PRJ, typename PAR>
+inline std::size_t pj_inv_n(PRJ const& prj, PAR const& par,
+            double const* x, double const* y, std::size_t xy_stride,
+            double* lon, double* lat, std::size_t ll_stride, std::size_t count)
+{
+    std::size_t projected = 0;
+    std::size_t i = 0;
+    while (i < count)
+    {
+        try
+        {
+            for ( ; i < count; ++i)
+            {
+                XY xy;
+                geometry::set<0>(xy, x[i * xy_stride]);
+                geometry::set<1>(xy, y[i * xy_stride]);
+                LL ll;
+                pj_inv(prj, par, xy, ll);
+                lon[i * ll_stride] = geometry::get<0>(ll);
+                lat[i * ll_stride] = geometry::get<1>(ll);
+                ++projected;
+            }
+        }
+        catch (...)
+        {
+            lon[i * ll_stride] = HUGE_VAL;
+            lat[i * ll_stride] = HUGE_VAL;
+            ++i;
+        }
+    }
+    return projected;
+}
+
 } // namespace detail
 }}} // namespace boost::geometry::projections
 
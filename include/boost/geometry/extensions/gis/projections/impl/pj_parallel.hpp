@@ -0,0 +1,125 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_PROJECTIONS_IMPL_PJ_PARALLEL_HPP
+#define BOOST_GEOMETRY_PROJECTIONS_IMPL_PJ_PARALLEL_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include <boost/geometry/util/parallel.hpp>
+
+
+namespace boost { namespace geometry { namespace projections
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail
+{
+
+// Number of points projected by one task
+static const std::size_t parallel_chunk_size = 4096;
+
+template <bool Forward>
+struct pj_batch
+{
+    template <typename Projection>
+    static inline std::size_t apply(Projection const& prj,
+            double const* in1, double const* in2, std::size_t in_stride,
+            double* out1, double* out2, std::size_t out_stride,
+            std::size_t count)
+    {
+        return prj.forward(in1, in2, in_stride, out1, out2, out_stride, count);
+    }
+};
+
+template <>
+struct pj_batch<false>
+{
+    template <typename Projection>
+    static inline std::size_t apply(Projection const& prj,
+            double const* in1, double const* in2, std::size_t in_stride,
+            double* out1, double* out2, std::size_t out_stride,
+            std::size_t count)
+    {
+        return prj.inverse(in1, in2, in_stride, out1, out2, out_stride, count);
+    }
+};
+
+// Projects one chunk of the arrays by calling the batch forward or inverse
+// projection of Projection, stores the number of projected points
+template <typename Projection, bool Forward>
+class pj_chunks
+{
+public :
+    inline pj_chunks(Projection const& prj,
+            double const* in1, double const* in2, std::size_t in_stride,
+            double* out1, double* out2, std::size_t out_stride,
+            std::size_t count, std::vector<std::size_t>& projected)
+        : m_prj(prj)
+        , m_in1(in1), m_in2(in2), m_in_stride(in_stride)
+        , m_out1(out1), m_out2(out2), m_out_stride(out_stride)
+        , m_count(count)
+        , m_projected(projected)
+    {}
+
+    inline void operator()(std::size_t chunk) const
+    {
+        std::size_t const first = chunk * parallel_chunk_size;
+        std::size_t const n = (std::min)(parallel_chunk_size, m_count - first);
+        std::size_t const in = first * m_in_stride;
+        std::size_t const out = first * m_out_stride;
+
+        m_projected[chunk] = pj_batch<Forward>::apply(m_prj,
+                    m_in1 + in, m_in2 + in, m_in_stride,
+                    m_out1 + out, m_out2 + out, m_out_stride, n);
+    }
+
+private :
+    Projection const& m_prj;
+    double const* m_in1;
+    double const* m_in2;
+    std::size_t m_in_stride;
+    double* m_out1;
+    double* m_out2;
+    std::size_t m_out_stride;
+    std::size_t m_count;
+    std::vector<std::size_t>& m_projected;
+};
+
+// Projects the arrays in chunks, concurrently if more threads are used.
+// The batch projections are const and don't modify shared state so the
+// chunks are independent.
+template <bool Forward, typename Projection>
+inline std::size_t pj_parallel_n(Projection const& prj,
+            double const* in1, double const* in2, std::size_t in_stride,
+            double* out1, double* out2, std::size_t out_stride,
+            std::size_t count, std::size_t threads)
+{
+    std::size_t const chunks
+        = (count + parallel_chunk_size - 1) / parallel_chunk_size;
+    std::vector<std::size_t> projected(chunks, 0);
+
+    pj_chunks<Projection, Forward> f(prj, in1, in2, in_stride,
+                                     out1, out2, out_stride,
+                                     count, projected);
+    geometry::detail::parallel::for_each_index(chunks, f, threads);
+
+    return std::accumulate(projected.begin(), projected.end(), std::size_t(0));
+}
+
+} // namespace detail
+#endif // DOXYGEN_NO_DETAIL
+
+}}} // namespace boost::geometry::projections
+
+
+#endif // BOOST_GEOMETRY_PROJECTIONS_IMPL_PJ_PARALLEL_HPP
@@ -0,0 +1,221 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// This file is manually converted from PROJ4
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// This file is converted from PROJ4, http://trac.osgeo.org/proj
+// PROJ4 is originally written by Gerald Evenden (then of the USGS)
+// PROJ4 is maintained by Frank Warmerdam
+// PROJ4 is converted to Geometry Library by Barend Gehrels (Geodan, Amsterdam)
+
+// Original copyright notice:
+
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef BOOST_GEOMETRY_PROJECTIONS_IMPL_PJ_TRANSFORM_HPP
+#define BOOST_GEOMETRY_PROJECTIONS_IMPL_PJ_TRANSFORM_HPP
+
+
+#include <cmath>
+
+#include <boost/geometry/util/math.hpp>
+
+#include <boost/geometry/extensions/gis/projections/impl/projects.hpp>
+
+/* datum shift of geodetic coordinates, via geocentric coordinates */
+
+namespace boost { namespace geometry { namespace projections {
+
+namespace detail {
+
+namespace geocent
+{
+    static const double genau = 1.e-12;
+    static const double genau2 = genau * genau;
+    static const int maxiter = 30;
+
+    /* WGS84 ellipsoid, es = f * (2 - f) with f = 1 / 298.257223563 */
+    static const double wgs84_a = 6378137.0;
+    static const double wgs84_es = 0.0066943799901413165;
+}
+
+/* geodetic (radians, height in meters) to geocentric coordinates */
+inline void pj_geodetic_to_geocentric(double a, double es,
+            double lon, double lat, double h,
+            double& x, double& y, double& z)
+{
+    /* don't blow up if latitude is just a little out of the valid range */
+    if (lat < -geometry::math::half_pi<double>())
+    {
+        lat = -geometry::math::half_pi<double>();
+    }
+    else if (lat > geometry::math::half_pi<double>())
+    {
+        lat = geometry::math::half_pi<double>();
+    }
+
+    double const sin_lat = sin(lat);
+    double const cos_lat = cos(lat);
+    /* earth radius at location */
+    double const rn = a / sqrt(1.0 - es * sin_lat * sin_lat);
+
+    x = (rn + h) * cos_lat * cos(lon);
+    y = (rn + h) * cos_lat * sin(lon);
+    z = ((rn * (1 - es)) + h) * sin_lat;
+}
+
+/* geocentric to geodetic coordinates, iteratively as in PROJ4 */
+inline void pj_geocentric_to_geodetic(double a, double es,
+            double x, double y, double z,
+            double& lon, double& lat, double& h)
+{
+    double const b = es == 0.0 ? a : a * sqrt(1 - es);
+
+    /* distance between semi-minor axis and location */
+    double const p = sqrt(x * x + y * y);
+    /* distance between center and location */
+    double const rr = sqrt(x * x + y * y + z * z);
+
+    if (p / a < geocent::genau)
+    {
+        /* special case, latitude is +/- 90 degrees */
+        lon = 0.;
+        if (rr / a < geocent::genau)
+        {
+            lat = geometry::math::half_pi<double>();
+            h = -b;
+            return;
+        }
+    }
+    else
+    {
+        lon = atan2(y, x);
+    }
+
+    /* sin and cos of the geocentric latitude */
+    double const ct = z / rr;
+    double const st = p / rr;
+    double rx = 1.0 / sqrt(1.0 - es * (2.0 - es) * st * st);
+    double cphi0 = st * (1.0 - es) * rx;
+    double sphi0 = ct * rx;
+    double cphi = cphi0;
+    double sphi = sphi0;
+    double sdphi = 0;
+
+    /* loop to find sin and cos of the geodetic latitude */
+    int iter = 0;
+    do
+    {
+        iter++;
+        double const rn = a / sqrt(1.0 - es * sphi0 * sphi0);
+        h = p * cphi0 + z * sphi0 - rn * (1.0 - es * sphi0 * sphi0);
+
+        double const rk = es * rn / (rn + h);
+        rx = 1.0 / sqrt(1.0 - rk * (2.0 - rk) * st * st);
+        cphi = st * (1.0 - rk) * rx;
+        sphi = ct * rx;
+        sdphi = sphi * cphi0 - cphi * sphi0;
+        cphi0 = cphi;
+        sphi0 = sphi;
+    }
+    while (sdphi * sdphi > geocent::genau2 && iter < geocent::maxiter);
+
+    lat = atan(sphi / geometry::math::abs(cphi));
+}
+
+/* geocentric coordinates of the datum of par to WGS84 (towgs84) */
+template <typename PAR>
+inline void pj_geocentric_to_wgs84(PAR const& par, double& x, double& y, double& z)
+{
+    double const* const p = par.datum_params;
+    if (par.datum_type == PJD_3PARAM)
+    {
+        x += p[0];
+        y += p[1];
+        z += p[2];
+    }
+    else if (par.datum_type == PJD_7PARAM)
+    {
+        double const x_out = p[6] * (       x - p[5] * y + p[4] * z) + p[0];
+        double const y_out = p[6] * ( p[5] * x +       y - p[3] * z) + p[1];
+        double const z_out = p[6] * (-p[4] * x + p[3] * y +       z) + p[2];
+        x = x_out;
+        y = y_out;
+        z = z_out;
+    }
+}
+
+/* geocentric coordinates of WGS84 to the datum of par */
+template <typename PAR>
+inline void pj_geocentric_from_wgs84(PAR const& par, double& x, double& y, double& z)
+{
+    double const* const p = par.datum_params;
+    if (par.datum_type == PJD_3PARAM)
+    {
+        x -= p[0];
+        y -= p[1];
+        z -= p[2];
+    }
+    else if (par.datum_type == PJD_7PARAM)
+    {
+        double const x_tmp = (x - p[0]) / p[6];
+        double const y_tmp = (y - p[1]) / p[6];
+        double const z_tmp = (z - p[2]) / p[6];
+        x =         x_tmp + p[5] * y_tmp - p[4] * z_tmp;
+        y = -p[5] * x_tmp +        y_tmp + p[3] * z_tmp;
+        z =  p[4] * x_tmp - p[3] * y_tmp +        z_tmp;
+    }
+}
+
+/* true if the datum of par is shifted with respect to WGS84 */
+template <typename PAR>
+inline bool pj_datum_shifted(PAR const& par)
+{
+    return par.datum_type == PJD_3PARAM || par.datum_type == PJD_7PARAM;
+}
+
+/* shifts geodetic coordinates (radians) from WGS84 to the datum of par,
+   which has the original ellipsoid of par */
+template <typename PAR>
+inline void pj_datum_from_wgs84(PAR const& par, double& lon, double& lat)
+{
+    double x, y, z, h;
+    pj_geodetic_to_geocentric(geocent::wgs84_a, geocent::wgs84_es, lon, lat, 0.0, x, y, z);
+    pj_geocentric_from_wgs84(par, x, y, z);
+    pj_geocentric_to_geodetic(par.a_orig, par.es_orig, x, y, z, lon, lat, h);
+}
+
+/* shifts geodetic coordinates (radians) from the datum of par to WGS84 */
+template <typename PAR>
+inline void pj_datum_to_wgs84(PAR const& par, double& lon, double& lat)
+{
+    double x, y, z, h;
+    pj_geodetic_to_geocentric(par.a_orig, par.es_orig, lon, lat, 0.0, x, y, z);
+    pj_geocentric_to_wgs84(par, x, y, z);
+    pj_geocentric_to_geodetic(geocent::wgs84_a, geocent::wgs84_es, x, y, z, lon, lat, h);
+}
+
+} // namespace detail
+}}} // namespace boost::geometry::projections
+
+#endif // BOOST_GEOMETRY_PROJECTIONS_IMPL_PJ_TRANSFORM_HPP
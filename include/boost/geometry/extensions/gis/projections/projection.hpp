@@ -10,8 +10,13 @@
 #define BOOST_GEOMETRY_PROJECTIONS_PROJECTION_HPP
 
 
+#include <cmath>
+#include <cstddef>
 #include <string>
+
+#include <boost/geometry/core/access.hpp>
 #include <boost/geometry/extensions/gis/projections/impl/projects.hpp>
+#include <boost/geometry/extensions/gis/projections/impl/pj_parallel.hpp>
 
 namespace boost { namespace geometry { namespace projections
 {
@@ -51,6 +56,124 @@ class projection
         /// Inverse projection using x / y and lon / lat
         virtual void inv(XY_T& xy_x, XY_T& xy_y, LL_T& lp_lon, LL_T& lp_lat) const = 0;
 
+        /// Forward projection of count points, the coordinates are read and
+        /// written with the given strides. Points which can't be projected
+        /// are set to HUGE_VAL. Returns the number of projected points
+        virtual std::size_t forward(LL_T const* lon, LL_T const* lat, std::size_t ll_stride,
+                                    XY_T* x, XY_T* y, std::size_t xy_stride,
+                                    std::size_t count) const
+        {
+            std::size_t projected = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                LL ll;
+                geometry::set<0>(ll, lon[i * ll_stride]);
+                geometry::set<1>(ll, lat[i * ll_stride]);
+                XY xy;
+                if (forward(ll, xy))
+                {
+                    x[i * xy_stride] = geometry::get<0>(xy);
+                    y[i * xy_stride] = geometry::get<1>(xy);
+                    ++projected;
+                }
+                else
+                {
+                    x[i * xy_stride] = HUGE_VAL;
+                    y[i * xy_stride] = HUGE_VAL;
+                }
+            }
+            return projected;
+        }
+
+        /// Inverse projection of count points, see forward
+        virtual std::size_t inverse(XY_T const* x, XY_T const* y, std::size_t xy_stride,
+                                    LL_T* lon, LL_T* lat, std::size_t ll_stride,
+                                    std::size_t count) const
+        {
+            std::size_t projected = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                XY xy;
+                geometry::set<0>(xy, x[i * xy_stride]);
+                geometry::set<1>(xy, y[i * xy_stride]);
+                LL ll;
+                if (inverse(xy, ll))
+                {
+                    lon[i * ll_stride] = geometry::get<0>(ll);
+                    lat[i * ll_stride] = geometry::get<1>(ll);
+                    ++projected;
+                }
+                else
+                {
+                    lon[i * ll_stride] = HUGE_VAL;
+                    lat[i * ll_stride] = HUGE_VAL;
+                }
+            }
+            return projected;
+        }
+
+        /// Forward projection of count points stored in separate arrays
+        std::size_t forward(LL_T const* lon, LL_T const* lat,
+                            XY_T* x, XY_T* y, std::size_t count) const
+        {
+            return forward(lon, lat, 1, x, y, 1, count);
+        }
+
+        /// Forward projection of count points stored in interleaved arrays
+        std::size_t forward(LL_T const* lonlat, XY_T* xy, std::size_t count) const
+        {
+            return forward(lonlat, lonlat + 1, 2, xy, xy + 1, 2, count);
+        }
+
+        /// Forward projection of count points stored in separate arrays, in parallel
+        std::size_t forward(LL_T const* lon, LL_T const* lat,
+                            XY_T* x, XY_T* y, std::size_t count,
+                            geometry::parallel const& policy) const
+        {
+            return detail::pj_parallel_n<true>(*this, lon, lat, 1, x, y, 1, count,
+                        geometry::detail::parallel::threads_count(policy));
+        }
+
+        /// Forward projection of count points stored in interleaved arrays, in parallel
+        std::size_t forward(LL_T const* lonlat, XY_T* xy, std::size_t count,
+                            geometry::parallel const& policy) const
+        {
+            return detail::pj_parallel_n<true>(*this, lonlat, lonlat + 1, 2,
+                        xy, xy + 1, 2, count,
+                        geometry::detail::parallel::threads_count(policy));
+        }
+
+        /// Inverse projection of count points stored in separate arrays
+        std::size_t inverse(XY_T const* x, XY_T const* y,
+                            LL_T* lon, LL_T* lat, std::size_t count) const
+        {
+            return inverse(x, y, 1, lon, lat, 1, count);
+        }
+
+        /// Inverse projection of count points stored in interleaved arrays
+        std::size_t inverse(XY_T const* xy, LL_T* lonlat, std::size_t count) const
+        {
+            return inverse(xy, xy + 1, 2, lonlat, lonlat + 1, 2, count);
+        }
+
+        /// Inverse projection of count points stored in separate arrays, in parallel
+        std::size_t inverse(XY_T const* x, XY_T const* y,
+                            LL_T* lon, LL_T* lat, std::size_t count,
+                            geometry::parallel const& policy) const
+        {
+            return detail::pj_parallel_n<false>(*this, x, y, 1, lon, lat, 1, count,
+                        geometry::detail::parallel::threads_count(policy));
+        }
+
+        /// Inverse projection of count points stored in interleaved arrays, in parallel
+        std::size_t inverse(XY_T const* xy, LL_T* lonlat, std::size_t count,
+                            geometry::parallel const& policy) const
+        {
+            return detail::pj_parallel_n<false>(*this, xy, xy + 1, 2,
+                        lonlat, lonlat + 1, 2, count,
+                        geometry::detail::parallel::threads_count(policy));
+        }
+
         /// Returns name of projection
         virtual std::string name() const = 0;
 
@@ -0,0 +1,283 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_PROJECTIONS_STATIC_EPSG_HPP
+#define BOOST_GEOMETRY_PROJECTIONS_STATIC_EPSG_HPP
+
+
+#include <cstddef>
+
+#include <boost/geometry/core/radian_access.hpp>
+#include <boost/geometry/util/math.hpp>
+
+#include <boost/geometry/extensions/gis/projections/static_parameters.hpp>
+#include <boost/geometry/extensions/gis/projections/impl/pj_transform.hpp>
+
+#include <boost/geometry/extensions/gis/projections/proj/lcc.hpp>
+#include <boost/geometry/extensions/gis/projections/proj/merc.hpp>
+#include <boost/geometry/extensions/gis/projections/proj/sterea.hpp>
+#include <boost/geometry/extensions/gis/projections/proj/tmerc.hpp>
+
+// This file is OPTIONAL
+// Only to be included if projections are specified by EPSG codes at compile
+// time. The definitions correspond to the ones of epsg.hpp
+
+namespace boost { namespace geometry { namespace projections
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail
+{
+
+// UTM zones of WGS84 (north: 32601-32660, south: 32701-32760)
+// and ETRS89 (25828-25838)
+template
+<
+    std::size_t Code, typename LL, typename XY,
+    bool IsUtm = (Code > 32600 && Code <= 32660)
+              || (Code > 32700 && Code <= 32760)
+              || (Code >= 25828 && Code <= 25838)
+>
+struct static_epsg_utm
+{};
+
+template <std::size_t Code, typename LL, typename XY>
+struct static_epsg_utm<Code, LL, XY, true>
+{
+    typedef utm_ellipsoid<LL, XY, static_parameters> type;
+
+    static inline static_parameters par()
+    {
+        static_parameters par;
+        if (Code < 32600)
+        {
+            static_ellps_rf(par, 6378137.0, 298.257222101); // GRS80
+        }
+        else
+        {
+            static_ellps_rf(par, 6378137.0, 298.257223563); // WGS84
+            static_towgs84(par, 0, 0, 0);
+        }
+        static_origin(par, 0, 0, 1, 0, 0);
+        par.params.add("zone", 0, static_cast<int>(Code % 100));
+        if (Code > 32700)
+        {
+            par.params.add("south", 0, 1);
+        }
+        return par;
+    }
+};
+
+} // namespace detail
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+    \brief EPSG traits of projections initialized without parsing
+    \details Like epsg_traits, but the parameters are set by values instead
+        of parsed from a string, and the projection uses static_parameters.
+        Specializations exist for a selection of EPSG codes and for the UTM
+        zones of WGS84 and ETRS89, other codes can be added by specializing.
+    \ingroup projection
+    \tparam Code epsg code
+    \tparam LL latlong point type
+    \tparam XY xy point type
+*/
+template <std::size_t Code, typename LL, typename XY>
+struct static_epsg_traits : detail::static_epsg_utm<Code, LL, XY>
+{
+    // Specializations define:
+    // - type to get projection type
+    // - function par to get parameters
+};
+
+
+// RGF93 / Lambert-93
+template <typename LL, typename XY>
+struct static_epsg_traits<2154, LL, XY>
+{
+    typedef lcc_ellipsoid<LL, XY, static_parameters> type;
+    static inline static_parameters par()
+    {
+        static_parameters par;
+        detail::static_ellps_rf(par, 6378137.0, 298.257222101); // GRS80
+        detail::static_towgs84(par, 0, 0, 0, 0, 0, 0, 0);
+        detail::static_origin(par, 3, 46.5, 1, 700000, 6600000);
+        par.params.add("lat_1", 49 * geometry::math::d2r<double>());
+        par.params.add("lat_2", 44 * geometry::math::d2r<double>());
+        par.params.add("lat_0", par.phi0);
+        return par;
+    }
+};
+
+// NAD83(HARN) / Massachusetts Mainland
+template <typename LL, typename XY>
+struct static_epsg_traits<2805, LL, XY>
+{
+    typedef lcc_ellipsoid<LL, XY, static_parameters> type;
+    static inline static_parameters par()
+    {
+        static_parameters par;
+        detail::static_ellps_rf(par, 6378137.0, 298.257222101); // GRS80
+        detail::static_origin(par, -71.5, 41, 1, 200000, 750000);
+        par.params.add("lat_1", 42.68333333333333 * geometry::math::d2r<double>());
+        par.params.add("lat_2", 41.71666666666667 * geometry::math::d2r<double>());
+        par.params.add("lat_0", par.phi0);
+        return par;
+    }
+};
+
+// WGS 84 / World Mercator
+template <typename LL, typename XY>
+struct static_epsg_traits<3395, LL, XY>
+{
+    typedef merc_ellipsoid<LL, XY, static_parameters> type;
+    static inline static_parameters par()
+    {
+        static_parameters par;
+        detail::static_ellps_rf(par, 6378137.0, 298.257223563); // WGS84
+        detail::static_towgs84(par, 0, 0, 0);
+        detail::static_origin(par, 0, 0, 1, 0, 0);
+        return par;
+    }
+};
+
+// OSGB 1936 / British National Grid
+template <typename LL, typename XY>
+struct static_epsg_traits<27700, LL, XY>
+{
+    typedef tmerc_ellipsoid<LL, XY, static_parameters> type;
+    static inline static_parameters par()
+    {
+        static_parameters par;
+        detail::static_ellps_b(par, 6377563.396, 6356256.910); // airy
+        detail::static_towgs84(par, 446.448, -125.157, 542.060,
+                               0.1502, 0.2470, 0.8421, -20.4894); // OSGB36
+        detail::static_origin(par, -2, 49, 0.9996012717, 400000, -100000);
+        return par;
+    }
+};
+
+// Amersfoort / RD New
+template <typename LL, typename XY>
+struct static_epsg_traits<28992, LL, XY>
+{
+    typedef sterea_ellipsoid<LL, XY, static_parameters> type;
+    static inline static_parameters par()
+    {
+        static_parameters par;
+        detail::static_ellps_rf(par, 6377397.155, 299.1528128); // bessel
+        detail::static_origin(par, 5.38763888888889, 52.15616055555555,
+                              0.9999079, 155000, 463000);
+        return par;
+    }
+};
+
+// DHDN / Gauss-Kruger zone 3
+template <typename LL, typename XY>
+struct static_epsg_traits<31467, LL, XY>
+{
+    typedef tmerc_ellipsoid<LL, XY, static_parameters> type;
+    static inline static_parameters par()
+    {
+        static_parameters par;
+        detail::static_ellps_rf(par, 6377397.155, 299.1528128); // bessel
+        detail::static_towgs84(par, 606.0, 23.0, 413.0); // potsdam
+        detail::static_origin(par, 9, 0, 1, 3500000, 0);
+        return par;
+    }
+};
+
+
+/*!
+    \brief Projection of the coordinate system of an EPSG code, including
+        the datum shift from WGS84
+    \details The projection is created without the factory, without
+        allocating memory and without parsing strings, the forward and
+        inverse projections are inlined. If the datum of the coordinate
+        system has a shift to WGS84 (towgs84), the latlong points are in
+        WGS84 and shifted to the datum (via geocentric coordinates) before
+        they are projected, and back after the inverse projection.
+    \ingroup projection
+    \tparam Code epsg code, static_epsg_traits should be defined for it
+    \tparam LL latlong point type
+    \tparam XY xy point type
+*/
+template <std::size_t Code, typename LL, typename XY>
+class epsg_projector
+{
+public :
+    typedef static_epsg_traits<Code, LL, XY> traits_type;
+    typedef typename traits_type::type projection_type;
+
+    typedef LL geographic_point_type; ///< latlong point type
+    typedef XY cartesian_point_type;  ///< xy point type
+
+    inline epsg_projector()
+        : m_prj(traits_type::par())
+        , m_shifted(detail::pj_datum_shifted(m_prj.params()))
+    {}
+
+    /// Forward projection, from WGS84 Latitude-Longitude to Cartesian
+    inline bool forward(LL const& ll, XY& xy) const
+    {
+        if (! m_shifted)
+        {
+            return m_prj.forward(ll, xy);
+        }
+
+        double lon = geometry::get_as_radian<0>(ll);
+        double lat = geometry::get_as_radian<1>(ll);
+        if (geometry::math::abs(lat) > geometry::math::half_pi<double>() + 1e-12)
+        {
+            return false;
+        }
+        detail::pj_datum_from_wgs84(m_prj.params(), lon, lat);
+
+        LL shifted = ll;
+        geometry::set_from_radian<0>(shifted, lon);
+        geometry::set_from_radian<1>(shifted, lat);
+        return m_prj.forward(shifted, xy);
+    }
+
+    /// Inverse projection, from Cartesian to WGS84 Latitude-Longitude
+    inline bool inverse(XY const& xy, LL& ll) const
+    {
+        if (! m_prj.inverse(xy, ll))
+        {
+            return false;
+        }
+
+        if (m_shifted)
+        {
+            double lon = geometry::get_as_radian<0>(ll);
+            double lat = geometry::get_as_radian<1>(ll);
+            detail::pj_datum_to_wgs84(m_prj.params(), lon, lat);
+            geometry::set_from_radian<0>(ll, lon);
+            geometry::set_from_radian<1>(ll, lat);
+        }
+        return true;
+    }
+
+    /// Returns the projection, projecting the points of the datum of the
+    /// coordinate system
+    inline projection_type const& get_projection() const
+    {
+        return m_prj;
+    }
+
+private :
+    projection_type m_prj;
+    bool m_shifted;
+};
+
+
+}}} // namespace boost::geometry::projections
+
+
+#endif // BOOST_GEOMETRY_PROJECTIONS_STATIC_EPSG_HPP
@@ -0,0 +1,187 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_PROJECTIONS_STATIC_PARAMETERS_HPP
+#define BOOST_GEOMETRY_PROJECTIONS_STATIC_PARAMETERS_HPP
+
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include <boost/assert.hpp>
+
+#include <boost/geometry/util/math.hpp>
+
+#include <boost/geometry/extensions/gis/projections/impl/projects.hpp>
+
+
+namespace boost { namespace geometry { namespace projections
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail
+{
+
+// Value of a projection specific parameter, e.g. lat_1 of lcc. Angles are
+// stored in radians, as pj_param returns them
+struct static_pvalue
+{
+    char const* param;
+    int i;
+    double f;
+};
+
+// Fixed list of projection specific parameters
+struct static_pvalues
+{
+    static const std::size_t max_count = 4;
+
+    std::size_t count;
+    static_pvalue values[max_count];
+
+    inline static_pvalues()
+        : count(0)
+    {}
+
+    inline void add(char const* param, double f, int i = 0)
+    {
+        BOOST_ASSERT(count < max_count);
+        static_pvalue const value = { param, i, f };
+        values[count++] = value;
+    }
+};
+
+// Same as pj_param for the parameters read from a string, the values are
+// looked up by name only
+inline pvalue pj_param(static_pvalues const& pl, char const* opt)
+{
+    pvalue value;
+    value.i = 0;
+    value.f = 0.0;
+
+    for (std::size_t index = 0; index < pl.count; index++)
+    {
+        static_pvalue const& it = pl.values[index];
+        if (std::strcmp(it.param, opt + 1) == 0)
+        {
+            switch (opt[0])
+            {
+            case 't':
+                value.i = 1;
+                break;
+            case 'i': case 'b':
+                value.i = it.i;
+                break;
+            case 'd': case 'r':
+                value.f = it.f;
+                break;
+            }
+            return value;
+        }
+    }
+    return value;
+}
+
+} // namespace detail
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+    \brief Parameters of a projection specified by values
+    \details The parameters are set by the functions in this file instead of
+        by parsing a string (see init), they don't allocate memory. They can
+        be used as the Parameters type of the projections whose
+        initialization only reads numeric parameters.
+    \ingroup projection
+*/
+struct static_parameters : public detail::pj_const_pod
+{
+    detail::static_pvalues params;
+};
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail
+{
+
+// Sets the ellipsoid of the parameters like pj_ell_set and pj_init do
+inline void static_ellps(static_parameters& par, double a, double es)
+{
+    par.a = par.a_orig = a;
+    par.es = par.es_orig = es;
+    par.e = sqrt(es);
+    par.ra = 1. / a;
+    par.one_es = 1. - es;
+    par.rone_es = 1. / par.one_es;
+}
+
+// Ellipsoid specified by major axis and reciprocal flattening (rf=)
+inline void static_ellps_rf(static_parameters& par, double a, double rf)
+{
+    double const f = 1. / rf;
+    static_ellps(par, a, f * (2. - f));
+}
+
+// Ellipsoid specified by major and minor axis (b=)
+inline void static_ellps_b(static_parameters& par, double a, double b)
+{
+    static_ellps(par, a, 1. - (b * b) / (a * a));
+}
+
+// Sets lon_0 and lat_0 (in degrees), k_0, x_0 and y_0, and the units (m)
+inline void static_origin(static_parameters& par,
+            double lon_0, double lat_0, double k_0, double x_0, double y_0)
+{
+    par.lam0 = lon_0 * geometry::math::d2r<double>();
+    par.phi0 = lat_0 * geometry::math::d2r<double>();
+    par.k0 = k_0;
+    par.x0 = x_0;
+    par.y0 = y_0;
+    par.to_meter = par.fr_meter = 1.;
+}
+
+// Sets the datum shift to WGS84 like pj_datum_set, rotations are specified
+// in arc seconds and the scale in parts per million (towgs84=)
+inline void static_towgs84(static_parameters& par,
+            double dx, double dy, double dz,
+            double rx = 0., double ry = 0., double rz = 0., double ds = 0.)
+{
+    par.datum_params[0] = dx;
+    par.datum_params[1] = dy;
+    par.datum_params[2] = dz;
+    if (rx != 0. || ry != 0. || rz != 0. || ds != 0.)
+    {
+        double const sec_to_rad = geometry::math::d2r<double>() / 3600.;
+        par.datum_type = PJD_7PARAM;
+        par.datum_params[3] = rx * sec_to_rad;
+        par.datum_params[4] = ry * sec_to_rad;
+        par.datum_params[5] = rz * sec_to_rad;
+        par.datum_params[6] = ds / 1000000.0 + 1;
+    }
+    else if (dx == 0. && dy == 0. && dz == 0.
+        && par.a == 6378137.0
+        && geometry::math::abs(par.es - 0.006694379990) < 0.000000000050)
+    {
+        // Check of pj_init, the ellipsoid is WGS84 or GRS80
+        par.datum_type = PJD_WGS84;
+    }
+    else
+    {
+        par.datum_type = PJD_3PARAM;
+    }
+}
+
+} // namespace detail
+#endif // DOXYGEN_NO_DETAIL
+
+
+}}} // namespace boost::geometry::projections
+
+
+#endif // BOOST_GEOMETRY_PROJECTIONS_STATIC_PARAMETERS_HPP
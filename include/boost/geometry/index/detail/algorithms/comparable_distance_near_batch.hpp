@@ -0,0 +1,394 @@
+// Boost.Geometry Index
+//
+// squared distances between a point and the nearest points of several boxes
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_COMPARABLE_DISTANCE_NEAR_BATCH_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_COMPARABLE_DISTANCE_NEAR_BATCH_HPP
+
+#include <cstddef>
+
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_system.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/cs.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/strategies/default_comparable_distance_result.hpp>
+
+#include <boost/geometry/index/detail/assert.hpp>
+#include <boost/geometry/index/detail/predicates.hpp>
+#include <boost/geometry/index/detail/tags.hpp>
+
+// The kernels use SSE2 or AVX if the compiler targets them, otherwise the
+// boxes are processed one by one. BOOST_GEOMETRY_INDEX_NO_SIMD disables the
+// intrinsics.
+#if !defined(BOOST_GEOMETRY_INDEX_NO_SIMD)
+#  if defined(__AVX__)
+#    define BOOST_GEOMETRY_INDEX_SIMD_AVX
+#    include <immintrin.h>
+#  elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define BOOST_GEOMETRY_INDEX_SIMD_SSE2
+#    include <emmintrin.h>
+#  endif
+#endif
+
+namespace boost { namespace geometry { namespace index { namespace detail {
+
+namespace near_batch {
+
+// Maximum number of boxes processed at once, a multiple of the number of
+// lanes of all kernels
+static const std::size_t max_count = 16;
+
+// Coordinates of the boxes stored dimension by dimension (SoA), the lanes
+// above the count are padded with the coordinates of the point
+template <typename T, std::size_t Dimension>
+struct boxes
+{
+    T min_corner[Dimension][max_count];
+    T max_corner[Dimension][max_count];
+};
+
+// The squared distances are summed from the last dimension to the first one,
+// as in pythagoras_point_box, so the results are equal to the ones of
+// geometry::comparable_distance()
+template <typename T>
+struct kernel
+{
+    template <std::size_t Dimension>
+    static inline void apply(T const (&pt)[Dimension],
+                             boxes<T, Dimension> const& b,
+                             std::size_t count, T * result)
+    {
+        for ( std::size_t i = 0 ; i < count ; ++i )
+        {
+            T r = 0;
+            for ( std::size_t d = Dimension ; d-- > 0 ; )
+            {
+                T diff = 0;
+                if ( pt[d] < b.min_corner[d][i] )
+                    diff = b.min_corner[d][i] - pt[d];
+                else if ( b.max_corner[d][i] < pt[d] )
+                    diff = pt[d] - b.max_corner[d][i];
+                r += diff * diff;
+            }
+            result[i] = r;
+        }
+    }
+};
+
+#if defined(BOOST_GEOMETRY_INDEX_SIMD_AVX)
+
+template <>
+struct kernel<double>
+{
+    template <std::size_t Dimension>
+    static inline void apply(double const (&pt)[Dimension],
+                             boxes<double, Dimension> const& b,
+                             std::size_t count, double * result)
+    {
+        __m256d const zero = _mm256_setzero_pd();
+        for ( std::size_t i = 0 ; i < count ; i += 4 )
+        {
+            __m256d r = zero;
+            for ( std::size_t d = Dimension ; d-- > 0 ; )
+            {
+                __m256d const p = _mm256_set1_pd(pt[d]);
+                __m256d const below = _mm256_max_pd(_mm256_sub_pd(_mm256_loadu_pd(&b.min_corner[d][i]), p), zero);
+                __m256d const above = _mm256_max_pd(_mm256_sub_pd(p, _mm256_loadu_pd(&b.max_corner[d][i])), zero);
+                __m256d const diff = _mm256_add_pd(below, above);
+                r = _mm256_add_pd(r, _mm256_mul_pd(diff, diff));
+            }
+            _mm256_storeu_pd(result + i, r);
+        }
+    }
+};
+
+template <>
+struct kernel<float>
+{
+    template <std::size_t Dimension>
+    static inline void apply(float const (&pt)[Dimension],
+                             boxes<float, Dimension> const& b,
+                             std::size_t count, float * result)
+    {
+        __m256 const zero = _mm256_setzero_ps();
+        for ( std::size_t i = 0 ; i < count ; i += 8 )
+        {
+            __m256 r = zero;
+            for ( std::size_t d = Dimension ; d-- > 0 ; )
+            {
+                __m256 const p = _mm256_set1_ps(pt[d]);
+                __m256 const below = _mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(&b.min_corner[d][i]), p), zero);
+                __m256 const above = _mm256_max_ps(_mm256_sub_ps(p, _mm256_loadu_ps(&b.max_corner[d][i])), zero);
+                __m256 const diff = _mm256_add_ps(below, above);
+                r = _mm256_add_ps(r, _mm256_mul_ps(diff, diff));
+            }
+            _mm256_storeu_ps(result + i, r);
+        }
+    }
+};
+
+#elif defined(BOOST_GEOMETRY_INDEX_SIMD_SSE2)
+
+template <>
+struct kernel<double>
+{
+    template <std::size_t Dimension>
+    static inline void apply(double const (&pt)[Dimension],
+                             boxes<double, Dimension> const& b,
+                             std::size_t count, double * result)
+    {
+        __m128d const zero = _mm_setzero_pd();
+        for ( std::size_t i = 0 ; i < count ; i += 2 )
+        {
+            __m128d r = zero;
+            for ( std::size_t d = Dimension ; d-- > 0 ; )
+            {
+                __m128d const p = _mm_set1_pd(pt[d]);
+                __m128d const below = _mm_max_pd(_mm_sub_pd(_mm_loadu_pd(&b.min_corner[d][i]), p), zero);
+                __m128d const above = _mm_max_pd(_mm_sub_pd(p, _mm_loadu_pd(&b.max_corner[d][i])), zero);
+                __m128d const diff = _mm_add_pd(below, above);
+                r = _mm_add_pd(r, _mm_mul_pd(diff, diff));
+            }
+            _mm_storeu_pd(result + i, r);
+        }
+    }
+};
+
+template <>
+struct kernel<float>
+{
+    template <std::size_t Dimension>
+    static inline void apply(float const (&pt)[Dimension],
+                             boxes<float, Dimension> const& b,
+                             std::size_t count, float * result)
+    {
+        __m128 const zero = _mm_setzero_ps();
+        for ( std::size_t i = 0 ; i < count ; i += 4 )
+        {
+            __m128 r = zero;
+            for ( std::size_t d = Dimension ; d-- > 0 ; )
+            {
+                __m128 const p = _mm_set1_ps(pt[d]);
+                __m128 const below = _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&b.min_corner[d][i]), p), zero);
+                __m128 const above = _mm_max_ps(_mm_sub_ps(p, _mm_loadu_ps(&b.max_corner[d][i])), zero);
+                __m128 const diff = _mm_add_ps(below, above);
+                r = _mm_add_ps(r, _mm_mul_ps(diff, diff));
+            }
+            _mm_storeu_ps(result + i, r);
+        }
+    }
+};
+
+#endif
+
+template <typename Box, std::size_t I, std::size_t Dimension>
+struct load_box
+{
+    template <typename T>
+    static inline void apply(Box const& b, boxes<T, Dimension> & bs, std::size_t i)
+    {
+        bs.min_corner[I][i] = static_cast<T>(geometry::get<geometry::min_corner, I>(b));
+        bs.max_corner[I][i] = static_cast<T>(geometry::get<geometry::max_corner, I>(b));
+        load_box<Box, I + 1, Dimension>::apply(b, bs, i);
+    }
+};
+
+template <typename Box, std::size_t Dimension>
+struct load_box<Box, Dimension, Dimension>
+{
+    template <typename T>
+    static inline void apply(Box const& , boxes<T, Dimension> & , std::size_t ) {}
+};
+
+template <typename Point, std::size_t I, std::size_t Dimension>
+struct load_point
+{
+    template <typename T>
+    static inline void apply(Point const& p, T (&pt)[Dimension])
+    {
+        pt[I] = static_cast<T>(geometry::get<I>(p));
+        load_point<Point, I + 1, Dimension>::apply(p, pt);
+    }
+};
+
+template <typename Point, std::size_t Dimension>
+struct load_point<Point, Dimension, Dimension>
+{
+    template <typename T>
+    static inline void apply(Point const& , T (&)[Dimension]) {}
+};
+
+template <typename Point, typename Box, bool IsCartesian>
+struct is_batchable
+{
+    static const bool value = false;
+};
+
+template <typename Point, typename Box>
+struct is_batchable<Point, Box, true>
+{
+    typedef typename geometry::default_comparable_distance_result<Point, Box>::type result_type;
+
+    static const bool value =
+        boost::is_arithmetic<typename coordinate_type<Point>::type>::value
+     && boost::is_arithmetic<typename coordinate_type<Box>::type>::value
+     && static_cast<std::size_t>(dimension<Point>::value) == static_cast<std::size_t>(dimension<Box>::value)
+     && ( boost::is_same<result_type, double>::value
+       || boost::is_same<result_type, float>::value );
+};
+
+} // namespace near_batch
+
+// Whether the distances between the Point and Boxes can be calculated by
+// comparable_distance_near_batch: cartesian geometries with arithmetic
+// coordinates and floating point distances
+template <typename Point, typename Box>
+struct is_comparable_distance_near_batchable
+    : near_batch::is_batchable
+        <
+            Point, Box,
+            boost::is_same<typename tag<Point>::type, point_tag>::value
+         && boost::is_same<typename tag<Box>::type, box_tag>::value
+         && boost::is_same<typename cs_tag<Point>::type, cartesian_tag>::value
+         && boost::is_same<typename cs_tag<Box>::type, cartesian_tag>::value
+        >
+{};
+
+// Calculates the comparable distances between a point and up to
+// near_batch::max_count boxes at once. The boxes are added one by one,
+// their coordinates are stored dimension by dimension so the distances
+// to all of them can be calculated with SIMD instructions.
+template <typename Point, typename Box>
+class comparable_distance_near_batch
+{
+public:
+    typedef typename geometry::default_comparable_distance_result<Point, Box>::type result_type;
+
+    static const std::size_t max_count = near_batch::max_count;
+
+    inline explicit comparable_distance_near_batch(Point const& pt)
+        : m_count(0)
+    {
+        near_batch::load_point<Point, 0, dimension_value>::apply(pt, m_point);
+    }
+
+    inline void clear()
+    {
+        m_count = 0;
+    }
+
+    inline std::size_t size() const
+    {
+        return m_count;
+    }
+
+    inline void push_back(Box const& b)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(m_count < max_count, "too many boxes");
+        near_batch::load_box<Box, 0, dimension_value>::apply(b, m_boxes, m_count);
+        ++m_count;
+    }
+
+    // Calculates the distances of all boxes, the padding lanes are equal to 0
+    inline void apply()
+    {
+        // round up to the greatest number of lanes
+        std::size_t const count = (m_count + 7) & ~std::size_t(7);
+        for ( std::size_t i = m_count ; i < count ; ++i )
+        {
+            for ( std::size_t d = 0 ; d < dimension_value ; ++d )
+            {
+                m_boxes.min_corner[d][i] = m_point[d];
+                m_boxes.max_corner[d][i] = m_point[d];
+            }
+        }
+
+        near_batch::kernel<result_type>::apply(m_point, m_boxes, count, m_distances);
+    }
+
+    inline result_type const& operator[](std::size_t i) const
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(i < m_count, "index out of bounds");
+        return m_distances[i];
+    }
+
+private:
+    static const std::size_t dimension_value = dimension<Box>::value;
+
+    result_type m_point[dimension_value];
+    near_batch::boxes<result_type, dimension_value> m_boxes;
+    result_type m_distances[max_count];
+    std::size_t m_count;
+};
+
+namespace near_batch {
+
+// Passes the children [first, last) of a node meeting the predicates to
+// branches.push(child, distance), unless the distance isn't ok or it's not
+// smaller than the greatest distance of the found neighbors if prune is true.
+// The bounds of a child are returned by branches.bounds(child). The distances
+// are calculated by NodeDistances, max_count of them at once.
+template <typename Predicates, typename NodeDistances, typename Child, typename Distance, typename Branches>
+inline void push_branches(Predicates const& predicates, NodeDistances & node_distances,
+                          Child first, Child const& last,
+                          bool prune, Distance const& greatest_distance,
+                          Branches & branches)
+{
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+    typedef typename NodeDistances::result_type node_distance_type;
+
+    while ( first != last )
+    {
+        Child batch_last = first;
+        node_distances.clear();
+        for ( ; batch_last != last && node_distances.size() < NodeDistances::max_count ; ++batch_last )
+            node_distances.push_back(branches.bounds(batch_last));
+        node_distances.apply();
+
+        for ( std::size_t i = 0 ; first != batch_last ; ++first, ++i )
+        {
+            // if current node meets predicates
+            // 0 - dummy value
+            if ( !index::detail::predicates_check<index::detail::bounds_tag, 0, predicates_len>(
+                    predicates, 0, branches.bounds(first)) )
+            {
+                continue;
+            }
+
+            // calculate node's distance(s) for distance predicate
+            node_distance_type node_distance;
+            // if distance isn't ok - move to the next node
+            if ( !node_distances.get(i, node_distance) )
+            {
+                continue;
+            }
+
+            // if current node is further than found neighbors - don't analyze it
+            if ( prune && greatest_distance <= node_distance )
+            {
+                continue;
+            }
+
+            branches.push(first, node_distance);
+        }
+    }
+}
+
+} // namespace near_batch
+
+}}}} // namespace boost::geometry::index::detail
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_COMPARABLE_DISTANCE_NEAR_BATCH_HPP
@@ -0,0 +1,149 @@
+// Boost.Geometry Index
+//
+// Positions of points on space-filling curves (Morton/Z-order and Hilbert)
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_SPACE_FILLING_CURVE_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_SPACE_FILLING_CURVE_HPP
+
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail {
+
+// The bounds are divided into a grid of 2^bits cells in each dimension
+// and the key is the position of the cell containing the point on the curve.
+// The keys of all dimensions are stored in 64 bits.
+
+template <std::size_t Dimension>
+struct space_filling_curve_traits
+{
+    BOOST_STATIC_ASSERT(0 < Dimension && Dimension <= 64);
+
+    static const std::size_t bits = 64 / Dimension < 32 ? 64 / Dimension : 32;
+};
+
+template <std::size_t I, std::size_t Dimension>
+struct grid_coordinates
+{
+    template <typename Point, typename Box>
+    static inline void apply(Point const& point, Box const& bounds, boost::uint32_t * coords)
+    {
+        static const double cells_max = static_cast<double>(
+            (boost::uint64_t(1) << space_filling_curve_traits<Dimension>::bits) - 1);
+
+        double const c = static_cast<double>(geometry::get<I>(point));
+        double const min_c = static_cast<double>(geometry::get<min_corner, I>(bounds));
+        double const max_c = static_cast<double>(geometry::get<max_corner, I>(bounds));
+
+        double cell = 0;
+        if ( min_c < max_c )
+        {
+            cell = (c - min_c) / (max_c - min_c) * cells_max;
+            if ( cell < 0 )
+                cell = 0;
+            else if ( cells_max < cell )
+                cell = cells_max;
+        }
+        coords[I] = static_cast<boost::uint32_t>(cell);
+
+        grid_coordinates<I + 1, Dimension>::apply(point, bounds, coords);
+    }
+};
+
+template <std::size_t Dimension>
+struct grid_coordinates<Dimension, Dimension>
+{
+    template <typename Point, typename Box>
+    static inline void apply(Point const& , Box const& , boost::uint32_t * ) {}
+};
+
+// Interleaves the bits, the most significant bit of the first coordinate first
+template <std::size_t Dimension>
+inline boost::uint64_t interleave_bits(boost::uint32_t const* coords)
+{
+    static const std::size_t bits = space_filling_curve_traits<Dimension>::bits;
+
+    boost::uint64_t result = 0;
+    for ( std::size_t b = bits ; b > 0 ; --b )
+    {
+        for ( std::size_t d = 0 ; d < Dimension ; ++d )
+        {
+            result = (result << 1) | ((coords[d] >> (b - 1)) & 1u);
+        }
+    }
+    return result;
+}
+
+struct morton_curve
+{
+    template <typename Point, typename Box>
+    static inline boost::uint64_t apply(Point const& point, Box const& bounds)
+    {
+        static const std::size_t dimension = geometry::dimension<Point>::value;
+
+        boost::uint32_t coords[dimension];
+        grid_coordinates<0, dimension>::apply(point, bounds, coords);
+        return interleave_bits<dimension>(coords);
+    }
+};
+
+// J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 2004
+// The grid coordinates are transformed into the transposed Hilbert index
+// which is then interleaved.
+struct hilbert_curve
+{
+    template <typename Point, typename Box>
+    static inline boost::uint64_t apply(Point const& point, Box const& bounds)
+    {
+        static const std::size_t dimension = geometry::dimension<Point>::value;
+        static const std::size_t bits = space_filling_curve_traits<dimension>::bits;
+
+        boost::uint32_t x[dimension];
+        grid_coordinates<0, dimension>::apply(point, bounds, x);
+
+        boost::uint32_t const m = boost::uint32_t(1) << (bits - 1);
+
+        // inverse undo
+        for ( boost::uint32_t q = m ; q > 1 ; q >>= 1 )
+        {
+            boost::uint32_t const p = q - 1;
+            for ( std::size_t i = 0 ; i < dimension ; ++i )
+            {
+                // if the bit is set invert the lower bits of x[0],
+                // otherwise exchange the lower bits of x[0] and x[i]
+                // without branches, the bits are random
+                boost::uint32_t const invert = 0u - ((x[i] & q) != 0 ? 1u : 0u);
+                boost::uint32_t const t = (x[0] ^ x[i]) & p & ~invert;
+                x[0] ^= (p & invert) | t;
+                x[i] ^= t;
+            }
+        }
+
+        // gray encode
+        for ( std::size_t i = 1 ; i < dimension ; ++i )
+            x[i] ^= x[i - 1];
+        boost::uint32_t t = 0;
+        for ( boost::uint32_t q = m ; q > 1 ; q >>= 1 )
+        {
+            if ( x[dimension - 1] & q )
+                t ^= q - 1;
+        }
+        for ( std::size_t i = 0 ; i < dimension ; ++i )
+            x[i] ^= t;
+
+        return interleave_bits<dimension>(x);
+    }
+};
+
+}}}} // namespace boost::geometry::index::detail
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_ALGORITHMS_SPACE_FILLING_CURVE_HPP
@@ -12,7 +12,11 @@
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_DISTANCE_PREDICATES_HPP
 #define BOOST_GEOMETRY_INDEX_DETAIL_DISTANCE_PREDICATES_HPP
 
+#include <boost/core/addressof.hpp>
+#include <boost/core/enable_if.hpp>
+
 #include <boost/geometry/index/detail/algorithms/comparable_distance_near.hpp>
+#include <boost/geometry/index/detail/algorithms/comparable_distance_near_batch.hpp>
 #include <boost/geometry/index/detail/algorithms/comparable_distance_far.hpp>
 #include <boost/geometry/index/detail/algorithms/comparable_distance_centroid.hpp>
 #include <boost/geometry/index/detail/algorithms/path_intersection.hpp>
@@ -156,6 +160,98 @@ struct calculate_distance< predicates::path<SegmentOrLinestring>, Indexable, Tag
     }
 };
 
+// ------------------------------------------------------------------ //
+// calculate_node_distances
+// ------------------------------------------------------------------ //
+
+// Calculates the distances of up to max_count bounds of the children of a node.
+// The bounds are added with push_back(), apply() is called and the distances
+// are taken with get(). By default the distances are calculated one by one
+// in get().
+template <typename Predicate, typename Box, typename Enable = void>
+class calculate_node_distances
+{
+    typedef calculate_distance<Predicate, Box, bounds_tag> calculate_node_distance;
+
+public:
+    typedef typename calculate_node_distance::result_type result_type;
+
+    static const std::size_t max_count = near_batch::max_count;
+
+    inline explicit calculate_node_distances(Predicate const& p)
+        : m_pred(p), m_count(0)
+    {}
+
+    inline void clear() { m_count = 0; }
+
+    inline std::size_t size() const { return m_count; }
+
+    inline void push_back(Box const& b)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(m_count < max_count, "too many boxes");
+        m_boxes[m_count++] = boost::addressof(b);
+    }
+
+    inline void apply() {}
+
+    inline bool get(std::size_t i, result_type & result) const
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(i < m_count, "index out of bounds");
+        return calculate_node_distance::apply(m_pred, *m_boxes[i], result);
+    }
+
+private:
+    Predicate const& m_pred;
+    Box const* m_boxes[max_count];
+    std::size_t m_count;
+};
+
+// nearest() with cartesian boxes - the distances to all bounds are calculated
+// at once in apply()
+template <typename PointRelation, typename Box>
+class calculate_node_distances
+    <
+        predicates::nearest<PointRelation>, Box,
+        typename boost::enable_if_c
+            <
+                is_comparable_distance_near_batchable
+                    <
+                        typename relation<PointRelation>::value_type, Box
+                    >::value
+            >::type
+    >
+{
+    typedef detail::relation<PointRelation> relation;
+    typedef typename relation::value_type point_type;
+    typedef comparable_distance_near_batch<point_type, Box> batch_type;
+
+public:
+    typedef typename batch_type::result_type result_type;
+
+    static const std::size_t max_count = batch_type::max_count;
+
+    inline explicit calculate_node_distances(predicates::nearest<PointRelation> const& p)
+        : m_batch(relation::value(p.point_or_relation))
+    {}
+
+    inline void clear() { m_batch.clear(); }
+
+    inline std::size_t size() const { return m_batch.size(); }
+
+    inline void push_back(Box const& b) { m_batch.push_back(b); }
+
+    inline void apply() { m_batch.apply(); }
+
+    inline bool get(std::size_t i, result_type & result) const
+    {
+        result = m_batch[i];
+        return true;
+    }
+
+private:
+    batch_type m_batch;
+};
+
 }}}} // namespace boost::geometry::index::detail
 
 #endif // BOOST_GEOMETRY_INDEX_RTREE_DISTANCE_PREDICATES_HPP
@@ -0,0 +1,116 @@
+// Boost.Geometry Index
+//
+// Spatial join predicates definition and checks.
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_JOIN_PREDICATES_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_JOIN_PREDICATES_HPP
+
+#include <boost/mpl/assert.hpp>
+
+#include <boost/geometry/algorithms/distance.hpp>
+
+#include <boost/geometry/index/detail/predicates.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail {
+
+namespace join_predicates {
+
+// ------------------------------------------------------------------ //
+// predicates
+// ------------------------------------------------------------------ //
+
+// The relation between the Indexables of the first and the second rtree
+template <typename Tag>
+struct spatial
+{};
+
+template <typename T>
+struct distance_within
+{
+    distance_within() {}
+    distance_within(T const& d) : max_distance(d) {}
+    T max_distance;
+};
+
+} // namespace join_predicates
+
+// ------------------------------------------------------------------ //
+// join_predicate_check
+// ------------------------------------------------------------------ //
+
+// bounds() - true if the Indexables or nodes bounded by the geometries may contain a pair of joined values
+// values() - true if the values having the Indexables are joined
+
+template <typename Predicate>
+struct join_predicate_check
+{
+    BOOST_MPL_ASSERT_MSG(
+        (false),
+        NOT_IMPLEMENTED_FOR_THIS_JOIN_PREDICATE,
+        (join_predicate_check));
+};
+
+template <>
+struct join_predicate_check< join_predicates::spatial<predicates::intersects_tag> >
+{
+    typedef join_predicates::spatial<predicates::intersects_tag> predicate_type;
+
+    template <typename Geometry1, typename Geometry2>
+    static inline bool bounds(predicate_type const&, Geometry1 const& g1, Geometry2 const& g2)
+    {
+        return spatial_predicate_call<predicates::intersects_tag>::apply(g1, g2);
+    }
+
+    template <typename Indexable1, typename Indexable2>
+    static inline bool values(predicate_type const&, Indexable1 const& i1, Indexable2 const& i2)
+    {
+        return spatial_predicate_call<predicates::intersects_tag>::apply(i1, i2);
+    }
+};
+
+template <>
+struct join_predicate_check< join_predicates::spatial<predicates::within_tag> >
+{
+    typedef join_predicates::spatial<predicates::within_tag> predicate_type;
+
+    // the nodes containing Indexables within the other ones must intersect
+    template <typename Geometry1, typename Geometry2>
+    static inline bool bounds(predicate_type const&, Geometry1 const& g1, Geometry2 const& g2)
+    {
+        return spatial_predicate_call<predicates::intersects_tag>::apply(g1, g2);
+    }
+
+    template <typename Indexable1, typename Indexable2>
+    static inline bool values(predicate_type const&, Indexable1 const& i1, Indexable2 const& i2)
+    {
+        return spatial_predicate_call<predicates::within_tag>::apply(i1, i2);
+    }
+};
+
+template <typename T>
+struct join_predicate_check< join_predicates::distance_within<T> >
+{
+    typedef join_predicates::distance_within<T> predicate_type;
+
+    template <typename Geometry1, typename Geometry2>
+    static inline bool bounds(predicate_type const& p, Geometry1 const& g1, Geometry2 const& g2)
+    {
+        return geometry::distance(g1, g2) <= p.max_distance;
+    }
+
+    template <typename Indexable1, typename Indexable2>
+    static inline bool values(predicate_type const& p, Indexable1 const& i1, Indexable2 const& i2)
+    {
+        return geometry::distance(i1, i2) <= p.max_distance;
+    }
+};
+
+}}}} // namespace boost::geometry::index::detail
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_JOIN_PREDICATES_HPP
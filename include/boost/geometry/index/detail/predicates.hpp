@@ -14,7 +14,24 @@
 #include <boost/geometry/index/predicates.hpp>
 #include <boost/geometry/index/detail/tags.hpp>
 
-namespace boost { namespace geometry { namespace index { namespace detail {
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief The traversal of the R-tree used by the k-nearest neighbour query.
+
+The best-first traversal visits less nodes but has a greater overhead than
+the depth-first one, so it's faster for a greater k, see \c nearest().
+
+\ingroup predicates
+*/
+enum nearest_traversal
+{
+    default_traversal,  /*!< best-first for k >= 100, depth-first otherwise */
+    depth_first,        /*!< the children of a node are visited recursively, sorted by distance */
+    best_first          /*!< the closest of all nodes waiting in one priority queue is visited */
+};
+
+namespace detail {
 
 namespace predicates {
 
@@ -82,12 +99,15 @@ struct nearest
     nearest()
 //        : count(0)
     {}
-    nearest(PointOrRelation const& por, unsigned k)
+    nearest(PointOrRelation const& por, unsigned k,
+            nearest_traversal t = default_traversal)
         : point_or_relation(por)
         , count(k)
+        , traversal(t)
     {}
     PointOrRelation point_or_relation;
     unsigned count;
+    nearest_traversal traversal;
 };
 
 template <typename SegmentOrLinestring>
@@ -822,6 +842,20 @@ struct predicates_find_distance< boost::tuples::cons<Head, Tail> >
     >::value;
 };
 
+// predicate_traversal
+
+template <typename DistancePredicates>
+inline nearest_traversal predicate_traversal(predicates::nearest<DistancePredicates> const& p)
+{
+    return p.traversal;
+}
+
+template <typename Linestring>
+inline nearest_traversal predicate_traversal(predicates::path<Linestring> const& )
+{
+    return default_traversal;
+}
+
 }}}} // namespace boost::geometry::index::detail
 
 #endif // BOOST_GEOMETRY_INDEX_DETAIL_PREDICATES_HPP
@@ -0,0 +1,18 @@
+// Boost.Geometry Index
+//
+// Flat R-tree implementation
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_FLAT_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_FLAT_HPP
+
+#include <boost/geometry/index/detail/rtree/flat/nodes.hpp>
+#include <boost/geometry/index/detail/rtree/flat/query.hpp>
+#include <boost/geometry/index/detail/rtree/flat/view.hpp>
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_FLAT_HPP
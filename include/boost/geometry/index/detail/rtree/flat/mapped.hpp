@@ -0,0 +1,465 @@
+// Boost.Geometry Index
+//
+// Binary layout of the flat R-tree which may be queried directly in mapped memory
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_MAPPED_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_MAPPED_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+
+#include <boost/cstdint.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+
+#include <boost/geometry/index/parameters.hpp>
+#include <boost/geometry/index/detail/exception.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace flat {
+
+// The layout of the file, all sections are aligned to 64 bytes:
+//
+// HEADER   file_header
+// BOUNDS   Box
+// NODES    node<Box, uint32_t>[nodes_count]
+// VALUES   Value[values_count]
+//
+// The nodes and Values are stored as they're stored in memory so the file
+// may be used only on platforms with the same byte order and the same
+// sizes and alignments of types. The version must be increased each time
+// the layout is changed.
+
+namespace mapped {
+
+static const boost::uint32_t format_version = 1;
+static const boost::uint32_t byte_order_mark = 0x01020304;
+static const boost::uint64_t section_alignment = 64;
+
+enum algorithm_id
+{
+    linear_algorithm = 1,
+    quadratic_algorithm = 2,
+    rstar_algorithm = 3,
+    kmeans_algorithm = 4
+};
+
+struct file_header
+{
+    char magic[8];
+    boost::uint32_t version;
+    boost::uint32_t byte_order;
+
+    boost::uint32_t algorithm;
+    boost::uint32_t max_elements;
+    boost::uint32_t min_elements;
+    boost::uint32_t reinserted_elements;
+    boost::uint32_t overlap_cost_threshold;
+
+    boost::uint32_t dimension;
+    boost::uint32_t coordinate_size;
+    boost::uint32_t value_size;
+    boost::uint32_t node_size;
+    boost::uint32_t leafs_level;
+
+    boost::uint64_t leafs_begin;
+    boost::uint64_t nodes_count;
+    boost::uint64_t values_count;
+
+    boost::uint64_t bounds_offset;
+    boost::uint64_t nodes_offset;
+    boost::uint64_t values_offset;
+};
+
+inline void set_magic(file_header & h)
+{
+    std::memcpy(h.magic, "BGIRTREE", 8);
+}
+
+inline bool check_magic(file_header const& h)
+{
+    return std::memcmp(h.magic, "BGIRTREE", 8) == 0;
+}
+
+inline boost::uint64_t aligned_offset(boost::uint64_t offset)
+{
+    return (offset + section_alignment - 1) / section_alignment * section_alignment;
+}
+
+inline void set_parameters(file_header & h, algorithm_id algorithm,
+                           size_t max_elements, size_t min_elements,
+                           size_t reinserted_elements = 0, size_t overlap_cost_threshold = 0)
+{
+    h.algorithm = algorithm;
+    h.max_elements = static_cast<boost::uint32_t>(max_elements);
+    h.min_elements = static_cast<boost::uint32_t>(min_elements);
+    h.reinserted_elements = static_cast<boost::uint32_t>(reinserted_elements);
+    h.overlap_cost_threshold = static_cast<boost::uint32_t>(overlap_cost_threshold);
+}
+
+inline void check_algorithm(file_header const& h, algorithm_id algorithm)
+{
+    if ( h.algorithm != static_cast<boost::uint32_t>(algorithm) )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: different algorithm parameters");
+}
+
+inline void check_parameters(file_header const& h, algorithm_id algorithm,
+                             size_t max_elements, size_t min_elements,
+                             size_t reinserted_elements = 0, size_t overlap_cost_threshold = 0)
+{
+    check_algorithm(h, algorithm);
+
+    if ( h.max_elements != max_elements || h.min_elements != min_elements
+      || h.reinserted_elements != reinserted_elements
+      || h.overlap_cost_threshold != overlap_cost_threshold )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: different algorithm parameters");
+}
+
+// Stores the parameters in the header and creates the parameters from
+// the header. The compile-time parameters must be equal to the stored ones.
+template <typename Parameters>
+struct parameters_io
+{
+    BOOST_MPL_ASSERT_MSG(
+        (false),
+        NOT_IMPLEMENTED_FOR_THESE_PARAMETERS,
+        (Parameters));
+};
+
+template <size_t Max, size_t Min>
+struct parameters_io< index::linear<Max, Min> >
+{
+    typedef index::linear<Max, Min> parameters_type;
+
+    static inline void save(file_header & h, parameters_type const& )
+    {
+        set_parameters(h, linear_algorithm, Max, Min);
+    }
+
+    static inline parameters_type load(file_header const& h)
+    {
+        check_parameters(h, linear_algorithm, Max, Min);
+        return parameters_type();
+    }
+};
+
+template <size_t Max, size_t Min>
+struct parameters_io< index::quadratic<Max, Min> >
+{
+    typedef index::quadratic<Max, Min> parameters_type;
+
+    static inline void save(file_header & h, parameters_type const& )
+    {
+        set_parameters(h, quadratic_algorithm, Max, Min);
+    }
+
+    static inline parameters_type load(file_header const& h)
+    {
+        check_parameters(h, quadratic_algorithm, Max, Min);
+        return parameters_type();
+    }
+};
+
+template <size_t Max, size_t Min, size_t RE, size_t OCT>
+struct parameters_io< index::rstar<Max, Min, RE, OCT> >
+{
+    typedef index::rstar<Max, Min, RE, OCT> parameters_type;
+
+    static inline void save(file_header & h, parameters_type const& p)
+    {
+        set_parameters(h, rstar_algorithm, Max, Min,
+                       p.get_reinserted_elements(), p.get_overlap_cost_threshold());
+    }
+
+    static inline parameters_type load(file_header const& h)
+    {
+        parameters_type p;
+        check_parameters(h, rstar_algorithm, Max, Min,
+                         p.get_reinserted_elements(), p.get_overlap_cost_threshold());
+        return p;
+    }
+};
+
+// The number of iterations affects only the creation of the tree so it isn't stored
+template <size_t Max, size_t Min, size_t It>
+struct parameters_io< index::kmeans<Max, Min, It> >
+{
+    typedef index::kmeans<Max, Min, It> parameters_type;
+
+    static inline void save(file_header & h, parameters_type const& )
+    {
+        set_parameters(h, kmeans_algorithm, Max, Min);
+    }
+
+    static inline parameters_type load(file_header const& h)
+    {
+        check_parameters(h, kmeans_algorithm, Max, Min);
+        return parameters_type();
+    }
+};
+
+template <>
+struct parameters_io<index::dynamic_linear>
+{
+    static inline void save(file_header & h, index::dynamic_linear const& p)
+    {
+        set_parameters(h, linear_algorithm, p.get_max_elements(), p.get_min_elements());
+    }
+
+    static inline index::dynamic_linear load(file_header const& h)
+    {
+        check_algorithm(h, linear_algorithm);
+        return index::dynamic_linear(h.max_elements, h.min_elements);                               // MAY THROW
+    }
+};
+
+template <>
+struct parameters_io<index::dynamic_quadratic>
+{
+    static inline void save(file_header & h, index::dynamic_quadratic const& p)
+    {
+        set_parameters(h, quadratic_algorithm, p.get_max_elements(), p.get_min_elements());
+    }
+
+    static inline index::dynamic_quadratic load(file_header const& h)
+    {
+        check_algorithm(h, quadratic_algorithm);
+        return index::dynamic_quadratic(h.max_elements, h.min_elements);                            // MAY THROW
+    }
+};
+
+template <>
+struct parameters_io<index::dynamic_rstar>
+{
+    static inline void save(file_header & h, index::dynamic_rstar const& p)
+    {
+        set_parameters(h, rstar_algorithm, p.get_max_elements(), p.get_min_elements(),
+                       p.get_reinserted_elements(), p.get_overlap_cost_threshold());
+    }
+
+    static inline index::dynamic_rstar load(file_header const& h)
+    {
+        check_algorithm(h, rstar_algorithm);
+        return index::dynamic_rstar(h.max_elements, h.min_elements,
+                                    h.reinserted_elements, h.overlap_cost_threshold);               // MAY THROW
+    }
+};
+
+template <>
+struct parameters_io<index::dynamic_kmeans>
+{
+    static inline void save(file_header & h, index::dynamic_kmeans const& p)
+    {
+        set_parameters(h, kmeans_algorithm, p.get_max_elements(), p.get_min_elements());
+    }
+
+    static inline index::dynamic_kmeans load(file_header const& h)
+    {
+        check_algorithm(h, kmeans_algorithm);
+        return index::dynamic_kmeans(h.max_elements, h.min_elements);                               // MAY THROW
+    }
+};
+
+// The header describing the Values and nodes of the given types.
+template <typename Value, typename Node>
+inline file_header make_header(boost::uint64_t nodes_count, boost::uint64_t values_count)
+{
+    typedef typename Node::box_type box_type;
+
+    file_header h;
+    std::memset(&h, 0, sizeof(file_header));
+
+    set_magic(h);
+    h.version = format_version;
+    h.byte_order = byte_order_mark;
+
+    h.dimension = static_cast<boost::uint32_t>(geometry::dimension<box_type>::value);
+    h.coordinate_size = static_cast<boost::uint32_t>(sizeof(typename coordinate_type<box_type>::type));
+    h.value_size = static_cast<boost::uint32_t>(sizeof(Value));
+    h.node_size = static_cast<boost::uint32_t>(sizeof(Node));
+
+    h.nodes_count = nodes_count;
+    h.values_count = values_count;
+
+    h.bounds_offset = aligned_offset(sizeof(file_header));
+    h.nodes_offset = aligned_offset(h.bounds_offset + sizeof(box_type));
+    h.values_offset = aligned_offset(h.nodes_offset + nodes_count * sizeof(Node));
+
+    return h;
+}
+
+inline void write_padding(std::ostream & os, boost::uint64_t & pos, boost::uint64_t offset)
+{
+    static const char zeros[section_alignment] = {};
+    BOOST_GEOMETRY_INDEX_ASSERT(pos <= offset && offset - pos < section_alignment, "unexpected offset");
+    os.write(zeros, static_cast<std::streamsize>(offset - pos));
+    pos = offset;
+}
+
+template <typename T>
+inline void write_array(std::ostream & os, boost::uint64_t & pos, T const* ptr, boost::uint64_t count)
+{
+    os.write(reinterpret_cast<const char*>(ptr), static_cast<std::streamsize>(count * sizeof(T)));
+    pos += count * sizeof(T);
+}
+
+// Writes the storage of the flat R-tree. The errors are reported by the stream.
+template <typename Storage, typename Parameters> inline
+void write(std::ostream & os, Storage const& storage, Parameters const& parameters,
+           typename Storage::nodes_type::value_type::box_type const& bounds)
+{
+    typedef typename Storage::nodes_type::value_type node_type;
+    typedef typename Storage::values_type::value_type value_type;
+
+    file_header h = make_header<value_type, node_type>(storage.nodes.size(), storage.values.size());
+    parameters_io<Parameters>::save(h, parameters);
+    h.leafs_begin = storage.leafs_begin;
+    h.leafs_level = static_cast<boost::uint32_t>(storage.leafs_level);
+
+    boost::uint64_t pos = 0;
+    write_array(os, pos, &h, 1);
+    write_padding(os, pos, h.bounds_offset);
+    write_array(os, pos, &bounds, 1);
+    write_padding(os, pos, h.nodes_offset);
+    if ( !storage.nodes.empty() )
+        write_array(os, pos, &storage.nodes[0], h.nodes_count);
+    write_padding(os, pos, h.values_offset);
+    if ( !storage.values.empty() )
+        write_array(os, pos, &storage.values[0], h.values_count);
+}
+
+// Checks if the children of the nodes are stored in the arrays. The children of
+// a node are stored after it so the traversal can't visit a node twice.
+template <typename Node>
+inline void check_nodes(file_header const& h, const void * data)
+{
+    Node const* nodes = reinterpret_cast<Node const*>(
+                            static_cast<const char*>(data) + h.nodes_offset);
+
+    for ( boost::uint64_t i = 0 ; i < h.nodes_count ; ++i )
+    {
+        boost::uint64_t const first = nodes[i].first;
+        boost::uint64_t const last = first + nodes[i].count;
+
+        bool const valid = i < h.leafs_begin
+                         ? (i < first && last <= h.nodes_count)
+                         : (last <= h.values_count);
+        if ( !valid )
+            throw_runtime_error("boost::geometry::index::mapped_rtree: invalid nodes");
+    }
+}
+
+// Reads the header and checks if it's compatible with the types of Value and node
+// and consistent with the size of the data. The children of the nodes are checked
+// against the numbers of nodes and Values, the boxes are assumed to be written by write().
+template <typename Value, typename Node>
+inline file_header read_header(const void * data, std::size_t size)
+{
+    typedef typename Node::box_type box_type;
+
+    if ( data == 0 || size < sizeof(file_header) )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: invalid size of data");
+
+    file_header h;
+    std::memcpy(&h, data, sizeof(file_header));
+
+    if ( !check_magic(h) )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: unknown format");
+    if ( h.version != format_version )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: unsupported version");
+    if ( h.byte_order != byte_order_mark )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: different byte order");
+
+    // the counts are not used to calculate the offsets before they're checked against the size
+    file_header const expected = make_header<Value, Node>(0, 0);
+    if ( h.dimension != expected.dimension
+      || h.coordinate_size != expected.coordinate_size
+      || h.value_size != expected.value_size
+      || h.node_size != expected.node_size )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: different types of Values or nodes");
+
+    if ( h.bounds_offset != expected.bounds_offset
+      || h.nodes_offset != expected.nodes_offset
+      || size < h.nodes_offset
+      || (size - h.nodes_offset) / sizeof(Node) < h.nodes_count
+      || h.values_offset != aligned_offset(h.nodes_offset + h.nodes_count * sizeof(Node))
+      || size < h.values_offset
+      || (size - h.values_offset) / sizeof(Value) < h.values_count
+      || (h.nodes_count == 0) != (h.values_count == 0) )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: invalid size of data");
+
+    // each level above the leafs contains at least one node
+    if ( h.nodes_count == 0
+         ? (h.leafs_begin != 0 || h.leafs_level != 0)
+         : (h.nodes_count <= h.leafs_begin
+         || h.leafs_begin < h.leafs_level
+         || (h.leafs_level == 0) != (h.leafs_begin == 0)) )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: invalid levels");
+
+    if ( h.algorithm < linear_algorithm || kmeans_algorithm < h.algorithm
+      || h.min_elements == 0
+      || boost::uint64_t(h.max_elements) + 1 < 2 * boost::uint64_t(h.min_elements)
+      || h.max_elements < h.reinserted_elements )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: invalid parameters");
+
+    std::size_t const address = reinterpret_cast<std::size_t>(data);
+    if ( address % boost::alignment_of<box_type>::value != 0
+      || address % boost::alignment_of<Node>::value != 0
+      || address % boost::alignment_of<Value>::value != 0 )
+        throw_runtime_error("boost::geometry::index::mapped_rtree: data not aligned");
+
+    check_nodes<Node>(h, data);
+
+    return h;
+}
+
+// The range of objects stored in memory which isn't owned
+template <typename T>
+class array_view
+{
+public:
+    typedef T value_type;
+    typedef T const& const_reference;
+    typedef T const* const_pointer;
+    typedef T const* const_iterator;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    array_view() : m_data(0), m_size(0) {}
+
+    array_view(T const* data, size_type size) : m_data(data), m_size(size) {}
+
+    const_reference operator[](size_type i) const { return m_data[i]; }
+    const_reference front() const { return m_data[0]; }
+    const_iterator begin() const { return m_data; }
+    const_iterator end() const { return m_data + m_size; }
+    size_type size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+private:
+    T const* m_data;
+    size_type m_size;
+};
+
+template <typename T>
+inline array_view<T> make_array_view(const void * data, boost::uint64_t offset, boost::uint64_t count)
+{
+    return array_view<T>(
+        reinterpret_cast<T const*>(static_cast<const char*>(data) + offset),
+        static_cast<std::size_t>(count));
+}
+
+} // namespace mapped
+
+}}}}}} // namespace boost::geometry::index::detail::rtree::flat
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_MAPPED_HPP
@@ -0,0 +1,197 @@
+// Boost.Geometry Index
+//
+// Flat R-tree nodes and conversion from the R-tree
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_NODES_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_NODES_HPP
+
+#include <limits>
+#include <vector>
+
+#include <boost/geometry/index/detail/exception.hpp>
+#include <boost/geometry/index/detail/rtree/node/node.hpp>
+#include <boost/geometry/index/detail/rtree/utilities/view.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace flat {
+
+// All nodes are stored in one array in breadth-first order, the children
+// of a node are stored one after another so they're identified by the index
+// of the first one and the number of children. Since the R-tree is balanced
+// the leafs are stored at the end of the array. The children of a leaf are
+// values stored in a separate array in the same order.
+//
+// ROOT     0
+// L1       1 2
+// LEAFS    3 4 | 5 6 7
+// VALUES   v v v | v v | v v v | v v | v v
+
+template <typename Box, typename IndexType>
+struct node
+{
+    typedef Box box_type;
+    typedef IndexType index_type;
+
+    node() : first(0), count(0) {}
+
+    node(Box const& b) : box(b), first(0), count(0) {}
+
+    Box box;
+    IndexType first;
+    IndexType count;
+};
+
+// Storage of nodes and values of the flat R-tree
+template <typename Nodes, typename Values>
+struct storage
+{
+    typedef Nodes nodes_type;
+    typedef Values values_type;
+    typedef typename Nodes::size_type size_type;
+
+    // The containers are created from allocators or views of memory
+    template <typename NodesArg, typename ValuesArg>
+    storage(NodesArg const& nodes_arg, ValuesArg const& values_arg)
+        : nodes(nodes_arg), values(values_arg), leafs_begin(0), leafs_level(0)
+    {}
+
+    inline bool is_leaf(size_type node_index) const
+    {
+        return leafs_begin <= node_index;
+    }
+
+    Nodes nodes;
+    Values values;
+    size_type leafs_begin;
+    size_type leafs_level;
+};
+
+namespace visitors {
+
+// Stores the children of visited nodes at the end of the array of nodes
+// and the values of visited leafs at the end of the array of values.
+template <typename Value, typename Options, typename Box, typename Allocators, typename Storage>
+struct copy_level
+    : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+{
+    typedef typename rtree::internal_node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    typedef typename Allocators::node_pointer node_pointer;
+    typedef typename Storage::size_type size_type;
+    typedef typename Storage::nodes_type::value_type flat_node;
+    typedef typename flat_node::index_type index_type;
+
+    inline copy_level(Storage & s)
+        : storage(s), current(0), leafs_found(false)
+    {}
+
+    inline void operator()(internal_node const& n)
+    {
+        typedef typename rtree::elements_type<internal_node>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        BOOST_GEOMETRY_INDEX_ASSERT(!leafs_found, "unexpected number of levels");
+
+        storage.nodes[current].first = static_cast<index_type>(storage.nodes.size());
+        storage.nodes[current].count = static_cast<index_type>(elements.size());
+
+        if ( (std::numeric_limits<index_type>::max)() - elements.size() < storage.nodes.size() )
+            throw_length_error("too many nodes");                                                   // THROW
+
+        for (typename elements_type::const_iterator it = elements.begin();
+            it != elements.end(); ++it)
+        {
+            storage.nodes.push_back(flat_node(it->first));                                          // MAY THROW (A, C)
+            next_level.push_back(it->second);                                                       // MAY THROW (A)
+        }
+    }
+
+    inline void operator()(leaf const& n)
+    {
+        typedef typename rtree::elements_type<leaf>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        leafs_found = true;
+
+        storage.nodes[current].first = static_cast<index_type>(storage.values.size());
+        storage.nodes[current].count = static_cast<index_type>(elements.size());
+
+        for (typename elements_type::const_iterator it = elements.begin();
+            it != elements.end(); ++it)
+        {
+            storage.values.push_back(*it);                                                          // MAY THROW (A, C)
+        }
+    }
+
+    Storage & storage;
+    size_type current;
+    bool leafs_found;
+    std::vector<node_pointer> next_level;
+};
+
+} // namespace visitors
+
+// Copies the nodes and values of the R-tree level by level.
+template <typename Rtree, typename Storage> inline
+void copy(Rtree const& tree, Storage & storage)
+{
+    typedef utilities::view<Rtree> RTV;
+    typedef typename RTV::allocators_type::node_pointer node_pointer;
+    typedef typename Storage::nodes_type::value_type flat_node;
+    typedef typename Storage::size_type size_type;
+
+    storage.nodes.clear();
+    storage.values.clear();
+    storage.leafs_begin = 0;
+    storage.leafs_level = 0;
+
+    if ( tree.empty() )
+        return;
+
+    if ( (std::numeric_limits<typename flat_node::index_type>::max)() < tree.size() )
+        throw_length_error("too many values");                                                      // THROW
+
+    RTV rtv(tree);
+
+    visitors::copy_level<
+        typename RTV::value_type,
+        typename RTV::options_type,
+        typename RTV::box_type,
+        typename RTV::allocators_type,
+        Storage
+    > copy_v(storage);
+
+    storage.values.reserve(tree.size());                                                            // MAY THROW (A)
+    storage.nodes.push_back(flat_node(tree.bounds()));                                              // MAY THROW (A, C)
+
+    // root
+    rtv.apply_visitor(copy_v);
+
+    size_type level_begin = 0;
+    std::vector<node_pointer> current_level;
+    while ( !copy_v.leafs_found )
+    {
+        level_begin = storage.nodes.size() - copy_v.next_level.size();
+        current_level.swap(copy_v.next_level);
+        copy_v.next_level.clear();
+        ++storage.leafs_level;
+
+        for ( size_type i = 0 ; i < current_level.size() ; ++i )
+        {
+            copy_v.current = level_begin + i;
+            rtree::apply_visitor(copy_v, *current_level[i]);                                        // MAY THROW (A, C)
+        }
+    }
+
+    storage.leafs_begin = level_begin;
+}
+
+}}}}}} // namespace boost::geometry::index::detail::rtree::flat
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_NODES_HPP
@@ -0,0 +1,681 @@
+// Boost.Geometry Index
+//
+// Flat R-tree spatial and distance queries
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_QUERY_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_QUERY_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <boost/core/addressof.hpp>
+
+#include <boost/geometry/index/detail/predicates.hpp>
+#include <boost/geometry/index/detail/distance_predicates.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/distance_query.hpp>
+#include <boost/geometry/index/detail/rtree/query_iterators.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace flat {
+
+// The same algorithms as in visitors::spatial_query and visitors::distance_query
+// but the nodes are identified by indexes in the array of nodes.
+
+// The children of a flat node identified by the indexes of the nodes
+template <typename Nodes>
+struct node_children
+{
+    typedef typename Nodes::value_type::box_type bounds_type;
+    typedef typename Nodes::size_type node_type;
+    typedef typename Nodes::size_type child_type;
+
+    inline explicit node_children(Nodes const& n) : nodes(n) {}
+
+    inline bounds_type const& bounds(child_type i) const { return nodes[i].box; }
+    inline node_type node(child_type i) const { return i; }
+
+    Nodes const& nodes;
+};
+
+template <typename Storage, typename Translator, typename Predicates, typename OutIter>
+struct spatial_query
+{
+    typedef typename Storage::size_type size_type;
+    typedef typename Storage::nodes_type::value_type node_type;
+    typedef typename Storage::values_type::value_type value_type;
+
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+
+    inline spatial_query(Storage const& s, Translator const& t, Predicates const& p, OutIter out_it)
+        : storage(s), tr(t), pred(p), out_iter(out_it), found_count(0)
+    {}
+
+    inline void apply(size_type node_index)
+    {
+        node_type const& n = storage.nodes[node_index];
+
+        if ( storage.is_leaf(node_index) )
+        {
+            // get all values meeting predicates
+            for ( size_type i = n.first ; i < n.first + n.count ; ++i )
+            {
+                value_type const& v = storage.values[i];
+                if ( index::detail::predicates_check<index::detail::value_tag, 0, predicates_len>(pred, v, tr(v)) )
+                {
+                    *out_iter = v;
+                    ++out_iter;
+
+                    ++found_count;
+                }
+            }
+        }
+        else
+        {
+            // traverse nodes meeting predicates
+            for ( size_type i = n.first ; i < n.first + n.count ; ++i )
+            {
+                // 0 - dummy value
+                if ( index::detail::predicates_check<index::detail::bounds_tag, 0, predicates_len>(pred, 0, storage.nodes[i].box) )
+                    apply(i);
+            }
+        }
+    }
+
+    Storage const& storage;
+    Translator const& tr;
+
+    Predicates pred;
+
+    OutIter out_iter;
+    size_type found_count;
+};
+
+template <typename Storage, typename Translator, typename Predicates, unsigned DistancePredicateIndex, typename OutIter>
+class distance_query
+{
+public:
+    typedef typename Storage::size_type size_type;
+    typedef typename Storage::nodes_type nodes_type;
+    typedef typename Storage::nodes_type::value_type node_type;
+    typedef typename Storage::values_type::value_type value_type;
+    typedef typename node_type::box_type box_type;
+
+    typedef index::detail::predicates_element<DistancePredicateIndex, Predicates> nearest_predicate_access;
+    typedef typename nearest_predicate_access::type nearest_predicate_type;
+    typedef typename indexable_type<Translator>::type indexable_type;
+
+    typedef index::detail::calculate_distance<nearest_predicate_type, indexable_type, value_tag> calculate_value_distance;
+    typedef index::detail::calculate_distance<nearest_predicate_type, box_type, bounds_tag> calculate_node_distance;
+    typedef typename calculate_value_distance::result_type value_distance_type;
+    typedef typename calculate_node_distance::result_type node_distance_type;
+    typedef index::detail::calculate_node_distances<nearest_predicate_type, box_type> node_distances_type;
+
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+
+    inline distance_query(Storage const& s, size_type max_elements, Translator const& translator, Predicates const& pred, OutIter out_it)
+        : m_storage(s), m_translator(translator)
+        , m_pred(pred)
+        , m_result(nearest_predicate_access::get(m_pred).count, out_it)
+    {
+        // at most max elements of one node per level are stored at the same time,
+        // and never more than all nodes
+        size_type const levels = m_storage.leafs_level;
+        if ( 0 < levels )
+        {
+            size_type const per_level = (std::min)(max_elements, m_storage.nodes.size() / levels);
+            m_active_branches.reserve(per_level * levels);                                          // MAY THROW (A)
+        }
+    }
+
+    inline void apply(size_type node_index)
+    {
+        if ( m_storage.is_leaf(node_index) )
+            apply_leaf(node_index);
+        else
+            apply_internal(node_index);
+    }
+
+    inline size_t finish()
+    {
+        return m_result.finish();
+    }
+
+private:
+    typedef std::pair<node_distance_type, size_type> branch_data;
+
+    inline void apply_internal(size_type node_index)
+    {
+        node_type const& n = m_storage.nodes[node_index];
+
+        // active nodes of all levels are stored in one container,
+        // the ones of this node after the ones of its ancestors
+        size_type const abl_begin = m_active_branches.size();
+
+        // fill array of nodes meeting predicates,
+        // the distances of several children are calculated at once
+        node_distances_type node_distances(predicate());
+        node_children<nodes_type> children(m_storage.nodes);
+        rtree::visitors::branches_list<node_children<nodes_type>, std::vector<branch_data> > branches(children, m_active_branches);
+        near_batch::push_branches(m_pred, node_distances, size_type(n.first), size_type(n.first) + n.count,
+                                  m_result.has_enough_neighbors(), m_result.greatest_comparable_distance(),
+                                  branches);                                                       // MAY THROW (A)
+
+        size_type const abl_end = m_active_branches.size();
+
+        // if there aren't any nodes in ABL - return
+        if ( abl_begin == abl_end )
+            return;
+
+        // sort array
+        std::sort(m_active_branches.begin() + abl_begin, m_active_branches.end(), abl_less);
+
+        // recursively visit nodes
+        // the container may be reallocated by the descendants so the indexes are used
+        for ( size_type i = abl_begin ; i < abl_end ; ++i )
+        {
+            // if current node is further than furthest neighbor, the rest of nodes also will be further
+            if ( m_result.has_enough_neighbors() &&
+                 is_node_prunable(m_result.greatest_comparable_distance(), m_active_branches[i].first) )
+                break;
+
+            apply(m_active_branches[i].second);
+        }
+
+        m_active_branches.resize(abl_begin);
+    }
+
+    inline void apply_leaf(size_type node_index)
+    {
+        node_type const& n = m_storage.nodes[node_index];
+
+        // search leaf for closest value meeting predicates
+        for ( size_type i = n.first ; i < n.first + n.count ; ++i )
+        {
+            value_type const& v = m_storage.values[i];
+
+            // if value meets predicates
+            if ( index::detail::predicates_check<index::detail::value_tag, 0, predicates_len>(m_pred, v, m_translator(v)) )
+            {
+                // calculate values distance for distance predicate
+                value_distance_type value_distance;
+                // if distance is ok
+                if ( calculate_value_distance::apply(predicate(), m_translator(v), value_distance) )
+                {
+                    // store value
+                    m_result.store(v, value_distance);
+                }
+            }
+        }
+    }
+
+    static inline bool abl_less(branch_data const& p1, branch_data const& p2)
+    {
+        return p1.first < p2.first;
+    }
+
+    template <typename Distance>
+    static inline bool is_node_prunable(Distance const& greatest_dist, node_distance_type const& d)
+    {
+        return greatest_dist <= d;
+    }
+
+    nearest_predicate_type const& predicate() const
+    {
+        return nearest_predicate_access::get(m_pred);
+    }
+
+    Storage const& m_storage;
+    Translator const& m_translator;
+
+    Predicates m_pred;
+    rtree::visitors::distance_query_result<value_type, Translator, value_distance_type, OutIter> m_result;
+
+    std::vector<branch_data> m_active_branches;
+};
+
+// The same algorithms as in visitors::spatial_query_incremental and
+// visitors::distance_query_incremental used by the query iterators.
+
+template <typename Storage, typename Translator, typename Predicates>
+class spatial_query_incremental
+{
+public:
+    typedef typename Storage::size_type size_type;
+    typedef typename Storage::nodes_type::value_type node_type;
+    typedef typename Storage::values_type values_type;
+    typedef typename values_type::value_type value_type;
+    typedef typename values_type::const_reference const_reference;
+
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+
+    inline spatial_query_incremental()
+        : m_storage(NULL)
+        , m_translator(NULL)
+//        , m_pred()
+        , m_current(0)
+        , m_last(0)
+    {}
+
+    inline spatial_query_incremental(Storage const& s, Translator const& t, Predicates const& p)
+        : m_storage(::boost::addressof(s))
+        , m_translator(::boost::addressof(t))
+        , m_pred(p)
+        , m_current(0)
+        , m_last(0)
+    {}
+
+    const_reference dereference() const
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(m_current < m_last, "not dereferencable");
+        return m_storage->values[m_current];
+    }
+
+    void initialize(size_type root_index)
+    {
+        visit(root_index);
+        search_value();
+    }
+
+    void increment()
+    {
+        ++m_current;
+        search_value();
+    }
+
+    void search_value()
+    {
+        for (;;)
+        {
+            // if leaf is choosen, move to the next value in leaf
+            if ( m_current < m_last )
+            {
+                // return if next value is found
+                value_type const& v = m_storage->values[m_current];
+                if ( index::detail::predicates_check<index::detail::value_tag, 0, predicates_len>(m_pred, v, (*m_translator)(v)) )
+                    return;
+
+                ++m_current;
+            }
+            // if leaf isn't choosen, move to the next leaf
+            else
+            {
+                // return if there is no more nodes to traverse
+                if ( m_internal_stack.empty() )
+                    return;
+
+                // no more children in current node, remove it from stack
+                if ( m_internal_stack.back().first == m_internal_stack.back().second )
+                {
+                    m_internal_stack.pop_back();
+                    continue;
+                }
+
+                size_type const i = m_internal_stack.back().first;
+                ++m_internal_stack.back().first;
+
+                // next node is found, push it to the stack
+                // 0 - dummy value
+                if ( index::detail::predicates_check<index::detail::bounds_tag, 0, predicates_len>(m_pred, 0, m_storage->nodes[i].box) )
+                    visit(i);
+            }
+        }
+    }
+
+    bool is_end() const
+    {
+        return m_last <= m_current;
+    }
+
+    friend bool operator==(spatial_query_incremental const& l, spatial_query_incremental const& r)
+    {
+        return l.is_end() ? r.is_end() : (!r.is_end() && l.m_current == r.m_current);
+    }
+
+private:
+    // the children of a node are pushed to the stack,
+    // the range of values of a leaf becomes the current one
+    inline void visit(size_type node_index)
+    {
+        node_type const& n = m_storage->nodes[node_index];
+
+        if ( m_storage->is_leaf(node_index) )
+        {
+            m_current = n.first;
+            m_last = n.first + n.count;
+        }
+        else
+        {
+            m_internal_stack.push_back(std::make_pair(size_type(n.first), size_type(n.first + n.count)));  // MAY THROW (A)
+        }
+    }
+
+    const Storage * m_storage;
+    const Translator * m_translator;
+
+    Predicates m_pred;
+
+    std::vector< std::pair<size_type, size_type> > m_internal_stack;
+    size_type m_current;
+    size_type m_last;
+};
+
+template <typename Storage, typename Translator, typename Predicates, unsigned DistancePredicateIndex>
+class distance_query_incremental
+{
+public:
+    typedef typename Storage::size_type size_type;
+    typedef typename Storage::nodes_type nodes_type;
+    typedef typename Storage::nodes_type::value_type node_type;
+    typedef typename Storage::values_type values_type;
+    typedef typename values_type::value_type value_type;
+    typedef typename values_type::const_reference const_reference;
+    typedef typename node_type::box_type box_type;
+
+    typedef index::detail::predicates_element<DistancePredicateIndex, Predicates> nearest_predicate_access;
+    typedef typename nearest_predicate_access::type nearest_predicate_type;
+    typedef typename indexable_type<Translator>::type indexable_type;
+
+    typedef index::detail::calculate_distance<nearest_predicate_type, indexable_type, value_tag> calculate_value_distance;
+    typedef index::detail::calculate_distance<nearest_predicate_type, box_type, bounds_tag> calculate_node_distance;
+    typedef typename calculate_value_distance::result_type value_distance_type;
+    typedef typename calculate_node_distance::result_type node_distance_type;
+    typedef index::detail::calculate_node_distances<nearest_predicate_type, box_type> node_distances_type;
+
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+
+    typedef rtree::visitors::distance_query_branch<node_distance_type, size_type> branch_data;
+    typedef std::vector<branch_data> branches_type;
+
+    inline distance_query_incremental()
+        : m_storage(NULL)
+        , m_translator(NULL)
+//        , m_pred()
+        , current_neighbor((std::numeric_limits<size_type>::max)())
+        , current_level(0)
+    {}
+
+    inline distance_query_incremental(Storage const& s, Translator const& translator, Predicates const& pred)
+        : m_storage(::boost::addressof(s))
+        , m_translator(::boost::addressof(translator))
+        , m_pred(pred)
+        , current_neighbor((std::numeric_limits<size_type>::max)())
+        , current_level(0)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(0 < max_count(), "k must be greather than 0");
+    }
+
+    const_reference dereference() const
+    {
+        return m_storage->values[neighbors[current_neighbor].second];
+    }
+
+    void initialize(size_type root_index)
+    {
+        visit(root_index);
+        increment();
+    }
+
+    void increment()
+    {
+        for (;;)
+        {
+            size_type new_neighbor = current_neighbor == (std::numeric_limits<size_type>::max)() ? 0 : current_neighbor + 1;
+
+            if ( branches.empty() )
+            {
+                if ( new_neighbor < neighbors.size() )
+                    current_neighbor = new_neighbor;
+                else
+                {
+                    current_neighbor = (std::numeric_limits<size_type>::max)();
+                    // clear() is used to disable the condition above
+                    neighbors.clear();
+                }
+
+                return;
+            }
+            else
+            {
+                // the closest of all not visited nodes
+                branch_data const& closest_branch = branches.front();
+
+                // if there are no nodes which can have closer values, set new value
+                if ( new_neighbor < neighbors.size() &&
+                     // here must be < because otherwise neighbours may be sorted in different order
+                     // if there is another value with equal distance
+                     neighbors[new_neighbor].first < closest_branch.distance )
+                {
+                    current_neighbor = new_neighbor;
+                    return;
+                }
+
+                // if the closest node is further than the furthest neighbour, all other nodes also will be further
+                BOOST_GEOMETRY_INDEX_ASSERT(neighbors.size() <= max_count(), "unexpected neighbours count");
+                if ( max_count() <= neighbors.size() &&
+                     is_node_prunable(neighbors.back().first, closest_branch.distance) )
+                {
+                    branches.clear();
+                    continue;
+                }
+                else
+                {
+                    size_type node_index = closest_branch.ptr;
+                    current_level = closest_branch.level;
+                    std::pop_heap(branches.begin(), branches.end(), branch_data::greater);
+                    branches.pop_back();
+
+                    visit(node_index);
+                }
+            }
+        }
+    }
+
+    bool is_end() const
+    {
+        return (std::numeric_limits<size_type>::max)() == current_neighbor;
+    }
+
+    friend bool operator==(distance_query_incremental const& l, distance_query_incremental const& r)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(l.current_neighbor != r.current_neighbor ||
+                                    (std::numeric_limits<size_type>::max)() == l.current_neighbor ||
+                                    (std::numeric_limits<size_type>::max)() == r.current_neighbor ||
+                                    l.neighbors[l.current_neighbor].second == r.neighbors[r.current_neighbor].second,
+                                    "not corresponding iterators");
+        return l.current_neighbor == r.current_neighbor;
+    }
+
+private:
+    typedef std::pair<value_distance_type, size_type> neighbor_data;
+
+    inline void visit(size_type node_index)
+    {
+        if ( m_storage->is_leaf(node_index) )
+            visit_leaf(node_index);
+        else
+            visit_internal(node_index);
+    }
+
+    // Put node's children into the priority queue of active branches if those children meets predicates
+    // and aren't further than found neighbours (if there is enough neighbours)
+    inline void visit_internal(size_type node_index)
+    {
+        node_type const& n = m_storage->nodes[node_index];
+
+        // the distances of several children are calculated at once
+        bool const enough_neighbors = max_count() <= neighbors.size();
+        value_distance_type const greatest_distance = enough_neighbors
+            ? neighbors.back().first
+            : (std::numeric_limits<value_distance_type>::max)();
+
+        node_distances_type node_distances(predicate());
+        node_children<nodes_type> children(m_storage->nodes);
+        rtree::visitors::branches_heap<node_children<nodes_type>, branches_type> queue(children, branches, current_level + 1);
+        near_batch::push_branches(m_pred, node_distances, size_type(n.first), size_type(n.first) + n.count,
+                                  enough_neighbors, greatest_distance, queue);                     // MAY THROW (A)
+    }
+
+    // Put values into the list of neighbours if those values meets predicates
+    // and aren't further than already found neighbours (if there is enough neighbours)
+    inline void visit_leaf(size_type node_index)
+    {
+        node_type const& n = m_storage->nodes[node_index];
+
+        // store distance to the furthest neighbour
+        bool not_enough_neighbors = neighbors.size() < max_count();
+        value_distance_type greatest_distance = !not_enough_neighbors ? neighbors.back().first : (std::numeric_limits<value_distance_type>::max)();
+
+        // search leaf for closest value meeting predicates
+        for ( size_type i = n.first ; i < n.first + n.count ; ++i )
+        {
+            value_type const& v = m_storage->values[i];
+
+            // if value meets predicates
+            if ( index::detail::predicates_check<index::detail::value_tag, 0, predicates_len>(m_pred, v, (*m_translator)(v)) )
+            {
+                // calculate values distance for distance predicate
+                value_distance_type value_distance;
+                // if distance is ok
+                if ( calculate_value_distance::apply(predicate(), (*m_translator)(v), value_distance) )
+                {
+                    // if there is not enough values or current value is closer than furthest neighbour
+                    if ( not_enough_neighbors || value_distance < greatest_distance )
+                    {
+                        neighbors.push_back(neighbor_data(value_distance, i));                             // MAY THROW (A)
+                    }
+                }
+            }
+        }
+
+        // sort array
+        std::sort(neighbors.begin(), neighbors.end(), neighbors_less);
+        // remove furthest values
+        if ( max_count() < neighbors.size() )
+            neighbors.resize(max_count());
+    }
+
+    static inline bool neighbors_less(neighbor_data const& p1, neighbor_data const& p2)
+    {
+        return p1.first < p2.first;
+    }
+
+    template <typename Distance>
+    static inline bool is_node_prunable(Distance const& greatest_dist, node_distance_type const& d)
+    {
+        return greatest_dist <= d;
+    }
+
+    inline unsigned max_count() const
+    {
+        return nearest_predicate_access::get(m_pred).count;
+    }
+
+    nearest_predicate_type const& predicate() const
+    {
+        return nearest_predicate_access::get(m_pred);
+    }
+
+    const Storage * m_storage;
+    const Translator * m_translator;
+
+    Predicates m_pred;
+
+    // the priority queue of branches, the closest one in front
+    branches_type branches;
+    // the values are identified by indexes in the array of values
+    std::vector<neighbor_data> neighbors;
+    size_type current_neighbor;
+    size_t current_level;
+};
+
+// The query iterator using one of the incremental queries above. It may be
+// compared with iterators::end_query_iterator and wrapped by
+// iterators::query_iterator like the iterators of the R-tree.
+template <typename Visitor>
+class query_iterator
+{
+    typedef typename Visitor::values_type values_type;
+    typedef typename Visitor::size_type size_type;
+
+public:
+    typedef Visitor visitor_type;
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename values_type::value_type value_type;
+    typedef typename values_type::const_reference reference;
+    typedef typename values_type::difference_type difference_type;
+    typedef typename values_type::const_pointer pointer;
+
+    typedef iterators::end_query_iterator<value_type, values_type> end_iterator;
+
+    inline query_iterator()
+    {}
+
+    inline explicit query_iterator(Visitor const& v)
+        : m_visitor(v)
+    {}
+
+    inline query_iterator(Visitor const& v, size_type root_index)
+        : m_visitor(v)
+    {
+        m_visitor.initialize(root_index);
+    }
+
+    reference operator*() const
+    {
+        return m_visitor.dereference();
+    }
+
+    const value_type * operator->() const
+    {
+        return boost::addressof(m_visitor.dereference());
+    }
+
+    query_iterator & operator++()
+    {
+        m_visitor.increment();
+        return *this;
+    }
+
+    query_iterator operator++(int)
+    {
+        query_iterator temp = *this;
+        this->operator++();
+        return temp;
+    }
+
+    friend bool operator==(query_iterator const& l, query_iterator const& r)
+    {
+        return l.m_visitor == r.m_visitor;
+    }
+
+    friend bool operator==(query_iterator const& l, end_iterator const& /*r*/)
+    {
+        return l.m_visitor.is_end();
+    }
+
+    friend bool operator==(end_iterator const& /*l*/, query_iterator const& r)
+    {
+        return r.m_visitor.is_end();
+    }
+
+    friend bool operator!=(query_iterator const& l, query_iterator const& r)
+    {
+        return !(l == r);
+    }
+
+private:
+    Visitor m_visitor;
+};
+
+}}}}}} // namespace boost::geometry::index::detail::rtree::flat
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_QUERY_HPP
@@ -0,0 +1,44 @@
+// Boost.Geometry Index
+//
+// Flat R-tree view
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_VIEW_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_VIEW_HPP
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace flat {
+
+template <typename FlatRtree>
+class view
+{
+public:
+    typedef typename FlatRtree::storage_type storage_type;
+    typedef typename FlatRtree::translator_type translator_type;
+
+    view(FlatRtree const& t) : m_tree(t) {}
+
+    storage_type const& storage() const
+    {
+        return m_tree.m_storage;
+    }
+
+    translator_type const& translator() const
+    {
+        return m_tree.m_translator;
+    }
+
+private:
+    view(view const&);
+    view & operator=(view const&);
+
+    FlatRtree const& m_tree;
+};
+
+}}}}}} // namespace boost::geometry::index::detail::rtree::flat
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_VIEW_HPP
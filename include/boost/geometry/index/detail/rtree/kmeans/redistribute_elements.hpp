@@ -0,0 +1,338 @@
+// Boost.Geometry Index
+//
+// R-tree kmeans split algorithm implementation
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
+
+#include <boost/geometry/algorithms/comparable_distance.hpp>
+#include <boost/geometry/arithmetic/arithmetic.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/util/select_most_precise.hpp>
+
+#include <boost/geometry/index/detail/algorithms/bounds.hpp>
+
+#include <boost/geometry/index/detail/rtree/node/node.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/insert.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/is_leaf.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+namespace kmeans {
+
+// The elements are split into 2 clusters using Lloyd's algorithm.
+// Each element is represented by the center of its bounds. The centers of the
+// clusters are initialized with the element farthest from the mean of all
+// elements and the element farthest from it. In each iteration the elements
+// are assigned to the closer cluster, then if a cluster contains less than
+// min elements, the elements of the other cluster for which the difference of
+// distances to the centers is the smallest are moved to it. The iterations
+// are stopped if the assignment doesn't change or after max iterations
+// of the parameters.
+
+template <typename Box>
+struct center_type
+{
+    typedef typename geometry::select_most_precise
+        <
+            typename geometry::coordinate_type<Box>::type,
+            double
+        >::type calculation_type;
+
+    // the coordinates are analyzed as cartesian, like in other split algorithms
+    typedef geometry::model::point
+        <
+            calculation_type,
+            geometry::dimension<Box>::value,
+            geometry::cs::cartesian
+        > type;
+};
+
+template <size_t I, size_t Dimension>
+struct assign_center
+{
+    template <typename Box, typename Point>
+    static inline void apply(Box const& box, Point & center)
+    {
+        typedef typename geometry::coordinate_type<Point>::type calculation_type;
+
+        calculation_type const min_c = static_cast<calculation_type>(geometry::get<min_corner, I>(box));
+        calculation_type const max_c = static_cast<calculation_type>(geometry::get<max_corner, I>(box));
+        geometry::set<I>(center, min_c + (max_c - min_c) / 2);
+
+        assign_center<I + 1, Dimension>::apply(box, center);
+    }
+};
+
+template <size_t Dimension>
+struct assign_center<Dimension, Dimension>
+{
+    template <typename Box, typename Point>
+    static inline void apply(Box const& , Point & ) {}
+};
+
+template <typename Box, typename Elements, typename Translator, typename Centers>
+inline void calculate_centers(Elements const& elements, Translator const& tr, Centers & centers)
+{
+    typedef typename Centers::value_type center_type;
+
+    for ( typename Elements::const_iterator it = elements.begin() ; it != elements.end() ; ++it )
+    {
+        Box box;
+        detail::bounds(rtree::element_indexable(*it, tr), box);
+
+        center_type center;
+        assign_center<0, geometry::dimension<Box>::value>::apply(box, center);
+        centers.push_back(center);                                                                  // MAY THROW (alloc)
+    }
+}
+
+template <typename Centers, typename Point>
+inline size_t farthest_center(Centers const& centers, Point const& point)
+{
+    typedef typename geometry::coordinate_type<Point>::type calculation_type;
+
+    size_t result = 0;
+    calculation_type greatest_distance = 0;
+    for ( size_t i = 0 ; i < centers.size() ; ++i )
+    {
+        calculation_type d = geometry::comparable_distance(centers[i], point);
+        if ( greatest_distance < d )
+        {
+            greatest_distance = d;
+            result = i;
+        }
+    }
+    return result;
+}
+
+template <typename Centers, typename Groups, typename Point>
+inline void calculate_means(Centers const& centers, Groups const& groups, Point & mean1, Point & mean2)
+{
+    typedef typename geometry::coordinate_type<Point>::type calculation_type;
+
+    geometry::assign_zero(mean1);
+    geometry::assign_zero(mean2);
+    size_t count1 = 0;
+
+    for ( size_t i = 0 ; i < centers.size() ; ++i )
+    {
+        if ( groups[i] == 0 )
+        {
+            geometry::add_point(mean1, centers[i]);
+            ++count1;
+        }
+        else
+        {
+            geometry::add_point(mean2, centers[i]);
+        }
+    }
+
+    BOOST_GEOMETRY_INDEX_ASSERT(0 < count1 && count1 < centers.size(), "unexpected clusters");
+    geometry::divide_value(mean1, static_cast<calculation_type>(count1));
+    geometry::divide_value(mean2, static_cast<calculation_type>(centers.size() - count1));
+}
+
+// Moves the element of group From for which the difference of distances
+// to the mean of group To and the mean of group From is the smallest.
+template <typename Centers, typename Groups, typename Point>
+inline void move_closest(Centers const& centers, Groups & groups,
+                         size_t from, Point const& mean_from, Point const& mean_to)
+{
+    typedef typename geometry::coordinate_type<Point>::type calculation_type;
+
+    size_t best_index = centers.size();
+    calculation_type smallest_cost = 0;
+    for ( size_t i = 0 ; i < centers.size() ; ++i )
+    {
+        if ( groups[i] != from )
+            continue;
+
+        calculation_type cost = geometry::comparable_distance(centers[i], mean_to)
+                              - geometry::comparable_distance(centers[i], mean_from);
+        if ( best_index == centers.size() || cost < smallest_cost )
+        {
+            best_index = i;
+            smallest_cost = cost;
+        }
+    }
+
+    BOOST_GEOMETRY_INDEX_ASSERT(best_index < centers.size(), "element not found");
+    groups[best_index] = from == 0 ? 1 : 0;
+}
+
+// Returns true if the assignment was changed
+template <typename Centers, typename Groups, typename Point>
+inline bool assign_groups(Centers const& centers, Groups & groups,
+                          Point const& mean1, Point const& mean2,
+                          size_t min_elements)
+{
+    bool changed = false;
+    size_t count1 = 0;
+
+    for ( size_t i = 0 ; i < centers.size() ; ++i )
+    {
+        size_t const group = geometry::comparable_distance(centers[i], mean1)
+                          <= geometry::comparable_distance(centers[i], mean2) ? 0 : 1;
+        if ( groups[i] != group )
+        {
+            groups[i] = group;
+            changed = true;
+        }
+        if ( group == 0 )
+            ++count1;
+    }
+
+    size_t count2 = centers.size() - count1;
+
+    for ( ; count1 < min_elements ; ++count1, --count2 )
+    {
+        move_closest(centers, groups, 1, mean2, mean1);
+        changed = true;
+    }
+    for ( ; count2 < min_elements ; ++count2, --count1 )
+    {
+        move_closest(centers, groups, 0, mean1, mean2);
+        changed = true;
+    }
+
+    return changed;
+}
+
+template <typename Centers, typename Groups, typename Parameters>
+inline void cluster(Centers const& centers, Parameters const& parameters, Groups & groups)
+{
+    typedef typename Centers::value_type point_type;
+    typedef typename geometry::coordinate_type<point_type>::type calculation_type;
+
+    BOOST_GEOMETRY_INDEX_ASSERT(2 <= centers.size(), "unexpected number of elements");
+
+    // calculate initial seeds
+    point_type mean;
+    geometry::assign_zero(mean);
+    for ( size_t i = 0 ; i < centers.size() ; ++i )
+        geometry::add_point(mean, centers[i]);
+    geometry::divide_value(mean, static_cast<calculation_type>(centers.size()));
+
+    size_t seed1 = farthest_center(centers, mean);
+    size_t seed2 = farthest_center(centers, centers[seed1]);
+    if ( seed1 == seed2 )
+    {
+        // all centers are equal
+        seed2 = seed1 == 0 ? 1 : 0;
+    }
+
+    point_type mean1 = centers[seed1];
+    point_type mean2 = centers[seed2];
+
+    for ( size_t i = 0 ; i < centers.size() ; ++i )
+        groups.push_back(2);                                                                        // MAY THROW (alloc)
+
+    size_t const max_iterations = parameters.get_max_iterations();
+    for ( size_t iteration = 0 ; iteration < max_iterations ; ++iteration )
+    {
+        if ( ! assign_groups(centers, groups, mean1, mean2, parameters.get_min_elements()) )
+            break;
+
+        calculate_means(centers, groups, mean1, mean2);
+    }
+}
+
+} // namespace kmeans
+
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators>
+struct redistribute_elements<Value, Options, Translator, Box, Allocators, kmeans_tag>
+{
+    typedef typename Options::parameters_type parameters_type;
+
+    typedef typename rtree::node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type node;
+    typedef typename rtree::internal_node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    template <typename Node>
+    static inline void apply(Node & n,
+                             Node & second_node,
+                             Box & box1,
+                             Box & box2,
+                             parameters_type const& parameters,
+                             Translator const& translator,
+                             Allocators & allocators)
+    {
+        typedef typename rtree::elements_type<Node>::type elements_type;
+        typedef typename elements_type::value_type element_type;
+        typedef typename kmeans::center_type<Box>::type center_type;
+
+        elements_type & elements1 = rtree::elements(n);
+        elements_type & elements2 = rtree::elements(second_node);
+        const size_t elements1_count = parameters.get_max_elements() + 1;
+
+        BOOST_GEOMETRY_INDEX_ASSERT(elements1.size() == elements1_count, "unexpected number of elements");
+
+        // copy original elements - use in-memory storage (std::allocator)
+        typedef typename rtree::container_from_elements_type<elements_type, element_type>::type
+            container_type;
+        container_type elements_copy(elements1.begin(), elements1.end());                                   // MAY THROW, STRONG (alloc, copy)
+
+        // calculate clusters
+        typename rtree::container_from_elements_type<elements_type, center_type>::type centers;
+        typename rtree::container_from_elements_type<elements_type, size_t>::type groups;
+        kmeans::calculate_centers<Box>(elements_copy, translator, centers);                                // MAY THROW, STRONG (alloc)
+        kmeans::cluster(centers, parameters, groups);                                                       // MAY THROW, STRONG (alloc)
+
+        // prepare nodes' elements containers
+        elements1.clear();
+        BOOST_GEOMETRY_INDEX_ASSERT(elements2.empty(), "unexpected container state");
+
+        BOOST_TRY
+        {
+            for ( size_t i = 0 ; i < elements1_count ; ++i )
+            {
+                element_type const& elem = elements_copy[i];
+
+                if ( groups[i] == 0 )
+                {
+                    if ( elements1.empty() )
+                        detail::bounds(rtree::element_indexable(elem, translator), box1);
+                    else
+                        geometry::expand(box1, rtree::element_indexable(elem, translator));
+
+                    elements1.push_back(elem);                                                              // MAY THROW, STRONG (copy)
+                }
+                else
+                {
+                    if ( elements2.empty() )
+                        detail::bounds(rtree::element_indexable(elem, translator), box2);
+                    else
+                        geometry::expand(box2, rtree::element_indexable(elem, translator));
+
+                    elements2.push_back(elem);                                                              // MAY THROW, STRONG (alloc, copy)
+                }
+            }
+        }
+        BOOST_CATCH(...)
+        {
+            elements1.clear();
+            elements2.clear();
+
+            rtree::destroy_elements<Value, Options, Translator, Box, Allocators>::apply(elements_copy, allocators);
+            //elements_copy.clear();
+
+            BOOST_RETHROW                                                                                     // RETHROW, BASIC
+        }
+        BOOST_CATCH_END
+    }
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
@@ -27,12 +27,12 @@ struct choose_by_overlap_diff_tag {};
 
 // SplitTag
 struct split_default_tag {};
-//struct split_kmeans_tag {};
 
 // RedistributeTag
 struct linear_tag {};
 struct quadratic_tag {};
 struct rstar_tag {};
+struct kmeans_tag {};
 
 // NodeTag
 struct node_variant_dynamic_tag {};
@@ -96,18 +96,18 @@ struct options_type< index::rstar<MaxElements, MinElements, OverlapCostThreshold
     > type;
 };
 
-//template <size_t MaxElements, size_t MinElements>
-//struct options_type< kmeans<MaxElements, MinElements> >
-//{
-//    typedef options<
-//        kmeans<MaxElements, MinElements>,
-//        insert_default_tag,
-//        choose_by_content_diff_tag, // change it?
-//        split_kmeans_tag,
-//        int, // dummy tag - not used for now
-//        node_variant_static_tag
-//    > type;
-//};
+template <size_t MaxElements, size_t MinElements, size_t MaxIterations>
+struct options_type< index::kmeans<MaxElements, MinElements, MaxIterations> >
+{
+    typedef options<
+        index::kmeans<MaxElements, MinElements, MaxIterations>,
+        insert_default_tag,
+        choose_by_content_diff_tag,
+        split_default_tag,
+        kmeans_tag,
+        node_variant_static_tag
+    > type;
+};
 
 template <>
 struct options_type< index::dynamic_linear >
@@ -148,6 +148,19 @@ struct options_type< index::dynamic_rstar >
     > type;
 };
 
+template <>
+struct options_type< index::dynamic_kmeans >
+{
+    typedef options<
+        index::dynamic_kmeans,
+        insert_default_tag,
+        choose_by_content_diff_tag,
+        split_default_tag,
+        kmeans_tag,
+        node_variant_dynamic_tag
+    > type;
+};
+
 }} // namespace detail::rtree
 
 }}} // namespace boost::geometry::index
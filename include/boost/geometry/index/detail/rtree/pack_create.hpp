@@ -16,6 +16,10 @@
 
 #include <boost/geometry/algorithms/detail/expand_by_epsilon.hpp>
 
+#include <boost/geometry/index/packing.hpp>
+
+#include <boost/geometry/util/parallel.hpp>
+
 namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree {
 
 namespace pack_utils {
@@ -90,6 +94,64 @@ struct nth_element_and_half_boxes<Dimension, Dimension>
     static inline void apply(EIt , EIt , EIt , Box const& , Box & , Box & , std::size_t ) {}
 };
 
+// The entries sorted along a space-filling curve are only divided,
+// the hint box isn't used.
+template <typename Curve, std::size_t Dimension>
+struct split_entries
+{
+    template <typename EIt, typename Box>
+    static inline void apply(EIt , EIt , EIt , Box const& hint_box, Box & left, Box & right)
+    {
+        geometry::convert(hint_box, left);
+        geometry::convert(hint_box, right);
+    }
+};
+
+template <std::size_t Dimension>
+struct split_entries<void, Dimension>
+{
+    template <typename EIt, typename Box>
+    static inline void apply(EIt first, EIt median, EIt last, Box const& hint_box, Box & left, Box & right)
+    {
+        typename coordinate_type<Box>::type greatest_length;
+        std::size_t greatest_dim_index = 0;
+        biggest_edge<Dimension>::apply(hint_box, greatest_length, greatest_dim_index);
+        nth_element_and_half_boxes<0, Dimension>
+            ::apply(first, median, last, hint_box, left, right, greatest_dim_index);
+    }
+};
+
+template <typename Curve>
+struct sort_entries
+{
+    template <typename Entries, typename Box>
+    static inline void apply(Entries & entries, Box const& bounds)
+    {
+        // sort the keys with indexes of entries and then reorder the entries
+        typedef std::pair<boost::uint64_t, std::size_t> keyed_index;
+
+        std::vector<keyed_index> keys;
+        keys.reserve(entries.size());                                                               // MAY THROW (A)
+        for ( std::size_t i = 0 ; i < entries.size() ; ++i )
+            keys.push_back(keyed_index(Curve::apply(entries[i].first, bounds), i));
+
+        std::sort(keys.begin(), keys.end());
+
+        Entries sorted;
+        sorted.reserve(entries.size());                                                             // MAY THROW (A)
+        for ( std::size_t i = 0 ; i < keys.size() ; ++i )
+            sorted.push_back(entries[keys[i].second]);
+        entries.swap(sorted);
+    }
+};
+
+template <>
+struct sort_entries<void>
+{
+    template <typename Entries, typename Box>
+    static inline void apply(Entries & , Box const& ) {}
+};
+
 } // namespace pack_utils
 
 // STR leafs number are calculated as rcount/max
@@ -118,8 +180,25 @@ struct nth_element_and_half_boxes<Dimension, Dimension>
 // L1          125               52
 // L2  25  25  25  25  25   25  17    10
 // L3  5x5 5x5 5x5 5x5 5x5  5x5 3x5+2 2x5
+//
+// Parallel packing
+//
+// After the median split the two halves of the range are independent so they
+// may be packed by different threads. The left half is packed as a task into
+// a separate container, the right half by the current thread, and the results
+// are appended in the same order as in the sequential version, so the resulting
+// tree is exactly the same. Nodes are created concurrently so the Allocator
+// must be safe to use from multiple threads.
+//
+// Space-filling curve packing
+//
+// The entries are sorted by the position of their centroids on the Hilbert
+// or Z-order curve and then divided at the same median counts as above without
+// further sorting. So the leafs contain consecutive runs of values along the curve
+// and the number of elements in nodes is guaranteed to be between Min and Max.
 
-template <typename Value, typename Options, typename Translator, typename Box, typename Allocators>
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators,
+          typename Packing = default_packing_tag>
 class pack
 {
     typedef typename rtree::node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type node;
@@ -136,6 +215,8 @@ class pack
     typedef typename Options::parameters_type parameters_type;
     static const std::size_t dimension = geometry::dimension<point_type>::value;
 
+    typedef typename packing_curve<Packing>::type curve_type;
+
     typedef typename rtree::container_from_elements_type<
         typename rtree::elements_type<leaf>::type,
         std::size_t
@@ -148,7 +229,8 @@ public:
     // Arbitrary iterators
     template <typename InIt> inline static
     node_pointer apply(InIt first, InIt last, size_type & values_count, size_type & leafs_level,
-                       parameters_type const& parameters, Translator const& translator, Allocators & allocators)
+                       parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                       std::size_t threads = 1)
     {
         typedef typename std::iterator_traits<InIt>::difference_type diff_type;
             
@@ -183,14 +265,23 @@ public:
             entries.push_back(std::make_pair(pt, first));
         }
 
+        pack_utils::sort_entries<curve_type>::apply(entries, hint_box.get());                       // MAY THROW (A)
+
         subtree_elements_counts subtree_counts = calculate_subtree_elements_counts(values_count, parameters, leafs_level);
-        internal_element el = per_level(entries.begin(), entries.end(), hint_box.get(), values_count, subtree_counts,
-                                        parameters, translator, allocators);
 
-        return el.second;
+        typedef typename std::vector<entry_type>::iterator entries_iterator;
+        per_level_task<entries_iterator> root_task(entries.begin(), entries.end(), hint_box.get(), values_count, subtree_counts,
+                                                   parameters, translator, allocators, threads);
+        geometry::detail::parallel::run_team(root_task, threads);                                         // MAY THROW (A, C)
+
+        return root_task.result.second;
     }
 
 private:
+    // Minimal number of values for which the packing of a subtree is processed
+    // as a separate task. For smaller ranges the overhead isn't worth it.
+    static const std::size_t parallel_values_threshold = 4096;
+
     template <typename BoxType>
     class expandable_box
     {
@@ -241,7 +332,8 @@ private:
 
     template <typename EIt> inline static
     internal_element per_level(EIt first, EIt last, Box const& hint_box, std::size_t values_count, subtree_elements_counts const& subtree_counts,
-                               parameters_type const& parameters, Translator const& translator, Allocators & allocators)
+                               parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                               std::size_t threads)
     {
         BOOST_GEOMETRY_INDEX_ASSERT(0 < std::distance(first, last) && static_cast<std::size_t>(std::distance(first, last)) == values_count,
                                     "unexpected parameters");
@@ -310,19 +402,20 @@ private:
         
         per_level_packets(first, last, hint_box, values_count, subtree_counts, next_subtree_counts,
                           rtree::elements(in), elements_box,
-                          parameters, translator, allocators);
+                          parameters, translator, allocators, threads);
 
         auto_remover.release();
         return internal_element(elements_box.get(), n);
     }
 
-    template <typename EIt, typename ExpandableBox> inline static
+    template <typename EIt, typename Elements, typename ExpandableBox> inline static
     void per_level_packets(EIt first, EIt last, Box const& hint_box,
                            std::size_t values_count,
                            subtree_elements_counts const& subtree_counts,
                            subtree_elements_counts const& next_subtree_counts,
-                           internal_elements & elements, ExpandableBox & elements_box,
-                           parameters_type const& parameters, Translator const& translator, Allocators & allocators)
+                           Elements & elements, ExpandableBox & elements_box,
+                           parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                           std::size_t threads)
     {
         BOOST_GEOMETRY_INDEX_ASSERT(0 < std::distance(first, last) && static_cast<std::size_t>(std::distance(first, last)) == values_count,
                                     "unexpected parameters");
@@ -335,7 +428,7 @@ private:
         {
             // the end, move to the next level
             internal_element el = per_level(first, last, hint_box, values_count, next_subtree_counts,
-                                            parameters, translator, allocators);
+                                            parameters, translator, allocators, threads);
 
             // in case if push_back() do throw here
             // and even if this is not probable (previously reserved memory, nonthrowing pairs copy)
@@ -352,21 +445,158 @@ private:
         std::size_t median_count = calculate_median_count(values_count, subtree_counts);
         EIt median = first + median_count;
 
-        coordinate_type greatest_length;
-        std::size_t greatest_dim_index = 0;
-        pack_utils::biggest_edge<dimension>::apply(hint_box, greatest_length, greatest_dim_index);
         Box left, right;
-        pack_utils::nth_element_and_half_boxes<0, dimension>
-            ::apply(first, median, last, hint_box, left, right, greatest_dim_index);
+        pack_utils::split_entries<curve_type, dimension>
+            ::apply(first, median, last, hint_box, left, right);
         
+        if ( 1 < threads && parallel_values_threshold <= values_count )
+        {
+            per_level_packets_parallel(first, median, last, left, right,
+                                       median_count, values_count - median_count,
+                                       subtree_counts, next_subtree_counts,
+                                       elements, elements_box,
+                                       parameters, translator, allocators, threads);
+            return;
+        }
+
         per_level_packets(first, median, left,
                           median_count, subtree_counts, next_subtree_counts,
                           elements, elements_box,
-                          parameters, translator, allocators);
+                          parameters, translator, allocators, 1);
         per_level_packets(median, last, right,
                           values_count - median_count, subtree_counts, next_subtree_counts,
                           elements, elements_box,
-                          parameters, translator, allocators);
+                          parameters, translator, allocators, 1);
+    }
+
+    // elements of the internal node created in a task,
+    // destroys the subtrees in case of an exception
+    class packets_container
+    {
+        packets_container(packets_container const&);
+        packets_container & operator=(packets_container const&);
+
+    public:
+        explicit packets_container(Allocators & allocators)
+            : m_allocators(allocators)
+        {}
+
+        ~packets_container()
+        {
+            for ( typename std::vector<internal_element>::iterator it = m_elements.begin() ;
+                  it != m_elements.end() ; ++it )
+            {
+                subtree_destroyer dummy(it->second, m_allocators);
+            }
+        }
+
+        void push_back(internal_element const& el)
+        {
+            m_elements.push_back(el);                                                           // MAY THROW (A)
+        }
+
+        template <typename Elements, typename ExpandableBox>
+        void move_to(Elements & elements, ExpandableBox & elements_box)
+        {
+            while ( !m_elements.empty() )
+            {
+                // this container should have memory allocated, reserve() called outside
+                elements.push_back(m_elements.front());                                         // MAY THROW (A?,C) - however in normal conditions shouldn't
+                elements_box.expand(m_elements.front().first);
+                m_elements.erase(m_elements.begin());
+            }
+        }
+
+    private:
+        std::vector<internal_element> m_elements;
+        Allocators & m_allocators;
+    };
+
+    template <typename EIt>
+    struct per_level_packets_task
+    {
+        per_level_packets_task(EIt f, EIt l, Box const& hb, std::size_t vc,
+                               subtree_elements_counts const& sc, subtree_elements_counts const& nsc,
+                               parameters_type const& p, Translator const& t, Allocators & a, std::size_t th)
+            : first(f), last(l), hint_box(hb), values_count(vc)
+            , subtree_counts(sc), next_subtree_counts(nsc)
+            , parameters(p), translator(t), allocators(a), threads(th)
+            , elements(a)
+        {}
+
+        void operator()()
+        {
+            per_level_packets(first, last, hint_box, values_count, subtree_counts, next_subtree_counts,
+                              elements, elements_box,
+                              parameters, translator, allocators, threads);
+        }
+
+        EIt first, last;
+        Box const& hint_box;
+        std::size_t values_count;
+        subtree_elements_counts const& subtree_counts;
+        subtree_elements_counts const& next_subtree_counts;
+        parameters_type const& parameters;
+        Translator const& translator;
+        Allocators & allocators;
+        std::size_t threads;
+
+        packets_container elements;
+        expandable_box<Box> elements_box;
+    };
+
+    template <typename EIt>
+    struct per_level_task
+    {
+        per_level_task(EIt f, EIt l, Box const& hb, std::size_t vc, subtree_elements_counts const& sc,
+                       parameters_type const& p, Translator const& t, Allocators & a, std::size_t th)
+            : first(f), last(l), hint_box(hb), values_count(vc), subtree_counts(sc)
+            , parameters(p), translator(t), allocators(a), threads(th)
+            , result(Box(), node_pointer(0))
+        {}
+
+        void operator()()
+        {
+            result = per_level(first, last, hint_box, values_count, subtree_counts,
+                               parameters, translator, allocators, threads);
+        }
+
+        EIt first, last;
+        Box const& hint_box;
+        std::size_t values_count;
+        subtree_elements_counts const& subtree_counts;
+        parameters_type const& parameters;
+        Translator const& translator;
+        Allocators & allocators;
+        std::size_t threads;
+
+        internal_element result;
+    };
+
+    template <typename EIt, typename Elements, typename ExpandableBox> inline static
+    void per_level_packets_parallel(EIt first, EIt median, EIt last,
+                                    Box const& left, Box const& right,
+                                    std::size_t left_count, std::size_t right_count,
+                                    subtree_elements_counts const& subtree_counts,
+                                    subtree_elements_counts const& next_subtree_counts,
+                                    Elements & elements, ExpandableBox & elements_box,
+                                    parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                                    std::size_t threads)
+    {
+        // the threads are divided between the halves
+        std::size_t const left_threads = threads / 2;
+
+        per_level_packets_task<EIt> left_task(first, median, left, left_count,
+                                              subtree_counts, next_subtree_counts,
+                                              parameters, translator, allocators, left_threads);
+        per_level_packets_task<EIt> right_task(median, last, right, right_count,
+                                               subtree_counts, next_subtree_counts,
+                                               parameters, translator, allocators, threads - left_threads);
+
+        geometry::detail::parallel::fork_join(left_task, right_task, true);                 // MAY THROW (A, C)
+
+        left_task.elements.move_to(elements, elements_box);                                 // MAY THROW (A?,C)
+        right_task.elements.move_to(elements, elements_box);                                // MAY THROW (A?,C)
     }
 
     inline static
@@ -0,0 +1,92 @@
+// Boost.Geometry Index
+//
+// R-tree visitor calculating the overlap of nodes
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_UTILITIES_OVERLAP_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_UTILITIES_OVERLAP_HPP
+
+#include <boost/tuple/tuple.hpp>
+
+#include <boost/geometry/index/detail/algorithms/content.hpp>
+#include <boost/geometry/index/detail/algorithms/intersection_content.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace utilities {
+
+namespace visitors {
+
+// Calculates the sum of contents of the nodes and the sum of contents
+// of the intersections of the siblings (the overlap).
+template <typename Value, typename Options, typename Box, typename Allocators>
+struct overlap : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+{
+    typedef typename rtree::internal_node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    typedef typename index::detail::default_content_result<Box>::type content_type;
+
+    inline overlap()
+        : nodes_content(0)
+        , overlap_content(0)
+    {}
+
+    inline void operator()(internal_node const& n)
+    {
+        typedef typename rtree::elements_type<internal_node>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        for (typename elements_type::const_iterator it = elements.begin();
+            it != elements.end(); ++it)
+        {
+            nodes_content += index::detail::content(it->first);
+
+            for (typename elements_type::const_iterator it2 = it + 1;
+                it2 != elements.end(); ++it2)
+            {
+                overlap_content += index::detail::intersection_content(it->first, it2->first);
+            }
+
+            rtree::apply_visitor(*this, *it->second);
+        }
+    }
+
+    inline void operator()(leaf const& )
+    {}
+
+    content_type nodes_content;
+    content_type overlap_content;
+};
+
+} // namespace visitors
+
+template <typename Rtree> inline
+boost::tuple
+    <
+        typename index::detail::default_content_result<typename utilities::view<Rtree>::box_type>::type,
+        typename index::detail::default_content_result<typename utilities::view<Rtree>::box_type>::type
+    >
+overlap(Rtree const& tree)
+{
+    typedef utilities::view<Rtree> RTV;
+    RTV rtv(tree);
+
+    visitors::overlap<
+        typename RTV::value_type,
+        typename RTV::options_type,
+        typename RTV::box_type,
+        typename RTV::allocators_type
+    > overlap_v;
+
+    rtv.apply_visitor(overlap_v);
+
+    return boost::make_tuple(overlap_v.nodes_content, overlap_v.overlap_content);
+}
+
+}}}}}} // namespace boost::geometry::index::detail::rtree::utilities
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_UTILITIES_OVERLAP_HPP
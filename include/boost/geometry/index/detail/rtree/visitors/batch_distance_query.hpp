@@ -0,0 +1,142 @@
+// Boost.Geometry Index
+//
+// R-tree k nearest neighbors query of many geometries at once
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_BATCH_DISTANCE_QUERY_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_BATCH_DISTANCE_QUERY_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry/algorithms/centroid.hpp>
+
+#include <boost/geometry/index/detail/algorithms/space_filling_curve.hpp>
+#include <boost/geometry/index/detail/distance_predicates.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/distance_query.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace visitors {
+
+// The k nearest neighbors of many geometries. The queries are sorted along
+// the Hilbert curve so the consecutive ones are close to each other and visit
+// mostly the same nodes which are then already in the cache. The sorted queries
+// are divided into chunks which may be processed in parallel. The neighbors
+// of the i-th query are written at position i * k of the output.
+//
+// Traversing the tree once for a group of close queries was also tested but
+// it was slower because the children are visited in the order of the closest
+// query and the other ones find their neighbors later and prune less.
+template <
+    typename Value,
+    typename Options,
+    typename Translator,
+    typename Box,
+    typename Allocators,
+    typename QueryIter,
+    typename OutIter,
+    typename CountIter
+>
+class batch_distance_query
+{
+    typedef typename Options::parameters_type parameters_type;
+    typedef typename rtree::node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type node;
+
+    typedef typename std::iterator_traits<QueryIter>::value_type query_geometry;
+    typedef index::detail::predicates::nearest<query_geometry> nearest_predicate_type;
+
+    typedef typename geometry::point_type<Box>::type point_type;
+    typedef std::pair<boost::uint64_t, size_t> keyed_index;
+
+public:
+    // the number of queries processed by one thread at once
+    static const size_t chunk_size = 1024;
+
+    inline batch_distance_query(node const& root, Box const& bounds,
+                                parameters_type const& parameters, Translator const& translator,
+                                QueryIter queries_first, size_t queries_count, size_t k,
+                                OutIter out_it, CountIter counts_it)
+        : m_root(root), m_parameters(parameters), m_translator(translator)
+        , m_queries_first(queries_first), m_count(k)
+        , m_out_it(out_it), m_counts_it(counts_it)
+    {
+        m_order.reserve(queries_count);                                                             // MAY THROW (A)
+        QueryIter it = queries_first;
+        for ( size_t i = 0 ; i < queries_count ; ++i, ++it )
+        {
+            point_type pt;
+            geometry::centroid(*it, pt);
+            m_order.push_back(keyed_index(index::detail::hilbert_curve::apply(pt, bounds), i));
+        }
+
+        std::sort(m_order.begin(), m_order.end());
+
+        m_found.resize((queries_count + chunk_size - 1) / chunk_size, 0);                          // MAY THROW (A)
+    }
+
+    inline size_t chunks_count() const
+    {
+        return m_found.size();
+    }
+
+    // the total number of found neighbors
+    inline size_t found_count() const
+    {
+        size_t result = 0;
+        for ( size_t i = 0 ; i < m_found.size() ; ++i )
+            result += m_found[i];
+        return result;
+    }
+
+    inline void operator()(size_t chunk)
+    {
+        typedef visitors::distance_query<
+            Value, Options, Translator, Box, Allocators,
+            nearest_predicate_type, 0, OutIter
+        > distance_query_type;
+
+        size_t const chunk_begin = chunk * chunk_size;
+        size_t const chunk_end = (std::min)(chunk_begin + chunk_size, m_order.size());
+
+        for ( size_t i = chunk_begin ; i < chunk_end ; ++i )
+        {
+            size_t const q = m_order[i].second;
+
+            distance_query_type distance_v(m_parameters, m_translator,
+                                           nearest_predicate_type(*(m_queries_first + q), static_cast<unsigned>(m_count)),
+                                           m_out_it + q * m_count);                                 // MAY THROW (A, C)
+
+            rtree::apply_visitor(distance_v, m_root);                                               // MAY THROW (V, C, A)
+
+            size_t const found = distance_v.finish();                                               // MAY THROW (V)
+            *(m_counts_it + q) = found;
+            m_found[chunk] += found;
+        }
+    }
+
+private:
+    node const& m_root;
+    parameters_type const& m_parameters;
+    Translator const& m_translator;
+    QueryIter m_queries_first;
+    size_t m_count;
+    OutIter m_out_it;
+    CountIter m_counts_it;
+
+    std::vector<keyed_index> m_order;
+    std::vector<size_t> m_found;
+};
+
+}}} // namespace detail::rtree::visitors
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_BATCH_DISTANCE_QUERY_HPP
@@ -89,6 +89,103 @@ private:
     std::vector< std::pair<distance_type, Value> > m_neighbors;
 };
 
+// The minimal number of neighbors for which the best-first traversal is used by query()
+// if the nearest() predicate doesn't specify the traversal
+static const unsigned best_first_min_count = 100;
+
+// The node waiting in the priority queue of the best-first traversal.
+// Of the equally distant nodes the deeper ones are visited first. Otherwise
+// if the query geometry was inside many overlapping nodes, all of them would
+// be visited, level by level, before the first neighbor was found.
+template <typename DistanceType, typename NodePointer>
+struct distance_query_branch
+{
+    inline distance_query_branch(DistanceType const& d, size_t l, NodePointer p)
+        : distance(d), level(l), ptr(p)
+    {}
+
+    // the comparison creating the heap with the closest branch in front
+    static inline bool greater(distance_query_branch const& b1, distance_query_branch const& b2)
+    {
+        return b2.distance < b1.distance
+            || ( !(b1.distance < b2.distance) && b1.level < b2.level );
+    }
+
+    DistanceType distance;
+    size_t level;
+    NodePointer ptr;
+};
+
+// The children of an internal node of the R-tree identified by the iterators
+// of its elements
+template <typename Elements>
+struct element_children
+{
+    typedef typename Elements::value_type::first_type bounds_type;
+    typedef typename Elements::value_type::second_type node_type;
+    typedef typename Elements::const_iterator child_type;
+
+    inline bounds_type const& bounds(child_type const& it) const { return it->first; }
+    inline node_type node(child_type const& it) const { return it->second; }
+};
+
+// The branches passed to near_batch::push_branches() stored at the end of the list
+template <typename Children, typename Branches>
+class branches_list
+{
+public:
+    inline branches_list(Children const& children, Branches & branches)
+        : m_children(children), m_branches(branches)
+    {}
+
+    template <typename Child>
+    inline typename Children::bounds_type const& bounds(Child const& child) const
+    {
+        return m_children.bounds(child);
+    }
+
+    template <typename Child, typename Distance>
+    inline void push(Child const& child, Distance const& d)
+    {
+        m_branches.push_back(typename Branches::value_type(d, m_children.node(child)));              // MAY THROW (A)
+    }
+
+private:
+    Children const& m_children;
+    Branches & m_branches;
+};
+
+// The branches passed to near_batch::push_branches() stored in the priority queue
+template <typename Children, typename Branches>
+class branches_heap
+{
+public:
+    inline branches_heap(Children const& children, Branches & branches, size_t level)
+        : m_children(children), m_branches(branches), m_level(level)
+    {}
+
+    template <typename Child>
+    inline typename Children::bounds_type const& bounds(Child const& child) const
+    {
+        return m_children.bounds(child);
+    }
+
+    template <typename Child, typename Distance>
+    inline void push(Child const& child, Distance const& d)
+    {
+        typedef typename Branches::value_type branch_data;
+        m_branches.push_back(branch_data(d, m_level, m_children.node(child)));                      // MAY THROW (A)
+        std::push_heap(m_branches.begin(), m_branches.end(), branch_data::greater);
+    }
+
+private:
+    Children const& m_children;
+    Branches & m_branches;
+    size_t m_level;
+};
+
+// Depth-first traversal. The children of each node are sorted by distance and
+// visited recursively. It's the fastest for small k in well-structured trees.
 template <
     typename Value,
     typename Options,
@@ -117,6 +214,7 @@ public:
     typedef index::detail::calculate_distance<nearest_predicate_type, Box, bounds_tag> calculate_node_distance;
     typedef typename calculate_value_distance::result_type value_distance_type;
     typedef typename calculate_node_distance::result_type node_distance_type;
+    typedef index::detail::calculate_node_distances<nearest_predicate_type, Box> node_distances_type;
 
     static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
 
@@ -141,33 +239,14 @@ public:
         
         elements_type const& elements = rtree::elements(n);
 
-        // fill array of nodes meeting predicates
-        for (typename elements_type::const_iterator it = elements.begin();
-            it != elements.end(); ++it)
-        {
-            // if current node meets predicates
-            // 0 - dummy value
-            if ( index::detail::predicates_check<index::detail::bounds_tag, 0, predicates_len>(m_pred, 0, it->first) )
-            {
-                // calculate node's distance(s) for distance predicate
-                node_distance_type node_distance;
-                // if distance isn't ok - move to the next node
-                if ( !calculate_node_distance::apply(predicate(), it->first, node_distance) )
-                {
-                    continue;
-                }
-
-                // if current node is further than found neighbors - don't analyze it
-                if ( m_result.has_enough_neighbors() &&
-                     is_node_prunable(m_result.greatest_comparable_distance(), node_distance) )
-                {
-                    continue;
-                }
-
-                // add current node's data into the list
-                active_branch_list.push_back( std::make_pair(node_distance, it->second) );
-            }
-        }
+        // fill array of nodes meeting predicates,
+        // the distances of several children are calculated at once
+        node_distances_type node_distances(predicate());
+        element_children<elements_type> children;
+        branches_list<element_children<elements_type>, active_branch_list_type> branches(children, active_branch_list);
+        near_batch::push_branches(m_pred, node_distances, elements.begin(), elements.end(),
+                                  m_result.has_enough_neighbors(), m_result.greatest_comparable_distance(),
+                                  branches);                                                       // MAY THROW (A)
 
         // if there aren't any nodes in ABL - return
         if ( active_branch_list.empty() )
@@ -187,33 +266,6 @@ public:
 
             rtree::apply_visitor(*this, *(it->second));
         }
-
-        // ALTERNATIVE VERSION - use heap instead of sorted container
-        // It seems to be faster for greater MaxElements and slower otherwise
-        // CONSIDER: using one global container/heap for active branches
-        //           instead of a sorted container per level
-        //           This would also change the way how branches are traversed!
-        //           The same may be applied to the iterative version which btw suffers
-        //           from the copying of the whole containers on resize of the ABLs container
-
-        //// make a heap
-        //std::make_heap(active_branch_list.begin(), active_branch_list.end(), abl_greater);
-
-        //// recursively visit nodes
-        //while ( !active_branch_list.empty() )
-        //{
-        //    //if current node is further than furthest neighbor, the rest of nodes also will be further
-        //    if ( m_result.has_enough_neighbors()
-        //      && is_node_prunable(m_result.greatest_comparable_distance(), active_branch_list.front().first) )
-        //    {
-        //        break;
-        //    }
-
-        //    rtree::apply_visitor(*this, *(active_branch_list.front().second));
-
-        //    std::pop_heap(active_branch_list.begin(), active_branch_list.end(), abl_greater);
-        //    active_branch_list.pop_back();
-        //}
     }
 
     inline void operator()(leaf const& n)
@@ -253,12 +305,146 @@ private:
         return p1.first < p2.first;
     }
 
-    //static inline bool abl_greater(
-    //    std::pair<node_distance_type, typename Allocators::node_pointer> const& p1,
-    //    std::pair<node_distance_type, typename Allocators::node_pointer> const& p2)
-    //{
-    //    return p1.first > p2.first;
-    //}
+    template <typename Distance>
+    static inline bool is_node_prunable(Distance const& greatest_dist, node_distance_type const& d)
+    {
+        return greatest_dist <= d;
+    }
+
+    nearest_predicate_type const& predicate() const
+    {
+        return nearest_predicate_access::get(m_pred);
+    }
+
+    parameters_type const& m_parameters;
+    Translator const& m_translator;
+
+    Predicates m_pred;
+    distance_query_result<Value, Translator, value_distance_type, OutIter> m_result;
+};
+
+// Best-first traversal. The branches of all visited nodes are stored in one
+// priority queue and always the closest one is visited next, so the nodes
+// further than the k-th neighbor are never visited. The queue operations are
+// more expensive than sorting the children of a node, so this pays off for
+// greater k or in trees with overlapping nodes.
+template <
+    typename Value,
+    typename Options,
+    typename Translator,
+    typename Box,
+    typename Allocators,
+    typename Predicates,
+    unsigned DistancePredicateIndex,
+    typename OutIter
+>
+class best_first_distance_query
+    : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+{
+public:
+    typedef typename Options::parameters_type parameters_type;
+
+    typedef typename rtree::node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type node;
+    typedef typename rtree::internal_node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    typedef index::detail::predicates_element<DistancePredicateIndex, Predicates> nearest_predicate_access;
+    typedef typename nearest_predicate_access::type nearest_predicate_type;
+    typedef typename indexable_type<Translator>::type indexable_type;
+
+    typedef index::detail::calculate_distance<nearest_predicate_type, indexable_type, value_tag> calculate_value_distance;
+    typedef index::detail::calculate_distance<nearest_predicate_type, Box, bounds_tag> calculate_node_distance;
+    typedef typename calculate_value_distance::result_type value_distance_type;
+    typedef typename calculate_node_distance::result_type node_distance_type;
+    typedef index::detail::calculate_node_distances<nearest_predicate_type, Box> node_distances_type;
+
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+
+    typedef typename Allocators::node_pointer node_pointer;
+    typedef distance_query_branch<node_distance_type, node_pointer> branch_data;
+
+    inline best_first_distance_query(parameters_type const& parameters, Translator const& translator, Predicates const& pred, OutIter out_it)
+        : m_parameters(parameters), m_translator(translator)
+        , m_pred(pred)
+        , m_result(nearest_predicate_access::get(m_pred).count, out_it)
+        , m_level(0), m_traversing(false)
+    {}
+
+    // The root starts the traversal, the other internal nodes only add their
+    // branches into the queue.
+    inline void operator()(internal_node const& n)
+    {
+        if ( m_traversing )
+        {
+            push_branches(n);                                                                       // MAY THROW (A)
+            return;
+        }
+
+        m_traversing = true;
+
+        m_branches.reserve(m_parameters.get_max_elements() * 4);                                   // MAY THROW (A)
+        push_branches(n);                                                                           // MAY THROW (A)
+
+        while ( !m_branches.empty() )
+        {
+            // if the closest node is further than the furthest neighbor, the rest of nodes also will be further
+            if ( m_result.has_enough_neighbors() &&
+                 is_node_prunable(m_result.greatest_comparable_distance(), m_branches.front().distance) )
+                break;
+
+            node_pointer ptr = m_branches.front().ptr;
+            m_level = m_branches.front().level;
+            std::pop_heap(m_branches.begin(), m_branches.end(), branch_data::greater);
+            m_branches.pop_back();
+
+            rtree::apply_visitor(*this, *ptr);                                                      // MAY THROW (V, C, A)
+        }
+    }
+
+    inline void operator()(leaf const& n)
+    {
+        typedef typename rtree::elements_type<leaf>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        // search leaf for closest value meeting predicates
+        for (typename elements_type::const_iterator it = elements.begin();
+            it != elements.end(); ++it)
+        {
+            // if value meets predicates
+            if ( index::detail::predicates_check<index::detail::value_tag, 0, predicates_len>(m_pred, *it, m_translator(*it)) )
+            {
+                // calculate values distance for distance predicate
+                value_distance_type value_distance;
+                // if distance is ok
+                if ( calculate_value_distance::apply(predicate(), m_translator(*it), value_distance) )
+                {
+                    // store value
+                    m_result.store(*it, value_distance);
+                }
+            }
+        }
+    }
+
+    inline size_t finish()
+    {
+        return m_result.finish();
+    }
+
+private:
+    // add the branches meeting predicates which may contain closer values than the found neighbors
+    inline void push_branches(internal_node const& n)
+    {
+        typedef typename rtree::elements_type<internal_node>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        // the distances of several children are calculated at once
+        node_distances_type node_distances(predicate());
+        element_children<elements_type> children;
+        branches_heap<element_children<elements_type>, std::vector<branch_data> > branches(children, m_branches, m_level + 1);
+        near_batch::push_branches(m_pred, node_distances, elements.begin(), elements.end(),
+                                  m_result.has_enough_neighbors(), m_result.greatest_comparable_distance(),
+                                  branches);                                                       // MAY THROW (A)
+    }
 
     template <typename Distance>
     static inline bool is_node_prunable(Distance const& greatest_dist, node_distance_type const& d)
@@ -276,8 +462,15 @@ private:
 
     Predicates m_pred;
     distance_query_result<Value, Translator, value_distance_type, OutIter> m_result;
+
+    // the priority queue of branches, the closest one in front
+    std::vector<branch_data> m_branches;
+    size_t m_level;
+    bool m_traversing;
 };
 
+// Best-first traversal used by the query iterators. The next neighbor is
+// returned as soon as no branch remaining in the queue can contain a closer one.
 template <
     typename Value,
     typename Options,
@@ -305,6 +498,7 @@ public:
     typedef index::detail::calculate_distance<nearest_predicate_type, Box, bounds_tag> calculate_node_distance;
     typedef typename calculate_value_distance::result_type value_distance_type;
     typedef typename calculate_node_distance::result_type node_distance_type;
+    typedef index::detail::calculate_node_distances<nearest_predicate_type, Box> node_distances_type;
 
     typedef typename Allocators::size_type size_type;
     typedef typename Allocators::const_reference const_reference;
@@ -316,40 +510,21 @@ public:
     typedef typename internal_elements::const_iterator internal_iterator;
     typedef typename rtree::elements_type<leaf>::type leaf_elements;
 
-    typedef std::pair<node_distance_type, node_pointer> branch_data;
-    typedef typename index::detail::rtree::container_from_elements_type<
-        internal_elements, branch_data
-    >::type active_branch_list_type;
-    struct internal_stack_element
-    {
-        internal_stack_element() : current_branch(0) {}
-#ifdef BOOST_NO_CXX11_RVALUE_REFERENCES
-        // Required in c++03 for containers using Boost.Move
-        internal_stack_element & operator=(internal_stack_element const& o)
-        {
-            branches = o.branches;
-            current_branch = o.current_branch;
-            return *this;
-        }
-#endif
-        active_branch_list_type branches;
-        typename active_branch_list_type::size_type current_branch;
-    };
-    typedef std::vector<internal_stack_element> internal_stack_type;
+    typedef distance_query_branch<node_distance_type, node_pointer> branch_data;
+    typedef std::vector<branch_data> branches_type;
 
     inline distance_query_incremental()
         : m_translator(NULL)
 //        , m_pred()
         , current_neighbor((std::numeric_limits<size_type>::max)())
-//        , next_closest_node_distance((std::numeric_limits<node_distance_type>::max)())
+        , current_level(0)
     {}
 
     inline distance_query_incremental(Translator const& translator, Predicates const& pred)
         : m_translator(::boost::addressof(translator))
         , m_pred(pred)
         , current_neighbor((std::numeric_limits<size_type>::max)())
-
-        , next_closest_node_distance((std::numeric_limits<node_distance_type>::max)())
+        , current_level(0)
     {
         BOOST_GEOMETRY_INDEX_ASSERT(0 < max_count(), "k must be greather than 0");
     }
@@ -371,7 +546,7 @@ public:
         {
             size_type new_neighbor = current_neighbor == (std::numeric_limits<size_type>::max)() ? 0 : current_neighbor + 1;
 
-            if ( internal_stack.empty() )
+            if ( branches.empty() )
             {
                 if ( new_neighbor < neighbors.size() )
                     current_neighbor = new_neighbor;
@@ -386,41 +561,35 @@ public:
             }
             else
             {
-                active_branch_list_type & branches = internal_stack.back().branches;
-                typename active_branch_list_type::size_type & current_branch = internal_stack.back().current_branch;
-
-                if ( branches.size() <= current_branch )
-                {
-                    internal_stack.pop_back();
-                    continue;
-                }
+                // the closest of all not visited nodes
+                branch_data const& closest_branch = branches.front();
 
                 // if there are no nodes which can have closer values, set new value
                 if ( new_neighbor < neighbors.size() &&
                      // here must be < because otherwise neighbours may be sorted in different order
                      // if there is another value with equal distance
-                     neighbors[new_neighbor].first < next_closest_node_distance )
+                     neighbors[new_neighbor].first < closest_branch.distance )
                 {
                     current_neighbor = new_neighbor;
                     return;
                 }
 
-                // if node is further than the furthest neighbour, following nodes also will be further
+                // if the closest node is further than the furthest neighbour, all other nodes also will be further
                 BOOST_GEOMETRY_INDEX_ASSERT(neighbors.size() <= max_count(), "unexpected neighbours count");
                 if ( max_count() <= neighbors.size() &&
-                     is_node_prunable(neighbors.back().first, branches[current_branch].first) )
+                     is_node_prunable(neighbors.back().first, closest_branch.distance) )
                 {
-                    // stop traversing current level
-                    internal_stack.pop_back();
+                    branches.clear();
                     continue;
                 }
                 else
                 {
-                    // new level - must increment current_branch before traversing of another level (mem reallocation)
-                    ++current_branch;
-                    rtree::apply_visitor(*this, *(branches[current_branch - 1].second));
+                    node_pointer ptr = closest_branch.ptr;
+                    current_level = closest_branch.level;
+                    std::pop_heap(branches.begin(), branches.end(), branch_data::greater);
+                    branches.pop_back();
 
-                    next_closest_node_distance = calc_closest_node_distance(internal_stack.begin(), internal_stack.end());
+                    rtree::apply_visitor(*this, *ptr);
                 }
             }
         }
@@ -441,7 +610,7 @@ public:
         return l.current_neighbor == r.current_neighbor;
     }
 
-    // Put node's elements into the list of active branches if those elements meets predicates
+    // Put node's elements into the priority queue of active branches if those elements meets predicates
     // and distance predicates(currently not used)
     // and aren't further than found neighbours (if there is enough neighbours)
     inline void operator()(internal_node const& n)
@@ -449,41 +618,18 @@ public:
         typedef typename rtree::elements_type<internal_node>::type elements_type;
         elements_type const& elements = rtree::elements(n);
 
-        // add new element
-        internal_stack.resize(internal_stack.size()+1);
-
-        // fill active branch list array of nodes meeting predicates
-        for ( typename elements_type::const_iterator it = elements.begin() ; it != elements.end() ; ++it )
-        {
-            // if current node meets predicates
-            // 0 - dummy value
-            if ( index::detail::predicates_check<index::detail::bounds_tag, 0, predicates_len>(m_pred, 0, it->first) )
-            {
-                // calculate node's distance(s) for distance predicate
-                node_distance_type node_distance;
-                // if distance isn't ok - move to the next node
-                if ( !calculate_node_distance::apply(predicate(), it->first, node_distance) )
-                {
-                    continue;
-                }
-
-                // if current node is further than found neighbors - don't analyze it
-                if ( max_count() <= neighbors.size() &&
-                     is_node_prunable(neighbors.back().first, node_distance) )
-                {
-                    continue;
-                }
-
-                // add current node's data into the list
-                internal_stack.back().branches.push_back( std::make_pair(node_distance, it->second) );
-            }
-        }
-
-        if ( internal_stack.back().branches.empty() )
-            internal_stack.pop_back();
-        else
-            // sort array
-            std::sort(internal_stack.back().branches.begin(), internal_stack.back().branches.end(), abl_less);
+        // fill active branch list array of nodes meeting predicates,
+        // the distances of several children are calculated at once
+        bool const enough_neighbors = max_count() <= neighbors.size();
+        value_distance_type const greatest_distance = enough_neighbors
+            ? neighbors.back().first
+            : (std::numeric_limits<value_distance_type>::max)();
+
+        node_distances_type node_distances(predicate());
+        element_children<elements_type> children;
+        branches_heap<element_children<elements_type>, branches_type> queue(children, branches, current_level + 1);
+        near_batch::push_branches(m_pred, node_distances, elements.begin(), elements.end(),
+                                  enough_neighbors, greatest_distance, queue);
     }
 
     // Put values into the list of neighbours if those values meets predicates
@@ -526,35 +672,12 @@ public:
     }
 
 private:
-    static inline bool abl_less(std::pair<node_distance_type, typename Allocators::node_pointer> const& p1,
-                                std::pair<node_distance_type, typename Allocators::node_pointer> const& p2)
-    {
-        return p1.first < p2.first;
-    }
-
     static inline bool neighbors_less(std::pair<value_distance_type, const Value *> const& p1,
                                       std::pair<value_distance_type, const Value *> const& p2)
     {
         return p1.first < p2.first;
     }
 
-    node_distance_type
-    calc_closest_node_distance(typename internal_stack_type::const_iterator first,
-                               typename internal_stack_type::const_iterator last)
-    {
-        node_distance_type result = (std::numeric_limits<node_distance_type>::max)();
-        for ( ; first != last ; ++first )
-        {
-            if ( first->branches.size() <= first->current_branch )
-                continue;
-
-            node_distance_type curr_dist = first->branches[first->current_branch].first;
-            if ( curr_dist < result )
-                result = curr_dist;
-        }
-        return result;
-    }
-
     template <typename Distance>
     static inline bool is_node_prunable(Distance const& greatest_dist, node_distance_type const& d)
     {
@@ -575,10 +698,11 @@ private:
 
     Predicates m_pred;
 
-    internal_stack_type internal_stack;
+    // the priority queue of branches, the closest one in front
+    branches_type branches;
     std::vector< std::pair<value_distance_type, const Value *> > neighbors;
     size_type current_neighbor;
-    node_distance_type next_closest_node_distance;
+    size_t current_level;
 };
 
 }}} // namespace detail::rtree::visitors
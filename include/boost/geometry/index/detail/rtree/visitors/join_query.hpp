@@ -0,0 +1,325 @@
+// Boost.Geometry Index
+//
+// R-tree spatial join of two rtrees
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_JOIN_QUERY_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_JOIN_QUERY_HPP
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/index/detail/join_predicates.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace visitors {
+
+// The members of one of the joined rtrees
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators>
+struct join_tree
+{
+    typedef Value value_type;
+    typedef Translator translator_type;
+    typedef Box box_type;
+    typedef typename Options::parameters_type parameters_type;
+
+    typedef typename rtree::internal_node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    typedef typename Allocators::node_pointer node_pointer;
+    typedef typename Allocators::size_type size_type;
+
+    inline join_tree(node_pointer r, size_type ll, Box const& b, Translator const& tr)
+        : root(r), leafs_level(ll), bounds(b), translator(tr)
+    {}
+
+    node_pointer root;
+    size_type leafs_level;
+    Box bounds;
+    Translator const& translator;
+};
+
+// The pair of nodes of the joined rtrees, their boxes and levels
+template <typename Tree1, typename Tree2>
+struct join_node_pair
+{
+    inline join_node_pair(typename Tree1::node_pointer n1, typename Tree1::box_type const& b1, typename Tree1::size_type l1,
+                          typename Tree2::node_pointer n2, typename Tree2::box_type const& b2, typename Tree2::size_type l2)
+        : node1(n1), box1(b1), level1(l1), node2(n2), box2(b2), level2(l2)
+    {}
+
+    typename Tree1::node_pointer node1;
+    typename Tree1::box_type box1;
+    typename Tree1::size_type level1;
+    typename Tree2::node_pointer node2;
+    typename Tree2::box_type box2;
+    typename Tree2::size_type level2;
+};
+
+// Synchronized traversal of two rtrees. Both trees are descended at once
+// and only the pairs of nodes whose boxes may contain joined values are
+// visited. If one of the nodes is a leaf only the other one is descended.
+// The pairs of Values are written to the output in the order of traversal.
+template <typename Tree1, typename Tree2, typename Predicate, typename OutIter>
+class join_query
+{
+    typedef typename Tree1::internal_node internal_node1;
+    typedef typename Tree1::leaf leaf1;
+    typedef typename Tree2::internal_node internal_node2;
+    typedef typename Tree2::leaf leaf2;
+
+    typedef typename rtree::elements_type<internal_node1>::type internal_elements1;
+    typedef typename rtree::elements_type<internal_node2>::type internal_elements2;
+    typedef typename rtree::elements_type<leaf1>::type leaf_elements1;
+    typedef typename rtree::elements_type<leaf2>::type leaf_elements2;
+
+    typedef index::detail::join_predicate_check<Predicate> check;
+
+public:
+    typedef join_node_pair<Tree1, Tree2> node_pair;
+
+    inline join_query(Tree1 const& tree1, Tree2 const& tree2, Predicate const& pred, OutIter out_it)
+        : m_tree1(tree1), m_tree2(tree2), m_pred(pred), m_out_it(out_it), m_found_count(0)
+    {}
+
+    // join the whole trees
+    inline void apply()
+    {
+        if ( check::bounds(m_pred, m_tree1.bounds, m_tree2.bounds) )
+            apply(node_pair(m_tree1.root, m_tree1.bounds, 0, m_tree2.root, m_tree2.bounds, 0));     // MAY THROW (V, C, A)
+    }
+
+    // join the subtrees of the pair of nodes
+    inline void apply(node_pair const& p)
+    {
+        bool const is_leaf1 = p.level1 == m_tree1.leafs_level;
+        bool const is_leaf2 = p.level2 == m_tree2.leafs_level;
+
+        if ( is_leaf1 && is_leaf2 )
+        {
+            join_leafs(rtree::get<leaf1>(*p.node1), p.box1,
+                       rtree::get<leaf2>(*p.node2), p.box2);                                        // MAY THROW (V, C)
+            return;
+        }
+
+        if ( is_leaf2 )
+        {
+            internal_elements1 const& elements1 = rtree::elements(rtree::get<internal_node1>(*p.node1));
+            for ( typename internal_elements1::const_iterator it1 = elements1.begin() ; it1 != elements1.end() ; ++it1 )
+            {
+                if ( check::bounds(m_pred, it1->first, p.box2) )
+                    apply(node_pair(it1->second, it1->first, p.level1 + 1, p.node2, p.box2, p.level2));
+            }
+            return;
+        }
+
+        internal_elements2 const& elements2 = rtree::elements(rtree::get<internal_node2>(*p.node2));
+
+        if ( is_leaf1 )
+        {
+            for ( typename internal_elements2::const_iterator it2 = elements2.begin() ; it2 != elements2.end() ; ++it2 )
+            {
+                if ( check::bounds(m_pred, p.box1, it2->first) )
+                    apply(node_pair(p.node1, p.box1, p.level1, it2->second, it2->first, p.level2 + 1));
+            }
+            return;
+        }
+
+        internal_elements1 const& elements1 = rtree::elements(rtree::get<internal_node1>(*p.node1));
+
+        // the children of the second node which may contain joined values,
+        // the children of the first node are tested in the loop below
+        typedef typename index::detail::rtree::container_from_elements_type<
+            internal_elements2, typename internal_elements2::const_iterator
+        >::type candidates_type;
+
+        candidates_type candidates;
+        for ( typename internal_elements2::const_iterator it2 = elements2.begin() ; it2 != elements2.end() ; ++it2 )
+        {
+            if ( check::bounds(m_pred, p.box1, it2->first) )
+                candidates.push_back(it2);
+        }
+
+        for ( typename internal_elements1::const_iterator it1 = elements1.begin() ; it1 != elements1.end() ; ++it1 )
+        {
+            if ( !check::bounds(m_pred, it1->first, p.box2) )
+                continue;
+
+            for ( typename candidates_type::const_iterator it2 = candidates.begin() ; it2 != candidates.end() ; ++it2 )
+            {
+                if ( check::bounds(m_pred, it1->first, (*it2)->first) )
+                    apply(node_pair(it1->second, it1->first, p.level1 + 1,
+                                    (*it2)->second, (*it2)->first, p.level2 + 1));                  // MAY THROW (V, C, A)
+            }
+        }
+    }
+
+    inline size_t found_count() const
+    {
+        return m_found_count;
+    }
+
+private:
+    inline void join_leafs(leaf1 const& n1, typename Tree1::box_type const& box1,
+                           leaf2 const& n2, typename Tree2::box_type const& box2)
+    {
+        leaf_elements1 const& elements1 = rtree::elements(n1);
+        leaf_elements2 const& elements2 = rtree::elements(n2);
+
+        typedef typename index::detail::rtree::container_from_elements_type<
+            leaf_elements2, typename leaf_elements2::const_iterator
+        >::type candidates_type;
+
+        candidates_type candidates;
+        for ( typename leaf_elements2::const_iterator it2 = elements2.begin() ; it2 != elements2.end() ; ++it2 )
+        {
+            if ( check::bounds(m_pred, box1, m_tree2.translator(*it2)) )
+                candidates.push_back(it2);
+        }
+
+        for ( typename leaf_elements1::const_iterator it1 = elements1.begin() ; it1 != elements1.end() ; ++it1 )
+        {
+            if ( !check::bounds(m_pred, m_tree1.translator(*it1), box2) )
+                continue;
+
+            for ( typename candidates_type::const_iterator it2 = candidates.begin() ; it2 != candidates.end() ; ++it2 )
+            {
+                if ( check::values(m_pred, m_tree1.translator(*it1), m_tree2.translator(**it2)) )
+                {
+                    *m_out_it = std::make_pair(*it1, **it2);                                        // MAY THROW (V, C)
+                    ++m_out_it;
+                    ++m_found_count;
+                }
+            }
+        }
+    }
+
+    Tree1 const& m_tree1;
+    Tree2 const& m_tree2;
+    Predicate const& m_pred;
+    OutIter m_out_it;
+    size_t m_found_count;
+};
+
+// The pairs of children of the roots are joined as separate tasks which may
+// be processed in parallel. Each task stores the pairs of Values in its own
+// container and they are written to the output in the order of tasks so
+// the result is the same as the result of join_query.
+template <typename Tree1, typename Tree2, typename Predicate>
+class parallel_join_query
+{
+    typedef std::pair<typename Tree1::value_type, typename Tree2::value_type> result_type;
+    typedef std::back_insert_iterator< std::vector<result_type> > task_out_iterator;
+    typedef join_query<Tree1, Tree2, Predicate, task_out_iterator> join_query_type;
+    typedef typename join_query_type::node_pair node_pair;
+
+    typedef typename Tree1::internal_node internal_node1;
+    typedef typename Tree2::internal_node internal_node2;
+    typedef typename rtree::elements_type<internal_node1>::type internal_elements1;
+    typedef typename rtree::elements_type<internal_node2>::type internal_elements2;
+
+    typedef index::detail::join_predicate_check<Predicate> check;
+
+public:
+    inline parallel_join_query(Tree1 const& tree1, Tree2 const& tree2, Predicate const& pred)
+        : m_tree1(tree1), m_tree2(tree2), m_pred(pred)
+    {
+        if ( !check::bounds(m_pred, m_tree1.bounds, m_tree2.bounds) )
+            return;
+
+        node_pair const roots(m_tree1.root, m_tree1.bounds, 0, m_tree2.root, m_tree2.bounds, 0);
+
+        bool const is_leaf1 = 0 == m_tree1.leafs_level;
+        bool const is_leaf2 = 0 == m_tree2.leafs_level;
+
+        if ( is_leaf1 && is_leaf2 )
+        {
+            m_tasks.push_back(roots);                                                               // MAY THROW (A)
+        }
+        else if ( is_leaf2 )
+        {
+            internal_elements1 const& elements1 = rtree::elements(rtree::get<internal_node1>(*roots.node1));
+            for ( typename internal_elements1::const_iterator it1 = elements1.begin() ; it1 != elements1.end() ; ++it1 )
+            {
+                if ( check::bounds(m_pred, it1->first, roots.box2) )
+                    m_tasks.push_back(node_pair(it1->second, it1->first, 1, roots.node2, roots.box2, 0));  // MAY THROW (A)
+            }
+        }
+        else if ( is_leaf1 )
+        {
+            internal_elements2 const& elements2 = rtree::elements(rtree::get<internal_node2>(*roots.node2));
+            for ( typename internal_elements2::const_iterator it2 = elements2.begin() ; it2 != elements2.end() ; ++it2 )
+            {
+                if ( check::bounds(m_pred, roots.box1, it2->first) )
+                    m_tasks.push_back(node_pair(roots.node1, roots.box1, 0, it2->second, it2->first, 1));  // MAY THROW (A)
+            }
+        }
+        else
+        {
+            internal_elements1 const& elements1 = rtree::elements(rtree::get<internal_node1>(*roots.node1));
+            internal_elements2 const& elements2 = rtree::elements(rtree::get<internal_node2>(*roots.node2));
+            for ( typename internal_elements1::const_iterator it1 = elements1.begin() ; it1 != elements1.end() ; ++it1 )
+            {
+                if ( !check::bounds(m_pred, it1->first, roots.box2) )
+                    continue;
+
+                for ( typename internal_elements2::const_iterator it2 = elements2.begin() ; it2 != elements2.end() ; ++it2 )
+                {
+                    if ( check::bounds(m_pred, it1->first, it2->first) )
+                        m_tasks.push_back(node_pair(it1->second, it1->first, 1, it2->second, it2->first, 1)); // MAY THROW (A)
+                }
+            }
+        }
+
+        m_results.resize(m_tasks.size());                                                           // MAY THROW (A)
+    }
+
+    inline size_t tasks_count() const
+    {
+        return m_tasks.size();
+    }
+
+    inline void operator()(size_t task)
+    {
+        join_query_type join_v(m_tree1, m_tree2, m_pred, std::back_inserter(m_results[task]));
+        join_v.apply(m_tasks[task]);                                                                // MAY THROW (V, C, A)
+    }
+
+    // write the results of all tasks
+    template <typename OutIter>
+    inline size_t finish(OutIter out_it) const
+    {
+        size_t result = 0;
+        for ( size_t i = 0 ; i < m_results.size() ; ++i )
+        {
+            for ( typename std::vector<result_type>::const_iterator it = m_results[i].begin() ;
+                  it != m_results[i].end() ; ++it, ++out_it )
+            {
+                *out_it = *it;                                                                      // MAY THROW (V, C)
+            }
+            result += m_results[i].size();
+        }
+        return result;
+    }
+
+private:
+    Tree1 const& m_tree1;
+    Tree2 const& m_tree2;
+    Predicate const& m_pred;
+
+    std::vector<node_pair> m_tasks;
+    std::vector< std::vector<result_type> > m_results;
+};
+
+}}} // namespace detail::rtree::visitors
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_JOIN_QUERY_HPP
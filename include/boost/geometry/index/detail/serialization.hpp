@@ -156,6 +156,31 @@ void load_construct_data(Archive & ar, boost::geometry::index::rstar<Max, Min, R
 template<class Archive, size_t Max, size_t Min, size_t RE, size_t OCT>
 void serialize(Archive &, boost::geometry::index::rstar<Max, Min, RE, OCT> &, unsigned int) {}
 
+// boost::geometry::index::kmeans
+
+template<class Archive, size_t Max, size_t Min, size_t It>
+void save_construct_data(Archive & ar, const boost::geometry::index::kmeans<Max, Min, It> * params, unsigned int )
+{
+    size_t max = params->get_max_elements(), min = params->get_min_elements(), it = params->get_max_iterations();
+    ar << boost::serialization::make_nvp("max", max);
+    ar << boost::serialization::make_nvp("min", min);
+    ar << boost::serialization::make_nvp("it", it);
+}
+template<class Archive, size_t Max, size_t Min, size_t It>
+void load_construct_data(Archive & ar, boost::geometry::index::kmeans<Max, Min, It> * params, unsigned int )
+{
+    size_t max, min, it;
+    ar >> boost::serialization::make_nvp("max", max);
+    ar >> boost::serialization::make_nvp("min", min);
+    ar >> boost::serialization::make_nvp("it", it);
+    if ( max != params->get_max_elements() || min != params->get_min_elements() ||
+         it != params->get_max_iterations() )
+        BOOST_THROW_EXCEPTION(std::runtime_error("parameters not compatible"));
+    // the constructor musn't be called for this type
+    //::new(params)boost::geometry::index::kmeans<Max, Min, It>();
+}
+template<class Archive, size_t Max, size_t Min, size_t It> void serialize(Archive &, boost::geometry::index::kmeans<Max, Min, It> &, unsigned int) {}
+
 // boost::geometry::index::dynamic_linear
 
 template<class Archive>
@@ -220,6 +245,27 @@ inline void load_construct_data(Archive & ar, boost::geometry::index::dynamic_rs
 }
 template<class Archive> void serialize(Archive &, boost::geometry::index::dynamic_rstar &, unsigned int) {}
 
+// boost::geometry::index::dynamic_kmeans
+
+template<class Archive>
+inline void save_construct_data(Archive & ar, const boost::geometry::index::dynamic_kmeans * params, unsigned int )
+{
+    size_t max = params->get_max_elements(), min = params->get_min_elements(), it = params->get_max_iterations();
+    ar << boost::serialization::make_nvp("max", max);
+    ar << boost::serialization::make_nvp("min", min);
+    ar << boost::serialization::make_nvp("it", it);
+}
+template<class Archive>
+inline void load_construct_data(Archive & ar, boost::geometry::index::dynamic_kmeans * params, unsigned int )
+{
+    size_t max, min, it;
+    ar >> boost::serialization::make_nvp("max", max);
+    ar >> boost::serialization::make_nvp("min", min);
+    ar >> boost::serialization::make_nvp("it", it);
+    ::new(params)boost::geometry::index::dynamic_kmeans(max, min, it);
+}
+template<class Archive> void serialize(Archive &, boost::geometry::index::dynamic_kmeans &, unsigned int) {}
+
 }} // boost::serialization
 
 // TODO - move to index/detail/serialization.hpp or maybe geometry/serialization.hpp
@@ -0,0 +1,630 @@
+// Boost.Geometry Index
+//
+// Flat R-tree implementation
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_FLAT_RTREE_HPP
+#define BOOST_GEOMETRY_INDEX_FLAT_RTREE_HPP
+
+#include <boost/container/vector.hpp>
+#include <boost/core/swap.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/geometry/index/detail/config_begin.hpp>
+
+#include <boost/geometry/index/detail/rtree/flat/flat.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief The read-only R-tree stored in contiguous memory.
+
+The flat R-tree contains the same nodes as the R-tree it was created from
+but all of them are stored in one array in breadth-first order and the children
+of nodes are referenced by indexes. The Values are stored in a separate array
+in the order of leafs. This improves the cache locality of queries. The flat
+R-tree can't be modified, it may only be created from an R-tree or a range
+of Values.
+
+\tparam Value           The type of objects stored in the container.
+\tparam Parameters      Compile-time parameters.
+\tparam IndexableGetter The function object extracting Indexable from Value.
+\tparam EqualTo         The function object comparing objects of type Value.
+\tparam Allocator       The allocator used to allocate/deallocate memory,
+                        construct/destroy nodes and Values.
+*/
+template <
+    typename Value,
+    typename Parameters,
+    typename IndexableGetter = index::indexable<Value>,
+    typename EqualTo = index::equal_to<Value>,
+    typename Allocator = std::allocator<Value>
+>
+class flat_rtree
+{
+public:
+    /*! \brief The type of the R-tree from which the flat R-tree may be created. */
+    typedef index::rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> rtree_type;
+
+    /*! \brief The type of Value stored in the container. */
+    typedef Value value_type;
+    /*! \brief R-tree parameters type. */
+    typedef Parameters parameters_type;
+    /*! \brief The function object extracting Indexable from Value. */
+    typedef IndexableGetter indexable_getter;
+    /*! \brief The function object comparing objects of type Value. */
+    typedef EqualTo value_equal;
+    /*! \brief The type of allocator used by the container. */
+    typedef Allocator allocator_type;
+
+    /*! \brief The Indexable type to which Value is translated. */
+    typedef typename rtree_type::indexable_type indexable_type;
+    /*! \brief The Box type used by the R-tree. */
+    typedef typename rtree_type::bounds_type bounds_type;
+
+private:
+    typedef detail::translator<IndexableGetter, EqualTo> translator_type;
+
+    typedef ::boost::container::allocator_traits<Allocator> allocator_traits_type;
+
+    // 32-bit indexes make the nodes smaller
+    typedef detail::rtree::flat::node<bounds_type, boost::uint32_t> node_type;
+    typedef typename Allocator::template rebind<node_type>::other node_allocator_type;
+
+    typedef ::boost::container::vector<node_type, node_allocator_type> nodes_type;
+    typedef ::boost::container::vector<value_type, allocator_type> values_type;
+
+    typedef detail::rtree::flat::storage<nodes_type, values_type> storage_type;
+
+public:
+    /*! \brief Type of reference to Value. */
+    typedef typename values_type::const_reference const_reference;
+    /*! \brief Type of pointer to Value. */
+    typedef typename values_type::const_pointer const_pointer;
+    /*! \brief Type of difference type. */
+    typedef typename values_type::difference_type difference_type;
+    /*! \brief Unsigned integral type used by the container. */
+    typedef typename values_type::size_type size_type;
+
+    /*! \brief The type-erased const-iterator of the flat rtree. */
+    typedef typename values_type::const_iterator const_iterator;
+
+    /*! \brief The type-erased const-query-iterator of the flat rtree. */
+    typedef index::detail::rtree::iterators::query_iterator<value_type, values_type> const_query_iterator;
+
+public:
+
+    /*!
+    \brief The constructor.
+
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    If allocator copy constructor throws.
+    */
+    inline explicit flat_rtree(parameters_type const& parameters = parameters_type(),
+                               indexable_getter const& getter = indexable_getter(),
+                               value_equal const& equal = value_equal(),
+                               allocator_type const& allocator = allocator_type())
+        : m_translator(getter, equal)
+        , m_parameters(parameters)
+        , m_storage(node_allocator_type(allocator), allocator)
+    {}
+
+    /*!
+    \brief The constructor.
+
+    The flat R-tree containing the same nodes and Values as the R-tree is created.
+
+    \param tree     The R-tree.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor throws.
+    \li If allocation throws or returns invalid value.
+    \li std::length_error if the number of nodes or Values is greater than 2^32 - 1.
+    */
+    inline explicit flat_rtree(rtree_type const& tree)
+        : m_translator(tree.indexable_get(), tree.value_eq())
+        , m_parameters(tree.parameters())
+        , m_storage(node_allocator_type(tree.get_allocator()), tree.get_allocator())
+    {
+        detail::rtree::flat::copy(tree, m_storage);
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm.
+
+    \param first        The beginning of the range of Values.
+    \param last         The end of the range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Iterator>
+    inline flat_rtree(Iterator first, Iterator last,
+                      parameters_type const& parameters = parameters_type(),
+                      indexable_getter const& getter = indexable_getter(),
+                      value_equal const& equal = value_equal(),
+                      allocator_type const& allocator = allocator_type())
+        : m_translator(getter, equal)
+        , m_parameters(parameters)
+        , m_storage(node_allocator_type(allocator), allocator)
+    {
+        rtree_type tree(first, last, parameters, getter, equal, allocator);
+        detail::rtree::flat::copy(tree, m_storage);
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm.
+
+    \param rng          The range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Range>
+    inline explicit flat_rtree(Range const& rng,
+                               parameters_type const& parameters = parameters_type(),
+                               indexable_getter const& getter = indexable_getter(),
+                               value_equal const& equal = value_equal(),
+                               allocator_type const& allocator = allocator_type())
+        : m_translator(getter, equal)
+        , m_parameters(parameters)
+        , m_storage(node_allocator_type(allocator), allocator)
+    {
+        rtree_type tree(rng, parameters, getter, equal, allocator);
+        detail::rtree::flat::copy(tree, m_storage);
+    }
+
+    /*!
+    \brief Swaps contents of two flat rtrees.
+
+    Parameters, translator and allocators are swapped as well.
+
+    \param other    The flat rtree which content will be swapped with this rtree content.
+
+    \par Throws
+    If allocators swap throws.
+    */
+    void swap(flat_rtree & other)
+    {
+        boost::swap(m_translator, other.m_translator);
+        boost::swap(m_parameters, other.m_parameters);
+        m_storage.nodes.swap(other.m_storage.nodes);
+        m_storage.values.swap(other.m_storage.values);
+        boost::swap(m_storage.leafs_begin, other.m_storage.leafs_begin);
+        boost::swap(m_storage.leafs_level, other.m_storage.leafs_level);
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
+
+    The same predicates as in the case of the R-tree query may be passed, see
+    <tt>rtree::query(Predicates const&, OutIter)</tt>.
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If predicates copy throws.
+
+    \warning
+    Only one \c nearest() perdicate may be passed to the query. Passing more of them results in compile-time error.
+
+    \param predicates   Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of values found.
+    */
+    template <typename Predicates, typename OutIter>
+    size_type query(Predicates const& predicates, OutIter out_it) const
+    {
+        if ( m_storage.nodes.empty() )
+            return 0;
+
+        static const unsigned distance_predicates_count = detail::predicates_count_distance<Predicates>::value;
+        static const bool is_distance_predicate = 0 < distance_predicates_count;
+        BOOST_MPL_ASSERT_MSG((distance_predicates_count <= 1), PASS_ONLY_ONE_DISTANCE_PREDICATE, (Predicates));
+
+        return query_dispatch(predicates, out_it, boost::mpl::bool_<is_distance_predicate>());
+    }
+
+    /*!
+    \brief Returns a query iterator pointing at the begin of the query range.
+
+    This method returns an iterator which may be used to perform iterative queries.
+    For the information about predicates which may be passed to this method see query().
+    Like in the case of the R-tree, the Values found by the nearest() predicate are
+    returned in the order of their distances.
+
+    \par Example
+    \verbatim
+    for ( Tree::const_query_iterator it = tree.qbegin(bgi::nearest(pt, 10000)) ;
+          it != tree.qend() ; ++it )
+    {
+        // do something with value
+        if ( has_enough_nearest_values() )
+            break;
+    }
+    \endverbatim
+
+    \par Iterator category
+    ForwardIterator
+
+    \par Throws
+    If predicates copy throws.
+    If allocation throws.
+
+    \warning
+    The swap of the flat rtree invalidates the iterators.
+
+    \param predicates   Predicates.
+
+    \return             The iterator pointing at the begin of the query range.
+    */
+    template <typename Predicates>
+    const_query_iterator qbegin(Predicates const& predicates) const
+    {
+        static const unsigned distance_predicates_count = detail::predicates_count_distance<Predicates>::value;
+        static const bool is_distance_predicate = 0 < distance_predicates_count;
+        BOOST_MPL_ASSERT_MSG((distance_predicates_count <= 1), PASS_ONLY_ONE_DISTANCE_PREDICATE, (Predicates));
+
+        return qbegin_dispatch(predicates, boost::mpl::bool_<is_distance_predicate>());
+    }
+
+    /*!
+    \brief Returns a query iterator pointing at the end of the query range.
+
+    This method returns an iterator which may be used to check if the query has ended.
+
+    \par Iterator category
+    ForwardIterator
+
+    \par Throws
+    Nothing
+
+    \return             The iterator pointing at the end of the query range.
+    */
+    const_query_iterator qend() const
+    {
+        return const_query_iterator();
+    }
+
+    /*!
+    \brief Returns the iterator pointing at the first Value.
+
+    The Values are traversed in the order of leafs.
+
+    \par Throws
+    Nothing.
+    */
+    const_iterator begin() const
+    {
+        return m_storage.values.begin();
+    }
+
+    /*!
+    \brief Returns the iterator pointing past the last Value.
+
+    \par Throws
+    Nothing.
+    */
+    const_iterator end() const
+    {
+        return m_storage.values.end();
+    }
+
+    /*!
+    \brief Returns the number of stored values.
+
+    \return         The number of stored values.
+
+    \par Throws
+    Nothing.
+    */
+    inline size_type size() const
+    {
+        return m_storage.values.size();
+    }
+
+    /*!
+    \brief Query if the container is empty.
+
+    \return         true if the container is empty.
+
+    \par Throws
+    Nothing.
+    */
+    inline bool empty() const
+    {
+        return m_storage.values.empty();
+    }
+
+    /*!
+    \brief Returns the box able to contain all values stored in the container.
+
+    If the container is empty the result of \c geometry::assign_inverse() is returned.
+
+    \return     The box able to contain all values stored in the container or an invalid box if
+                there are no values in the container.
+
+    \par Throws
+    Nothing.
+    */
+    inline bounds_type bounds() const
+    {
+        bounds_type result;
+        if ( m_storage.nodes.empty() )
+        {
+            geometry::assign_inverse(result);
+            return result;
+        }
+
+        return m_storage.nodes.front().box;
+    }
+
+    /*!
+    \brief Returns parameters.
+
+    \return     The parameters object.
+
+    \par Throws
+    Nothing.
+    */
+    inline parameters_type parameters() const
+    {
+        return m_parameters;
+    }
+
+    /*!
+    \brief Returns function retrieving Indexable from Value.
+
+    \return     The indexable_getter object.
+
+    \par Throws
+    Nothing.
+    */
+    indexable_getter indexable_get() const
+    {
+        return m_translator;
+    }
+
+    /*!
+    \brief Returns function comparing Values
+
+    \return     The value_equal function.
+
+    \par Throws
+    Nothing.
+    */
+    value_equal value_eq() const
+    {
+        return m_translator;
+    }
+
+    /*!
+    \brief Returns allocator used by the flat rtree.
+
+    \return     The allocator.
+
+    \par Throws
+    If allocator copy constructor throws.
+    */
+    allocator_type get_allocator() const
+    {
+        return m_storage.values.get_allocator();
+    }
+
+    /*!
+    \brief Returns the depth of the R-tree.
+
+    This function is not a part of the 'official' interface.
+
+    \return     The depth of the R-tree.
+
+    \par Throws
+    Nothing.
+    */
+    inline size_type depth() const
+    {
+        return m_storage.leafs_level;
+    }
+
+private:
+    template <typename Predicates, typename OutIter>
+    size_type query_dispatch(Predicates const& predicates, OutIter out_it, boost::mpl::bool_<false> const& /*is_distance_predicate*/) const
+    {
+        detail::rtree::flat::spatial_query<storage_type, translator_type, Predicates, OutIter>
+            find_v(m_storage, m_translator, predicates, out_it);
+
+        find_v.apply(0);
+
+        return find_v.found_count;
+    }
+
+    template <typename Predicates, typename OutIter>
+    size_type query_dispatch(Predicates const& predicates, OutIter out_it, boost::mpl::bool_<true> const& /*is_distance_predicate*/) const
+    {
+        static const unsigned distance_predicate_index = detail::predicates_find_distance<Predicates>::value;
+        detail::rtree::flat::distance_query<
+            storage_type,
+            translator_type,
+            Predicates,
+            distance_predicate_index,
+            OutIter
+        > distance_v(m_storage, m_parameters.get_max_elements(), m_translator, predicates, out_it);
+
+        distance_v.apply(0);
+
+        return distance_v.finish();
+    }
+
+    template <typename Predicates>
+    const_query_iterator qbegin_dispatch(Predicates const& predicates, boost::mpl::bool_<false> const& /*is_distance_predicate*/) const
+    {
+        typedef detail::rtree::flat::query_iterator<
+            detail::rtree::flat::spatial_query_incremental<storage_type, translator_type, Predicates>
+        > iterator_type;
+        typedef typename iterator_type::visitor_type visitor_type;
+
+        visitor_type const visitor(m_storage, m_translator, predicates);
+
+        if ( m_storage.nodes.empty() )
+            return const_query_iterator(iterator_type(visitor));
+
+        return const_query_iterator(iterator_type(visitor, 0));
+    }
+
+    template <typename Predicates>
+    const_query_iterator qbegin_dispatch(Predicates const& predicates, boost::mpl::bool_<true> const& /*is_distance_predicate*/) const
+    {
+        typedef detail::rtree::flat::query_iterator<
+            detail::rtree::flat::distance_query_incremental<
+                storage_type,
+                translator_type,
+                Predicates,
+                detail::predicates_find_distance<Predicates>::value
+            >
+        > iterator_type;
+        typedef typename iterator_type::visitor_type visitor_type;
+
+        visitor_type const visitor(m_storage, m_translator, predicates);
+
+        if ( m_storage.nodes.empty() )
+            return const_query_iterator(iterator_type(visitor));
+
+        return const_query_iterator(iterator_type(visitor, 0));
+    }
+
+    translator_type m_translator;
+    Parameters m_parameters;
+    storage_type m_storage;
+
+    friend class detail::rtree::flat::view<flat_rtree>;
+};
+
+/*!
+\brief Creates the flat R-tree containing the same nodes and Values as the R-tree.
+
+\ingroup rtree_functions
+
+\param tree     The R-tree.
+
+\return         The flat R-tree.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>
+freeze(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree)
+{
+    return flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>(tree);
+}
+
+/*!
+\brief Find values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
+
+It calls <tt>flat_rtree::query(Predicates const&, OutIter)</tt>.
+
+\ingroup rtree_functions
+
+\param tree         The flat rtree.
+\param predicates   Predicates.
+\param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+\return             The number of values found.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename Predicates, typename OutIter> inline
+typename flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+query(flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+      Predicates const& predicates,
+      OutIter out_it)
+{
+    return tree.query(predicates, out_it);
+}
+
+/*!
+\brief Returns the query iterator pointing at the begin of the query range.
+
+It calls <tt>flat_rtree::qbegin(Predicates const&)</tt>.
+
+\ingroup rtree_functions
+
+\param tree         The flat rtree.
+\param predicates   Predicates.
+
+\return             The iterator pointing at the begin of the query range.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename Predicates> inline
+typename flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::const_query_iterator
+qbegin(flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+       Predicates const& predicates)
+{
+    return tree.qbegin(predicates);
+}
+
+/*!
+\brief Returns the query iterator pointing at the end of the query range.
+
+It calls \c flat_rtree::qend().
+
+\ingroup rtree_functions
+
+\param tree         The flat rtree.
+
+\return             The iterator pointing at the end of the query range.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator> inline
+typename flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::const_query_iterator
+qend(flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree)
+{
+    return tree.qend();
+}
+
+/*!
+\brief Exchanges the contents of the container with those of other.
+
+It calls \c flat_rtree::swap().
+
+\ingroup rtree_functions
+
+\param l     The first flat rtree.
+\param r     The second flat rtree.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline void swap(flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> & l,
+                 flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> & r)
+{
+    return l.swap(r);
+}
+
+}}} // namespace boost::geometry::index
+
+#include <boost/geometry/index/detail/config_end.hpp>
+
+#endif // BOOST_GEOMETRY_INDEX_FLAT_RTREE_HPP
@@ -0,0 +1,522 @@
+// Boost.Geometry Index
+//
+// R-tree stored in the binary format which may be queried in mapped memory
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_MAPPED_RTREE_HPP
+#define BOOST_GEOMETRY_INDEX_MAPPED_RTREE_HPP
+
+#include <ostream>
+
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+
+#include <boost/geometry/index/flat_rtree.hpp>
+
+#include <boost/geometry/index/detail/config_begin.hpp>
+
+#include <boost/geometry/index/detail/rtree/flat/mapped.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief The read-only R-tree stored in memory in the binary format, e.g. in a memory-mapped file.
+
+The mapped R-tree doesn't own the memory and doesn't copy the data, the queries
+are performed directly on the nodes and Values stored in the memory passed to
+the constructor. So the R-tree may be opened immediately, e.g. after mapping
+a file with <tt>boost::interprocess::mapped_region</tt>, and only the pages
+touched by the queries are loaded from the disk. The data must be created
+by <tt>write_mapped()</tt>.
+
+The nodes and Values are stored in the same layout as in the flat R-tree
+and as they're stored in memory. Because of that Value must be trivially
+copyable and the data may be opened only on platforms with the same byte
+order, sizes and alignments of types. The binary format contains the header
+storing the version, parameters, the sizes of types and the sizes of stored
+arrays which is checked when the mapped R-tree is created.
+
+\tparam Value           The type of objects stored in the container, it must be trivially copyable.
+\tparam Parameters      Compile-time parameters.
+\tparam IndexableGetter The function object extracting Indexable from Value.
+\tparam EqualTo         The function object comparing objects of type Value.
+*/
+template <
+    typename Value,
+    typename Parameters,
+    typename IndexableGetter = index::indexable<Value>,
+    typename EqualTo = index::equal_to<Value>
+>
+class mapped_rtree
+{
+    BOOST_MPL_ASSERT_MSG(
+        (boost::has_trivial_copy<Value>::value),
+        VALUE_TYPE_MUST_BE_TRIVIALLY_COPYABLE,
+        (Value));
+
+public:
+    /*! \brief The type of Value stored in the container. */
+    typedef Value value_type;
+    /*! \brief R-tree parameters type. */
+    typedef Parameters parameters_type;
+    /*! \brief The function object extracting Indexable from Value. */
+    typedef IndexableGetter indexable_getter;
+    /*! \brief The function object comparing objects of type Value. */
+    typedef EqualTo value_equal;
+
+    /*! \brief The Indexable type to which Value is translated. */
+    typedef typename index::rtree<Value, Parameters, IndexableGetter, EqualTo>::indexable_type indexable_type;
+    /*! \brief The Box type used by the R-tree. */
+    typedef typename index::rtree<Value, Parameters, IndexableGetter, EqualTo>::bounds_type bounds_type;
+
+private:
+    typedef detail::translator<IndexableGetter, EqualTo> translator_type;
+
+    // the same nodes as in the flat_rtree
+    typedef detail::rtree::flat::node<bounds_type, boost::uint32_t> node_type;
+
+    typedef detail::rtree::flat::mapped::array_view<node_type> nodes_type;
+    typedef detail::rtree::flat::mapped::array_view<value_type> values_type;
+
+    typedef detail::rtree::flat::storage<nodes_type, values_type> storage_type;
+
+public:
+    /*! \brief Type of reference to Value. */
+    typedef Value const& const_reference;
+    /*! \brief Type of pointer to Value. */
+    typedef Value const* const_pointer;
+    /*! \brief Type of difference type. */
+    typedef std::ptrdiff_t difference_type;
+    /*! \brief Unsigned integral type used by the container. */
+    typedef std::size_t size_type;
+
+    /*! \brief The const-iterator of the mapped rtree. */
+    typedef Value const* const_iterator;
+
+    /*! \brief The type-erased const-query-iterator of the mapped rtree. */
+    typedef index::detail::rtree::iterators::query_iterator<value_type, values_type> const_query_iterator;
+
+public:
+
+    /*!
+    \brief The constructor.
+
+    The header and the nodes of the data are checked and the parameters are read. The data
+    isn't copied so it must exist as long as the mapped R-tree is used.
+
+    \param data         The pointer to the data created by write_mapped(), aligned at least
+                        like Value and the nodes, e.g. the address of the mapped region.
+    \param size         The size of the data in bytes.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+
+    \par Throws
+    \li std::runtime_error if the data has different format, version, byte order,
+        sizes of types or parameters, if the stored parameters, counts, levels
+        or children of nodes are invalid or if it's too small or not aligned.
+    */
+    inline mapped_rtree(const void * data, size_type size,
+                        indexable_getter const& getter = indexable_getter(),
+                        value_equal const& equal = value_equal())
+        : m_header(detail::rtree::flat::mapped::read_header<value_type, node_type>(data, size))
+        , m_translator(getter, equal)
+        , m_parameters(detail::rtree::flat::mapped::parameters_io<Parameters>::load(m_header))
+        , m_storage(
+            detail::rtree::flat::mapped::make_array_view<node_type>(
+                data, m_header.nodes_offset, m_header.nodes_count),
+            detail::rtree::flat::mapped::make_array_view<value_type>(
+                data, m_header.values_offset, m_header.values_count))
+    {
+        m_storage.leafs_begin = static_cast<size_type>(m_header.leafs_begin);
+        m_storage.leafs_level = m_header.leafs_level;
+        m_bounds = *reinterpret_cast<bounds_type const*>(
+                        static_cast<const char*>(data) + m_header.bounds_offset);
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
+
+    The same predicates as in the case of the R-tree query may be passed, see
+    <tt>rtree::query(Predicates const&, OutIter)</tt>.
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If predicates copy throws.
+
+    \warning
+    Only one \c nearest() perdicate may be passed to the query. Passing more of them results in compile-time error.
+
+    \param predicates   Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of values found.
+    */
+    template <typename Predicates, typename OutIter>
+    size_type query(Predicates const& predicates, OutIter out_it) const
+    {
+        if ( m_storage.nodes.empty() )
+            return 0;
+
+        static const unsigned distance_predicates_count = detail::predicates_count_distance<Predicates>::value;
+        static const bool is_distance_predicate = 0 < distance_predicates_count;
+        BOOST_MPL_ASSERT_MSG((distance_predicates_count <= 1), PASS_ONLY_ONE_DISTANCE_PREDICATE, (Predicates));
+
+        return query_dispatch(predicates, out_it, boost::mpl::bool_<is_distance_predicate>());
+    }
+
+    /*!
+    \brief Returns a query iterator pointing at the begin of the query range.
+
+    The same predicates as in the case of the R-tree query may be passed, see
+    <tt>rtree::qbegin(Predicates const&)</tt>.
+
+    \par Iterator category
+    ForwardIterator
+
+    \par Throws
+    If predicates copy throws.
+    If allocation throws.
+
+    \warning
+    The iterators refer to the mapped rtree which must exist as long as they're used.
+
+    \param predicates   Predicates.
+
+    \return             The iterator pointing at the begin of the query range.
+    */
+    template <typename Predicates>
+    const_query_iterator qbegin(Predicates const& predicates) const
+    {
+        static const unsigned distance_predicates_count = detail::predicates_count_distance<Predicates>::value;
+        static const bool is_distance_predicate = 0 < distance_predicates_count;
+        BOOST_MPL_ASSERT_MSG((distance_predicates_count <= 1), PASS_ONLY_ONE_DISTANCE_PREDICATE, (Predicates));
+
+        return qbegin_dispatch(predicates, boost::mpl::bool_<is_distance_predicate>());
+    }
+
+    /*!
+    \brief Returns a query iterator pointing at the end of the query range.
+
+    \par Iterator category
+    ForwardIterator
+
+    \par Throws
+    Nothing
+
+    \return             The iterator pointing at the end of the query range.
+    */
+    const_query_iterator qend() const
+    {
+        return const_query_iterator();
+    }
+
+    /*!
+    \brief Returns the iterator pointing at the first Value.
+
+    The Values are traversed in the order of leafs.
+
+    \par Throws
+    Nothing.
+    */
+    const_iterator begin() const
+    {
+        return m_storage.values.begin();
+    }
+
+    /*!
+    \brief Returns the iterator pointing past the last Value.
+
+    \par Throws
+    Nothing.
+    */
+    const_iterator end() const
+    {
+        return m_storage.values.end();
+    }
+
+    /*!
+    \brief Returns the number of stored values.
+
+    \return         The number of stored values.
+
+    \par Throws
+    Nothing.
+    */
+    inline size_type size() const
+    {
+        return m_storage.values.size();
+    }
+
+    /*!
+    \brief Query if the container is empty.
+
+    \return         true if the container is empty.
+
+    \par Throws
+    Nothing.
+    */
+    inline bool empty() const
+    {
+        return m_storage.values.empty();
+    }
+
+    /*!
+    \brief Returns the box able to contain all values stored in the container.
+
+    If the container is empty the result of \c geometry::assign_inverse() is returned.
+
+    \return     The box able to contain all values stored in the container or an invalid box if
+                there are no values in the container.
+
+    \par Throws
+    Nothing.
+    */
+    inline bounds_type bounds() const
+    {
+        return m_bounds;
+    }
+
+    /*!
+    \brief Returns parameters.
+
+    \return     The parameters object.
+
+    \par Throws
+    Nothing.
+    */
+    inline parameters_type parameters() const
+    {
+        return m_parameters;
+    }
+
+    /*!
+    \brief Returns function retrieving Indexable from Value.
+
+    \return     The indexable_getter object.
+
+    \par Throws
+    Nothing.
+    */
+    indexable_getter indexable_get() const
+    {
+        return m_translator;
+    }
+
+    /*!
+    \brief Returns function comparing Values
+
+    \return     The value_equal function.
+
+    \par Throws
+    Nothing.
+    */
+    value_equal value_eq() const
+    {
+        return m_translator;
+    }
+
+    /*!
+    \brief Returns the depth of the R-tree.
+
+    This function is not a part of the 'official' interface.
+
+    \return     The depth of the R-tree.
+
+    \par Throws
+    Nothing.
+    */
+    inline size_type depth() const
+    {
+        return m_storage.leafs_level;
+    }
+
+private:
+    template <typename Predicates, typename OutIter>
+    size_type query_dispatch(Predicates const& predicates, OutIter out_it, boost::mpl::bool_<false> const& /*is_distance_predicate*/) const
+    {
+        detail::rtree::flat::spatial_query<storage_type, translator_type, Predicates, OutIter>
+            find_v(m_storage, m_translator, predicates, out_it);
+
+        find_v.apply(0);
+
+        return find_v.found_count;
+    }
+
+    template <typename Predicates, typename OutIter>
+    size_type query_dispatch(Predicates const& predicates, OutIter out_it, boost::mpl::bool_<true> const& /*is_distance_predicate*/) const
+    {
+        static const unsigned distance_predicate_index = detail::predicates_find_distance<Predicates>::value;
+        detail::rtree::flat::distance_query<
+            storage_type,
+            translator_type,
+            Predicates,
+            distance_predicate_index,
+            OutIter
+        > distance_v(m_storage, m_parameters.get_max_elements(), m_translator, predicates, out_it);
+
+        distance_v.apply(0);
+
+        return distance_v.finish();
+    }
+
+    template <typename Predicates>
+    const_query_iterator qbegin_dispatch(Predicates const& predicates, boost::mpl::bool_<false> const& /*is_distance_predicate*/) const
+    {
+        typedef detail::rtree::flat::query_iterator<
+            detail::rtree::flat::spatial_query_incremental<storage_type, translator_type, Predicates>
+        > iterator_type;
+        typedef typename iterator_type::visitor_type visitor_type;
+
+        visitor_type const visitor(m_storage, m_translator, predicates);
+
+        if ( m_storage.nodes.empty() )
+            return const_query_iterator(iterator_type(visitor));
+
+        return const_query_iterator(iterator_type(visitor, 0));
+    }
+
+    template <typename Predicates>
+    const_query_iterator qbegin_dispatch(Predicates const& predicates, boost::mpl::bool_<true> const& /*is_distance_predicate*/) const
+    {
+        typedef detail::rtree::flat::query_iterator<
+            detail::rtree::flat::distance_query_incremental<
+                storage_type,
+                translator_type,
+                Predicates,
+                detail::predicates_find_distance<Predicates>::value
+            >
+        > iterator_type;
+        typedef typename iterator_type::visitor_type visitor_type;
+
+        visitor_type const visitor(m_storage, m_translator, predicates);
+
+        if ( m_storage.nodes.empty() )
+            return const_query_iterator(iterator_type(visitor));
+
+        return const_query_iterator(iterator_type(visitor, 0));
+    }
+
+    detail::rtree::flat::mapped::file_header m_header;
+    translator_type m_translator;
+    Parameters m_parameters;
+    storage_type m_storage;
+    bounds_type m_bounds;
+};
+
+/*!
+\brief Writes the flat R-tree in the binary format which may be opened by the mapped R-tree.
+
+The nodes and Values are written as they're stored in memory, Value must be
+trivially copyable. The errors are reported by the stream which should be opened
+in binary mode.
+
+\ingroup rtree_functions
+
+\param os       The output stream.
+\param tree     The flat R-tree.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline void write_mapped(std::ostream & os,
+                         flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree)
+{
+    BOOST_MPL_ASSERT_MSG(
+        (boost::has_trivial_copy<Value>::value),
+        VALUE_TYPE_MUST_BE_TRIVIALLY_COPYABLE,
+        (Value));
+
+    typedef flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> flat_rtree_type;
+
+    detail::rtree::flat::view<flat_rtree_type> v(tree);
+    detail::rtree::flat::mapped::write(os, v.storage(), tree.parameters(), tree.bounds());
+}
+
+/*!
+\brief Writes the R-tree in the binary format which may be opened by the mapped R-tree.
+
+The R-tree is converted to the flat R-tree first, see <tt>freeze()</tt>. Packed R-trees
+should be used because their nodes are fuller.
+
+\ingroup rtree_functions
+
+\param os       The output stream.
+\param tree     The R-tree.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline void write_mapped(std::ostream & os,
+                         rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree)
+{
+    write_mapped(os, freeze(tree));
+}
+
+/*!
+\brief Find values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
+
+It calls <tt>mapped_rtree::query(Predicates const&, OutIter)</tt>.
+
+\ingroup rtree_functions
+
+\param tree         The mapped rtree.
+\param predicates   Predicates.
+\param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+\return             The number of values found.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo,
+          typename Predicates, typename OutIter> inline
+typename mapped_rtree<Value, Parameters, IndexableGetter, EqualTo>::size_type
+query(mapped_rtree<Value, Parameters, IndexableGetter, EqualTo> const& tree,
+      Predicates const& predicates,
+      OutIter out_it)
+{
+    return tree.query(predicates, out_it);
+}
+
+/*!
+\brief Returns the query iterator pointing at the begin of the query range.
+
+It calls <tt>mapped_rtree::qbegin(Predicates const&)</tt>.
+
+\ingroup rtree_functions
+
+\param tree         The mapped rtree.
+\param predicates   Predicates.
+
+\return             The iterator pointing at the begin of the query range.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo,
+          typename Predicates> inline
+typename mapped_rtree<Value, Parameters, IndexableGetter, EqualTo>::const_query_iterator
+qbegin(mapped_rtree<Value, Parameters, IndexableGetter, EqualTo> const& tree,
+       Predicates const& predicates)
+{
+    return tree.qbegin(predicates);
+}
+
+/*!
+\brief Returns the query iterator pointing at the end of the query range.
+
+It calls \c mapped_rtree::qend().
+
+\ingroup rtree_functions
+
+\param tree         The mapped rtree.
+
+\return             The iterator pointing at the end of the query range.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo> inline
+typename mapped_rtree<Value, Parameters, IndexableGetter, EqualTo>::const_query_iterator
+qend(mapped_rtree<Value, Parameters, IndexableGetter, EqualTo> const& tree)
+{
+    return tree.qend();
+}
+
+}}} // namespace boost::geometry::index
+
+#include <boost/geometry/index/detail/config_end.hpp>
+
+#endif // BOOST_GEOMETRY_INDEX_MAPPED_RTREE_HPP
@@ -0,0 +1,78 @@
+// Boost.Geometry Index
+//
+// R-tree packing algorithms
+//
+// Copyright (c) 2016 Boost.Geometry contributors.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_PACKING_HPP
+#define BOOST_GEOMETRY_INDEX_PACKING_HPP
+
+#include <boost/mpl/bool.hpp>
+
+#include <boost/geometry/index/detail/algorithms/space_filling_curve.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief Hilbert curve packing algorithm.
+
+The Values are sorted by the position of the centroids of their Indexables
+on the Hilbert curve and the nodes are filled sequentially.
+*/
+struct hilbert_packing {};
+
+/*!
+\brief Morton (Z-order) curve packing algorithm.
+
+The Values are sorted by the position of the centroids of their Indexables
+on the Z-order curve and the nodes are filled sequentially.
+*/
+struct morton_packing {};
+
+namespace detail { namespace rtree {
+
+// The default packing algorithm, top-down median split
+struct default_packing_tag {};
+
+template <typename Packing>
+struct is_packing
+    : boost::mpl::false_
+{};
+
+template <>
+struct is_packing<index::hilbert_packing>
+    : boost::mpl::true_
+{};
+
+template <>
+struct is_packing<index::morton_packing>
+    : boost::mpl::true_
+{};
+
+template <typename Packing>
+struct packing_curve
+{
+    typedef void type;
+};
+
+template <>
+struct packing_curve<index::hilbert_packing>
+{
+    typedef detail::hilbert_curve type;
+};
+
+template <>
+struct packing_curve<index::morton_packing>
+{
+    typedef detail::morton_curve type;
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_PACKING_HPP
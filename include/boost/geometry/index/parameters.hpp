@@ -137,12 +137,35 @@ struct rstar
     static size_t get_overlap_cost_threshold() { return OverlapCostThreshold; }
 };
 
-//template <size_t MaxElements, size_t MinElements>
-//struct kmeans
-//{
-//    static const size_t max_elements = MaxElements;
-//    static const size_t min_elements = MinElements;
-//};
+/*!
+\brief K-means r-tree creation algorithm parameters.
+
+Overflowing nodes are split into two groups of elements using k-means
+clustering of the centroids of elements. This algorithm gives nodes
+covering tightly the clusters of elements.
+
+\tparam MaxElements     Maximum number of elements in nodes.
+\tparam MinElements     Minimum number of elements in nodes. Default: 0.3*Max.
+\tparam MaxIterations   Maximum number of iterations of the clustering of a split node. Default: 16.
+*/
+template <size_t MaxElements,
+          size_t MinElements = detail::default_min_elements_s<MaxElements>::value,
+          size_t MaxIterations = 16>
+struct kmeans
+{
+    BOOST_MPL_ASSERT_MSG((0 < MinElements && 2*MinElements <= MaxElements+1),
+                         INVALID_STATIC_MIN_MAX_PARAMETERS, (kmeans));
+    BOOST_MPL_ASSERT_MSG((0 < MaxIterations),
+                         INVALID_STATIC_MAX_ITERATIONS_PARAMETER, (kmeans));
+
+    static const size_t max_elements = MaxElements;
+    static const size_t min_elements = MinElements;
+    static const size_t max_iterations = MaxIterations;
+
+    static size_t get_max_elements() { return MaxElements; }
+    static size_t get_min_elements() { return MinElements; }
+    static size_t get_max_iterations() { return MaxIterations; }
+};
 
 /*!
 \brief Linear r-tree creation algorithm parameters - run-time version.
@@ -202,6 +225,42 @@ private:
     size_t m_min_elements;
 };
 
+/*!
+\brief K-means r-tree creation algorithm parameters - run-time version.
+*/
+class dynamic_kmeans
+{
+public:
+    /*!
+    \brief The constructor.
+
+    \param max_elements     Maximum number of elements in nodes.
+    \param min_elements     Minimum number of elements in nodes. Default: 0.3*Max.
+    \param max_iterations   Maximum number of iterations of the clustering of a split node. Default: 16.
+    */
+    dynamic_kmeans(size_t max_elements,
+                   size_t min_elements = detail::default_min_elements_d(),
+                   size_t max_iterations = 16)
+        : m_max_elements(max_elements)
+        , m_min_elements(detail::default_min_elements_d_calc(max_elements, min_elements))
+        , m_max_iterations(max_iterations)
+    {
+        if (!(0 < m_min_elements && 2*m_min_elements <= m_max_elements+1))
+            detail::throw_invalid_argument("invalid min or/and max parameters of dynamic_kmeans");
+        if (m_max_iterations == 0)
+            detail::throw_invalid_argument("invalid max iterations parameter of dynamic_kmeans");
+    }
+
+    size_t get_max_elements() const { return m_max_elements; }
+    size_t get_min_elements() const { return m_min_elements; }
+    size_t get_max_iterations() const { return m_max_iterations; }
+
+private:
+    size_t m_max_elements;
+    size_t m_min_elements;
+    size_t m_max_iterations;
+};
+
 /*!
 \brief R*-tree creation algorithm parameters - run-time version.
 */
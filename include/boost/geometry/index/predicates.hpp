@@ -16,6 +16,7 @@
 #include <boost/mpl/assert.hpp>
 
 #include <boost/geometry/index/detail/predicates.hpp>
+#include <boost/geometry/index/detail/join_predicates.hpp>
 #include <boost/geometry/index/detail/tuples.hpp>
 
 /*!
@@ -335,6 +336,94 @@ nearest(Geometry const& geometry, unsigned k)
     return detail::predicates::nearest<Geometry>(geometry, k);
 }
 
+/*!
+\brief Generate nearest() predicate using the given traversal of the R-tree.
+
+The same as <tt>nearest(Geometry const&, unsigned)</tt> but the query traverses
+the R-tree as specified instead of choosing the traversal by \c k. The best-first
+traversal visits less nodes, which pays off for a greater \c k or a costly distance.
+
+\par Example
+\verbatim
+bgi::query(spatial_index, bgi::nearest(pt, 5, bgi::best_first), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+
+\param geometry     The geometry from which distance is calculated.
+\param k            The maximum number of values to return.
+\param traversal    The traversal of the R-tree used by \c rtree::query().
+*/
+template <typename Geometry> inline
+detail::predicates::nearest<Geometry>
+nearest(Geometry const& geometry, unsigned k, nearest_traversal traversal)
+{
+    return detail::predicates::nearest<Geometry>(geometry, k, traversal);
+}
+
+/*!
+\brief Generate join_intersects() predicate.
+
+Generate a predicate defining the relationship of Values stored in two spatial indexes.
+A pair of Values will be returned by the join if <tt>bg::intersects(Indexable1, Indexable2)</tt>
+returns true.
+
+\par Example
+\verbatim
+bgi::join(rtree1, rtree2, bgi::join_intersects(), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+*/
+inline detail::join_predicates::spatial<detail::predicates::intersects_tag>
+join_intersects()
+{
+    return detail::join_predicates::spatial<detail::predicates::intersects_tag>();
+}
+
+/*!
+\brief Generate join_within() predicate.
+
+Generate a predicate defining the relationship of Values stored in two spatial indexes.
+A pair of Values will be returned by the join if <tt>bg::within(Indexable1, Indexable2)</tt>
+returns true.
+
+\par Example
+\verbatim
+bgi::join(points_rtree, boxes_rtree, bgi::join_within(), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+*/
+inline detail::join_predicates::spatial<detail::predicates::within_tag>
+join_within()
+{
+    return detail::join_predicates::spatial<detail::predicates::within_tag>();
+}
+
+/*!
+\brief Generate join_distance_within() predicate.
+
+Generate a predicate defining the relationship of Values stored in two spatial indexes.
+A pair of Values will be returned by the join if <tt>bg::distance(Indexable1, Indexable2)</tt>
+is lesser or equal to the maximum distance.
+
+\par Example
+\verbatim
+bgi::join(rtree1, rtree2, bgi::join_distance_within(10.0), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+
+\param max_distance The maximum distance between the Indexables.
+*/
+template <typename T> inline
+detail::join_predicates::distance_within<T>
+join_distance_within(T const& max_distance)
+{
+    return detail::join_predicates::distance_within<T>(max_distance);
+}
+
 #ifdef BOOST_GEOMETRY_INDEX_DETAIL_EXPERIMENTAL
 
 /*!
@@ -16,6 +16,8 @@
 #include <algorithm>
 
 // Boost
+#include <boost/core/enable_if.hpp>
+#include <boost/core/ignore_unused.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/move/move.hpp>
 
@@ -35,6 +37,8 @@
 
 #include <boost/geometry/strategies/strategies.hpp>
 
+#include <boost/geometry/util/parallel.hpp>
+
 // Boost.Geometry.Index
 #include <boost/geometry/index/detail/config_begin.hpp>
 
@@ -45,6 +49,7 @@
 
 #include <boost/geometry/index/indexable.hpp>
 #include <boost/geometry/index/equal_to.hpp>
+#include <boost/geometry/index/packing.hpp>
 
 #include <boost/geometry/index/detail/translator.hpp>
 
@@ -65,13 +70,15 @@
 #include <boost/geometry/index/detail/rtree/visitors/destroy.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/spatial_query.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/distance_query.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/batch_distance_query.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/join_query.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/count.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/children_box.hpp>
 
 #include <boost/geometry/index/detail/rtree/linear/linear.hpp>
 #include <boost/geometry/index/detail/rtree/quadratic/quadratic.hpp>
 #include <boost/geometry/index/detail/rtree/rstar/rstar.hpp>
-//#include <boost/geometry/extensions/index/detail/rtree/kmeans/kmeans.hpp>
+#include <boost/geometry/index/detail/rtree/kmeans/kmeans.hpp>
 
 #include <boost/geometry/index/detail/rtree/pack_create.hpp>
 
@@ -110,13 +117,15 @@ algorithm with specific parameters like min and max number of elements in node.
 Predefined algorithms with compile-time parameters are:
 \li <tt>boost::geometry::index::linear</tt>,
  \li <tt>boost::geometry::index::quadratic</tt>,
- \li <tt>boost::geometry::index::rstar</tt>.
+ \li <tt>boost::geometry::index::rstar</tt>,
+ \li <tt>boost::geometry::index::kmeans</tt>.
 
 \par
 Predefined algorithms with run-time parameters are:
  \li \c boost::geometry::index::dynamic_linear,
  \li \c boost::geometry::index::dynamic_quadratic,
- \li \c boost::geometry::index::dynamic_rstar.
+ \li \c boost::geometry::index::dynamic_rstar,
+ \li \c boost::geometry::index::dynamic_kmeans.
 
 \par IndexableGetter
 The object of IndexableGetter type translates from Value to Indexable each time
@@ -201,7 +210,11 @@ private:
     typedef ::boost::container::allocator_traits<Allocator> allocator_traits_type;
     typedef detail::rtree::subtree_destroyer<value_type, options_type, translator_type, box_type, allocators_type> subtree_destroyer;
 
+    typedef detail::rtree::visitors::join_tree<value_type, options_type, translator_type, box_type, allocators_type> join_tree_type;
+
     friend class detail::rtree::utilities::view<rtree>;
+    template <typename V, typename P, typename I, typename E, typename A>
+    friend class rtree;
 #ifdef BOOST_GEOMETRY_INDEX_DETAIL_EXPERIMENTAL
     friend class detail::rtree::private_view<rtree>;
     friend class detail::rtree::const_private_view<rtree>;
@@ -335,6 +348,160 @@ public:
         m_members.leafs_level = ll;
     }
 
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm. The subtrees are packed in parallel
+    by up to the number of threads requested by the policy. The resulting tree is the
+    same as the one created by the sequential version of the packing algorithm.
+
+    \param first        The beginning of the range of Values.
+    \param last         The end of the range of Values.
+    \param policy       The parallel execution policy.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object. It must be safe to allocate
+                        and deallocate nodes concurrently.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Iterator>
+    inline rtree(Iterator first, Iterator last,
+                 geometry::parallel const& policy,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        typedef detail::rtree::pack<value_type, options_type, translator_type, box_type, allocators_type> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(first, last, vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators(),
+                                     geometry::detail::parallel::threads_count(policy));
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm. The subtrees are packed in parallel
+    by up to the number of threads requested by the policy. The resulting tree is the
+    same as the one created by the sequential version of the packing algorithm.
+
+    \param rng          The range of Values.
+    \param policy       The parallel execution policy.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object. It must be safe to allocate
+                        and deallocate nodes concurrently.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Range>
+    inline rtree(Range const& rng,
+                 geometry::parallel const& policy,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        typedef detail::rtree::pack<value_type, options_type, translator_type, box_type, allocators_type> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(::boost::begin(rng), ::boost::end(rng), vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators(),
+                                     geometry::detail::parallel::threads_count(policy));
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using the packing algorithm passed as the third argument,
+    \c index::hilbert_packing or \c index::morton_packing. The Values are sorted
+    along a space-filling curve and the nodes are filled sequentially.
+
+    \param first        The beginning of the range of Values.
+    \param last         The end of the range of Values.
+    \param packing      The packing algorithm.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Iterator, typename Packing>
+    inline rtree(Iterator first, Iterator last,
+                 Packing const& packing,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type(),
+                 typename boost::enable_if_c<detail::rtree::is_packing<Packing>::value>::type * = 0)
+        : m_members(getter, equal, parameters, allocator)
+    {
+        boost::ignore_unused(packing);
+        typedef detail::rtree::pack<value_type, options_type, translator_type, box_type, allocators_type, Packing> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(first, last, vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators());
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using the packing algorithm passed as the second argument,
+    \c index::hilbert_packing or \c index::morton_packing. The Values are sorted
+    along a space-filling curve and the nodes are filled sequentially.
+
+    \param rng          The range of Values.
+    \param packing      The packing algorithm.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Range, typename Packing>
+    inline rtree(Range const& rng,
+                 Packing const& packing,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type(),
+                 typename boost::enable_if_c<detail::rtree::is_packing<Packing>::value>::type * = 0)
+        : m_members(getter, equal, parameters, allocator)
+    {
+        boost::ignore_unused(packing);
+        typedef detail::rtree::pack<value_type, options_type, translator_type, box_type, allocators_type, Packing> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(::boost::begin(rng), ::boost::end(rng), vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators());
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
     /*!
     \brief The destructor.
 
@@ -838,6 +1005,169 @@ public:
         return query_dispatch(predicates, out_it, boost::mpl::bool_<is_distance_predicate>());
     }
 
+    /*!
+    \brief Finds k values nearest to each of the query geometries.
+
+    The result is the same as the result of calling query() with the \c nearest()
+    predicate for each of the geometries but the geometries are sorted spatially first
+    so the consecutive queries visit mostly the same nodes which are already in the cache.
+
+    The neighbors of the i-th geometry are written to the range <tt>[out_it + i*k, out_it + i*k + n)</tt>
+    in the same order as by query() and their number \c n (less than \c k if the container
+    contains less than \c k values) is written to <tt>*(counts_it + i)</tt>.
+
+    \par Example
+    \verbatim
+    std::vector<Value> result(points.size() * 5);
+    std::vector<std::size_t> counts(points.size());
+    tree.batch_nearest(points, 5, result.begin(), counts.begin());
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If geometry copy throws.
+    The rtree isn't changed but the values and counts found before the
+    exception may already be written to the outputs.
+
+    \param queries      The random access range of geometries, e.g. Points.
+    \param k            The number of nearest values searched for each geometry.
+    \param out_it       The random access iterator to the output of at least <tt>size(queries) * k</tt> Values.
+    \param counts_it    The random access iterator to the output of the numbers of values found for each geometry.
+
+    \return             The number of values found.
+    */
+    template <typename Queries, typename OutIter, typename CountIter>
+    size_type batch_nearest(Queries const& queries, size_type k, OutIter out_it, CountIter counts_it) const
+    {
+        return this->raw_batch_nearest(queries, k, out_it, counts_it, 1);
+    }
+
+    /*!
+    \brief Finds k values nearest to each of the query geometries in parallel.
+
+    The groups of query geometries are processed in parallel, the result is the same
+    as the result of the sequential version, see batch_nearest(Queries const&, size_type, OutIter, CountIter).
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If geometry copy throws.
+    The rtree isn't changed but the values and counts found before the
+    exception may already be written to the outputs.
+
+    \param queries      The random access range of geometries, e.g. Points.
+    \param k            The number of nearest values searched for each geometry.
+    \param out_it       The random access iterator to the output of at least <tt>size(queries) * k</tt> Values.
+    \param counts_it    The random access iterator to the output of the numbers of values found for each geometry.
+    \param policy       The parallel execution policy.
+
+    \return             The number of values found.
+    */
+    template <typename Queries, typename OutIter, typename CountIter>
+    size_type batch_nearest(Queries const& queries, size_type k, OutIter out_it, CountIter counts_it,
+                            geometry::parallel const& policy) const
+    {
+        return this->raw_batch_nearest(queries, k, out_it, counts_it,
+                                       geometry::detail::parallel::threads_count(policy));
+    }
+
+    /*!
+    \brief Finds the pairs of values of this and the other rtree meeting the join predicate.
+
+    Both rtrees are traversed at once and only the pairs of nodes whose boxes may contain
+    joined values are visited. The pairs <tt>std::pair<value_type, OtherValue></tt> are written
+    to the output iterator.
+
+    <b>Join predicates</b> may be generated by functions:
+    \li \c boost::geometry::index::join_intersects(),
+    \li \c boost::geometry::index::join_within(),
+    \li \c boost::geometry::index::join_distance_within().
+
+    \par Example
+    \verbatim
+    std::vector< std::pair<Value1, Value2> > result;
+    tree1.join(tree2, bgi::join_intersects(), std::back_inserter(result));
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If OutIter dereference or increment throws.
+
+    \param other        The other rtree.
+    \param predicate    The join predicate.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of pairs found.
+    */
+    template <typename OtherValue, typename OtherParameters, typename OtherIndexableGetter, typename OtherEqualTo, typename OtherAllocator,
+              typename JoinPredicate, typename OutIter>
+    size_type join(rtree<OtherValue, OtherParameters, OtherIndexableGetter, OtherEqualTo, OtherAllocator> const& other,
+                   JoinPredicate const& predicate, OutIter out_it) const
+    {
+        if ( !m_members.root || !other.m_members.root )
+            return 0;
+
+        typedef rtree<OtherValue, OtherParameters, OtherIndexableGetter, OtherEqualTo, OtherAllocator> other_rtree;
+
+        join_tree_type const tree1 = this->join_tree();
+        typename other_rtree::join_tree_type const tree2 = other.join_tree();
+
+        detail::rtree::visitors::join_query<
+            join_tree_type, typename other_rtree::join_tree_type, JoinPredicate, OutIter
+        > join_v(tree1, tree2, predicate, out_it);
+
+        join_v.apply();                                                                             // MAY THROW (V, C, A)
+
+        return static_cast<size_type>(join_v.found_count());
+    }
+
+    /*!
+    \brief Finds the pairs of values of this and the other rtree meeting the join predicate in parallel.
+
+    The pairs of children of the roots are joined in parallel and the result is the same as
+    the result of the sequential version, see join(Rtree const&, JoinPredicate const&, OutIter).
+    The pairs are gathered in temporary containers and written to the output at the end.
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If OutIter dereference or increment throws.
+    If allocation throws.
+
+    \param other        The other rtree.
+    \param predicate    The join predicate.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+    \param policy       The parallel execution policy.
+
+    \return             The number of pairs found.
+    */
+    template <typename OtherValue, typename OtherParameters, typename OtherIndexableGetter, typename OtherEqualTo, typename OtherAllocator,
+              typename JoinPredicate, typename OutIter>
+    size_type join(rtree<OtherValue, OtherParameters, OtherIndexableGetter, OtherEqualTo, OtherAllocator> const& other,
+                   JoinPredicate const& predicate, OutIter out_it,
+                   geometry::parallel const& policy) const
+    {
+        if ( !m_members.root || !other.m_members.root )
+            return 0;
+
+        std::size_t const threads = geometry::detail::parallel::threads_count(policy);
+
+        // the results of the tasks are buffered, don't do it if there is nothing to gain
+        if ( threads <= 1 )
+            return this->join(other, predicate, out_it);                                            // MAY THROW (V, C, A)
+
+        typedef rtree<OtherValue, OtherParameters, OtherIndexableGetter, OtherEqualTo, OtherAllocator> other_rtree;
+
+        join_tree_type const tree1 = this->join_tree();
+        typename other_rtree::join_tree_type const tree2 = other.join_tree();
+
+        detail::rtree::visitors::parallel_join_query<
+            join_tree_type, typename other_rtree::join_tree_type, JoinPredicate
+        > join_v(tree1, tree2, predicate);                                                          // MAY THROW (A)
+
+        geometry::detail::parallel::for_each_index(join_v.tasks_count(), join_v, threads);          // MAY THROW (V, C, A)
+
+        return static_cast<size_type>(join_v.finish(out_it));                                     // MAY THROW (V, C)
+    }
+
     /*!
     \brief Returns a query iterator pointing at the begin of the query range.
 
@@ -1427,6 +1757,16 @@ private:
         return m_members.leafs_level;
     }
 
+    /*!
+    \pre Root node must exist - m_root != 0.
+
+    \brief Returns the members used by the spatial join.
+    */
+    inline join_tree_type join_tree() const
+    {
+        return join_tree_type(m_members.root, m_members.leafs_level, this->bounds(), m_members.translator());
+    }
+
 private:
 
     /*!
@@ -1677,6 +2017,32 @@ private:
         BOOST_GEOMETRY_INDEX_ASSERT(m_members.root, "The root must exist");
 
         static const unsigned distance_predicate_index = detail::predicates_find_distance<Predicates>::value;
+
+        // the best-first traversal visits less nodes but has a greater overhead,
+        // by default it's used only for a greater k
+        typedef detail::predicates_element<distance_predicate_index, Predicates> element_access;
+        nearest_traversal const traversal
+            = detail::predicate_traversal(element_access::get(predicates));
+        if ( traversal == best_first
+          || ( traversal == default_traversal
+            && detail::rtree::visitors::best_first_min_count <= element_access::get(predicates).count ) )
+        {
+            detail::rtree::visitors::best_first_distance_query<
+                value_type,
+                options_type,
+                translator_type,
+                box_type,
+                allocators_type,
+                Predicates,
+                distance_predicate_index,
+                OutIter
+            > distance_v(m_members.parameters(), m_members.translator(), predicates, out_it);
+
+            detail::rtree::apply_visitor(distance_v, *m_members.root);
+
+            return distance_v.finish();
+        }
+
         detail::rtree::visitors::distance_query<
             value_type,
             options_type,
@@ -1692,7 +2058,45 @@ private:
 
         return distance_v.finish();
     }
-    
+
+    /*!
+    \brief Find k nearest values of each of the query geometries.
+
+    \par Exception-safety
+    basic, the rtree isn't changed but the outputs may be partially written
+    */
+    template <typename Queries, typename OutIter, typename CountIter>
+    size_type raw_batch_nearest(Queries const& queries, size_type k, OutIter out_it, CountIter counts_it,
+                                std::size_t threads) const
+    {
+        typedef typename boost::range_const_iterator<Queries>::type query_iterator;
+
+        size_type const queries_count = static_cast<size_type>(boost::size(queries));
+
+        if ( !m_members.root || k == 0 )
+        {
+            for ( size_type i = 0 ; i < queries_count ; ++i, ++counts_it )
+                *counts_it = 0;
+            return 0;
+        }
+
+        detail::rtree::visitors::batch_distance_query<
+            value_type,
+            options_type,
+            translator_type,
+            box_type,
+            allocators_type,
+            query_iterator,
+            OutIter,
+            CountIter
+        > batch_v(*m_members.root, this->bounds(), m_members.parameters(), m_members.translator(),
+                  boost::const_begin(queries), queries_count, k, out_it, counts_it);               // MAY THROW (A)
+
+        geometry::detail::parallel::for_each_index(batch_v.chunks_count(), batch_v, threads);      // MAY THROW (V, C, A)
+
+        return static_cast<size_type>(batch_v.found_count());
+    }
+
     /*!
     \brief Count elements corresponding to value or indexable.
 
@@ -1986,6 +2390,123 @@ query(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
     return tree.query(predicates, out_it);
 }
 
+/*!
+\brief Finds k values nearest to each of the query geometries.
+
+It calls <tt>rtree::batch_nearest(Queries const&, size_type, OutIter, CountIter)</tt>.
+
+\ingroup rtree_functions
+
+\param tree         The rtree.
+\param queries      The random access range of geometries, e.g. Points.
+\param k            The number of nearest values searched for each geometry.
+\param out_it       The random access iterator to the output of at least <tt>size(queries) * k</tt> Values.
+\param counts_it    The random access iterator to the output of the numbers of values found for each geometry.
+
+\return             The number of values found.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename Queries, typename OutIter, typename CountIter> inline
+typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+batch_nearest(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+              Queries const& queries,
+              typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type k,
+              OutIter out_it,
+              CountIter counts_it)
+{
+    return tree.batch_nearest(queries, k, out_it, counts_it);
+}
+
+/*!
+\brief Finds k values nearest to each of the query geometries in parallel.
+
+It calls <tt>rtree::batch_nearest(Queries const&, size_type, OutIter, CountIter, geometry::parallel const&)</tt>.
+
+\ingroup rtree_functions
+
+\param tree         The rtree.
+\param queries      The random access range of geometries, e.g. Points.
+\param k            The number of nearest values searched for each geometry.
+\param out_it       The random access iterator to the output of at least <tt>size(queries) * k</tt> Values.
+\param counts_it    The random access iterator to the output of the numbers of values found for each geometry.
+\param policy       The parallel execution policy.
+
+\return             The number of values found.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename Queries, typename OutIter, typename CountIter> inline
+typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+batch_nearest(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+              Queries const& queries,
+              typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type k,
+              OutIter out_it,
+              CountIter counts_it,
+              geometry::parallel const& policy)
+{
+    return tree.batch_nearest(queries, k, out_it, counts_it, policy);
+}
+
+/*!
+\brief Finds the pairs of values of two rtrees meeting the join predicate.
+
+It calls <tt>rtree::join(Rtree const&, JoinPredicate const&, OutIter)</tt>.
+
+\par Example
+\verbatim
+std::vector< std::pair<Value1, Value2> > result;
+bgi::join(tree1, tree2, bgi::join_intersects(), std::back_inserter(result));
+bgi::join(tree1, tree2, bgi::join_distance_within(10.0), std::back_inserter(result));
+\endverbatim
+
+\ingroup rtree_functions
+
+\param tree1        The first rtree.
+\param tree2        The second rtree.
+\param predicate    The join predicate.
+\param out_it       The output iterator of the pairs of values.
+
+\return             The number of pairs found.
+*/
+template <typename Value1, typename Parameters1, typename IndexableGetter1, typename EqualTo1, typename Allocator1,
+          typename Value2, typename Parameters2, typename IndexableGetter2, typename EqualTo2, typename Allocator2,
+          typename JoinPredicate, typename OutIter> inline
+typename rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1>::size_type
+join(rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1> const& tree1,
+     rtree<Value2, Parameters2, IndexableGetter2, EqualTo2, Allocator2> const& tree2,
+     JoinPredicate const& predicate,
+     OutIter out_it)
+{
+    return tree1.join(tree2, predicate, out_it);
+}
+
+/*!
+\brief Finds the pairs of values of two rtrees meeting the join predicate in parallel.
+
+It calls <tt>rtree::join(Rtree const&, JoinPredicate const&, OutIter, geometry::parallel const&)</tt>.
+
+\ingroup rtree_functions
+
+\param tree1        The first rtree.
+\param tree2        The second rtree.
+\param predicate    The join predicate.
+\param out_it       The output iterator of the pairs of values.
+\param policy       The parallel execution policy.
+
+\return             The number of pairs found.
+*/
+template <typename Value1, typename Parameters1, typename IndexableGetter1, typename EqualTo1, typename Allocator1,
+          typename Value2, typename Parameters2, typename IndexableGetter2, typename EqualTo2, typename Allocator2,
+          typename JoinPredicate, typename OutIter> inline
+typename rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1>::size_type
+join(rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1> const& tree1,
+     rtree<Value2, Parameters2, IndexableGetter2, EqualTo2, Allocator2> const& tree2,
+     JoinPredicate const& predicate,
+     OutIter out_it,
+     geometry::parallel const& policy)
+{
+    return tree1.join(tree2, predicate, out_it, policy);
+}
+
 /*!
 \brief Returns the query iterator pointing at the begin of the query range.
 
@@ -69,6 +69,7 @@ struct read_wkt_exception : public geometry::exception
                        std::string const& wkt)
         : message(msg)
         , wkt(wkt)
+        , position(static_cast<std::size_t>(-1))
     {
         if (it != end)
         {
@@ -82,21 +83,43 @@ struct read_wkt_exception : public geometry::exception
     read_wkt_exception(std::string const& msg, std::string const& wkt)
         : message(msg)
         , wkt(wkt)
+        , position(static_cast<std::size_t>(-1))
     {
         complete = message + "' in (" + wkt.substr(0, 100) + ")";
     }
 
+    read_wkt_exception(std::string const& msg,
+                       std::size_t offset,
+                       std::string const& wkt)
+        : message(msg)
+        , wkt(wkt)
+        , position(offset)
+    {
+        source = " at offset " + boost::lexical_cast<std::string>(offset);
+        complete = message + source + " in '" + wkt.substr(0, 100) + "'";
+    }
+
     virtual ~read_wkt_exception() throw() {}
 
     virtual const char* what() const throw()
     {
         return complete.c_str();
     }
+
+    /*!
+    \brief Returns the byte offset in the input where the error was found,
+        if the input was parsed from a character buffer, otherwise -1
+    */
+    inline std::size_t offset() const
+    {
+        return position;
+    }
 private :
     std::string source;
     std::string message;
     std::string wkt;
     std::string complete;
+    std::size_t position;
 };
 
 
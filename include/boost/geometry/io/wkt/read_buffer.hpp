@@ -0,0 +1,1109 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKT_READ_BUFFER_HPP
+#define BOOST_GEOMETRY_IO_WKT_READ_BUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/range.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+
+#include <boost/geometry/algorithms/assign.hpp>
+#include <boost/geometry/algorithms/clear.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/mutable_range.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/util/coordinate_cast.hpp>
+#include <boost/geometry/util/select_most_precise.hpp>
+
+#include <boost/geometry/io/wkt/detail/prefix.hpp>
+#include <boost/geometry/io/wkt/read.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkt
+{
+
+inline bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r'
+        || c == '\v' || c == '\f';
+}
+
+inline bool is_separator(char c)
+{
+    return c == ',' || c == '(' || c == ')' || is_space(c);
+}
+
+inline bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool is_letter(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+inline char to_upper(char c)
+{
+    return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+// Powers of ten which are exactly representable as a double
+inline double exact_power_of_ten(int n)
+{
+    static const double powers[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    return powers[n];
+}
+
+
+// Largest mantissa and power of ten which are exactly representable in T,
+// their product or quotient is then rounded only once
+template <typename T>
+struct exact_number_limits
+{
+    typedef typename select_most_precise<T, double>::type calculation_type;
+    static const boost::uint64_t max_mantissa = boost::uint64_t(1) << 53;
+    static const int max_exponent = 22;
+};
+
+template <>
+struct exact_number_limits<float>
+{
+    typedef float calculation_type;
+    static const boost::uint64_t max_mantissa = boost::uint64_t(1) << 24;
+    static const int max_exponent = 10;
+};
+
+
+// Converts a number of which the digits and the exponent cannot be combined
+// exactly. The stream uses the classic locale and converts as strtof, strtod
+// or strtold (so correctly rounded), but is slow.
+template <typename T>
+struct precise_number_parser
+{
+    static inline void apply(char const* first, char const* last, T& value)
+    {
+        std::istringstream in(std::string(first, last));
+        in.imbue(std::locale::classic());
+        in >> value;
+        if (in.fail())
+        {
+            // Out of range
+            std::string const text(first, last);
+            bool const negative = text[0] == '-';
+            bool const overflow = text.find_first_of("eE") == std::string::npos
+                || text[text.find_first_of("eE") + 1] != '-';
+            value = overflow ? std::numeric_limits<T>::infinity() : T(0);
+            value = negative ? -value : value;
+        }
+    }
+};
+
+// For double, strtod is used (correctly rounded, also out of range). The
+// decimal point of the locale is avoided by removing the point and
+// subtracting the number of decimals from the exponent, 1.5e3 -> 15e2
+template <>
+struct precise_number_parser<double>
+{
+    static inline void apply(char const* first, char const* last, double& value)
+    {
+        std::size_t const size = static_cast<std::size_t>(last - first);
+
+        // Digits, 'e', exponent sign, up to 12 exponent digits, terminator
+        std::size_t const capacity = size + 16;
+        char buffer[80];
+        std::string text;
+        char* copy = buffer;
+        if (capacity > sizeof(buffer))
+        {
+            text.resize(capacity);
+            copy = &text[0];
+        }
+
+        std::size_t n = 0;
+        long decimals = 0;
+        bool fraction = false;
+        char const* it = first;
+        for (; it != last && *it != 'e' && *it != 'E'; ++it)
+        {
+            if (*it == '.')
+            {
+                fraction = true;
+                continue;
+            }
+            if (fraction && decimals < 1000000000L)
+            {
+                decimals++;
+            }
+            copy[n++] = *it;
+        }
+
+        long exponent = 0;
+        if (it != last)
+        {
+            ++it;
+            bool const negative = it != last && *it == '-';
+            if (it != last && (*it == '-' || *it == '+'))
+            {
+                ++it;
+            }
+            for (; it != last; ++it)
+            {
+                if (exponent < 1000000000L)
+                {
+                    exponent = exponent * 10 + (*it - '0');
+                }
+            }
+            exponent = negative ? -exponent : exponent;
+        }
+        exponent -= decimals;
+
+        copy[n++] = 'e';
+        if (exponent < 0)
+        {
+            copy[n++] = '-';
+            exponent = -exponent;
+        }
+        char digits[12];
+        int count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + exponent % 10);
+            exponent /= 10;
+        } while (exponent > 0);
+        while (count > 0)
+        {
+            copy[n++] = digits[--count];
+        }
+        copy[n] = 0;
+
+        value = std::strtod(copy, 0);
+    }
+};
+
+
+/*!
+\brief Internal, scans WKT in a character buffer, in place
+\details Whitespace is skipped, keywords are compared case-insensitively and
+    numbers are parsed independent of the locale. Errors are reported with
+    the byte offset in the buffer, plus the base offset if the buffer is a
+    record of a larger input.
+*/
+class buffer_scanner
+{
+public :
+    buffer_scanner(char const* first, char const* last,
+                   std::size_t base_offset = 0)
+        : m_first(first)
+        , m_it(first)
+        , m_last(last)
+        , m_base_offset(base_offset)
+    {}
+
+    // Returns the next non-whitespace character, or 0 at the end
+    inline char peek()
+    {
+        skip_whitespace();
+        return m_it != m_last ? *m_it : 0;
+    }
+
+    inline bool at_end()
+    {
+        skip_whitespace();
+        return m_it == m_last;
+    }
+
+    // Skips the character if it is the next non-whitespace character
+    inline bool consume(char c)
+    {
+        if (peek() == c && m_it != m_last)
+        {
+            ++m_it;
+            return true;
+        }
+        return false;
+    }
+
+    inline void expect(char c, char const* message)
+    {
+        if (! consume(c))
+        {
+            fail(message);
+        }
+    }
+
+    // Returns true if the next coordinate is missing
+    inline bool at_coordinate_end()
+    {
+        char const c = peek();
+        return m_it == m_last || c == ',' || c == ')';
+    }
+
+    // Compares the next word with the (upper case) keyword, case-insensitively,
+    // and skips it if it matches
+    inline bool keyword(char const* word)
+    {
+        skip_whitespace();
+        char const* it = m_it;
+        for (; *word != 0; ++word, ++it)
+        {
+            if (it == m_last || to_upper(*it) != *word)
+            {
+                return false;
+            }
+        }
+        if (it != m_last && is_letter(*it))
+        {
+            return false;
+        }
+        m_it = it;
+        return true;
+    }
+
+    template <typename T>
+    inline void parse_floating_point(T& value)
+    {
+        skip_whitespace();
+        char const* const start = m_it;
+
+        bool negative = false;
+        if (m_it != m_last && (*m_it == '-' || *m_it == '+'))
+        {
+            negative = *m_it == '-';
+            ++m_it;
+        }
+
+        if (m_it == m_last || ! (is_digit(*m_it) || *m_it == '.'))
+        {
+            // For example inf or nan
+            m_it = start;
+            parse_other(value);
+            return;
+        }
+
+        // Collect up to 19 significant digits
+        boost::uint64_t mantissa = 0;
+        int significant = 0;
+        int exponent = 0;
+        bool truncated = false;
+        bool has_digits = false;
+
+        for (; m_it != m_last && is_digit(*m_it); ++m_it)
+        {
+            has_digits = true;
+            add_digit(*m_it, mantissa, significant, truncated, exponent, false);
+        }
+        if (m_it != m_last && *m_it == '.')
+        {
+            ++m_it;
+            for (; m_it != m_last && is_digit(*m_it); ++m_it)
+            {
+                has_digits = true;
+                add_digit(*m_it, mantissa, significant, truncated, exponent, true);
+            }
+        }
+        if (! has_digits)
+        {
+            m_it = start;
+            fail("Expected number");
+        }
+
+        if (m_it != m_last && (*m_it == 'e' || *m_it == 'E'))
+        {
+            ++m_it;
+            bool negative_exponent = false;
+            if (m_it != m_last && (*m_it == '-' || *m_it == '+'))
+            {
+                negative_exponent = *m_it == '-';
+                ++m_it;
+            }
+            if (m_it == m_last || ! is_digit(*m_it))
+            {
+                m_it = start;
+                fail("Expected number");
+            }
+            int e = 0;
+            for (; m_it != m_last && is_digit(*m_it); ++m_it)
+            {
+                if (e < 100000)
+                {
+                    e = e * 10 + (*m_it - '0');
+                }
+            }
+            exponent += negative_exponent ? -e : e;
+        }
+
+        check_number_end(start);
+
+        // The result is exact if the mantissa and the power of ten are exact,
+        // so rounded only once. Otherwise use the slower precise conversion.
+        typedef exact_number_limits<T> limits;
+        typedef typename limits::calculation_type calculation_type;
+        if (! truncated
+            && mantissa <= limits::max_mantissa
+            && exponent >= -limits::max_exponent
+            && exponent <= limits::max_exponent)
+        {
+            calculation_type result = static_cast<calculation_type>(mantissa);
+            if (exponent < 0)
+            {
+                result /= calculation_type(exact_power_of_ten(-exponent));
+            }
+            else if (exponent > 0)
+            {
+                result *= calculation_type(exact_power_of_ten(exponent));
+            }
+            value = static_cast<T>(negative ? -result : result);
+            return;
+        }
+
+        precise_number_parser<T>::apply(start, m_it, value);
+    }
+
+    template <typename T>
+    inline void parse_integer(T& value)
+    {
+        skip_whitespace();
+        char const* const start = m_it;
+
+        bool negative = false;
+        if (m_it != m_last && (*m_it == '-' || *m_it == '+'))
+        {
+            negative = *m_it == '-';
+            ++m_it;
+        }
+
+        if (m_it == m_last || ! is_digit(*m_it))
+        {
+            m_it = start;
+            fail("Expected number");
+        }
+
+        boost::uint64_t const max_value = negative
+            ? static_cast<boost::uint64_t>(-(std::numeric_limits<T>::min() + 1)) + 1
+            : static_cast<boost::uint64_t>(std::numeric_limits<T>::max());
+
+        boost::uint64_t result = 0;
+        for (; m_it != m_last && is_digit(*m_it); ++m_it)
+        {
+            boost::uint64_t const digit = *m_it - '0';
+            if (result > (max_value - digit) / 10)
+            {
+                m_it = start;
+                fail("Number out of range");
+            }
+            result = result * 10 + digit;
+        }
+
+        if (negative && ! boost::is_signed<T>::value && result != 0)
+        {
+            m_it = start;
+            fail("Number out of range");
+        }
+
+        check_number_end(start);
+
+        value = negative
+            ? static_cast<T>(-static_cast<T>(result - 1) - 1)
+            : static_cast<T>(result);
+    }
+
+    // Parses other coordinate types using coordinate_cast
+    template <typename T>
+    inline void parse_other(T& value)
+    {
+        skip_whitespace();
+        char const* const start = m_it;
+        while (m_it != m_last && ! is_separator(*m_it))
+        {
+            ++m_it;
+        }
+        if (m_it == start)
+        {
+            fail("Expected number");
+        }
+
+        try
+        {
+            value = coordinate_cast<T>::apply(std::string(start, m_it));
+        }
+        catch(std::exception const& e)
+        {
+            m_it = start;
+            fail(e.what());
+        }
+    }
+
+    inline std::size_t offset() const
+    {
+        return m_base_offset + static_cast<std::size_t>(m_it - m_first);
+    }
+
+    inline void fail(std::string const& message) const
+    {
+        std::size_t const size = static_cast<std::size_t>(m_last - m_first);
+        // Thrown by boost::throw_exception, so parallel readers can transport
+        // it to the calling thread without C++11 exception_ptr
+        boost::throw_exception(read_wkt_exception(message, offset(),
+                std::string(m_first, m_first + (std::min)(size, std::size_t(100)))));
+    }
+
+private :
+    inline void skip_whitespace()
+    {
+        while (m_it != m_last && is_space(*m_it))
+        {
+            ++m_it;
+        }
+    }
+
+    static inline void add_digit(char c, boost::uint64_t& mantissa,
+                int& significant, bool& truncated, int& exponent,
+                bool is_fraction)
+    {
+        if (significant == 0 && c == '0')
+        {
+            // Leading zero
+            if (is_fraction)
+            {
+                exponent--;
+            }
+        }
+        else if (significant < 19)
+        {
+            mantissa = mantissa * 10 + (c - '0');
+            significant++;
+            if (is_fraction)
+            {
+                exponent--;
+            }
+        }
+        else
+        {
+            if (c != '0')
+            {
+                truncated = true;
+            }
+            if (! is_fraction)
+            {
+                exponent++;
+            }
+        }
+    }
+
+    inline void check_number_end(char const* start)
+    {
+        if (m_it != m_last && ! is_separator(*m_it))
+        {
+            m_it = start;
+            fail("Invalid number");
+        }
+    }
+
+    char const* m_first;
+    char const* m_it;
+    char const* m_last;
+    std::size_t m_base_offset;
+};
+
+
+template
+<
+    typename CoordinateType,
+    bool IsFloatingPoint = boost::is_floating_point<CoordinateType>::value,
+    bool IsIntegral = boost::is_integral<CoordinateType>::value
+>
+struct buffer_number_parser
+{
+    static inline void apply(buffer_scanner& scanner, CoordinateType& value)
+    {
+        scanner.parse_other(value);
+    }
+};
+
+template <typename CoordinateType>
+struct buffer_number_parser<CoordinateType, true, false>
+{
+    static inline void apply(buffer_scanner& scanner, CoordinateType& value)
+    {
+        scanner.parse_floating_point(value);
+    }
+};
+
+template <typename CoordinateType>
+struct buffer_number_parser<CoordinateType, false, true>
+{
+    static inline void apply(buffer_scanner& scanner, CoordinateType& value)
+    {
+        scanner.parse_integer(value);
+    }
+};
+
+
+template <typename Point,
+          std::size_t Dimension = 0,
+          std::size_t DimensionCount = geometry::dimension<Point>::value>
+struct buffer_parsing_assigner
+{
+    static inline void apply(buffer_scanner& scanner, Point& point)
+    {
+        typedef typename coordinate_type<Point>::type coordinate_type;
+
+        // Initialize missing coordinates to default constructor (zero)
+        coordinate_type value = coordinate_type();
+        if (! scanner.at_coordinate_end())
+        {
+            buffer_number_parser<coordinate_type>::apply(scanner, value);
+        }
+        set<Dimension>(point, value);
+
+        buffer_parsing_assigner
+            <
+                Point, Dimension + 1, DimensionCount
+            >::apply(scanner, point);
+    }
+};
+
+template <typename Point, std::size_t DimensionCount>
+struct buffer_parsing_assigner<Point, DimensionCount, DimensionCount>
+{
+    static inline void apply(buffer_scanner& , Point& )
+    {}
+};
+
+
+// Parses coordinate sequences like "(1 2,3 4,...)" into an output iterator
+template <typename Point>
+struct buffer_container_inserter
+{
+    template <typename OutputIterator>
+    static inline void apply(buffer_scanner& scanner, OutputIterator out)
+    {
+        scanner.expect('(', "Expected '('");
+
+        Point point;
+        while (scanner.peek() != ')' && ! scanner.at_end())
+        {
+            buffer_parsing_assigner<Point>::apply(scanner, point);
+            out = point;
+            ++out;
+            if (! scanner.consume(','))
+            {
+                break;
+            }
+        }
+
+        scanner.expect(')', "Expected ')'");
+    }
+};
+
+// Parses coordinate sequences like "(1 2,3 4,...)" into a range,
+// Geometry is a value-type or reference-type
+template <typename Geometry>
+struct buffer_container_appender
+{
+    typedef typename geometry::point_type<Geometry>::type point_type;
+
+    static inline void apply(buffer_scanner& scanner, Geometry out)
+    {
+        scanner.expect('(', "Expected '('");
+
+        stateful_range_appender<Geometry> appender;
+
+        point_type point;
+        while (scanner.peek() != ')' && ! scanner.at_end())
+        {
+            buffer_parsing_assigner<point_type>::apply(scanner, point);
+
+            bool const is_next_expected = scanner.consume(',');
+
+            appender.append(out, point, is_next_expected);
+
+            if (! is_next_expected)
+            {
+                break;
+            }
+        }
+
+        scanner.expect(')', "Expected ')'");
+    }
+};
+
+template <typename Point>
+struct buffer_point_parser
+{
+    static inline void apply(buffer_scanner& scanner, Point& point)
+    {
+        scanner.expect('(', "Expected '('");
+        buffer_parsing_assigner<Point>::apply(scanner, point);
+        scanner.expect(')', "Expected ')'");
+    }
+};
+
+template <typename Point>
+struct buffer_noparenthesis_point_parser
+{
+    static inline void apply(buffer_scanner& scanner, Point& point)
+    {
+        buffer_parsing_assigner<Point>::apply(scanner, point);
+    }
+};
+
+template <typename Linestring>
+struct buffer_linestring_parser
+{
+    static inline void apply(buffer_scanner& scanner, Linestring& linestring)
+    {
+        buffer_container_appender<Linestring&>::apply(scanner, linestring);
+    }
+};
+
+template <typename Ring>
+struct buffer_ring_parser
+{
+    static inline void apply(buffer_scanner& scanner, Ring& ring)
+    {
+        // A ring should look like polygon((x y,x y,x y...))
+        scanner.expect('(', "Expected '('");
+        buffer_container_appender<Ring&>::apply(scanner, ring);
+        scanner.expect(')', "Expected ')'");
+    }
+};
+
+// Parses a polygon like "((x y,x y),(x y,x y))", the interior rings are
+// parsed in place
+template <typename Polygon>
+struct buffer_polygon_parser
+{
+    typedef typename ring_return_type<Polygon>::type ring_return_type;
+    typedef buffer_container_appender<ring_return_type> appender;
+
+    typedef typename boost::remove_reference
+        <
+            typename traits::interior_mutable_type<Polygon>::type
+        >::type interior_type;
+
+    static inline void apply(buffer_scanner& scanner, Polygon& polygon)
+    {
+        scanner.expect('(', "Expected '('");
+
+        bool first = true;
+        while (scanner.peek() != ')' && ! scanner.at_end())
+        {
+            if (first)
+            {
+                appender::apply(scanner, exterior_ring(polygon));
+                first = false;
+            }
+            else
+            {
+                typename traits::interior_mutable_type<Polygon>::type
+                    interiors = interior_rings(polygon);
+                traits::resize<interior_type>::apply(interiors,
+                                                     boost::size(interiors) + 1);
+                appender::apply(scanner, *(boost::end(interiors) - 1));
+            }
+
+            if (! scanner.consume(','))
+            {
+                break;
+            }
+        }
+
+        scanner.expect(')', "Expected ')'");
+    }
+};
+
+
+inline void buffer_check_end(buffer_scanner& scanner)
+{
+    if (! scanner.at_end())
+    {
+        scanner.fail("Too much tokens");
+    }
+}
+
+// Parses the geometry name and the optional Z, M and EMPTY,
+// returns false if the geometry is empty
+template <typename Geometry>
+inline bool buffer_initialize(buffer_scanner& scanner,
+                              char const* geometry_name)
+{
+    if (! scanner.keyword(geometry_name))
+    {
+        scanner.fail(std::string("Should start with '") + geometry_name + "'");
+    }
+
+    // M is ignored at all
+    bool has_empty = false;
+    bool has_z = false;
+    for (;;)
+    {
+        if (scanner.keyword("ZM") || scanner.keyword("MZ")
+            || scanner.keyword("Z"))
+        {
+            has_z = true;
+        }
+        else if (scanner.keyword("EMPTY"))
+        {
+            has_empty = true;
+        }
+        else if (! scanner.keyword("M"))
+        {
+            break;
+        }
+    }
+
+    if (has_z && dimension<Geometry>::type::value < 3)
+    {
+        scanner.fail("Z only allowed for 3 or more dimensions");
+    }
+
+    if (has_empty)
+    {
+        buffer_check_end(scanner);
+        return false;
+    }
+    return true;
+}
+
+
+template <typename Geometry, template<typename> class Parser, typename PrefixPolicy>
+struct buffer_geometry_parser
+{
+    static inline void apply(buffer_scanner& scanner, Geometry& geometry)
+    {
+        geometry::clear(geometry);
+
+        if (buffer_initialize<Geometry>(scanner, PrefixPolicy::apply()))
+        {
+            Parser<Geometry>::apply(scanner, geometry);
+            buffer_check_end(scanner);
+        }
+    }
+};
+
+template <typename MultiGeometry, template<typename> class Parser, typename PrefixPolicy>
+struct buffer_multi_parser
+{
+    static inline void apply(buffer_scanner& scanner, MultiGeometry& geometry)
+    {
+        traits::clear<MultiGeometry>::apply(geometry);
+
+        if (buffer_initialize<MultiGeometry>(scanner, PrefixPolicy::apply()))
+        {
+            scanner.expect('(', "Expected '('");
+
+            while (scanner.peek() != ')' && ! scanner.at_end())
+            {
+                traits::resize<MultiGeometry>::apply(geometry, boost::size(geometry) + 1);
+                Parser
+                    <
+                        typename boost::range_value<MultiGeometry>::type
+                    >::apply(scanner, *(boost::end(geometry) - 1));
+
+                if (! scanner.consume(','))
+                {
+                    break;
+                }
+            }
+
+            scanner.expect(')', "Expected ')'");
+            buffer_check_end(scanner);
+        }
+    }
+};
+
+template <typename MultiGeometry, typename PrefixPolicy>
+struct buffer_multi_point_parser
+{
+    typedef typename boost::range_value<MultiGeometry>::type point_type;
+
+    static inline void apply(buffer_scanner& scanner, MultiGeometry& geometry)
+    {
+        traits::clear<MultiGeometry>::apply(geometry);
+
+        if (buffer_initialize<MultiGeometry>(scanner, PrefixPolicy::apply()))
+        {
+            scanner.expect('(', "Expected '('");
+
+            // If first point definition starts with "(" then parse points as (x y)
+            // otherwise as "x y"
+            bool const using_brackets = scanner.peek() == '(';
+
+            while (scanner.peek() != ')' && ! scanner.at_end())
+            {
+                traits::resize<MultiGeometry>::apply(geometry, boost::size(geometry) + 1);
+
+                if (using_brackets)
+                {
+                    buffer_point_parser<point_type>::apply(scanner,
+                        *(boost::end(geometry) - 1));
+                }
+                else
+                {
+                    buffer_noparenthesis_point_parser<point_type>::apply(scanner,
+                        *(boost::end(geometry) - 1));
+                }
+
+                if (! scanner.consume(','))
+                {
+                    break;
+                }
+            }
+
+            scanner.expect(')', "Expected ')'");
+            buffer_check_end(scanner);
+        }
+    }
+};
+
+// Box (Non-OGC), read from a POLYGON, or from a BOX with two points
+template <typename Box>
+struct buffer_box_parser
+{
+    static inline void apply(buffer_scanner& scanner, Box& box)
+    {
+        typedef typename point_type<Box>::type point_type;
+
+        bool should_close = false;
+        if (scanner.keyword("POLYGON"))
+        {
+            if (scanner.keyword("EMPTY"))
+            {
+                buffer_check_end(scanner);
+                assign_zero(box);
+                return;
+            }
+            scanner.expect('(', "Expected '('");
+            should_close = true;
+        }
+        else if (! scanner.keyword("BOX"))
+        {
+            scanner.fail("Should start with 'POLYGON' or 'BOX'");
+        }
+
+        std::vector<point_type> points;
+        buffer_container_inserter<point_type>::apply(scanner,
+                                                     std::back_inserter(points));
+
+        if (should_close)
+        {
+            scanner.expect(')', "Expected ')'");
+        }
+        buffer_check_end(scanner);
+
+        std::size_t index = 0;
+        std::size_t const n = points.size();
+        if (n == 2)
+        {
+            index = 1;
+        }
+        else if (n == 4 || n == 5)
+        {
+            // Take the opposite corner which is always 2
+            index = 2;
+        }
+        else
+        {
+            scanner.fail("Box should have 2,4 or 5 points");
+        }
+
+        geometry::detail::assign_point_to_index<min_corner>(points.front(), box);
+        geometry::detail::assign_point_to_index<max_corner>(points[index], box);
+    }
+};
+
+// Segment (Non-OGC), read from a SEGMENT or LINESTRING with two points
+template <typename Segment>
+struct buffer_segment_parser
+{
+    static inline void apply(buffer_scanner& scanner, Segment& segment)
+    {
+        typedef typename point_type<Segment>::type point_type;
+
+        if (! scanner.keyword("SEGMENT") && ! scanner.keyword("LINESTRING"))
+        {
+            scanner.fail("Should start with 'LINESTRING' or 'SEGMENT'");
+        }
+
+        std::vector<point_type> points;
+        buffer_container_inserter<point_type>::apply(scanner,
+                                                     std::back_inserter(points));
+        buffer_check_end(scanner);
+
+        if (points.size() != 2)
+        {
+            scanner.fail("Segment should have 2 points");
+        }
+
+        geometry::detail::assign_point_to_index<0>(points.front(), segment);
+        geometry::detail::assign_point_to_index<1>(points.back(), segment);
+    }
+};
+
+
+}} // namespace detail::wkt
+#endif // DOXYGEN_NO_DETAIL
+
+
+#ifndef DOXYGEN_NO_DISPATCH
+namespace dispatch
+{
+
+template <typename Tag, typename Geometry>
+struct read_wkt_buffer {};
+
+template <typename Point>
+struct read_wkt_buffer<point_tag, Point>
+    : detail::wkt::buffer_geometry_parser
+        <
+            Point,
+            detail::wkt::buffer_point_parser,
+            detail::wkt::prefix_point
+        >
+{};
+
+template <typename Linestring>
+struct read_wkt_buffer<linestring_tag, Linestring>
+    : detail::wkt::buffer_geometry_parser
+        <
+            Linestring,
+            detail::wkt::buffer_linestring_parser,
+            detail::wkt::prefix_linestring
+        >
+{};
+
+template <typename Ring>
+struct read_wkt_buffer<ring_tag, Ring>
+    : detail::wkt::buffer_geometry_parser
+        <
+            Ring,
+            detail::wkt::buffer_ring_parser,
+            detail::wkt::prefix_polygon
+        >
+{};
+
+template <typename Polygon>
+struct read_wkt_buffer<polygon_tag, Polygon>
+    : detail::wkt::buffer_geometry_parser
+        <
+            Polygon,
+            detail::wkt::buffer_polygon_parser,
+            detail::wkt::prefix_polygon
+        >
+{};
+
+template <typename MultiGeometry>
+struct read_wkt_buffer<multi_point_tag, MultiGeometry>
+    : detail::wkt::buffer_multi_point_parser
+        <
+            MultiGeometry,
+            detail::wkt::prefix_multipoint
+        >
+{};
+
+template <typename MultiGeometry>
+struct read_wkt_buffer<multi_linestring_tag, MultiGeometry>
+    : detail::wkt::buffer_multi_parser
+        <
+            MultiGeometry,
+            detail::wkt::buffer_linestring_parser,
+            detail::wkt::prefix_multilinestring
+        >
+{};
+
+template <typename MultiGeometry>
+struct read_wkt_buffer<multi_polygon_tag, MultiGeometry>
+    : detail::wkt::buffer_multi_parser
+        <
+            MultiGeometry,
+            detail::wkt::buffer_polygon_parser,
+            detail::wkt::prefix_multipolygon
+        >
+{};
+
+template <typename Box>
+struct read_wkt_buffer<box_tag, Box>
+    : detail::wkt::buffer_box_parser<Box>
+{};
+
+template <typename Segment>
+struct read_wkt_buffer<segment_tag, Segment>
+    : detail::wkt::buffer_segment_parser<Segment>
+{};
+
+} // namespace dispatch
+#endif // DOXYGEN_NO_DISPATCH
+
+
+/*!
+\brief Parses OGC Well-Known Text (\ref WKT) from a character buffer into a
+    geometry (any geometry)
+\ingroup wkt
+\details The characters are scanned in place, numbers are parsed independent
+    of the locale and the coordinates are appended directly to the geometry.
+    A string_view can be passed as its data() and data() + size(). Errors are
+    reported by a read_wkt_exception containing the byte offset in the buffer.
+\tparam Geometry \tparam_geometry
+\param first pointer to the first character of the \ref WKT
+\param last pointer past the last character of the \ref WKT
+\param geometry \param_geometry output geometry
+
+\qbk{distinguish,character buffer}
+*/
+template <typename Geometry>
+inline void read_wkt(char const* first, char const* last, Geometry& geometry)
+{
+    geometry::concept::check<Geometry>();
+
+    detail::wkt::buffer_scanner scanner(first, last);
+    dispatch::read_wkt_buffer
+        <
+            typename tag<Geometry>::type,
+            Geometry
+        >::apply(scanner, geometry);
+}
+
+
+}} // namespace boost::geometry
+
+#endif // BOOST_GEOMETRY_IO_WKT_READ_BUFFER_HPP
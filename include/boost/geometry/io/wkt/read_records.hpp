@@ -0,0 +1,422 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKT_READ_RECORDS_HPP
+#define BOOST_GEOMETRY_IO_WKT_READ_RECORDS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include <boost/exception_ptr.hpp>
+
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/geometries/concepts/check.hpp>
+#include <boost/geometry/io/wkt/read_buffer.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkt
+{
+
+// Returns the end of the line starting at first, the position of '\n'
+// or last
+inline char const* line_end(char const* first, char const* last)
+{
+    void const* it = std::memchr(first, '\n',
+                                 static_cast<std::size_t>(last - first));
+    return it != 0 ? static_cast<char const*>(it) : last;
+}
+
+inline bool is_blank(char const* first, char const* last)
+{
+    for (; first != last; ++first)
+    {
+        if (! is_space(*first))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parses one record, reported offsets are relative to the whole input
+template <typename Geometry>
+inline void read_wkt_record(char const* first, char const* last,
+                            std::size_t base_offset, Geometry& geometry)
+{
+    buffer_scanner scanner(first, last, base_offset);
+    dispatch::read_wkt_buffer
+        <
+            typename tag<Geometry>::type,
+            Geometry
+        >::apply(scanner, geometry);
+}
+
+// Divides the buffer into (at most) count chunks of about the same size,
+// each chunk ends after a newline (or at the end of the buffer)
+template <typename Char>
+inline void line_chunks(Char const* first, Char const* last, std::size_t count,
+                        std::vector<Char const*>& boundaries)
+{
+    std::size_t const size = static_cast<std::size_t>(last - first);
+
+    boundaries.clear();
+    boundaries.push_back(first);
+    for (std::size_t i = 1; i < count; i++)
+    {
+        Char const* it = first + size / count * i;
+        if (it < boundaries.back())
+        {
+            continue;
+        }
+        while (it != last && *it != '\n')
+        {
+            ++it;
+        }
+        if (it == last)
+        {
+            break;
+        }
+        boundaries.push_back(it + 1);
+    }
+    if (boundaries.back() != last)
+    {
+        boundaries.push_back(last);
+    }
+}
+
+// Reads all records of the chunk [boundaries[i], boundaries[i + 1]), into
+// one geometry reused for the whole chunk. Readers which don't throw stop
+// at an invalid record, which is registered in the chunk's flag. The
+// exception of a reader which throws is stored per chunk.
+template <typename Geometry, typename Reader, typename Char, typename Visitor>
+struct for_each_record_chunk
+{
+    for_each_record_chunk(std::vector<Char const*> const& boundaries,
+                          Char const* first, Visitor& visitor,
+                          std::vector<char>& completed,
+                          std::vector<boost::exception_ptr>& exceptions)
+        : m_boundaries(boundaries)
+        , m_first(first)
+        , m_visitor(visitor)
+        , m_completed(completed)
+        , m_exceptions(exceptions)
+    {}
+
+    inline void operator()(std::size_t i) const
+    {
+        try
+        {
+            Reader reader(m_boundaries[i], m_boundaries[i + 1],
+                          static_cast<std::size_t>(m_boundaries[i] - m_first));
+            Geometry geometry;
+            while (reader.next(geometry))
+            {
+                m_visitor(static_cast<Geometry const&>(geometry),
+                          reader.record_offset());
+            }
+            m_completed[i] = reader.at_end() ? 1 : 0;
+        }
+        catch (...)
+        {
+            m_exceptions[i] = boost::current_exception();
+        }
+    }
+
+    std::vector<Char const*> const& m_boundaries;
+    Char const* m_first;
+    Visitor& m_visitor;
+    std::vector<char>& m_completed;
+    std::vector<boost::exception_ptr>& m_exceptions;
+};
+
+// Calls the visitor for each record of the chunks, in parallel. Returns
+// false if one of the chunks was not read completely. If chunks throw, the
+// exception of the first one is rethrown, so the error with the smallest
+// offset is reported, as by the sequential readers.
+template <typename Geometry, typename Reader, typename Char, typename Visitor>
+inline bool for_each_record(std::vector<Char const*> const& boundaries,
+                            Visitor& visitor,
+                            geometry::parallel const& policy)
+{
+    if (boundaries.size() < 2)
+    {
+        return true;
+    }
+
+    std::size_t const count = boundaries.size() - 1;
+    std::vector<char> completed(count, 0);
+    std::vector<boost::exception_ptr> exceptions(count);
+    for_each_record_chunk<Geometry, Reader, Char, Visitor> const
+        chunk(boundaries, boundaries.front(), visitor, completed, exceptions);
+    detail::parallel::for_each_index(count, chunk,
+        detail::parallel::threads_count(policy));
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (exceptions[i])
+        {
+            boost::rethrow_exception(exceptions[i]);
+        }
+    }
+
+    return std::find(completed.begin(), completed.end(), 0) == completed.end();
+}
+
+
+}} // namespace detail::wkt
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Reads newline-delimited \ref WKT records from a character buffer,
+    one by one
+\ingroup wkt
+\details Each line of the buffer contains one geometry, lines containing only
+    whitespace are skipped. The buffer (for example a memory-mapped file) is
+    not copied and should stay valid while the reader is used. The records
+    are parsed as by read_wkt(first, last, geometry), into a geometry which
+    can be reused for all records. Errors are reported by a
+    read_wkt_exception containing the byte offset in the whole buffer.
+*/
+class wkt_record_reader
+{
+public :
+    /*!
+    \brief Constructs the reader
+    \param first pointer to the first character of the buffer
+    \param last pointer past the last character of the buffer
+    \param base_offset offset of the buffer if it is a part of a larger
+        input, added to all reported offsets
+    */
+    wkt_record_reader(char const* first, char const* last,
+                      std::size_t base_offset = 0)
+        : m_first(first)
+        , m_it(first)
+        , m_last(last)
+        , m_base_offset(base_offset)
+        , m_record_offset(0)
+        , m_count(0)
+    {}
+
+    /*!
+    \brief Reads the next record into the geometry, which is cleared first
+    \return false if there are no records left
+    */
+    template <typename Geometry>
+    inline bool next(Geometry& geometry)
+    {
+        geometry::concept::check<Geometry>();
+
+        while (m_it != m_last)
+        {
+            char const* const first = m_it;
+            char const* const last = detail::wkt::line_end(m_it, m_last);
+            m_it = last != m_last ? last + 1 : last;
+
+            if (! detail::wkt::is_blank(first, last))
+            {
+                m_record_offset = offset(first);
+                m_count++;
+                detail::wkt::read_wkt_record(first, last, m_record_offset,
+                                             geometry);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*!
+    \brief Returns the byte offset of the record read last
+    */
+    inline std::size_t record_offset() const
+    {
+        return m_record_offset;
+    }
+
+    /*!
+    \brief Returns the number of records read
+    */
+    inline std::size_t count() const
+    {
+        return m_count;
+    }
+
+    /*!
+    \brief Returns true if all records were read
+    */
+    inline bool at_end() const
+    {
+        return m_it == m_last;
+    }
+
+private :
+    inline std::size_t offset(char const* it) const
+    {
+        return m_base_offset + static_cast<std::size_t>(it - m_first);
+    }
+
+    char const* m_first;
+    char const* m_it;
+    char const* m_last;
+    std::size_t m_base_offset;
+    std::size_t m_record_offset;
+    std::size_t m_count;
+};
+
+
+/*!
+\brief Reads newline-delimited \ref WKT records from an input stream,
+    one by one
+\ingroup wkt
+\details Like wkt_record_reader, but the lines are read from the stream into
+    a reused string. Offsets are counted from the position of the stream
+    when the reader was constructed.
+*/
+class wkt_stream_reader
+{
+public :
+    /*!
+    \brief Constructs the reader
+    \param stream the input stream, which should stay valid while the reader
+        is used
+    */
+    explicit wkt_stream_reader(std::istream& stream)
+        : m_stream(stream)
+        , m_offset(0)
+        , m_record_offset(0)
+        , m_count(0)
+    {}
+
+    /*!
+    \brief Reads the next record into the geometry, which is cleared first
+    \return false if there are no records left
+    */
+    template <typename Geometry>
+    inline bool next(Geometry& geometry)
+    {
+        geometry::concept::check<Geometry>();
+
+        while (std::getline(m_stream, m_line))
+        {
+            std::size_t const offset = m_offset;
+            m_offset += m_line.size() + 1;
+
+            char const* const first = m_line.data();
+            char const* const last = first + m_line.size();
+            if (! detail::wkt::is_blank(first, last))
+            {
+                m_record_offset = offset;
+                m_count++;
+                detail::wkt::read_wkt_record(first, last, offset, geometry);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*!
+    \brief Returns the byte offset of the record read last
+    */
+    inline std::size_t record_offset() const
+    {
+        return m_record_offset;
+    }
+
+    /*!
+    \brief Returns the number of records read
+    */
+    inline std::size_t count() const
+    {
+        return m_count;
+    }
+
+private :
+    std::istream& m_stream;
+    std::string m_line;
+    std::size_t m_offset;
+    std::size_t m_record_offset;
+    std::size_t m_count;
+};
+
+
+/*!
+\brief Calls a visitor for each newline-delimited \ref WKT record of a
+    character buffer
+\ingroup wkt
+\details The visitor is called as visitor(geometry, offset), with the parsed
+    geometry and the byte offset of its record, in the order of the records.
+\tparam Geometry \tparam_geometry
+\param first pointer to the first character of the buffer
+\param last pointer past the last character of the buffer
+\param visitor function object called for each record
+
+\qbk{distinguish,sequential}
+*/
+template <typename Geometry, typename Visitor>
+inline void for_each_wkt_record(char const* first, char const* last,
+                                Visitor& visitor)
+{
+    wkt_record_reader reader(first, last);
+    Geometry geometry;
+    while (reader.next(geometry))
+    {
+        visitor(static_cast<Geometry const&>(geometry),
+                reader.record_offset());
+    }
+}
+
+/*!
+\brief Calls a visitor for each newline-delimited \ref WKT record of a
+    character buffer, parsing independent chunks in parallel
+\ingroup wkt
+\details The buffer is divided into chunks at line boundaries, the chunks
+    are parsed by parallel tasks, each one reusing its own geometry. The
+    visitor is called as visitor(geometry, offset) concurrently and in any
+    order, the offsets can be used to restore the order. If parsing fails
+    the read_wkt_exception of the invalid record with the smallest offset
+    is rethrown after all tasks finished, as by the sequential version.
+\tparam Geometry \tparam_geometry
+\param first pointer to the first character of the buffer
+\param last pointer past the last character of the buffer
+\param visitor function object called for each record, it should be safe
+    to call concurrently
+\param parallel_policy the parallel execution policy
+
+\qbk{distinguish,parallel}
+*/
+template <typename Geometry, typename Visitor>
+inline void for_each_wkt_record(char const* first, char const* last,
+                                Visitor& visitor,
+                                geometry::parallel const& parallel_policy)
+{
+    // Several chunks per thread, records may differ much in size
+    std::size_t const threads
+        = detail::parallel::threads_count(parallel_policy);
+
+    std::vector<char const*> boundaries;
+    detail::wkt::line_chunks(first, last, threads * 4, boundaries);
+
+    detail::wkt::for_each_record
+        <
+            Geometry, wkt_record_reader
+        >(boundaries, visitor, parallel_policy);
+}
+
+
+}} // namespace boost::geometry
+
+#endif // BOOST_GEOMETRY_IO_WKT_READ_RECORDS_HPP
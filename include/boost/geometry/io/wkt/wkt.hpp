@@ -15,6 +15,8 @@
 #define BOOST_GEOMETRY_IO_WKT_WKT_HPP
 
 #include <boost/geometry/io/wkt/read.hpp>
+#include <boost/geometry/io/wkt/read_buffer.hpp>
+#include <boost/geometry/io/wkt/read_records.hpp>
 #include <boost/geometry/io/wkt/write.hpp>
 
 // BSG 2011-02-03
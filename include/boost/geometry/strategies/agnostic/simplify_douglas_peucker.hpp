@@ -20,15 +20,18 @@
 
 
 #include <cstddef>
+#include <functional>
 #ifdef BOOST_GEOMETRY_DEBUG_DOUGLAS_PEUCKER
 #include <iostream>
 #endif
+#include <utility>
 #include <vector>
 
 #include <boost/range.hpp>
 
 #include <boost/geometry/core/cs.hpp>
 #include <boost/geometry/strategies/distance.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 
 #ifdef BOOST_GEOMETRY_DEBUG_DOUGLAS_PEUCKER
@@ -48,27 +51,18 @@ namespace detail
 {
 
     /*!
-        \brief Small wrapper around a point, with an extra member "included"
-        \details
-            It has a const-reference to the original point (so no copy here)
-        \tparam the enclosed point type
+        \brief Memory used by douglas_peucker, it can be reused for
+            several ranges to avoid allocations
     */
-    template<typename Point>
-    struct douglas_peucker_point
+    struct douglas_peucker_buffer
     {
-        Point const& p;
-        bool included;
+        // Index ranges (the first and the last point) still to be considered
+        typedef std::pair<std::size_t, std::size_t> index_range;
 
-        inline douglas_peucker_point(Point const& ap)
-            : p(ap)
-            , included(false)
-        {}
-
-        // Necessary for proper compilation
-        inline douglas_peucker_point<Point> operator=(douglas_peucker_point<Point> const& )
-        {
-            return douglas_peucker_point<Point>(*this);
-        }
+        // Flags of the points, char is used instead of bool because
+        // the flags of different sub-ranges are set concurrently
+        std::vector<char> included;
+        std::vector<index_range> stack;
     };
 
     template
@@ -110,86 +104,198 @@ namespace detail
         {}
 
     private :
-        typedef detail::douglas_peucker_point<Point> dp_point_type;
-        typedef typename std::vector<dp_point_type>::iterator iterator_type;
+        typedef douglas_peucker_buffer::index_range index_range;
 
+        // Sub-ranges are processed in parallel if the range has at least
+        // this number of points, ranges are not split for the threads
+        // if they are smaller than task_min_size
+        static const std::size_t parallel_min_size = 10000;
+        static const std::size_t task_min_size = 1000;
 
         LessCompare const& less() const
         {
             return *this;
         }
 
-        inline void consider(iterator_type begin,
-                             iterator_type end,
-                             distance_type const& max_dist,
-                             int& n,
-                             distance_strategy_type const& ps_distance_strategy) const
+        // Finds the point of [first, last] most far from the segment between
+        // first and last. If it is further than max_dist it is included and
+        // its index is returned, otherwise first is returned.
+        template <typename Iterator>
+        inline std::size_t split(Iterator points,
+                                 index_range const& range,
+                                 distance_type const& max_dist,
+                                 std::vector<char>& included,
+                                 distance_strategy_type const& ps_distance_strategy) const
         {
-            std::size_t size = end - begin;
+            std::size_t const first = range.first;
+            std::size_t const last = range.second;
 
             // size must be at least 3
             // because we want to consider a candidate point in between
-            if (size <= 2)
+            if (last - first < 2)
             {
 #ifdef BOOST_GEOMETRY_DEBUG_DOUGLAS_PEUCKER
-                if (begin != end)
-                {
-                    std::cout << "ignore between " << dsv(begin->p)
-                        << " and " << dsv((end - 1)->p)
-                        << " size=" << size << std::endl;
-                }
-                std::cout << "return because size=" << size << std::endl;
+                std::cout << "return because size=" << last - first + 1 << std::endl;
 #endif
-                return;
+                return first;
             }
 
-            iterator_type last = end - 1;
+            Point const& p1 = *(points + first);
+            Point const& p2 = *(points + last);
 
 #ifdef BOOST_GEOMETRY_DEBUG_DOUGLAS_PEUCKER
-            std::cout << "find between " << dsv(begin->p)
-                << " and " << dsv(last->p)
-                << " size=" << size << std::endl;
+            std::cout << "find between " << dsv(p1)
+                << " and " << dsv(p2)
+                << " size=" << last - first + 1 << std::endl;
 #endif
 
-
             // Find most far point, compare to the current segment
-            //geometry::segment<Point const> s(begin->p, last->p);
             distance_type md(-1.0); // any value < 0
-            iterator_type candidate;
-            for(iterator_type it = begin + 1; it != last; ++it)
+            std::size_t candidate = first;
+            Iterator it = points + first + 1;
+            for (std::size_t i = first + 1; i < last; ++i, ++it)
             {
-                distance_type dist = ps_distance_strategy.apply(it->p, begin->p, last->p);
+                distance_type dist = ps_distance_strategy.apply(*it, p1, p2);
 
 #ifdef BOOST_GEOMETRY_DEBUG_DOUGLAS_PEUCKER
-                std::cout << "consider " << dsv(it->p)
+                std::cout << "consider " << dsv(*it)
                     << " at " << double(dist)
                     << ((dist > max_dist) ? " maybe" : " no")
                     << std::endl;
-
 #endif
                 if ( less()(md, dist) )
                 {
                     md = dist;
-                    candidate = it;
+                    candidate = i;
                 }
             }
 
             // If a point is found, set the include flag
-            // and handle segments in between recursively
             if ( less()(max_dist, md) )
             {
 #ifdef BOOST_GEOMETRY_DEBUG_DOUGLAS_PEUCKER
-                std::cout << "use " << dsv(candidate->p) << std::endl;
+                std::cout << "use " << dsv(*(points + candidate)) << std::endl;
 #endif
+                included[candidate] = 1;
+                return candidate;
+            }
+            return first;
+        }
 
-                candidate->included = true;
-                n++;
+        // Considers the ranges on the stack, and the sub-ranges of the points
+        // found in them, until the stack is empty
+        template <typename Iterator>
+        inline void consider(Iterator points,
+                             distance_type const& max_dist,
+                             std::vector<char>& included,
+                             std::vector<index_range>& stack,
+                             distance_strategy_type const& ps_distance_strategy) const
+        {
+            while (! stack.empty())
+            {
+                index_range const range = stack.back();
+                stack.pop_back();
+
+                std::size_t const candidate = split(points, range, max_dist,
+                                    included, ps_distance_strategy);
+                if (candidate != range.first)
+                {
+                    // The first sub-range is considered first
+                    stack.push_back(index_range(candidate, range.second));
+                    stack.push_back(index_range(range.first, candidate));
+                }
+            }
+        }
+
+        template <typename Iterator>
+        struct consider_task
+        {
+            consider_task(douglas_peucker const& dp,
+                          Iterator points,
+                          distance_type const& max_dist,
+                          std::vector<char>& included,
+                          std::vector<index_range> const& ranges,
+                          distance_strategy_type const& ps_distance_strategy)
+                : m_dp(dp)
+                , m_points(points)
+                , m_max_dist(max_dist)
+                , m_included(included)
+                , m_ranges(ranges)
+                , m_strategy(ps_distance_strategy)
+            {}
+
+            inline void operator()(std::size_t i) const
+            {
+                std::vector<index_range> stack(1, m_ranges[i]);
+                m_dp.consider(m_points, m_max_dist, m_included, stack, m_strategy);
+            }
 
-                consider(begin, candidate + 1, max_dist, n, ps_distance_strategy);
-                consider(candidate, end, max_dist, n, ps_distance_strategy);
+            douglas_peucker const& m_dp;
+            Iterator m_points;
+            distance_type const& m_max_dist;
+            std::vector<char>& m_included;
+            std::vector<index_range> const& m_ranges;
+            distance_strategy_type const& m_strategy;
+        };
+
+        // Splits the ranges, breadth first, until there are enough ranges
+        // for the threads or they are all too small
+        template <typename Iterator>
+        inline void split_for_tasks(Iterator points,
+                                    distance_type const& max_dist,
+                                    std::vector<char>& included,
+                                    std::vector<index_range>& ranges,
+                                    std::size_t tasks,
+                                    distance_strategy_type const& ps_distance_strategy) const
+        {
+            bool splitted = true;
+            while (splitted && ranges.size() < tasks)
+            {
+                splitted = false;
+                std::size_t const count = ranges.size();
+                for (std::size_t i = 0; i < count && ranges.size() < tasks; ++i)
+                {
+                    index_range const range = ranges[i];
+                    if (range.second - range.first < task_min_size)
+                    {
+                        continue;
+                    }
+
+                    std::size_t const candidate = split(points, range, max_dist,
+                                        included, ps_distance_strategy);
+                    if (candidate != range.first)
+                    {
+                        ranges[i] = index_range(range.first, candidate);
+                        ranges.push_back(index_range(candidate, range.second));
+                        splitted = true;
+                    }
+                    else
+                    {
+                        // Nothing to include, the range is finished
+                        ranges[i] = index_range(range.first, range.first);
+                    }
+                }
             }
         }
 
+        template <typename Iterator, typename OutputIterator>
+        static inline OutputIterator copy_included(Iterator points,
+                                                   std::vector<char> const& included,
+                                                   OutputIterator out)
+        {
+            for (std::size_t i = 0; i < included.size(); ++i, ++points)
+            {
+                if (included[i])
+                {
+                    // copy-coordinates does not work because OutputIterator
+                    // does not model Point (??)
+                    //geometry::convert(*points, *out);
+                    *out = *points;
+                    out++;
+                }
+            }
+            return out;
+        }
 
     public :
 
@@ -198,42 +304,100 @@ namespace detail
                                     OutputIterator out,
                                     distance_type max_distance) const
         {
+            douglas_peucker_buffer buffer;
+            return apply(range, out, max_distance, buffer);
+        }
+
+        // Uses the passed buffer, which may be reused for other ranges
+        template <typename Range, typename OutputIterator>
+        inline OutputIterator apply(Range const& range,
+                                    OutputIterator out,
+                                    distance_type max_distance,
+                                    douglas_peucker_buffer& buffer) const
+        {
 #ifdef BOOST_GEOMETRY_DEBUG_DOUGLAS_PEUCKER
                 std::cout << "max distance: " << max_distance
                           << std::endl << std::endl;
 #endif
-            distance_strategy_type strategy;
+            typedef typename boost::range_iterator<Range const>::type iterator;
 
-            // Copy coordinates, a vector of references to all points
-            std::vector<dp_point_type> ref_candidates(boost::begin(range),
-                            boost::end(range));
+            std::size_t const size = boost::size(range);
+            if (size == 0)
+            {
+                return out;
+            }
+
+            distance_strategy_type strategy;
+            iterator const points = boost::begin(range);
 
             // Include first and last point of line,
             // they are always part of the line
-            int n = 2;
-            ref_candidates.front().included = true;
-            ref_candidates.back().included = true;
+            buffer.included.assign(size, 0);
+            buffer.included.front() = 1;
+            buffer.included.back() = 1;
 
-            // Get points, recursively, including them if they are further away
+            // Get points, including them if they are further away
             // than the specified distance
-            consider(boost::begin(ref_candidates), boost::end(ref_candidates), max_distance, n, strategy);
+            buffer.stack.clear();
+            buffer.stack.push_back(index_range(0, size - 1));
+            consider(points, max_distance, buffer.included, buffer.stack, strategy);
+
+            return copy_included(points, buffer.included, out);
+        }
+
+        // Considers independent sub-ranges of long ranges in parallel
+        template <typename Range, typename OutputIterator>
+        inline OutputIterator apply(Range const& range,
+                                    OutputIterator out,
+                                    distance_type max_distance,
+                                    geometry::parallel const& policy) const
+        {
+            douglas_peucker_buffer buffer;
+            return apply(range, out, max_distance, policy, buffer);
+        }
 
-            // Copy included elements to the output
-            for(typename std::vector<dp_point_type>::const_iterator it
-                            = boost::begin(ref_candidates);
-                it != boost::end(ref_candidates);
-                ++it)
+        // Considers independent sub-ranges of long ranges in parallel, using
+        // the passed buffer for the flags and the ranges of the tasks
+        template <typename Range, typename OutputIterator>
+        inline OutputIterator apply(Range const& range,
+                                    OutputIterator out,
+                                    distance_type max_distance,
+                                    geometry::parallel const& policy,
+                                    douglas_peucker_buffer& buffer) const
+        {
+            typedef typename boost::range_iterator<Range const>::type iterator;
+
+            std::size_t const size = boost::size(range);
+            std::size_t const threads
+                = geometry::detail::parallel::threads_count(policy);
+            if (threads <= 1 || size < parallel_min_size)
             {
-                if (it->included)
-                {
-                    // copy-coordinates does not work because OutputIterator
-                    // does not model Point (??)
-                    //geometry::convert(it->p, *out);
-                    *out = it->p;
-                    out++;
-                }
+                return apply(range, out, max_distance, buffer);
             }
-            return out;
+
+            distance_strategy_type strategy;
+            iterator const points = boost::begin(range);
+
+            buffer.included.assign(size, 0);
+            buffer.included.front() = 1;
+            buffer.included.back() = 1;
+
+            // The ranges are split sequentially until there are several
+            // ranges per thread, then they are considered in parallel.
+            // The sub-ranges don't overlap (apart from their endpoints,
+            // which are already included) so the result is the same as the
+            // result of the sequential version.
+            std::vector<index_range>& ranges = buffer.stack;
+            ranges.assign(1, index_range(0, size - 1));
+            split_for_tasks(points, max_distance, buffer.included, ranges,
+                            threads * 4, strategy);
+
+            consider_task<iterator> task(*this, points, max_distance,
+                                         buffer.included, ranges, strategy);
+            geometry::detail::parallel::for_each_index(ranges.size(), task,
+                                                       threads);
+
+            return copy_included(points, buffer.included, out);
         }
 
     };
@@ -276,44 +440,96 @@ public :
             PointDistanceStrategy
         >::distance_type distance_type;
 
+    /*!
+    \brief Memory used by the strategy, which can be passed to apply and
+        reused for several ranges to avoid allocations
+    */
+    typedef detail::douglas_peucker_buffer buffer_type;
+
+private :
+
+    typedef typename strategy::distance::services::comparable_type
+        <
+            PointDistanceStrategy
+        >::type comparable_distance_strategy_type;
+
+    typedef detail::douglas_peucker
+        <
+            Point, comparable_distance_strategy_type
+        > detail_type;
+
+    static inline typename detail_type::distance_type
+    comparable_distance(distance_type const& max_distance)
+    {
+        return strategy::distance::services::result_from_distance
+            <
+                comparable_distance_strategy_type, Point, Point
+            >::apply(comparable_distance_strategy_type(), max_distance);
+    }
+
+public :
+
     template <typename Range, typename OutputIterator>
     static inline OutputIterator apply(Range const& range,
                                        OutputIterator out,
                                        distance_type const& max_distance)
     {
-        namespace services = strategy::distance::services;
-
-        typedef typename services::comparable_type
-            <
-                PointDistanceStrategy
-            >::type comparable_distance_strategy_type;
-
-        return detail::douglas_peucker
-            <
-                Point, comparable_distance_strategy_type
-            >().apply(range, out,
-                      services::result_from_distance
-                          <
-                              comparable_distance_strategy_type, Point, Point
-                          >::apply(comparable_distance_strategy_type(),
-                                   max_distance)
-                      );
+        return detail_type().apply(range, out,
+                                   comparable_distance(max_distance));
     }
 
-};
-
-}} // namespace strategy::simplify
+    /*!
+    \brief Simplifies the range, using the passed buffer which can be
+        reused for other ranges
+    */
+    template <typename Range, typename OutputIterator>
+    static inline OutputIterator apply(Range const& range,
+                                       OutputIterator out,
+                                       distance_type const& max_distance,
+                                       buffer_type& buffer)
+    {
+        return detail_type().apply(range, out,
+                                   comparable_distance(max_distance),
+                                   buffer);
+    }
 
+    /*!
+    \brief Simplifies the range, independent sub-ranges of long ranges
+        are processed in parallel
+    \details The result is the same as the result of the sequential version.
+    */
+    template <typename Range, typename OutputIterator>
+    static inline OutputIterator apply(Range const& range,
+                                       OutputIterator out,
+                                       distance_type const& max_distance,
+                                       geometry::parallel const& policy)
+    {
+        return detail_type().apply(range, out,
+                                   comparable_distance(max_distance),
+                                   policy);
+    }
 
-namespace traits {
+    /*!
+    \brief Simplifies the range, independent sub-ranges of long ranges
+        are processed in parallel, using the passed buffer which can be
+        reused for other ranges
+    \details The result is the same as the result of the sequential version.
+    */
+    template <typename Range, typename OutputIterator>
+    static inline OutputIterator apply(Range const& range,
+                                       OutputIterator out,
+                                       distance_type const& max_distance,
+                                       geometry::parallel const& policy,
+                                       buffer_type& buffer)
+    {
+        return detail_type().apply(range, out,
+                                   comparable_distance(max_distance),
+                                   policy, buffer);
+    }
 
-template <typename P>
-struct point_type<geometry::strategy::simplify::detail::douglas_peucker_point<P> >
-{
-    typedef P type;
 };
 
-} // namespace traits
+}} // namespace strategy::simplify
 
 
 }} // namespace boost::geometry
@@ -0,0 +1,71 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_STRATEGY_AGNOSTIC_SIMPLIFY_TOPOLOGY_PRESERVING_HPP
+#define BOOST_GEOMETRY_STRATEGY_AGNOSTIC_SIMPLIFY_TOPOLOGY_PRESERVING_HPP
+
+
+#include <boost/geometry/core/tags.hpp>
+#include <boost/geometry/strategies/distance.hpp>
+#include <boost/geometry/strategies/agnostic/simplify_visvalingam_whyatt.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+namespace strategy { namespace simplify
+{
+
+
+/*!
+\brief Implements the simplify algorithm.
+\ingroup strategies
+\details The topology_preserving strategy simplifies the rings of a ring,
+    polygon or multi-polygon together, using the Visvalingam-Whyatt
+    algorithm (see visvalingam_whyatt, the passed value is an area).
+    The rings are divided into arcs at the points where they meet each
+    other. An arc shared by several rings (e.g. the common boundary of
+    neighbouring polygons) is simplified once and the result is used in
+    all of them, so the simplified polygons still share it. A vertex is
+    not removed if the triangle formed with its neighbours contains other
+    vertices, if the segment replacing it would cross, touch or overlap
+    another segment (e.g. when two arcs between the same points would both
+    be collapsed onto it), or if a ring containing it would have less
+    than 3 vertices. So if the input is valid, the output is valid too.
+    The shared boundaries are detected by comparing the coordinates, so
+    the same vertices have to be used in both geometries. Other geometries
+    are simplified with visvalingam_whyatt.
+\tparam Point the point type
+\tparam PointDistanceStrategy point-segment distance strategy, it is not
+    used by the algorithm but required by the SimplifyStrategy concept
+
+\qbk{
+[heading See also]
+[link geometry.reference.algorithms.simplify.simplify_4_with_strategy simplify (with strategy)]
+}
+*/
+template
+<
+    typename Point,
+    typename PointDistanceStrategy
+        = typename strategy::distance::services::default_strategy
+            <
+                point_tag, segment_tag, Point
+            >::type
+>
+class topology_preserving
+    : public visvalingam_whyatt<Point, PointDistanceStrategy>
+{};
+
+
+}} // namespace strategy::simplify
+
+
+}} // namespace boost::geometry
+
+#endif // BOOST_GEOMETRY_STRATEGY_AGNOSTIC_SIMPLIFY_TOPOLOGY_PRESERVING_HPP
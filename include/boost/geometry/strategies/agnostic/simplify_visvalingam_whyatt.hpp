@@ -0,0 +1,395 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_STRATEGY_AGNOSTIC_SIMPLIFY_VISVALINGAM_WHYATT_HPP
+#define BOOST_GEOMETRY_STRATEGY_AGNOSTIC_SIMPLIFY_VISVALINGAM_WHYATT_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <boost/range.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/tags.hpp>
+#include <boost/geometry/strategies/distance.hpp>
+#include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/select_most_precise.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+namespace strategy { namespace simplify
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail
+{
+
+/*!
+    \brief Vertices of one or more chains of points, removed in the order
+        of their effective areas
+    \details The effective area of a vertex is the area of the triangle
+        formed with its neighbours. The vertex with the smallest area is
+        removed and the areas of its neighbours are recalculated, they're
+        never smaller than the area of the removed vertex. The vertices are
+        kept in an indexed heap, so their areas can be updated in place.
+        The first and the last point of each chain are never removed.
+    \tparam Point the point type
+*/
+template <typename Point>
+class visvalingam_whyatt_vertices
+{
+public :
+
+    typedef typename select_most_precise
+        <
+            typename coordinate_type<Point>::type,
+            double
+        >::type area_type;
+
+    static const std::size_t none = std::size_t(-1);
+
+    // Adds the points of a chain, returns the index of the first one
+    template <typename Iterator>
+    inline std::size_t add_chain(Iterator first, Iterator last)
+    {
+        std::size_t const begin = m_points.size();
+        std::size_t const count = std::distance(first, last);
+        m_points.reserve(begin + count);
+        m_prev.reserve(begin + count);
+        m_next.reserve(begin + count);
+        m_removed.reserve(begin + count);
+        for (Iterator it = first; it != last; ++it)
+        {
+            std::size_t const index = m_points.size();
+            m_points.push_back(&*it);
+            m_prev.push_back(index == begin ? none : index - 1);
+            m_next.push_back(index + 1);
+            m_removed.push_back(false);
+        }
+        if (m_points.size() > begin)
+        {
+            m_next.back() = none;
+        }
+        return begin;
+    }
+
+    inline std::size_t size() const
+    {
+        return m_points.size();
+    }
+
+    inline Point const& point(std::size_t i) const
+    {
+        return *m_points[i];
+    }
+
+    inline bool removed(std::size_t i) const
+    {
+        return m_removed[i];
+    }
+
+    inline std::size_t prev(std::size_t i) const
+    {
+        return m_prev[i];
+    }
+
+    inline std::size_t next(std::size_t i) const
+    {
+        return m_next[i];
+    }
+
+    // Removes the vertices with an effective area smaller than max_area.
+    // The policy is called with the indices of a vertex and its neighbours
+    // before the vertex is removed, if it returns false the vertex is kept.
+    template <typename RemovePolicy>
+    inline void apply(area_type const& max_area, RemovePolicy& policy)
+    {
+        m_heap.reserve(m_points.size());
+        m_positions.assign(m_points.size(), none);
+        for (std::size_t i = 0; i < m_points.size(); ++i)
+        {
+            if (m_prev[i] != none && m_next[i] != none)
+            {
+                m_positions[i] = m_heap.size();
+                m_heap.push_back(entry(triangle_area(i), i));
+            }
+        }
+        for (std::size_t k = (m_heap.size() + arity - 2) / arity; k > 0; --k)
+        {
+            sift_down(k - 1);
+        }
+
+        while (! m_heap.empty())
+        {
+            std::size_t const i = m_heap.front().index;
+            area_type const area = m_heap.front().area;
+            if (! (area < max_area))
+            {
+                break;
+            }
+
+            // Removed from the heap, also if the policy keeps it
+            remove_top();
+
+            std::size_t const prev = m_prev[i];
+            std::size_t const next = m_next[i];
+
+            if (! policy(i, prev, next))
+            {
+                continue;
+            }
+
+            m_removed[i] = true;
+            m_next[prev] = next;
+            m_prev[next] = prev;
+
+            update(prev, area);
+            update(next, area);
+        }
+    }
+
+private :
+
+    // The heap contains the areas and indices of the vertices, the vertex
+    // with the smallest area (and index) is on top. The positions of the
+    // vertices in the heap are kept to update their areas. It is a 4-ary
+    // heap, which is less deep and has better locality than a binary heap.
+    static const std::size_t arity = 4;
+
+    struct entry
+    {
+        entry(area_type const& a, std::size_t i)
+            : area(a), index(i)
+        {}
+
+        inline bool operator<(entry const& other) const
+        {
+            return area < other.area
+                || (! (other.area < area) && index < other.index);
+        }
+
+        area_type area;
+        std::size_t index;
+    };
+
+    inline void place(std::size_t k, entry const& e)
+    {
+        m_heap[k] = e;
+        m_positions[e.index] = k;
+    }
+
+    inline void sift_up(std::size_t k)
+    {
+        entry const e = m_heap[k];
+        while (k > 0)
+        {
+            std::size_t const parent = (k - 1) / arity;
+            if (! (e < m_heap[parent]))
+            {
+                break;
+            }
+            place(k, m_heap[parent]);
+            k = parent;
+        }
+        place(k, e);
+    }
+
+    inline void sift_down(std::size_t k)
+    {
+        entry const e = m_heap[k];
+        std::size_t const size = m_heap.size();
+        for (;;)
+        {
+            std::size_t const first = arity * k + 1;
+            if (first >= size)
+            {
+                break;
+            }
+            std::size_t const last = (std::min)(first + arity, size);
+            std::size_t child = first;
+            for (std::size_t c = first + 1; c < last; ++c)
+            {
+                if (m_heap[c] < m_heap[child])
+                {
+                    child = c;
+                }
+            }
+            if (! (m_heap[child] < e))
+            {
+                break;
+            }
+            place(k, m_heap[child]);
+            k = child;
+        }
+        place(k, e);
+    }
+
+    inline void remove_top()
+    {
+        m_positions[m_heap.front().index] = none;
+        entry const last = m_heap.back();
+        m_heap.pop_back();
+        if (! m_heap.empty())
+        {
+            place(0, last);
+            sift_down(0);
+        }
+    }
+
+    inline area_type triangle_area(std::size_t i) const
+    {
+        Point const& p0 = *m_points[m_prev[i]];
+        Point const& p1 = *m_points[i];
+        Point const& p2 = *m_points[m_next[i]];
+
+        area_type const x0 = geometry::get<0>(p0);
+        area_type const y0 = geometry::get<1>(p0);
+        area_type const dx1 = area_type(geometry::get<0>(p1)) - x0;
+        area_type const dy1 = area_type(geometry::get<1>(p1)) - y0;
+        area_type const dx2 = area_type(geometry::get<0>(p2)) - x0;
+        area_type const dy2 = area_type(geometry::get<1>(p2)) - y0;
+
+        return math::abs(dx1 * dy2 - dy1 * dx2) / area_type(2);
+    }
+
+    inline void update(std::size_t i, area_type const& removed_area)
+    {
+        std::size_t const k = m_positions[i];
+        if (k == none)
+        {
+            // An endpoint, or kept by the policy
+            return;
+        }
+
+        area_type area = triangle_area(i);
+        if (area < removed_area)
+        {
+            // The areas never decrease below the area of the removed
+            // vertex, otherwise a vertex could be removed before the one
+            // whose removal made its area smaller
+            area = removed_area;
+        }
+
+        bool const smaller = area < m_heap[k].area;
+        m_heap[k].area = area;
+        if (smaller)
+        {
+            sift_up(k);
+        }
+        else
+        {
+            sift_down(k);
+        }
+    }
+
+    std::vector<Point const*> m_points;
+    std::vector<std::size_t> m_prev;
+    std::vector<std::size_t> m_next;
+    std::vector<bool> m_removed;
+    std::vector<entry> m_heap;
+    std::vector<std::size_t> m_positions;
+};
+
+template <typename Point>
+const std::size_t visvalingam_whyatt_vertices<Point>::none;
+
+struct visvalingam_whyatt_remove_all
+{
+    inline bool operator()(std::size_t, std::size_t, std::size_t) const
+    {
+        return true;
+    }
+};
+
+} // namespace detail
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Implements the simplify algorithm.
+\ingroup strategies
+\details The visvalingam_whyatt strategy simplifies a linestring, ring or
+    vector of points using the Visvalingam-Whyatt algorithm. The vertex
+    with the smallest effective area (the area of the triangle formed with
+    its neighbours) is removed until all the remaining vertices have an
+    effective area greater than or equal to the passed value, which is
+    therefore an area and not a distance. The first and the last point are
+    always kept. The effective areas are kept in a heap, so the complexity
+    is O(n log n). The areas are calculated in the cartesian way.
+\tparam Point the point type
+\tparam PointDistanceStrategy point-segment distance strategy, it is not
+    used by the algorithm but required by the SimplifyStrategy concept
+
+\qbk{
+[heading See also]
+[link geometry.reference.algorithms.simplify.simplify_4_with_strategy simplify (with strategy)]
+}
+*/
+
+/*
+For the algorithm, see:
+ - M. Visvalingam and J.D. Whyatt, Line generalisation by repeated
+   elimination of points, The Cartographic Journal 30(1), 1993
+*/
+template
+<
+    typename Point,
+    typename PointDistanceStrategy
+        = typename strategy::distance::services::default_strategy
+            <
+                point_tag, segment_tag, Point
+            >::type
+>
+class visvalingam_whyatt
+{
+public :
+
+    typedef PointDistanceStrategy distance_strategy_type;
+
+    typedef typename detail::visvalingam_whyatt_vertices
+        <
+            Point
+        >::area_type area_type;
+
+    template <typename Range, typename OutputIterator>
+    static inline OutputIterator apply(Range const& range,
+                                       OutputIterator out,
+                                       area_type const& max_area)
+    {
+        detail::visvalingam_whyatt_vertices<Point> vertices;
+        vertices.add_chain(boost::begin(range), boost::end(range));
+
+        detail::visvalingam_whyatt_remove_all policy;
+        vertices.apply(max_area, policy);
+
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+        {
+            if (! vertices.removed(i))
+            {
+                *out = vertices.point(i);
+                ++out;
+            }
+        }
+        return out;
+    }
+};
+
+
+}} // namespace strategy::simplify
+
+
+}} // namespace boost::geometry
+
+#endif // BOOST_GEOMETRY_STRATEGY_AGNOSTIC_SIMPLIFY_VISVALINGAM_WHYATT_HPP
@@ -0,0 +1,396 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_STRATEGIES_GEOGRAPHIC_GEOCENTRIC_CHORD_HPP
+#define BOOST_GEOMETRY_STRATEGIES_GEOGRAPHIC_GEOCENTRIC_CHORD_HPP
+
+
+#include <algorithm>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/radian_access.hpp>
+#include <boost/geometry/core/radius.hpp>
+#include <boost/geometry/core/srs.hpp>
+
+#include <boost/geometry/algorithms/detail/flattening.hpp>
+
+#include <boost/geometry/strategies/distance.hpp>
+
+#include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/promote_floating_point.hpp>
+#include <boost/geometry/util/select_calculation_type.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+namespace strategy { namespace distance
+{
+
+
+namespace comparable
+{
+
+// Comparable geocentric chord: the squared length of the straight line
+// between the points on the surface of the spheroid.
+// To compare distances, we can avoid:
+// - applying sqrt
+// - converting the chord to the length of an arc
+// The chord is never longer than the geodesic, so the comparable distance of
+// a geodesic distance (result_from_distance) is its square: all points within
+// the distance have a smaller or equal comparable distance.
+template
+<
+    typename Spheroid,
+    typename CalculationType = void
+>
+class geocentric_chord
+{
+public :
+    template <typename Point1, typename Point2>
+    struct calculation_type
+        : promote_floating_point
+          <
+              typename select_calculation_type
+                  <
+                      Point1,
+                      Point2,
+                      CalculationType
+                  >::type
+          >
+    {};
+
+    typedef Spheroid model_type;
+
+    inline geocentric_chord()
+        : m_spheroid()
+    {}
+
+    explicit inline geocentric_chord(Spheroid const& spheroid)
+        : m_spheroid(spheroid)
+    {}
+
+    template <typename Point1, typename Point2>
+    inline typename calculation_type<Point1, Point2>::type
+    apply(Point1 const& point1, Point2 const& point2) const
+    {
+        return calc<typename calculation_type<Point1, Point2>::type>
+            (
+                get_as_radian<0>(point1), get_as_radian<1>(point1),
+                get_as_radian<0>(point2), get_as_radian<1>(point2)
+            );
+    }
+
+    /*!
+    \brief converts a point to geocentric (earth-centered, earth-fixed)
+        cartesian coordinates, on the surface of the spheroid
+    \details The squared cartesian distance between two converted points is
+        the comparable distance of the points. A cartesian rtree of the
+        converted points therefore uses it during nearest queries.
+    */
+    template <typename Point, typename GeocentricPoint>
+    inline void to_geocentric(Point const& point, GeocentricPoint& geocentric) const
+    {
+        typedef typename coordinate_type<GeocentricPoint>::type coordinate_type;
+        typedef typename calculation_type<Point, GeocentricPoint>::type calc_t;
+
+        calc_t const lon = get_as_radian<0>(point);
+        calc_t const lat = get_as_radian<1>(point);
+
+        calc_t const radius_a = calc_t(get_radius<0>(m_spheroid));
+        calc_t const es = eccentricity_squared<calc_t>();
+
+        calc_t const sin_lat = sin(lat);
+        calc_t const cos_lat = cos(lat);
+        calc_t const n = radius_a / math::sqrt(calc_t(1) - es * sin_lat * sin_lat);
+
+        set<0>(geocentric, coordinate_type(n * cos_lat * cos(lon)));
+        set<1>(geocentric, coordinate_type(n * cos_lat * sin(lon)));
+        set<2>(geocentric, coordinate_type(n * (calc_t(1) - es) * sin_lat));
+    }
+
+    inline Spheroid const& model() const
+    {
+        return m_spheroid;
+    }
+
+private :
+    template <typename CT>
+    inline CT eccentricity_squared() const
+    {
+        CT const flattening = geometry::detail::flattening<CT>(m_spheroid);
+        return flattening * (CT(2) - flattening);
+    }
+
+    template <typename CT, typename T1, typename T2>
+    inline CT calc(T1 const& lon1, T1 const& lat1,
+                   T2 const& lon2, T2 const& lat2) const
+    {
+        CT const radius_a = CT(get_radius<0>(m_spheroid));
+        CT const es = eccentricity_squared<CT>();
+        CT const c1 = 1;
+
+        CT const sin_lat1 = sin(lat1);
+        CT const cos_lat1 = cos(lat1);
+        CT const sin_lat2 = sin(lat2);
+        CT const cos_lat2 = cos(lat2);
+        CT const n1 = radius_a / math::sqrt(c1 - es * sin_lat1 * sin_lat1);
+        CT const n2 = radius_a / math::sqrt(c1 - es * sin_lat2 * sin_lat2);
+
+        // Rotated around the axis such that the first point has y = 0,
+        // which saves the sine and cosine of one longitude
+        CT const dlon = lon2 - lon1;
+        CT const r2 = n2 * cos_lat2;
+        CT const dx = n1 * cos_lat1 - r2 * cos(dlon);
+        CT const dy = r2 * sin(dlon);
+        CT const dz = (c1 - es) * (n1 * sin_lat1 - n2 * sin_lat2);
+
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    Spheroid m_spheroid;
+};
+
+
+} // namespace comparable
+
+
+/*!
+\brief Fast approximation of the geodesic distance, using the straight line
+    (chord) between the points in geocentric coordinates
+\ingroup distance
+\details The chord is converted to the length of the arc of a sphere with the
+    mean radius of the spheroid, 2 R asin(chord / 2 R). The relative error of
+    this approximation is below 1.2e-5 (s / 1000 km)^2 for geodesic distances
+    s up to 10000 km: about 1 cm at 100 km, 12 m at 1000 km and 1.5 km at
+    5000 km. For nearly antipodal points it can be a few percent.
+    The geodesic distance of points is always between min_distance and
+    max_distance of their comparable distance, which can be used to filter
+    points before calculating the exact distances of the remaining candidates.
+\tparam Spheroid The reference spheroid model
+\tparam CalculationType \tparam_calculation
+\note The bounds follow from the curvature of geodesics, which is at most
+    1 / (a (1 - e^2)): the chord of a geodesic of length s is at least the
+    chord of a circle with this radius (Schur's comparison theorem)
+\note Measured against the geodesics of C.F.F. Karney, Algorithms for
+    geodesics, J. Geodesy 87, 43-55 (2013), on WGS84
+*/
+template
+<
+    typename Spheroid,
+    typename CalculationType = void
+>
+class geocentric_chord
+{
+    typedef comparable::geocentric_chord<Spheroid, CalculationType> comparable_type;
+
+public :
+    template <typename Point1, typename Point2>
+    struct calculation_type
+        : services::return_type<comparable_type, Point1, Point2>
+    {};
+
+    typedef Spheroid model_type;
+
+    inline geocentric_chord()
+        : m_comparable()
+    {}
+
+    explicit inline geocentric_chord(Spheroid const& spheroid)
+        : m_comparable(spheroid)
+    {}
+
+    /*!
+    \brief applies the distance calculation
+    \return the approximated geodesic distance
+    \param point1 first point
+    \param point2 second point
+    */
+    template <typename Point1, typename Point2>
+    inline typename calculation_type<Point1, Point2>::type
+    apply(Point1 const& point1, Point2 const& point2) const
+    {
+        typedef typename calculation_type<Point1, Point2>::type calc_t;
+
+        calc_t const chord = math::sqrt(m_comparable.apply(point1, point2));
+        calc_t const radius = mean_radius<calc_t>();
+        calc_t const c2 = 2;
+        return c2 * radius * asin((std::min)(chord / (c2 * radius), calc_t(1)));
+    }
+
+    /*!
+    \brief returns the smallest possible geodesic distance of points
+        having the specified comparable distance, the length of the chord
+    */
+    template <typename T>
+    inline T min_distance(T const& comparable_distance) const
+    {
+        return math::sqrt(comparable_distance);
+    }
+
+    /*!
+    \brief returns the largest possible geodesic distance of points
+        having the specified comparable distance
+    */
+    template <typename T>
+    inline T max_distance(T const& comparable_distance) const
+    {
+        T const radius_a = T(get_radius<0>(m_comparable.model()));
+        T const flattening = geometry::detail::flattening<T>(m_comparable.model());
+        T const c1 = 1;
+        T const c2 = 2;
+
+        // Smallest radius of curvature of the spheroid, at the equator
+        // along the meridian
+        T const rho = radius_a * math::sqr(c1 - flattening);
+
+        T const chord = math::sqrt(comparable_distance);
+        return chord < c2 * rho
+            ? c2 * rho * asin(chord / (c2 * rho))
+            : math::pi<T>() * radius_a;
+    }
+
+    template <typename Point, typename GeocentricPoint>
+    inline void to_geocentric(Point const& point, GeocentricPoint& geocentric) const
+    {
+        m_comparable.to_geocentric(point, geocentric);
+    }
+
+    inline Spheroid const& model() const
+    {
+        return m_comparable.model();
+    }
+
+private :
+    template <typename CT>
+    inline CT mean_radius() const
+    {
+        CT const radius_a = CT(get_radius<0>(m_comparable.model()));
+        CT const radius_b = CT(get_radius<2>(m_comparable.model()));
+        return (CT(2) * radius_a + radius_b) / CT(3);
+    }
+
+    comparable_type m_comparable;
+};
+
+
+#ifndef DOXYGEN_NO_STRATEGY_SPECIALIZATIONS
+namespace services
+{
+
+template <typename Spheroid, typename CalculationType>
+struct tag<geocentric_chord<Spheroid, CalculationType> >
+{
+    typedef strategy_tag_distance_point_point type;
+};
+
+
+template <typename Spheroid, typename CalculationType, typename P1, typename P2>
+struct return_type<geocentric_chord<Spheroid, CalculationType>, P1, P2>
+    : geocentric_chord<Spheroid, CalculationType>::template calculation_type<P1, P2>
+{};
+
+
+template <typename Spheroid, typename CalculationType>
+struct comparable_type<geocentric_chord<Spheroid, CalculationType> >
+{
+    typedef comparable::geocentric_chord<Spheroid, CalculationType> type;
+};
+
+
+template <typename Spheroid, typename CalculationType>
+struct get_comparable<geocentric_chord<Spheroid, CalculationType> >
+{
+private :
+    typedef geocentric_chord<Spheroid, CalculationType> this_type;
+    typedef comparable::geocentric_chord<Spheroid, CalculationType> comparable_type;
+public :
+    static inline comparable_type apply(this_type const& input)
+    {
+        return comparable_type(input.model());
+    }
+};
+
+template <typename Spheroid, typename CalculationType, typename P1, typename P2>
+struct result_from_distance<geocentric_chord<Spheroid, CalculationType>, P1, P2>
+{
+private :
+    typedef geocentric_chord<Spheroid, CalculationType> this_type;
+    typedef typename return_type<this_type, P1, P2>::type return_type;
+public :
+    template <typename T>
+    static inline return_type apply(this_type const& , T const& value)
+    {
+        return return_type(value);
+    }
+};
+
+
+// Specializations for comparable::geocentric_chord
+template <typename Spheroid, typename CalculationType>
+struct tag<comparable::geocentric_chord<Spheroid, CalculationType> >
+{
+    typedef strategy_tag_distance_point_point type;
+};
+
+
+template <typename Spheroid, typename CalculationType, typename P1, typename P2>
+struct return_type<comparable::geocentric_chord<Spheroid, CalculationType>, P1, P2>
+    : comparable::geocentric_chord<Spheroid, CalculationType>::template calculation_type<P1, P2>
+{};
+
+
+template <typename Spheroid, typename CalculationType>
+struct comparable_type<comparable::geocentric_chord<Spheroid, CalculationType> >
+{
+    typedef comparable::geocentric_chord<Spheroid, CalculationType> type;
+};
+
+
+template <typename Spheroid, typename CalculationType>
+struct get_comparable<comparable::geocentric_chord<Spheroid, CalculationType> >
+{
+private :
+    typedef comparable::geocentric_chord<Spheroid, CalculationType> this_type;
+public :
+    static inline this_type apply(this_type const& input)
+    {
+        return input;
+    }
+};
+
+
+template <typename Spheroid, typename CalculationType, typename P1, typename P2>
+struct result_from_distance<comparable::geocentric_chord<Spheroid, CalculationType>, P1, P2>
+{
+private :
+    typedef comparable::geocentric_chord<Spheroid, CalculationType> strategy_type;
+    typedef typename return_type<strategy_type, P1, P2>::type return_type;
+public :
+    // The largest squared chord of points within the distance
+    template <typename T>
+    static inline return_type apply(strategy_type const& , T const& distance)
+    {
+        return_type const d = distance;
+        return d * d;
+    }
+};
+
+
+} // namespace services
+#endif // DOXYGEN_NO_STRATEGY_SPECIALIZATIONS
+
+
+}} // namespace strategy::distance
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_STRATEGIES_GEOGRAPHIC_GEOCENTRIC_CHORD_HPP
@@ -0,0 +1,243 @@
+// Boost.Geometry
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_UTIL_PARALLEL_HPP
+#define BOOST_GEOMETRY_UTIL_PARALLEL_HPP
+
+
+#include <cstddef>
+
+#include <boost/config.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <boost/exception_ptr.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+// Parallel execution is implemented with OpenMP so the library stays
+// header-only. If the code is compiled without OpenMP support all tasks
+// are processed sequentially by the calling thread.
+// Tasks (used by recursive algorithms) require OpenMP 3.0.
+#if defined(_OPENMP) && (_OPENMP >= 200805)
+#define BOOST_GEOMETRY_DETAIL_PARALLEL_TASKS
+#endif
+
+
+namespace boost { namespace geometry
+{
+
+
+/*!
+\brief Execution policy requesting parallel processing
+\ingroup utility
+\details Algorithms taking this policy divide their work into independent
+    tasks and process them with up to the requested number of threads.
+    The result is the same as the result of the sequential version.
+    If the program is compiled without OpenMP support the tasks are
+    processed sequentially.
+*/
+class parallel
+{
+public:
+    /*!
+    \brief The constructor.
+    \param threads The maximum number of threads. If 0 the default number
+        of threads of the OpenMP runtime is used.
+    */
+    explicit parallel(std::size_t threads = 0)
+        : m_threads(threads)
+    {}
+
+    /*!
+    \brief Returns the requested number of threads, 0 means default.
+    */
+    std::size_t threads() const
+    {
+        return m_threads;
+    }
+
+private:
+    std::size_t m_threads;
+};
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace parallel
+{
+
+
+inline std::size_t max_threads()
+{
+#ifdef _OPENMP
+    return static_cast<std::size_t>(omp_get_max_threads());
+#else
+    return 1;
+#endif
+}
+
+inline std::size_t thread_index()
+{
+#ifdef _OPENMP
+    return static_cast<std::size_t>(omp_get_thread_num());
+#else
+    return 0;
+#endif
+}
+
+inline std::size_t threads_count(geometry::parallel const& policy)
+{
+    std::size_t const threads = policy.threads();
+    return threads == 0 ? max_threads() : threads;
+}
+
+
+// Exceptions can't leave OpenMP tasks and parallel regions, the first one
+// is stored and rethrown by the thread which started the parallel work.
+class exception_holder
+{
+public:
+    template <typename Function>
+    inline void run(Function & f)
+    {
+        try
+        {
+            f();
+        }
+        catch (...)
+        {
+            store();
+        }
+    }
+
+    template <typename Function, typename Argument>
+    inline void run(Function & f, Argument const& arg)
+    {
+        try
+        {
+            f(arg);
+        }
+        catch (...)
+        {
+            store();
+        }
+    }
+
+    inline void rethrow() const
+    {
+        if (m_exception)
+        {
+            boost::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    inline void store()
+    {
+#ifdef _OPENMP
+#pragma omp critical (boost_geometry_detail_parallel_exception)
+#endif
+        {
+            if (! m_exception)
+            {
+                m_exception = boost::current_exception();
+            }
+        }
+    }
+
+    boost::exception_ptr m_exception;
+};
+
+
+// Calls f() inside a team of threads. Only one thread calls f(), the other
+// ones execute the tasks created by fork_join().
+template <typename Function>
+inline void run_team(Function & f, std::size_t threads)
+{
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_TASKS
+    if (threads > 1)
+    {
+        exception_holder holder;
+#pragma omp parallel num_threads(static_cast<int>(threads))
+        {
+#pragma omp single
+            holder.run(f);
+        }
+        holder.rethrow();
+        return;
+    }
+#else
+    boost::ignore_unused(threads);
+#endif
+
+    f();
+}
+
+// Calls f1() and f2(), if spawn is true f1() is processed as a task and may
+// be executed by a different thread of the team.
+template <typename Function1, typename Function2>
+inline void fork_join(Function1 & f1, Function2 & f2, bool spawn)
+{
+#ifdef BOOST_GEOMETRY_DETAIL_PARALLEL_TASKS
+    if (spawn)
+    {
+        exception_holder holder;
+#pragma omp task shared(f1, holder)
+        holder.run(f1);
+        holder.run(f2);
+#pragma omp taskwait
+        holder.rethrow();
+        return;
+    }
+#else
+    boost::ignore_unused(spawn);
+#endif
+
+    f1();
+    f2();
+}
+
+// Calls f(i) for i in [0, count), the calls may be executed concurrently
+// and in any order.
+template <typename Function>
+inline void for_each_index(std::size_t count, Function & f, std::size_t threads)
+{
+#ifdef _OPENMP
+    if (threads > 1 && count > 1)
+    {
+        exception_holder holder;
+        // OpenMP 2.0 requires a signed loop variable
+        long const n = static_cast<long>(count);
+#pragma omp parallel for num_threads(static_cast<int>(threads)) schedule(dynamic)
+        for (long i = 0; i < n; ++i)
+        {
+            holder.run(f, static_cast<std::size_t>(i));
+        }
+        holder.rethrow();
+        return;
+    }
+#else
+    boost::ignore_unused(threads);
+#endif
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        f(i);
+    }
+}
+
+
+}} // namespace detail::parallel
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_UTIL_PARALLEL_HPP
@@ -0,0 +1,95 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the times of separate knn queries and of the batch knn query.
+
+#include <iostream>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef boost::chrono::thread_clock clock_type;
+typedef boost::chrono::duration<float> dur_t;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+typedef bgi::rtree<B, bgi::linear<16, 4> > RT;
+
+void test_queries(RT const& t, std::vector<P> const& queries, size_t k)
+{
+    std::vector<B> result;
+    result.reserve(k);
+
+    clock_type::time_point start = clock_type::now();
+    size_t temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        result.clear();
+        t.query(bgi::nearest(queries[i], static_cast<unsigned>(k)), std::back_inserter(result));
+        temp += result.size();
+    }
+    dur_t time = clock_type::now() - start;
+    std::cout << "query(nearest(P, " << k << ")) " << queries.size() << " found " << temp << " : " << time << '\n';
+
+    std::vector<B> results(queries.size() * k);
+    std::vector<size_t> counts(queries.size());
+
+    start = clock_type::now();
+    temp = t.batch_nearest(queries, k, results.begin(), counts.begin());
+    time = clock_type::now() - start;
+    std::cout << "batch_nearest(P, " << k << ") " << queries.size() << " found " << temp << " : " << time << '\n';
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t queries_count = 1000000;
+
+    std::vector<B> values;
+    std::vector<P> queries;
+    {
+        boost::mt19937 rng;
+        float max_val = static_cast<float>(values_count / 2);
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            float x = rnd(), y = rnd();
+            values.push_back(B(P(x - 0.5f, y - 0.5f), P(x + 0.5f, y + 0.5f)));
+        }
+        for ( size_t i = 0 ; i < queries_count ; ++i )
+            queries.push_back(P(rnd(), rnd()));
+    }
+
+    {
+        RT t(values.begin(), values.end());
+        std::cout << "packed rtree" << std::endl;
+        test_queries(t, queries, 1);
+        test_queries(t, queries, 10);
+    }
+
+    {
+        RT t;
+        for ( size_t i = 0 ; i < values_count ; ++i )
+            t.insert(values[i]);
+        std::cout << "inserted rtree" << std::endl;
+        test_queries(t, queries, 1);
+        test_queries(t, queries, 10);
+    }
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the query times of the rtree and the flat rtree created from it.
+
+#include <iostream>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/index/flat_rtree.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef boost::chrono::thread_clock clock_type;
+typedef boost::chrono::duration<float> dur_t;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+typedef bgi::rtree<B, bgi::linear<16, 4> > RT;
+typedef bgi::flat_rtree<B, bgi::linear<16, 4> > FRT;
+
+template <typename Tree>
+void test_queries(Tree const& t, std::vector<B> const& queries, const char * name)
+{
+    std::vector<B> result;
+    result.reserve(100);
+
+    clock_type::time_point start = clock_type::now();
+    size_t temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        result.clear();
+        t.query(bgi::intersects(queries[i]), std::back_inserter(result));
+        temp += result.size();
+    }
+    dur_t time = clock_type::now() - start;
+    std::cout << name << " - query(B) " << queries.size() << " found " << temp << " : " << time << '\n';
+
+    start = clock_type::now();
+    temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        result.clear();
+        t.query(bgi::nearest(queries[i].min_corner(), 10), std::back_inserter(result));
+        temp += result.size();
+    }
+    time = clock_type::now() - start;
+    std::cout << name << " - query(nearest(P, 10)) " << queries.size() << " found " << temp << " : " << time << '\n';
+}
+
+int main()
+{
+    size_t values_count = 10000000;
+    size_t queries_count = 1000000;
+
+    std::vector<B> values;
+    std::vector<B> queries;
+
+    //randomize values
+    {
+        boost::mt19937 rng;
+        //rng.seed(static_cast<unsigned int>(std::time(0)));
+        double max_val = static_cast<double>(values_count / 10);
+        boost::uniform_real<double> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<double> > rnd(rng, range);
+
+        std::cout << "randomizing data\n";
+        values.reserve(values_count);
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            double x = rnd();
+            double y = rnd();
+            values.push_back(B(P(x - 0.5, y - 0.5), P(x + 0.5, y + 0.5)));
+        }
+
+        queries.reserve(queries_count);
+        for ( size_t i = 0 ; i < queries_count ; ++i )
+        {
+            double x = rnd();
+            double y = rnd();
+            queries.push_back(B(P(x - 10, y - 10), P(x + 10, y + 10)));
+        }
+        std::cout << "randomized\n";
+    }
+
+    // inserted values, nodes allocated in random order
+    {
+        clock_type::time_point start = clock_type::now();
+        RT t;
+        for ( size_t i = 0 ; i < values.size() ; ++i )
+            t.insert(values[i]);
+        dur_t time = clock_type::now() - start;
+        std::cout << "rtree - insert " << values_count << " : " << time << '\n';
+
+        test_queries(t, queries, "rtree");
+
+        start = clock_type::now();
+        FRT ft(t);
+        time = clock_type::now() - start;
+        std::cout << "flat_rtree - create " << values_count << " : " << time << '\n';
+
+        test_queries(ft, queries, "flat_rtree");
+    }
+
+    // packed values
+    {
+        clock_type::time_point start = clock_type::now();
+        RT t(values);
+        dur_t time = clock_type::now() - start;
+        std::cout << "rtree - pack " << values_count << " : " << time << '\n';
+
+        test_queries(t, queries, "rtree");
+
+        FRT ft = bgi::freeze(t);
+
+        test_queries(ft, queries, "flat_rtree");
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the times of the spatial join performed with a query per value
+// of the first rtree and with the synchronized traversal of both rtrees.
+// Compile with OpenMP support enabled, otherwise the parallel join
+// is performed by one thread.
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+// wall clock, thread_clock would measure the time of the calling thread only
+typedef boost::chrono::steady_clock clock_type;
+typedef boost::chrono::duration<float> dur_t;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+typedef bgi::rtree<B, bgi::linear<16, 4> > RT;
+
+std::vector<B> random_boxes(size_t count, float max_val, float half_size, unsigned seed)
+{
+    boost::mt19937 rng(seed);
+    boost::uniform_real<float> range(-max_val, max_val);
+    boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+    std::vector<B> result;
+    result.reserve(count);
+    for ( size_t i = 0 ; i < count ; ++i )
+    {
+        float x = rnd(), y = rnd();
+        result.push_back(B(P(x - half_size, y - half_size), P(x + half_size, y + half_size)));
+    }
+    return result;
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t max_threads = bg::detail::parallel::max_threads();
+    // about 2 intersecting values per value
+    float max_val = static_cast<float>(values_count / 1000);
+
+    std::vector<B> values1 = random_boxes(values_count, max_val, 0.5f, 1);
+    std::vector<B> values2 = random_boxes(values_count, max_val, 1.0f, 2);
+
+    RT t1(values1.begin(), values1.end());
+    RT t2(values2.begin(), values2.end());
+
+    std::vector< std::pair<B, B> > result;
+
+    {
+        clock_type::time_point start = clock_type::now();
+        std::vector<B> found;
+        for ( size_t i = 0 ; i < values1.size() ; ++i )
+        {
+            found.clear();
+            t2.query(bgi::intersects(values1[i]), std::back_inserter(found));
+            for ( size_t j = 0 ; j < found.size() ; ++j )
+                result.push_back(std::make_pair(values1[i], found[j]));
+        }
+        dur_t time = clock_type::now() - start;
+        std::cout << time << " - query(intersects(B)) " << values_count << " found " << result.size() << '\n';
+    }
+
+    {
+        result.clear();
+        clock_type::time_point start = clock_type::now();
+        size_t found = t1.join(t2, bgi::join_intersects(), std::back_inserter(result));
+        dur_t time = clock_type::now() - start;
+        std::cout << time << " - join(join_intersects()) found " << found << '\n';
+    }
+
+    for ( size_t threads = 1 ; threads <= max_threads ; threads *= 2 )
+    {
+        result.clear();
+        clock_type::time_point start = clock_type::now();
+        size_t found = t1.join(t2, bgi::join_intersects(), std::back_inserter(result), bg::parallel(threads));
+        dur_t time = clock_type::now() - start;
+        std::cout << time << " - join(join_intersects()) threads " << threads << " found " << found << '\n';
+    }
+
+    {
+        result.clear();
+        clock_type::time_point start = clock_type::now();
+        size_t found = t1.join(t2, bgi::join_distance_within(1.0), std::back_inserter(result));
+        dur_t time = clock_type::now() - start;
+        std::cout << time << " - join(join_distance_within(1)) found " << found << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the kmeans and rstar split algorithms on clustered data.
+
+#include <iostream>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/index/detail/rtree/utilities/overlap.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef boost::chrono::thread_clock clock_type;
+typedef boost::chrono::duration<float> dur_t;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+
+template <typename Rtree>
+void test_rtree(std::vector<B> const& values, std::vector<B> const& queries, const char * name)
+{
+    clock_type::time_point start = clock_type::now();
+    Rtree t;
+    for ( size_t i = 0 ; i < values.size() ; ++i )
+        t.insert(values[i]);
+    dur_t time = clock_type::now() - start;
+    std::cout << name << " - insert " << values.size() << " : " << time << '\n';
+
+    typename bgi::detail::default_content_result<B>::type nodes_content, overlap_content;
+    boost::tie(nodes_content, overlap_content) = bgi::detail::rtree::utilities::overlap(t);
+    std::cout << name << " - overlap / content : " << overlap_content / nodes_content << '\n';
+
+    std::vector<B> result;
+    result.reserve(100);
+
+    start = clock_type::now();
+    size_t temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        result.clear();
+        t.query(bgi::intersects(queries[i]), std::back_inserter(result));
+        temp += result.size();
+    }
+    time = clock_type::now() - start;
+    std::cout << name << " - query(B) " << queries.size() << " found " << temp << " : " << time << '\n';
+
+    start = clock_type::now();
+    temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        result.clear();
+        t.query(bgi::nearest(queries[i].min_corner(), 5), std::back_inserter(result));
+        temp += result.size();
+    }
+    time = clock_type::now() - start;
+    std::cout << name << " - query(nearest(P, 5)) " << queries.size() << " found " << temp << " : " << time << '\n';
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t queries_count = 100000;
+    size_t clusters_count = 100;
+
+    std::vector<B> values;
+    std::vector<B> queries;
+
+    //randomize values
+    {
+        boost::mt19937 rng;
+        //rng.seed(static_cast<unsigned int>(std::time(0)));
+        double max_val = static_cast<double>(values_count / 10);
+        boost::uniform_real<double> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<double> > rnd(rng, range);
+        boost::normal_distribution<double> spread(0, max_val / 50);
+        boost::variate_generator<boost::mt19937&, boost::normal_distribution<double> > rnd_spread(rng, spread);
+
+        std::vector<P> centers;
+        for ( size_t i = 0 ; i < clusters_count ; ++i )
+            centers.push_back(P(rnd(), rnd()));
+
+        std::cout << "randomizing data\n";
+        values.reserve(values_count);
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            P const& c = centers[i % clusters_count];
+            double x = bg::get<0>(c) + rnd_spread();
+            double y = bg::get<1>(c) + rnd_spread();
+            values.push_back(B(P(x - 0.5, y - 0.5), P(x + 0.5, y + 0.5)));
+        }
+
+        queries.reserve(queries_count);
+        for ( size_t i = 0 ; i < queries_count ; ++i )
+        {
+            P const& c = centers[i % clusters_count];
+            double x = bg::get<0>(c) + rnd_spread();
+            double y = bg::get<1>(c) + rnd_spread();
+            queries.push_back(B(P(x - 5, y - 5), P(x + 5, y + 5)));
+        }
+        std::cout << "randomized\n";
+    }
+
+    test_rtree< bgi::rtree<B, bgi::kmeans<16, 4> > >(values, queries, "kmeans<16, 4>");
+    test_rtree< bgi::rtree<B, bgi::rstar<16, 4> > >(values, queries, "rstar<16, 4>");
+    test_rtree< bgi::rtree<B, bgi::quadratic<16, 4> > >(values, queries, "quadratic<16, 4>");
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the time needed to load the rtree serialized with Boost.Serialization
+// and to open the mapped rtree stored in the memory-mapped file.
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#define BOOST_GEOMETRY_INDEX_DETAIL_EXPERIMENTAL
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/index/mapped_rtree.hpp>
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef boost::chrono::steady_clock clock_type;
+typedef boost::chrono::duration<float> dur_t;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+typedef bgi::rtree<B, bgi::linear<16, 4> > RT;
+typedef bgi::mapped_rtree<B, bgi::linear<16, 4> > MRT;
+
+template <typename Tree>
+size_t test_queries(Tree const& t, std::vector<B> const& queries)
+{
+    std::vector<B> result;
+    size_t temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        result.clear();
+        t.query(bgi::intersects(queries[i]), std::back_inserter(result));
+        temp += result.size();
+    }
+    return temp;
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t queries_count = 1000;
+
+    std::vector<B> values, queries;
+    {
+        boost::mt19937 rng;
+        float max_val = 500;
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            float x = rnd(), y = rnd();
+            values.push_back(B(P(x - 0.5f, y - 0.5f), P(x + 0.5f, y + 0.5f)));
+        }
+        for ( size_t i = 0 ; i < queries_count ; ++i )
+        {
+            float x = rnd(), y = rnd();
+            queries.push_back(B(P(x - 10, y - 10), P(x + 10, y + 10)));
+        }
+    }
+
+    {
+        RT t(values.begin(), values.end());
+
+        clock_type::time_point start = clock_type::now();
+        {
+            std::ofstream ofs("benchmark_mapped_tree.bin", std::ios::binary | std::ios::trunc);
+            boost::archive::binary_oarchive oa(ofs);
+            oa << t;
+        }
+        dur_t time = clock_type::now() - start;
+        std::cout << "serialized in: " << time << '\n';
+
+        start = clock_type::now();
+        {
+            std::ofstream ofs("benchmark_mapped_tree.map", std::ios::binary | std::ios::trunc);
+            bgi::write_mapped(ofs, t);
+        }
+        time = clock_type::now() - start;
+        std::cout << "written in: " << time << '\n';
+    }
+
+    {
+        clock_type::time_point start = clock_type::now();
+        RT t;
+        {
+            std::ifstream ifs("benchmark_mapped_tree.bin", std::ios::binary);
+            boost::archive::binary_iarchive ia(ifs);
+            ia >> t;
+        }
+        dur_t time = clock_type::now() - start;
+        std::cout << "deserialized in: " << time << '\n';
+
+        start = clock_type::now();
+        size_t found = test_queries(t, queries);
+        time = clock_type::now() - start;
+        std::cout << "rtree - query(B) " << queries_count << " found " << found << " : " << time << '\n';
+    }
+
+    {
+        namespace bip = boost::interprocess;
+
+        clock_type::time_point start = clock_type::now();
+        bip::file_mapping file("benchmark_mapped_tree.map", bip::read_only);
+        bip::mapped_region region(file, bip::read_only);
+        MRT t(region.get_address(), region.get_size());
+        dur_t time = clock_type::now() - start;
+        std::cout << "mapped in: " << time << '\n';
+
+        start = clock_type::now();
+        size_t found = test_queries(t, queries);
+        time = clock_type::now() - start;
+        std::cout << "mapped rtree - query(B) " << queries_count << " found " << found << " : " << time << '\n';
+    }
+
+    std::remove("benchmark_mapped_tree.bin");
+    std::remove("benchmark_mapped_tree.map");
+
+    return 0;
+}
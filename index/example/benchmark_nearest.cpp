@@ -0,0 +1,111 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the times of knn queries performed with query() and with the
+// query iterators for various k in shallow and deep trees.
+
+#include <iostream>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef boost::chrono::thread_clock clock_type;
+typedef boost::chrono::duration<float> dur_t;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+
+template <typename RT>
+void test_queries(RT const& t, std::vector<P> const& queries, unsigned k)
+{
+    std::vector<B> result;
+    result.reserve(k);
+
+    clock_type::time_point start = clock_type::now();
+    size_t temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        result.clear();
+        t.query(bgi::nearest(queries[i], k), std::back_inserter(result));
+        temp += result.size();
+    }
+    dur_t time = clock_type::now() - start;
+    std::cout << "query(nearest(P, " << k << ")) " << queries.size() << " found " << temp << " : " << time << '\n';
+
+    start = clock_type::now();
+    temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        for ( typename RT::const_query_iterator it = t.qbegin(bgi::nearest(queries[i], k)) ;
+              it != t.qend() ; ++it )
+        {
+            ++temp;
+        }
+    }
+    time = clock_type::now() - start;
+    std::cout << "qbegin(nearest(P, " << k << ")) " << queries.size() << " found " << temp << " : " << time << '\n';
+}
+
+template <typename RT>
+void test_rtree(std::vector<B> const& values, std::vector<P> const& queries, const char * name)
+{
+    {
+        RT t(values.begin(), values.end());
+        std::cout << "packed " << name << std::endl;
+        test_queries(t, queries, 1);
+        test_queries(t, queries, 10);
+        test_queries(t, queries, 100);
+    }
+
+    {
+        RT t;
+        for ( size_t i = 0 ; i < values.size() ; ++i )
+            t.insert(values[i]);
+        std::cout << "inserted " << name << std::endl;
+        test_queries(t, queries, 1);
+        test_queries(t, queries, 10);
+        test_queries(t, queries, 100);
+    }
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t queries_count = 100000;
+
+    std::vector<B> values;
+    std::vector<P> queries;
+    {
+        boost::mt19937 rng;
+        float max_val = static_cast<float>(values_count / 2);
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            float x = rnd(), y = rnd();
+            values.push_back(B(P(x - 0.5f, y - 0.5f), P(x + 0.5f, y + 0.5f)));
+        }
+        for ( size_t i = 0 ; i < queries_count ; ++i )
+            queries.push_back(P(rnd(), rnd()));
+    }
+
+    test_rtree< bgi::rtree<B, bgi::linear<4, 2> > >(values, queries, "linear<4, 2>");
+    test_rtree< bgi::rtree<B, bgi::linear<16, 4> > >(values, queries, "linear<16, 4>");
+    test_rtree< bgi::rtree<B, bgi::rstar<8, 3> > >(values, queries, "rstar<8, 3>");
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the default packing algorithm with the Hilbert and Z-order curve
+// packing, build time, query time and the number of nodes visited by queries.
+
+#include <iostream>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef boost::chrono::thread_clock clock_type;
+typedef boost::chrono::duration<float> dur_t;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+typedef bgi::rtree<P, bgi::linear<16, 4> > RT;
+
+// Counts the nodes which would be visited by the spatial query
+template <typename Value, typename Options, typename Box, typename Allocators>
+struct nodes_visited
+    : public bgi::detail::rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+{
+    typedef typename bgi::detail::rtree::internal_node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename bgi::detail::rtree::leaf<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    explicit nodes_visited(Box const& b) : box(b), count(0) {}
+
+    inline void operator()(internal_node const& n)
+    {
+        typedef typename bgi::detail::rtree::elements_type<internal_node>::type elements_type;
+        elements_type const& elements = bgi::detail::rtree::elements(n);
+
+        ++count;
+
+        for (typename elements_type::const_iterator it = elements.begin();
+            it != elements.end(); ++it)
+        {
+            if ( bg::intersects(it->first, box) )
+                bgi::detail::rtree::apply_visitor(*this, *it->second);
+        }
+    }
+
+    inline void operator()(leaf const& )
+    {
+        ++count;
+    }
+
+    Box box;
+    size_t count;
+};
+
+template <typename Rtree>
+size_t count_nodes_visited(Rtree const& t, B const& b)
+{
+    typedef bgi::detail::rtree::utilities::view<Rtree> RTV;
+    RTV rtv(t);
+    nodes_visited<
+        typename RTV::value_type,
+        typename RTV::options_type,
+        typename RTV::box_type,
+        typename RTV::allocators_type
+    > v(b);
+    rtv.apply_visitor(v);
+    return v.count;
+}
+
+template <typename Packing>
+void test_rtree(std::vector<P> const& values, std::vector<B> const& queries,
+                Packing const& packing, const char * name)
+{
+    clock_type::time_point start = clock_type::now();
+    RT t(values, packing);
+    dur_t time = clock_type::now() - start;
+    std::cout << name << " - pack " << values.size() << " : " << time << '\n';
+
+    std::vector<P> result;
+    result.reserve(100);
+
+    start = clock_type::now();
+    size_t temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        result.clear();
+        t.query(bgi::intersects(queries[i]), std::back_inserter(result));
+        temp += result.size();
+    }
+    time = clock_type::now() - start;
+    std::cout << name << " - query(B) " << queries.size() << " found " << temp << " : " << time << '\n';
+
+    size_t visited = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+        visited += count_nodes_visited(t, queries[i]);
+    std::cout << name << " - query(B) nodes visited per query : "
+              << static_cast<double>(visited) / queries.size() << '\n';
+
+    start = clock_type::now();
+    temp = 0;
+    for ( size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        result.clear();
+        t.query(bgi::nearest(queries[i].min_corner(), 5), std::back_inserter(result));
+        temp += result.size();
+    }
+    time = clock_type::now() - start;
+    std::cout << name << " - query(nearest(P, 5)) " << queries.size() << " found " << temp << " : " << time << '\n';
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t queries_count = 100000;
+
+    std::vector<P> values;
+    std::vector<B> queries;
+
+    //randomize values
+    {
+        boost::mt19937 rng;
+        //rng.seed(static_cast<unsigned int>(std::time(0)));
+        double max_val = static_cast<double>(values_count / 10);
+        boost::uniform_real<double> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<double> > rnd(rng, range);
+
+        std::cout << "randomizing data\n";
+        values.reserve(values_count);
+        for ( size_t i = 0 ; i < values_count ; ++i )
+            values.push_back(P(rnd(), rnd()));
+
+        queries.reserve(queries_count);
+        for ( size_t i = 0 ; i < queries_count ; ++i )
+        {
+            double x = rnd();
+            double y = rnd();
+            queries.push_back(B(P(x - 10, y - 10), P(x + 10, y + 10)));
+        }
+        std::cout << "randomized\n";
+    }
+
+    // the parameters object is passed, the default packing algorithm is used
+    test_rtree(values, queries, bgi::linear<16, 4>(), "default");
+    test_rtree(values, queries, bgi::hilbert_packing(), "hilbert");
+    test_rtree(values, queries, bgi::morton_packing(), "morton");
+
+    return 0;
+}
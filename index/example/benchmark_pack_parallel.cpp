@@ -0,0 +1,83 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compile with OpenMP support enabled, otherwise the parallel packing
+// is performed by one thread.
+
+#include <iostream>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+int main()
+{
+    namespace bg = boost::geometry;
+    namespace bgi = bg::index;
+    // wall clock, thread_clock would measure the time of the calling thread only
+    typedef boost::chrono::steady_clock clock_t;
+    typedef boost::chrono::duration<float> dur_t;
+
+    size_t values_count = 5000000;
+    size_t max_threads = bg::detail::parallel::max_threads();
+
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+    typedef bg::model::box<P> B;
+    typedef bgi::rtree<B, bgi::linear<16, 4> > RT;
+    //typedef bgi::rtree<B, bgi::quadratic<8, 3> > RT;
+    //typedef bgi::rtree<B, bgi::rstar<8, 3> > RT;
+
+    std::vector<B> values;
+
+    //randomize values
+    {
+        boost::mt19937 rng;
+        //rng.seed(static_cast<unsigned int>(std::time(0)));
+        float max_val = static_cast<float>(values_count / 2);
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        values.reserve(values_count);
+
+        std::cout << "randomizing data\n";
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            float x = rnd();
+            float y = rnd();
+            values.push_back(B(P(x - 0.5f, y - 0.5f), P(x + 0.5f, y + 0.5f)));
+        }
+        std::cout << "randomized\n";
+    }
+
+    for (;;)
+    {
+        {
+            clock_t::time_point start = clock_t::now();
+            RT t(values.begin(), values.end());
+            dur_t time = clock_t::now() - start;
+            std::cout << time << " - pack " << values_count << " size " << t.size() << '\n';
+        }
+
+        for ( size_t threads = 1 ; threads <= max_threads ; threads *= 2 )
+        {
+            clock_t::time_point start = clock_t::now();
+            RT t(values.begin(), values.end(), bg::parallel(threads));
+            dur_t time = clock_t::now() - start;
+            std::cout << time << " - pack " << values_count << " threads " << threads << " size " << t.size() << '\n';
+        }
+
+        std::cout << "------------------------------------------------\n";
+    }
+
+    return 0;
+}
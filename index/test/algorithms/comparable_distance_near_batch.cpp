@@ -0,0 +1,115 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdlib>
+
+#include <geometry_index_test_common.hpp>
+
+#include <boost/geometry/index/detail/algorithms/comparable_distance_near_batch.hpp>
+
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/geometries/box.hpp>
+
+template <typename T>
+T random_coordinate()
+{
+    return static_cast<T>(std::rand() % 2001 - 1000) / T(8);
+}
+
+template <typename Point>
+Point random_point()
+{
+    typedef typename bg::coordinate_type<Point>::type coordinate_type;
+
+    // the third coordinate is ignored by the 2d points
+    coordinate_type const x = random_coordinate<coordinate_type>();
+    coordinate_type const y = random_coordinate<coordinate_type>();
+    coordinate_type const z = random_coordinate<coordinate_type>();
+    return Point(x, y, z);
+}
+
+// the distances should be equal to the ones calculated by comparable_distance()
+// for any number of boxes, including the ones not filling the SIMD registers
+template <typename Point, typename Box>
+void test_batch(std::size_t count)
+{
+    typedef bgi::detail::comparable_distance_near_batch<Point, Box> batch_type;
+    typedef typename batch_type::result_type result_type;
+
+    Point const pt = random_point<Point>();
+    batch_type batch(pt);
+
+    std::vector<Box> boxes;
+    for ( std::size_t i = 0 ; i < count ; ++i )
+    {
+        Point p1 = random_point<Point>();
+        Point p2 = random_point<Point>();
+        Box b;
+        bg::assign_inverse(b);
+        bg::expand(b, p1);
+        bg::expand(b, p2);
+        boxes.push_back(b);
+        batch.push_back(b);
+    }
+
+    // boxes containing the point
+    if ( 1 < count )
+    {
+        boxes[1] = Box(pt, pt);
+        batch.clear();
+        for ( std::size_t i = 0 ; i < count ; ++i )
+            batch.push_back(boxes[i]);
+    }
+
+    BOOST_CHECK_EQUAL(batch.size(), count);
+
+    batch.apply();
+
+    for ( std::size_t i = 0 ; i < count ; ++i )
+    {
+        result_type const expected = bg::comparable_distance(pt, boxes[i]);
+        BOOST_CHECK_EQUAL(batch[i], expected);
+    }
+}
+
+template <typename Point>
+void test_point()
+{
+    typedef bg::model::box<Point> box_type;
+
+    BOOST_STATIC_ASSERT((bgi::detail::is_comparable_distance_near_batchable<Point, box_type>::value));
+
+    for ( std::size_t count = 1 ; count <= bgi::detail::near_batch::max_count ; ++count )
+        for ( int i = 0 ; i < 10 ; ++i )
+            test_batch<Point, box_type>(count);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<int, 2, bg::cs::cartesian> P2ic;
+    typedef bg::model::point<float, 2, bg::cs::cartesian> P2fc;
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2dc;
+
+    typedef bg::model::point<float, 3, bg::cs::cartesian> P3fc;
+    typedef bg::model::point<double, 3, bg::cs::cartesian> P3dc;
+
+    typedef bg::model::point<double, 2, bg::cs::geographic<bg::degree> > P2dg;
+
+    test_point<P2fc>();
+    test_point<P2dc>();
+    test_point<P3fc>();
+    test_point<P3dc>();
+
+    // the distances between integer coordinates are calculated exactly
+    // and the ones of other coordinate systems by different strategies
+    BOOST_STATIC_ASSERT((! bgi::detail::is_comparable_distance_near_batchable<P2ic, bg::model::box<P2ic> >::value));
+    BOOST_STATIC_ASSERT((! bgi::detail::is_comparable_distance_near_batchable<P2dg, bg::model::box<P2dg> >::value));
+
+    return 0;
+}
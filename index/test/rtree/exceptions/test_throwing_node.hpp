@@ -35,6 +35,9 @@ struct quadratic_throwing : public quadratic<MaxElements, MinElements> {};
 template <size_t MaxElements, size_t MinElements, size_t OverlapCostThreshold = 0, size_t ReinsertedElements = detail::default_rstar_reinserted_elements_s<MaxElements>::value>
 struct rstar_throwing : public rstar<MaxElements, MinElements, OverlapCostThreshold, ReinsertedElements> {};
 
+template <size_t MaxElements, size_t MinElements>
+struct kmeans_throwing : public kmeans<MaxElements, MinElements> {};
+
 namespace detail { namespace rtree {
 
 // options implementation (from options.hpp)
@@ -71,6 +74,16 @@ struct options_type< rstar_throwing<MaxElements, MinElements, OverlapCostThresho
     > type;
 };
 
+template <size_t MaxElements, size_t MinElements>
+struct options_type< kmeans_throwing<MaxElements, MinElements> >
+{
+    typedef options<
+        kmeans_throwing<MaxElements, MinElements>,
+        insert_default_tag, choose_by_content_diff_tag, split_default_tag, kmeans_tag,
+        node_throwing_static_tag
+    > type;
+};
+
 }} // namespace detail::rtree
 
 // node implementation
@@ -0,0 +1,128 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <vector>
+
+#include <rtree/test_rtree.hpp>
+
+// The neighbors found by the batch query must be at the same distances
+// as the ones found by the separate queries.
+template <typename Rtree, typename Point, typename Results, typename Counts>
+void check_results(Rtree const& tree, std::vector<Point> const& queries, std::size_t k,
+                   Results const& results, Counts const& counts)
+{
+    typedef typename Rtree::value_type value_t;
+
+    bgi::indexable<value_t> getter;
+
+    for ( std::size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        std::vector<value_t> expected;
+        tree.query(bgi::nearest(queries[i], static_cast<unsigned>(k)), std::back_inserter(expected));
+
+        BOOST_CHECK_EQUAL(expected.size(), counts[i]);
+        if ( expected.size() != counts[i] )
+            continue;
+
+        std::vector<double> expected_dist, dist;
+        for ( std::size_t j = 0 ; j < expected.size() ; ++j )
+        {
+            expected_dist.push_back(bg::comparable_distance(queries[i], getter(expected[j])));
+            dist.push_back(bg::comparable_distance(queries[i], getter(results[i * k + j])));
+        }
+        std::sort(expected_dist.begin(), expected_dist.end());
+        std::sort(dist.begin(), dist.end());
+
+        BOOST_CHECK(expected_dist == dist);
+    }
+}
+
+template <typename Rtree>
+void test_batch(Rtree const& tree, std::size_t k)
+{
+    typedef typename Rtree::value_type value_t;
+    typedef typename Rtree::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    std::vector<point_t> queries;
+    for ( std::size_t i = 0 ; i < 3000 ; ++i )
+    {
+        double x = static_cast<double>((i * 3571) % 1103) - 50;
+        double y = static_cast<double>((i * 6007) % 1051) - 50;
+        queries.push_back(point_t(x, y));
+    }
+
+    std::size_t expected_total = 0;
+    for ( std::size_t i = 0 ; i < queries.size() ; ++i )
+        expected_total += (std::min)(k, tree.size());
+
+    {
+        std::vector<value_t> results(queries.size() * k);
+        std::vector<std::size_t> counts(queries.size(), 1000);
+        std::size_t total = tree.batch_nearest(queries, k, results.begin(), counts.begin());
+        BOOST_CHECK_EQUAL(total, expected_total);
+        check_results(tree, queries, k, results, counts);
+    }
+
+    {
+        std::vector<value_t> results(queries.size() * k);
+        std::vector<std::size_t> counts(queries.size(), 1000);
+        std::size_t total = bgi::batch_nearest(tree, queries, k, results.begin(), counts.begin(), bg::parallel(4));
+        BOOST_CHECK_EQUAL(total, expected_total);
+        check_results(tree, queries, k, results, counts);
+    }
+
+    // no queries
+    {
+        std::vector<point_t> no_queries;
+        std::vector<value_t> results;
+        std::vector<std::size_t> counts;
+        BOOST_CHECK_EQUAL(tree.batch_nearest(no_queries, k, results.begin(), counts.begin()), 0u);
+    }
+}
+
+template <typename Params>
+void test_rtree(std::size_t vcount, Params const& params = Params())
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+    typedef std::pair<box_t, std::size_t> box_value_t;
+    typedef std::pair<point_t, std::size_t> point_value_t;
+
+    std::vector<box_value_t> boxes;
+    std::vector<point_value_t> points;
+    for ( std::size_t i = 0 ; i < vcount ; ++i )
+    {
+        double x = static_cast<double>((i * 7919) % 1009);
+        double y = static_cast<double>((i * 104729) % 997);
+        boxes.push_back(std::make_pair(box_t(point_t(x, y), point_t(x + 2.5, y + 1.5)), i));
+        points.push_back(std::make_pair(point_t(x, y), i));
+    }
+
+    bgi::rtree<point_value_t, Params> packed_points(points, params);
+    test_batch(packed_points, 1);
+    test_batch(packed_points, 10);
+
+    bgi::rtree<box_value_t, Params> inserted_boxes(params);
+    inserted_boxes.insert(boxes);
+    test_batch(inserted_boxes, 5);
+}
+
+int test_main(int, char* [])
+{
+    test_rtree< bgi::linear<16, 4> >(0);
+    test_rtree< bgi::linear<16, 4> >(3);
+    test_rtree< bgi::linear<16, 4> >(5000);
+    test_rtree< bgi::quadratic<4, 2> >(2000);
+    test_rtree< bgi::rstar<8, 3> >(2000);
+    test_rtree(2000, bgi::dynamic_rstar(5, 2));
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <rtree/test_rtree.hpp>
+
+#include <boost/geometry/index/flat_rtree.hpp>
+
+template <typename Value>
+std::vector<std::size_t> sorted_ids(std::vector<Value> const& values)
+{
+    std::vector<std::size_t> result;
+    for ( std::size_t i = 0 ; i < values.size() ; ++i )
+        result.push_back(values[i].second);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template <typename Rtree, typename FlatRtree, typename Predicates>
+void check_query(Rtree const& tree, FlatRtree const& flat, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected_result, result;
+    std::size_t expected_count = tree.query(pred, std::back_inserter(expected_result));
+    std::size_t count = flat.query(pred, std::back_inserter(result));
+
+    BOOST_CHECK_EQUAL(expected_count, count);
+    BOOST_CHECK(sorted_ids(expected_result) == sorted_ids(result));
+}
+
+// The R-tree and the flat R-tree have the same nodes so the Values are
+// returned in the same order, the nearest ones sorted by distances
+template <typename Rtree, typename FlatRtree, typename Predicates>
+void check_qbegin(Rtree const& tree, FlatRtree const& flat, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected_result(tree.qbegin(pred), tree.qend());
+    std::vector<value_t> result;
+    for ( typename FlatRtree::const_query_iterator it = flat.qbegin(pred) ; it != flat.qend() ; ++it )
+        result.push_back(*it);
+
+    BOOST_CHECK(expected_result.size() == result.size()
+             && std::equal(expected_result.begin(), expected_result.end(), result.begin(), bgi::equal_to<value_t>()));
+    BOOST_CHECK(std::distance(bgi::qbegin(flat, pred), bgi::qend(flat)) == static_cast<std::ptrdiff_t>(result.size()));
+}
+
+struct id_is_odd
+{
+    template <typename Value>
+    bool operator()(Value const& v) const
+    {
+        return v.second % 2 == 1;
+    }
+};
+
+template <typename Rtree>
+void test_flat(Rtree const& tree)
+{
+    typedef typename Rtree::value_type value_t;
+    typedef typename Rtree::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+    typedef bgi::flat_rtree<
+        value_t,
+        typename Rtree::parameters_type,
+        typename Rtree::indexable_getter,
+        typename Rtree::value_equal,
+        typename Rtree::allocator_type
+    > flat_t;
+
+    flat_t flat = bgi::freeze(tree);
+
+    BOOST_CHECK_EQUAL(flat.size(), tree.size());
+    BOOST_CHECK_EQUAL(flat.empty(), tree.empty());
+    BOOST_CHECK_EQUAL(flat.depth(), bgi::detail::rtree::utilities::view<Rtree>(tree).depth());
+    BOOST_CHECK(bg::equals(flat.bounds(), tree.bounds()) || tree.empty());
+
+    // the values are stored in the order of leafs
+    BOOST_CHECK(std::equal(tree.begin(), tree.end(), flat.begin(), bgi::equal_to<value_t>()));
+
+    box_t qbox(point_t(100, 100), point_t(200, 300));
+    point_t qpt(500, 500);
+
+    check_query(tree, flat, bgi::intersects(qbox));
+    check_query(tree, flat, bgi::within(qbox));
+    check_query(tree, flat, !bgi::intersects(qbox));
+    check_query(tree, flat, bgi::intersects(qbox) && bgi::satisfies(id_is_odd()));
+    check_query(tree, flat, bgi::nearest(qpt, 1));
+    check_query(tree, flat, bgi::nearest(qpt, 10));
+    check_query(tree, flat, bgi::nearest(qpt, 1000));
+    check_query(tree, flat, bgi::nearest(qpt, 10) && bgi::satisfies(id_is_odd()));
+    check_query(tree, flat, bgi::nearest(qbox, 10) && !bgi::intersects(qbox));
+
+    check_qbegin(tree, flat, bgi::intersects(qbox));
+    check_qbegin(tree, flat, !bgi::intersects(qbox));
+    check_qbegin(tree, flat, bgi::nearest(qpt, 1));
+    check_qbegin(tree, flat, bgi::nearest(qpt, 10));
+    check_qbegin(tree, flat, bgi::nearest(qpt, 1000));
+    check_qbegin(tree, flat, bgi::nearest(qbox, 10) && !bgi::intersects(qbox));
+
+    flat_t flat2(tree.parameters());
+    BOOST_CHECK(flat2.empty());
+    flat2.swap(flat);
+    BOOST_CHECK(flat.empty());
+    BOOST_CHECK_EQUAL(flat2.size(), tree.size());
+    check_query(tree, flat2, bgi::intersects(qbox));
+
+    std::vector<value_t> result;
+    BOOST_CHECK_EQUAL(flat.query(bgi::intersects(qbox), std::back_inserter(result)), 0u);
+    BOOST_CHECK_EQUAL(flat.query(bgi::nearest(qpt, 5), std::back_inserter(result)), 0u);
+    BOOST_CHECK(flat.qbegin(bgi::intersects(qbox)) == flat.qend());
+    BOOST_CHECK(flat.qbegin(bgi::nearest(qpt, 5)) == flat.qend());
+}
+
+template <typename Params>
+void test_rtree(std::size_t vcount, Params const& params = Params())
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+    typedef std::pair<box_t, std::size_t> box_value_t;
+    typedef std::pair<point_t, std::size_t> point_value_t;
+
+    std::vector<box_value_t> boxes;
+    std::vector<point_value_t> points;
+    for ( std::size_t i = 0 ; i < vcount ; ++i )
+    {
+        double x = static_cast<double>((i * 7919) % 1009);
+        double y = static_cast<double>((i * 104729) % 997);
+        boxes.push_back(std::make_pair(box_t(point_t(x, y), point_t(x + 2.5, y + 1.5)), i));
+        points.push_back(std::make_pair(point_t(x, y), i));
+    }
+
+    // packed
+    bgi::rtree<box_value_t, Params> packed_boxes(boxes, params);
+    test_flat(packed_boxes);
+    bgi::rtree<point_value_t, Params> packed_points(points, params);
+    test_flat(packed_points);
+
+    // inserted
+    bgi::rtree<box_value_t, Params> inserted_boxes(params);
+    inserted_boxes.insert(boxes);
+    test_flat(inserted_boxes);
+
+    // created directly
+    bgi::flat_rtree<point_value_t, Params> flat(points, params);
+    check_query(packed_points, flat, bgi::nearest(point_t(0, 0), 7));
+    BOOST_CHECK_EQUAL(flat.size(), points.size());
+}
+
+int test_main(int, char* [])
+{
+    test_rtree< bgi::linear<16, 4> >(0);
+    test_rtree< bgi::linear<16, 4> >(1);
+    test_rtree< bgi::linear<16, 4> >(16);
+    test_rtree< bgi::linear<16, 4> >(5000);
+    test_rtree< bgi::quadratic<4, 2> >(3000);
+    test_rtree< bgi::rstar<8, 3> >(3000);
+    test_rtree(3000, bgi::dynamic_rstar(5, 2));
+
+    return 0;
+}
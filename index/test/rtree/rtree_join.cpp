@@ -0,0 +1,120 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <rtree/test_rtree.hpp>
+
+typedef std::pair<std::size_t, std::size_t> id_pair;
+
+template <typename Pairs>
+std::vector<id_pair> sorted_ids(Pairs const& pairs)
+{
+    std::vector<id_pair> result;
+    for ( std::size_t i = 0 ; i < pairs.size() ; ++i )
+        result.push_back(id_pair(pairs[i].first.second, pairs[i].second.second));
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// The pairs found by checking all of them
+template <typename Values1, typename Values2, typename Predicate>
+std::vector<id_pair> brute_force(Values1 const& values1, Values2 const& values2, Predicate const& pred)
+{
+    typedef bgi::detail::join_predicate_check<Predicate> check;
+
+    std::vector<id_pair> result;
+    for ( std::size_t i = 0 ; i < values1.size() ; ++i )
+        for ( std::size_t j = 0 ; j < values2.size() ; ++j )
+            if ( check::values(pred, values1[i].first, values2[j].first) )
+                result.push_back(id_pair(values1[i].second, values2[j].second));
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template <typename Rtree1, typename Rtree2, typename Values1, typename Values2, typename Predicate>
+void check_join(Rtree1 const& tree1, Rtree2 const& tree2,
+                Values1 const& values1, Values2 const& values2,
+                Predicate const& pred)
+{
+    typedef std::pair<typename Rtree1::value_type, typename Rtree2::value_type> pair_t;
+
+    std::vector<id_pair> expected = brute_force(values1, values2, pred);
+
+    std::vector<pair_t> result;
+    std::size_t count = tree1.join(tree2, pred, std::back_inserter(result));
+    BOOST_CHECK_EQUAL(count, result.size());
+    BOOST_CHECK(sorted_ids(result) == expected);
+
+    // the parallel version returns the pairs in the same order
+    std::vector<pair_t> result_p;
+    std::size_t count_p = bgi::join(tree1, tree2, pred, std::back_inserter(result_p), bg::parallel(4));
+    BOOST_CHECK_EQUAL(count_p, result_p.size());
+    BOOST_CHECK(sorted_ids(result_p) == expected);
+
+    bool same_order = result.size() == result_p.size();
+    for ( std::size_t i = 0 ; same_order && i < result.size() ; ++i )
+        same_order = result[i].first.second == result_p[i].first.second
+                  && result[i].second.second == result_p[i].second.second;
+    BOOST_CHECK(same_order);
+}
+
+template <typename Params1, typename Params2>
+void test_join(std::size_t count1, std::size_t count2,
+               Params1 const& params1 = Params1(), Params2 const& params2 = Params2())
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+    typedef std::pair<box_t, std::size_t> box_value_t;
+    typedef std::pair<point_t, std::size_t> point_value_t;
+
+    std::vector<box_value_t> boxes1, boxes2;
+    std::vector<point_value_t> points;
+    for ( std::size_t i = 0 ; i < count1 ; ++i )
+    {
+        double x = static_cast<double>((i * 7919) % 1009);
+        double y = static_cast<double>((i * 104729) % 997);
+        boxes1.push_back(std::make_pair(box_t(point_t(x, y), point_t(x + 4, y + 3)), i));
+        points.push_back(std::make_pair(point_t(x + 0.5, y + 0.5), i));
+    }
+    for ( std::size_t i = 0 ; i < count2 ; ++i )
+    {
+        double x = static_cast<double>((i * 6007) % 1013);
+        double y = static_cast<double>((i * 3571) % 991);
+        boxes2.push_back(std::make_pair(box_t(point_t(x, y), point_t(x + 7, y + 5)), i));
+    }
+
+    bgi::rtree<box_value_t, Params1> tree1(boxes1, params1);
+    bgi::rtree<point_value_t, Params1> points_tree(params1);
+    points_tree.insert(points);
+    bgi::rtree<box_value_t, Params2> tree2(params2);
+    tree2.insert(boxes2);
+
+    check_join(tree1, tree2, boxes1, boxes2, bgi::join_intersects());
+    check_join(tree2, tree1, boxes2, boxes1, bgi::join_intersects());
+    check_join(tree1, tree2, boxes1, boxes2, bgi::join_within());
+    check_join(points_tree, tree2, points, boxes2, bgi::join_within());
+    check_join(tree1, tree2, boxes1, boxes2, bgi::join_distance_within(10.0));
+    check_join(points_tree, tree1, points, boxes1, bgi::join_distance_within(3.0));
+}
+
+int test_main(int, char* [])
+{
+    test_join< bgi::linear<16, 4>, bgi::linear<16, 4> >(0, 100);
+    test_join< bgi::linear<16, 4>, bgi::linear<16, 4> >(100, 0);
+    test_join< bgi::linear<16, 4>, bgi::linear<16, 4> >(1, 3);
+    test_join< bgi::linear<16, 4>, bgi::quadratic<4, 2> >(5, 2000);
+    test_join< bgi::linear<16, 4>, bgi::quadratic<4, 2> >(2000, 3000);
+    test_join< bgi::rstar<8, 3>, bgi::linear<32, 8> >(3000, 2000);
+    test_join(1000, 1500, bgi::dynamic_quadratic(5, 2), bgi::rstar<4, 2>());
+
+    return 0;
+}
@@ -0,0 +1,318 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <rtree/test_rtree.hpp>
+
+#include <boost/geometry/index/mapped_rtree.hpp>
+
+// The data is copied into the buffer of doubles so it's aligned like Values
+struct buffer
+{
+    template <typename Tree>
+    explicit buffer(Tree const& tree)
+    {
+        std::ostringstream os(std::ios::binary);
+        bgi::write_mapped(os, tree);
+        assign(os.str());
+    }
+
+    void assign(std::string const& str)
+    {
+        size = str.size();
+        data.resize(size / sizeof(double) + 1);
+        std::memcpy(&data[0], str.data(), size);
+    }
+
+    const void * ptr() const { return &data[0]; }
+
+    std::vector<double> data;
+    std::size_t size;
+};
+
+template <typename Value>
+std::vector<std::size_t> sorted_ids(std::vector<Value> const& values)
+{
+    std::vector<std::size_t> result;
+    for ( std::size_t i = 0 ; i < values.size() ; ++i )
+        result.push_back(values[i].second);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template <typename Rtree, typename MappedRtree, typename Predicates>
+void check_query(Rtree const& tree, MappedRtree const& mapped, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected_result, result;
+    std::size_t expected_count = tree.query(pred, std::back_inserter(expected_result));
+    std::size_t count = mapped.query(pred, std::back_inserter(result));
+
+    BOOST_CHECK_EQUAL(expected_count, count);
+    BOOST_CHECK(sorted_ids(expected_result) == sorted_ids(result));
+}
+
+// The R-tree and the mapped R-tree have the same nodes so the Values are
+// returned in the same order, the nearest ones sorted by distances
+template <typename Rtree, typename MappedRtree, typename Predicates>
+void check_qbegin(Rtree const& tree, MappedRtree const& mapped, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected_result(tree.qbegin(pred), tree.qend());
+    std::vector<value_t> result;
+    for ( typename MappedRtree::const_query_iterator it = mapped.qbegin(pred) ; it != mapped.qend() ; ++it )
+        result.push_back(*it);
+
+    BOOST_CHECK(expected_result.size() == result.size()
+             && std::equal(expected_result.begin(), expected_result.end(), result.begin(), bgi::equal_to<value_t>()));
+    BOOST_CHECK(std::distance(bgi::qbegin(mapped, pred), bgi::qend(mapped)) == static_cast<std::ptrdiff_t>(result.size()));
+}
+
+template <typename MappedRtree>
+bool opening_throws(buffer const& buf, std::size_t size)
+{
+    try
+    {
+        MappedRtree mapped(buf.ptr(), size);
+    }
+    catch (std::runtime_error const&)
+    {
+        return true;
+    }
+    return false;
+}
+
+// Modifies one member of the header, the data must not be opened
+template <typename MappedRtree, typename Member, typename T>
+void check_corrupted_header(buffer const& buf,
+                            Member bgi::detail::rtree::flat::mapped::file_header::* member,
+                            T value)
+{
+    bgi::detail::rtree::flat::mapped::file_header h;
+    std::memcpy(&h, buf.ptr(), sizeof(h));
+    if ( h.*member == static_cast<Member>(value) )
+        return;
+    h.*member = static_cast<Member>(value);
+
+    buffer corrupted(buf);
+    std::memcpy(&corrupted.data[0], &h, sizeof(h));
+    BOOST_CHECK(opening_throws<MappedRtree>(corrupted, corrupted.size));
+}
+
+// Modifies the children of one node, the data must not be opened
+template <typename MappedRtree, typename Box>
+void check_corrupted_node(buffer const& buf, boost::uint64_t index,
+                          boost::uint32_t first, boost::uint32_t count)
+{
+    typedef bgi::detail::rtree::flat::node<Box, boost::uint32_t> node_t;
+
+    bgi::detail::rtree::flat::mapped::file_header h;
+    std::memcpy(&h, buf.ptr(), sizeof(h));
+    if ( h.nodes_count <= index )
+        return;
+
+    buffer corrupted(buf);
+    char * ptr = reinterpret_cast<char*>(&corrupted.data[0])
+               + h.nodes_offset + index * sizeof(node_t);
+    node_t n;
+    std::memcpy(&n, ptr, sizeof(n));
+    n.first = first;
+    n.count = count;
+    std::memcpy(ptr, &n, sizeof(n));
+    BOOST_CHECK(opening_throws<MappedRtree>(corrupted, corrupted.size));
+}
+
+template <typename Rtree>
+void test_mapped(Rtree const& tree)
+{
+    typedef typename Rtree::value_type value_t;
+    typedef typename Rtree::parameters_type params_t;
+    typedef typename Rtree::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+    typedef bgi::mapped_rtree<value_t, params_t> mapped_t;
+    typedef bgi::detail::rtree::flat::mapped::file_header header_t;
+
+    buffer buf(tree);
+    mapped_t mapped(buf.ptr(), buf.size);
+
+    BOOST_CHECK_EQUAL(mapped.size(), tree.size());
+    BOOST_CHECK_EQUAL(mapped.empty(), tree.empty());
+    BOOST_CHECK_EQUAL(mapped.depth(), bgi::detail::rtree::utilities::view<Rtree>(tree).depth());
+    BOOST_CHECK(bg::equals(mapped.bounds(), tree.bounds()) || tree.empty());
+    BOOST_CHECK_EQUAL(mapped.parameters().get_max_elements(), tree.parameters().get_max_elements());
+    BOOST_CHECK_EQUAL(mapped.parameters().get_min_elements(), tree.parameters().get_min_elements());
+
+    // the values are stored in the order of leafs
+    BOOST_CHECK(std::equal(tree.begin(), tree.end(), mapped.begin(), bgi::equal_to<value_t>()));
+
+    box_t qbox(point_t(100, 100), point_t(200, 300));
+    point_t qpt(500, 500);
+
+    check_query(tree, mapped, bgi::intersects(qbox));
+    check_query(tree, mapped, bgi::within(qbox));
+    check_query(tree, mapped, !bgi::intersects(qbox));
+    check_query(tree, mapped, bgi::nearest(qpt, 1));
+    check_query(tree, mapped, bgi::nearest(qpt, 10));
+    check_query(tree, mapped, bgi::nearest(qpt, 1000));
+    check_query(tree, mapped, bgi::nearest(qbox, 10) && !bgi::intersects(qbox));
+
+    check_qbegin(tree, mapped, bgi::intersects(qbox));
+    check_qbegin(tree, mapped, !bgi::intersects(qbox));
+    check_qbegin(tree, mapped, bgi::nearest(qpt, 1));
+    check_qbegin(tree, mapped, bgi::nearest(qpt, 10));
+    check_qbegin(tree, mapped, bgi::nearest(qpt, 1000));
+    check_qbegin(tree, mapped, bgi::nearest(qbox, 10) && !bgi::intersects(qbox));
+
+    // invalid data
+    BOOST_CHECK(opening_throws<mapped_t>(buf, 0));
+    BOOST_CHECK(opening_throws<mapped_t>(buf, buf.size - 1) || tree.empty());
+
+    buffer corrupted(buf);
+    reinterpret_cast<char*>(&corrupted.data[0])[0] = 'X';
+    BOOST_CHECK(opening_throws<mapped_t>(corrupted, corrupted.size));
+
+    corrupted = buf;
+    header_t h;
+    std::memcpy(&h, buf.ptr(), sizeof(h));
+    ++h.version;
+    std::memcpy(&corrupted.data[0], &h, sizeof(h));
+    BOOST_CHECK(opening_throws<mapped_t>(corrupted, corrupted.size));
+
+    // counts, levels and parameters inconsistent with the data
+    check_corrupted_header<mapped_t>(buf, &header_t::nodes_count, 0xFFFFFFFFFFFFFFFFull / sizeof(h));
+    check_corrupted_header<mapped_t>(buf, &header_t::values_count, 0xFFFFFFFFFFFFFFFFull);
+    check_corrupted_header<mapped_t>(buf, &header_t::leafs_begin, h.nodes_count);
+    check_corrupted_header<mapped_t>(buf, &header_t::leafs_level, 0xFFFFFFFFu);
+    check_corrupted_header<mapped_t>(buf, &header_t::leafs_level, h.leafs_begin + 1);
+    check_corrupted_header<mapped_t>(buf, &header_t::max_elements, h.min_elements);
+    check_corrupted_header<mapped_t>(buf, &header_t::min_elements, 0u);
+    check_corrupted_header<mapped_t>(buf, &header_t::algorithm, 0xFFu);
+
+    // children of nodes outside the arrays or not stored after the parent
+    if ( 0 < h.leafs_begin )
+    {
+        check_corrupted_node<mapped_t, box_t>(buf, 0, 0, 1);
+        check_corrupted_node<mapped_t, box_t>(buf, 0, 1, static_cast<boost::uint32_t>(h.nodes_count));
+    }
+    check_corrupted_node<mapped_t, box_t>(buf, h.nodes_count - 1, 0, static_cast<boost::uint32_t>(h.values_count + 1));
+    check_corrupted_node<mapped_t, box_t>(buf, h.nodes_count - 1, 0xFFFFFFFFu, 1);
+
+    // different types of Values
+    typedef std::pair<box_t, std::pair<std::size_t, std::size_t> > other_value_t;
+    typedef bgi::mapped_rtree<other_value_t, params_t> other_mapped_t;
+    BOOST_CHECK(opening_throws<other_mapped_t>(buf, buf.size));
+}
+
+template <typename Params>
+void test_rtree(std::size_t vcount, Params const& params = Params())
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+    typedef std::pair<box_t, std::size_t> box_value_t;
+    typedef std::pair<point_t, std::size_t> point_value_t;
+
+    std::vector<box_value_t> boxes;
+    std::vector<point_value_t> points;
+    for ( std::size_t i = 0 ; i < vcount ; ++i )
+    {
+        double x = static_cast<double>((i * 7919) % 1009);
+        double y = static_cast<double>((i * 104729) % 997);
+        boxes.push_back(std::make_pair(box_t(point_t(x, y), point_t(x + 2.5, y + 1.5)), i));
+        points.push_back(std::make_pair(point_t(x, y), i));
+    }
+
+    bgi::rtree<box_value_t, Params> packed_boxes(boxes, params);
+    test_mapped(packed_boxes);
+    bgi::rtree<point_value_t, Params> packed_points(points, params);
+    test_mapped(packed_points);
+
+    bgi::rtree<box_value_t, Params> inserted_boxes(params);
+    inserted_boxes.insert(boxes);
+    test_mapped(inserted_boxes);
+
+    // written from the flat R-tree
+    bgi::flat_rtree<point_value_t, Params> flat(points, params);
+    buffer buf(flat);
+    bgi::mapped_rtree<point_value_t, Params> mapped(buf.ptr(), buf.size);
+    check_query(packed_points, mapped, bgi::nearest(point_t(0, 0), 7));
+}
+
+void test_parameters()
+{
+    typedef bg::model::point<float, 2, bg::cs::cartesian> point_t;
+    typedef std::pair<point_t, std::size_t> value_t;
+
+    std::vector<value_t> values;
+    for ( std::size_t i = 0 ; i < 100 ; ++i )
+        values.push_back(std::make_pair(point_t(float(i % 10), float(i / 10)), i));
+
+    bgi::rtree<value_t, bgi::rstar<8, 3> > tree(values);
+    buffer buf(tree);
+
+    // the same compile-time parameters
+    bgi::mapped_rtree<value_t, bgi::rstar<8, 3> > mapped(buf.ptr(), buf.size);
+    BOOST_CHECK_EQUAL(mapped.size(), values.size());
+
+    // the run-time parameters are read from the data
+    bgi::mapped_rtree<value_t, bgi::dynamic_rstar> mapped_d(buf.ptr(), buf.size);
+    BOOST_CHECK_EQUAL(mapped_d.parameters().get_max_elements(), 8u);
+    BOOST_CHECK_EQUAL(mapped_d.parameters().get_min_elements(), 3u);
+    BOOST_CHECK_EQUAL(mapped_d.parameters().get_reinserted_elements(),
+                      tree.parameters().get_reinserted_elements());
+    check_query(tree, mapped_d, bgi::nearest(point_t(5, 5), 5));
+
+    // the greatest max elements, the memory reserved by the query is limited by the nodes
+    {
+        buffer big(buf);
+        bgi::detail::rtree::flat::mapped::file_header h;
+        std::memcpy(&h, buf.ptr(), sizeof(h));
+        h.max_elements = 0xFFFFFFFFu;
+        std::memcpy(&big.data[0], &h, sizeof(h));
+        bgi::mapped_rtree<value_t, bgi::dynamic_rstar> mapped_big(big.ptr(), big.size);
+        check_query(tree, mapped_big, bgi::nearest(point_t(5, 5), 5));
+    }
+
+    // different parameters or algorithm
+    typedef bgi::mapped_rtree<value_t, bgi::rstar<16, 3> > mapped_rstar_t;
+    typedef bgi::mapped_rtree<value_t, bgi::linear<8, 3> > mapped_linear_t;
+    typedef bgi::mapped_rtree<value_t, bgi::dynamic_quadratic> mapped_quadratic_t;
+    BOOST_CHECK(opening_throws<mapped_rstar_t>(buf, buf.size));
+    BOOST_CHECK(opening_throws<mapped_linear_t>(buf, buf.size));
+    BOOST_CHECK(opening_throws<mapped_quadratic_t>(buf, buf.size));
+
+    // different coordinate type
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_d_t;
+    typedef bgi::mapped_rtree<std::pair<point_d_t, std::size_t>, bgi::rstar<8, 3> > mapped_double_t;
+    BOOST_CHECK(opening_throws<mapped_double_t>(buf, buf.size));
+}
+
+int test_main(int, char* [])
+{
+    test_rtree< bgi::linear<16, 4> >(0);
+    test_rtree< bgi::linear<16, 4> >(1);
+    test_rtree< bgi::linear<16, 4> >(5000);
+    test_rtree< bgi::quadratic<4, 2> >(3000);
+    test_rtree< bgi::rstar<8, 3> >(3000);
+    test_rtree< bgi::kmeans<16, 4> >(3000);
+    test_rtree(3000, bgi::dynamic_linear(5, 2));
+
+    test_parameters();
+
+    return 0;
+}
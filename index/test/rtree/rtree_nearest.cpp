@@ -0,0 +1,143 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <vector>
+
+#include <rtree/test_rtree.hpp>
+
+// The distances of the k closest values meeting the predicate, found by checking all of them
+template <typename Value, typename Point, typename Box>
+std::vector<double> brute_force(std::vector<Value> const& values, Point const& pt, std::size_t k,
+                                Box const* excluded)
+{
+    bgi::indexable<Value> getter;
+
+    std::vector<double> result;
+    for ( std::size_t i = 0 ; i < values.size() ; ++i )
+    {
+        if ( excluded && bg::intersects(getter(values[i]), *excluded) )
+            continue;
+        result.push_back(bg::comparable_distance(pt, getter(values[i])));
+    }
+
+    std::sort(result.begin(), result.end());
+    if ( k < result.size() )
+        result.resize(k);
+    return result;
+}
+
+template <typename Value, typename Point>
+std::vector<double> distances(std::vector<Value> const& values, Point const& pt)
+{
+    bgi::indexable<Value> getter;
+
+    std::vector<double> result;
+    for ( std::size_t i = 0 ; i < values.size() ; ++i )
+        result.push_back(bg::comparable_distance(pt, getter(values[i])));
+    return result;
+}
+
+template <typename Rtree, typename Predicates, typename Point>
+void check_nearest(Rtree const& tree, Predicates const& pred, Point const& pt,
+                   std::vector<double> const& expected)
+{
+    typedef typename Rtree::value_type value_t;
+
+    // query() returns the neighbors in no particular order
+    std::vector<value_t> found;
+    tree.query(pred, std::back_inserter(found));
+    std::vector<double> dist = distances(found, pt);
+    std::sort(dist.begin(), dist.end());
+    BOOST_CHECK(dist == expected);
+
+    // the query iterators return the neighbors sorted by distance
+    std::vector<value_t> found_it;
+    std::copy(tree.qbegin(pred), tree.qend(), std::back_inserter(found_it));
+    std::vector<double> dist_it = distances(found_it, pt);
+    BOOST_CHECK(dist_it == expected);
+}
+
+template <typename Rtree, typename Values>
+void test_nearest(Rtree const& tree, Values const& values)
+{
+    typedef typename Rtree::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    std::size_t const ks[] = { 1, 2, 10, 100, values.size() + 1 };
+    box_t excluded(point_t(200, 200), point_t(600, 500));
+
+    for ( std::size_t i = 0 ; i < 20 ; ++i )
+    {
+        point_t pt(static_cast<double>((i * 3571) % 1203) - 100,
+                   static_cast<double>((i * 6007) % 1151) - 100);
+
+        for ( std::size_t j = 0 ; j < sizeof(ks) / sizeof(ks[0]) ; ++j )
+        {
+            unsigned k = static_cast<unsigned>(ks[j]);
+
+            std::vector<double> const expected
+                = brute_force(values, pt, k, static_cast<box_t const*>(0));
+            std::vector<double> const expected_excluded
+                = brute_force(values, pt, k, &excluded);
+
+            check_nearest(tree, bgi::nearest(pt, k), pt, expected);
+            check_nearest(tree, bgi::nearest(pt, k) && !bgi::intersects(excluded), pt,
+                          expected_excluded);
+
+            // both traversals with the same k
+            check_nearest(tree, bgi::nearest(pt, k, bgi::depth_first), pt, expected);
+            check_nearest(tree, bgi::nearest(pt, k, bgi::best_first), pt, expected);
+            check_nearest(tree, bgi::nearest(pt, k, bgi::depth_first) && !bgi::intersects(excluded), pt,
+                          expected_excluded);
+            check_nearest(tree, bgi::nearest(pt, k, bgi::best_first) && !bgi::intersects(excluded), pt,
+                          expected_excluded);
+        }
+    }
+}
+
+template <typename Params>
+void test_rtree(std::size_t vcount, Params const& params = Params())
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+    typedef std::pair<box_t, std::size_t> box_value_t;
+    typedef std::pair<point_t, std::size_t> point_value_t;
+
+    std::vector<box_value_t> boxes;
+    std::vector<point_value_t> points;
+    for ( std::size_t i = 0 ; i < vcount ; ++i )
+    {
+        double x = static_cast<double>((i * 7919) % 1009);
+        double y = static_cast<double>((i * 104729) % 997);
+        boxes.push_back(std::make_pair(box_t(point_t(x, y), point_t(x + 2.5, y + 1.5)), i));
+        points.push_back(std::make_pair(point_t(x, y), i));
+    }
+
+    bgi::rtree<point_value_t, Params> packed_points(points, params);
+    test_nearest(packed_points, points);
+
+    bgi::rtree<box_value_t, Params> inserted_boxes(params);
+    inserted_boxes.insert(boxes);
+    test_nearest(inserted_boxes, boxes);
+}
+
+int test_main(int, char* [])
+{
+    // the small nodes make the trees deep
+    test_rtree< bgi::linear<4, 2> >(0);
+    test_rtree< bgi::linear<4, 2> >(1);
+    test_rtree< bgi::linear<4, 2> >(2000);
+    test_rtree< bgi::quadratic<4, 2> >(2000);
+    test_rtree< bgi::rstar<4, 2> >(2000);
+    test_rtree< bgi::linear<32, 8> >(2000);
+    test_rtree(2000, bgi::dynamic_quadratic(4, 2));
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <vector>
+
+#include <rtree/test_rtree.hpp>
+
+#include <boost/geometry/index/detail/rtree/utilities/are_counts_ok.hpp>
+
+template <typename Point>
+struct curve_key_less
+{
+    typedef bg::model::box<Point> box_t;
+
+    curve_key_less(box_t const& b) : bounds(b) {}
+
+    bool operator()(Point const& p1, Point const& p2) const
+    {
+        return bgi::detail::hilbert_curve::apply(p1, bounds)
+             < bgi::detail::hilbert_curve::apply(p2, bounds);
+    }
+
+    box_t bounds;
+};
+
+// consecutive cells of the Hilbert curve are adjacent
+void test_hilbert_curve()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    std::vector<point_t> points;
+    for ( int x = 0 ; x < 16 ; ++x )
+        for ( int y = 0 ; y < 16 ; ++y )
+            points.push_back(point_t(x + 0.5, y + 0.5));
+
+    std::sort(points.begin(), points.end(), curve_key_less<point_t>(box_t(point_t(0, 0), point_t(16, 16))));
+
+    for ( std::size_t i = 1 ; i < points.size() ; ++i )
+    {
+        double d = bg::math::abs(bg::get<0>(points[i]) - bg::get<0>(points[i - 1]))
+                 + bg::math::abs(bg::get<1>(points[i]) - bg::get<1>(points[i - 1]));
+        BOOST_CHECK_EQUAL(d, 1.0);
+    }
+}
+
+void test_morton_curve()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    box_t bounds(point_t(0, 0), point_t(2, 2));
+    boost::uint64_t k00 = bgi::detail::morton_curve::apply(point_t(0.5, 0.5), bounds);
+    boost::uint64_t k01 = bgi::detail::morton_curve::apply(point_t(0.5, 1.5), bounds);
+    boost::uint64_t k10 = bgi::detail::morton_curve::apply(point_t(1.5, 0.5), bounds);
+    boost::uint64_t k11 = bgi::detail::morton_curve::apply(point_t(1.5, 1.5), bounds);
+
+    BOOST_CHECK(k00 < k01 && k01 < k10 && k10 < k11);
+}
+
+template <typename Rtree>
+void check_rtree(Rtree const& expected, Rtree const& rt, bool check_counts)
+{
+    if ( !rt.empty() )
+    {
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rt));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt));
+        if ( check_counts )
+        {
+            BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(rt));
+        }
+    }
+
+    BOOST_CHECK_EQUAL(rt.size(), expected.size());
+    BOOST_CHECK_EQUAL(bgi::detail::rtree::utilities::view<Rtree>(rt).depth(),
+                      bgi::detail::rtree::utilities::view<Rtree>(expected).depth());
+
+    typedef typename Rtree::value_type value_t;
+    typedef typename Rtree::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    box_t qbox(point_t(100, 100), point_t(200, 300));
+    std::vector<value_t> expected_result, result;
+    expected.query(bgi::intersects(qbox), std::back_inserter(expected_result));
+    rt.query(bgi::intersects(qbox), std::back_inserter(result));
+    BOOST_CHECK(expected_result.size() == result.size());
+
+    std::vector<std::size_t> expected_ids, ids;
+    for ( std::size_t i = 0 ; i < expected_result.size() ; ++i )
+        expected_ids.push_back(expected_result[i].second);
+    for ( std::size_t i = 0 ; i < result.size() ; ++i )
+        ids.push_back(result[i].second);
+    std::sort(expected_ids.begin(), expected_ids.end());
+    std::sort(ids.begin(), ids.end());
+    BOOST_CHECK(expected_ids == ids);
+}
+
+template <typename Point, typename Params>
+void test_rtree(std::size_t vcount, Params const& params = Params())
+{
+    typedef bg::model::box<Point> box_t;
+    typedef std::pair<box_t, std::size_t> value_t;
+    typedef bgi::rtree<value_t, Params> rtree_t;
+
+    std::vector<value_t> values;
+    values.reserve(vcount);
+    for ( std::size_t i = 0 ; i < vcount ; ++i )
+    {
+        Point pt;
+        bg::assign_zero(pt);
+        bg::set<0>(pt, static_cast<double>((i * 7919) % 1009));
+        bg::set<1>(pt, static_cast<double>((i * 104729) % 997));
+        if ( bg::dimension<Point>::value > 2 )
+            bg::set<bg::dimension<Point>::value - 1>(pt, static_cast<double>(i % 13));
+        Point pt2 = pt;
+        bg::add_value(pt2, 0.5);
+        values.push_back(std::make_pair(box_t(pt, pt2), i));
+    }
+
+    bool const check_counts = ! boost::is_same<Params, bgi::dynamic_rstar>::value;
+
+    rtree_t expected(values, params);
+
+    rtree_t rt1(values, bgi::hilbert_packing(), params);
+    check_rtree(expected, rt1, check_counts);
+    rtree_t rt2(values.begin(), values.end(), bgi::hilbert_packing(), params);
+    check_rtree(expected, rt2, check_counts);
+
+    rtree_t rt3(values, bgi::morton_packing(), params);
+    check_rtree(expected, rt3, check_counts);
+    rtree_t rt4(values.begin(), values.end(), bgi::morton_packing(), params);
+    check_rtree(expected, rt4, check_counts);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2;
+    typedef bg::model::point<double, 3, bg::cs::cartesian> P3;
+
+    test_hilbert_curve();
+    test_morton_curve();
+
+    test_rtree< P2, bgi::linear<16, 4> >(0);
+    test_rtree< P2, bgi::linear<16, 4> >(1);
+    test_rtree< P2, bgi::linear<16, 4> >(177);
+    test_rtree< P2, bgi::quadratic<5, 2> >(177);
+    test_rtree< P2, bgi::rstar<8, 3> >(20000);
+    test_rtree< P3, bgi::rstar<8, 3> >(20000);
+    test_rtree< P2 >(5000, bgi::dynamic_rstar(5, 2));
+
+    return 0;
+}
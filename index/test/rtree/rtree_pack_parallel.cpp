@@ -0,0 +1,80 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <vector>
+
+#include <rtree/test_rtree.hpp>
+
+template <typename Rtree>
+void check_the_same(Rtree const& expected, Rtree const& rt)
+{
+    if ( !rt.empty() )
+    {
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rt));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt));
+    }
+
+    BOOST_CHECK_EQUAL(rt.size(), expected.size());
+    BOOST_CHECK_EQUAL(bgi::detail::rtree::utilities::view<Rtree>(rt).depth(),
+                      bgi::detail::rtree::utilities::view<Rtree>(expected).depth());
+
+    // the leafs are traversed in the same order if the structure is the same
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), rt.begin(),
+                           bgi::equal_to<typename Rtree::value_type>()));
+}
+
+template <typename Params>
+void test_rtree(std::size_t vcount, Params const& params = Params())
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+    typedef std::pair<box_t, std::size_t> value_t;
+    typedef bgi::rtree<value_t, Params> rtree_t;
+
+    std::vector<value_t> values;
+    values.reserve(vcount);
+    for ( std::size_t i = 0 ; i < vcount ; ++i )
+    {
+        double x = static_cast<double>((i * 7919) % 1009);
+        double y = static_cast<double>((i * 104729) % 997);
+        values.push_back(std::make_pair(box_t(point_t(x, y), point_t(x + 0.5, y + 0.5)), i));
+    }
+
+    rtree_t expected(values, params);
+
+    for ( std::size_t threads = 1 ; threads <= 5 ; threads += 2 )
+    {
+        rtree_t rt1(values, bg::parallel(threads), params);
+        check_the_same(expected, rt1);
+
+        rtree_t rt2(values.begin(), values.end(), bg::parallel(threads), params);
+        check_the_same(expected, rt2);
+    }
+
+    rtree_t rt3(values, bg::parallel(), params);
+    check_the_same(expected, rt3);
+
+    box_t qbox(point_t(100, 100), point_t(200, 300));
+    std::vector<value_t> expected_result, result;
+    expected.query(bgi::intersects(qbox), std::back_inserter(expected_result));
+    rt3.query(bgi::intersects(qbox), std::back_inserter(result));
+    BOOST_CHECK(expected_result.size() == result.size());
+}
+
+int test_main(int, char* [])
+{
+    test_rtree< bgi::linear<16, 4> >(0);
+    test_rtree< bgi::linear<16, 4> >(10);
+    test_rtree< bgi::linear<16, 4> >(50000);
+    test_rtree< bgi::quadratic<8, 3> >(20000);
+    test_rtree< bgi::rstar<4, 2> >(20000);
+    test_rtree(30000, bgi::dynamic_rstar(5, 2));
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Checks that the parallel buffer produces the same output as the
+// sequential version.
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+
+template <typename Geometry>
+std::string to_wkt(Geometry const& geometry)
+{
+    std::ostringstream out;
+    out << std::setprecision(20) << bg::wkt(geometry);
+    return out.str();
+}
+
+template <typename MultiPolygon, typename Geometry, typename JoinStrategy>
+void check_parallel(std::string const& caseid, Geometry const& geometry,
+        double distance, JoinStrategy const& join_strategy)
+{
+    bg::strategy::buffer::distance_symmetric<double> distance_strategy(distance);
+    bg::strategy::buffer::side_straight side_strategy;
+    bg::strategy::buffer::end_round end_strategy(12);
+    bg::strategy::buffer::point_circle point_strategy(12);
+
+    MultiPolygon expected;
+    bg::buffer(geometry, expected,
+        distance_strategy, side_strategy, join_strategy,
+        end_strategy, point_strategy);
+
+    BOOST_CHECK_MESSAGE(! expected.empty(), "empty: " << caseid);
+
+    for (std::size_t threads = 1; threads <= 4; threads *= 2)
+    {
+        MultiPolygon result;
+        bg::buffer(geometry, result,
+            distance_strategy, side_strategy, join_strategy,
+            end_strategy, point_strategy, bg::parallel(threads));
+
+        BOOST_CHECK_MESSAGE(to_wkt(result) == to_wkt(expected),
+            "buffer: " << caseid << " threads: " << threads);
+    }
+}
+
+// A grid of streets with slightly bent segments, the buffers of the
+// crossing streets overlap each other
+template <typename MultiLinestring>
+MultiLinestring streets(int count)
+{
+    typedef typename boost::range_value<MultiLinestring>::type linestring_type;
+    typedef typename bg::point_type<MultiLinestring>::type point_type;
+
+    MultiLinestring result;
+    for (int i = 0; i < count; i++)
+    {
+        linestring_type horizontal, vertical;
+        for (int j = 0; j <= count; j++)
+        {
+            double const bend = (j % 2 == 0 ? 0.5 : -0.5) + 0.1 * (i % 3);
+            bg::append(horizontal, point_type(j * 10.0, i * 10.0 + bend));
+            bg::append(vertical, point_type(i * 10.0 + bend, j * 10.0));
+        }
+        result.push_back(horizontal);
+        result.push_back(vertical);
+    }
+    return result;
+}
+
+// Squares with holes, the buffers of neighbouring squares overlap
+template <typename MultiPolygon>
+MultiPolygon squares(int count)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+    typedef typename bg::point_type<MultiPolygon>::type point_type;
+
+    MultiPolygon result;
+    for (int i = 0; i < count; i++)
+    {
+        for (int j = 0; j < count; j++)
+        {
+            double const x = i * 10.0;
+            double const y = j * 10.0;
+
+            polygon_type square;
+            bg::append(square.outer(), point_type(x, y));
+            bg::append(square.outer(), point_type(x, y + 8));
+            bg::append(square.outer(), point_type(x + 8, y + 8));
+            bg::append(square.outer(), point_type(x + 8, y));
+            bg::append(square.outer(), point_type(x, y));
+            square.inners().resize(1);
+            bg::append(square.inners()[0], point_type(x + 3, y + 3));
+            bg::append(square.inners()[0], point_type(x + 5, y + 3));
+            bg::append(square.inners()[0], point_type(x + 5, y + 5));
+            bg::append(square.inners()[0], point_type(x + 3, y + 5));
+            bg::append(square.inners()[0], point_type(x + 3, y + 3));
+            result.push_back(square);
+        }
+    }
+    bg::correct(result);
+    return result;
+}
+
+// A polygon with many concave and convex corners
+template <typename Polygon>
+Polygon star(int count)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+
+    Polygon result;
+    double const pi = boost::math::constants::pi<double>();
+    for (int i = 0; i <= count; i++)
+    {
+        double const angle = 2.0 * pi * (i % count) / count;
+        double const radius = i % 2 == 0 ? 100.0 : 80.0;
+        bg::append(result.outer(), point_type(radius * std::cos(angle),
+                                              radius * std::sin(angle)));
+    }
+    bg::correct(result);
+    return result;
+}
+
+template <typename P>
+void test_all()
+{
+    typedef bg::model::linestring<P> linestring;
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::multi_point<P> multi_point;
+    typedef bg::model::multi_linestring<linestring> multi_linestring;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+    bg::strategy::buffer::join_round join_round(12);
+    bg::strategy::buffer::join_miter join_miter;
+
+    multi_linestring const mls = streets<multi_linestring>(8);
+    check_parallel<multi_polygon>("streets_round", mls, 1.5, join_round);
+    check_parallel<multi_polygon>("streets_miter", mls, 1.5, join_miter);
+    check_parallel<multi_polygon>("streets_wide", mls, 6.0, join_round);
+
+    multi_polygon const mp = squares<multi_polygon>(6);
+    check_parallel<multi_polygon>("squares_inflate", mp, 1.5, join_round);
+    check_parallel<multi_polygon>("squares_deflate", mp, -0.5, join_miter);
+
+    multi_point mpt;
+    for (int i = 0; i < 50; i++)
+    {
+        bg::append(mpt, P((i * 7) % 23, (i * 11) % 19));
+    }
+    check_parallel<multi_polygon>("points", mpt, 2.0, join_round);
+
+    // A single polygon, only the turns are calculated in parallel
+    polygon const pg = star<polygon>(200);
+    check_parallel<multi_polygon>("star_inflate", pg, 5.0, join_round);
+    check_parallel<multi_polygon>("star_deflate", pg, -5.0, join_round);
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+
+    return 0;
+}
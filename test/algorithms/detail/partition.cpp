@@ -27,6 +27,7 @@
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <boost/shared_ptr.hpp>
 
 
 template <typename Box>
@@ -639,6 +640,111 @@ void test_heterogenuous_collections(int seed1, int seed2, int size, int count)
     BOOST_CHECK_EQUAL(visitor2.count, expected_count);
 }
 
+// Records the ids of the intersecting pairs in the order of visiting,
+// it may be used by the parallel partition
+struct id_pair_visitor
+{
+    std::vector<std::pair<int, int> > pairs;
+
+    id_pair_visitor()
+    {}
+
+    id_pair_visitor(id_pair_visitor const&, bg::detail::partition::split)
+    {}
+
+    template <typename Item1, typename Item2>
+    inline void apply(Item1 const& item1, Item2 const& item2)
+    {
+        if (bg::intersects(item1.box, item2.box))
+        {
+            pairs.push_back(std::make_pair(item1.id, item2.id));
+        }
+    }
+
+    inline void join(id_pair_visitor const& other)
+    {
+        pairs.insert(pairs.end(), other.pairs.begin(), other.pairs.end());
+    }
+};
+
+// Records the levels of the visited boxes in the order of visiting. It's
+// passed by value, the copies share the levels but the visitors of the
+// parallel tasks record their own ones
+struct level_box_visitor
+{
+    boost::shared_ptr<std::vector<std::size_t> > levels;
+
+    level_box_visitor()
+        : levels(new std::vector<std::size_t>())
+    {}
+
+    level_box_visitor(level_box_visitor const&, bg::detail::partition::split)
+        : levels(new std::vector<std::size_t>())
+    {}
+
+    template <typename Box>
+    inline void apply(Box const&, std::size_t level)
+    {
+        levels->push_back(level);
+    }
+
+    inline void join(level_box_visitor const& other)
+    {
+        levels->insert(levels->end(),
+                other.levels->begin(), other.levels->end());
+    }
+};
+
+void test_parallel(int seed1, int seed2, int size, int count)
+{
+    typedef bg::model::box<point_item> box_type;
+    std::vector<box_item<box_type> > boxes1, boxes2;
+
+    fill_boxes(boxes1, seed1, size, count);
+    fill_boxes(boxes2, seed2, size, count);
+
+    typedef bg::partition<box_type, get_box, ovelaps_box> partition_type;
+
+    id_pair_visitor expected1, expected2;
+    partition_type::apply(boxes1, expected1);
+    partition_type::apply(boxes1, boxes2, expected2);
+
+    BOOST_CHECK(! expected1.pairs.empty());
+    BOOST_CHECK(! expected2.pairs.empty());
+
+    // The pairs are visited in the same order as by the sequential version
+    for (std::size_t threads = 1; threads <= 4; threads *= 2)
+    {
+        bg::parallel policy(threads);
+        id_pair_visitor visitor1, visitor2;
+        partition_type::apply(boxes1, visitor1, policy);
+        partition_type::apply(boxes1, boxes2, visitor2, bg::parallel(threads));
+
+        BOOST_CHECK(visitor1.pairs == expected1.pairs);
+        BOOST_CHECK(visitor2.pairs == expected2.pairs);
+    }
+
+    // Each task visits the boxes with its own box visitor, the boxes are
+    // joined in the order of the sequential version
+    typedef bg::partition
+        <
+            box_type, get_box, ovelaps_box, get_box, ovelaps_box,
+            bg::detail::partition::include_all_policy,
+            bg::detail::partition::include_all_policy,
+            level_box_visitor
+        > box_partition_type;
+
+    id_pair_visitor visitor;
+    level_box_visitor expected_boxes, boxes;
+    box_partition_type::apply(boxes1, boxes2, visitor, 16, expected_boxes);
+    BOOST_CHECK(! expected_boxes.levels->empty());
+
+    bg::parallel policy(4);
+    id_pair_visitor parallel_visitor;
+    box_partition_type::apply(boxes1, boxes2, parallel_visitor, policy, 16, boxes);
+    BOOST_CHECK(*boxes.levels == *expected_boxes.levels);
+}
+
 int test_main( int , char* [] )
 {
     test_all<bg::model::d2::point_xy<double> >();
@@ -663,5 +769,8 @@ int test_main( int , char* [] )
 
     test_heterogenuous_collections(67890, 98765, 20, 60);
 
+    test_parallel(12345, 54321, 20, 2000);
+    test_parallel(67890, 98765, 100, 5000);
+
     return 0;
 }
@@ -0,0 +1,180 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/algorithms/distance_matrix.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+#include <boost/geometry/strategies/geographic/distance_andoyer.hpp>
+#include <boost/geometry/strategies/geographic/distance_thomas.hpp>
+#include <boost/geometry/strategies/geographic/distance_vincenty.hpp>
+
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+
+template <typename Point>
+std::vector<Point> geographic_points(int count, int seed)
+{
+    boost::minstd_rand rng(seed);
+    boost::uniform_real<> lon(-180, 180);
+    boost::uniform_real<> lat(-89, 89);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_real<> > rnd_lon(rng, lon);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_real<> > rnd_lat(rng, lat);
+
+    std::vector<Point> points;
+    for (int i = 0; i < count; i++)
+    {
+        points.push_back(Point(rnd_lon(), rnd_lat()));
+    }
+
+    // Special cases: poles, antimeridian, nearby points and equal points
+    points.push_back(Point(0, 90));
+    points.push_back(Point(45, -90));
+    points.push_back(Point(180, 10));
+    points.push_back(Point(-180, 10));
+    points.push_back(Point(4.0, 52.0));
+    points.push_back(Point(4.001, 52.001));
+    points.push_back(Point(4.0, 52.0));
+    return points;
+}
+
+template <typename Points1, typename Points2, typename Strategy>
+void check_matrix(Points1 const& points1, Points2 const& points2,
+                  Strategy const& strategy, double tolerance,
+                  std::string const& caseid)
+{
+    std::size_t const count2 = boost::size(points2);
+
+    std::vector<double> matrix;
+    bg::distance_matrix(points1, points2, std::back_inserter(matrix), strategy);
+    BOOST_CHECK_EQUAL(matrix.size(), boost::size(points1) * count2);
+
+    std::size_t errors = 0;
+    for (std::size_t i = 0; i < boost::size(points1); i++)
+    {
+        for (std::size_t j = 0; j < count2; j++)
+        {
+            double const expected = strategy.apply(points1[i], points2[j]);
+            double const detected = matrix[i * count2 + j];
+            if (bg::math::abs(detected - expected)
+                    > tolerance * (std::max)(1.0, bg::math::abs(expected))
+                && errors++ < 10)
+            {
+                BOOST_CHECK_MESSAGE(false, caseid << " " << i << " " << j
+                    << " expected: " << expected << " detected: " << detected);
+            }
+        }
+    }
+
+    // The rows are the same as the distances of the points
+    std::vector<double> row;
+    bg::distances(points1[3], points2, std::back_inserter(row), strategy);
+    BOOST_CHECK(std::equal(row.begin(), row.end(), matrix.begin() + 3 * count2));
+
+    // The parallel version gives the same result
+    std::vector<double> parallel_matrix(matrix.size());
+    std::vector<double>::iterator it
+        = bg::distance_matrix(points1, points2, parallel_matrix.begin(),
+                              strategy, bg::parallel(2));
+    BOOST_CHECK(it == parallel_matrix.end());
+    BOOST_CHECK(std::equal(matrix.begin(), matrix.end(), parallel_matrix.begin()));
+}
+
+template <typename Point>
+void test_geographic()
+{
+    typedef bg::srs::spheroid<double> spheroid_type;
+
+    std::vector<Point> const points1 = geographic_points<Point>(60, 1);
+    std::vector<Point> const points2 = geographic_points<Point>(80, 2);
+
+    check_matrix(points1, points2,
+                 bg::strategy::distance::andoyer<spheroid_type>(), 1e-9,
+                 "andoyer");
+    // The distances of nearby points are more precise than the ones of the
+    // strategy, calculating acos near 1
+    check_matrix(points1, points2,
+                 bg::strategy::distance::thomas<spheroid_type>(), 1e-6,
+                 "thomas");
+    {
+        std::vector<Point> nearby;
+        nearby.push_back(Point(4.00001, 52.00001));
+        std::vector<double> d;
+        bg::distances(Point(4.0, 52.0), nearby, std::back_inserter(d),
+                      bg::strategy::distance::thomas<spheroid_type>());
+        double const vincenty = bg::strategy::distance::vincenty
+            <
+                spheroid_type
+            >().apply(Point(4.0, 52.0), nearby[0]);
+        BOOST_CHECK_CLOSE(d[0], vincenty, 1e-3);
+    }
+    check_matrix(points1, points2,
+                 bg::strategy::distance::vincenty<spheroid_type>(), 0.0,
+                 "vincenty");
+
+    // Different spheroid
+    check_matrix(points1, points2,
+                 bg::strategy::distance::andoyer<spheroid_type>(
+                    spheroid_type(6378137.0, 6356752.3142451793)), 1e-9,
+                 "andoyer_wgs84");
+
+    // Default strategy
+    std::vector<double> matrix;
+    bg::distance_matrix(points1, points2, std::back_inserter(matrix));
+    BOOST_CHECK_CLOSE(matrix[5 * points2.size() + 7],
+                      bg::distance(points1[5], points2[7]), 1e-7);
+}
+
+template <typename Point>
+void test_cartesian()
+{
+    typedef bg::model::multi_point<Point> multi_point;
+
+    multi_point points1, points2;
+    for (int i = 0; i < 20; i++)
+    {
+        bg::append(points1, Point(i, i * 2));
+        bg::append(points2, Point(i * 3, -i));
+    }
+
+    check_matrix(points1, points2,
+                 bg::strategy::distance::pythagoras<>(), 0.0, "pythagoras");
+    check_matrix(points1, points2,
+                 bg::strategy::distance::comparable::pythagoras<>(), 0.0,
+                 "comparable_pythagoras");
+
+    std::vector<double> row;
+    bg::distances(Point(1, 1), points2, std::back_inserter(row));
+    BOOST_CHECK_EQUAL(row.size(), 20u);
+    BOOST_CHECK_CLOSE(row[1], bg::distance(Point(1, 1), Point(3, -1)), 1e-12);
+
+    // Empty ranges
+    multi_point const empty;
+    std::vector<double> matrix;
+    bg::distance_matrix(points1, empty, std::back_inserter(matrix));
+    bg::distance_matrix(empty, points2, std::back_inserter(matrix));
+    BOOST_CHECK(matrix.empty());
+}
+
+int test_main(int, char* [])
+{
+    test_geographic<bg::model::point<double, 2, bg::cs::geographic<bg::degree> > >();
+    test_cartesian<bg::model::point<double, 2, bg::cs::cartesian> >();
+
+    return 0;
+}
@@ -0,0 +1,217 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include <boost/math/special_functions/next.hpp>
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+
+
+template <typename Point>
+struct collect_point
+{
+    explicit collect_point(std::vector<Point>& points)
+        : m_points(points)
+    {}
+
+    inline void operator()(Point const& p)
+    {
+        m_points.push_back(p);
+    }
+
+    std::vector<Point>& m_points;
+};
+
+// The points tested: the vertices, the centers of the edges
+// and points on a grid covering the geometry
+template <typename Point, typename Geometry>
+std::vector<Point> test_points(Geometry const& geometry, int grid_size)
+{
+    typedef typename bg::coordinate_type<Point>::type coordinate_type;
+
+    std::vector<Point> result;
+
+    bg::model::box<Point> box;
+    bg::envelope(geometry, box);
+
+    coordinate_type const min_x = bg::get<bg::min_corner, 0>(box);
+    coordinate_type const min_y = bg::get<bg::min_corner, 1>(box);
+    coordinate_type const width = bg::get<bg::max_corner, 0>(box) - min_x;
+    coordinate_type const height = bg::get<bg::max_corner, 1>(box) - min_y;
+
+    for (int i = -1; i <= grid_size + 1; i++)
+    {
+        for (int j = -1; j <= grid_size + 1; j++)
+        {
+            result.push_back(Point(min_x + width * i / grid_size,
+                                   min_y + height * j / grid_size));
+        }
+    }
+
+    std::vector<Point> vertices;
+    bg::for_each_point(geometry, collect_point<Point>(vertices));
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        result.push_back(vertices[i]);
+        if (i + 1 < vertices.size())
+        {
+            result.push_back(Point(
+                (bg::get<0>(vertices[i]) + bg::get<0>(vertices[i + 1])) / 2,
+                (bg::get<1>(vertices[i]) + bg::get<1>(vertices[i + 1])) / 2));
+        }
+    }
+
+    return result;
+}
+
+// The points a few representable values above and below the vertices, which
+// are compared with the vertices with the epsilon of the coordinate type
+template <typename Point, typename Geometry>
+std::vector<Point> near_vertices(Geometry const& geometry)
+{
+    std::vector<Point> result;
+
+    std::vector<Point> vertices;
+    bg::for_each_point(geometry, collect_point<Point>(vertices));
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        Point const& v = vertices[i];
+        for (int d = -4; d <= 4; d++)
+        {
+            if (d != 0)
+            {
+                result.push_back(Point(bg::get<0>(v),
+                    boost::math::float_advance(bg::get<1>(v), d)));
+            }
+        }
+    }
+    return result;
+}
+
+template <typename Geometry>
+void check_prepared(std::string const& caseid, Geometry const& geometry, int grid_size)
+{
+    typedef typename bg::point_type<Geometry>::type point_type;
+
+    bg::prepared_areal<Geometry> prepared(geometry);
+
+    std::vector<point_type> points = test_points<point_type>(geometry, grid_size);
+    std::vector<point_type> const near = near_vertices<point_type>(geometry);
+    points.insert(points.end(), near.begin(), near.end());
+
+    std::size_t within_count = 0;
+    std::size_t covered_by_count = 0;
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        point_type const& point = points[i];
+
+        bool const within = bg::within(point, geometry);
+        bool const covered_by = bg::covered_by(point, geometry);
+
+        BOOST_CHECK_MESSAGE(bg::within(point, prepared) == within,
+            caseid << " within " << bg::wkt(point));
+        BOOST_CHECK_MESSAGE(bg::covered_by(point, prepared) == covered_by,
+            caseid << " covered_by " << bg::wkt(point));
+        BOOST_CHECK_MESSAGE(bg::intersects(point, prepared) == covered_by,
+            caseid << " intersects " << bg::wkt(point));
+        BOOST_CHECK_MESSAGE(bg::disjoint(point, prepared) == ! covered_by,
+            caseid << " disjoint " << bg::wkt(point));
+
+        within_count += within ? 1 : 0;
+        covered_by_count += covered_by ? 1 : 0;
+    }
+
+    // The points have to be tested on each side of the boundary
+    BOOST_CHECK_MESSAGE(within_count > 0 && covered_by_count < points.size(),
+        caseid << " all points on one side of the boundary");
+}
+
+template <typename Geometry>
+void test_wkt(std::string const& caseid, std::string const& wkt, int grid_size = 20)
+{
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+    bg::correct(geometry);
+    check_prepared(caseid, geometry, grid_size);
+}
+
+// A star-like polygon with many edges and a hole
+template <typename Polygon>
+void test_star(int count)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+
+    boost::minstd_rand rng(count);
+    boost::uniform_int<> radius(50, 100);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_int<> > rnd(rng, radius);
+
+    Polygon polygon;
+    for (int i = 0; i < count; i++)
+    {
+        double const angle = -2.0 * bg::math::pi<double>() * i / count;
+        double const r = rnd();
+        bg::append(polygon.outer(), point_type(r * std::cos(angle), r * std::sin(angle)));
+    }
+    polygon.inners().resize(1);
+    bg::append(polygon.inners()[0], point_type(-10, -10));
+    bg::append(polygon.inners()[0], point_type(10, -10));
+    bg::append(polygon.inners()[0], point_type(10, 10));
+    bg::append(polygon.inners()[0], point_type(-10, 10));
+    bg::correct(polygon);
+
+    check_prepared("star", polygon, 100);
+}
+
+template <typename P>
+void test_all()
+{
+    typedef bg::model::ring<P> ring;
+    typedef bg::model::ring<P, false, false> ring_ccw_open;
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::polygon<P, false, false> polygon_ccw_open;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+    test_wkt<ring>("ring", "POLYGON((0 0,0 10,10 10,10 0,0 0))");
+    test_wkt<ring_ccw_open>("ring_ccw_open", "POLYGON((0 0,10 0,10 10,0 10))");
+    test_wkt<polygon>("polygon_with_holes",
+        "POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,4 2,4 4,2 4,2 2),(5 5,8 5,8 8,5 8,5 5))");
+    test_wkt<polygon>("polygon_horizontal_edges",
+        "POLYGON((0 0,0 4,2 4,2 6,4 6,4 2,6 2,6 8,8 8,8 0,0 0))", 16);
+    test_wkt<polygon_ccw_open>("polygon_ccw_open",
+        "POLYGON((0 0,10 0,10 10,0 10),(2 2,2 4,4 4,4 2))");
+    test_wkt<polygon>("polygon_degenerate_hole",
+        "POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,4 2,2 2))");
+    test_wkt<multi_polygon>("multi_polygon",
+        "MULTIPOLYGON(((0 0,0 10,10 10,10 0,0 0),(2 2,4 2,4 4,2 4,2 2)),((12 0,12 5,20 5,12 0)),((3 3,3 3.5,3.5 3.5,3 3)))");
+
+    test_star<polygon>(1000);
+    test_star<polygon>(5000);
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+    test_all<bg::model::d2::point_xy<float> >();
+
+    // Empty geometries don't contain any point
+    typedef bg::model::polygon<bg::model::d2::point_xy<double> > polygon;
+    polygon empty;
+    bg::prepared_areal<polygon> prepared(empty);
+    BOOST_CHECK(! bg::covered_by(bg::model::d2::point_xy<double>(0, 0), prepared));
+
+    return 0;
+}
@@ -0,0 +1,257 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+
+
+template <typename Prepared, typename Geometry>
+void check_prepared(Prepared const& prepared, Geometry const& geometry,
+                    std::string const& caseid)
+{
+    double const expected = bg::distance(prepared.geometry(), geometry);
+    double const detected = bg::distance(prepared, geometry);
+    BOOST_CHECK_MESSAGE(bg::math::equals(detected, expected),
+        "distance: " << caseid << " " << bg::wkt(geometry)
+        << " expected: " << expected << " detected: " << detected);
+
+    double const expected_cd
+        = bg::comparable_distance(prepared.geometry(), geometry);
+    double const detected_cd = bg::comparable_distance(prepared, geometry);
+    BOOST_CHECK_MESSAGE(bg::math::equals(detected_cd, expected_cd),
+        "comparable_distance: " << caseid << " " << bg::wkt(geometry)
+        << " expected: " << expected_cd << " detected: " << detected_cd);
+}
+
+// A star-like polygon with many vertices and a hole
+template <typename Polygon>
+Polygon star(int count)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+
+    boost::minstd_rand rng(count);
+    boost::uniform_int<> radius(80, 100);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_int<> > rnd(rng, radius);
+
+    Polygon polygon;
+    for (int i = 0; i < count; i++)
+    {
+        double const angle = -2.0 * bg::math::pi<double>() * i / count;
+        double const r = rnd();
+        bg::append(polygon.outer(), point_type(r * std::cos(angle), r * std::sin(angle)));
+    }
+    polygon.inners().resize(1);
+    bg::append(polygon.inners()[0], point_type(-10, -10));
+    bg::append(polygon.inners()[0], point_type(10, -10));
+    bg::append(polygon.inners()[0], point_type(10, 10));
+    bg::append(polygon.inners()[0], point_type(-10, 10));
+    bg::correct(polygon);
+    return polygon;
+}
+
+// A zigzag line with many vertices, long enough to be split in blocks
+template <typename Linestring>
+Linestring zigzag(double x, double y, int count)
+{
+    typedef typename bg::point_type<Linestring>::type point_type;
+
+    Linestring line;
+    for (int i = 0; i < count; i++)
+    {
+        bg::append(line, point_type(x + i * 0.25, y + (i % 2) * 0.5));
+    }
+    return line;
+}
+
+template <typename Polygon, typename Prepared>
+void test_geometries(Prepared const& prepared, std::string const& caseid)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    typedef bg::model::linestring<point_type> linestring;
+    typedef bg::model::multi_point<point_type> multi_point;
+    typedef bg::model::multi_linestring<linestring> multi_linestring;
+
+    // Points, squares and lines placed on a grid covering the prepared
+    // geometry and its surroundings
+    for (int i = -14; i <= 14; i++)
+    {
+        for (int j = -14; j <= 14; j++)
+        {
+            double const x = i * 9.5;
+            double const y = j * 9.5;
+            std::ostringstream id;
+            id << caseid << "_" << i << "_" << j;
+
+            point_type const point(x, y);
+
+            Polygon square;
+            bg::append(square.outer(), point_type(x, y));
+            bg::append(square.outer(), point_type(x, y + 6));
+            bg::append(square.outer(), point_type(x + 6, y + 6));
+            bg::append(square.outer(), point_type(x + 6, y));
+            bg::append(square.outer(), point_type(x, y));
+            bg::correct(square);
+
+            linestring line;
+            bg::append(line, point_type(x, y));
+            bg::append(line, point_type(x + 7, y + 3));
+            bg::append(line, point_type(x + 2, y + 8));
+
+            multi_point mpoint;
+            bg::append(mpoint, point_type(x, y));
+            bg::append(mpoint, point_type(x + 3, y + 4));
+
+            multi_linestring mline;
+            mline.push_back(line);
+
+            check_prepared(prepared, point, id.str());
+            check_prepared(prepared, square, id.str());
+            check_prepared(prepared, line, id.str());
+            check_prepared(prepared, mpoint, id.str());
+            check_prepared(prepared, mline, id.str());
+        }
+    }
+
+    // Long lines, the distance is calculated in blocks
+    for (int i = 0; i < 8; i++)
+    {
+        std::ostringstream id;
+        id << caseid << "_zigzag_" << i;
+        linestring const line = zigzag<linestring>(-200 + i * 30, -130 + i * 25, 500);
+        check_prepared(prepared, line, id.str());
+    }
+}
+
+// Long multipoints, the distances of blocks of points are calculated with the
+// passed strategies, the results are compared with the distances of all points
+template <typename P>
+void test_strategies()
+{
+    typedef bg::model::linestring<P> linestring;
+    typedef bg::model::multi_point<P> multi_point;
+
+    bg::strategy::distance::pythagoras<> const pp_strategy;
+    bg::strategy::distance::comparable::pythagoras<> const cpp_strategy;
+    bg::strategy::distance::projected_point<> const ps_strategy;
+
+    linestring const line = zigzag<linestring>(-100, 0, 800);
+    bg::prepared_distance<linestring> const prepared(line);
+
+    for (int i = 0; i < 4; i++)
+    {
+        multi_point mpoint1, mpoint2;
+        bg::assign_points(mpoint1, zigzag<linestring>(-150 + i * 40, 20 + i * 5, 300));
+        bg::assign_points(mpoint2, zigzag<linestring>(-120 + i * 30, -40 + i * 7, 200));
+
+        double expected_pp = -1, expected_ps = -1;
+        for (std::size_t j = 0; j < mpoint1.size(); j++)
+        {
+            double const ps = bg::distance(mpoint1[j], line, ps_strategy);
+            if (expected_ps < 0 || ps < expected_ps)
+            {
+                expected_ps = ps;
+            }
+            for (std::size_t k = 0; k < mpoint2.size(); k++)
+            {
+                double const pp = bg::distance(mpoint1[j], mpoint2[k], pp_strategy);
+                if (expected_pp < 0 || pp < expected_pp)
+                {
+                    expected_pp = pp;
+                }
+            }
+        }
+
+        BOOST_CHECK_CLOSE(bg::distance(mpoint1, mpoint2, pp_strategy), expected_pp, 0.0001);
+        BOOST_CHECK_CLOSE(bg::distance(mpoint1, mpoint2, cpp_strategy), expected_pp * expected_pp, 0.0001);
+        BOOST_CHECK_CLOSE(bg::distance(mpoint1, line, ps_strategy), expected_ps, 0.0001);
+        BOOST_CHECK_CLOSE(bg::distance(prepared, mpoint1, ps_strategy), expected_ps, 0.0001);
+    }
+}
+
+template <typename P>
+void test_all()
+{
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::polygon<P, false, false> polygon_ccw_open;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+    typedef bg::model::linestring<P> linestring;
+    typedef bg::model::multi_linestring<linestring> multi_linestring;
+
+    {
+        polygon const geometry = star<polygon>(2000);
+        bg::prepared_distance<polygon> prepared(geometry);
+        test_geometries<polygon>(prepared, "polygon");
+    }
+
+    {
+        polygon_ccw_open const geometry = star<polygon_ccw_open>(500);
+        bg::prepared_distance<polygon_ccw_open> prepared(geometry);
+        test_geometries<polygon_ccw_open>(prepared, "polygon_ccw_open");
+    }
+
+    {
+        multi_polygon geometry;
+        geometry.push_back(star<polygon>(1000));
+        geometry.push_back(polygon());
+        bg::read_wkt("POLYGON((-5 -5,-5 5,5 5,5 -5,-5 -5))", geometry.back());
+        bg::prepared_distance<multi_polygon> prepared(geometry);
+        test_geometries<polygon>(prepared, "multi_polygon");
+    }
+
+    {
+        linestring geometry;
+        bg::assign_points(geometry, star<polygon>(1000).outer());
+        bg::prepared_distance<linestring> prepared(geometry);
+        test_geometries<polygon>(prepared, "linestring");
+    }
+
+    {
+        multi_linestring geometry;
+        geometry.push_back(zigzag<linestring>(-100, 0, 800));
+        geometry.push_back(zigzag<linestring>(-100, 50, 800));
+        bg::prepared_distance<multi_linestring> prepared(geometry);
+        test_geometries<polygon>(prepared, "multi_linestring");
+    }
+
+    {
+        // Degenerated linestring, without segments
+        linestring geometry;
+        bg::read_wkt("LINESTRING(1 1)", geometry);
+        bg::prepared_distance<linestring> prepared(geometry);
+        check_prepared(prepared, P(4, 5), "one_point");
+    }
+
+    {
+        linestring const empty;
+        bg::prepared_distance<linestring> prepared(empty);
+        BOOST_CHECK_THROW(bg::distance(prepared, P(0, 0)),
+                          bg::empty_input_exception);
+    }
+
+    test_strategies<P>();
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+    test_all<bg::model::d2::point_xy<float> >();
+
+    return 0;
+}
@@ -0,0 +1,270 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+
+
+template <typename Geometry>
+std::string to_wkt(Geometry const& geometry)
+{
+    std::ostringstream out;
+    out << std::setprecision(20) << bg::wkt(geometry);
+    return out.str();
+}
+
+template <typename Prepared, typename Geometry>
+void check_prepared(Prepared const& prepared, Geometry const& geometry,
+                    std::string const& caseid)
+{
+    BOOST_CHECK_MESSAGE(bg::disjoint(prepared, geometry)
+                        == bg::disjoint(prepared.geometry(), geometry),
+        "disjoint: " << caseid << " " << bg::wkt(geometry));
+    BOOST_CHECK_MESSAGE(bg::intersects(prepared, geometry)
+                        == bg::intersects(prepared.geometry(), geometry),
+        "intersects: " << caseid << " " << bg::wkt(geometry));
+}
+
+template <typename GeometryOut, bool Enabled>
+struct check_intersection
+{
+    template <typename Prepared, typename Geometry>
+    static void apply(Prepared const& prepared, Geometry const& geometry,
+                      std::string const& caseid)
+    {
+        GeometryOut expected, detected;
+        bg::intersection(prepared.geometry(), geometry, expected);
+        bg::intersection(prepared, geometry, detected);
+
+        BOOST_CHECK_MESSAGE(to_wkt(detected) == to_wkt(expected),
+            "intersection: " << caseid << " " << bg::wkt(geometry));
+    }
+};
+
+template <typename GeometryOut>
+struct check_intersection<GeometryOut, false>
+{
+    template <typename Prepared, typename Geometry>
+    static void apply(Prepared const& , Geometry const& , std::string const& )
+    {}
+};
+
+// A star-like polygon with many vertices and a hole
+template <typename Polygon>
+Polygon star(int count)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+
+    boost::minstd_rand rng(count);
+    boost::uniform_int<> radius(80, 100);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_int<> > rnd(rng, radius);
+
+    Polygon polygon;
+    for (int i = 0; i < count; i++)
+    {
+        double const angle = -2.0 * bg::math::pi<double>() * i / count;
+        double const r = rnd();
+        bg::append(polygon.outer(), point_type(r * std::cos(angle), r * std::sin(angle)));
+    }
+    polygon.inners().resize(1);
+    bg::append(polygon.inners()[0], point_type(-10, -10));
+    bg::append(polygon.inners()[0], point_type(10, -10));
+    bg::append(polygon.inners()[0], point_type(10, 10));
+    bg::append(polygon.inners()[0], point_type(-10, 10));
+    bg::correct(polygon);
+    return polygon;
+}
+
+// Passes the requests of get_turns to the prepared geometry and records
+// the cached sections it returns
+template <typename Prepared>
+struct recording_prepared
+{
+    explicit recording_prepared(Prepared const& p)
+        : prepared(p), requests(0), hits(0), sections(0), same(true)
+    {}
+
+    template <typename Sections, bool Reverse, typename OtherGeometry, typename RobustPolicy>
+    Sections const* cached_sections(OtherGeometry const& geometry,
+                                    RobustPolicy const& robust_policy) const
+    {
+        Sections const* result = prepared.template cached_sections
+            <
+                Sections, Reverse
+            >(geometry, robust_policy);
+
+        requests++;
+        if (result != 0)
+        {
+            hits++;
+            same = same && (sections == 0 || sections == result);
+            sections = result;
+        }
+        return result;
+    }
+
+    Prepared const& prepared;
+    mutable std::size_t requests;
+    mutable std::size_t hits;
+    mutable void const* sections;
+    mutable bool same;
+};
+
+// The sections created once by the constructor are used by all calls
+template <typename Polygon, typename Prepared>
+void check_reused(Prepared const& prepared, std::string const& caseid)
+{
+    typedef typename Prepared::geometry_type geometry_type;
+    typedef typename bg::point_type<Polygon>::type point_type;
+
+    recording_prepared<Prepared> recording(prepared);
+
+    std::size_t calls = 0;
+    for (int i = -11; i <= 11; i++)
+    {
+        Polygon square;
+        bg::append(square.outer(), point_type(i * 9.5, i * 9.5));
+        bg::append(square.outer(), point_type(i * 9.5, i * 9.5 + 6));
+        bg::append(square.outer(), point_type(i * 9.5 + 6, i * 9.5 + 6));
+        bg::append(square.outer(), point_type(i * 9.5 + 6, i * 9.5));
+        bg::append(square.outer(), point_type(i * 9.5, i * 9.5));
+        bg::correct(square);
+
+        bool const disjoint = bg::detail::prepared_sections::disjoint
+            <
+                geometry_type, Polygon
+            >::apply(prepared.geometry(), square, recording);
+        BOOST_CHECK_EQUAL(disjoint, bg::disjoint(prepared.geometry(), square));
+        calls++;
+    }
+
+    // The sections of the other geometry are requested too, not returned
+    BOOST_CHECK_MESSAGE(recording.hits == calls
+                     && recording.requests == 2 * calls
+                     && recording.same,
+        caseid << " sections not reused, " << recording.hits
+               << " of " << recording.requests << " requests");
+
+    // The sections of a copy are not cached
+    recording_prepared<Prepared> copy_recording(prepared);
+    geometry_type const copy = prepared.geometry();
+    bg::detail::prepared_sections::disjoint
+        <
+            geometry_type, geometry_type
+        >::apply(copy, prepared.geometry(), copy_recording);
+    BOOST_CHECK_EQUAL(copy_recording.hits, 1u);
+}
+
+template <typename Polygon, bool Intersection, typename Prepared>
+void test_small_geometries(Prepared const& prepared, std::string const& caseid)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+    typedef bg::model::linestring<point_type> linestring;
+    typedef bg::model::multi_polygon<Polygon> multi_polygon;
+
+    check_reused<Polygon>(prepared, caseid);
+
+    std::size_t intersecting = 0;
+
+    // Squares and lines placed on a grid covering the prepared geometry,
+    // partly outside its envelope
+    for (int i = -11; i <= 11; i++)
+    {
+        for (int j = -11; j <= 11; j++)
+        {
+            double const x = i * 9.5;
+            double const y = j * 9.5;
+            std::ostringstream id;
+            id << caseid << "_" << i << "_" << j;
+
+            Polygon square;
+            bg::append(square.outer(), point_type(x, y));
+            bg::append(square.outer(), point_type(x, y + 6));
+            bg::append(square.outer(), point_type(x + 6, y + 6));
+            bg::append(square.outer(), point_type(x + 6, y));
+            bg::append(square.outer(), point_type(x, y));
+            bg::correct(square);
+
+            linestring line;
+            bg::append(line, point_type(x, y));
+            bg::append(line, point_type(x + 7, y + 3));
+            bg::append(line, point_type(x + 2, y + 8));
+
+            multi_polygon multi;
+            multi.push_back(square);
+
+            check_prepared(prepared, square, id.str());
+            check_prepared(prepared, line, id.str());
+            check_prepared(prepared, multi, id.str());
+            check_intersection<multi_polygon, Intersection>::apply(prepared, square, id.str());
+            check_intersection<multi_polygon, Intersection>::apply(prepared, multi, id.str());
+
+            intersecting += bg::intersects(prepared, square) ? 1 : 0;
+        }
+    }
+
+    // Some of the squares intersect, some don't
+    BOOST_CHECK_MESSAGE(intersecting > 0 && intersecting < 23 * 23,
+        caseid << " all squares on one side");
+}
+
+template <typename P>
+void test_all()
+{
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::polygon<P, false, false> polygon_ccw_open;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+    typedef bg::model::linestring<P> linestring;
+
+    {
+        polygon const geometry = star<polygon>(2000);
+        bg::prepared_sections<polygon> prepared(geometry);
+        test_small_geometries<polygon, true>(prepared, "polygon");
+    }
+
+    {
+        polygon_ccw_open const geometry = star<polygon_ccw_open>(500);
+        bg::prepared_sections<polygon_ccw_open> prepared(geometry);
+        test_small_geometries<polygon_ccw_open, true>(prepared, "polygon_ccw_open");
+    }
+
+    {
+        multi_polygon geometry;
+        geometry.push_back(star<polygon>(1000));
+        geometry.push_back(polygon());
+        bg::read_wkt("POLYGON((-5 -5,-5 5,5 5,5 -5,-5 -5))", geometry.back());
+        bg::prepared_sections<multi_polygon> prepared(geometry);
+        test_small_geometries<polygon, true>(prepared, "multi_polygon");
+    }
+
+    {
+        linestring geometry;
+        bg::assign_points(geometry, star<polygon>(1000).outer());
+        bg::prepared_sections<linestring> prepared(geometry);
+        test_small_geometries<polygon, false>(prepared, "linestring");
+    }
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+    test_all<bg::model::d2::point_xy<float> >();
+
+    return 0;
+}
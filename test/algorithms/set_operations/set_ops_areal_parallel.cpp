@@ -0,0 +1,141 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Checks that the parallel intersection, union and difference of areal
+// geometries produce the same output as the sequential versions.
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+#include <algorithms/overlay/multi_overlay_cases.hpp>
+
+
+template <typename Geometry>
+std::string to_wkt(Geometry const& geometry)
+{
+    std::ostringstream out;
+    out << std::setprecision(20) << bg::wkt(geometry);
+    return out.str();
+}
+
+template <typename MultiPolygon>
+void check_parallel(std::string const& caseid,
+        MultiPolygon const& mp1, MultiPolygon const& mp2)
+{
+    MultiPolygon intersection, union_, difference;
+    bg::intersection(mp1, mp2, intersection);
+    bg::union_(mp1, mp2, union_);
+    bg::difference(mp1, mp2, difference);
+
+    for (std::size_t threads = 1; threads <= 4; threads *= 2)
+    {
+        MultiPolygon intersection_p, union_p, difference_p;
+        bg::intersection(mp1, mp2, intersection_p, bg::parallel(threads));
+        bg::union_(mp1, mp2, union_p, bg::parallel(threads));
+        bg::difference(mp1, mp2, difference_p, bg::parallel(threads));
+
+        BOOST_CHECK_MESSAGE(to_wkt(intersection_p) == to_wkt(intersection),
+            "intersection: " << caseid << " threads: " << threads);
+        BOOST_CHECK_MESSAGE(to_wkt(union_p) == to_wkt(union_),
+            "union: " << caseid << " threads: " << threads);
+        BOOST_CHECK_MESSAGE(to_wkt(difference_p) == to_wkt(difference),
+            "difference: " << caseid << " threads: " << threads);
+    }
+}
+
+template <typename MultiPolygon>
+void test_case(std::string const& caseid,
+        std::string const& wkt1, std::string const& wkt2)
+{
+    MultiPolygon mp1, mp2;
+    bg::read_wkt(wkt1, mp1);
+    bg::read_wkt(wkt2, mp2);
+    bg::correct(mp1);
+    bg::correct(mp2);
+    check_parallel(caseid, mp1, mp2);
+}
+
+// A grid of squares with holes and a grid of diamonds crossing them,
+// the diamonds touch each other which results in clustered turns
+template <typename MultiPolygon>
+void test_grid(int count, double diamond_offset)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+    typedef typename bg::point_type<MultiPolygon>::type point_type;
+
+    MultiPolygon squares, diamonds;
+    for (int i = 0; i < count; i++)
+    {
+        for (int j = 0; j < count; j++)
+        {
+            double const x = i * 10.0;
+            double const y = j * 10.0;
+
+            polygon_type square;
+            bg::append(square.outer(), point_type(x, y));
+            bg::append(square.outer(), point_type(x, y + 8));
+            bg::append(square.outer(), point_type(x + 8, y + 8));
+            bg::append(square.outer(), point_type(x + 8, y));
+            bg::append(square.outer(), point_type(x, y));
+            square.inners().resize(1);
+            bg::append(square.inners()[0], point_type(x + 3, y + 3));
+            bg::append(square.inners()[0], point_type(x + 5, y + 3));
+            bg::append(square.inners()[0], point_type(x + 5, y + 5));
+            bg::append(square.inners()[0], point_type(x + 3, y + 5));
+            bg::append(square.inners()[0], point_type(x + 3, y + 3));
+            squares.push_back(square);
+
+            double const cx = x + diamond_offset;
+            double const cy = y + diamond_offset;
+            polygon_type diamond;
+            bg::append(diamond.outer(), point_type(cx - 5, cy));
+            bg::append(diamond.outer(), point_type(cx, cy + 5));
+            bg::append(diamond.outer(), point_type(cx + 5, cy));
+            bg::append(diamond.outer(), point_type(cx, cy - 5));
+            bg::append(diamond.outer(), point_type(cx - 5, cy));
+            diamonds.push_back(diamond);
+        }
+    }
+
+    bg::correct(squares);
+    bg::correct(diamonds);
+
+    std::ostringstream caseid;
+    caseid << "grid_" << count << "_" << diamond_offset;
+    check_parallel(caseid.str(), squares, diamonds);
+}
+
+template <typename P>
+void test_all()
+{
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+    test_case<multi_polygon>("case_multi_2", case_multi_2[0], case_multi_2[1]);
+    test_case<multi_polygon>("case_78_multi", case_78_multi[0], case_78_multi[1]);
+    test_case<multi_polygon>("case_88_multi", case_88_multi[0], case_88_multi[1]);
+    test_case<multi_polygon>("case_recursive_boxes_3", case_recursive_boxes_3[0], case_recursive_boxes_3[1]);
+
+    test_grid<multi_polygon>(12, 4.0);
+    test_grid<multi_polygon>(20, 6.5);
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+
+    return 0;
+}
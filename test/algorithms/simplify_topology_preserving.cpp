@@ -0,0 +1,251 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <sstream>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/equals.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/algorithms/is_valid.hpp>
+#include <boost/geometry/algorithms/num_points.hpp>
+#include <boost/geometry/algorithms/simplify.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+
+#include <boost/geometry/io/wkt/wkt.hpp>
+
+
+template <typename Geometry>
+void test_geometry(std::string const& wkt, std::string const& expected,
+                   double max_area)
+{
+    typedef typename bg::point_type<Geometry>::type point_type;
+
+    Geometry geometry, simplified;
+    bg::read_wkt(wkt, geometry);
+
+    bg::simplify(geometry, simplified, max_area,
+        bg::strategy::simplify::topology_preserving<point_type>());
+
+    std::ostringstream out;
+    out << bg::wkt(simplified);
+    BOOST_CHECK_MESSAGE(out.str() == expected,
+        "simplify_topology_preserving: " << wkt
+        << " expected: " << expected << " detected: " << out.str());
+}
+
+// The polygons of a multi-polygon which share a boundary should still share
+// it, without gaps or overlaps, so their union has no holes
+template <typename MultiPolygon>
+void check_shared(std::string const& caseid, MultiPolygon const& simplified)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+
+    MultiPolygon overlap, merged;
+    double overlap_area = 0;
+    for (std::size_t i = 0; i < simplified.size(); i++)
+    {
+        BOOST_CHECK_MESSAGE(bg::is_valid(simplified[i]),
+            "not valid: " << caseid << " polygon " << i
+            << " " << bg::wkt(simplified[i]));
+
+        for (std::size_t j = i + 1; j < simplified.size(); j++)
+        {
+            overlap.clear();
+            bg::intersection(simplified[i], simplified[j], overlap);
+            overlap_area += bg::area(overlap);
+        }
+
+        MultiPolygon temp;
+        bg::union_(merged, simplified[i], temp);
+        merged = temp;
+    }
+
+    BOOST_CHECK_CLOSE(overlap_area, 0.0, 0.001);
+    BOOST_CHECK_EQUAL(merged.size(), 1u);
+    if (merged.size() == 1u)
+    {
+        BOOST_CHECK_MESSAGE(merged.front().inners().empty(),
+            "gap between the polygons: " << caseid);
+    }
+    boost::ignore_unused<polygon_type>();
+}
+
+// A point on a wavy line of a grid, the line is the line-th vertical (or
+// horizontal) line, the point is the k-th step on it. The points are
+// calculated from the indices, so neighbouring polygons get the same points
+template <typename Point>
+Point wave_point(bool vertical, int line, int k, int count, int steps)
+{
+    double const size = 10.0;
+    double const fixed = line * size;
+    double const t = k * size / steps;
+
+    double offset = 0;
+    if (line > 0 && line < count && k % steps != 0)
+    {
+        // Damped near the corners, to avoid intersections
+        double const pi = boost::math::constants::pi<double>();
+        double const damping = std::sin(pi * (k % steps) / steps);
+        offset = damping * (0.3 * std::sin(t * 1.7 + fixed * 0.9)
+                          + 0.05 * std::sin(t * 13.0 + fixed));
+    }
+
+    return vertical ? Point(fixed + offset, t) : Point(t, fixed + offset);
+}
+
+// A grid of squares with wavy boundaries
+template <typename MultiPolygon>
+MultiPolygon wavy_grid(int count, int steps)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+    typedef typename bg::point_type<MultiPolygon>::type point_type;
+
+    MultiPolygon result;
+    for (int i = 0; i < count; i++)
+    {
+        for (int j = 0; j < count; j++)
+        {
+            polygon_type polygon;
+            for (int k = 0; k < steps; k++)
+            {
+                bg::append(polygon.outer(), wave_point<point_type>(false,
+                    j, i * steps + k, count, steps));
+            }
+            for (int k = 0; k < steps; k++)
+            {
+                bg::append(polygon.outer(), wave_point<point_type>(true,
+                    i + 1, j * steps + k, count, steps));
+            }
+            for (int k = 0; k < steps; k++)
+            {
+                bg::append(polygon.outer(), wave_point<point_type>(false,
+                    j + 1, (i + 1) * steps - k, count, steps));
+            }
+            for (int k = 0; k <= steps; k++)
+            {
+                bg::append(polygon.outer(), wave_point<point_type>(true,
+                    i, (j + 1) * steps - k, count, steps));
+            }
+
+            bg::correct(polygon);
+            result.push_back(polygon);
+        }
+    }
+    return result;
+}
+
+template <typename P>
+void test_all()
+{
+    typedef bg::model::ring<P> ring;
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+    typedef bg::model::linestring<P> linestring;
+    typedef bg::strategy::simplify::topology_preserving<P> strategy_type;
+
+    // Linestrings are simplified with visvalingam_whyatt
+    test_geometry<linestring>("LINESTRING(0 0,1 1,2 0,3 5,4 0)",
+        "LINESTRING(0 0,2 0,3 5,4 0)", 1.5);
+
+    test_geometry<ring>("POLYGON((0 0,0 10,10 10,10.5 5,10 0,0 0))",
+        "POLYGON((0 0,0 10,10 10,10 0,0 0))", 5.0);
+
+    // The first point is removed too, the ring starts at the smallest point
+    test_geometry<ring>("POLYGON((0 5,0 10,10 10,10 0,0 0,0 5))",
+        "POLYGON((0 0,0 10,10 10,10 0,0 0))", 1.0);
+
+    // The ring keeps 3 vertices
+    test_geometry<ring>("POLYGON((0 0,0 10,10 10,10 0,0 0))",
+        "POLYGON((0 0,10 10,10 0,0 0))", 1000.0);
+
+    // A negative value, the rings are not simplified
+    test_geometry<ring>("POLYGON((0 0,0 10,10 10,10.5 5,10 0,0 0))",
+        "POLYGON((0 0,0 10,10 10,10.5 5,10 0,0 0))", -1.0);
+
+    // The spike is not removed, the hole would be outside the polygon
+    std::string const spike
+        = "POLYGON((0 0,0 10,10 10,10 0,5 -3,0 0),(4.5 -1,5 -2,5.5 -1,4.5 -1))";
+    test_geometry<polygon>(spike,
+        "POLYGON((0 0,0 10,10 10,10 0,5 -3,0 0),(4.5 -1,5 -2,5.5 -1,4.5 -1))",
+        20.0);
+    {
+        polygon geometry, simplified;
+        bg::read_wkt(spike, geometry);
+
+        // Without checking the topology the output is invalid
+        bg::simplify(geometry, simplified, 20.0,
+            bg::strategy::simplify::visvalingam_whyatt<P>());
+        BOOST_CHECK(! bg::is_valid(simplified));
+    }
+
+    // The boundary shared by the polygons is simplified in the same way
+    test_geometry<multi_polygon>(
+        "MULTIPOLYGON(((0 0,0 10,5 10,5.2 5,5 0,0 0)),"
+        "((5 0,5.2 5,5 10,10 10,10 0,5 0)))",
+        "MULTIPOLYGON(((0 0,0 10,5 10,5 0,0 0)),((5 0,5 10,10 10,10 0,5 0)))",
+        5.0);
+
+    // A hole filled by another polygon
+    test_geometry<multi_polygon>(
+        "MULTIPOLYGON(((0 0,0 10,10 10,10 0,0 0),(2 2,8 2,8 8,5 8.2,2 8,2 2)),"
+        "((2 2,2 8,5 8.2,8 8,8 2,2 2)))",
+        "MULTIPOLYGON(((0 0,0 10,10 10,10 0,0 0),(2 2,8 2,8 8,2 8,2 2)),"
+        "((2 2,2 8,8 8,8 2,2 2)))",
+        1.0);
+
+    // Two arcs between the same nodes are not collapsed onto one segment
+    {
+        std::string const arcs
+            = "MULTIPOLYGON(((0 0,5 -5,10 0,5 1,0 0)),"
+              "((0 0,5 2,10 0,5 10,0 0)))";
+        multi_polygon geometry, simplified;
+        bg::read_wkt(arcs, geometry);
+        bg::correct(geometry);
+        BOOST_CHECK(bg::is_valid(geometry));
+
+        bg::simplify(geometry, simplified, 100.0, strategy_type());
+        BOOST_CHECK_MESSAGE(bg::is_valid(simplified),
+            "not valid: " << bg::wkt(simplified));
+
+        std::ostringstream out;
+        out << bg::wkt(simplified);
+        BOOST_CHECK_EQUAL(out.str(),
+            "MULTIPOLYGON(((0 0,10 0,5 -5,0 0)),((0 0,5 10,10 0,5 2,0 0)))");
+    }
+
+    multi_polygon const grid = wavy_grid<multi_polygon>(4, 40);
+    check_shared("wavy_grid", grid);
+    double const areas[] = { 0.001, 0.01, 0.1, 1.0 };
+    for (std::size_t i = 0; i < sizeof(areas) / sizeof(areas[0]); i++)
+    {
+        multi_polygon simplified;
+        bg::simplify(grid, simplified, areas[i], strategy_type());
+
+        std::ostringstream caseid;
+        caseid << "wavy_grid_" << areas[i];
+        check_shared(caseid.str(), simplified);
+
+        BOOST_CHECK_LT(bg::num_points(simplified), bg::num_points(grid));
+    }
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+
+    return 0;
+}
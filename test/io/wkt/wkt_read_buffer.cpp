@@ -0,0 +1,215 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <boost/algorithm/string.hpp>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/io/wkt/read.hpp>
+#include <boost/geometry/io/wkt/read_buffer.hpp>
+#include <boost/geometry/io/wkt/write.hpp>
+
+#include <boost/random/linear_congruential.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+
+template <typename G>
+std::string to_wkt(G const& geometry)
+{
+    std::ostringstream out;
+    out << std::setprecision(20) << bg::wkt(geometry);
+    return out.str();
+}
+
+template <typename G>
+void read_buffer(std::string const& wkt, G& geometry)
+{
+    bg::read_wkt(wkt.data(), wkt.data() + wkt.size(), geometry);
+}
+
+// The geometry read from the buffer is the same as read from the string
+template <typename G>
+void test_same(std::string const& wkt)
+{
+    G expected, detected;
+    bg::read_wkt(wkt, expected);
+    read_buffer(wkt, detected);
+
+    BOOST_CHECK_MESSAGE(to_wkt(detected) == to_wkt(expected),
+        "WKT: " << wkt << " expected: " << to_wkt(expected)
+        << " detected: " << to_wkt(detected));
+}
+
+template <typename G>
+void test_relaxed(std::string const& wkt, std::string const& expected)
+{
+    G geometry;
+    read_buffer(wkt, geometry);
+
+    BOOST_CHECK_EQUAL(boost::to_upper_copy(to_wkt(geometry)),
+                      boost::to_upper_copy(expected));
+}
+
+template <typename G>
+void test_wrong(std::string const& wkt, std::string const& start,
+                std::size_t offset)
+{
+    std::string e("no exception");
+    std::size_t detected_offset = 0;
+    G geometry;
+    try
+    {
+        read_buffer(wkt, geometry);
+    }
+    catch(bg::read_wkt_exception const& ex)
+    {
+        e = ex.what();
+        boost::to_lower(e);
+        detected_offset = ex.offset();
+    }
+
+    BOOST_CHECK_MESSAGE(boost::starts_with(e, start), "  Expected:"
+                << start << " Got:" << e << " with WKT: " << wkt);
+    BOOST_CHECK_MESSAGE(detected_offset == offset, "  Expected offset:"
+                << offset << " Got:" << detected_offset << " with WKT: " << wkt);
+}
+
+template <typename T>
+void test_number(std::string const& text, T const& expected)
+{
+    typedef bg::model::point<T, 2, bg::cs::cartesian> point_type;
+    point_type point;
+    read_buffer("POINT(" + text + " 0)", point);
+
+    BOOST_CHECK_MESSAGE(bg::get<0>(point) == expected,
+        "Number: " << text << " expected: " << std::setprecision(20) << expected
+        << " detected: " << bg::get<0>(point));
+}
+
+// Doubles written with 17 significant digits are read back exactly
+void test_round_trip()
+{
+    boost::minstd_rand rng(7);
+    boost::uniform_real<> mantissa(-1.0, 1.0);
+    boost::uniform_int<> exponent(-30, 30);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_real<> > rnd_m(rng, mantissa);
+    boost::variate_generator<boost::minstd_rand&, boost::uniform_int<> > rnd_e(rng, exponent);
+
+    for (int i = 0; i < 10000; i++)
+    {
+        double const value = rnd_m() * std::pow(10.0, rnd_e());
+        char text[64];
+        std::sprintf(text, "%.17g", value);
+        test_number<double>(text, value);
+    }
+}
+
+template <typename P>
+void test_all()
+{
+    typedef bg::model::linestring<P> linestring;
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::polygon<P, true, false> polygon_open;
+    typedef bg::model::ring<P> ring;
+    typedef bg::model::multi_point<P> multi_point;
+    typedef bg::model::multi_linestring<linestring> multi_linestring;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+    typedef bg::model::box<P> box;
+    typedef bg::model::segment<P> segment;
+
+    test_same<P>("POINT(1 2)");
+    test_same<P>("point ( -1.5e3 +2.25 )");
+    test_same<linestring>("LINESTRING(1 1,2 2,3 3)");
+    test_same<linestring>("LINESTRING()");
+    test_same<linestring>("LINESTRING EMPTY");
+    test_same<ring>("POLYGON((0 0,0 1,1 1,1 0,0 0))");
+    test_same<polygon>("POLYGON((0 0,0 4,4 4,4 0,0 0),(1 1,2 1,2 2,1 2,1 1),(3 3,3.5 3,3.5 3.5,3 3))");
+    test_same<polygon>("POLYGON((),(),())");
+    test_same<polygon_open>("POLYGON((0 0,0 4,4 4,4 0,0 0))");
+    test_same<polygon_open>("POLYGON((0 0,0 4,4 4,4 0))");
+    test_same<multi_point>("MULTIPOINT((1 2),(3 4))");
+    test_same<multi_point>("MULTIPOINT(1 2,3 4)");
+    test_same<multi_point>("MULTIPOINT EMPTY");
+    test_same<multi_linestring>("MULTILINESTRING((1 1,2 2,3 3),(4 4,5 5,6 6))");
+    test_same<multi_polygon>("MULTIPOLYGON(((0 0,0 2,2 2,2 0,0 0),(1 1,1 2,2 2,2 1,1 1)),((0 0,0 4,4 4,4 0,0 0)))");
+    test_same<box>("BOX(1 1,2 2)");
+    test_same<box>("POLYGON((1 1,1 2,2 2,2 1,1 1))");
+    test_same<segment>("SEGMENT(1 1,2 2)");
+    test_same<segment>("LINESTRING(1 1,2 2)");
+
+    // Relaxed: other whitespace, missing coordinates, measures
+    test_relaxed<P>("POINT(1)", "POINT(1 0)");
+    test_relaxed<P>("POINT()", "POINT(0 0)");
+    test_relaxed<P>("POINT  M ( 1 2)", "POINT(1 2)");
+    test_relaxed<P>("\n POINT\r\n(1\t2)\n", "POINT(1 2)");
+    test_relaxed<linestring>("LINESTRING(1,2,3)", "LINESTRING(1 0,2 0,3 0)");
+    test_relaxed<box>("POLYGON EMPTY", "POLYGON((0 0,0 0,0 0,0 0,0 0))");
+
+    // Errors, with the offset of the character (or number) which is wrong
+    test_wrong<P>("POINT(1 2", "expected ')'", 9);
+    test_wrong<P>("POINT 1 2)", "expected '('", 6);
+    test_wrong<P>("POINT(1 2,)", "expected ')'", 9);
+    test_wrong<P>("POINT(1 2)foo", "too much tokens", 10);
+    test_wrong<P>("POINT(1 2 3)", "expected ')'", 10);
+    test_wrong<P>("POINT(a 2)", "bad lexical cast", 6);
+    test_wrong<P>("POINT(1x 2)", "invalid number", 6);
+    test_wrong<P>("POINT(1 2e)", "expected number", 8);
+    test_wrong<P>("POINT Z (1 2 3)", "z only allowed", 8);
+    test_wrong<P>("PIONT (1 2)", "should start with 'point'", 0);
+    test_wrong<linestring>("LINESTRING())", "too much tokens", 12);
+    test_wrong<multi_polygon>(
+        "MULTIPOLYGON(((0 0,0 2,2 2,2 0,0 0),(1 1,1 2,2 2,2 1,1 1)),(0 0,0 4,4 4,4 0,0 0)))",
+        "expected '('", 60);
+    test_wrong<multi_point>("MULTIPOINT((8 9), 10 11)", "expected '('", 18);
+    test_wrong<multi_point>("MULTIPOINT(12 13, (14 15))", "expected number", 18);
+    test_wrong<box>("BOX(1 1,2 2,3 3)", "box should have 2", 16);
+    test_wrong<segment>("SEGMENT(1 1,2 2,3 3)", "segment should have 2", 20);
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+    test_all<bg::model::d2::point_xy<float> >();
+
+    test_number<double>("0", 0.0);
+    test_number<double>("-0.25E-3", -0.25e-3);
+    test_number<double>(".5", 0.5);
+    test_number<double>("5.", 5.0);
+    test_number<double>("+7", 7.0);
+    test_number<double>("0.1", 0.1);
+    test_number<double>("0.000000000000000000000000000001", 1e-30);
+    test_number<double>("123456789012345678901234567890", 123456789012345678901234567890.0);
+    test_number<double>("1.7976931348623157e308", 1.7976931348623157e308);
+    test_number<double>("4.9406564584124654e-324", 4.9406564584124654e-324);
+    test_number<double>("1e400", std::numeric_limits<double>::infinity());
+    test_number<float>("0.1", 0.1f);
+    test_number<float>("3.4028234e38", 3.4028234e38f);
+    // Just above halfway 1 and the next float, rounded to double it is halfway
+    test_number<float>("1.00000005960464483090", 1.00000011920928955078125f);
+    test_number<long double>("0.1", 0.1L);
+    test_number<int>("-2147483648", -2147483647 - 1);
+    test_number<int>("2147483647", 2147483647);
+
+    typedef bg::model::point<int, 2, bg::cs::cartesian> int_point;
+    test_wrong<int_point>("POINT(2147483648 0)", "number out of range", 6);
+    test_wrong<int_point>("POINT(1.5 0)", "invalid number", 6);
+
+    test_round_trip();
+
+    return 0;
+}
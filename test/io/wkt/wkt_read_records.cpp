@@ -0,0 +1,209 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <boost/algorithm/string.hpp>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/io/wkt/read.hpp>
+#include <boost/geometry/io/wkt/read_records.hpp>
+#include <boost/geometry/io/wkt/write.hpp>
+
+
+template <typename G>
+std::string to_wkt(G const& geometry)
+{
+    std::ostringstream out;
+    out << bg::wkt(geometry);
+    return out.str();
+}
+
+// Collects the records by offset, the calls may be concurrent
+struct collect_visitor
+{
+    template <typename G>
+    void operator()(G const& geometry, std::size_t offset)
+    {
+        std::string const wkt = to_wkt(geometry);
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        records[offset] = wkt;
+    }
+
+    std::map<std::size_t, std::string> records;
+};
+
+// The records read from the buffer and the stream are the same as read by
+// read_wkt from each line, with the offset of the line
+template <typename G>
+void test_records(std::string const& data)
+{
+    std::map<std::size_t, std::string> expected;
+    for (std::size_t begin = 0; begin < data.size(); )
+    {
+        std::size_t end = data.find('\n', begin);
+        end = end == std::string::npos ? data.size() : end;
+        std::string const line
+            = boost::trim_copy(data.substr(begin, end - begin));
+        if (! line.empty())
+        {
+            G geometry;
+            bg::read_wkt(line, geometry);
+            expected[begin + data.substr(begin).find(line)] = to_wkt(geometry);
+        }
+        begin = end + 1;
+    }
+
+    char const* first = data.data();
+    char const* last = first + data.size();
+
+    {
+        bg::wkt_record_reader reader(first, last);
+        std::map<std::size_t, std::string> detected;
+        G geometry;
+        while (reader.next(geometry))
+        {
+            detected[reader.record_offset()] = to_wkt(geometry);
+        }
+        BOOST_CHECK(detected == expected);
+        BOOST_CHECK_EQUAL(reader.count(), expected.size());
+        BOOST_CHECK(reader.at_end());
+    }
+
+    {
+        std::istringstream in(data);
+        bg::wkt_stream_reader reader(in);
+        std::map<std::size_t, std::string> detected;
+        G geometry;
+        while (reader.next(geometry))
+        {
+            detected[reader.record_offset()] = to_wkt(geometry);
+        }
+        BOOST_CHECK(detected == expected);
+        BOOST_CHECK_EQUAL(reader.count(), expected.size());
+    }
+
+    {
+        collect_visitor visitor;
+        bg::for_each_wkt_record<G>(first, last, visitor);
+        BOOST_CHECK(visitor.records == expected);
+    }
+
+    for (std::size_t threads = 1; threads <= 4; threads++)
+    {
+        collect_visitor visitor;
+        bg::for_each_wkt_record<G>(first, last, visitor, bg::parallel(threads));
+        BOOST_CHECK_MESSAGE(visitor.records == expected,
+            "parallel, threads: " << threads);
+    }
+}
+
+// The offset of the error is relative to the whole buffer
+template <typename G>
+void test_wrong(std::string const& data, std::size_t offset)
+{
+    std::size_t detected_offset = 0;
+    try
+    {
+        collect_visitor visitor;
+        bg::for_each_wkt_record<G>(data.data(), data.data() + data.size(),
+                                   visitor, bg::parallel(2));
+    }
+    catch(bg::read_wkt_exception const& ex)
+    {
+        detected_offset = ex.offset();
+    }
+    BOOST_CHECK_EQUAL(detected_offset, offset);
+
+    detected_offset = 0;
+    try
+    {
+        std::istringstream in(data);
+        bg::wkt_stream_reader reader(in);
+        G geometry;
+        while (reader.next(geometry))
+        {}
+    }
+    catch(bg::read_wkt_exception const& ex)
+    {
+        detected_offset = ex.offset();
+    }
+    BOOST_CHECK_EQUAL(detected_offset, offset);
+}
+
+template <typename P>
+void test_all()
+{
+    typedef bg::model::linestring<P> linestring;
+    typedef bg::model::polygon<P> polygon;
+
+    test_records<P>("");
+    test_records<P>("\n\n  \n");
+    test_records<P>("POINT(1 2)");
+    test_records<P>("POINT(1 2)\nPOINT(3 4)\n\nPOINT(5 6)\n");
+    test_records<P>("POINT(1 2)\r\n  \r\nPOINT(3 4)\r\n");
+    test_records<linestring>("LINESTRING(1 1,2 2)\nLINESTRING()\nLINESTRING(3 3,4 4,5 5)");
+
+    {
+        // Many records of different sizes, divided into chunks
+        std::ostringstream out;
+        for (int i = 0; i < 500; i++)
+        {
+            out << "POLYGON((0 0,0 " << i << "," << i << " " << i
+                << "," << i << " 0,0 0)";
+            for (int j = 0; j < i % 7; j++)
+            {
+                out << ",(1 1,2 1,2 2,1 2,1 1)";
+            }
+            out << ")\n";
+            if (i % 13 == 0)
+            {
+                out << "\n";
+            }
+        }
+        test_records<polygon>(out.str());
+    }
+
+    test_wrong<P>("POINT(1 2)\nPOINT(3 4\nPOINT(5 6)", 20);
+    test_wrong<P>("POINT(1 2)\n\nPIONT(5 6)", 12);
+
+    {
+        // The first chunk is read slowest, its invalid record is reported
+        // anyway, and not the invalid records of the other chunks
+        std::ostringstream out;
+        for (int i = 0; i < 2000; i++)
+        {
+            out << "POINT(1 2)\n";
+        }
+        out << "POINT(1 2\n";
+        for (int i = 0; i < 60000; i++)
+        {
+            out << "PIONT(1 2)\n";
+        }
+        for (int i = 0; i < 5; i++)
+        {
+            test_wrong<P>(out.str(), 2000 * 11 + 9);
+        }
+    }
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+    test_all<bg::model::d2::point_xy<float> >();
+
+    return 0;
+}
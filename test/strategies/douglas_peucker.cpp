@@ -18,10 +18,12 @@
 #endif
 #endif
 
+#include <cmath>
 #include <iostream>
 #include <iterator>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <boost/test/included/unit_test.hpp>
 
@@ -420,3 +422,62 @@ BOOST_AUTO_TEST_CASE( test_with_comparable_distance_strategy )
             simplify_comparable_distance_strategy<long double>::type
         >("ld");
 }
+
+
+// A long track, the result of the parallel version and of the version
+// with a reused buffer should be the same as the result of the sequential
+// version
+BOOST_AUTO_TEST_CASE( test_long_track )
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+    typedef std::vector<point_type> track_type;
+    typedef default_simplify_strategy<double>::type strategy_type;
+
+    track_type track;
+    double x = 0, y = 0;
+    for (std::size_t i = 0; i < 200000; i++)
+    {
+        x += std::cos(i * 0.001) + 0.3 * std::sin(i * 0.37);
+        y += std::sin(i * 0.0013) + 0.3 * std::cos(i * 0.53);
+        track.push_back(point_type(x, y));
+    }
+
+    double const distances[] = { 0.01, 0.5, 10.0 };
+    for (std::size_t d = 0; d < sizeof(distances) / sizeof(distances[0]); d++)
+    {
+        track_type expected;
+        strategy_type::apply(track, std::back_inserter(expected), distances[d]);
+        BOOST_CHECK_LT(expected.size(), track.size());
+        BOOST_CHECK(bg::equals(expected.front(), track.front()));
+        BOOST_CHECK(bg::equals(expected.back(), track.back()));
+
+        for (std::size_t threads = 1; threads <= 8; threads *= 2)
+        {
+            track_type result;
+            strategy_type::apply(track, std::back_inserter(result),
+                                 distances[d], bg::parallel(threads));
+            BOOST_CHECK_MESSAGE(equals::apply(result, expected),
+                "parallel, distance: " << distances[d]
+                << " threads: " << threads);
+        }
+    }
+
+    // The same buffer used for several ranges
+    strategy_type::buffer_type buffer;
+    for (std::size_t size = 100000; size >= 1; size /= 10)
+    {
+        track_type const part(track.begin(), track.begin() + size);
+
+        track_type expected, result, parallel_result;
+        strategy_type::apply(part, std::back_inserter(expected), 0.5);
+        strategy_type::apply(part, std::back_inserter(result), 0.5, buffer);
+        strategy_type::apply(part, std::back_inserter(parallel_result), 0.5,
+                             bg::parallel(4), buffer);
+
+        BOOST_CHECK_MESSAGE(equals::apply(result, expected),
+            "buffer, size: " << size);
+        BOOST_CHECK_MESSAGE(equals::apply(parallel_result, expected),
+            "parallel buffer, size: " << size);
+        BOOST_CHECK_EQUAL(buffer.included.size(), size);
+    }
+}
@@ -0,0 +1,251 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/concept_check.hpp>
+
+#include <boost/geometry/strategies/geographic/distance_geocentric_chord.hpp>
+
+#include <boost/geometry/core/srs.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+#include <boost/geometry/algorithms/assign.hpp>
+#include <boost/geometry/algorithms/comparable_distance.hpp>
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+
+typedef bg::srs::spheroid<double> spheroid_type;
+typedef bg::model::point<double, 3, bg::cs::cartesian> geocentric_type;
+
+
+template <typename P1, typename P2>
+void test_distance(double lon1, double lat1, double lon2, double lat2,
+                   double expected_km)
+{
+    typedef bg::strategy::distance::geocentric_chord<spheroid_type> strategy_type;
+    typedef bg::strategy::distance::comparable::geocentric_chord<spheroid_type> comparable_type;
+
+    BOOST_CONCEPT_ASSERT
+        (
+            (bg::concept::PointDistanceStrategy<strategy_type, P1, P2>)
+        );
+
+    typedef typename bg::strategy::distance
+        ::services::return_type<strategy_type, P1, P2>::type return_type;
+
+    strategy_type const strategy;
+    comparable_type const comparable;
+
+    P1 p1;
+    P2 p2;
+    bg::assign_values(p1, lon1, lat1);
+    bg::assign_values(p2, lon2, lat2);
+
+    double const expected = 1000.0 * expected_km;
+
+    // The documented maximum error, the expected distances are rounded to mm
+    double const tolerance = 0.001;
+    double const max_error = 1.2e-5 * bg::math::sqr(expected_km / 1000.0);
+    return_type const distance = strategy.apply(p1, p2);
+    BOOST_CHECK_MESSAGE(bg::math::abs(distance - expected) <= max_error * expected + tolerance,
+                        "detected: " << distance << " expected: " << expected);
+    BOOST_CHECK_EQUAL(bg::distance(p1, p2, strategy), distance);
+
+    // The geodesic is between the bounds of the comparable distance
+    return_type const cd = comparable.apply(p1, p2);
+    BOOST_CHECK_EQUAL(bg::comparable_distance(p1, p2, strategy), cd);
+    BOOST_CHECK(strategy.min_distance(cd) <= expected + tolerance);
+    BOOST_CHECK(strategy.max_distance(cd) >= expected - tolerance);
+
+    // Comparable distance of the geodesic
+    return_type const expected_cd = bg::strategy::distance::services::result_from_distance
+        <
+            comparable_type, P1, P2
+        >::apply(comparable, expected + tolerance);
+    BOOST_CHECK(cd <= expected_cd);
+
+    // Cartesian distance of the geocentric points
+    geocentric_type g1, g2;
+    strategy.to_geocentric(p1, g1);
+    strategy.to_geocentric(p2, g2);
+    BOOST_CHECK_CLOSE(bg::comparable_distance(g1, g2) + 1.0, cd + 1.0, 1e-9);
+}
+
+void test_geocentric()
+{
+    typedef bg::model::point<double, 2, bg::cs::geographic<bg::degree> > point_type;
+
+    spheroid_type const spheroid;
+    bg::strategy::distance::geocentric_chord<spheroid_type> const strategy(spheroid);
+
+    double const a = bg::get_radius<0>(spheroid);
+    double const b = bg::get_radius<2>(spheroid);
+
+    geocentric_type g;
+    strategy.to_geocentric(point_type(0, 0), g);
+    BOOST_CHECK_CLOSE(bg::get<0>(g), a, 1e-12);
+    BOOST_CHECK_SMALL(bg::get<1>(g), 1e-6);
+    BOOST_CHECK_SMALL(bg::get<2>(g), 1e-6);
+
+    strategy.to_geocentric(point_type(90, 0), g);
+    BOOST_CHECK_CLOSE(bg::get<1>(g), a, 1e-12);
+
+    strategy.to_geocentric(point_type(0, -90), g);
+    BOOST_CHECK_CLOSE(bg::get<2>(g), -b, 1e-9);
+
+    // Chord along the equator
+    double const chord = 2.0 * a * sin(bg::math::d2r<double>() / 2.0);
+    BOOST_CHECK_CLOSE(bg::comparable_distance(point_type(0, 0), point_type(1, 0),
+                                              strategy),
+                      chord * chord, 1e-10);
+
+    // Antipodal points
+    double const cd = bg::comparable_distance(point_type(0, 0), point_type(180, 0),
+                                              strategy);
+    BOOST_CHECK_CLOSE(cd, 4.0 * a * a, 1e-10);
+    BOOST_CHECK_CLOSE(strategy.max_distance(cd), bg::math::pi<double>() * a, 1e-10);
+}
+
+// Nearest query of an rtree of geocentric points, and filtering of points
+// within a distance, refined with the geodesic distance
+void test_rtree()
+{
+    typedef bg::model::point<double, 2, bg::cs::geographic<bg::degree> > point_type;
+    typedef std::pair<geocentric_type, std::size_t> value_type;
+
+    bg::strategy::distance::geocentric_chord<spheroid_type> const strategy;
+    bg::strategy::distance::andoyer<spheroid_type> const exact;
+
+    std::vector<point_type> points;
+    std::vector<value_type> values;
+    for (int i = 0; i < 40; i++)
+    {
+        for (int j = 0; j < 40; j++)
+        {
+            point_type const p(170.0 + i * 0.5, 40.0 + j * 0.5 + i * 0.01);
+            geocentric_type g;
+            strategy.to_geocentric(p, g);
+            values.push_back(value_type(g, points.size()));
+            points.push_back(p);
+        }
+    }
+
+    bg::index::rtree<value_type, bg::index::rstar<8> > const rtree(values);
+
+    point_type const query(179.9, 49.3);
+    geocentric_type query_g;
+    strategy.to_geocentric(query, query_g);
+
+    // The rtree finds the nearest points by their comparable distance
+    std::vector<value_type> nearest;
+    rtree.query(bg::index::nearest(query_g, 20), std::back_inserter(nearest));
+    std::vector<std::size_t> nearest_ids;
+    for (std::size_t i = 0; i < nearest.size(); i++)
+    {
+        nearest_ids.push_back(nearest[i].second);
+    }
+    std::sort(nearest_ids.begin(), nearest_ids.end());
+
+    std::vector<std::pair<double, std::size_t> > expected;
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        expected.push_back(std::make_pair(
+            bg::comparable_distance(query, points[i], strategy), i));
+    }
+    std::sort(expected.begin(), expected.end());
+    std::vector<std::size_t> expected_ids;
+    for (std::size_t i = 0; i < 20; i++)
+    {
+        expected_ids.push_back(expected[i].second);
+    }
+    std::sort(expected_ids.begin(), expected_ids.end());
+    BOOST_CHECK(nearest_ids == expected_ids);
+
+    // Points within 100 km: candidates in the rtree, accepted by their
+    // maximal distance or by the geodesic distance
+    double const limit = 100000.0;
+    double const limit_cd = bg::strategy::distance::services::result_from_distance
+        <
+            bg::strategy::distance::comparable::geocentric_chord<spheroid_type>,
+            point_type, point_type
+        >::apply(bg::strategy::distance::services::get_comparable
+                    <
+                        bg::strategy::distance::geocentric_chord<spheroid_type>
+                    >::apply(strategy), limit);
+
+    std::size_t within = 0, refined = 0;
+    for (std::size_t i = 0; i < expected.size() && expected[i].first <= limit_cd; i++)
+    {
+        if (strategy.max_distance(expected[i].first) <= limit)
+        {
+            within++;
+        }
+        else
+        {
+            refined++;
+            if (exact.apply(query, points[expected[i].second]) <= limit)
+            {
+                within++;
+            }
+        }
+    }
+
+    std::size_t within_exact = 0;
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        if (exact.apply(query, points[i]) <= limit)
+        {
+            within_exact++;
+        }
+    }
+    BOOST_CHECK_EQUAL(within, within_exact);
+    BOOST_CHECK(refined < within / 10);
+}
+
+template <typename P1, typename P2>
+void test_all()
+{
+    // Geodesic distances calculated with GeographicLib (Karney)
+    test_distance<P1, P2>(4, 52, 3, 40, 1336.027219);
+    test_distance<P1, P2>(0, 90, 1, 80, 1116.825857);
+    test_distance<P1, P2>(4, 52, 4, 52, 0.0);
+    test_distance<P1, P2>(4.9, 52.37, 4.91, 52.38, 1.304606);
+    test_distance<P1, P2>(4.9, 52.37, 5.9, 52.37, 68.109820);
+    test_distance<P1, P2>(0, 0, 1, 0, 111.319491);
+    test_distance<P1, P2>(0, 0, 0, 1, 110.574389);
+    test_distance<P1, P2>(170, -10, -170, 10, 3130.218198);
+    test_distance<P1, P2>(-74, 40.7, -0.1, 51.5, 5587.819517);
+}
+
+int test_main(int, char* [])
+{
+    test_all
+        <
+            bg::model::point<double, 2, bg::cs::geographic<bg::degree> >,
+            bg::model::point<double, 2, bg::cs::geographic<bg::degree> >
+        >();
+    test_all
+        <
+            bg::model::point<double, 2, bg::cs::geographic<bg::degree> >,
+            bg::model::point<long double, 2, bg::cs::geographic<bg::degree> >
+        >();
+
+    test_geocentric();
+    test_rtree();
+
+    return 0;
+}
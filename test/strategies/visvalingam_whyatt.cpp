@@ -0,0 +1,110 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2016 Boost.Geometry contributors.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_TEST_MODULE
+#define BOOST_TEST_MODULE test_visvalingam_whyatt
+#endif
+
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+#include <boost/geometry/strategies/agnostic/simplify_visvalingam_whyatt.hpp>
+#include <boost/geometry/strategies/concepts/simplify_concept.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+
+#include <boost/geometry/algorithms/equals.hpp>
+
+#include <boost/geometry/io/wkt/wkt.hpp>
+
+
+namespace bg = ::boost::geometry;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+typedef bg::model::linestring<point_type> linestring_type;
+typedef bg::strategy::simplify::visvalingam_whyatt<point_type> strategy_type;
+
+BOOST_CONCEPT_ASSERT( (bg::concept::SimplifyStrategy<strategy_type, point_type>) );
+
+
+inline void check(std::string const& wkt, double max_area,
+                  std::string const& expected_wkt)
+{
+    linestring_type input, expected, result;
+    bg::read_wkt(wkt, input);
+    bg::read_wkt(expected_wkt, expected);
+
+    strategy_type::apply(input, std::back_inserter(result), max_area);
+
+    std::ostringstream out;
+    out << bg::wkt(result);
+    BOOST_CHECK_MESSAGE(bg::equals(result, expected),
+        "input: " << wkt << " max area: " << max_area
+        << " expected: " << expected_wkt << " detected: " << out.str());
+}
+
+
+BOOST_AUTO_TEST_CASE( test_visvalingam_whyatt )
+{
+    // Effective areas: (1 1) 1, (2 0) 1, (3 5) 5.5
+    std::string const wkt = "LINESTRING(0 0,1 1,2 0,3 5,4 0)";
+
+    check(wkt, 0.5, wkt);
+    check(wkt, 1.0, wkt);
+
+    // After (1 1) is removed, the areas of (2 0) and (3 5) are 5
+    check(wkt, 1.5, "LINESTRING(0 0,2 0,3 5,4 0)");
+    check(wkt, 5.5, "LINESTRING(0 0,3 5,4 0)");
+    check(wkt, 100.0, "LINESTRING(0 0,4 0)");
+
+    // Collinear points have no area
+    check("LINESTRING(0 0,1 0,2 0,3 0)", 1.0e-9, "LINESTRING(0 0,3 0)");
+
+    // Equal areas, the first vertex is removed first. After that the
+    // area of (2 0) is 1 and it is removed before (3 1), which has area 2
+    check("LINESTRING(0 0,1 1,2 0,3 1,4 0)", 1.5, "LINESTRING(0 0,3 1,4 0)");
+
+    check("LINESTRING(0 0,1 1)", 100.0, "LINESTRING(0 0,1 1)");
+}
+
+BOOST_AUTO_TEST_CASE( test_visvalingam_whyatt_vertices )
+{
+    typedef bg::strategy::simplify::detail::visvalingam_whyatt_vertices
+        <
+            point_type
+        > vertices_type;
+
+    linestring_type first, second;
+    bg::read_wkt("LINESTRING(0 0,1 1,2 0)", first);
+    bg::read_wkt("LINESTRING(2 0,3 1,4 0)", second);
+
+    vertices_type vertices;
+    BOOST_CHECK_EQUAL(vertices.add_chain(first.begin(), first.end()), 0u);
+    BOOST_CHECK_EQUAL(vertices.add_chain(second.begin(), second.end()), 3u);
+    BOOST_CHECK_EQUAL(vertices.size(), 6u);
+
+    // The chains are independent, the endpoints are not removed
+    bg::strategy::simplify::detail::visvalingam_whyatt_remove_all policy;
+    vertices.apply(100.0, policy);
+
+    BOOST_CHECK(! vertices.removed(0));
+    BOOST_CHECK(vertices.removed(1));
+    BOOST_CHECK(! vertices.removed(2));
+    BOOST_CHECK(! vertices.removed(3));
+    BOOST_CHECK(vertices.removed(4));
+    BOOST_CHECK(! vertices.removed(5));
+    BOOST_CHECK_EQUAL(vertices.next(0), 2u);
+    BOOST_CHECK_EQUAL(vertices.prev(5), 3u);
+    BOOST_CHECK_EQUAL(vertices.next(2), vertices_type::none);
+}